@@ -43,6 +43,9 @@
 
 #define MONITOR_DECAY_EVERY 512 /* in samples */
 
+#define FLOAT_BLOCK 64 /* in stereo frames */
+#define FLOAT_SCALE (32767.0f * 65536.0f) /* full range of a 16-bit sample */
+
 #define SQ(x) ((x)*(x))
 #define ARRAY_SIZE(x) (sizeof(x) / sizeof(*x))
 
@@ -581,6 +584,27 @@ void timecoder_cycle_definition(struct timecoder *tc)
     tc->timecode_ticker = 0;
 }
 
+/*
+ * Decode a single stereo frame in the full range of a signed int
+ */
+
+static inline void submit_frame(struct timecoder *tc,
+                                signed int left, signed int right)
+{
+    signed int primary, secondary;
+
+    if (tc->def->flags & SWITCH_PRIMARY) {
+        primary = left;
+        secondary = right;
+    } else {
+        primary = right;
+        secondary = left;
+    }
+
+    process_sample(tc, primary, secondary);
+    update_monitor(tc, left, right);
+}
+
 /*
  * Submit and decode a block of PCM audio data to the timecode decoder
  *
@@ -590,23 +614,46 @@ void timecoder_cycle_definition(struct timecoder *tc)
 void timecoder_submit(struct timecoder *tc, signed short *pcm, size_t npcm)
 {
     while (npcm--) {
-	signed int left, right, primary, secondary;
+        submit_frame(tc, pcm[0] << 16, pcm[1] << 16);
+        pcm += TIMECODER_CHANNELS;
+    }
+}
 
-        left = pcm[0] << 16;
-        right = pcm[1] << 16;
+/*
+ * Submit and decode a block of floating point PCM audio data
+ *
+ * PCM data is in the range -1.0 to 1.0 before applying the gain, and is
+ * clipped to the range of timecoder_submit(). Unlike a conversion to
+ * signed short, the precision of the input below 16-bit is retained.
+ */
 
-        if (tc->def->flags & SWITCH_PRIMARY) {
-            primary = left;
-            secondary = right;
-        } else {
-            primary = right;
-            secondary = left;
+void timecoder_submit_float(struct timecoder *tc, const float *pcm,
+                            size_t npcm, float gain)
+{
+    signed int block[FLOAT_BLOCK * TIMECODER_CHANNELS];
+    const float scale = gain * FLOAT_SCALE;
+
+    while (npcm > 0) {
+        size_t n, s;
+
+        n = npcm < FLOAT_BLOCK ? npcm : FLOAT_BLOCK;
+
+        /* Convert in blocks without branches, so that the compiler
+         * can vectorize the conversion */
+
+        for (s = 0; s < n * TIMECODER_CHANNELS; s++) {
+            float x = pcm[s] * scale;
+            x = x > FLOAT_SCALE ? FLOAT_SCALE : x;
+            x = x < -FLOAT_SCALE ? -FLOAT_SCALE : x;
+            block[s] = (signed int)x;
         }
 
-	process_sample(tc, primary, secondary);
-        update_monitor(tc, left, right);
+        for (s = 0; s < n; s++)
+            submit_frame(tc, block[s * TIMECODER_CHANNELS],
+                         block[s * TIMECODER_CHANNELS + 1]);
 
-        pcm += TIMECODER_CHANNELS;
+        pcm += n * TIMECODER_CHANNELS;
+        npcm -= n;
     }
 }
 
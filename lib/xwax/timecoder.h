@@ -94,6 +94,8 @@ void timecoder_monitor_clear(struct timecoder *tc);
 
 void timecoder_cycle_definition(struct timecoder *tc);
 void timecoder_submit(struct timecoder *tc, signed short *pcm, size_t npcm);
+void timecoder_submit_float(struct timecoder *tc, const float *pcm,
+                            size_t npcm, float gain);
 signed int timecoder_get_position(struct timecoder *tc, double *when);
 
 /*
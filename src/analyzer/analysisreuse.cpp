@@ -0,0 +1,280 @@
+#include "analyzer/analysisreuse.h"
+
+#include <QCryptographicHash>
+#include <QSqlQuery>
+#include <QSqlRecord>
+#include <QtEndian>
+#include <cmath>
+#include <vector>
+
+#include "analyzer/analyzersilence.h"
+#include "analyzer/constants.h"
+#include "engine/engine.h"
+#include "library/queryutil.h"
+#include "preferences/waveformsettings.h"
+#include "sources/audiosourcestereoproxy.h"
+#include "track/keyfactory.h"
+#include "track/track.h"
+#include "util/logger.h"
+#include "util/math.h"
+#include "util/samplebuffer.h"
+#include "waveform/waveformfactory.h"
+
+namespace {
+
+mixxx::Logger kLogger("AnalysisReuse");
+
+// The decoded samples of these excerpts, distributed evenly over the
+// whole track, are hashed. This takes only a fraction of the time that
+// decoding the whole track would take.
+constexpr int kFingerprintExcerptCount = 8;
+constexpr SINT kFingerprintExcerptFrames = 4096;
+
+// The samples are hashed with 16 bit, which is sufficient for
+// distinguishing different audio
+constexpr CSAMPLE kFingerprintSampleScale = 32767.0f;
+
+} // anonymous namespace
+
+AnalysisReuse::AnalysisReuse(
+        UserSettingsPointer pConfig,
+        const QSqlDatabase& database)
+        : m_pConfig(std::move(pConfig)),
+          m_database(database),
+          m_analysisDao(m_pConfig) {
+    m_analysisDao.initialize(m_database);
+}
+
+// static
+QByteArray AnalysisReuse::fingerprint(
+        const mixxx::AudioSourcePointer& pAudioSource) {
+    const mixxx::IndexRange frameRange = pAudioSource->frameIndexRange();
+    if (frameRange.empty()) {
+        return QByteArray();
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QStringLiteral("%1;%2;%3")
+                         .arg(QString::number(pAudioSource->getSignalInfo().getSampleRate()),
+                                 QString::number(pAudioSource->getSignalInfo()
+                                                         .getChannelCount()),
+                                 QString::number(frameRange.length()))
+                         .toLatin1());
+
+    const SINT excerptFrames = math_min(kFingerprintExcerptFrames, frameRange.length());
+    mixxx::AudioSourceStereoProxy audioSourceProxy(pAudioSource, excerptFrames);
+    mixxx::SampleBuffer sampleBuffer(excerptFrames * mixxx::kAnalysisChannels);
+    std::vector<qint16> pcmSamples(excerptFrames * mixxx::kAnalysisChannels);
+    for (int excerpt = 0; excerpt < kFingerprintExcerptCount; ++excerpt) {
+        // The excerpt is taken from the middle of the part of the
+        // track that it represents
+        const SINT partStart = frameRange.length() * excerpt / kFingerprintExcerptCount;
+        const SINT partEnd = frameRange.length() * (excerpt + 1) / kFingerprintExcerptCount;
+        const SINT excerptStart = frameRange.start() +
+                math_clamp((partStart + partEnd - excerptFrames) / 2,
+                        SINT(0),
+                        frameRange.length() - excerptFrames);
+        const auto readableSampleFrames = audioSourceProxy.readSampleFrames(
+                mixxx::WritableSampleFrames(
+                        mixxx::IndexRange::forward(excerptStart, excerptFrames),
+                        mixxx::SampleBuffer::WritableSlice(sampleBuffer)));
+        // The actual range may differ if the length of the
+        // audio source has been adjusted while reading
+        hash.addData(QStringLiteral(";%1;%2")
+                             .arg(QString::number(readableSampleFrames
+                                                          .frameIndexRange()
+                                                          .start()),
+                                     QString::number(readableSampleFrames
+                                                             .frameIndexRange()
+                                                             .length()))
+                             .toLatin1());
+        const CSAMPLE* pSamples = readableSampleFrames.readableData();
+        const SINT length = readableSampleFrames.readableLength();
+        for (SINT i = 0; i < length; ++i) {
+            pcmSamples[i] = qToLittleEndian(static_cast<qint16>(std::lround(
+                    math_clamp(pSamples[i], -1.0f, 1.0f) * kFingerprintSampleScale)));
+        }
+        hash.addData(QByteArray::fromRawData(
+                reinterpret_cast<const char*>(pcmSamples.data()),
+                static_cast<int>(length * sizeof(qint16))));
+    }
+    return hash.result();
+}
+
+bool AnalysisReuse::hasFingerprint(TrackId trackId) const {
+    QSqlQuery query(m_database);
+    query.prepare(QStringLiteral(
+            "SELECT audio_fingerprint FROM library WHERE id=:trackId"));
+    query.bindValue(":trackId", trackId.toVariant());
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+        // Don't reuse results for tracks in an unknown state
+        return true;
+    }
+    return query.next() && !query.value(0).isNull();
+}
+
+bool AnalysisReuse::storeFingerprint(TrackId trackId, const QByteArray& fingerprint) const {
+    VERIFY_OR_DEBUG_ASSERT(!fingerprint.isEmpty()) {
+        return false;
+    }
+    QSqlQuery query(m_database);
+    query.prepare(QStringLiteral(
+            "UPDATE library SET audio_fingerprint=:fingerprint WHERE id=:trackId"));
+    query.bindValue(":fingerprint", fingerprint);
+    query.bindValue(":trackId", trackId.toVariant());
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+        return false;
+    }
+    return true;
+}
+
+TrackId AnalysisReuse::reuseResults(
+        const TrackPointer& pTrack,
+        mixxx::audio::SampleRate sampleRate,
+        const QByteArray& fingerprint) const {
+    const TrackId trackId = pTrack->getId();
+    if (!trackId.isValid() || fingerprint.isEmpty()) {
+        return TrackId();
+    }
+
+    // The oldest track with the same audio is most likely the
+    // original one that has already been analyzed
+    QSqlQuery query(m_database);
+    query.prepare(QStringLiteral(
+            "SELECT library.id,beats_version,beats_sub_version,beats,"
+            "keys_version,keys_sub_version,keys,replaygain,replaygain_peak,"
+            "cues.position AS sound_position,cues.length AS sound_length "
+            "FROM library LEFT JOIN cues ON cues.track_id=library.id "
+            "AND cues.type=:audibleSoundType "
+            "WHERE library.audio_fingerprint=:fingerprint AND library.id<>:trackId "
+            "ORDER BY library.id LIMIT 1"));
+    query.bindValue(":audibleSoundType", static_cast<int>(mixxx::CueType::AudibleSound));
+    query.bindValue(":fingerprint", fingerprint);
+    query.bindValue(":trackId", trackId.toVariant());
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+        return TrackId();
+    }
+    if (!query.next()) {
+        return TrackId();
+    }
+    const QSqlRecord record = query.record();
+    const TrackId otherTrackId(record.value(0));
+    bool reused = false;
+
+    // Beats that have been created from the metadata are replaced
+    // by the analysis
+    const mixxx::BeatsPointer pBeats = pTrack->getBeats();
+    const QString beatsVersion = record.value(1).toString();
+    if (!beatsVersion.isEmpty() && !pTrack->isBpmLocked() &&
+            (!pBeats || pBeats->getSubVersion().isEmpty())) {
+        const mixxx::BeatsPointer pOtherBeats = mixxx::Beats::fromByteArray(
+                sampleRate,
+                beatsVersion,
+                record.value(2).toString(),
+                record.value(3).toByteArray());
+        if (pOtherBeats && pTrack->trySetBeats(pOtherBeats)) {
+            reused = true;
+        }
+    }
+
+    if (!pTrack->getKeys().isValid()) {
+        QByteArray keysBlob = record.value(6).toByteArray();
+        const Keys keys = KeyFactory::loadKeysFromByteArray(
+                record.value(4).toString(),
+                record.value(5).toString(),
+                &keysBlob);
+        if (keys.isValid()) {
+            pTrack->setKeys(keys);
+            reused = true;
+        }
+    }
+
+    const double replayGainRatio = record.value(7).toDouble();
+    if (!pTrack->getReplayGain().hasRatio() &&
+            mixxx::ReplayGain::isValidRatio(replayGainRatio)) {
+        mixxx::ReplayGain replayGain(pTrack->getReplayGain());
+        replayGain.setRatio(replayGainRatio);
+        replayGain.setPeak(record.value(8).toFloat());
+        pTrack->setReplayGain(replayGain);
+        reused = true;
+    }
+
+    const double soundLengthFrames =
+            record.value(10).toDouble() / mixxx::kEngineChannelCount;
+    if (soundLengthFrames > 0 && AnalyzerSilence::shouldAnalyze(pTrack)) {
+        const auto firstSoundPosition =
+                mixxx::audio::FramePos::fromEngineSamplePosMaybeInvalid(
+                        record.value(9).toDouble());
+        if (firstSoundPosition.isValid()) {
+            AnalyzerSilence::setupCues(pTrack,
+                    m_pConfig,
+                    firstSoundPosition,
+                    firstSoundPosition + soundLengthFrames);
+            reused = true;
+        }
+    }
+
+    if (!pTrack->getWaveform() && !pTrack->getWaveformSummary() &&
+            reuseWaveforms(trackId, otherTrackId)) {
+        reused = true;
+    }
+
+    if (!reused) {
+        return TrackId();
+    }
+    kLogger.info()
+            << "Reusing analysis results of track"
+            << otherTrackId
+            << "with identical audio for track"
+            << trackId;
+    return otherTrackId;
+}
+
+bool AnalysisReuse::reuseWaveforms(TrackId trackId, TrackId otherTrackId) const {
+    if (!WaveformSettings(m_pConfig).waveformCachingEnabled()) {
+        return false;
+    }
+
+    // Stored analyses of the track itself are loaded by the AnalyzerWaveform
+    QSqlQuery query(m_database);
+    query.prepare(QStringLiteral("SELECT COUNT(*) FROM %1 WHERE track_id=:trackId")
+                          .arg(AnalysisDao::s_analysisTableName));
+    query.bindValue(":trackId", trackId.toVariant());
+    if (!query.exec() || !query.next()) {
+        LOG_FAILED_QUERY(query);
+        return false;
+    }
+    if (query.value(0).toInt() > 0) {
+        return false;
+    }
+
+    AnalysisDao::AnalysisInfo waveform;
+    AnalysisDao::AnalysisInfo waveformSummary;
+    const auto analyses = m_analysisDao.getAnalysesForTrack(otherTrackId);
+    for (const auto& analysis : analyses) {
+        if (analysis.type == AnalysisDao::TYPE_WAVEFORM &&
+                WaveformFactory::waveformVersionToVersionClass(
+                        analysis.version) == WaveformFactory::VC_USE) {
+            waveform = analysis;
+        } else if (analysis.type == AnalysisDao::TYPE_WAVESUMMARY &&
+                WaveformFactory::waveformSummaryVersionToVersionClass(
+                        analysis.version) == WaveformFactory::VC_USE) {
+            waveformSummary = analysis;
+        }
+    }
+    if (waveform.type == AnalysisDao::TYPE_UNKNOWN ||
+            waveformSummary.type == AnalysisDao::TYPE_UNKNOWN) {
+        return false;
+    }
+
+    // Insert copies for the track
+    waveform.analysisId = -1;
+    waveform.trackId = trackId;
+    waveformSummary.analysisId = -1;
+    waveformSummary.trackId = trackId;
+    return m_analysisDao.saveAnalysis(&waveform) &&
+            m_analysisDao.saveAnalysis(&waveformSummary);
+}
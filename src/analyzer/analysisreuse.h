@@ -0,0 +1,53 @@
+#pragma once
+
+#include <QByteArray>
+#include <QSqlDatabase>
+
+#include "audio/types.h"
+#include "library/dao/analysisdao.h"
+#include "preferences/usersettings.h"
+#include "sources/audiosource.h"
+#include "track/track_decl.h"
+#include "track/trackid.h"
+
+/// Reuses the analysis results of other tracks with identical audio,
+/// e.g. copies of the same file on different drives.
+///
+/// The audio is identified by a fingerprint that hashes the decoded
+/// samples of a few short excerpts together with the signal properties
+/// and the length of the track. It is stored in the library table when a
+/// track is analyzed for the first time. Results are only reused for
+/// tracks without a fingerprint. A track that is analyzed again, e.g.
+/// after its beats have been cleared, is always processed by the analyzers.
+///
+/// Only used from the worker thread of an AnalyzerThread.
+class AnalysisReuse final {
+  public:
+    AnalysisReuse(
+            UserSettingsPointer pConfig,
+            const QSqlDatabase& database);
+
+    /// Decodes the excerpts and returns an empty fingerprint if
+    /// the audio source is empty.
+    static QByteArray fingerprint(
+            const mixxx::AudioSourcePointer& pAudioSource);
+
+    bool hasFingerprint(TrackId trackId) const;
+    bool storeFingerprint(TrackId trackId, const QByteArray& fingerprint) const;
+
+    /// Copies all results that are missing from another track with the
+    /// same fingerprint into the track. The waveforms are copied in the
+    /// database where the AnalyzerWaveform picks them up. Returns the id
+    /// of the other track or an invalid id if no results have been copied.
+    TrackId reuseResults(
+            const TrackPointer& pTrack,
+            mixxx::audio::SampleRate sampleRate,
+            const QByteArray& fingerprint) const;
+
+  private:
+    bool reuseWaveforms(TrackId trackId, TrackId otherTrackId) const;
+
+    const UserSettingsPointer m_pConfig;
+    const QSqlDatabase m_database;
+    mutable AnalysisDao m_analysisDao;
+};
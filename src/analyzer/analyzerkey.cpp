@@ -31,8 +31,9 @@ mixxx::AnalyzerPluginInfo AnalyzerKey::defaultPlugin() {
     return plugins.at(0);
 }
 
-AnalyzerKey::AnalyzerKey(const KeyDetectionSettings& keySettings)
+AnalyzerKey::AnalyzerKey(const KeyDetectionSettings& keySettings, bool segmented)
         : m_keySettings(keySettings),
+          m_segmented(segmented),
           m_iSampleRate(0),
           m_iTotalSamples(0),
           m_iMaxSamplesToProcess(0),
@@ -92,7 +93,7 @@ bool AnalyzerKey::initialize(const AnalyzerTrack& tio,
     DEBUG_ASSERT(!m_pPlugin);
     if (bShouldAnalyze) {
         if (m_pluginId == mixxx::AnalyzerQueenMaryKey::pluginInfo().id()) {
-            m_pPlugin = std::make_unique<mixxx::AnalyzerQueenMaryKey>();
+            m_pPlugin = std::make_unique<mixxx::AnalyzerQueenMaryKey>(m_segmented);
 #if defined __KEYFINDER__
         } else if (m_pluginId == mixxx::AnalyzerKeyFinder::pluginInfo().id()) {
             m_pPlugin = std::make_unique<mixxx::AnalyzerKeyFinder>();
@@ -14,7 +14,9 @@
 
 class AnalyzerKey : public Analyzer {
   public:
-    explicit AnalyzerKey(const KeyDetectionSettings& keySettings);
+    explicit AnalyzerKey(
+            const KeyDetectionSettings& keySettings,
+            bool segmented = false);
     ~AnalyzerKey() override = default;
 
     static QList<mixxx::AnalyzerPluginInfo> availablePlugins();
@@ -34,6 +36,7 @@ class AnalyzerKey : public Analyzer {
     bool shouldAnalyze(TrackPointer tio) const;
 
     KeyDetectionSettings m_keySettings;
+    const bool m_segmented;
     std::unique_ptr<mixxx::AnalyzerKeyPlugin> m_pPlugin;
     QString m_pluginId;
     int m_iSampleRate;
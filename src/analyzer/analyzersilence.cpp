@@ -11,7 +11,10 @@ constexpr CSAMPLE kSilenceThreshold = 0.001f;
 // TODO: Change the above line to:
 //constexpr CSAMPLE kSilenceThreshold = db2ratio(-60.0f);
 
-bool shouldAnalyze(TrackPointer pTrack) {
+} // anonymous namespace
+
+// static
+bool AnalyzerSilence::shouldAnalyze(TrackPointer pTrack) {
     CuePointer pIntroCue = pTrack->findCueByType(mixxx::CueType::Intro);
     CuePointer pOutroCue = pTrack->findCueByType(mixxx::CueType::Outro);
     CuePointer pAudibleSound = pTrack->findCueByType(mixxx::CueType::AudibleSound);
@@ -22,8 +25,6 @@ bool shouldAnalyze(TrackPointer pTrack) {
     return false;
 }
 
-} // anonymous namespace
-
 AnalyzerSilence::AnalyzerSilence(UserSettingsPointer pConfig)
         : m_pConfig(pConfig),
           m_fThreshold(kSilenceThreshold),
@@ -93,9 +94,18 @@ void AnalyzerSilence::storeResults(TrackPointer pTrack) {
         m_iSignalEnd = m_iFramesProcessed;
     }
 
-    const auto firstSoundPosition = mixxx::audio::FramePos(m_iSignalStart);
-    const auto lastSoundPosition = mixxx::audio::FramePos(m_iSignalEnd);
+    setupCues(pTrack,
+            m_pConfig,
+            mixxx::audio::FramePos(m_iSignalStart),
+            mixxx::audio::FramePos(m_iSignalEnd));
+}
 
+// static
+void AnalyzerSilence::setupCues(
+        TrackPointer pTrack,
+        UserSettingsPointer pConfig,
+        mixxx::audio::FramePos firstSoundPosition,
+        mixxx::audio::FramePos lastSoundPosition) {
     CuePointer pAudibleSound = pTrack->findCueByType(mixxx::CueType::AudibleSound);
     if (pAudibleSound == nullptr) {
         pAudibleSound = pTrack->createAndAddCue(
@@ -128,7 +138,7 @@ void AnalyzerSilence::storeResults(TrackPointer pTrack) {
     if (!mainCuePosition.isValid() || upgradingWithMainCueAtDefault) {
         pTrack->setMainCuePosition(firstSoundPosition);
         // NOTE: the actual default for this ConfigValue is set in DlgPrefDeck.
-    } else if (m_pConfig->getValue(ConfigKey("[Controls]", "SetIntroStartAtMainCue"), false) &&
+    } else if (pConfig->getValue(ConfigKey("[Controls]", "SetIntroStartAtMainCue"), false) &&
             pIntroCue == nullptr) {
         introStartPosition = mainCuePosition;
     }
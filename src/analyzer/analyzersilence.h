@@ -2,6 +2,7 @@
 
 #include "analyzer/analyzer.h"
 #include "analyzer/analyzertrack.h"
+#include "audio/frame.h"
 #include "preferences/usersettings.h"
 
 class CuePointer;
@@ -18,6 +19,18 @@ class AnalyzerSilence : public Analyzer {
     void storeResults(TrackPointer pTrack) override;
     void cleanup() override;
 
+    /// Returns false if the track already has all cues that
+    /// are created from the analysis results.
+    static bool shouldAnalyze(TrackPointer pTrack);
+
+    /// Creates or adjusts the cues of a track with audible sound
+    /// between the given positions.
+    static void setupCues(
+            TrackPointer pTrack,
+            UserSettingsPointer pConfig,
+            mixxx::audio::FramePos firstSoundPosition,
+            mixxx::audio::FramePos lastSoundPosition);
+
   private:
     UserSettingsPointer m_pConfig;
     CSAMPLE m_fThreshold;
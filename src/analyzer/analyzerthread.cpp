@@ -2,6 +2,7 @@
 
 #include <mutex>
 
+#include "analyzer/analysisreuse.h"
 #include "analyzer/analyzerbeats.h"
 #include "analyzer/analyzerebur128.h"
 #include "analyzer/analyzergain.h"
@@ -18,6 +19,7 @@
 #include "util/db/dbconnectionpooled.h"
 #include "util/db/dbconnectionpooler.h"
 #include "util/logger.h"
+#include "util/threadrole.h"
 #include "util/timer.h"
 
 namespace {
@@ -84,26 +86,31 @@ AnalyzerThread::AnalyzerThread(
           m_pConfig(pConfig),
           m_modeFlags(modeFlags),
           m_nextTrack(2), // minimum capacity
+          m_pWaveformPreviewAnalyzer(nullptr),
           m_sampleBuffer(mixxx::kAnalysisSamplesPerChunk),
           m_emittedState(AnalyzerThreadState::Void) {
     std::call_once(registerMetaTypesOnceFlag, registerMetaTypesOnce);
 }
 
 void AnalyzerThread::doRun() {
-    std::unique_ptr<AnalysisDao> pAnalysisDao;
+    const mixxx::ScopedThreadRole threadRole(mixxx::ThreadRole::Analyzer);
     // The thread-local database connection  must not be closed
     // before returning from this function.
-    mixxx::DbConnectionPooler dbConnectionPooler;
+    const mixxx::DbConnectionPooler dbConnectionPooler(m_dbConnectionPool);
+    if (!dbConnectionPooler.isPooling()) {
+        kLogger.warning()
+                << "Failed to obtain database connection for analyzer thread";
+        return;
+    }
+    QSqlDatabase dbConnection = mixxx::DbConnectionPooled(m_dbConnectionPool);
+    const AnalysisReuse analysisReuse(m_pConfig, dbConnection);
 
     if (m_modeFlags & AnalyzerModeFlags::WithWaveform) {
-        dbConnectionPooler = mixxx::DbConnectionPooler(m_dbConnectionPool); // move assignment
-        if (!dbConnectionPooler.isPooling()) {
-            kLogger.warning()
-                    << "Failed to obtain database connection for analyzer thread";
-            return;
+        auto pAnalyzerWaveform = std::make_unique<AnalyzerWaveform>(m_pConfig, dbConnection);
+        if (m_modeFlags & AnalyzerModeFlags::WithWaveformPreview) {
+            m_pWaveformPreviewAnalyzer = pAnalyzerWaveform.get();
         }
-        QSqlDatabase dbConnection = mixxx::DbConnectionPooled(m_dbConnectionPool);
-        m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerWaveform>(m_pConfig, dbConnection)));
+        m_analyzers.push_back(AnalyzerWithState(std::move(pAnalyzerWaveform)));
     }
     if (AnalyzerGain::isEnabled(ReplayGainSettings(m_pConfig))) {
         m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerGain>(m_pConfig)));
@@ -114,8 +121,10 @@ void AnalyzerThread::doRun() {
     // BPM detection might be disabled in the config, but can be overridden
     // and enabled by explicitly setting the mode flag.
     const bool enforceBpmDetection = (m_modeFlags & AnalyzerModeFlags::WithBeats) != 0;
-    m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerBeats>(m_pConfig, enforceBpmDetection)));
-    m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerKey>(m_pConfig)));
+    const bool segmented = (m_modeFlags & AnalyzerModeFlags::Segmented) != 0;
+    m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerBeats>(
+            m_pConfig, enforceBpmDetection, segmented)));
+    m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerKey>(m_pConfig, segmented)));
     m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerSilence>(m_pConfig)));
     DEBUG_ASSERT(!m_analyzers.empty());
     kLogger.debug() << "Activated" << m_analyzers.size() << "analyzers";
@@ -140,6 +149,20 @@ void AnalyzerThread::doRun() {
             continue;
         }
 
+        // Results of another track with identical audio are only
+        // reused when analyzing a track for the first time
+        const TrackId trackId = m_currentTrack->getTrack()->getId();
+        QByteArray fingerprint;
+        bool reusedResults = false;
+        if (!analysisReuse.hasFingerprint(trackId)) {
+            fingerprint = AnalysisReuse::fingerprint(audioSource);
+            reusedResults = analysisReuse
+                                    .reuseResults(m_currentTrack->getTrack(),
+                                            audioSource->getSignalInfo().getSampleRate(),
+                                            fingerprint)
+                                    .isValid();
+        }
+
         bool processTrack = false;
         for (auto&& analyzer : m_analyzers) {
             // Make sure not to short-circuit initialize(...)
@@ -166,6 +189,9 @@ void AnalyzerThread::doRun() {
                 for (auto&& analyzer : m_analyzers) {
                     analyzer.finish(*m_currentTrack);
                 }
+                if (!fingerprint.isEmpty()) {
+                    analysisReuse.storeFingerprint(trackId, fingerprint);
+                }
                 emitDoneProgress(kAnalyzerProgressDone);
             } else {
                 for (auto&& analyzer : m_analyzers) {
@@ -175,12 +201,19 @@ void AnalyzerThread::doRun() {
             }
         } else {
             kLogger.debug() << "Skipping track analysis because no analyzer initialized.";
+            if (!fingerprint.isEmpty()) {
+                analysisReuse.storeFingerprint(trackId, fingerprint);
+            }
+            if (reusedResults) {
+                emit analysisSkipped(m_id, trackId);
+            }
             emitDoneProgress(kAnalyzerProgressDone);
         }
     }
     DEBUG_ASSERT(!m_currentTrack);
     DEBUG_ASSERT(isStopping());
 
+    m_pWaveformPreviewAnalyzer = nullptr;
     m_analyzers.clear();
 
     kLogger.debug() << "Exiting worker thread";
@@ -232,6 +265,12 @@ AnalyzerThread::AnalysisResult AnalyzerThread::analyzeAudioSource(
     // Analysis starts now
     emitBusyProgress(kAnalyzerProgressNone);
 
+    if (m_pWaveformPreviewAnalyzer) {
+        // Decodes short excerpts of the whole track. The waveform
+        // analyzer ignores this request if it is inactive.
+        m_pWaveformPreviewAnalyzer->processPreview(audioSource);
+    }
+
     mixxx::IndexRange remainingFrameRange = audioSource->frameIndexRange();
     while (!remainingFrameRange.empty()) {
         sleepWhileSuspended();
@@ -22,6 +22,10 @@ enum AnalyzerModeFlags {
     WithBeats = 0x01,
     WithWaveform = 0x02,
     LowPriority = 0x04,
+    // Analyze beats and key of a single track on multiple threads
+    Segmented = 0x08,
+    // Show a coarse waveform of the whole track before analyzing it
+    WithWaveformPreview = 0x10,
     All = WithBeats | WithWaveform,
 };
 
@@ -44,6 +48,8 @@ Q_DECLARE_METATYPE(AnalyzerThreadState);
 // The frequency of progress signal is limited to avoid flooding the
 // signal queued connection between the internal worker thread and
 // the host, which might otherwise cause unresponsiveness of the host.
+class AnalyzerWaveform;
+
 class AnalyzerThread : public WorkerThread {
     Q_OBJECT
 
@@ -88,6 +94,11 @@ class AnalyzerThread : public WorkerThread {
     // AnalyzerThreadProgress object and register it as a new meta type.
     void progress(int threadId, AnalyzerThreadState threadState, TrackId trackId, AnalyzerProgress trackProgress);
 
+    // Emitted before the Done progress of a track if all analyzers
+    // have been skipped, because the results of another track with
+    // identical audio could be reused.
+    void analysisSkipped(int threadId, TrackId trackId);
+
   protected:
     void doRun() override;
 
@@ -118,6 +129,9 @@ class AnalyzerThread : public WorkerThread {
 
     std::vector<AnalyzerWithState> m_analyzers;
 
+    // One of m_analyzers if a waveform preview is requested
+    AnalyzerWaveform* m_pWaveformPreviewAnalyzer;
+
     mixxx::SampleBuffer m_sampleBuffer;
 
     std::optional<AnalyzerTrack> m_currentTrack;
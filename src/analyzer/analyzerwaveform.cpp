@@ -1,17 +1,43 @@
 #include "analyzer/analyzerwaveform.h"
 
 #include "analyzer/analyzertrack.h"
+#include "analyzer/constants.h"
 #include "engine/engineobject.h"
 #include "engine/filters/enginefilterbessel4.h"
 #include "engine/filters/enginefilterbutterworth8.h"
+#include "sources/audiosourcestereoproxy.h"
 #include "track/track.h"
 #include "util/logger.h"
+#include "util/samplebuffer.h"
 #include "waveform/waveformfactory.h"
 
 namespace {
 
 mixxx::Logger kLogger("AnalyzerWaveform");
 
+// The coarse preview consists of short excerpts at regular intervals
+constexpr int kPreviewExcerptCount = 256;
+constexpr SINT kPreviewExcerptFrames = 4096;
+
+// Shorter tracks are decoded fast enough and don't need a preview
+constexpr SINT kPreviewMinFrames = 4 * kPreviewExcerptCount * kPreviewExcerptFrames;
+
+// Fills the visual samples that cover the frames with the data
+void fillPreview(Waveform* pWaveform,
+        SINT firstFrame,
+        SINT endFrame,
+        const WaveformData* pData) {
+    const double ratio = pWaveform->getAudioVisualRatio();
+    const int begin = static_cast<int>(firstFrame / ratio) * ChannelCount;
+    const int end = math_min(static_cast<int>(endFrame / ratio) * ChannelCount,
+            pWaveform->getDataSize());
+    WaveformData* pWaveformData = pWaveform->data();
+    for (int i = begin; i < end; i += ChannelCount) {
+        pWaveformData[i + Left] = pData[Left];
+        pWaveformData[i + Right] = pData[Right];
+    }
+}
+
 } // namespace
 
 AnalyzerWaveform::AnalyzerWaveform(
@@ -177,48 +203,13 @@ bool AnalyzerWaveform::processSamples(const CSAMPLE* buffer, const int bufferLen
         return false;
     }
 
-    //this should only append once if bufferLength is constant
-    if (bufferLength > (int)m_buffers[0].size()) {
-        m_buffers[Low].resize(bufferLength);
-        m_buffers[Mid].resize(bufferLength);
-        m_buffers[High].resize(bufferLength);
-    }
-
-    m_filter[Low]->process(buffer, &m_buffers[Low][0], bufferLength);
-    m_filter[Mid]->process(buffer, &m_buffers[Mid][0], bufferLength);
-    m_filter[High]->process(buffer, &m_buffers[High][0], bufferLength);
+    filterSamples(buffer, bufferLength);
 
     m_waveform->setSaveState(Waveform::SaveState::NotSaved);
     m_waveformSummary->setSaveState(Waveform::SaveState::NotSaved);
 
     for (int i = 0; i < bufferLength; i += 2) {
-        // Take max value, not average of data
-        CSAMPLE cover[2] = {fabs(buffer[i]), fabs(buffer[i + 1])};
-        CSAMPLE clow[2] = {fabs(m_buffers[Low][i]), fabs(m_buffers[Low][i + 1])};
-        CSAMPLE cmid[2] = {fabs(m_buffers[Mid][i]), fabs(m_buffers[Mid][i + 1])};
-        CSAMPLE chigh[2] = {fabs(m_buffers[High][i]), fabs(m_buffers[High][i + 1])};
-
-        // This is for if you want to experiment with averaging instead of
-        // maxing.
-        // m_stride.m_overallData[Right] += buffer[i]*buffer[i];
-        // m_stride.m_overallData[Left] += buffer[i + 1]*buffer[i + 1];
-        // m_stride.m_filteredData[Right][Low] += m_buffers[Low][i]*m_buffers[Low][i];
-        // m_stride.m_filteredData[Left][Low] += m_buffers[Low][i + 1]*m_buffers[Low][i + 1];
-        // m_stride.m_filteredData[Right][Mid] += m_buffers[Mid][i]*m_buffers[Mid][i];
-        // m_stride.m_filteredData[Left][Mid] += m_buffers[Mid][i + 1]*m_buffers[Mid][i + 1];
-        // m_stride.m_filteredData[Right][High] += m_buffers[High][i]*m_buffers[High][i];
-        // m_stride.m_filteredData[Left][High] += m_buffers[High][i + 1]*m_buffers[High][i + 1];
-
-        // Record the max across this stride.
-        storeIfGreater(&m_stride.m_overallData[Left], cover[Left]);
-        storeIfGreater(&m_stride.m_overallData[Right], cover[Right]);
-        storeIfGreater(&m_stride.m_filteredData[Left][Low], clow[Left]);
-        storeIfGreater(&m_stride.m_filteredData[Right][Low], clow[Right]);
-        storeIfGreater(&m_stride.m_filteredData[Left][Mid], cmid[Left]);
-        storeIfGreater(&m_stride.m_filteredData[Right][Mid], cmid[Right]);
-        storeIfGreater(&m_stride.m_filteredData[Left][High], chigh[Left]);
-        storeIfGreater(&m_stride.m_filteredData[Right][High], chigh[Right]);
-
+        storeMaximaInStride(&m_stride, buffer, i);
         m_stride.m_position++;
 
         if (fmod(m_stride.m_position, m_stride.m_length) < 1) {
@@ -258,6 +249,111 @@ bool AnalyzerWaveform::processSamples(const CSAMPLE* buffer, const int bufferLen
     return true;
 }
 
+void AnalyzerWaveform::processPreview(const mixxx::AudioSourcePointer& pAudioSource) {
+    if (!m_waveform || !m_waveformSummary) {
+        // The track is not analyzed
+        return;
+    }
+    const mixxx::IndexRange frameRange = pAudioSource->frameIndexRange();
+    if (frameRange.length() < kPreviewMinFrames) {
+        return;
+    }
+    PerformanceTimer timer;
+    timer.start();
+
+    mixxx::AudioSourceStereoProxy audioSourceProxy(pAudioSource, kPreviewExcerptFrames);
+    mixxx::SampleBuffer sampleBuffer(kPreviewExcerptFrames * mixxx::kAnalysisChannels);
+    for (int excerpt = 0; excerpt < kPreviewExcerptCount; ++excerpt) {
+        // The excerpt is taken from the middle of the part of the
+        // track that it represents
+        const SINT partStart = frameRange.length() * excerpt / kPreviewExcerptCount;
+        const SINT partEnd = frameRange.length() * (excerpt + 1) / kPreviewExcerptCount;
+        const SINT excerptStart = frameRange.start() +
+                (partStart + partEnd - kPreviewExcerptFrames) / 2;
+        const auto readableSampleFrames = audioSourceProxy.readSampleFrames(
+                mixxx::WritableSampleFrames(
+                        mixxx::IndexRange::forward(excerptStart, kPreviewExcerptFrames),
+                        mixxx::SampleBuffer::WritableSlice(sampleBuffer)));
+        if (readableSampleFrames.frameIndexRange().empty()) {
+            continue;
+        }
+        const CSAMPLE* pSamples = readableSampleFrames.readableData();
+        const int length = static_cast<int>(readableSampleFrames.readableLength());
+        filterSamples(pSamples, length);
+
+        // Average the strides of the excerpt like for the summary
+        WaveformStride stride(m_stride.m_length, m_stride.m_averageLength);
+        WaveformData strideData[ChannelCount];
+        for (int i = 0; i < length; i += 2) {
+            storeMaximaInStride(&stride, pSamples, i);
+            stride.m_position++;
+            if (fmod(stride.m_position, stride.m_length) < 1) {
+                stride.store(strideData);
+            }
+        }
+        WaveformData excerptData[ChannelCount];
+        stride.averageStore(excerptData);
+
+        fillPreview(m_waveform.data(), partStart, partEnd, excerptData);
+        fillPreview(m_waveformSummary.data(), partStart, partEnd, excerptData);
+    }
+
+    // Don't let the excerpts affect the analysis of the first samples.
+    // assumeSettled() only skips the ramping, it keeps the history of the
+    // filters, so they are created again.
+    destroyFilters();
+    createFilters(pAudioSource->getSignalInfo().getSampleRate());
+
+    m_waveform->setHasPreview(true);
+    m_waveformSummary->setHasPreview(true);
+
+    kLogger.debug() << "Waveform preview for" << kPreviewExcerptCount
+                    << "excerpts created" << timer.elapsed().debugSecondsWithUnit();
+}
+
+void AnalyzerWaveform::filterSamples(const CSAMPLE* buffer, int bufferLength) {
+    //this should only append once if bufferLength is constant
+    if (bufferLength > (int)m_buffers[0].size()) {
+        m_buffers[Low].resize(bufferLength);
+        m_buffers[Mid].resize(bufferLength);
+        m_buffers[High].resize(bufferLength);
+    }
+
+    m_filter[Low]->process(buffer, &m_buffers[Low][0], bufferLength);
+    m_filter[Mid]->process(buffer, &m_buffers[Mid][0], bufferLength);
+    m_filter[High]->process(buffer, &m_buffers[High][0], bufferLength);
+}
+
+void AnalyzerWaveform::storeMaximaInStride(
+        WaveformStride* pStride, const CSAMPLE* buffer, int i) {
+    // Take max value, not average of data
+    CSAMPLE cover[2] = {fabs(buffer[i]), fabs(buffer[i + 1])};
+    CSAMPLE clow[2] = {fabs(m_buffers[Low][i]), fabs(m_buffers[Low][i + 1])};
+    CSAMPLE cmid[2] = {fabs(m_buffers[Mid][i]), fabs(m_buffers[Mid][i + 1])};
+    CSAMPLE chigh[2] = {fabs(m_buffers[High][i]), fabs(m_buffers[High][i + 1])};
+
+    // This is for if you want to experiment with averaging instead of
+    // maxing.
+    // pStride->m_overallData[Right] += buffer[i]*buffer[i];
+    // pStride->m_overallData[Left] += buffer[i + 1]*buffer[i + 1];
+    // pStride->m_filteredData[Right][Low] += m_buffers[Low][i]*m_buffers[Low][i];
+    // pStride->m_filteredData[Left][Low] += m_buffers[Low][i + 1]*m_buffers[Low][i + 1];
+    // pStride->m_filteredData[Right][Mid] += m_buffers[Mid][i]*m_buffers[Mid][i];
+    // pStride->m_filteredData[Left][Mid] += m_buffers[Mid][i + 1]*m_buffers[Mid][i + 1];
+    // pStride->m_filteredData[Right][High] += m_buffers[High][i]*m_buffers[High][i];
+    // pStride->m_filteredData[Left][High] += m_buffers[High][i + 1]*m_buffers[High][i + 1];
+
+    // Record the max across this stride.
+    storeIfGreater(&pStride->m_overallData[Left], cover[Left]);
+    storeIfGreater(&pStride->m_overallData[Right], cover[Right]);
+    storeIfGreater(&pStride->m_filteredData[Left][Low], clow[Left]);
+    storeIfGreater(&pStride->m_filteredData[Right][Low], clow[Right]);
+    storeIfGreater(&pStride->m_filteredData[Left][Mid], cmid[Left]);
+    storeIfGreater(&pStride->m_filteredData[Right][Mid], cmid[Right]);
+    storeIfGreater(&pStride->m_filteredData[Left][High], chigh[Left]);
+    storeIfGreater(&pStride->m_filteredData[Right][High], chigh[Right]);
+}
+
 void AnalyzerWaveform::cleanup() {
     m_waveform.clear();
     m_waveformData = nullptr;
@@ -268,6 +364,7 @@ void AnalyzerWaveform::cleanup() {
 void AnalyzerWaveform::storeResults(TrackPointer tio) {
     // Force completion to waveform size
     if (m_waveform) {
+        m_waveform->setHasPreview(false);
         m_waveform->setSaveState(Waveform::SaveState::SavePending);
         m_waveform->setCompletion(m_waveform->getDataSize());
         m_waveform->setVersion(WaveformFactory::currentWaveformVersion());
@@ -277,6 +374,7 @@ void AnalyzerWaveform::storeResults(TrackPointer tio) {
 
     // Force completion to waveform size
     if (m_waveformSummary) {
+        m_waveformSummary->setHasPreview(false);
         m_waveformSummary->setSaveState(Waveform::SaveState::SavePending);
         m_waveformSummary->setCompletion(m_waveformSummary->getDataSize());
         m_waveformSummary->setVersion(WaveformFactory::currentWaveformSummaryVersion());
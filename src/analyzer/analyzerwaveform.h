@@ -8,6 +8,7 @@
 #include "analyzer/analyzer.h"
 #include "analyzer/analyzertrack.h"
 #include "library/dao/analysisdao.h"
+#include "sources/audiosource.h"
 #include "util/performancetimer.h"
 #include "waveform/waveform.h"
 
@@ -148,9 +149,18 @@ class AnalyzerWaveform : public Analyzer {
     void storeResults(TrackPointer tio) override;
     void cleanup() override;
 
+    /// Fills both waveforms with a coarse preview of the whole track
+    /// from short excerpts, which is replaced by processSamples() while
+    /// the analysis progresses. Must be invoked after initialize() and
+    /// before processSamples(). Short tracks don't get a preview.
+    void processPreview(const mixxx::AudioSourcePointer& pAudioSource);
+
   private:
     bool shouldAnalyze(TrackPointer tio) const;
 
+    void filterSamples(const CSAMPLE* buffer, int bufferLength);
+    void storeMaximaInStride(WaveformStride* pStride, const CSAMPLE* buffer, int i);
+
     void storeCurrentStridePower();
     void resetCurrentStride();
 
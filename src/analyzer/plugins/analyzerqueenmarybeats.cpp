@@ -22,6 +22,12 @@ constexpr float kStepSecs = 0.01161f;
 // results in 43 Hz @ 44.1 kHz / 47 Hz @ 48 kHz / 47 Hz @ 96 kHz
 constexpr int kMaximumBinSizeHz = 50; // Hz
 
+// The length of the segments in segmented mode. The complex spectral
+// difference only depends on the two preceding windows, i.e. the results
+// are exact after a few warm-up windows.
+constexpr float kSegmentSecs = 30.0f;
+constexpr size_t kSegmentWarmUpWindows = 4;
+
 DFConfig makeDetectionFunctionConfig(int stepSizeFrames, int windowSize) {
     // These are the defaults for the VAMP beat tracker plugin we used in Mixxx
     // 2.0.
@@ -38,8 +44,10 @@ DFConfig makeDetectionFunctionConfig(int stepSizeFrames, int windowSize) {
 
 } // namespace
 
-AnalyzerQueenMaryBeats::AnalyzerQueenMaryBeats()
-        : m_windowSize(0),
+AnalyzerQueenMaryBeats::AnalyzerQueenMaryBeats(bool segmented)
+        : m_segmented(segmented),
+          m_initialized(false),
+          m_windowSize(0),
           m_stepSizeFrames(0) {
 }
 
@@ -51,10 +59,28 @@ bool AnalyzerQueenMaryBeats::initialize(mixxx::audio::SampleRate sampleRate) {
     m_sampleRate = sampleRate;
     m_stepSizeFrames = static_cast<int>(m_sampleRate * kStepSecs);
     m_windowSize = MathUtilities::nextPowerOfTwo(m_sampleRate / kMaximumBinSizeHz);
-    m_pDetectionFunction = std::make_unique<DetectionFunction>(
-            makeDetectionFunctionConfig(m_stepSizeFrames, m_windowSize));
     qDebug() << "input sample rate is " << m_sampleRate << ", step size is " << m_stepSizeFrames;
 
+    if (m_segmented) {
+        const int windowSize = m_windowSize;
+        const int stepSizeFrames = m_stepSizeFrames;
+        m_initialized = m_segmentedHelper.initialize(m_windowSize,
+                m_stepSizeFrames,
+                static_cast<size_t>(kSegmentSecs / kStepSecs),
+                kSegmentWarmUpWindows,
+                [windowSize, stepSizeFrames]() {
+                    auto pDetectionFunction = std::make_shared<DetectionFunction>(
+                            makeDetectionFunctionConfig(stepSizeFrames, windowSize));
+                    return [pDetectionFunction](double* pWindow, size_t, double* pResult) {
+                        *pResult = pDetectionFunction->processTimeDomain(pWindow);
+                        return true;
+                    };
+                });
+        return m_initialized;
+    }
+
+    m_pDetectionFunction = std::make_unique<DetectionFunction>(
+            makeDetectionFunctionConfig(m_stepSizeFrames, m_windowSize));
     m_helper.initialize(
             m_windowSize, m_stepSizeFrames, [this](double* pWindow, size_t) {
                 // TODO(rryan) reserve?
@@ -62,20 +88,32 @@ bool AnalyzerQueenMaryBeats::initialize(mixxx::audio::SampleRate sampleRate) {
                         m_pDetectionFunction->processTimeDomain(pWindow));
                 return true;
             });
+    m_initialized = true;
     return true;
 }
 
 bool AnalyzerQueenMaryBeats::processSamples(const CSAMPLE* pIn, const int iLen) {
     DEBUG_ASSERT(iLen % kAnalysisChannels == 0);
-    if (!m_pDetectionFunction) {
+    if (!m_initialized) {
         return false;
     }
 
+    if (m_segmented) {
+        return m_segmentedHelper.processStereoSamples(pIn, iLen);
+    }
     return m_helper.processStereoSamples(pIn, iLen);
 }
 
 bool AnalyzerQueenMaryBeats::finalize() {
-    m_helper.finalize();
+    if (m_segmented) {
+        if (!m_segmentedHelper.finalize()) {
+            m_initialized = false;
+            return false;
+        }
+        m_detectionResults = m_segmentedHelper.results();
+    } else {
+        m_helper.finalize();
+    }
 
     int nonZeroCount = static_cast<int>(m_detectionResults.size());
     while (nonZeroCount > 0 && m_detectionResults.at(nonZeroCount - 1) <= 0.0) {
@@ -112,6 +150,7 @@ bool AnalyzerQueenMaryBeats::finalize() {
     }
 
     m_pDetectionFunction.reset();
+    m_initialized = false;
     return true;
 }
 
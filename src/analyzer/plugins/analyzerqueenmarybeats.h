@@ -25,7 +25,9 @@ class AnalyzerQueenMaryBeats : public AnalyzerBeatsPlugin {
                 true);
     }
 
-    AnalyzerQueenMaryBeats();
+    // In segmented mode the onsets of a single track are detected on
+    // multiple threads. The results are identical.
+    explicit AnalyzerQueenMaryBeats(bool segmented = false);
     ~AnalyzerQueenMaryBeats() override;
 
     AnalyzerPluginInfo info() const override {
@@ -45,8 +47,11 @@ class AnalyzerQueenMaryBeats : public AnalyzerBeatsPlugin {
     }
 
   private:
+    const bool m_segmented;
     std::unique_ptr<DetectionFunction> m_pDetectionFunction;
     DownmixAndOverlapHelper m_helper;
+    SegmentedDownmixAndOverlapHelper m_segmentedHelper;
+    bool m_initialized;
     mixxx::audio::SampleRate m_sampleRate;
     int m_windowSize;
     int m_stepSizeFrames;
@@ -17,10 +17,29 @@ namespace {
 // Tuning frequency of concert A in Hertz. Default value from VAMP plugin.
 constexpr int kTuningFrequencyHertz = 440;
 
+// The chroma and the detected keys are averaged over 10 windows each.
+// The warm-up restores both averages before the first window of the
+// segment.
+constexpr double kSegmentSecs = 60.0;
+constexpr double kSegmentWarmUpSecs = 20.0;
+
+mixxx::track::io::key::ChromaticKey toChromaticKey(int iKey) {
+    if (!ChromaticKey_IsValid(iKey)) {
+        qWarning() << "No valid key detected in analyzed window:" << iKey;
+        DEBUG_ASSERT(!"iKey is invalid");
+        return mixxx::track::io::key::INVALID;
+    }
+    return static_cast<ChromaticKey>(iKey);
+}
+
 } // namespace
 
-AnalyzerQueenMaryKey::AnalyzerQueenMaryKey()
-        : m_currentFrame(0),
+AnalyzerQueenMaryKey::AnalyzerQueenMaryKey(bool segmented)
+        : m_segmented(segmented),
+          m_initialized(false),
+          m_windowSize(0),
+          m_stepSize(0),
+          m_currentFrame(0),
           m_prevKey(mixxx::track::io::key::INVALID) {
 }
 
@@ -54,19 +73,34 @@ bool AnalyzerQueenMaryKey::initialize(mixxx::audio::SampleRate sampleRate) {
 
     GetKeyMode::Config config(sampleRate, kTuningFrequencyHertz);
     m_pKeyMode = std::make_unique<GetKeyMode>(config);
-    size_t windowSize = m_pKeyMode->getBlockSize();
-    size_t stepSize = m_pKeyMode->getHopSize();
-
-    return m_helper.initialize(
-            windowSize, stepSize, [this](double* pWindow, size_t) {
-                int iKey = m_pKeyMode->process(pWindow);
+    m_windowSize = m_pKeyMode->getBlockSize();
+    m_stepSize = m_pKeyMode->getHopSize();
+
+    if (m_segmented) {
+        // Each segment uses its own key detector
+        m_pKeyMode.reset();
+        const double stepSecs = m_stepSize / sampleRate.toDouble();
+        m_initialized = m_segmentedHelper.initialize(m_windowSize,
+                m_stepSize,
+                static_cast<size_t>(std::ceil(kSegmentSecs / stepSecs)),
+                static_cast<size_t>(std::ceil(kSegmentWarmUpSecs / stepSecs)),
+                [config]() {
+                    auto pKeyMode = std::make_shared<GetKeyMode>(config);
+                    return [pKeyMode](double* pWindow, size_t, double* pResult) {
+                        const auto key = toChromaticKey(pKeyMode->process(pWindow));
+                        *pResult = key;
+                        return key != mixxx::track::io::key::INVALID;
+                    };
+                });
+        return m_initialized;
+    }
 
-                if (!ChromaticKey_IsValid(iKey)) {
-                    qWarning() << "No valid key detected in analyzed window:" << iKey;
-                    DEBUG_ASSERT(!"iKey is invalid");
+    m_initialized = m_helper.initialize(
+            m_windowSize, m_stepSize, [this](double* pWindow, size_t) {
+                const auto key = toChromaticKey(m_pKeyMode->process(pWindow));
+                if (key == mixxx::track::io::key::INVALID) {
                     return false;
                 }
-                const auto key = static_cast<ChromaticKey>(iKey);
                 if (key != m_prevKey) {
                     // TODO(rryan) reserve?
                     m_resultKeys.push_back(qMakePair(
@@ -75,22 +109,46 @@ bool AnalyzerQueenMaryKey::initialize(mixxx::audio::SampleRate sampleRate) {
                 }
                 return true;
             });
+    return m_initialized;
 }
 
 bool AnalyzerQueenMaryKey::processSamples(const CSAMPLE* pIn, const int iLen) {
     DEBUG_ASSERT(iLen % kAnalysisChannels == 0);
-    if (!m_pKeyMode) {
+    if (!m_initialized) {
         return false;
     }
 
     const size_t numInputFrames = iLen / kAnalysisChannels;
     m_currentFrame += numInputFrames;
+    if (m_segmented) {
+        return m_segmentedHelper.processStereoSamples(pIn, iLen);
+    }
     return m_helper.processStereoSamples(pIn, iLen);
 }
 
 bool AnalyzerQueenMaryKey::finalize() {
-    m_helper.finalize();
+    if (m_segmented) {
+        if (!m_segmentedHelper.finalize()) {
+            m_initialized = false;
+            return false;
+        }
+        // The serial analysis records the position of the chunk that
+        // completed the window. Use the end of the window instead.
+        const auto& results = m_segmentedHelper.results();
+        for (size_t window = 0; window < results.size(); ++window) {
+            const auto key = static_cast<ChromaticKey>(static_cast<int>(results[window]));
+            if (key != m_prevKey) {
+                const size_t frame = math_min(
+                        window * m_stepSize + m_windowSize / 2, m_currentFrame);
+                m_resultKeys.push_back(qMakePair(key, static_cast<double>(frame)));
+                m_prevKey = key;
+            }
+        }
+    } else {
+        m_helper.finalize();
+    }
     m_pKeyMode.reset();
+    m_initialized = false;
     return true;
 }
 
@@ -25,7 +25,10 @@ class AnalyzerQueenMaryKey : public AnalyzerKeyPlugin {
                 false);
     }
 
-    AnalyzerQueenMaryKey();
+    // In segmented mode the chroma of a single track is analyzed on
+    // multiple threads. Each segment restores the averaging state of the
+    // key detector from the preceding 20 seconds.
+    explicit AnalyzerQueenMaryKey(bool segmented = false);
     ~AnalyzerQueenMaryKey() override;
 
     AnalyzerPluginInfo info() const override {
@@ -41,8 +44,13 @@ class AnalyzerQueenMaryKey : public AnalyzerKeyPlugin {
     }
 
   private:
+    const bool m_segmented;
     std::unique_ptr<GetKeyMode> m_pKeyMode;
     DownmixAndOverlapHelper m_helper;
+    SegmentedDownmixAndOverlapHelper m_segmentedHelper;
+    bool m_initialized;
+    size_t m_windowSize;
+    size_t m_stepSize;
     size_t m_currentFrame;
     KeyChangeList m_resultKeys;
     mixxx::track::io::key::ChromaticKey m_prevKey;
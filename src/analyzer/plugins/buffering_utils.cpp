@@ -1,29 +1,48 @@
 #include "analyzer/plugins/buffering_utils.h"
 
+#include <QThreadPool>
+#include <QtConcurrentRun>
+
 #include "util/math.h"
 #include "util/sample.h"
+#include "util/threadrole.h"
 
 #include <string.h>
 
 namespace mixxx {
 
+namespace {
+
+// Shared by the segments of all analyzer threads
+QThreadPool* segmentThreadPool() {
+    static QThreadPool s_threadPool;
+    return &s_threadPool;
+}
+
+} // anonymous namespace
+
 bool DownmixAndOverlapHelper::initialize(size_t windowSize,
         size_t stepSize,
-        const WindowReadyCallback& callback) {
+        const WindowReadyCallback& callback,
+        bool centerFirstWindow) {
     m_buffer.assign(windowSize, 0.0);
     m_callback = callback;
     m_windowSize = windowSize;
     m_stepSize = stepSize;
     // make sure the first frame is centered into the fft window. This makes sure
     // that the result is significant starting from the first step.
-    m_bufferWritePosition = windowSize / 2;
+    m_bufferWritePosition = centerFirstWindow ? windowSize / 2 : 0;
     return m_windowSize > 0 && m_stepSize > 0 &&
             m_stepSize <= m_windowSize && callback;
 }
 
 bool DownmixAndOverlapHelper::processStereoSamples(const CSAMPLE* pInput, size_t inputStereoSamples) {
     const size_t numInputFrames = inputStereoSamples / 2;
-    return processInner(pInput, numInputFrames);
+    return processInner(pInput, numInputFrames, 2);
+}
+
+bool DownmixAndOverlapHelper::processMonoSamples(const CSAMPLE* pInput, size_t inputMonoSamples) {
+    return processInner(pInput, inputMonoSamples, 1);
 }
 
 bool DownmixAndOverlapHelper::finalize() {
@@ -34,11 +53,11 @@ bool DownmixAndOverlapHelper::finalize() {
     // instead of "m_windowSize / 2 - m_stepSize"
     size_t framesToFillWindow = m_windowSize - m_bufferWritePosition;
     size_t numInputFrames = math_max(framesToFillWindow, m_windowSize / 2 - 1);
-    return processInner(nullptr, numInputFrames);
+    return processInner(nullptr, numInputFrames, 2);
 }
 
 bool DownmixAndOverlapHelper::processInner(
-        const CSAMPLE* pInput, size_t numInputFrames) {
+        const CSAMPLE* pInput, size_t numInputFrames, int channelCount) {
     size_t inRead = 0;
     double* pDownmix = m_buffer.data();
 
@@ -47,7 +66,11 @@ bool DownmixAndOverlapHelper::processInner(
         DEBUG_ASSERT(m_bufferWritePosition <= m_windowSize);
         size_t writeAvailable = m_windowSize - m_bufferWritePosition;
         size_t numFrames = math_min(readAvailable, writeAvailable);
-        if (pInput) {
+        if (pInput && channelCount == 1) {
+            for (size_t i = 0; i < numFrames; ++i) {
+                pDownmix[m_bufferWritePosition + i] = pInput[inRead + i];
+            }
+        } else if (pInput) {
             for (size_t i = 0; i < numFrames; ++i) {
                 // We analyze a mono downmix of the signal since we don't think
                 // stereo does us any good.
@@ -84,4 +107,173 @@ bool DownmixAndOverlapHelper::processInner(
     return true;
 }
 
+SegmentedDownmixAndOverlapHelper::~SegmentedDownmixAndOverlapHelper() {
+    waitForSegments();
+}
+
+bool SegmentedDownmixAndOverlapHelper::initialize(
+        size_t windowSize,
+        size_t stepSize,
+        size_t segmentWindows,
+        size_t warmUpWindows,
+        const WindowFunctionFactory& factory) {
+    waitForSegments();
+    m_segments.clear();
+    m_results.clear();
+    m_pendingSamples.clear();
+    m_pendingStartFrame = 0;
+    m_receivedFrames = 0;
+    m_nextSegment = 0;
+    m_windowSize = windowSize;
+    m_stepSize = stepSize;
+    m_segmentWindows = segmentWindows;
+    m_warmUpWindows = warmUpWindows;
+    m_windowFunctionFactory = factory;
+    // At least one warm-up window is needed to align the last segment
+    // with the serial windows
+    return m_windowSize > 0 && m_stepSize > 0 &&
+            m_stepSize <= m_windowSize && m_segmentWindows > 0 &&
+            m_warmUpWindows > 0 && factory;
+}
+
+// Window n covers the frames [n * step - windowSize / 2, n * step + windowSize / 2)
+size_t SegmentedDownmixAndOverlapHelper::segmentFirstWindow(size_t segment) const {
+    const size_t ownFirstWindow = segment * m_segmentWindows;
+    if (ownFirstWindow <= m_warmUpWindows) {
+        return 0;
+    }
+    const size_t firstWindow = ownFirstWindow - m_warmUpWindows;
+    if (firstWindow * m_stepSize < m_windowSize / 2) {
+        // Starts before the first frame
+        return 0;
+    }
+    return firstWindow;
+}
+
+size_t SegmentedDownmixAndOverlapHelper::segmentStartFrame(size_t segment) const {
+    const size_t firstWindow = segmentFirstWindow(segment);
+    if (firstWindow == 0) {
+        return 0;
+    }
+    return firstWindow * m_stepSize - m_windowSize / 2;
+}
+
+size_t SegmentedDownmixAndOverlapHelper::segmentEndFrame(size_t segment) const {
+    const size_t lastWindow = (segment + 1) * m_segmentWindows - 1;
+    return lastWindow * m_stepSize + m_windowSize / 2;
+}
+
+bool SegmentedDownmixAndOverlapHelper::processStereoSamples(
+        const CSAMPLE* pInput, size_t inputStereoSamples) {
+    const size_t numInputFrames = inputStereoSamples / 2;
+    const size_t offset = m_pendingSamples.size();
+    m_pendingSamples.resize(offset + numInputFrames);
+    for (size_t i = 0; i < numInputFrames; ++i) {
+        // Same downmix as DownmixAndOverlapHelper
+        m_pendingSamples[offset + i] = (pInput[i * 2] + pInput[i * 2 + 1]) * 0.5f;
+    }
+    m_receivedFrames += numInputFrames;
+
+    while (m_receivedFrames >= segmentEndFrame(m_nextSegment)) {
+        startSegment(segmentEndFrame(m_nextSegment), false);
+    }
+    return !anySegmentFailed();
+}
+
+bool SegmentedDownmixAndOverlapHelper::finalize() {
+    startSegment(m_receivedFrames, true);
+    bool ok = true;
+    for (auto& future : m_segments) {
+        const SegmentResult& result = future.result();
+        ok &= result.ok;
+        if (ok) {
+            m_results.insert(m_results.end(), result.results.begin(), result.results.end());
+        }
+    }
+    m_segments.clear();
+    m_pendingSamples.clear();
+    return ok;
+}
+
+void SegmentedDownmixAndOverlapHelper::startSegment(size_t endFrame, bool lastSegment) {
+    const size_t segment = m_nextSegment++;
+    const size_t startFrame = segmentStartFrame(segment);
+    DEBUG_ASSERT(startFrame >= m_pendingStartFrame);
+    DEBUG_ASSERT(endFrame <= m_pendingStartFrame + m_pendingSamples.size());
+    std::vector<CSAMPLE> samples(
+            m_pendingSamples.begin() + (startFrame - m_pendingStartFrame),
+            m_pendingSamples.begin() + (endFrame - m_pendingStartFrame));
+
+    // Don't buffer more segments than can be processed concurrently
+    const int maxPendingSegments = segmentThreadPool()->maxThreadCount() + 1;
+    int pendingSegments = 0;
+    for (auto it = m_segments.rbegin(); it != m_segments.rend(); ++it) {
+        if (!it->isFinished() && ++pendingSegments >= maxPendingSegments) {
+            it->waitForFinished();
+        }
+    }
+
+    const size_t firstWindow = segmentFirstWindow(segment);
+    const size_t skipWindows = segment * m_segmentWindows - firstWindow;
+    const size_t windowSize = m_windowSize;
+    const size_t stepSize = m_stepSize;
+    auto windowFunction = m_windowFunctionFactory();
+    m_segments.push_back(QtConcurrent::run(segmentThreadPool(),
+            [samples = std::move(samples),
+                    windowFunction = std::move(windowFunction),
+                    firstWindow,
+                    skipWindows,
+                    windowSize,
+                    stepSize,
+                    lastSegment]() {
+                const ScopedThreadRole threadRole(ThreadRole::Analyzer);
+                SegmentResult segmentResult;
+                size_t window = 0;
+                DownmixAndOverlapHelper helper;
+                const bool initialized = helper.initialize(
+                        windowSize,
+                        stepSize,
+                        [&](double* pWindow, size_t frames) {
+                            double result;
+                            if (!windowFunction(pWindow, frames, &result)) {
+                                return false;
+                            }
+                            if (window++ >= skipWindows) {
+                                segmentResult.results.push_back(result);
+                            }
+                            return true;
+                        },
+                        firstWindow == 0);
+                segmentResult.ok = initialized &&
+                        helper.processMonoSamples(samples.data(), samples.size()) &&
+                        (!lastSegment || helper.finalize());
+                return segmentResult;
+            }));
+
+    // Drop the samples that are not needed by the next segment
+    const size_t nextStartFrame = segmentStartFrame(m_nextSegment);
+    if (nextStartFrame > m_pendingStartFrame) {
+        const size_t dropFrames = math_min(
+                nextStartFrame - m_pendingStartFrame, m_pendingSamples.size());
+        m_pendingSamples.erase(m_pendingSamples.begin(),
+                m_pendingSamples.begin() + dropFrames);
+        m_pendingStartFrame += dropFrames;
+    }
+}
+
+bool SegmentedDownmixAndOverlapHelper::anySegmentFailed() const {
+    for (const auto& future : m_segments) {
+        if (future.isFinished() && !future.result().ok) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void SegmentedDownmixAndOverlapHelper::waitForSegments() {
+    for (auto& future : m_segments) {
+        future.waitForFinished();
+    }
+}
+
 } // namespace mixxx
@@ -1,7 +1,9 @@
 #pragma once
 
-#include <vector>
+#include <QFuture>
+#include <deque>
 #include <functional>
+#include <vector>
 
 #include "util/types.h"
 
@@ -16,19 +18,27 @@ class DownmixAndOverlapHelper {
 
     typedef std::function<bool(double* pBuffer, size_t frames)> WindowReadyCallback;
 
+    // The first window is centered around the first frame unless
+    // centerFirstWindow is false. Then it starts at the first frame.
     bool initialize(
             size_t windowSize,
             size_t stepSize,
-            const WindowReadyCallback& callback);
+            const WindowReadyCallback& callback,
+            bool centerFirstWindow = true);
 
     bool processStereoSamples(
             const CSAMPLE* pInput,
             size_t inputStereoSamples);
 
+    // For input that has already been downmixed
+    bool processMonoSamples(
+            const CSAMPLE* pInput,
+            size_t inputMonoSamples);
+
     bool finalize();
 
   private:
-    bool processInner(const CSAMPLE* pInput, size_t numInputFrames);
+    bool processInner(const CSAMPLE* pInput, size_t numInputFrames, int channelCount);
 
     std::vector<double> m_buffer;
     // The window size in frames.
@@ -39,4 +49,71 @@ class DownmixAndOverlapHelper {
     WindowReadyCallback m_callback;
 };
 
+// Processes the windows of DownmixAndOverlapHelper in segments that are
+// analyzed concurrently while the track is still being decoded. Each segment
+// starts with a few warm-up windows whose results are discarded. They restore
+// the state of window functions that depend on the preceding windows, e.g.
+// the spectral history of an onset detection function. The results are
+// merged in window order, i.e. they do not depend on the number of threads.
+class SegmentedDownmixAndOverlapHelper {
+  public:
+    // Processes the windows of a single segment in order and stores one
+    // result per window.
+    typedef std::function<bool(double* pWindow, size_t windowSize, double* pResult)>
+            WindowFunction;
+    // Creates a window function with a fresh state for each segment.
+    typedef std::function<WindowFunction()> WindowFunctionFactory;
+
+    SegmentedDownmixAndOverlapHelper() = default;
+    // Waits for pending segments
+    ~SegmentedDownmixAndOverlapHelper();
+
+    bool initialize(
+            size_t windowSize,
+            size_t stepSize,
+            size_t segmentWindows,
+            size_t warmUpWindows,
+            const WindowFunctionFactory& factory);
+
+    bool processStereoSamples(
+            const CSAMPLE* pInput,
+            size_t inputStereoSamples);
+
+    // Waits until all segments have been processed
+    bool finalize();
+
+    // The result of every window, available after finalize()
+    const std::vector<double>& results() const {
+        return m_results;
+    }
+
+  private:
+    struct SegmentResult {
+        bool ok = false;
+        // Without the warm-up windows
+        std::vector<double> results;
+    };
+
+    size_t segmentFirstWindow(size_t segment) const;
+    size_t segmentStartFrame(size_t segment) const;
+    size_t segmentEndFrame(size_t segment) const;
+    void startSegment(size_t endFrame, bool lastSegment);
+    bool anySegmentFailed() const;
+    void waitForSegments();
+
+    size_t m_windowSize = 0;
+    size_t m_stepSize = 0;
+    size_t m_segmentWindows = 0;
+    size_t m_warmUpWindows = 0;
+    WindowFunctionFactory m_windowFunctionFactory;
+
+    // The mono downmix that has not been assigned to a segment yet
+    std::vector<CSAMPLE> m_pendingSamples;
+    size_t m_pendingStartFrame = 0;
+    size_t m_receivedFrames = 0;
+    size_t m_nextSegment = 0;
+    std::deque<QFuture<SegmentResult>> m_segments;
+    std::vector<double> m_results;
+};
+
 } // namespace mixxx
@@ -1,5 +1,7 @@
 #include "analyzer/trackanalysisscheduler.h"
 
+#include <algorithm>
+
 #include "analyzer/analyzerscheduledtrack.h"
 #include "analyzer/analyzertrack.h"
 #include "moc_trackanalysisscheduler.cpp"
@@ -57,6 +59,7 @@ TrackAnalysisScheduler::TrackAnalysisScheduler(
           m_currentTrackProgress(kAnalyzerProgressUnknown),
           m_currentTrackNumber(0),
           m_dequeuedTracksCount(0),
+          m_skippedTracksCount(0),
           // The first signal should always be emitted
           m_lastProgressEmittedAt(Clock::now() - kProgressInhibitDuration) {
     DEBUG_ASSERT(m_pEnvironment);
@@ -83,6 +86,10 @@ TrackAnalysisScheduler::TrackAnalysisScheduler(
                 &AnalyzerThread::progress,
                 this,
                 &TrackAnalysisScheduler::onWorkerThreadProgress);
+        connect(m_workers.back().thread(),
+                &AnalyzerThread::analysisSkipped,
+                this,
+                &TrackAnalysisScheduler::onWorkerThreadAnalysisSkipped);
     }
     // 2nd pass: Start worker threads in a suspended state
     for (const auto& worker: m_workers) {
@@ -99,9 +106,18 @@ void TrackAnalysisScheduler::emitProgressOrFinished() {
     // The finished() signal is emitted regardless of when the last
     // signal has been emitted
     if (allTracksFinished()) {
+        if (m_skippedTracksCount > 0) {
+            kLogger.info()
+                    << "Skipped the analysis of"
+                    << m_skippedTracksCount
+                    << "of"
+                    << m_dequeuedTracksCount
+                    << "tracks by reusing the results of tracks with identical audio";
+        }
         m_currentTrackProgress = kAnalyzerProgressUnknown;
         m_currentTrackNumber = 0;
         m_dequeuedTracksCount = 0;
+        m_skippedTracksCount = 0;
         emit finished();
         return;
     }
@@ -113,10 +129,10 @@ void TrackAnalysisScheduler::emitProgressOrFinished() {
     }
     m_lastProgressEmittedAt = now;
 
-    DEBUG_ASSERT(m_pendingTrackIds.size() <=
+    DEBUG_ASSERT(m_pendingTracks.size() <=
             static_cast<size_t>(m_dequeuedTracksCount));
     const int finishedTracksCount =
-            m_dequeuedTracksCount - static_cast<int>(m_pendingTrackIds.size());
+            m_dequeuedTracksCount - static_cast<int>(m_pendingTracks.size());
 
     AnalyzerProgress workerProgressSum = 0;
     int workerProgressCount = 0;
@@ -171,7 +187,7 @@ void TrackAnalysisScheduler::emitProgressOrFinished() {
         }
     }
     const int totalTracksCount =
-            m_dequeuedTracksCount + static_cast<int>(m_queuedTracks.size());
+            m_dequeuedTracksCount + queuedTracksCount();
     DEBUG_ASSERT(m_currentTrackNumber <= m_dequeuedTracksCount);
     DEBUG_ASSERT(m_dequeuedTracksCount <= totalTracksCount);
     emit progress(
@@ -202,12 +218,18 @@ void TrackAnalysisScheduler::onWorkerThreadProgress(
         DEBUG_ASSERT(!trackId.isValid());
         DEBUG_ASSERT(analyzerProgress == kAnalyzerProgressUnknown);
         worker.onAnalyzerProgress(analyzerProgress);
-        submitNextTrack(&worker);
+        {
+            const int queuedCount = queuedTracksCount();
+            submitNextTrack(&worker);
+            if (queuedTracksCount() != queuedCount) {
+                emit queueChanged();
+            }
+        }
         break;
     case AnalyzerThreadState::Busy:
         DEBUG_ASSERT(trackId.isValid());
         // Ignore delayed signals for tracks that are no longer pending
-        if (m_pendingTrackIds.find(trackId) != m_pendingTrackIds.end()) {
+        if (m_pendingTracks.find(trackId) != m_pendingTracks.end()) {
             DEBUG_ASSERT(analyzerProgress != kAnalyzerProgressUnknown);
             DEBUG_ASSERT(analyzerProgress < kAnalyzerProgressDone);
             worker.onAnalyzerProgress(analyzerProgress);
@@ -217,12 +239,13 @@ void TrackAnalysisScheduler::onWorkerThreadProgress(
     case AnalyzerThreadState::Done:
         DEBUG_ASSERT(trackId.isValid());
         // Ignore delayed signals for tracks that are no longer pending
-        if (m_pendingTrackIds.find(trackId) != m_pendingTrackIds.end()) {
+        if (m_pendingTracks.find(trackId) != m_pendingTracks.end()) {
             DEBUG_ASSERT((analyzerProgress == kAnalyzerProgressDone) // success
                     || (analyzerProgress == kAnalyzerProgressUnknown)); // failure
-            m_pendingTrackIds.erase(trackId);
+            m_pendingTracks.erase(trackId);
             worker.onAnalyzerProgress(analyzerProgress);
             emit trackProgress(trackId, analyzerProgress);
+            emit queueChanged();
         }
         break;
     case AnalyzerThreadState::Exit:
@@ -237,14 +260,51 @@ void TrackAnalysisScheduler::onWorkerThreadProgress(
     emitProgressOrFinished();
 }
 
-bool TrackAnalysisScheduler::scheduleTrack(AnalyzerScheduledTrack track) {
-    VERIFY_OR_DEBUG_ASSERT(track.getTrackId().isValid()) {
+void TrackAnalysisScheduler::onWorkerThreadAnalysisSkipped(
+        int threadId,
+        TrackId trackId) {
+    Q_UNUSED(threadId);
+    // Ignore delayed signals for tracks that are no longer pending
+    if (m_pendingTracks.find(trackId) != m_pendingTracks.end()) {
+        ++m_skippedTracksCount;
+    }
+}
+
+bool TrackAnalysisScheduler::scheduleTrack(
+        AnalyzerScheduledTrack track,
+        Priority priority) {
+    const TrackId trackId = track.getTrackId();
+    VERIFY_OR_DEBUG_ASSERT(trackId.isValid()) {
         qWarning()
                 << "Cannot schedule track with invalid id"
-                << track.getTrackId();
+                << trackId;
         return false;
     }
-    m_queuedTracks.push_back(track);
+    QueuedTrack queuedTrack{std::move(track), Clock::now()};
+    if (priority == Priority::High) {
+        const auto hasTrackId = [trackId](const QueuedTrack& other) {
+            return other.track.getTrackId() == trackId;
+        };
+        if (m_pendingTracks.find(trackId) != m_pendingTracks.end() ||
+                std::any_of(m_priorityQueuedTracks.begin(),
+                        m_priorityQueuedTracks.end(),
+                        hasTrackId)) {
+            // Already analyzed or waiting for analysis
+            return true;
+        }
+        // Move a track that is already waiting ahead and keep
+        // the time when it has been scheduled
+        const auto it = std::find_if(
+                m_queuedTracks.begin(), m_queuedTracks.end(), hasTrackId);
+        if (it != m_queuedTracks.end()) {
+            queuedTrack.scheduledAt = it->scheduledAt;
+            m_queuedTracks.erase(it);
+        }
+        m_priorityQueuedTracks.push_back(std::move(queuedTrack));
+    } else {
+        m_queuedTracks.push_back(std::move(queuedTrack));
+    }
+    emit queueChanged();
     // Don't wake up the suspended thread now to avoid race conditions
     // if multiple threads are added in a row by calling this function
     // multiple times. The caller is responsible to finish the scheduling
@@ -276,10 +336,37 @@ void TrackAnalysisScheduler::resume() {
     }
 }
 
+mixxx::Duration TrackAnalysisScheduler::longestWaitTime() const {
+    if (allTracksFinished()) {
+        return mixxx::Duration::empty();
+    }
+    const auto now = Clock::now();
+    auto scheduledAt = now;
+    // Tracks that have been moved into the priority lane might have
+    // been scheduled before those in front of it
+    for (const auto& queuedTrack : m_priorityQueuedTracks) {
+        scheduledAt = std::min(scheduledAt, queuedTrack.scheduledAt);
+    }
+    if (!m_queuedTracks.empty()) {
+        scheduledAt = std::min(scheduledAt, m_queuedTracks.front().scheduledAt);
+    }
+    for (const auto& pendingTrack : m_pendingTracks) {
+        scheduledAt = std::min(scheduledAt, pendingTrack.second);
+    }
+    return mixxx::Duration::fromNanos(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(now - scheduledAt)
+                    .count());
+}
+
 bool TrackAnalysisScheduler::submitNextTrack(Worker* worker) {
     DEBUG_ASSERT(worker);
-    while (!m_queuedTracks.empty()) {
-        AnalyzerScheduledTrack nextScheduledTrack = m_queuedTracks.front();
+    while (queuedTracksCount() > 0) {
+        // The priority lane is always served first
+        auto& queuedTracks = m_priorityQueuedTracks.empty()
+                ? m_queuedTracks
+                : m_priorityQueuedTracks;
+        const QueuedTrack nextQueuedTrack = queuedTracks.front();
+        const AnalyzerScheduledTrack& nextScheduledTrack = nextQueuedTrack.track;
         TrackId nextTrackId = nextScheduledTrack.getTrackId();
         DEBUG_ASSERT(nextTrackId.isValid());
         if (nextTrackId.isValid()) {
@@ -287,15 +374,16 @@ bool TrackAnalysisScheduler::submitNextTrack(Worker* worker) {
                     m_pEnvironment->loadTrackById(nextTrackId);
             if (nextTrackPtr) {
                 AnalyzerTrack nextTrack(nextTrackPtr, nextScheduledTrack.getOptions());
-                if (m_pendingTrackIds.insert(nextTrackId).second) {
+                if (m_pendingTracks.emplace(nextTrackId, nextQueuedTrack.scheduledAt)
+                                .second) {
                     if (worker->submitNextTrack(std::move(nextTrack))) {
-                        m_queuedTracks.pop_front();
+                        queuedTracks.pop_front();
                         ++m_dequeuedTracksCount;
                         return true;
                     } else {
                         // The worker may already have been assigned new tasks
                         // in the mean time, nothing to worry about.
-                        m_pendingTrackIds.erase(nextTrackId);
+                        m_pendingTracks.erase(nextTrackId);
                         kLogger.debug()
                                 << "Failed to submit next track - worker thread"
                                 << worker->thread()->id()
@@ -320,7 +408,7 @@ bool TrackAnalysisScheduler::submitNextTrack(Worker* worker) {
                     << nextTrackId;
         }
         // Skip this track
-        m_queuedTracks.pop_front();
+        queuedTracks.pop_front();
         ++m_dequeuedTracksCount;
     }
     return false;
@@ -333,7 +421,8 @@ void TrackAnalysisScheduler::stop() {
     }
     // The worker threads are still running at this point
     // and m_workers must not be modified!
+    m_priorityQueuedTracks.clear();
     m_queuedTracks.clear();
-    m_pendingTrackIds.clear();
+    m_pendingTracks.clear();
     DEBUG_ASSERT((allTracksFinished()));
 }
@@ -1,15 +1,17 @@
 #pragma once
 
 #include <QList>
+#include <chrono>
 #include <deque>
+#include <map>
 #include <memory>
-#include <set>
 #include <vector>
 
 #include "analyzer/analyzerscheduledtrack.h"
 #include "analyzer/analyzerthread.h"
 #include "analyzer/analyzertrack.h"
 #include "util/db/dbconnectionpool.h"
+#include "util/duration.h"
 
 /// Callbacks for triggering side-effects in the outer context of
 /// TrackAnalysisScheduler.
@@ -49,11 +51,29 @@ class TrackAnalysisScheduler : public QObject {
             AnalyzerModeFlags modeFlags);
     ~TrackAnalysisScheduler() override;
 
+    enum class Priority {
+        Normal,
+        // For tracks that a DJ is waiting for, e.g. after loading them
+        // into a deck. They are analyzed before all queued tracks with
+        // a normal priority.
+        High,
+    };
+
     // Schedule single or multiple tracks. After all tracks have been scheduled
     // the caller must invoke resume() once.
-    bool scheduleTrack(AnalyzerScheduledTrack track);
+    bool scheduleTrack(AnalyzerScheduledTrack track, Priority priority = Priority::Normal);
     int scheduleTracks(const QList<AnalyzerScheduledTrack>& tracks);
 
+    // The number of scheduled tracks that are either queued or
+    // currently analyzed
+    int unfinishedTracksCount() const {
+        return queuedTracksCount() + static_cast<int>(m_pendingTracks.size());
+    }
+
+    // The time since the longest waiting unfinished track has been
+    // scheduled, empty if all tracks are finished
+    mixxx::Duration longestWaitTime() const;
+
   public slots:
     void suspend();
 
@@ -70,11 +90,16 @@ class TrackAnalysisScheduler : public QObject {
     // Current average progress for all scheduled tracks and from all workers
     void progress(AnalyzerProgress currentTrackProgress, int currentTrackNumber, int totalTracksCount);
     void finished();
+    // Tracks have been scheduled, submitted to a worker or finished
+    void queueChanged();
 
   private slots:
     void onWorkerThreadProgress(int threadId, AnalyzerThreadState threadState, TrackId trackId, AnalyzerProgress analyzerProgress);
+    void onWorkerThreadAnalysisSkipped(int threadId, TrackId trackId);
 
   private:
+    friend class TrackAnalysisSchedulerTest;
+
     // Owns an analyzer thread and buffers the most recent progress update
     // received from this thread during analysis. It does not need to be
     // thread-safe, because all functions are invoked from the host thread
@@ -140,23 +165,38 @@ class TrackAnalysisScheduler : public QObject {
         AnalyzerProgress m_analyzerProgress;
     };
 
+    typedef std::chrono::steady_clock Clock;
+
+    struct QueuedTrack {
+        AnalyzerScheduledTrack track;
+        Clock::time_point scheduledAt;
+    };
+
     bool submitNextTrack(Worker* worker);
     void emitProgressOrFinished();
 
+    int queuedTracksCount() const {
+        return static_cast<int>(m_priorityQueuedTracks.size() + m_queuedTracks.size());
+    }
+
     bool allTracksFinished() const {
-        return m_queuedTracks.empty() &&
-                m_pendingTrackIds.empty();
+        return m_priorityQueuedTracks.empty() &&
+                m_queuedTracks.empty() &&
+                m_pendingTracks.empty();
     }
 
     const std::unique_ptr<const TrackAnalysisSchedulerEnvironment> m_pEnvironment;
 
     std::vector<Worker> m_workers;
 
-    std::deque<AnalyzerScheduledTrack> m_queuedTracks;
+    // Tracks with Priority::High are submitted to workers first
+    std::deque<QueuedTrack> m_priorityQueuedTracks;
+    std::deque<QueuedTrack> m_queuedTracks;
 
     // Tracks that have already been submitted to workers
-    // and not yet reported back as finished.
-    std::set<TrackId> m_pendingTrackIds;
+    // and not yet reported back as finished, mapped to the
+    // time when they have been scheduled.
+    std::map<TrackId, Clock::time_point> m_pendingTracks;
 
     AnalyzerProgress m_currentTrackProgress;
 
@@ -164,6 +204,9 @@ class TrackAnalysisScheduler : public QObject {
 
     int m_dequeuedTracksCount;
 
-    typedef std::chrono::steady_clock Clock;
+    // Tracks that reused the analysis results of other
+    // tracks with identical audio
+    int m_skippedTracksCount;
+
     Clock::time_point m_lastProgressEmittedAt;
 };
@@ -9,6 +9,7 @@
 #include "moc_controllermanager.cpp"
 #include "util/cmdlineargs.h"
 #include "util/compatibility/qmutex.h"
+#include "util/threadrole.h"
 #include "util/time.h"
 #include "util/trace.h"
 #ifdef __HSS1394__
@@ -87,7 +88,8 @@ ControllerManager::ControllerManager(UserSettingsPointer pConfig)
           // its own event loop.
           m_pControllerLearningEventFilter(new ControllerLearningEventFilter()),
           m_pollTimer(this),
-          m_skipPoll(false) {
+          m_skipPoll(false),
+          m_threadRoleId(-1) {
     qRegisterMetaType<std::shared_ptr<LegacyControllerMapping>>(
             "std::shared_ptr<LegacyControllerMapping>");
 
@@ -137,6 +139,9 @@ ControllerLearningEventFilter* ControllerManager::getControllerLearningEventFilt
 void ControllerManager::slotInitialize() {
     qDebug() << "ControllerManager:slotInitialize";
 
+    m_threadRoleId = mixxx::ThreadRoleRegistry::registerCurrentThread(
+            mixxx::ThreadRole::Controller);
+
     // Initialize mapping info parsers. This object is only for use in the main
     // thread. Do not touch it from within ControllerManager.
     m_pMainThreadUserMappingEnumerator = QSharedPointer<MappingInfoEnumerator>(
@@ -174,6 +179,7 @@ void ControllerManager::slotShutdown() {
     }
 
     // Stop the processor after the enumerators since the engines live in it
+    mixxx::ThreadRoleRegistry::unregisterThread(m_threadRoleId);
     m_pThread->quit();
 }
 
@@ -84,4 +84,6 @@ class ControllerManager : public QObject {
     QSharedPointer<MappingInfoEnumerator> m_pMainThreadUserMappingEnumerator;
     QSharedPointer<MappingInfoEnumerator> m_pMainThreadSystemMappingEnumerator;
     bool m_skipPoll;
+    // Registration of m_pThread in the ThreadRoleRegistry
+    int m_threadRoleId;
 };
@@ -12,7 +12,9 @@
 HidController::HidController(
         mixxx::hid::DeviceInfo&& deviceInfo)
         : Controller(deviceInfo.formatName()),
-          m_deviceInfo(std::move(deviceInfo)) {
+          m_deviceInfo(std::move(deviceInfo)),
+          m_inputFieldGeneration(0) {
+    qRegisterMetaType<QVector<HidChangedField>>("QVector<HidChangedField>");
     setDeviceCategory(mixxx::hid::DeviceCategory::guessFromDeviceInfo(m_deviceInfo));
 
     // All HID devices are full-duplex
@@ -107,12 +109,19 @@ int HidController::open() {
 
     m_pHidIoThread = std::make_unique<HidIoThread>(pHidDevice, m_deviceInfo);
     m_pHidIoThread->setObjectName(QStringLiteral("HidIoThread ") + getName());
+    // The fields of the new thread start with the initial generation
+    m_inputFieldGeneration = m_pHidIoThread->inputReportFieldGeneration();
 
     connect(m_pHidIoThread.get(),
             &HidIoThread::receive,
             this,
             &HidController::receive,
             Qt::QueuedConnection);
+    connect(m_pHidIoThread.get(),
+            &HidIoThread::receiveChangedFields,
+            this,
+            &HidController::receiveChangedFields,
+            Qt::QueuedConnection);
 
     // Controller input needs to be prioritized since it can affect the
     // audio directly, like when scratching
@@ -163,6 +172,9 @@ int HidController::close() {
     // This executes the shutdown function of the JavaScript mapping
     stopEngine();
 
+    // The bindings could hold JavaScript callbacks of the stopped engine
+    m_inputFieldBindings.clear();
+
     if (m_pHidIoThread) {
         disconnect(m_pHidIoThread.get());
 
@@ -206,6 +218,71 @@ void HidController::sendBytes(const QByteArray& data) {
     m_pHidIoThread->updateCachedOutputReportData(0, data, false);
 }
 
+int HidController::registerInputField(InputFieldBinding&& binding) {
+    VERIFY_OR_DEBUG_ASSERT(m_pHidIoThread) {
+        return -1;
+    }
+    const int fieldId = m_pHidIoThread->registerInputReportField(binding.field);
+    if (fieldId < 0) {
+        qCWarning(m_logInput) << "Invalid InputReport field at byte offset"
+                              << binding.field.byteOffset << "bit offset"
+                              << binding.field.bitOffset << "with"
+                              << binding.field.bitSize << "bits";
+        return -1;
+    }
+    // Field IDs are assigned consecutively by the HidInputReportParser
+    DEBUG_ASSERT(static_cast<std::size_t>(fieldId) == m_inputFieldBindings.size());
+    m_inputFieldBindings.push_back(std::move(binding));
+    return fieldId;
+}
+
+void HidController::clearInputFields() {
+    VERIFY_OR_DEBUG_ASSERT(m_pHidIoThread) {
+        return;
+    }
+    m_inputFieldGeneration = m_pHidIoThread->clearInputReportFields();
+    m_inputFieldBindings.clear();
+}
+
+void HidController::receiveChangedFields(
+        const QVector<HidChangedField>& changedFields,
+        mixxx::Duration timestamp) {
+    ControllerScriptEngineLegacy* pEngine = getScriptEngine();
+    if (!pEngine) {
+        // Don't complain, since this will always show after closing a device as
+        // queued signals flush out
+        return;
+    }
+    triggerActivity();
+
+    for (const auto& changedField : changedFields) {
+        // Fields of previously registered bindings may still be queued,
+        // after the mapping cleared them. Their IDs may already be reused
+        // by new bindings.
+        if (changedField.generation != m_inputFieldGeneration ||
+                changedField.fieldId < 0 ||
+                static_cast<std::size_t>(changedField.fieldId) >=
+                        m_inputFieldBindings.size()) {
+            continue;
+        }
+        const InputFieldBinding& binding = m_inputFieldBindings[changedField.fieldId];
+        qCDebug(m_logInput) << "t:" << timestamp.formatMillisWithUnit()
+                            << "InputReport field" << changedField.fieldId
+                            << "changed to" << changedField.value;
+        if (binding.pControl) {
+            binding.pControl->setParameter(
+                    static_cast<double>(changedField.value) /
+                    binding.field.maxUnsignedValue());
+        } else {
+            const auto args = QJSValueList{
+                    static_cast<double>(changedField.value),
+                    changedField.fieldId,
+            };
+            pEngine->executeFunction(binding.callback, args);
+        }
+    }
+}
+
 ControllerJSProxy* HidController::jsProxy() {
     return new HidControllerJSProxy(this);
 }
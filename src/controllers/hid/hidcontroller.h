@@ -1,7 +1,10 @@
 #pragma once
 
+#include <QJSValue>
 #include <QThread>
+#include <vector>
 
+#include "control/pollingcontrolproxy.h"
 #include "controllers/controller.h"
 #include "controllers/hid/hiddevice.h"
 #include "controllers/hid/hidiothread.h"
@@ -36,7 +39,24 @@ class HidController final : public Controller {
     int open() override;
     int close() override;
 
+    /// Dispatches the natively unpacked InputReport fields to the bound
+    /// controls or JavaScript callbacks
+    void receiveChangedFields(const QVector<HidChangedField>& changedFields,
+            mixxx::Duration timestamp);
+
   private:
+    /// Binding of a registered InputReport field, either to a control,
+    /// whose parameter is set to the normalized field value, or to a
+    /// JavaScript callback
+    struct InputFieldBinding {
+        HidReportField field;
+        std::unique_ptr<PollingControlProxy> pControl;
+        QJSValue callback;
+    };
+
+    int registerInputField(InputFieldBinding&& binding);
+    void clearInputFields();
+
     // For devices which only support a single report, reportID must be set to
     // 0x0.
     void sendBytes(const QByteArray& data) override;
@@ -46,6 +66,11 @@ class HidController final : public Controller {
     std::unique_ptr<HidIoThread> m_pHidIoThread;
     std::shared_ptr<LegacyHidControllerMapping> m_pMapping;
 
+    /// Indexed by the field ID returned by HidIoThread::registerInputReportField
+    std::vector<InputFieldBinding> m_inputFieldBindings;
+    /// Field generation of m_inputFieldBindings, see HidChangedField::generation
+    int m_inputFieldGeneration;
+
     friend class HidControllerJSProxy;
 };
 
@@ -99,6 +124,103 @@ class HidControllerJSProxy : public ControllerJSProxy {
                 reportID, dataArray, resendUnchangedReport);
     }
 
+    /// @brief Changes a single packed field of an OutputReport. The report is
+    ///        only sent to the device, if at least one bit actually changed.
+    /// @details The report must have been sent once with sendOutputReport before,
+    ///          which defines its size and the initial values of all other fields.
+    /// @param reportID 1...255 for HID devices that uses ReportIDs - or 0 for devices, which don't use ReportIDs
+    /// @param byteOffset Offset of the field in the report data in bytes (without ReportID)
+    /// @param bitOffset Offset of the least significant bit in the first byte (0...7)
+    /// @param bitSize Number of bits of the field (1...32)
+    /// @param value New value of the field
+    Q_INVOKABLE void setOutputReportField(quint8 reportID,
+            int byteOffset,
+            int bitOffset,
+            int bitSize,
+            quint32 value) {
+        VERIFY_OR_DEBUG_ASSERT(m_pHidController->m_pHidIoThread) {
+            return;
+        }
+        HidReportField field;
+        field.reportId = reportID;
+        field.byteOffset = byteOffset;
+        field.bitOffset = bitOffset;
+        field.bitSize = bitSize;
+        m_pHidController->m_pHidIoThread->updateCachedOutputReportField(
+                reportID, field, value);
+    }
+
+    /// @brief Registers a packed InputReport field, which is unpacked and
+    ///        compared natively. The callback is only called if the value changed.
+    /// @details InputReports containing registered fields are no longer passed to
+    ///          the incomingData function of the mapping.
+    /// @param reportID 1...255 for HID devices that uses ReportIDs - or 0 for devices, which don't use ReportIDs
+    /// @param byteOffset Offset of the field in bytes, including the ReportID byte
+    ///                   for HID devices which use ReportIDs (same as in incomingData)
+    /// @param bitOffset Offset of the least significant bit in the first byte (0...7)
+    /// @param bitSize Number of bits of the field (1...32)
+    /// @param callback Function called with (value, fieldId) on every change
+    /// @param isSigned If set, the field is interpreted as two's complement
+    /// @return The field ID, or -1 if the field is invalid
+    Q_INVOKABLE int registerInputField(quint8 reportID,
+            int byteOffset,
+            int bitOffset,
+            int bitSize,
+            const QJSValue& callback,
+            bool isSigned = false) {
+        if (!callback.isCallable()) {
+            qCWarning(m_pHidController->m_logInput)
+                    << "registerInputField requires a callback function";
+            return -1;
+        }
+        HidController::InputFieldBinding binding;
+        binding.field.reportId = reportID;
+        binding.field.byteOffset = byteOffset;
+        binding.field.bitOffset = bitOffset;
+        binding.field.bitSize = bitSize;
+        binding.field.isSigned = isSigned;
+        binding.callback = callback;
+        return m_pHidController->registerInputField(std::move(binding));
+    }
+
+    /// @brief Binds a packed InputReport field directly to a control, without
+    ///        executing any JavaScript code. The control parameter is set to
+    ///        the field value normalized to 0...1 whenever the value changes.
+    /// @param reportID 1...255 for HID devices that uses ReportIDs - or 0 for devices, which don't use ReportIDs
+    /// @param byteOffset Offset of the field in bytes, including the ReportID byte
+    ///                   for HID devices which use ReportIDs (same as in incomingData)
+    /// @param bitOffset Offset of the least significant bit in the first byte (0...7)
+    /// @param bitSize Number of bits of the field (1...32)
+    /// @param group Group of the control, e.g. "[Channel1]"
+    /// @param name Name of the control, e.g. "rate"
+    /// @return The field ID, or -1 if the field or the control is invalid
+    Q_INVOKABLE int bindInputFieldToControl(quint8 reportID,
+            int byteOffset,
+            int bitOffset,
+            int bitSize,
+            const QString& group,
+            const QString& name) {
+        HidController::InputFieldBinding binding;
+        binding.field.reportId = reportID;
+        binding.field.byteOffset = byteOffset;
+        binding.field.bitOffset = bitOffset;
+        binding.field.bitSize = bitSize;
+        binding.pControl = std::make_unique<PollingControlProxy>(
+                group, name, ControlFlag::AllowMissingOrInvalid);
+        if (!binding.pControl->valid()) {
+            qCWarning(m_pHidController->m_logInput)
+                    << "bindInputFieldToControl: Unknown control" << group << name;
+            return -1;
+        }
+        return m_pHidController->registerInputField(std::move(binding));
+    }
+
+    /// @brief Removes all registered InputReport fields. Afterwards all
+    ///        InputReports are passed to the incomingData function again.
+    Q_INVOKABLE void clearInputFields() {
+        m_pHidController->clearInputFields();
+    }
+
     /// @brief getInputReport receives an InputReport from the HID device on request.
     /// @details This can be used on startup to initialize the knob positions in Mixxx
     ///          to the physical position of the hardware knobs on the controller.
@@ -69,6 +69,44 @@ void HidIoOutputReport::updateCachedData(const QByteArray& data,
     m_resendUnchangedReport = resendUnchangedReport;
 }
 
+void HidIoOutputReport::updateCachedField(const HidReportField& field,
+        quint32 value,
+        const mixxx::hid::DeviceInfo& deviceInfo,
+        const RuntimeLoggingCategory& logOutput) {
+    auto cacheLock = lockMutex(&m_cachedDataMutex);
+
+    if (!field.isValid() ||
+            field.byteOffset + field.byteSpan() > m_lastCachedDataSize) {
+        qCWarning(logOutput) << "Field at byte offset" << field.byteOffset
+                             << "with" << field.bitSize << "bits doesn't fit into"
+                             << m_lastCachedDataSize << "bytes of report (with Report ID"
+                             << m_reportId << ") for" << deviceInfo.formatName()
+                             << "- This indicates a bug in the mapping code!";
+        return;
+    }
+
+    if (!m_possiblyUnsentDataCached) {
+        // After sending, m_cachedData holds outdated data due to the swap in
+        // sendCachedData. Start from the data sent last, reusing the already
+        // allocated heap memory.
+        qByteArrayReplaceWithPositionAndSize(&m_cachedData,
+                0,
+                m_cachedData.size(),
+                m_lastSentData.constData(),
+                m_lastSentData.size());
+    }
+    if (m_cachedData.size() < kReportIdSize + m_lastCachedDataSize) {
+        // Nothing was sent successfully yet
+        return;
+    }
+
+    // The first byte with the ReportID is not part of the field offset
+    if (field.insert(reinterpret_cast<unsigned char*>(m_cachedData.data()) + kReportIdSize,
+                value)) {
+        m_possiblyUnsentDataCached = true;
+    }
+}
+
 bool HidIoOutputReport::sendCachedData(QMutex* pHidDeviceAndPollMutex,
         hid_device* pHidDevice,
         const mixxx::hid::DeviceInfo& deviceInfo,
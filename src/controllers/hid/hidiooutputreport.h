@@ -2,6 +2,7 @@
 
 #include "controllers/controller.h"
 #include "controllers/hid/hiddevice.h"
+#include "controllers/hid/hidreportfield.h"
 #include "util/compatibility/qmutex.h"
 #include "util/duration.h"
 
@@ -16,6 +17,14 @@ class HidIoOutputReport {
             const RuntimeLoggingCategory& logOutput,
             bool resendUnchangedReport);
 
+    /// Changes a single field of the cached report data. The report is only
+    /// marked for sending if at least one bit changed. Requires that the
+    /// report was cached with updateCachedData before, to define its size.
+    void updateCachedField(const HidReportField& field,
+            quint32 value,
+            const mixxx::hid::DeviceInfo& deviceInfo,
+            const RuntimeLoggingCategory& logOutput);
+
     /// Sends the OutputReport to the HID device, when changed data are cached.
     /// Returns true if a time consuming hid_write operation was executed.
     bool sendCachedData(QMutex* pHidDeviceAndPollMutex,
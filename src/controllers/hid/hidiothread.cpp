@@ -8,6 +8,7 @@
 #include "controllers/hid/legacyhidcontrollermappingfilehandler.h"
 #include "moc_hidiothread.cpp"
 #include "util/string.h"
+#include "util/threadrole.h"
 #include "util/time.h"
 #include "util/trace.h"
 
@@ -59,6 +60,7 @@ HidIoThread::~HidIoThread() {
 void HidIoThread::run() {
     const QSemaphoreReleaser releaser(m_runLoopSemaphore);
     m_runLoopSemaphore.acquire();
+    const mixxx::ScopedThreadRole threadRole(mixxx::ThreadRole::Controller);
     while (!testAndSetThreadState(HidIoThreadState::StopRequested, HidIoThreadState::Stopped)) {
         // Ensure that all InputReports are read from the ring buffer, before the next OutputReport blocks the IO again
         // Polling available Input-Reports is a cheap software only operation, which takes insignificiant time
@@ -136,6 +138,18 @@ void HidIoThread::processInputReport(int bytesRead) {
     m_pollingBufferIndex = (m_pollingBufferIndex + 1) % kNumBuffers;
     m_lastPollSize = bytesRead;
 
+    // If the mapping registered fields for this report, unpack them here and
+    // only dispatch the values that changed, instead of letting the JavaScript
+    // mapping unpack and compare every field of every report.
+    if (m_inputReportParser.hasFieldsForReport(pCurrentBuffer, bytesRead)) {
+        QVector<HidChangedField> changedFields;
+        m_inputReportParser.parseReport(pCurrentBuffer, bytesRead, &changedFields);
+        if (!changedFields.isEmpty()) {
+            emit receiveChangedFields(changedFields, mixxx::Time::elapsed());
+        }
+        return;
+    }
+
     // Convert array of bytes read in a JavaScript compatible return type, this is emitted as deep-copy, for thread safety.
     // This eexecute callback function in JavaScript mapping and print to stdout in case of --controllerDebug
     emit receive(QByteArray(reinterpret_cast<const char*>(pCurrentBuffer),
@@ -208,6 +222,41 @@ void HidIoThread::updateCachedOutputReportData(quint8 reportID,
             data, m_deviceInfo, m_logOutput, resendUnchangedReport);
 }
 
+void HidIoThread::updateCachedOutputReportField(quint8 reportID,
+        const HidReportField& field,
+        quint32 value) {
+    auto mapLock = lockMutex(&m_outputReportMapMutex);
+    auto outputReportIterator = m_outputReports.find(reportID);
+    if (outputReportIterator == m_outputReports.end()) {
+        qCWarning(m_logOutput) << "OutputReport field set for"
+                               << m_deviceInfo.formatName() << "(Report ID"
+                               << reportID << ") before the report was sent once"
+                               << "- This indicates a bug in the mapping code!";
+        return;
+    }
+    // See updateCachedOutputReportData, why no mutex protection is needed
+    // after the lookup.
+    mapLock.unlock();
+
+    outputReportIterator->second->updateCachedField(
+            field, value, m_deviceInfo, m_logOutput);
+}
+
+int HidIoThread::registerInputReportField(const HidReportField& field) {
+    auto hidDeviceLock = lockMutex(&m_hidDeviceAndPollMutex);
+    return m_inputReportParser.registerField(field);
+}
+
+int HidIoThread::clearInputReportFields() {
+    auto hidDeviceLock = lockMutex(&m_hidDeviceAndPollMutex);
+    return m_inputReportParser.clear();
+}
+
+int HidIoThread::inputReportFieldGeneration() {
+    auto hidDeviceLock = lockMutex(&m_hidDeviceAndPollMutex);
+    return m_inputReportParser.generation();
+}
+
 bool HidIoThread::sendNextCachedOutputReport() {
     // m_outputReports.size() doesn't need mutex protection, because the value of i is not used.
     // i is just a counter to prevent infinite loop execution.
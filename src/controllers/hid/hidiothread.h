@@ -8,6 +8,7 @@
 #include "controllers/controller.h"
 #include "controllers/hid/hiddevice.h"
 #include "controllers/hid/hidiooutputreport.h"
+#include "controllers/hid/hidreportfield.h"
 #include "util/compatibility/qmutex.h"
 #include "util/duration.h"
 
@@ -46,12 +47,30 @@ class HidIoThread : public QThread {
             const QByteArray& reportData,
             bool resendUnchangedReport);
     QByteArray getInputReport(quint8 reportID);
+    /// Changes a single field of an OutputReport, which must have been sent
+    /// with updateCachedOutputReportData before, to define its size.
+    /// The report is only marked for sending if a bit actually changed.
+    void updateCachedOutputReportField(quint8 reportID,
+            const HidReportField& field,
+            quint32 value);
     void sendFeatureReport(quint8 reportID, const QByteArray& reportData);
     QByteArray getFeatureReport(quint8 reportID);
 
+    /// Registers a packed InputReport field, which is unpacked and compared
+    /// in this thread. Returns the field ID or -1 if the field is invalid.
+    int registerInputReportField(const HidReportField& field);
+    /// Removes all registered InputReport fields. Returns the new field
+    /// generation, changed fields of older generations may still be queued.
+    int clearInputReportFields();
+    int inputReportFieldGeneration();
+
   signals:
     /// Signals that a HID InputReport received by Interrupt triggered from HID device
     void receive(const QByteArray& data, mixxx::Duration timestamp);
+    /// Signals the fields of an InputReport, which changed since the previous report.
+    /// Reports with registered fields are only signaled by this, not by receive.
+    void receiveChangedFields(const QVector<HidChangedField>& changedFields,
+            mixxx::Duration timestamp);
 
   private:
     bool sendNextCachedOutputReport();
@@ -67,7 +86,8 @@ class HidIoThread : public QThread {
     /// This mutex must be locked for any hid device operation using the m_pHidDevice structure.
     /// If the hid_error functions is called after the hid device operation to get the error message,
     /// this mutex must not be unlocked before hid_error.
-    /// This mutex must be locked also, for access to m_pPollData, m_lastPollSize, m_pollingBufferIndex.
+    /// This mutex must be locked also, for access to m_pPollData, m_lastPollSize, m_pollingBufferIndex
+    /// and m_inputReportParser.
     QMutex m_hidDeviceAndPollMutex;
 
     /// const pointer to the C data structure, which hidapi uses for communication between functions
@@ -80,6 +100,8 @@ class HidIoThread : public QThread {
     int m_lastPollSize;
     int m_pollingBufferIndex;
 
+    HidInputReportParser m_inputReportParser;
+
     /// Must be locked when a operation changes the size of the m_outputReports map,
     /// or when modify the m_outputReportIterator
     QMutex m_outputReportMapMutex;
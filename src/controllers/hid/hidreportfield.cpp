@@ -0,0 +1,77 @@
+#include "controllers/hid/hidreportfield.h"
+
+qint64 HidReportField::extract(const unsigned char* pData) const {
+    // Gather all touched bytes little-endian. A 32 bit field with a
+    // bit offset of 7 spans 5 bytes, which still fits into 64 bits.
+    quint64 raw = 0;
+    const int span = byteSpan();
+    for (int i = 0; i < span; ++i) {
+        raw |= static_cast<quint64>(pData[byteOffset + i]) << (8 * i);
+    }
+    const quint32 value = static_cast<quint32>(raw >> bitOffset) & maxUnsignedValue();
+    if (isSigned) {
+        const quint32 signBit = 1u << (bitSize - 1);
+        if (value & signBit) {
+            return static_cast<qint64>(value) - (static_cast<qint64>(signBit) << 1);
+        }
+    }
+    return static_cast<qint64>(value);
+}
+
+bool HidReportField::insert(unsigned char* pData, quint32 value) const {
+    const quint64 mask = static_cast<quint64>(maxUnsignedValue()) << bitOffset;
+    const quint64 shiftedValue = (static_cast<quint64>(value) << bitOffset) & mask;
+    bool changed = false;
+    const int span = byteSpan();
+    for (int i = 0; i < span; ++i) {
+        const auto byteMask = static_cast<unsigned char>(mask >> (8 * i));
+        const auto byteValue = static_cast<unsigned char>(shiftedValue >> (8 * i));
+        const auto newByte = static_cast<unsigned char>(
+                (pData[byteOffset + i] & ~byteMask) | byteValue);
+        if (newByte != pData[byteOffset + i]) {
+            pData[byteOffset + i] = newByte;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+int HidInputReportParser::registerField(const HidReportField& field) {
+    if (!field.isValid()) {
+        return -1;
+    }
+    m_fields.push_back(FieldState{field, 0, false});
+    return static_cast<int>(m_fields.size()) - 1;
+}
+
+int HidInputReportParser::clear() {
+    m_fields.clear();
+    return ++m_generation;
+}
+
+bool HidInputReportParser::hasFieldsForReport(const unsigned char* pData, int length) const {
+    for (const auto& state : m_fields) {
+        if (matchesReport(state.field, pData, length)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void HidInputReportParser::parseReport(const unsigned char* pData,
+        int length,
+        QVector<HidChangedField>* pChangedFields) {
+    for (std::size_t i = 0; i < m_fields.size(); ++i) {
+        FieldState& state = m_fields[i];
+        if (!matchesReport(state.field, pData, length)) {
+            continue;
+        }
+        const qint64 value = state.field.extract(pData);
+        if (state.valid && state.lastValue == value) {
+            continue;
+        }
+        state.lastValue = value;
+        state.valid = true;
+        pChangedFields->append(HidChangedField{static_cast<int>(i), value, m_generation});
+    }
+}
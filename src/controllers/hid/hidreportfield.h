@@ -0,0 +1,119 @@
+#pragma once
+
+#include <QMetaType>
+#include <QVector>
+#include <QtGlobal>
+#include <vector>
+
+/// Declarative description of a packed field inside an HID report.
+///
+/// The byte offset is counted from the start of the report data as it is
+/// passed to the mapping:
+/// - For HID devices which don't use ReportIDs, the data bytes start at position 0
+/// - For HID devices which use ReportIDs to enumerate the reports, the
+///   ReportID is stored in the first byte and the data start at position 1
+///
+/// Multi-byte fields are little-endian, as defined by the HID specification.
+struct HidReportField {
+    /// ReportID of the report containing this field. If the device does not
+    /// use ReportIDs this must be 0, which matches every report.
+    quint8 reportId = 0;
+    int byteOffset = 0;
+    /// Offset of the least significant bit inside the byte at byteOffset (0...7)
+    int bitOffset = 0;
+    /// Number of bits (1...32)
+    int bitSize = 8;
+    /// Sign-extend the value (two's complement)
+    bool isSigned = false;
+
+    bool isValid() const {
+        return byteOffset >= 0 &&
+                bitOffset >= 0 && bitOffset < 8 &&
+                bitSize > 0 && bitSize <= 32;
+    }
+
+    /// Number of bytes that are touched by this field, starting at byteOffset
+    int byteSpan() const {
+        return (bitOffset + bitSize + 7) / 8;
+    }
+
+    /// Largest value of the field interpreted as unsigned integer
+    quint32 maxUnsignedValue() const {
+        return bitSize >= 32 ? 0xFFFFFFFFu : ((1u << bitSize) - 1u);
+    }
+
+    /// Extracts the field from the report. The report must contain
+    /// at least byteOffset + byteSpan() bytes.
+    qint64 extract(const unsigned char* pData) const;
+
+    /// Inserts the field into the report. Returns true if any bit changed.
+    /// The report must contain at least byteOffset + byteSpan() bytes.
+    bool insert(unsigned char* pData, quint32 value) const;
+};
+
+/// A field whose value changed between two consecutive InputReports
+struct HidChangedField {
+    int fieldId;
+    qint64 value;
+    /// Generation of the parser when the field was parsed. Field IDs are
+    /// reused after HidInputReportParser::clear(), so the receiver must
+    /// drop fields of an older generation.
+    int generation;
+};
+
+Q_DECLARE_METATYPE(QVector<HidChangedField>);
+
+/// Parses InputReports natively and dispatches only the fields that changed
+/// since the previous report with the same ReportID. This avoids that the
+/// JavaScript mapping has to unpack and compare every field of every report,
+/// which happens at up to 1kHz for typical DJ controllers.
+///
+/// This class is not thread-safe, the owner must serialize registration
+/// and parsing.
+class HidInputReportParser {
+  public:
+    /// Registers a field, returns the field ID or -1 if the field is invalid.
+    /// The first report containing the field always reports it as changed.
+    int registerField(const HidReportField& field);
+
+    /// Removes all registered fields and starts a new generation.
+    /// Returns the new generation.
+    int clear();
+
+    /// Generation of the currently registered fields, incremented on clear()
+    int generation() const {
+        return m_generation;
+    }
+
+    bool isEmpty() const {
+        return m_fields.empty();
+    }
+
+    /// Returns true if at least one field is registered for a report with
+    /// this data. Such reports are dispatched field-wise.
+    bool hasFieldsForReport(const unsigned char* pData, int length) const;
+
+    /// Unpacks all fields registered for the report and appends those, whose
+    /// value changed, to pChangedFields.
+    void parseReport(const unsigned char* pData,
+            int length,
+            QVector<HidChangedField>* pChangedFields);
+
+  private:
+    struct FieldState {
+        HidReportField field;
+        qint64 lastValue;
+        bool valid;
+    };
+
+    static bool matchesReport(const HidReportField& field,
+            const unsigned char* pData,
+            int length) {
+        return length > 0 &&
+                (field.reportId == 0 || field.reportId == pData[0]) &&
+                field.byteOffset + field.byteSpan() <= length;
+    }
+
+    std::vector<FieldState> m_fields;
+    int m_generation = 0;
+};
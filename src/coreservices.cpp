@@ -31,9 +31,11 @@
 #include "util/db/dbconnectionpooled.h"
 #include "util/font.h"
 #include "util/logger.h"
+#include "util/performancetimer.h"
 #include "util/screensaver.h"
 #include "util/screensavermanager.h"
 #include "util/statsmanager.h"
+#include "util/threadrole.h"
 #include "util/time.h"
 #include "util/translations.h"
 #include "util/versionstore.h"
@@ -116,6 +118,7 @@ CoreServices::CoreServices(const CmdlineArgs& args, QApplication* pApp)
     // called after the GUI is initialized
     initializeSettings();
     initializeLogging();
+    mixxx::ThreadRoleRegistry::loadConfig(m_pSettingsManager->settings());
     // Only record stats in developer mode.
     if (m_cmdlineArgs.getDeveloper()) {
         StatsManager::createInstance();
@@ -236,9 +239,19 @@ void CoreServices::initialize(QApplication* pApp) {
 
     QString resourcePath = pConfig->getResourcePath();
 
+    // Log the time spent for initializing each subsystem to spot
+    // regressions of the startup time
+    PerformanceTimer subsystemTimer;
+    subsystemTimer.start();
+    const auto logInitialized = [&subsystemTimer](const char* subsystem) {
+        kLogger.info() << "Initialized" << subsystem << "in"
+                       << subsystemTimer.restart().debugMillisWithUnit();
+    };
+
     emit initializationProgressUpdate(0, tr("fonts"));
 
     FontUtils::initializeFonts(resourcePath); // takes a long time
+    logInitialized("fonts");
 
     emit initializationProgressUpdate(10, tr("database"));
     m_pDbConnectionPool = MixxxDb(pConfig).connectionPool();
@@ -250,6 +263,7 @@ void CoreServices::initialize(QApplication* pApp) {
     if (!initializeDatabase()) {
         exit(-1);
     }
+    logInitialized("database");
 
     m_pControlIndicatorTimer = std::make_shared<mixxx::ControlIndicatorTimer>(this);
 
@@ -257,6 +271,7 @@ void CoreServices::initialize(QApplication* pApp) {
 
     emit initializationProgressUpdate(20, tr("effects"));
     m_pEffectsManager = std::make_shared<EffectsManager>(pConfig, pChannelHandleFactory);
+    logInitialized("effects");
 
     m_pEngine = std::make_shared<EngineMaster>(
             pConfig,
@@ -264,12 +279,14 @@ void CoreServices::initialize(QApplication* pApp) {
             m_pEffectsManager.get(),
             pChannelHandleFactory,
             true);
+    logInitialized("engine");
 
     emit initializationProgressUpdate(30, tr("audio interface"));
     // Although m_pSoundManager is created here, m_pSoundManager->setupDevices()
     // needs to be called after m_pPlayerManager registers sound IO for each EngineChannel.
     m_pSoundManager = std::make_shared<SoundManager>(pConfig, m_pEngine.get());
     m_pEngine->registerNonEngineChannelSoundIO(m_pSoundManager.get());
+    logInitialized("sound manager");
 
     m_pRecordingManager = std::make_shared<RecordingManager>(pConfig, m_pEngine.get());
 
@@ -284,6 +301,7 @@ void CoreServices::initialize(QApplication* pApp) {
 #else
     m_pVCManager = nullptr;
 #endif
+    logInitialized("recording, broadcasting and vinyl control");
 
     emit initializationProgressUpdate(40, tr("decks"));
     // Create the player manager. (long)
@@ -309,8 +327,10 @@ void CoreServices::initialize(QApplication* pApp) {
     m_pPlayerManager->addSampler();
     m_pPlayerManager->addSampler();
     m_pPlayerManager->addPreviewDeck();
+    logInitialized("decks");
 
     m_pEffectsManager->setup();
+    logInitialized("effect chains");
 
 #ifdef __VINYLCONTROL__
     m_pVCManager->init();
@@ -329,6 +349,7 @@ void CoreServices::initialize(QApplication* pApp) {
             &PlayerInfo::currentPlayingDeckChanged,
             m_pScreensaverManager.get(),
             &ScreensaverManager::slotCurrentPlayingDeckChanged);
+    logInitialized("screensaver");
 
     emit initializationProgressUpdate(50, tr("library"));
     CoverArtCache::createInstance();
@@ -351,6 +372,7 @@ void CoreServices::initialize(QApplication* pApp) {
     // been created. Otherwise Mixxx might hang when accessing
     // the uninitialized singleton instance!
     m_pPlayerManager->bindToLibrary(m_pLibrary.get());
+    logInitialized("library");
 
     bool hasChanged_MusicDir = false;
 
@@ -366,6 +388,8 @@ void CoreServices::initialize(QApplication* pApp) {
                 tr("Choose music library directory"),
                 QStandardPaths::writableLocation(
                         QStandardPaths::MusicLocation));
+        // Don't account the time waiting for the user to the next subsystem
+        subsystemTimer.restart();
         if (!fd.isEmpty()) {
             // adds Folder to database.
             m_pLibrary->slotRequestAddDir(fd);
@@ -383,6 +407,7 @@ void CoreServices::initialize(QApplication* pApp) {
     // Wait until all other ControlObjects are set up before initializing
     // controllers
     m_pControllerManager->setUpDevices();
+    logInitialized("controllers");
 
     // Scan the library for new files and directories
     bool rescan = pConfig->getValue<bool>(
@@ -431,6 +456,7 @@ void CoreServices::initialize(QApplication* pApp) {
     // This has to be done before m_pSoundManager->setupDevices()
     // https://bugs.launchpad.net/mixxx/+bug/1758189
     m_pPlayerManager->loadSamplers();
+    logInitialized("samplers");
 
     m_pTouchShift = std::make_unique<ControlPushButton>(ConfigKey("[Controls]", "touch_shift"));
 
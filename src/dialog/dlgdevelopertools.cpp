@@ -7,6 +7,7 @@
 #include "util/cmdlineargs.h"
 #include "util/logging.h"
 #include "util/statsmanager.h"
+#include "util/threadrole.h"
 
 DlgDeveloperTools::DlgDeveloperTools(QWidget* pParent,
                                      UserSettingsPointer pConfig)
@@ -98,6 +99,41 @@ void DlgDeveloperTools::timerEvent(QTimerEvent* pEvent) {
         if (pManager) {
             pManager->updateStats();
         }
+    } else if (toolTabWidget->currentWidget() == threadsTab) {
+        updateThreads();
+    }
+}
+
+void DlgDeveloperTools::updateThreads() {
+    const QList<mixxx::ThreadRoleRegistry::ThreadInfo> threads =
+            mixxx::ThreadRoleRegistry::threads();
+    threadsTable->setRowCount(threads.size());
+    for (int row = 0; row < threads.size(); ++row) {
+        const auto& thread = threads.at(row);
+        QStringList cpus;
+        for (const int cpu : thread.cpus) {
+            cpus.append(QString::number(cpu));
+        }
+        QString policy = mixxx::ThreadRoleConfig::policyName(thread.policy);
+        if (!thread.applied) {
+            policy += tr(" (failed)");
+        }
+        const QStringList columns = {
+                mixxx::threadRoleName(thread.role),
+                thread.name,
+                QString::number(thread.threadId),
+                cpus.isEmpty() ? tr("all") : cpus.join(QChar(',')),
+                policy,
+                QString::number(thread.cpuTime.toDoubleSeconds(), 'f', 3),
+        };
+        for (int column = 0; column < columns.size(); ++column) {
+            QTableWidgetItem* pItem = threadsTable->item(row, column);
+            if (!pItem) {
+                pItem = new QTableWidgetItem();
+                threadsTable->setItem(row, column, pItem);
+            }
+            pItem->setText(columns.at(column));
+        }
     }
 }
 
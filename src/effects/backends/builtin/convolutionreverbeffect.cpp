@@ -0,0 +1,361 @@
+#include "effects/backends/builtin/convolutionreverbeffect.h"
+
+#include <QMutex>
+#include <QSemaphore>
+#include <QThread>
+#include <QtDebug>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "util/compatibility/qmutex.h"
+#include "util/sample.h"
+
+/// Builds the convolvers that the audio thread has requested and deletes
+/// the ones it has replaced. It is woken up by the audio thread.
+class ConvolutionReverbBuilder final : public QThread {
+  public:
+    ConvolutionReverbBuilder()
+            : m_stop(false) {
+    }
+
+    ~ConvolutionReverbBuilder() override {
+        m_stop = true;
+        m_semaRun.release();
+        wait();
+    }
+
+    void addState(ConvolutionReverbGroupState* pState) {
+        const auto locker = lockMutex(&m_mutex);
+        m_states.push_back(pState);
+    }
+
+    /// Blocks until the builder doesn't access the state anymore
+    void removeState(ConvolutionReverbGroupState* pState) {
+        const auto locker = lockMutex(&m_mutex);
+        m_states.erase(std::remove(m_states.begin(), m_states.end(), pState),
+                m_states.end());
+    }
+
+    /// Called from the audio thread
+    void wake() {
+        m_semaRun.release();
+    }
+
+  protected:
+    void run() override {
+        while (true) {
+            m_semaRun.acquire();
+            if (m_stop) {
+                break;
+            }
+            const auto locker = lockMutex(&m_mutex);
+            for (ConvolutionReverbGroupState* pState : m_states) {
+                pState->buildRequestedConvolvers();
+            }
+        }
+    }
+
+  private:
+    QSemaphore m_semaRun;
+    QMutex m_mutex;
+    std::vector<ConvolutionReverbGroupState*> m_states;
+    std::atomic<bool> m_stop;
+};
+
+namespace {
+
+// The time until the impulse response has decayed by 60 dB
+constexpr double kDecaySeconds = 2.0;
+constexpr double kImpulseResponseSeconds = 2.0;
+// Keeps the level of the reverb comparable to the dry signal
+constexpr double kImpulseResponseEnergy = 0.25;
+// Different noise for both channels widens the stereo image
+constexpr std::minstd_rand::result_type kNoiseSeeds[] = {20231, 31337};
+
+// The impulse responses, the tail worker and the builder are shared by all
+// states, the convolution of the tails for all input channels runs on a
+// single thread.
+QMutex s_sharedMutex;
+std::weak_ptr<mixxx::ConvolutionTailWorker> s_pSharedTailWorker;
+std::weak_ptr<ConvolutionReverbBuilder> s_pSharedBuilder;
+
+struct SharedKernel {
+    mixxx::audio::SampleRate sampleRate;
+    SINT blockFrames = 0;
+    std::weak_ptr<const mixxx::ConvolutionKernel> pKernel;
+};
+SharedKernel s_sharedKernels[2];
+
+// The engine parameters of the last request, new states start with
+// convolvers for them. Zero until the first buffer has been processed.
+std::atomic<quint64> s_lastRequestedKey(0);
+
+quint64 convolversKey(const mixxx::EngineParameters& engineParameters) {
+    return (static_cast<quint64>(engineParameters.sampleRate().value()) << 32) |
+            static_cast<quint64>(engineParameters.framesPerBuffer());
+}
+
+mixxx::EngineParameters engineParametersFromKey(quint64 key) {
+    return mixxx::EngineParameters(
+            mixxx::audio::SampleRate(static_cast<mixxx::audio::SampleRate::value_t>(
+                    key >> 32)),
+            static_cast<SINT>(key & 0xffffffff));
+}
+
+std::shared_ptr<mixxx::ConvolutionTailWorker> sharedTailWorker() {
+    const auto locker = lockMutex(&s_sharedMutex);
+    std::shared_ptr<mixxx::ConvolutionTailWorker> pWorker = s_pSharedTailWorker.lock();
+    if (!pWorker) {
+        pWorker = std::make_shared<mixxx::ConvolutionTailWorker>();
+        pWorker->start(QThread::HighPriority);
+        s_pSharedTailWorker = pWorker;
+    }
+    return pWorker;
+}
+
+std::shared_ptr<ConvolutionReverbBuilder> sharedBuilder() {
+    const auto locker = lockMutex(&s_sharedMutex);
+    std::shared_ptr<ConvolutionReverbBuilder> pBuilder = s_pSharedBuilder.lock();
+    if (!pBuilder) {
+        pBuilder = std::make_shared<ConvolutionReverbBuilder>();
+        pBuilder->start();
+        s_pSharedBuilder = pBuilder;
+    }
+    return pBuilder;
+}
+
+std::shared_ptr<const mixxx::ConvolutionKernel> sharedKernel(
+        const mixxx::EngineParameters& engineParameters,
+        int channel) {
+    const auto locker = lockMutex(&s_sharedMutex);
+    SharedKernel& cached = s_sharedKernels[channel];
+    std::shared_ptr<const mixxx::ConvolutionKernel> pKernel = cached.pKernel.lock();
+    if (!pKernel ||
+            cached.sampleRate != engineParameters.sampleRate() ||
+            cached.blockFrames != engineParameters.framesPerBuffer()) {
+        pKernel = std::make_shared<const mixxx::ConvolutionKernel>(
+                ConvolutionReverbEffect::createImpulseResponse(
+                        engineParameters.sampleRate(), channel),
+                engineParameters.framesPerBuffer());
+        cached.sampleRate = engineParameters.sampleRate();
+        cached.blockFrames = engineParameters.framesPerBuffer();
+        cached.pKernel = pKernel;
+    }
+    return pKernel;
+}
+
+} // anonymous namespace
+
+ConvolutionReverbGroupState::ConvolutionReverbGroupState(
+        const mixxx::EngineParameters& engineParameters)
+        : EffectState(engineParameters),
+          sendBuffer(MAX_BUFFER_LEN),
+          sendPrevious(0),
+          m_pTailWorker(sharedTailWorker()),
+          m_pBuilder(sharedBuilder()),
+          m_requestedKey(0),
+          m_requestedKeyForBuilder(0),
+          m_pBuiltConvolvers(nullptr),
+          m_pRetiredConvolvers(nullptr),
+          m_builtKey(0) {
+    // The given engine parameters are only placeholders until the sound
+    // device has been set up. The engine parameters of other states are
+    // more likely to be right, e.g. when an input channel is routed again.
+    const quint64 key = s_lastRequestedKey.load(std::memory_order_relaxed);
+    if (key != 0) {
+        m_pConvolvers = buildConvolvers(key);
+        m_requestedKey = key;
+        m_requestedKeyForBuilder.store(key, std::memory_order_relaxed);
+        m_builtKey = key;
+    }
+    m_pBuilder->addState(this);
+}
+
+ConvolutionReverbGroupState::~ConvolutionReverbGroupState() {
+    m_pBuilder->removeState(this);
+    delete m_pBuiltConvolvers.load(std::memory_order_acquire);
+    delete m_pRetiredConvolvers.load(std::memory_order_acquire);
+}
+
+std::unique_ptr<ConvolutionReverbGroupState::Convolvers>
+ConvolutionReverbGroupState::buildConvolvers(quint64 key) const {
+    const mixxx::EngineParameters engineParameters = engineParametersFromKey(key);
+    auto pConvolvers = std::make_unique<Convolvers>();
+    pConvolvers->key = key;
+    for (std::size_t channel = 0; channel < pConvolvers->channels.size(); ++channel) {
+        pConvolvers->channels[channel] = std::make_unique<mixxx::PartitionedConvolver>(
+                sharedKernel(engineParameters, static_cast<int>(channel)),
+                m_pTailWorker);
+    }
+    return pConvolvers;
+}
+
+ConvolutionReverbGroupState::Convolvers* ConvolutionReverbGroupState::convolvers(
+        const mixxx::EngineParameters& engineParameters) {
+    // The replaced convolvers are handed back when the builder has
+    // deleted the ones replaced before.
+    if (!m_pRetiredConvolvers.load(std::memory_order_acquire)) {
+        Convolvers* pBuiltConvolvers =
+                m_pBuiltConvolvers.exchange(nullptr, std::memory_order_acq_rel);
+        if (pBuiltConvolvers) {
+            m_pRetiredConvolvers.store(m_pConvolvers.release(), std::memory_order_release);
+            m_pConvolvers.reset(pBuiltConvolvers);
+            m_pBuilder->wake();
+        }
+    }
+
+    const quint64 key = convolversKey(engineParameters);
+    if (key != m_requestedKey) {
+        m_requestedKey = key;
+        m_requestedKeyForBuilder.store(key, std::memory_order_release);
+        s_lastRequestedKey.store(key, std::memory_order_relaxed);
+        if (!m_pConvolvers || m_pConvolvers->key != key) {
+            m_pBuilder->wake();
+        }
+    }
+    return m_pConvolvers.get();
+}
+
+void ConvolutionReverbGroupState::buildRequestedConvolvers() {
+    delete m_pRetiredConvolvers.exchange(nullptr, std::memory_order_acq_rel);
+    const quint64 key = m_requestedKeyForBuilder.load(std::memory_order_acquire);
+    if (key == 0 || key == m_builtKey ||
+            m_pBuiltConvolvers.load(std::memory_order_acquire)) {
+        // Retried when the audio thread has picked up the built convolvers
+        return;
+    }
+    m_pBuiltConvolvers.store(buildConvolvers(key).release(), std::memory_order_release);
+    m_builtKey = key;
+}
+
+void ConvolutionReverbGroupState::clear() {
+    if (m_pConvolvers) {
+        for (const auto& pConvolver : m_pConvolvers->channels) {
+            pConvolver->clear();
+        }
+    }
+    sendPrevious = 0;
+}
+
+std::size_t ConvolutionReverbGroupState::heapBytes() const {
+    return static_cast<std::size_t>(sendBuffer.size()) * sizeof(CSAMPLE);
+}
+
+// static
+QString ConvolutionReverbEffect::getId() {
+    return "org.mixxx.effects.convolutionreverb";
+}
+
+// static
+EffectManifestPointer ConvolutionReverbEffect::getManifest() {
+    EffectManifestPointer pManifest(new EffectManifest());
+    pManifest->setAddDryToWet(true);
+    pManifest->setEffectRampsFromDry(true);
+
+    pManifest->setId(getId());
+    pManifest->setName(QObject::tr("Convolution Reverb"));
+    pManifest->setShortName(QObject::tr("Conv Reverb"));
+    pManifest->setAuthor("The Mixxx Team");
+    pManifest->setVersion("1.0");
+    pManifest->setDescription(QObject::tr(
+            "Places the signal in a large hall by convolving it with "
+            "the impulse response of the room"));
+
+    EffectManifestParameterPointer send = pManifest->addParameter();
+    send->setId("send_amount");
+    send->setName(QObject::tr("Send"));
+    send->setShortName(QObject::tr("Send"));
+    send->setDescription(QObject::tr(
+            "How much of the signal to send in to the effect"));
+    send->setValueScaler(EffectManifestParameter::ValueScaler::Linear);
+    send->setUnitsHint(EffectManifestParameter::UnitsHint::Unknown);
+    send->setDefaultLinkType(EffectManifestParameter::LinkType::Linked);
+    send->setDefaultLinkInversion(EffectManifestParameter::LinkInversion::NotInverted);
+    send->setRange(0, 0, 1);
+
+    return pManifest;
+}
+
+// static
+std::vector<float> ConvolutionReverbEffect::createImpulseResponse(
+        mixxx::audio::SampleRate sampleRate,
+        int channel) {
+    const auto length = static_cast<std::size_t>(
+            kImpulseResponseSeconds * sampleRate.toDouble());
+    std::vector<float> impulseResponse(length);
+
+    std::minstd_rand generator(kNoiseSeeds[channel]);
+    std::uniform_real_distribution<double> noise(-1.0, 1.0);
+    const double decayPerFrame = std::log(1000.0) / (kDecaySeconds * sampleRate.toDouble());
+    // High frequencies decay faster than low frequencies in a real room,
+    // the noise is filtered by a low pass filter that closes over time.
+    double lowPass = 0;
+    double energy = 0;
+    for (std::size_t i = 0; i < length; ++i) {
+        const double coefficient = 0.9 - 0.8 * i / length;
+        lowPass += coefficient * (noise(generator) - lowPass);
+        const double value = lowPass * std::exp(-decayPerFrame * i);
+        impulseResponse[i] = static_cast<float>(value);
+        energy += value * value;
+    }
+
+    const auto gain = static_cast<float>(std::sqrt(kImpulseResponseEnergy / energy));
+    for (auto& value : impulseResponse) {
+        value *= gain;
+    }
+    return impulseResponse;
+}
+
+void ConvolutionReverbEffect::loadEngineEffectParameters(
+        const QMap<QString, EngineEffectParameterPointer>& parameters) {
+    m_pSendParameter = parameters.value("send_amount");
+}
+
+void ConvolutionReverbEffect::processChannel(
+        ConvolutionReverbGroupState* pState,
+        const CSAMPLE* pInput,
+        CSAMPLE* pOutput,
+        const mixxx::EngineParameters& engineParameters,
+        const EffectEnableState enableState,
+        const GroupFeatureState& groupFeatures) {
+    Q_UNUSED(groupFeatures);
+
+    // Don't replay the reverberation from the last time the effect was enabled
+    if (enableState == EffectEnableState::Enabling) {
+        pState->clear();
+    }
+
+    const auto sendCurrent = static_cast<CSAMPLE_GAIN>(m_pSendParameter->value());
+    SampleUtil::copyWithRampingGain(pState->sendBuffer.data(),
+            pInput,
+            pState->sendPrevious,
+            sendCurrent,
+            engineParameters.samplesPerBuffer());
+
+    ConvolutionReverbGroupState::Convolvers* pConvolvers =
+            pState->convolvers(engineParameters);
+    if (pConvolvers) {
+        const int channelCount = engineParameters.channelCount();
+        for (std::size_t channel = 0; channel < pConvolvers->channels.size(); ++channel) {
+            pConvolvers->channels[channel]->process(pState->sendBuffer.data() + channel,
+                    pOutput + channel,
+                    engineParameters.framesPerBuffer(),
+                    channelCount);
+        }
+    } else {
+        // Only the dry signal until the convolvers have been built
+        SampleUtil::clear(pOutput, engineParameters.samplesPerBuffer());
+    }
+
+    // The ramping of the send parameter handles ramping when enabling, so
+    // this effect must handle ramping to dry when disabling itself (instead
+    // of being handled by EngineEffect::process).
+    if (enableState == EffectEnableState::Disabling) {
+        SampleUtil::applyRampingGain(pOutput, 1.0, 0.0, engineParameters.samplesPerBuffer());
+        pState->sendPrevious = 0;
+    } else {
+        pState->sendPrevious = sendCurrent;
+    }
+}
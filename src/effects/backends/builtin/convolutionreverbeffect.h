@@ -0,0 +1,105 @@
+#pragma once
+
+#include <QMap>
+#include <QtGlobal>
+#include <array>
+#include <atomic>
+#include <memory>
+
+#include "effects/backends/builtin/partitionedconvolver.h"
+#include "effects/backends/effectprocessor.h"
+#include "engine/effects/engineeffect.h"
+#include "engine/effects/engineeffectparameter.h"
+#include "util/class.h"
+#include "util/defs.h"
+#include "util/sample.h"
+#include "util/samplebuffer.h"
+#include "util/types.h"
+
+class ConvolutionReverbBuilder;
+
+class ConvolutionReverbGroupState : public EffectState {
+  public:
+    /// One convolver for each channel of the stereo signal
+    struct Convolvers {
+        // The sample rate and the buffer size they have been built for
+        quint64 key;
+        std::array<std::unique_ptr<mixxx::PartitionedConvolver>, 2> channels;
+    };
+
+    ConvolutionReverbGroupState(const mixxx::EngineParameters& engineParameters);
+    ~ConvolutionReverbGroupState() override;
+
+    /// Called from the audio thread
+    /// Returns the convolvers, which may have been built for other engine
+    /// parameters until the convolvers for these have been built in the
+    /// background, or nullptr if there are none yet.
+    Convolvers* convolvers(const mixxx::EngineParameters& engineParameters);
+    void clear();
+
+    /// Called from the ConvolutionReverbBuilder
+    void buildRequestedConvolvers();
+
+    /// The convolvers are not included, they are replaced in the background
+    std::size_t heapBytes() const override;
+
+    mixxx::SampleBuffer sendBuffer;
+    CSAMPLE_GAIN sendPrevious;
+
+  private:
+    std::unique_ptr<Convolvers> buildConvolvers(quint64 key) const;
+
+    const std::shared_ptr<mixxx::ConvolutionTailWorker> m_pTailWorker;
+    const std::shared_ptr<ConvolutionReverbBuilder> m_pBuilder;
+    // Only accessed by the audio thread
+    std::unique_ptr<Convolvers> m_pConvolvers;
+    quint64 m_requestedKey;
+    // Handed over between the audio thread and the builder
+    std::atomic<quint64> m_requestedKeyForBuilder;
+    std::atomic<Convolvers*> m_pBuiltConvolvers;
+    std::atomic<Convolvers*> m_pRetiredConvolvers;
+    // Only accessed by the builder
+    quint64 m_builtKey;
+
+    DISALLOW_COPY_AND_ASSIGN(ConvolutionReverbGroupState);
+};
+
+/// Convolves the signal with the impulse response of a room.
+///
+/// The impulse response and the convolvers depend on the sample rate and the
+/// buffer size of the engine, which are only known in the audio thread. They
+/// are built by a background thread when the audio thread requests them. The
+/// impulse responses are shared by all states of the same engine parameters.
+class ConvolutionReverbEffect : public EffectProcessorImpl<ConvolutionReverbGroupState> {
+  public:
+    ConvolutionReverbEffect() = default;
+
+    static QString getId();
+    static EffectManifestPointer getManifest();
+
+    /// Synthesizes decorrelated impulse responses for the left (0) and
+    /// right (1) channel
+    static std::vector<float> createImpulseResponse(
+            mixxx::audio::SampleRate sampleRate,
+            int channel);
+
+    void loadEngineEffectParameters(
+            const QMap<QString, EngineEffectParameterPointer>& parameters) override;
+
+    void processChannel(
+            ConvolutionReverbGroupState* pState,
+            const CSAMPLE* pInput,
+            CSAMPLE* pOutput,
+            const mixxx::EngineParameters& engineParameters,
+            const EffectEnableState enableState,
+            const GroupFeatureState& groupFeatures) override;
+
+  private:
+    QString debugString() const {
+        return getId();
+    }
+
+    EngineEffectParameterPointer m_pSendParameter;
+
+    DISALLOW_COPY_AND_ASSIGN(ConvolutionReverbEffect);
+};
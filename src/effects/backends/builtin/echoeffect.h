@@ -38,6 +38,15 @@ class EchoGroupState : public EffectState {
         ping_pong = 0;
     };
 
+    bool resetForReuse() override {
+        clear();
+        return true;
+    }
+
+    std::size_t heapBytes() const override {
+        return static_cast<std::size_t>(delay_buf.size()) * sizeof(CSAMPLE);
+    }
+
     mixxx::SampleBuffer delay_buf;
     CSAMPLE_GAIN prev_send;
     CSAMPLE_GAIN prev_feedback;
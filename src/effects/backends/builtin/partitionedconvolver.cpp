@@ -0,0 +1,364 @@
+#include "effects/backends/builtin/partitionedconvolver.h"
+
+#include <dsp/transforms/FFT.h>
+
+#include <algorithm>
+
+#include "util/assert.h"
+#include "util/compatibility/qmutex.h"
+#include "util/math.h"
+#include "util/threadrole.h"
+
+namespace {
+
+// Tail partitions shorter than this would make the background
+// thread wake up too often for small engine buffers.
+constexpr SINT kMinTailBlockFrames = 2048;
+
+constexpr int kMinTailBlocks = 8;
+
+} // anonymous namespace
+
+namespace mixxx {
+
+ConvolutionPartitions::ConvolutionPartitions(
+        const float* pImpulseResponse,
+        SINT length,
+        SINT partitionFrames)
+        : m_partitionFrames(partitionFrames),
+          m_count(static_cast<int>((length + partitionFrames - 1) / partitionFrames)) {
+    DEBUG_ASSERT(partitionFrames > 0);
+    m_real.resize(m_count * binCount());
+    m_imag.resize(m_count * binCount());
+
+    const SINT fftSize = 2 * m_partitionFrames;
+    FFTReal fft(static_cast<int>(fftSize));
+    std::vector<double> time(fftSize);
+    std::vector<double> real(fftSize);
+    std::vector<double> imag(fftSize);
+    for (int partition = 0; partition < m_count; ++partition) {
+        const SINT offset = partition * m_partitionFrames;
+        const SINT frames = math_min(m_partitionFrames, length - offset);
+        std::fill(time.begin(), time.end(), 0.0);
+        std::copy(pImpulseResponse + offset,
+                pImpulseResponse + offset + frames,
+                time.begin());
+        fft.forward(time.data(), real.data(), imag.data());
+        std::copy(real.begin(),
+                real.begin() + binCount(),
+                m_real.begin() + partition * binCount());
+        std::copy(imag.begin(),
+                imag.begin() + binCount(),
+                m_imag.begin() + partition * binCount());
+    }
+}
+
+ConvolutionKernel::ConvolutionKernel(
+        const std::vector<float>& impulseResponse,
+        SINT blockFrames)
+        : m_length(static_cast<SINT>(impulseResponse.size())),
+          m_head(impulseResponse.data(),
+                  math_min(m_length, 2 * tailBlockFrames(blockFrames)),
+                  blockFrames) {
+    const SINT headLength = 2 * tailBlockFrames(blockFrames);
+    if (m_length > headLength) {
+        m_tail = std::make_unique<ConvolutionPartitions>(
+                impulseResponse.data() + headLength,
+                m_length - headLength,
+                tailBlockFrames(blockFrames));
+    }
+}
+
+// static
+SINT ConvolutionKernel::tailBlockFrames(SINT blockFrames) {
+    DEBUG_ASSERT(blockFrames > 0);
+    const SINT tailBlocks = math_max(static_cast<SINT>(kMinTailBlocks),
+            (kMinTailBlockFrames + blockFrames - 1) / blockFrames);
+    return tailBlocks * blockFrames;
+}
+
+std::size_t ConvolutionKernel::heapBytes() const {
+    return m_head.heapBytes() + (m_tail ? m_tail->heapBytes() : 0);
+}
+
+UniformPartitionedConvolution::UniformPartitionedConvolution(
+        const ConvolutionPartitions& partitions)
+        : m_partitions(partitions),
+          m_pFft(std::make_unique<FFTReal>(
+                  static_cast<int>(2 * partitions.partitionFrames()))),
+          m_time(2 * partitions.partitionFrames()),
+          m_real(2 * partitions.partitionFrames()),
+          m_imag(2 * partitions.partitionFrames()),
+          m_delayLineReal(partitions.count() * partitions.binCount()),
+          m_delayLineImag(partitions.count() * partitions.binCount()),
+          m_delayLinePosition(0),
+          m_accumulatorReal(partitions.binCount()),
+          m_accumulatorImag(partitions.binCount()) {
+}
+
+UniformPartitionedConvolution::~UniformPartitionedConvolution() = default;
+
+void UniformPartitionedConvolution::process(const float* pInput, float* pOutput) {
+    const SINT frames = m_partitions.partitionFrames();
+    const SINT binCount = m_partitions.binCount();
+    const int count = m_partitions.count();
+
+    // Slide the input window by one block
+    std::copy(m_time.begin() + frames, m_time.end(), m_time.begin());
+    std::copy(pInput, pInput + frames, m_time.begin() + frames);
+    m_pFft->forward(m_time.data(), m_real.data(), m_imag.data());
+
+    // The delay line is traversed from the most recent input spectrum
+    // (convolved with the first partition) to the oldest one.
+    m_delayLinePosition = (m_delayLinePosition + count - 1) % count;
+    float* pDelayLineReal = &m_delayLineReal[m_delayLinePosition * binCount];
+    float* pDelayLineImag = &m_delayLineImag[m_delayLinePosition * binCount];
+    for (SINT bin = 0; bin < binCount; ++bin) {
+        pDelayLineReal[bin] = static_cast<float>(m_real[bin]);
+        pDelayLineImag[bin] = static_cast<float>(m_imag[bin]);
+    }
+
+    std::fill(m_accumulatorReal.begin(), m_accumulatorReal.end(), 0.0);
+    std::fill(m_accumulatorImag.begin(), m_accumulatorImag.end(), 0.0);
+    for (int partition = 0; partition < count; ++partition) {
+        const int position = (m_delayLinePosition + partition) % count;
+        const float* pInputReal = &m_delayLineReal[position * binCount];
+        const float* pInputImag = &m_delayLineImag[position * binCount];
+        const float* pFilterReal = m_partitions.real(partition);
+        const float* pFilterImag = m_partitions.imag(partition);
+        for (SINT bin = 0; bin < binCount; ++bin) {
+            m_accumulatorReal[bin] += pInputReal[bin] * pFilterReal[bin] -
+                    pInputImag[bin] * pFilterImag[bin];
+            m_accumulatorImag[bin] += pInputReal[bin] * pFilterImag[bin] +
+                    pInputImag[bin] * pFilterReal[bin];
+        }
+    }
+
+    // Only the second half of the circular convolution is free of aliasing
+    m_pFft->inverse(m_accumulatorReal.data(), m_accumulatorImag.data(), m_real.data());
+    for (SINT i = 0; i < frames; ++i) {
+        pOutput[i] = static_cast<float>(m_real[frames + i]);
+    }
+}
+
+void UniformPartitionedConvolution::clear() {
+    std::fill(m_time.begin(), m_time.end(), 0.0);
+    std::fill(m_delayLineReal.begin(), m_delayLineReal.end(), 0.0f);
+    std::fill(m_delayLineImag.begin(), m_delayLineImag.end(), 0.0f);
+}
+
+std::size_t UniformPartitionedConvolution::heapBytes() const {
+    return (m_time.size() + m_real.size() + m_imag.size() +
+                   m_accumulatorReal.size() + m_accumulatorImag.size()) *
+            sizeof(double) +
+            (m_delayLineReal.size() + m_delayLineImag.size()) * sizeof(float);
+}
+
+ConvolutionTailWorker::ConvolutionTailWorker()
+        : m_stop(false) {
+}
+
+ConvolutionTailWorker::~ConvolutionTailWorker() {
+    m_stop = true;
+    m_semaRun.release();
+    wait();
+}
+
+void ConvolutionTailWorker::addConvolver(PartitionedConvolver* pConvolver) {
+    const auto locker = lockMutex(&m_mutex);
+    m_convolvers.push_back(pConvolver);
+}
+
+void ConvolutionTailWorker::removeConvolver(PartitionedConvolver* pConvolver) {
+    const auto locker = lockMutex(&m_mutex);
+    m_convolvers.erase(
+            std::remove(m_convolvers.begin(), m_convolvers.end(), pConvolver),
+            m_convolvers.end());
+}
+
+void ConvolutionTailWorker::run() {
+    const mixxx::ScopedThreadRole threadRole(mixxx::ThreadRole::EngineWorker);
+    while (true) {
+        m_semaRun.acquire();
+        if (m_stop) {
+            break;
+        }
+        const auto locker = lockMutex(&m_mutex);
+        for (PartitionedConvolver* pConvolver : m_convolvers) {
+            pConvolver->processTailJobs();
+        }
+    }
+}
+
+PartitionedConvolver::PartitionedConvolver(
+        std::shared_ptr<const ConvolutionKernel> pKernel,
+        std::shared_ptr<ConvolutionTailWorker> pWorker)
+        : m_pKernel(std::move(pKernel)),
+          m_pWorker(std::move(pWorker)),
+          m_blockFrames(m_pKernel->blockFrames()),
+          m_tailBlocks(static_cast<int>(m_pKernel->tailBlockFrames() / m_blockFrames)),
+          m_head(m_pKernel->head()),
+          m_input(m_blockFrames),
+          m_output(m_blockFrames),
+          m_position(0),
+          m_tailBlockCount(0),
+          m_playTailOutput(false),
+          m_tailJobsSubmitted(0),
+          m_tailJobsProcessed(0),
+          m_tailBusy(false),
+          m_tailResetRequested(false) {
+    const ConvolutionPartitions* pTailPartitions = m_pKernel->tail();
+    if (!pTailPartitions) {
+        return;
+    }
+    m_pTail = std::make_unique<UniformPartitionedConvolution>(*pTailPartitions);
+    for (auto& tailJob : m_tailJobs) {
+        tailJob.input.resize(pTailPartitions->partitionFrames());
+        tailJob.output.resize(pTailPartitions->partitionFrames());
+    }
+    if (m_pWorker) {
+        m_pWorker->addConvolver(this);
+    }
+}
+
+PartitionedConvolver::~PartitionedConvolver() {
+    if (m_pTail && m_pWorker) {
+        m_pWorker->removeConvolver(this);
+    }
+}
+
+void PartitionedConvolver::process(const CSAMPLE* pInput,
+        CSAMPLE* pOutput,
+        SINT frameCount,
+        int sampleStride) {
+    SINT frame = 0;
+    while (frame < frameCount) {
+        const SINT frames = math_min(frameCount - frame, m_blockFrames - m_position);
+        for (SINT i = 0; i < frames; ++i) {
+            const SINT sample = (frame + i) * sampleStride;
+            m_input[m_position + i] = pInput[sample];
+            pOutput[sample] = m_output[m_position + i];
+        }
+        frame += frames;
+        m_position += frames;
+        if (m_position == m_blockFrames) {
+            processBlock();
+            m_position = 0;
+        }
+    }
+}
+
+void PartitionedConvolver::processBlock() {
+    m_head.process(m_input.data(), m_output.data());
+    if (!m_pTail || m_tailResetRequested.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    // The tail is delayed by two tail blocks, the first one of them is the
+    // time it takes to collect the input for a tail job.
+    const int tailBlock = static_cast<int>(m_tailBlockCount % m_tailBlocks);
+    // The job that collects the input of this block
+    const int job = static_cast<int>(m_tailBlockCount / m_tailBlocks);
+    if (tailBlock == 0) {
+        int processed = m_tailJobsProcessed.load(std::memory_order_acquire);
+        if (job >= 2 && processed < job - 1) {
+            // The worker has fallen behind. Process the pending jobs here
+            // unless the worker is processing them right now.
+            processTailJobs();
+            processed = m_tailJobsProcessed.load(std::memory_order_acquire);
+        }
+        if (processed < job - 2) {
+            // The worker is still reading the input of the job that used
+            // the same slot before.
+            requestTailReset();
+            return;
+        }
+        m_playTailOutput = job >= 2 && processed >= job - 1;
+    }
+
+    if (m_playTailOutput) {
+        const float* pTailOutput = m_tailJobs[(job - 2) % kTailJobSlots].output.data() +
+                tailBlock * m_blockFrames;
+        for (SINT i = 0; i < m_blockFrames; ++i) {
+            m_output[i] += pTailOutput[i];
+        }
+    }
+
+    std::copy(m_input.begin(),
+            m_input.end(),
+            m_tailJobs[job % kTailJobSlots].input.begin() + tailBlock * m_blockFrames);
+    if (tailBlock == m_tailBlocks - 1) {
+        m_tailJobsSubmitted.store(job + 1, std::memory_order_release);
+        if (m_pWorker) {
+            m_pWorker->wake();
+        } else {
+            processTailJobs();
+        }
+    }
+    ++m_tailBlockCount;
+}
+
+bool PartitionedConvolver::processTailJobs() {
+    if (m_tailBusy.exchange(true, std::memory_order_acquire)) {
+        return false;
+    }
+    if (m_tailResetRequested.load(std::memory_order_acquire)) {
+        m_pTail->clear();
+        m_tailJobsProcessed.store(0, std::memory_order_relaxed);
+        m_tailResetRequested.store(false, std::memory_order_release);
+    } else {
+        const int submitted = m_tailJobsSubmitted.load(std::memory_order_acquire);
+        for (int job = m_tailJobsProcessed.load(std::memory_order_relaxed);
+                job < submitted;
+                ++job) {
+            TailJob& tailJob = m_tailJobs[job % kTailJobSlots];
+            m_pTail->process(tailJob.input.data(), tailJob.output.data());
+            m_tailJobsProcessed.store(job + 1, std::memory_order_release);
+        }
+    }
+    m_tailBusy.store(false, std::memory_order_release);
+    return true;
+}
+
+bool PartitionedConvolver::hasPendingTailJobs() const {
+    return m_tailResetRequested.load(std::memory_order_acquire) ||
+            m_tailJobsProcessed.load(std::memory_order_acquire) <
+            m_tailJobsSubmitted.load(std::memory_order_relaxed);
+}
+
+void PartitionedConvolver::requestTailReset() {
+    // The slots are not touched by the audio thread until the reset
+    // has been processed, the jobs of the new tail are counted from zero.
+    m_tailJobsSubmitted.store(0, std::memory_order_relaxed);
+    m_tailResetRequested.store(true, std::memory_order_release);
+    m_tailBlockCount = 0;
+    if (m_pWorker) {
+        m_pWorker->wake();
+    } else {
+        processTailJobs();
+    }
+}
+
+void PartitionedConvolver::clear() {
+    m_head.clear();
+    std::fill(m_input.begin(), m_input.end(), 0.0f);
+    std::fill(m_output.begin(), m_output.end(), 0.0f);
+    m_position = 0;
+    if (m_pTail) {
+        requestTailReset();
+    }
+}
+
+std::size_t PartitionedConvolver::heapBytes() const {
+    std::size_t bytes = m_head.heapBytes() +
+            (m_input.size() + m_output.size()) * sizeof(float);
+    if (m_pTail) {
+        bytes += m_pTail->heapBytes();
+        for (const auto& tailJob : m_tailJobs) {
+            bytes += (tailJob.input.size() + tailJob.output.size()) * sizeof(float);
+        }
+    }
+    return bytes;
+}
+
+} // namespace mixxx
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <QMutex>
+#include <QSemaphore>
+#include <QThread>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "util/class.h"
+#include "util/types.h"
+
+class FFTReal;
+
+namespace mixxx {
+
+/// The spectra of an impulse response that is split into partitions
+/// of uniform length. Each partition is zero-padded to twice its length
+/// for overlap-save convolution.
+class ConvolutionPartitions final {
+  public:
+    ConvolutionPartitions(const float* pImpulseResponse,
+            SINT length,
+            SINT partitionFrames);
+
+    SINT partitionFrames() const {
+        return m_partitionFrames;
+    }
+    /// The number of frequency bins of each partition
+    SINT binCount() const {
+        return m_partitionFrames + 1;
+    }
+    int count() const {
+        return m_count;
+    }
+    const float* real(int partition) const {
+        return &m_real[partition * binCount()];
+    }
+    const float* imag(int partition) const {
+        return &m_imag[partition * binCount()];
+    }
+
+    std::size_t heapBytes() const {
+        return (m_real.size() + m_imag.size()) * sizeof(float);
+    }
+
+  private:
+    const SINT m_partitionFrames;
+    int m_count;
+    std::vector<float> m_real;
+    std::vector<float> m_imag;
+};
+
+/// A mono impulse response prepared for a PartitionedConvolver.
+///
+/// The head of the impulse response is split into short partitions of
+/// the engine buffer size that are convolved in the audio thread. The
+/// remaining tail is split into longer partitions that are convolved
+/// on a background thread. The tail starts after two tail partitions,
+/// which leaves the background thread more than the duration of one
+/// tail partition for each job.
+///
+/// Kernels are immutable and may be shared by multiple convolvers.
+class ConvolutionKernel final {
+  public:
+    ConvolutionKernel(const std::vector<float>& impulseResponse,
+            SINT blockFrames);
+
+    /// The length of the tail partitions for the given engine buffer
+    /// size. Always a multiple of the buffer size.
+    static SINT tailBlockFrames(SINT blockFrames);
+
+    SINT length() const {
+        return m_length;
+    }
+    SINT blockFrames() const {
+        return m_head.partitionFrames();
+    }
+    SINT tailBlockFrames() const {
+        return m_tail ? m_tail->partitionFrames() : 0;
+    }
+    const ConvolutionPartitions& head() const {
+        return m_head;
+    }
+    /// nullptr if the impulse response is short enough to be
+    /// convolved entirely in the audio thread
+    const ConvolutionPartitions* tail() const {
+        return m_tail.get();
+    }
+
+    std::size_t heapBytes() const;
+
+  private:
+    const SINT m_length;
+    ConvolutionPartitions m_head;
+    std::unique_ptr<ConvolutionPartitions> m_tail;
+};
+
+/// Uniformly partitioned overlap-save convolution. Each call of process()
+/// convolves one block of input with all partitions by accumulating the
+/// products with a delay line of the past input spectra.
+class UniformPartitionedConvolution final {
+  public:
+    explicit UniformPartitionedConvolution(const ConvolutionPartitions& partitions);
+    ~UniformPartitionedConvolution();
+
+    /// Consumes and produces partitionFrames() samples
+    void process(const float* pInput, float* pOutput);
+    void clear();
+
+    std::size_t heapBytes() const;
+
+  private:
+    const ConvolutionPartitions& m_partitions;
+    const std::unique_ptr<FFTReal> m_pFft;
+    // The previous and the current input block
+    std::vector<double> m_time;
+    // Scratch buffers for the full spectrum that FFTReal produces
+    std::vector<double> m_real;
+    std::vector<double> m_imag;
+    // The spectra of the past input blocks, the most recent one at m_delayLinePosition
+    std::vector<float> m_delayLineReal;
+    std::vector<float> m_delayLineImag;
+    int m_delayLinePosition;
+    std::vector<double> m_accumulatorReal;
+    std::vector<double> m_accumulatorImag;
+
+    DISALLOW_COPY_AND_ASSIGN(UniformPartitionedConvolution);
+};
+
+class PartitionedConvolver;
+
+/// Convolves the tails of all registered convolvers in the background.
+/// It is woken up by the audio thread after a tail block has been
+/// submitted. Convolvers are registered and unregistered on the main
+/// thread.
+class ConvolutionTailWorker final : public QThread {
+  public:
+    ConvolutionTailWorker();
+    ~ConvolutionTailWorker() override;
+
+    void addConvolver(PartitionedConvolver* pConvolver);
+    /// Blocks until the worker doesn't access the convolver anymore
+    void removeConvolver(PartitionedConvolver* pConvolver);
+
+    /// Called from the audio thread
+    void wake() {
+        m_semaRun.release();
+    }
+
+  protected:
+    void run() override;
+
+  private:
+    QSemaphore m_semaRun;
+    QMutex m_mutex;
+    std::vector<PartitionedConvolver*> m_convolvers;
+    std::atomic<bool> m_stop;
+};
+
+/// Convolves a mono signal with a ConvolutionKernel.
+///
+/// The latency is one engine buffer, i.e. the block size of the kernel:
+/// Each buffer of input is convolved with the head partitions as a whole
+/// and the output is played during the next buffer. The convolution of the
+/// tail is handed over to the ConvolutionTailWorker. If the worker has not
+/// started a pending tail job in time, the audio thread picks it up itself.
+/// The audio thread never waits for the worker: The output of a tail job
+/// that is still being processed is skipped, and if the worker falls behind
+/// even further the tail is reset. Without a worker the tail is always
+/// convolved in the audio thread.
+class PartitionedConvolver final {
+  public:
+    PartitionedConvolver(std::shared_ptr<const ConvolutionKernel> pKernel,
+            std::shared_ptr<ConvolutionTailWorker> pWorker);
+    ~PartitionedConvolver();
+
+    /// Every sampleStride-th sample of the buffers belongs to the
+    /// convolved channel, e.g. 2 for one channel of a stereo buffer.
+    /// pInput and pOutput may be the same buffer.
+    void process(const CSAMPLE* pInput,
+            CSAMPLE* pOutput,
+            SINT frameCount,
+            int sampleStride);
+
+    /// Silences the convolver, e.g. when the effect is enabled again.
+    /// The tail is reset by the worker and stays silent until then.
+    void clear();
+
+    /// Processes the submitted tail jobs or a requested reset. Returns
+    /// false if the tail is already being processed by another thread.
+    bool processTailJobs();
+
+    /// Returns true until the worker has processed all submitted tail
+    /// jobs and the requested reset.
+    bool hasPendingTailJobs() const;
+
+    std::size_t heapBytes() const;
+
+  private:
+    struct TailJob {
+        std::vector<float> input;
+        std::vector<float> output;
+    };
+
+    /// A job is submitted while the result of the previous job is still
+    /// being played, the third one leaves the worker a tail block of slack.
+    static constexpr int kTailJobSlots = 3;
+
+    void processBlock();
+    void requestTailReset();
+
+    const std::shared_ptr<const ConvolutionKernel> m_pKernel;
+    const std::shared_ptr<ConvolutionTailWorker> m_pWorker;
+    const SINT m_blockFrames;
+    // The number of blocks per tail job
+    const int m_tailBlocks;
+
+    UniformPartitionedConvolution m_head;
+    std::vector<float> m_input;
+    std::vector<float> m_output;
+    SINT m_position;
+    // The number of blocks since the tail has been reset
+    SINT m_tailBlockCount;
+    // If the output of the current tail job is played
+    bool m_playTailOutput;
+
+    // The tail jobs and resets are processed in order by either the worker
+    // or the audio thread, whichever holds m_tailBusy.
+    std::unique_ptr<UniformPartitionedConvolution> m_pTail;
+    TailJob m_tailJobs[kTailJobSlots];
+    std::atomic<int> m_tailJobsSubmitted;
+    std::atomic<int> m_tailJobsProcessed;
+    std::atomic<bool> m_tailBusy;
+    // Set by the audio thread, which submits no jobs until it has been reset
+    std::atomic<bool> m_tailResetRequested;
+
+    DISALLOW_COPY_AND_ASSIGN(PartitionedConvolver);
+};
+
+} // namespace mixxx
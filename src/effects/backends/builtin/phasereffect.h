@@ -27,6 +27,11 @@ class PhaserGroupState final : public EffectState {
         SampleUtil::clear(oldOutRight, MAXSTAGES);
     }
 
+    bool resetForReuse() override {
+        clear();
+        return true;
+    }
+
     CSAMPLE oldInLeft[MAXSTAGES];
     CSAMPLE oldInRight[MAXSTAGES];
     CSAMPLE oldOutLeft[MAXSTAGES];
@@ -4,6 +4,8 @@
 #include <QHash>
 #include <QPair>
 #include <QString>
+#include <memory>
+#include <vector>
 
 #include "effects/defs.h"
 #include "engine/channelhandle.h"
@@ -44,21 +46,67 @@
 ///
 /// EffectStates allocated on the main thread are passed as pointers to the
 /// EffectProcessorImpl in the audio callback thread via the EffectsMessenger.
-/// EffectStates are allocated and deallocated when a routing switch for an
-/// EffectChain is toggled and when a new EngineEffect is loaded into an EffectSlot.
+/// EffectStates are only allocated for input channels that are routed to the
+/// EffectChain, either when a new EngineEffect is loaded into an EffectSlot or
+/// when a routing switch of the EffectChain is toggled on. When the routing
+/// switch is toggled off, the states are swapped out in the audio thread after
+/// the effect has faded out and returned to the main thread where they are
+/// kept in a small pool for the next input channel that is routed to the chain.
 /// This allows for scaling up to an arbitrary number of input signals
 /// without wasting a lot of memory. (EffectStates could be (de)allocated when toggling
 /// the enable switches for EffectSlots as well, but the memory savings would be
 /// relatively small compared to the additional code complexity.)
 class EffectState {
   public:
-    EffectState(const mixxx::EngineParameters& engineParameters) {
+    EffectState(const mixxx::EngineParameters& engineParameters)
+            : m_sampleRate(engineParameters.sampleRate()),
+              m_framesPerBuffer(engineParameters.framesPerBuffer()) {
         // Subclasses should call engineParametersChanged here.
-        Q_UNUSED(engineParameters);
     };
     virtual ~EffectState(){};
+
+    /// Called from the main thread before a recycled state is reused for
+    /// another input channel with the same engine parameters. Subclasses
+    /// that can discard the signal of the previous input channel without
+    /// reallocating their buffers do so here and return true. Otherwise
+    /// the state is deleted and a new one is created.
+    virtual bool resetForReuse() {
+        return false;
+    }
+
+    bool isCreatedFor(const mixxx::EngineParameters& engineParameters) const {
+        return m_sampleRate == engineParameters.sampleRate() &&
+                m_framesPerBuffer == engineParameters.framesPerBuffer();
+    }
+
+    /// The memory that is allocated on the heap by this state in addition
+    /// to its own size, e.g. for delay lines. Only used for reporting.
+    virtual std::size_t heapBytes() const {
+        return 0;
+    }
+
+  private:
+    const mixxx::audio::SampleRate m_sampleRate;
+    const SINT m_framesPerBuffer;
+};
+
+/// The memory that is used by the EffectStates of one EffectProcessor
+struct EffectStatesMemoryReport {
+    /// The number of input channels with states, either routed
+    /// to the effect or waiting in the pool to be reused
+    int inputChannelCount = 0;
+    int pooledInputChannelCount = 0;
+    int stateCount = 0;
+    std::size_t bytes = 0;
 };
 
+inline QDebug operator<<(QDebug dbg, const EffectStatesMemoryReport& report) {
+    return dbg << report.stateCount << "states for"
+               << report.inputChannelCount << "input channels ("
+               << report.pooledInputChannelCount << "pooled)," << report.bytes
+               << "bytes";
+}
+
 /// EffectProcessor is an abstract base class for interfacing with an EffectSlot
 /// in the main thread without needing to specify a specific EffectState subclass
 /// for the template in EffectProcessorImpl.
@@ -72,12 +120,26 @@ class EffectProcessor {
             const QSet<ChannelHandleAndGroup>& activeInputChannels,
             const QSet<ChannelHandleAndGroup>& registeredOutputChannels,
             const mixxx::EngineParameters& engineParameters) = 0;
-    virtual void initializeInputChannel(
-            ChannelHandle inputChannel,
-            const mixxx::EngineParameters& engineParameters) = 0;
     virtual void loadEngineEffectParameters(
             const QMap<QString, EngineEffectParameterPointer>& parameters) = 0;
-    virtual bool hasStatesForInputChannel(ChannelHandle inputChannel) const = 0;
+    /// Creates the states for all registered output channels of an input
+    /// channel or reuses recycled states after resetting or recreating them. The states
+    /// are installed in the audio thread with swapStatesForInputChannel().
+    virtual std::unique_ptr<EffectStatesForInputChannel> createStatesForInputChannel(
+            const mixxx::EngineParameters& engineParameters) = 0;
+    /// Takes back states that have been swapped out in the audio thread
+    /// and either keeps them for reuse or deletes them.
+    virtual void recycleStatesForInputChannel(
+            std::unique_ptr<EffectStatesForInputChannel> pStates) = 0;
+    virtual EffectStatesMemoryReport memoryReport() const = 0;
+
+    /// Called from the audio thread
+    /// Exchanges the states of an input channel with the given states,
+    /// without allocating or deleting any memory. Passing empty states
+    /// removes the states of the input channel.
+    virtual void swapStatesForInputChannel(
+            ChannelHandle inputChannel,
+            EffectStatesForInputChannel* pStates) = 0;
 
     /// Called from the audio thread
     /// This method takes a buffer of audio samples as pInput, processes the buffer
@@ -109,6 +171,14 @@ class EffectProcessor {
     /// the dry signal is delayed to overlap with the output wet signal
     /// after processing all effects in the effects chain.
     virtual SINT getGroupDelayFrames() = 0;
+
+    /// Called from the audio thread
+    /// Notifies the processor that the value of the parameter at the given
+    /// index of the manifest has been changed. Most processors read the
+    /// values of their parameters when processing and don't need this.
+    virtual void parameterChanged(int parameterIndex) {
+        Q_UNUSED(parameterIndex);
+    }
 };
 
 /// EffectProcessorImpl manages a separate EffectState for every combination of
@@ -154,8 +224,14 @@ class EffectProcessorImpl : public EffectProcessor {
             const mixxx::EngineParameters& engineParameters,
             const EffectEnableState enableState,
             const GroupFeatureState& groupFeatures) final {
-        EffectSpecificState* pState =
-                m_channelStateMatrix[inputHandle][outputHandle].get();
+        EffectSpecificState* pState = nullptr;
+        const EffectStatesForInputChannel& outputChannelStates =
+                m_channelStateMatrix[inputHandle];
+        if (outputHandle.handle() < static_cast<int>(outputChannelStates.size())) {
+            // Only states created by createSpecificState() are installed
+            pState = static_cast<EffectSpecificState*>(
+                    outputChannelStates[outputHandle.handle()].get());
+        }
         VERIFY_OR_DEBUG_ASSERT(pState != nullptr) {
             if (kEffectDebugOutput) {
                 qWarning() << "EffectProcessorImpl::process could not retrieve"
@@ -166,6 +242,7 @@ class EffectProcessorImpl : public EffectProcessor {
                               "main thread.";
             }
             SampleUtil::copy(pOutput, pInput, engineParameters.samplesPerBuffer());
+            return;
         }
         processChannel(pState, pInput, pOutput, engineParameters, enableState, groupFeatures);
     }
@@ -175,17 +252,40 @@ class EffectProcessorImpl : public EffectProcessor {
             const mixxx::EngineParameters& engineParameters) final {
         m_registeredOutputChannels = registeredOutputChannels;
 
+        // The processor is not yet known by the audio thread, so the
+        // states can be installed directly.
         for (const ChannelHandleAndGroup& inputChannel : activeInputChannels) {
-            initializeInputChannel(inputChannel.handle(), engineParameters);
+            std::unique_ptr<EffectStatesForInputChannel> pStates =
+                    createStatesForInputChannel(engineParameters);
+            swapStatesForInputChannel(inputChannel.handle(), pStates.get());
+            DEBUG_ASSERT(pStates->empty());
         }
     };
 
-    void initializeInputChannel(ChannelHandle inputChannel,
+    std::unique_ptr<EffectStatesForInputChannel> createStatesForInputChannel(
             const mixxx::EngineParameters& engineParameters) final {
-        if (kEffectDebugOutput) {
-            qDebug() << this << "EffectProcessorImpl::initialize allocating "
-                                "EffectStates for input"
-                     << inputChannel;
+        if (!m_pooledStates.empty()) {
+            std::unique_ptr<EffectStatesForInputChannel> pStates =
+                    std::move(m_pooledStates.back());
+            m_pooledStates.pop_back();
+            if (kEffectDebugOutput) {
+                qDebug() << this << "EffectProcessorImpl reusing EffectStates"
+                         << pStates.get();
+            }
+            // The states still contain the signal of the previous input
+            // channel and may have been created for other engine parameters.
+            // Only states that can't be reset in place are recreated.
+            for (auto& pState : *pStates) {
+                if (!pState ||
+                        (pState->isCreatedFor(engineParameters) &&
+                                pState->resetForReuse())) {
+                    continue;
+                }
+                m_memoryReport.bytes -= pState->heapBytes();
+                pState.reset(createSpecificState(engineParameters));
+                m_memoryReport.bytes += pState->heapBytes();
+            }
+            return pStates;
         }
 
         int requiredVectorSize = 0;
@@ -198,38 +298,54 @@ class EffectProcessorImpl : public EffectProcessor {
                 requiredVectorSize = vectorIndex + 1;
             }
         }
-
         DEBUG_ASSERT(requiredVectorSize > 0);
-        auto& outputChannelStates = m_channelStateMatrix[inputChannel];
-        DEBUG_ASSERT(outputChannelStates.size() == 0);
-        outputChannelStates.reserve(requiredVectorSize);
-        outputChannelStates.clear();
-        for (int i = 0; i < requiredVectorSize; ++i) {
-            outputChannelStates.push_back(std::unique_ptr<EffectSpecificState>());
-        }
+
+        auto pStates = std::make_unique<EffectStatesForInputChannel>(requiredVectorSize);
         for (const ChannelHandleAndGroup& outputChannel :
                 std::as_const(m_registeredOutputChannels)) {
-            outputChannelStates[outputChannel.handle()].reset(
-                    createSpecificState(engineParameters));
+            EffectSpecificState* pState = createSpecificState(engineParameters);
+            (*pStates)[outputChannel.handle()].reset(pState);
+            ++m_memoryReport.stateCount;
+            m_memoryReport.bytes += sizeof(EffectSpecificState) + pState->heapBytes();
             if (kEffectDebugOutput) {
                 qDebug() << this
-                         << "EffectProcessorImpl::initialize "
+                         << "EffectProcessorImpl::createStatesForInputChannel "
                             "registering output"
-                         << outputChannel << outputChannel.handle()
-                         << outputChannelStates[outputChannel.handle()].get();
+                         << outputChannel << outputChannel.handle() << pState;
             }
         }
-    };
+        ++m_memoryReport.inputChannelCount;
+        return pStates;
+    }
 
-    bool hasStatesForInputChannel(ChannelHandle inputChannel) const final {
-        if (inputChannel.handle() < m_channelStateMatrix.size()) {
-            for (const auto& pState : m_channelStateMatrix.at(inputChannel)) {
-                if (pState) {
-                    return true;
-                }
+    void recycleStatesForInputChannel(
+            std::unique_ptr<EffectStatesForInputChannel> pStates) final {
+        if (!pStates || pStates->empty()) {
+            return;
+        }
+        if (m_pooledStates.size() < kMaxPooledInputChannels) {
+            m_pooledStates.push_back(std::move(pStates));
+            return;
+        }
+        for (const auto& pState : std::as_const(*pStates)) {
+            if (pState) {
+                --m_memoryReport.stateCount;
+                m_memoryReport.bytes -= sizeof(EffectSpecificState) + pState->heapBytes();
             }
         }
-        return false;
+        --m_memoryReport.inputChannelCount;
+    }
+
+    EffectStatesMemoryReport memoryReport() const final {
+        EffectStatesMemoryReport report = m_memoryReport;
+        report.pooledInputChannelCount = static_cast<int>(m_pooledStates.size());
+        return report;
+    }
+
+    void swapStatesForInputChannel(
+            ChannelHandle inputChannel,
+            EffectStatesForInputChannel* pStates) final {
+        m_channelStateMatrix[inputChannel].swap(*pStates);
     }
 
   protected:
@@ -245,6 +361,14 @@ class EffectProcessorImpl : public EffectProcessor {
     };
 
   private:
+    /// The number of unrouted input channels whose states are kept for reuse.
+    /// Routing switches are usually toggled for one channel at a time.
+    static constexpr std::size_t kMaxPooledInputChannels = 2;
+
     QSet<ChannelHandleAndGroup> m_registeredOutputChannels;
-    ChannelHandleMap<std::vector<std::unique_ptr<EffectSpecificState>>> m_channelStateMatrix;
+    /// Only accessed by the audio thread after initialize()
+    ChannelHandleMap<EffectStatesForInputChannel> m_channelStateMatrix;
+    /// Only accessed by the main thread
+    std::vector<std::unique_ptr<EffectStatesForInputChannel>> m_pooledStates;
+    EffectStatesMemoryReport m_memoryReport;
 };
@@ -8,14 +8,23 @@
 #endif
 #include "effects/presets/effectpreset.h"
 
-EffectsBackendManager::EffectsBackendManager() {
+#ifdef __LILV__
+namespace {
+const QString kLV2ManifestCacheFile = QStringLiteral("/effects/lv2manifests.cache");
+} // anonymous namespace
+#endif
+
+EffectsBackendManager::EffectsBackendManager(UserSettingsPointer pConfig) {
     m_pNumEffectsAvailable = std::make_unique<ControlObject>(
             ConfigKey("[Master]", "num_effectsavailable"));
     m_pNumEffectsAvailable->setReadOnly();
 
     addBackend(EffectsBackendPointer(new BuiltInBackend()));
 #ifdef __LILV__
-    addBackend(EffectsBackendPointer(new LV2Backend()));
+    addBackend(EffectsBackendPointer(
+            new LV2Backend(pConfig->getSettingsPath() + kLV2ManifestCacheFile)));
+#else
+    Q_UNUSED(pConfig);
 #endif
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "effects/backends/effectsbackend.h"
+#include "preferences/usersettings.h"
 
 class ControlObject;
 
@@ -8,7 +9,7 @@ class ControlObject;
 /// available EffectManifests, and creates EffectProcessors from EffectManifests.
 class EffectsBackendManager {
   public:
-    EffectsBackendManager();
+    explicit EffectsBackendManager(UserSettingsPointer pConfig);
     ~EffectsBackendManager() = default;
 
     const QList<EffectManifestPointer>& getManifests() const {
@@ -1,24 +1,158 @@
 #include "effects/backends/lv2/lv2backend.h"
 
+#include <QDir>
+#include <QFileInfo>
+#include <QUrl>
+
 #include "effects/backends/lv2/lv2effectprocessor.h"
 #include "effects/backends/lv2/lv2manifest.h"
+#include "util/logger.h"
+#include "util/parsedfilecache.h"
+#include "util/performancetimer.h"
 
-LV2Backend::LV2Backend() {
-    m_pWorld = lilv_world_new();
-    initializeProperties();
-    lilv_world_load_all(m_pWorld);
-    enumeratePlugins();
+namespace {
+
+const mixxx::Logger kLogger("LV2Backend");
+
+// Increase when the binary serialization of LV2Manifest changes
+constexpr quint32 kManifestCacheVersion = 1;
+
+const QString kBundleManifestFileName = QStringLiteral("manifest.ttl");
+
+/// The directories that lilv searches for bundles, either from the
+/// LV2_PATH environment variable or the default paths of the platform.
+QStringList bundleSearchPaths() {
+    const QString lv2Path = qEnvironmentVariable("LV2_PATH");
+    if (!lv2Path.isEmpty()) {
+        return lv2Path.split(QDir::listSeparator(),
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+                Qt::SkipEmptyParts);
+#else
+                QString::SkipEmptyParts);
+#endif
+    }
+#if defined(__WINDOWS__)
+    return {
+            qEnvironmentVariable("APPDATA") + QStringLiteral("/LV2"),
+            qEnvironmentVariable("COMMONPROGRAMFILES") + QStringLiteral("/LV2"),
+    };
+#elif defined(__APPLE__)
+    return {
+            QDir::homePath() + QStringLiteral("/.lv2"),
+            QDir::homePath() + QStringLiteral("/Library/Audio/Plug-Ins/LV2"),
+            QStringLiteral("/Library/Audio/Plug-Ins/LV2"),
+            QStringLiteral("/usr/local/lib/lv2"),
+            QStringLiteral("/usr/lib/lv2"),
+    };
+#else
+    return {
+            QDir::homePath() + QStringLiteral("/.lv2"),
+            QStringLiteral("/usr/local/lib/lv2"),
+            QStringLiteral("/usr/lib/lv2"),
+            QStringLiteral("/usr/local/lib64/lv2"),
+            QStringLiteral("/usr/lib64/lv2"),
+    };
+#endif
+}
+
+/// The manifest files of all bundles that are currently installed
+QSet<QString> installedBundleManifests() {
+    QSet<QString> bundleManifests;
+    for (const auto& searchPath : bundleSearchPaths()) {
+        const QDir searchDir(searchPath);
+        const QStringList bundleNames =
+                searchDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+        for (const auto& bundleName : bundleNames) {
+            const QFileInfo manifestInfo(
+                    searchDir.filePath(bundleName + QChar('/') + kBundleManifestFileName));
+            if (manifestInfo.isFile()) {
+                bundleManifests.insert(manifestInfo.absoluteFilePath());
+            }
+        }
+    }
+    return bundleManifests;
+}
+
+QString bundleManifestOfPlugin(const LilvPlugin* pPlugin) {
+    const QString bundlePath = QUrl(QString::fromUtf8(lilv_node_as_uri(
+                                            lilv_plugin_get_bundle_uri(pPlugin))))
+                                       .toLocalFile();
+    return QFileInfo(QDir(bundlePath).filePath(kBundleManifestFileName)).absoluteFilePath();
+}
+
+} // anonymous namespace
+
+LV2Backend::LV2Backend(const QString& cacheFilePath)
+        : m_pWorld(nullptr) {
+    if (cacheFilePath.isEmpty()) {
+        ensureWorldLoaded();
+        enumeratePlugins(nullptr);
+        return;
+    }
+
+    mixxx::ParsedFileCache cache(cacheFilePath, kManifestCacheVersion);
+    if (loadManifestsFromCache(cache)) {
+        return;
+    }
+    cache.clear();
+    ensureWorldLoaded();
+    enumeratePlugins(&cache);
+    cache.save();
 }
 
 LV2Backend::~LV2Backend() {
     for (LilvNode* node : std::as_const(m_properties)) {
         lilv_node_free(node);
     }
-    lilv_world_free(m_pWorld);
+    if (m_pWorld) {
+        lilv_world_free(m_pWorld);
+    }
     m_registeredEffects.clear();
 }
 
-void LV2Backend::enumeratePlugins() {
+bool LV2Backend::loadManifestsFromCache(const mixxx::ParsedFileCache& cache) {
+    const QStringList cachedBundleManifests = cache.sourceFilePaths();
+    if (cachedBundleManifests.isEmpty()) {
+        return false;
+    }
+    // Bundles in directories that are not searched here are only
+    // validated, but new bundles in those directories are not detected.
+    const QSet<QString> installedManifests = installedBundleManifests();
+    for (const auto& bundleManifest : installedManifests) {
+        if (!cachedBundleManifests.contains(bundleManifest)) {
+            kLogger.info() << "Found new LV2 bundle" << bundleManifest;
+            return false;
+        }
+    }
+
+    QHash<QString, LV2EffectManifestPointer> registeredEffects;
+    for (const auto& bundleManifest : cachedBundleManifests) {
+        QList<LV2EffectManifestPointer> manifests;
+        if (!cache.readValue(bundleManifest, &manifests)) {
+            kLogger.info() << "LV2 bundle has been modified or removed" << bundleManifest;
+            return false;
+        }
+        for (const auto& pManifest : std::as_const(manifests)) {
+            pManifest->setBackendType(getType());
+            registeredEffects.insert(pManifest->id(), pManifest);
+        }
+    }
+    m_registeredEffects = registeredEffects;
+    kLogger.info() << "Restored" << m_registeredEffects.size()
+                   << "LV2 plugin manifests from" << cache.filePath();
+    return true;
+}
+
+void LV2Backend::enumeratePlugins(mixxx::ParsedFileCache* pCache) {
+    QHash<QString, QList<LV2EffectManifestPointer>> manifestsByBundle;
+    if (pCache) {
+        // Bundles without plugins, e.g. presets, must be cached
+        // to detect added bundles
+        for (const auto& bundleManifest : installedBundleManifests()) {
+            manifestsByBundle.insert(bundleManifest, {});
+        }
+    }
+
     const LilvPlugins* plugs = lilv_world_get_all_plugins(m_pWorld);
     LILV_FOREACH(plugins, i, plugs) {
         const LilvPlugin* plug = lilv_plugins_get(plugs, i);
@@ -28,10 +162,44 @@ void LV2Backend::enumeratePlugins() {
         auto lv2Manifest = LV2EffectManifestPointer::create(plug, m_properties);
         lv2Manifest->setBackendType(getType());
         m_registeredEffects.insert(lv2Manifest->id(), lv2Manifest);
+        if (pCache) {
+            manifestsByBundle[bundleManifestOfPlugin(plug)].append(lv2Manifest);
+        }
+    }
+
+    if (pCache) {
+        for (auto it = manifestsByBundle.constBegin(); it != manifestsByBundle.constEnd(); ++it) {
+            pCache->insertValue(it.key(), it.value());
+        }
+    }
+}
+
+void LV2Backend::ensureWorldLoaded() const {
+    if (m_pWorld) {
+        return;
+    }
+    PerformanceTimer timer;
+    timer.start();
+    m_pWorld = lilv_world_new();
+    initializeProperties();
+    lilv_world_load_all(m_pWorld);
+
+    // Resolve the plugins of the manifests that have been restored from the cache
+    const LilvPlugins* plugs = lilv_world_get_all_plugins(m_pWorld);
+    for (const auto& pManifest : std::as_const(m_registeredEffects)) {
+        LilvNode* uri = lilv_new_uri(m_pWorld, pManifest->id().toUtf8().constData());
+        const LilvPlugin* plug = lilv_plugins_get_by_uri(plugs, uri);
+        lilv_node_free(uri);
+        if (!plug) {
+            kLogger.warning() << "LV2 plugin" << pManifest->id()
+                              << "has been removed";
+        }
+        pManifest->setPlugin(plug);
     }
+    kLogger.info() << "Loaded LV2 world in" << timer.elapsed().debugMillisWithUnit();
 }
 
-void LV2Backend::initializeProperties() {
+void LV2Backend::initializeProperties() const {
     m_properties["audio_port"] = lilv_new_uri(m_pWorld, LV2_CORE__AudioPort);
     m_properties["input_port"] = lilv_new_uri(m_pWorld, LV2_CORE__InputPort);
     m_properties["output_port"] = lilv_new_uri(m_pWorld, LV2_CORE__OutputPort);
@@ -87,6 +255,7 @@ std::unique_ptr<EffectProcessor> LV2Backend::createProcessor(
     VERIFY_OR_DEBUG_ASSERT(pLV2Manifest) {
         return nullptr;
     }
+    ensureWorldLoaded();
     return std::make_unique<LV2EffectProcessor>(pLV2Manifest);
 }
 
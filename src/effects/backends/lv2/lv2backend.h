@@ -7,10 +7,20 @@
 #include "effects/defs.h"
 #include "preferences/usersettings.h"
 
+namespace mixxx {
+class ParsedFileCache;
+} // namespace mixxx
+
 /// Refer to EffectsBackend for documentation
+///
+/// Loading all installed LV2 bundles with lilv is slow, so the manifests of the
+/// plugins are cached per bundle. If none of the bundles has been added, removed
+/// or modified since the cache has been written, the manifests are restored from
+/// the cache and the LV2 world is only loaded when the first effect is created.
 class LV2Backend : public EffectsBackend {
   public:
-    LV2Backend();
+    /// An empty cache file path disables the manifest cache
+    explicit LV2Backend(const QString& cacheFilePath = QString());
     virtual ~LV2Backend();
 
     EffectBackendType getType() const {
@@ -27,10 +37,15 @@ class LV2Backend : public EffectsBackend {
     bool canInstantiateEffect(const QString& effectId) const;
 
   private:
-    void enumeratePlugins();
-    void initializeProperties();
-    LilvWorld* m_pWorld;
-    QHash<QString, LilvNode*> m_properties;
+    bool loadManifestsFromCache(const mixxx::ParsedFileCache& cache);
+    void enumeratePlugins(mixxx::ParsedFileCache* pCache);
+    void ensureWorldLoaded() const;
+    void initializeProperties() const;
+
+    // The world is loaded lazily on first use when the manifests
+    // have been restored from the cache.
+    mutable LilvWorld* m_pWorld;
+    mutable QHash<QString, LilvNode*> m_properties;
     QHash<QString, LV2EffectManifestPointer> m_registeredEffects;
 
     QString debugString() const {
@@ -5,19 +5,15 @@
 
 LV2EffectProcessor::LV2EffectProcessor(LV2EffectManifestPointer pManifest)
         : m_pManifest(pManifest),
+          m_bufferL(MAX_BUFFER_LEN),
+          m_bufferR(MAX_BUFFER_LEN),
           m_pPlugin(pManifest->getPlugin()),
           m_audioPortIndices(pManifest->getAudioPortIndices()),
           m_controlPortIndices(pManifest->getControlPortIndices()) {
-    m_inputL = new float[MAX_BUFFER_LEN];
-    m_inputR = new float[MAX_BUFFER_LEN];
-    m_outputL = new float[MAX_BUFFER_LEN];
-    m_outputR = new float[MAX_BUFFER_LEN];
 }
 
 void LV2EffectProcessor::loadEngineEffectParameters(
         const QMap<QString, EngineEffectParameterPointer>& parameters) {
-    m_LV2parameters = new float[parameters.size()];
-
     // EngineEffect passes the EngineEffectParameters indexed by ID string, which
     // is used directly by built-in EffectProcessorImpl subclasseses to access
     // specific named parameters. However, LV2EffectProcessor::process iterates
@@ -28,14 +24,23 @@ void LV2EffectProcessor::loadEngineEffectParameters(
     for (const auto& pManifestParameter : m_pManifest->parameters()) {
         m_engineEffectParameters.append(parameters.value(pManifestParameter->id()));
     }
+
+    // The control ports are connected to these values, they must not be
+    // reallocated afterwards.
+    m_LV2parameters.resize(m_engineEffectParameters.size());
+    for (int i = 0; i < m_engineEffectParameters.size(); i++) {
+        m_LV2parameters[i] = static_cast<float>(m_engineEffectParameters[i]->value());
+    }
 }
 
-LV2EffectProcessor::~LV2EffectProcessor() {
-    delete[] m_inputL;
-    delete[] m_inputR;
-    delete[] m_outputL;
-    delete[] m_outputR;
-    delete[] m_LV2parameters;
+void LV2EffectProcessor::parameterChanged(int parameterIndex) {
+    VERIFY_OR_DEBUG_ASSERT(parameterIndex >= 0 &&
+            parameterIndex < m_engineEffectParameters.size()) {
+        return;
+    }
+    // The control ports of all instances are connected to this value
+    m_LV2parameters[parameterIndex] = static_cast<float>(
+            m_engineEffectParameters[parameterIndex]->value());
 }
 
 void LV2EffectProcessor::processChannel(
@@ -47,18 +52,16 @@ void LV2EffectProcessor::processChannel(
         const GroupFeatureState& groupFeatures) {
     Q_UNUSED(groupFeatures);
 
-    for (int i = 0; i < m_engineEffectParameters.size(); i++) {
-        m_LV2parameters[i] = static_cast<float>(m_engineEffectParameters[i]->value());
+    LilvInstance* instance = channelState->lilvInstance();
+    if (!instance) {
+        // The plugin could not be instantiated
+        SampleUtil::copy(pOutput, pInput, engineParameters.samplesPerBuffer());
+        return;
     }
 
-    SINT framesPerBuffer = engineParameters.framesPerBuffer();
-    // note: LOOP VECTORIZED.
-    for (SINT i = 0; i < framesPerBuffer; ++i) {
-        m_inputL[i] = pInput[i * 2];
-        m_inputR[i] = pInput[i * 2 + 1];
-    }
-
-    LilvInstance* instance = channelState->lilvInstance(m_pPlugin, engineParameters);
+    const SINT framesPerBuffer = engineParameters.framesPerBuffer();
+    SampleUtil::deinterleaveBuffer(
+            m_bufferL.data(), m_bufferR.data(), pInput, framesPerBuffer);
 
     if (enableState == EffectEnableState::Enabling) {
         lilv_instance_activate(instance);
@@ -66,11 +69,8 @@ void LV2EffectProcessor::processChannel(
 
     lilv_instance_run(instance, framesPerBuffer);
 
-    // note: LOOP VECTORIZED.
-    for (SINT i = 0; i < framesPerBuffer; ++i) {
-        pOutput[i * 2] = m_outputL[i];
-        pOutput[i * 2 + 1] = m_outputR[i];
-    }
+    SampleUtil::interleaveBuffer(
+            pOutput, m_bufferL.data(), m_bufferR.data(), framesPerBuffer);
 
     if (enableState == EffectEnableState::Disabling) {
         lilv_instance_deactivate(instance);
@@ -80,7 +80,13 @@ void LV2EffectProcessor::processChannel(
 LV2EffectGroupState* LV2EffectProcessor::createSpecificState(
         const mixxx::EngineParameters& engineParameters) {
     LV2EffectGroupState* pState = new LV2EffectGroupState(engineParameters);
-    LilvInstance* pInstance = pState->lilvInstance(m_pPlugin, engineParameters);
+    if (!m_pPlugin) {
+        // The plugin has been uninstalled since the manifest has been cached,
+        // the state passes the signal through.
+        qWarning() << "LV2 plugin" << m_pManifest->id() << "is not available";
+        return pState;
+    }
+    LilvInstance* pInstance = pState->createLilvInstance(m_pPlugin, engineParameters);
     VERIFY_OR_DEBUG_ASSERT(pInstance) {
         return pState;
     }
@@ -89,20 +95,18 @@ LV2EffectGroupState* LV2EffectProcessor::createSpecificState(
         qDebug() << this << "LV2EffectProcessor creating LV2EffectGroupState" << pState;
     }
 
-    if (pInstance) {
-        for (int i = 0; i < m_engineEffectParameters.size(); i++) {
-            m_LV2parameters[i] = static_cast<float>(m_engineEffectParameters[i]->value());
-            lilv_instance_connect_port(pInstance,
-                    m_controlPortIndices[i],
-                    &m_LV2parameters[i]);
-        }
-
-        // We assume the audio ports are in the following order:
-        // input_left, input_right, output_left, output_right
-        lilv_instance_connect_port(pInstance, m_audioPortIndices[0], m_inputL);
-        lilv_instance_connect_port(pInstance, m_audioPortIndices[1], m_inputR);
-        lilv_instance_connect_port(pInstance, m_audioPortIndices[2], m_outputL);
-        lilv_instance_connect_port(pInstance, m_audioPortIndices[3], m_outputR);
+    for (int i = 0; i < m_engineEffectParameters.size(); i++) {
+        lilv_instance_connect_port(pInstance,
+                m_controlPortIndices[i],
+                &m_LV2parameters[i]);
     }
+
+    // We assume the audio ports are in the following order:
+    // input_left, input_right, output_left, output_right
+    // Inputs and outputs share the same buffers for in-place processing.
+    lilv_instance_connect_port(pInstance, m_audioPortIndices[0], m_bufferL.data());
+    lilv_instance_connect_port(pInstance, m_audioPortIndices[1], m_bufferR.data());
+    lilv_instance_connect_port(pInstance, m_audioPortIndices[2], m_bufferL.data());
+    lilv_instance_connect_port(pInstance, m_audioPortIndices[3], m_bufferR.data());
     return pState;
 };
@@ -2,11 +2,14 @@
 
 #include <lilv/lilv.h>
 
+#include <vector>
+
 #include "effects/backends/effectprocessor.h"
 #include "effects/backends/lv2/lv2manifest.h"
 #include "effects/defs.h"
 #include "engine/effects/engineeffectparameter.h"
 #include "engine/engine.h"
+#include "util/samplebuffer.h"
 
 // Refer to EffectProcessor for documentation
 class LV2EffectGroupState final : public EffectState {
@@ -22,12 +25,16 @@ class LV2EffectGroupState final : public EffectState {
         }
     }
 
-    LilvInstance* lilvInstance(const LilvPlugin* pPlugin,
+    /// Instantiates the plugin once when the state is created in the main thread
+    LilvInstance* createLilvInstance(const LilvPlugin* pPlugin,
             const mixxx::EngineParameters& engineParameters) {
-        if (!m_pInstance) {
-            m_pInstance = lilv_plugin_instantiate(
-                    pPlugin, engineParameters.sampleRate(), nullptr);
-        }
+        DEBUG_ASSERT(!m_pInstance);
+        m_pInstance = lilv_plugin_instantiate(
+                pPlugin, engineParameters.sampleRate(), nullptr);
+        return m_pInstance;
+    }
+
+    LilvInstance* lilvInstance() const {
         return m_pInstance;
     }
 
@@ -35,10 +42,16 @@ class LV2EffectGroupState final : public EffectState {
     LilvInstance* m_pInstance;
 };
 
+/// The interleaved samples of the engine are split into planar buffers that are
+/// processed in-place by the plugin. In-place processing is supported by all
+/// plugins without the lv2:inPlaceBroken feature, and plugins that require any
+/// features are not loaded at all (see LV2Manifest).
+///
+/// All instances share the same audio and control port buffers. Ports are
+/// connected only once when a state is created, since the buffers never move.
 class LV2EffectProcessor final : public EffectProcessorImpl<LV2EffectGroupState> {
   public:
     LV2EffectProcessor(LV2EffectManifestPointer pManifest);
-    ~LV2EffectProcessor();
 
     void loadEngineEffectParameters(
             const QMap<QString, EngineEffectParameterPointer>& parameters) override;
@@ -51,17 +64,18 @@ class LV2EffectProcessor final : public EffectProcessorImpl<LV2EffectGroupState>
             const EffectEnableState enableState,
             const GroupFeatureState& groupFeatures) override;
 
+    /// Copies the new value of the parameter to its control port
+    void parameterChanged(int parameterIndex) override;
+
   private:
     LV2EffectGroupState* createSpecificState(
             const mixxx::EngineParameters& engineParameters) override;
 
     LV2EffectManifestPointer m_pManifest;
     QList<EngineEffectParameterPointer> m_engineEffectParameters;
-    float* m_inputL;
-    float* m_inputR;
-    float* m_outputL;
-    float* m_outputR;
-    float* m_LV2parameters;
+    mixxx::SampleBuffer m_bufferL;
+    mixxx::SampleBuffer m_bufferR;
+    std::vector<float> m_LV2parameters;
     const LilvPlugin* m_pPlugin;
     const QList<int> m_audioPortIndices;
     const QList<int> m_controlPortIndices;
@@ -154,6 +154,12 @@ LV2Manifest::LV2Manifest(const LilvPlugin* plug,
     lilv_nodes_free(features);
 }
 
+LV2Manifest::LV2Manifest()
+        : EffectManifest(),
+          m_pLV2plugin(nullptr),
+          m_status(AVAILABLE) {
+}
+
 QList<int> LV2Manifest::getAudioPortIndices() {
     return audioPortIndices;
 }
@@ -166,6 +172,10 @@ const LilvPlugin* LV2Manifest::getPlugin() {
     return m_pLV2plugin;
 }
 
+void LV2Manifest::setPlugin(const LilvPlugin* pPlugin) {
+    m_pLV2plugin = pPlugin;
+}
+
 LV2Manifest::Status LV2Manifest::getStatus() {
     return m_status;
 }
@@ -191,3 +201,72 @@ void LV2Manifest::buildEnumerationOptions(const LilvPort* port,
         lilv_scale_points_free(options);
     }
 }
+
+QDataStream& operator<<(QDataStream& stream, const LV2Manifest& manifest) {
+    stream << manifest.id()
+           << manifest.name()
+           << manifest.author()
+           << static_cast<qint32>(manifest.m_status)
+           << manifest.audioPortIndices
+           << manifest.controlPortIndices
+           << static_cast<qint32>(manifest.parameters().size());
+    for (const auto& pParameter : manifest.parameters()) {
+        stream << pParameter->id()
+               << pParameter->name()
+               << static_cast<qint32>(pParameter->unitsHint())
+               << static_cast<qint32>(pParameter->valueScaler())
+               << pParameter->getMinimum()
+               << pParameter->getDefault()
+               << pParameter->getMaximum()
+               << pParameter->getSteps();
+    }
+    return stream;
+}
+
+QDataStream& operator>>(QDataStream& stream, LV2Manifest& manifest) {
+    QString id;
+    QString name;
+    QString author;
+    qint32 status = 0;
+    qint32 parameterCount = 0;
+    stream >> id >> name >> author >> status >>
+            manifest.audioPortIndices >> manifest.controlPortIndices >>
+            parameterCount;
+    manifest.setId(id);
+    manifest.setName(name);
+    manifest.setAuthor(author);
+    manifest.m_status = static_cast<LV2Manifest::Status>(status);
+
+    for (qint32 i = 0; i < parameterCount && stream.status() == QDataStream::Ok; ++i) {
+        QString parameterId;
+        QString parameterName;
+        qint32 unitsHint = 0;
+        qint32 valueScaler = 0;
+        double minimum = 0;
+        double defaultValue = 0;
+        double maximum = 0;
+        QList<QPair<QString, double>> steps;
+        stream >> parameterId >> parameterName >> unitsHint >> valueScaler >>
+                minimum >> defaultValue >> maximum >> steps;
+
+        EffectManifestParameterPointer param = manifest.addParameter();
+        param->setId(parameterId);
+        param->setName(parameterName);
+        param->setUnitsHint(static_cast<EffectManifestParameter::UnitsHint>(unitsHint));
+        param->setValueScaler(static_cast<EffectManifestParameter::ValueScaler>(valueScaler));
+        param->setRange(minimum, defaultValue, maximum);
+        for (const auto& step : std::as_const(steps)) {
+            param->appendStep(step);
+        }
+    }
+    return stream;
+}
+
+QDataStream& operator<<(QDataStream& stream, const LV2EffectManifestPointer& pManifest) {
+    return stream << *pManifest;
+}
+
+QDataStream& operator>>(QDataStream& stream, LV2EffectManifestPointer& pManifest) {
+    pManifest = LV2EffectManifestPointer::create();
+    return stream >> *pManifest;
+}
@@ -2,6 +2,7 @@
 
 #include <lilv/lilv.h>
 
+#include <QDataStream>
 #include <QSharedPointer>
 #include <vector>
 
@@ -18,13 +19,22 @@ class LV2Manifest : public EffectManifest {
     };
 
     LV2Manifest(const LilvPlugin* plug, QHash<QString, LilvNode*>& properties);
+    /// An empty manifest without a plugin that is filled from the cache
+    LV2Manifest();
 
     QList<int> getAudioPortIndices();
     QList<int> getControlPortIndices();
     const LilvPlugin* getPlugin();
+    /// Sets the plugin of a cached manifest after the LV2 world has been loaded
+    void setPlugin(const LilvPlugin* pPlugin);
     bool isValid();
     Status getStatus();
 
+    /// Binary serialization for the manifest cache of LV2Backend. Only the
+    /// properties that are read from the plugin are included.
+    friend QDataStream& operator<<(QDataStream& stream, const LV2Manifest& manifest);
+    friend QDataStream& operator>>(QDataStream& stream, LV2Manifest& manifest);
+
   private:
     void buildEnumerationOptions(const LilvPort* port,
             EffectManifestParameterPointer param);
@@ -47,3 +57,6 @@ class LV2Manifest : public EffectManifest {
 };
 
 typedef QSharedPointer<LV2Manifest> LV2EffectManifestPointer;
+
+QDataStream& operator<<(QDataStream& stream, const LV2EffectManifestPointer& pManifest);
+QDataStream& operator>>(QDataStream& stream, LV2EffectManifestPointer& pManifest);
@@ -397,10 +397,11 @@ void EffectChain::enableForInputChannel(const ChannelHandleAndGroup& handleGroup
     request->EnableInputChannelForChain.channelHandle = handleGroup.handle();
 
     // Initialize EffectStates for the input channel here in the main thread to
-    // avoid allocating memory in the realtime audio callback thread.
+    // avoid allocating memory in the realtime audio callback thread. They are
+    // installed before the chain is enabled for the input channel.
 
     for (int i = 0; i < m_effectSlots.size(); ++i) {
-        m_effectSlots[i]->initalizeInputChannel(handleGroup.handle());
+        m_effectSlots[i]->installStatesForInputChannel(handleGroup.handle());
     }
 
     m_pMessenger->writeRequest(request);
@@ -418,6 +419,10 @@ void EffectChain::disableForInputChannel(const ChannelHandleAndGroup& handleGrou
     request->pTargetChain = m_pEngineEffectChain;
     request->DisableInputChannelForChain.channelHandle = handleGroup.handle();
     m_pMessenger->writeRequest(request);
+
+    for (int i = 0; i < m_effectSlots.size(); ++i) {
+        m_effectSlots[i]->releaseStatesForInputChannel(handleGroup.handle());
+    }
 }
 
 int EffectChain::presetIndex() const {
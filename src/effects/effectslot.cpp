@@ -164,6 +164,11 @@ void EffectSlot::removeFromEngine() {
         return;
     }
 
+    if (kEffectDebugOutput) {
+        qDebug() << this << m_group << "EffectState memory of"
+                 << m_pEngineEffect->name() << m_pEngineEffect->memoryReport();
+    }
+
     EffectsRequest* request = new EffectsRequest();
     request->type = EffectsRequest::REMOVE_EFFECT_FROM_CHAIN;
     request->pTargetChain = m_pEngineEffectChain;
@@ -192,12 +197,45 @@ void EffectSlot::updateEngineState() {
     }
 }
 
-void EffectSlot::initalizeInputChannel(ChannelHandle inputChannel) {
+void EffectSlot::installStatesForInputChannel(ChannelHandle inputChannel) {
     if (!m_pEngineEffect) {
         return;
     }
-    m_pEngineEffect->initalizeInputChannel(inputChannel);
-};
+    // The states are allocated here in the main thread to avoid allocating
+    // memory in the realtime audio callback thread.
+    std::unique_ptr<EffectStatesForInputChannel> pStates =
+            m_pEngineEffect->createStatesForInputChannel(inputChannel);
+    if (!pStates) {
+        return;
+    }
+
+    EffectsRequest* pRequest = new EffectsRequest();
+    pRequest->type = EffectsRequest::SWAP_EFFECT_STATES_FOR_INPUT_CHANNEL;
+    pRequest->pTargetChain = m_pEngineEffectChain;
+    pRequest->SwapEffectStatesForInputChannel.pEffect = m_pEngineEffect;
+    pRequest->SwapEffectStatesForInputChannel.channelHandle = inputChannel;
+    pRequest->SwapEffectStatesForInputChannel.pStates = pStates.release();
+    m_pMessenger->writeRequest(pRequest);
+}
+
+void EffectSlot::releaseStatesForInputChannel(ChannelHandle inputChannel) {
+    if (!m_pEngineEffect) {
+        return;
+    }
+    if (!m_pEngineEffect->releaseStatesForInputChannel(inputChannel)) {
+        return;
+    }
+
+    // The states are swapped with the empty states and returned to
+    // the EngineEffect for reuse by EffectsMessenger::collectGarbage()
+    EffectsRequest* pRequest = new EffectsRequest();
+    pRequest->type = EffectsRequest::SWAP_EFFECT_STATES_FOR_INPUT_CHANNEL;
+    pRequest->pTargetChain = m_pEngineEffectChain;
+    pRequest->SwapEffectStatesForInputChannel.pEffect = m_pEngineEffect;
+    pRequest->SwapEffectStatesForInputChannel.channelHandle = inputChannel;
+    pRequest->SwapEffectStatesForInputChannel.pStates = new EffectStatesForInputChannel();
+    m_pMessenger->writeRequest(pRequest);
+}
 
 EffectManifestPointer EffectSlot::getManifest() const {
     return m_pManifest;
@@ -123,7 +123,12 @@ class EffectSlot : public QObject {
         return m_group;
     }
 
-    void initalizeInputChannel(ChannelHandle inputChannel);
+    /// Allocates the EffectStates for an input channel that is routed to
+    /// the chain and sends them to the audio thread
+    void installStatesForInputChannel(ChannelHandle inputChannel);
+    /// Requests to remove the EffectStates of an input channel that is
+    /// no longer routed to the chain after it has been faded out
+    void releaseStatesForInputChannel(ChannelHandle inputChannel);
 
     EffectManifestPointer getManifest() const;
 
@@ -13,6 +13,9 @@ EffectsMessenger::EffectsMessenger(
 
 EffectsMessenger::~EffectsMessenger() {
     for (auto it = m_activeRequests.begin(); it != m_activeRequests.end(); it++) {
+        if (it.value()->type == EffectsRequest::SWAP_EFFECT_STATES_FOR_INPUT_CHANNEL) {
+            delete it.value()->SwapEffectStatesForInputChannel.pStates;
+        }
         delete it.value();
     }
 }
@@ -79,7 +82,7 @@ void EffectsMessenger::processEffectsResponses() {
     }
 }
 
-void EffectsMessenger::collectGarbage(const EffectsRequest* pRequest) {
+void EffectsMessenger::collectGarbage(EffectsRequest* pRequest) {
     if (pRequest->type == EffectsRequest::REMOVE_EFFECT_FROM_CHAIN) {
         if (kEffectDebugOutput) {
             qDebug() << debugString() << "delete" << pRequest->RemoveEffectFromChain.pEffect;
@@ -90,5 +93,12 @@ void EffectsMessenger::collectGarbage(const EffectsRequest* pRequest) {
             qDebug() << debugString() << "delete" << pRequest->RemoveEffectChain.pChain;
         }
         delete pRequest->RemoveEffectChain.pChain;
+    } else if (pRequest->type == EffectsRequest::SWAP_EFFECT_STATES_FOR_INPUT_CHANNEL) {
+        // Either the states that have been removed from the input channel
+        // or the new states if they have not been needed
+        pRequest->SwapEffectStatesForInputChannel.pEffect->recycleStatesForInputChannel(
+                std::unique_ptr<EffectStatesForInputChannel>(
+                        pRequest->SwapEffectStatesForInputChannel.pStates));
+        pRequest->SwapEffectStatesForInputChannel.pStates = nullptr;
     }
 }
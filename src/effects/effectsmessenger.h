@@ -24,7 +24,7 @@ class EffectsMessenger {
     void processEffectsResponses();
 
   private:
-    void collectGarbage(const EffectsRequest* pRequest);
+    void collectGarbage(EffectsRequest* pRequest);
 
     QString debugString() const {
         return "EffectsMessenger";
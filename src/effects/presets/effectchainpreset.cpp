@@ -2,6 +2,7 @@
 
 #include "effects/effectchain.h"
 #include "effects/presets/effectxmlelements.h"
+#include "util/assert.h"
 #include "util/xml.h"
 
 EffectChainPreset::EffectChainPreset()
@@ -94,3 +95,32 @@ const QDomElement EffectChainPreset::toXml(QDomDocument* doc) const {
 
 EffectChainPreset::~EffectChainPreset() {
 }
+
+QDataStream& operator<<(QDataStream& stream, const EffectChainPreset& preset) {
+    stream << preset.m_name
+           << static_cast<qint32>(preset.m_mixMode)
+           << preset.m_dSuper
+           << static_cast<qint32>(preset.m_effectPresets.size());
+    for (const auto& pEffectPreset : preset.m_effectPresets) {
+        VERIFY_OR_DEBUG_ASSERT(pEffectPreset) {
+            stream << EffectPreset();
+            continue;
+        }
+        stream << *pEffectPreset;
+    }
+    return stream;
+}
+
+QDataStream& operator>>(QDataStream& stream, EffectChainPreset& preset) {
+    qint32 mixMode = 0;
+    qint32 effectCount = 0;
+    stream >> preset.m_name >> mixMode >> preset.m_dSuper >> effectCount;
+    preset.m_mixMode = static_cast<EffectChainMixMode::Type>(mixMode);
+    preset.m_effectPresets.clear();
+    for (qint32 i = 0; i < effectCount && stream.status() == QDataStream::Ok; ++i) {
+        auto pEffectPreset = EffectPresetPointer::create();
+        stream >> *pEffectPreset;
+        preset.m_effectPresets.append(pEffectPreset);
+    }
+    return stream;
+}
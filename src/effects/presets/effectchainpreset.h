@@ -1,4 +1,5 @@
 #pragma once
+#include <QDataStream>
 #include <QDomElement>
 
 #include "effects/defs.h"
@@ -45,6 +46,10 @@ class EffectChainPreset {
         return m_effectPresets;
     }
 
+    /// Binary serialization for the preset cache
+    friend QDataStream& operator<<(QDataStream& stream, const EffectChainPreset& preset);
+    friend QDataStream& operator>>(QDataStream& stream, EffectChainPreset& preset);
+
   private:
     QString m_name;
     EffectChainMixMode::Type m_mixMode;
@@ -16,8 +16,30 @@ namespace {
 const QString kEffectChainPresetDirectory = QStringLiteral("/effects/chains");
 const QString kXmlFileExtension = QStringLiteral(".xml");
 const QString kFolderDelimiter = QStringLiteral("/");
+const QString kEffectChainPresetCacheFile = QStringLiteral("/effects/chains.cache");
+// Increase when the binary serialization of EffectChainPreset changes
+constexpr quint32 kEffectChainPresetCacheVersion = 1;
+
+} // anonymous namespace
+
+EffectChainPresetManager::EffectChainPresetManager(UserSettingsPointer pConfig,
+        EffectsBackendManagerPointer pBackendManager)
+        : m_pConfig(pConfig),
+          m_pBackendManager(pBackendManager),
+          m_presetCache(pConfig->getSettingsPath() + kEffectChainPresetCacheFile,
+                  kEffectChainPresetCacheVersion) {
+}
+
+EffectChainPresetManager::~EffectChainPresetManager() {
+    m_presetCache.save();
+}
+
+EffectChainPresetPointer EffectChainPresetManager::loadPresetFromFile(const QString& filePath) {
+    EffectChainPresetPointer pCachedPreset(new EffectChainPreset());
+    if (m_presetCache.readValue(filePath, pCachedPreset.data())) {
+        return pCachedPreset;
+    }
 
-EffectChainPresetPointer loadPresetFromFile(const QString& filePath) {
     QFile file(filePath);
     if (!file.open(QIODevice::ReadOnly)) {
         qWarning() << "Could not open chain preset file" << filePath;
@@ -32,17 +54,10 @@ EffectChainPresetPointer loadPresetFromFile(const QString& filePath) {
     EffectChainPresetPointer pEffectChainPreset(
             new EffectChainPreset(doc.documentElement()));
     file.close();
+    m_presetCache.insertValue(filePath, *pEffectChainPreset);
     return pEffectChainPreset;
 }
 
-} // anonymous namespace
-
-EffectChainPresetManager::EffectChainPresetManager(UserSettingsPointer pConfig,
-        EffectsBackendManagerPointer pBackendManager)
-        : m_pConfig(pConfig),
-          m_pBackendManager(pBackendManager) {
-}
-
 int EffectChainPresetManager::presetIndex(const QString& presetName) const {
     if (m_effectChainPresets.contains(presetName)) {
         EffectChainPresetPointer pPreset =
@@ -536,6 +551,7 @@ void EffectChainPresetManager::resetToDefaults() {
     importDefaultPresets();
     generateDefaultQuickEffectPresets();
     prependRemainingPresetsToLists();
+    m_presetCache.save();
 
     emit effectChainPresetListUpdated();
     emit quickEffectChainPresetListUpdated();
@@ -550,8 +566,9 @@ bool EffectChainPresetManager::savePresetXml(EffectChainPresetPointer pPreset) {
     // The file name does not matter as long as it is unique. The actual name string
     // is safely stored in the UTF8 document, regardless of what the filesystem
     // supports for file names.
-    QFile file(path + kFolderDelimiter +
-            mixxx::filename::sanitize(pPreset->name()) + kXmlFileExtension);
+    const QString filePath = path + kFolderDelimiter +
+            mixxx::filename::sanitize(pPreset->name()) + kXmlFileExtension;
+    QFile file(filePath);
     if (!file.open(QIODevice::Truncate | QIODevice::WriteOnly)) {
         QMessageBox msgBox;
         msgBox.setText(tr("Error saving effect chain preset"));
@@ -573,6 +590,9 @@ bool EffectChainPresetManager::savePresetXml(EffectChainPresetPointer pPreset) {
         qWarning() << "Could not write effect chain preset XML to" << file.fileName();
     }
     file.close();
+    if (success) {
+        m_presetCache.insertValue(filePath, *pPreset);
+    }
     return success;
 }
 
@@ -667,6 +687,7 @@ EffectsXmlData EffectChainPresetManager::readEffectsXml(
     }
 
     prependRemainingPresetsToLists();
+    m_presetCache.save();
 
     emit effectChainPresetListUpdated();
     emit quickEffectChainPresetListUpdated();
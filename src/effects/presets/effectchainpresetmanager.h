@@ -6,6 +6,7 @@
 #include "effects/backends/effectsbackendmanager.h"
 #include "effects/presets/effectchainpreset.h"
 #include "preferences/usersettings.h"
+#include "util/parsedfilecache.h"
 
 class EffectsManager;
 
@@ -18,6 +19,8 @@ struct EffectsXmlData {
 /// "effects/chains" folder in the user settings folder. The state of loaded
 /// effects are saved as EffectChainPresets in the effects.xml file in the user
 /// settings folder, which is used to restore the state of effects on startup.
+/// The parsed chain presets are cached in a binary file next to the
+/// "effects/chains" folder to avoid parsing the XML files on every startup.
 class EffectChainPresetManager : public QObject {
     Q_OBJECT
 
@@ -25,7 +28,7 @@ class EffectChainPresetManager : public QObject {
     EffectChainPresetManager(
             UserSettingsPointer pConfig,
             EffectsBackendManagerPointer pBackendManager);
-    ~EffectChainPresetManager() = default;
+    ~EffectChainPresetManager() override;
 
     const QList<EffectChainPresetPointer> getPresetsSorted() const {
         return m_effectChainPresetsSorted;
@@ -78,6 +81,7 @@ class EffectChainPresetManager : public QObject {
     void quickEffectChainPresetListUpdated();
 
   private:
+    EffectChainPresetPointer loadPresetFromFile(const QString& filePath);
     bool savePresetXml(EffectChainPresetPointer pPreset);
 
     void importUserPresets();
@@ -92,6 +96,7 @@ class EffectChainPresetManager : public QObject {
 
     UserSettingsPointer m_pConfig;
     EffectsBackendManagerPointer m_pBackendManager;
+    mixxx::ParsedFileCache m_presetCache;
 };
 
 typedef QSharedPointer<EffectChainPresetManager> EffectChainPresetManagerPointer;
@@ -81,3 +81,20 @@ const QDomElement EffectParameterPreset::toXml(QDomDocument* doc) const {
 
 EffectParameterPreset::~EffectParameterPreset() {
 }
+
+QDataStream& operator<<(QDataStream& stream, const EffectParameterPreset& preset) {
+    return stream << preset.m_dValue
+                  << preset.m_id
+                  << static_cast<qint32>(preset.m_linkType)
+                  << static_cast<qint32>(preset.m_linkInversion)
+                  << preset.m_bHidden;
+}
+
+QDataStream& operator>>(QDataStream& stream, EffectParameterPreset& preset) {
+    qint32 linkType = 0;
+    qint32 linkInversion = 0;
+    stream >> preset.m_dValue >> preset.m_id >> linkType >> linkInversion >> preset.m_bHidden;
+    preset.m_linkType = static_cast<EffectManifestParameter::LinkType>(linkType);
+    preset.m_linkInversion = static_cast<EffectManifestParameter::LinkInversion>(linkInversion);
+    return stream;
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QDataStream>
 #include <QDomElement>
 
 #include "effects/backends/effectmanifestparameter.h"
@@ -40,6 +41,10 @@ class EffectParameterPreset {
         return m_bHidden;
     }
 
+    /// Binary serialization for the preset cache
+    friend QDataStream& operator<<(QDataStream& stream, const EffectParameterPreset& preset);
+    friend QDataStream& operator>>(QDataStream& stream, EffectParameterPreset& preset);
+
   private:
     double m_dValue;
     QString m_id;
@@ -101,3 +101,18 @@ const QDomElement EffectPreset::toXml(QDomDocument* doc) const {
 
 EffectPreset::~EffectPreset() {
 }
+
+QDataStream& operator<<(QDataStream& stream, const EffectPreset& preset) {
+    return stream << preset.m_id
+                  << static_cast<qint32>(preset.m_backendType)
+                  << preset.m_dMetaParameter
+                  << preset.m_effectParameterPresets;
+}
+
+QDataStream& operator>>(QDataStream& stream, EffectPreset& preset) {
+    qint32 backendType = 0;
+    stream >> preset.m_id >> backendType >> preset.m_dMetaParameter >>
+            preset.m_effectParameterPresets;
+    preset.m_backendType = static_cast<EffectBackendType>(backendType);
+    return stream;
+}
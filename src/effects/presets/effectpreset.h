@@ -1,4 +1,5 @@
 #pragma once
+#include <QDataStream>
 #include <QDomElement>
 
 #include "effects/backends/effectmanifest.h"
@@ -39,6 +40,10 @@ class EffectPreset {
         return m_effectParameterPresets;
     }
 
+    /// Binary serialization for the preset cache
+    friend QDataStream& operator<<(QDataStream& stream, const EffectPreset& preset);
+    friend QDataStream& operator>>(QDataStream& stream, EffectPreset& preset);
+
   private:
     QString m_id;
     EffectBackendType m_backendType;
@@ -8,19 +8,26 @@
 
 namespace {
 const QString kEffectDefaultsDirectory = "/effects/defaults";
-}
+const QString kEffectDefaultsCacheFile = "/effects/defaults.cache";
+// Increase when the binary serialization of EffectPreset changes
+constexpr quint32 kEffectDefaultsCacheVersion = 1;
+} // anonymous namespace
 
 EffectPresetManager::EffectPresetManager(UserSettingsPointer pConfig,
         EffectsBackendManagerPointer pBackendManager)
         : m_pConfig(pConfig),
-          m_pBackendManager(pBackendManager) {
+          m_pBackendManager(pBackendManager),
+          m_presetCache(pConfig->getSettingsPath() + kEffectDefaultsCacheFile,
+                  kEffectDefaultsCacheVersion) {
     loadDefaultEffectPresets();
+    m_presetCache.save();
 }
 
 EffectPresetManager::~EffectPresetManager() {
     for (const auto& pEffectPreset : std::as_const(m_defaultPresets)) {
         saveDefaultForEffect(pEffectPreset);
     }
+    m_presetCache.save();
 }
 
 void EffectPresetManager::loadDefaultEffectPresets() {
@@ -29,17 +36,21 @@ void EffectPresetManager::loadDefaultEffectPresets() {
     QDir effectsDefaultsDir(dirPath);
     effectsDefaultsDir.setFilter(QDir::Files | QDir::Readable);
     const auto& fileNames = effectsDefaultsDir.entryList();
-    for (const auto& filePath : fileNames) {
-        QFile file(dirPath + "/" + filePath);
-        if (!file.open(QIODevice::ReadOnly)) {
-            continue;
-        }
-        QDomDocument doc;
-        if (!doc.setContent(&file)) {
-            file.close();
-            continue;
+    for (const auto& fileName : fileNames) {
+        const QString filePath = dirPath + "/" + fileName;
+        EffectPresetPointer pEffectPreset(new EffectPreset());
+        if (!m_presetCache.readValue(filePath, pEffectPreset.data())) {
+            QFile file(filePath);
+            if (!file.open(QIODevice::ReadOnly)) {
+                continue;
+            }
+            QDomDocument doc;
+            if (!doc.setContent(&file)) {
+                continue;
+            }
+            pEffectPreset = EffectPresetPointer(new EffectPreset(doc.documentElement()));
+            m_presetCache.insertValue(filePath, *pEffectPreset);
         }
-        EffectPresetPointer pEffectPreset(new EffectPreset(doc.documentElement()));
         if (!pEffectPreset->isEmpty()) {
             EffectManifestPointer pManifest = m_pBackendManager->getManifest(
                     pEffectPreset->id(), pEffectPreset->backendType());
@@ -47,7 +58,6 @@ void EffectPresetManager::loadDefaultEffectPresets() {
                 m_defaultPresets.insert(pManifest, pEffectPreset);
             }
         }
-        file.close();
     }
 
     // If no preset was found, generate one from the manifest
@@ -89,10 +99,13 @@ void EffectPresetManager::saveDefaultForEffect(EffectPresetPointer pEffectPreset
     // The file name does not matter as long as it is unique. The actual id string
     // is safely stored in the UTF8 document, regardless of what the filesystem
     // supports for file names.
-    QFile file(path + "/" + mixxx::filename::sanitize(pEffectPreset->id()) + ".xml");
+    const QString filePath =
+            path + "/" + mixxx::filename::sanitize(pEffectPreset->id()) + ".xml";
+    QFile file(filePath);
     if (!file.open(QIODevice::Truncate | QIODevice::WriteOnly)) {
         return;
     }
     file.write(doc.toString().toUtf8());
     file.close();
+    m_presetCache.insertValue(filePath, *pEffectPreset);
 }
@@ -2,9 +2,12 @@
 
 #include "effects/presets/effectpreset.h"
 #include "preferences/usersettings.h"
+#include "util/parsedfilecache.h"
 
 /// EffectPresetManager loads and saves default EffectPresets for each type of
 /// effect in the "effects/defaults" folder of the user settings folder.
+/// The parsed presets are cached in a binary file next to that folder to
+/// avoid parsing the XML files on every startup.
 class EffectPresetManager {
   public:
     EffectPresetManager(UserSettingsPointer pConfig, EffectsBackendManagerPointer pBackendManager);
@@ -24,4 +27,5 @@ class EffectPresetManager {
 
     UserSettingsPointer m_pConfig;
     EffectsBackendManagerPointer m_pBackendManager;
+    mixxx::ParsedFileCache m_presetCache;
 };
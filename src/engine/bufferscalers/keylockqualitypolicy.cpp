@@ -0,0 +1,51 @@
+#include "engine/bufferscalers/keylockqualitypolicy.h"
+
+#include "util/math.h"
+
+void KeylockQualityPolicy::setMaxTier(int maxTier) {
+    m_maxTier = math_max(maxTier, 0);
+    m_tier = m_maxTier;
+    m_framesSinceChange = 0;
+    m_framesOfLowLoad = 0;
+}
+
+bool KeylockQualityPolicy::update(double callbackLoad,
+        CSAMPLE_GAIN mainMixGain,
+        SINT frames,
+        mixxx::audio::SampleRate sampleRate) {
+    if (!sampleRate.isValid()) {
+        return false;
+    }
+    m_framesSinceChange += frames;
+
+    // On-air decks tolerate more load before they give up quality
+    const double gain = math_clamp(static_cast<double>(mainMixGain), 0.0, 1.0);
+    const double stepDownLoad = kStepDownLoadSilent +
+            gain * (kStepDownLoadOnAir - kStepDownLoadSilent);
+    const double stepUpLoad = stepDownLoad - kStepUpHysteresis;
+
+    // Stepping up requires a continuously low load
+    if (callbackLoad < stepUpLoad) {
+        m_framesOfLowLoad += frames;
+    } else {
+        m_framesOfLowLoad = 0;
+    }
+
+    int newTier = m_tier;
+    if (callbackLoad > stepDownLoad) {
+        if (m_tier > 0 &&
+                m_framesSinceChange >= kStepDownHoldSeconds * sampleRate.value()) {
+            newTier = m_tier - 1;
+        }
+    } else if (m_tier < m_maxTier &&
+            m_framesOfLowLoad >= kStepUpHoldSeconds * sampleRate.value()) {
+        newTier = m_tier + 1;
+    }
+    if (newTier == m_tier) {
+        return false;
+    }
+    m_tier = newTier;
+    m_framesSinceChange = 0;
+    m_framesOfLowLoad = 0;
+    return true;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "audio/types.h"
+#include "util/types.h"
+
+/// Decides which quality tier of the keylock scaler a single deck uses,
+/// based on the measured load of the audio callback and the gain of the
+/// deck in the main mix.
+///
+/// Tier 0 is the cheapest keylock scaler, the maximum tier is the engine
+/// selected in the preferences. Decks with a low gain in the main mix (e.g.
+/// previewed in the headphones, or faded out by the crossfader) step down
+/// at a lower load than on-air decks, so the audible decks keep their
+/// quality as long as possible.
+/// Stepping down reacts fast to prevent xruns, stepping up only after the
+/// load has been low for a while, to avoid flip-flopping between scalers.
+class KeylockQualityPolicy {
+  public:
+    // The callback load is the fraction of the buffer period spent in the
+    // audio callback, as reported by [Master],audio_latency_usage.
+    static constexpr double kStepDownLoadSilent = 0.5;
+    static constexpr double kStepDownLoadOnAir = 0.85;
+    static constexpr double kStepUpHysteresis = 0.25;
+    static constexpr double kStepDownHoldSeconds = 0.5;
+    static constexpr double kStepUpHoldSeconds = 3.0;
+
+    KeylockQualityPolicy()
+            : m_maxTier(0),
+              m_tier(0),
+              m_framesSinceChange(0),
+              m_framesOfLowLoad(0) {
+    }
+
+    /// Sets the most expensive tier and resets to it
+    void setMaxTier(int maxTier);
+
+    int maxTier() const {
+        return m_maxTier;
+    }
+
+    int tier() const {
+        return m_tier;
+    }
+
+    /// Called once per callback. Returns true if the tier has changed.
+    bool update(double callbackLoad,
+            CSAMPLE_GAIN mainMixGain,
+            SINT frames,
+            mixxx::audio::SampleRate sampleRate);
+
+  private:
+    int m_maxTier;
+    int m_tier;
+    SINT m_framesSinceChange;
+    SINT m_framesOfLowLoad;
+};
@@ -0,0 +1,153 @@
+#include "engine/bufferscalers/scaledloopcache.h"
+
+#include "engine/engine.h"
+#include "util/math.h"
+#include "util/sample.h"
+
+namespace {
+
+constexpr SINT kChannels = mixxx::kEngineChannelCount;
+
+} // anonymous namespace
+
+ScaledLoopCache::ScaledLoopCache(SINT capacityFrames)
+        : m_capacityFrames(capacityFrames),
+          m_pBuffer(SampleUtil::alloc(capacityFrames * kChannels)),
+          m_state(State::Invalid),
+          m_parameters{},
+          m_passFrames(0),
+          m_startPhase(0),
+          m_recordedFrames(0) {
+}
+
+ScaledLoopCache::~ScaledLoopCache() {
+    SampleUtil::free(m_pBuffer);
+}
+
+bool ScaledLoopCache::canCache(const Parameters& parameters) const {
+    if (!parameters.loopStartPosition.isValid() ||
+            !parameters.loopEndPosition.isValid()) {
+        return false;
+    }
+    const double rate = parameters.rate();
+    const mixxx::audio::FrameDiff_t loopLength = parameters.loopLength();
+    if (!(rate > 0) || !(loopLength > 0)) {
+        // Only forward playback is periodic
+        return false;
+    }
+    const double passFrames = loopLength / rate;
+    // The seam must not overlap with the continuation after one pass
+    return passFrames >= 2 * kSeamFrames &&
+            framesToRecord(passFrames) <= m_capacityFrames;
+}
+
+void ScaledLoopCache::invalidate() {
+    m_state = State::Invalid;
+    m_recordedFrames = 0;
+}
+
+double ScaledLoopCache::phaseOf(mixxx::audio::FramePos position) const {
+    const double phase = std::fmod(
+            (position - m_parameters.loopStartPosition) / m_parameters.rate(),
+            m_passFrames);
+    return phase < 0 ? phase + m_passFrames : phase;
+}
+
+void ScaledLoopCache::interpolateFrame(CSAMPLE* pOutput, double offset) const {
+    const SINT index = static_cast<SINT>(offset);
+    const auto fraction = static_cast<CSAMPLE>(offset - index);
+    const CSAMPLE* pFrame = m_pBuffer + index * kChannels;
+    for (SINT channel = 0; channel < kChannels; ++channel) {
+        pOutput[channel] = pFrame[channel] +
+                fraction * (pFrame[kChannels + channel] - pFrame[channel]);
+    }
+}
+
+void ScaledLoopCache::record(const Parameters& parameters,
+        const CSAMPLE* pBuffer,
+        SINT frames,
+        mixxx::audio::FramePos positionBefore,
+        mixxx::audio::FramePos positionAfter) {
+    if (m_state == State::Invalid || m_parameters != parameters) {
+        if (!canCache(parameters)) {
+            invalidate();
+            return;
+        }
+        m_parameters = parameters;
+        m_passFrames = parameters.loopLength() / parameters.rate();
+        m_recordedFrames = 0;
+        m_state = State::WaitingForLoopStart;
+    }
+
+    switch (m_state) {
+    case State::WaitingForLoopStart:
+        // The loop wrapped around during this buffer. The buffer itself
+        // still contains the fade in of the scaler, so start with the next.
+        if (positionAfter < positionBefore) {
+            m_state = State::Recording;
+        }
+        return;
+    case State::Recording:
+        break;
+    default:
+        return;
+    }
+
+    // Consecutive output frames have consecutive loop phases, so the
+    // frames are recorded contiguously, starting at an arbitrary phase.
+    if (m_recordedFrames == 0) {
+        m_startPhase = phaseOf(positionBefore);
+    }
+    const SINT recordFrames = framesToRecord(m_passFrames);
+    const SINT copyFrames = math_min(frames, recordFrames - m_recordedFrames);
+    SampleUtil::copy(m_pBuffer + m_recordedFrames * kChannels,
+            pBuffer,
+            copyFrames * kChannels);
+    m_recordedFrames += copyFrames;
+    if (m_recordedFrames < recordFrames) {
+        return;
+    }
+
+    // Fade from the continuation after one pass into the recorded start
+    // of the pass. The continuation is offset by the fractional part of
+    // the pass length.
+    for (SINT i = 0; i < kSeamFrames; ++i) {
+        CSAMPLE continuation[kChannels];
+        interpolateFrame(continuation, i + m_passFrames);
+        const auto startGain = static_cast<CSAMPLE_GAIN>(i) / kSeamFrames;
+        CSAMPLE* pFrame = m_pBuffer + i * kChannels;
+        for (SINT channel = 0; channel < kChannels; ++channel) {
+            pFrame[channel] = continuation[channel] +
+                    startGain * (pFrame[channel] - continuation[channel]);
+        }
+    }
+    m_state = State::Complete;
+}
+
+mixxx::audio::FramePos ScaledLoopCache::play(CSAMPLE* pOutput,
+        SINT frames,
+        mixxx::audio::FramePos position) const {
+    VERIFY_OR_DEBUG_ASSERT(m_state == State::Complete) {
+        SampleUtil::clear(pOutput, frames * kChannels);
+        return position;
+    }
+
+    double offset = phaseOf(position) - m_startPhase;
+    if (offset < 0) {
+        offset += m_passFrames;
+    }
+    for (SINT i = 0; i < frames; ++i) {
+        interpolateFrame(pOutput + i * kChannels, offset);
+        offset += 1;
+        if (offset >= m_passFrames) {
+            offset -= m_passFrames;
+        }
+    }
+
+    const mixxx::audio::FrameDiff_t loopLength = m_parameters.loopLength();
+    const mixxx::audio::FrameDiff_t offsetInLoop = std::fmod(
+            (position - m_parameters.loopStartPosition) + frames * m_parameters.rate(),
+            loopLength);
+    return m_parameters.loopStartPosition +
+            (offsetInLoop < 0 ? offsetInLoop + loopLength : offsetInLoop);
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cmath>
+
+#include "audio/frame.h"
+#include "util/types.h"
+
+/// Caches the output of a time stretching scaler for one pass of a loop.
+///
+/// With keylock enabled, each pass through a loop runs Rubberband or
+/// SoundTouch over the same audio with the same parameters. Once one pass has
+/// been rendered completely, the output is periodic and the following passes
+/// can be copied from this cache instead.
+///
+/// Cached frames are addressed by the loop phase in output frames, i.e. the
+/// distance of the play position from the loop start divided by the rate.
+/// This keeps the cached audio aligned with the play position reported by
+/// the ReadAheadManager, including the scaler latency.
+///
+/// One pass usually takes a fractional number of output frames, so the
+/// output frames of the following passes fall between the recorded frames.
+/// They are linearly interpolated. The scaler output is also not exactly
+/// periodic, because the time stretching is not aligned to the loop.
+/// A few frames beyond one pass are recorded and crossfaded into the start
+/// of the pass, so the cached pass wraps around without a click.
+///
+/// The recorded pass is only used if the parameters did not change in
+/// between. Any seek must invalidate the cache.
+///
+/// All methods except the constructor must be called from the engine thread
+/// only. The buffer is allocated upfront, to avoid allocations there.
+class ScaledLoopCache {
+  public:
+    /// Output frames recorded beyond one pass, which are crossfaded into
+    /// the start of the pass
+    static constexpr SINT kSeamFrames = 256;
+
+    struct Parameters {
+        double baseRate;
+        double tempoRatio;
+        double pitchRatio;
+        mixxx::audio::FramePos loopStartPosition;
+        mixxx::audio::FramePos loopEndPosition;
+
+        /// Consumed input frames per output frame
+        double rate() const {
+            return baseRate * tempoRatio;
+        }
+        mixxx::audio::FrameDiff_t loopLength() const {
+            return loopEndPosition - loopStartPosition;
+        }
+
+        bool operator==(const Parameters& other) const {
+            return baseRate == other.baseRate &&
+                    tempoRatio == other.tempoRatio &&
+                    pitchRatio == other.pitchRatio &&
+                    loopStartPosition == other.loopStartPosition &&
+                    loopEndPosition == other.loopEndPosition;
+        }
+        bool operator!=(const Parameters& other) const {
+            return !(*this == other);
+        }
+    };
+
+    explicit ScaledLoopCache(SINT capacityFrames);
+    ~ScaledLoopCache();
+
+    /// Returns false if a pass with these parameters can't be cached, e.g.
+    /// because the loop is too long or the playback is not forward.
+    bool canCache(const Parameters& parameters) const;
+
+    /// Returns true if a complete pass with exactly these parameters is cached
+    bool isCompleteFor(const Parameters& parameters) const {
+        return m_state == State::Complete && m_parameters == parameters;
+    }
+
+    void invalidate();
+
+    /// Passes a buffer rendered by the scaler. The positions are the play
+    /// positions before and after rendering the buffer. Recording starts
+    /// when the loop wrapped around for the first time with these parameters,
+    /// to skip the fade in of a just cleared scaler.
+    void record(const Parameters& parameters,
+            const CSAMPLE* pBuffer,
+            SINT frames,
+            mixxx::audio::FramePos positionBefore,
+            mixxx::audio::FramePos positionAfter);
+
+    /// Copies frames from the cache, starting at the given play position.
+    /// Returns the play position after these frames.
+    /// Precondition: isCompleteFor(parameters)
+    mixxx::audio::FramePos play(CSAMPLE* pOutput,
+            SINT frames,
+            mixxx::audio::FramePos position) const;
+
+  private:
+    enum class State {
+        Invalid,
+        WaitingForLoopStart,
+        Recording,
+        Complete,
+    };
+
+    /// Loop phase in output frames [0, m_passFrames)
+    double phaseOf(mixxx::audio::FramePos position) const;
+
+    /// The frames of one pass, the seam and one more frame for interpolation
+    static SINT framesToRecord(double passFrames) {
+        return static_cast<SINT>(std::ceil(passFrames)) + kSeamFrames + 1;
+    }
+
+    /// Linearly interpolates the recorded frames at a fractional offset
+    /// from the first recorded frame
+    void interpolateFrame(CSAMPLE* pOutput, double offset) const;
+
+    const SINT m_capacityFrames;
+    CSAMPLE* const m_pBuffer;
+
+    State m_state;
+    Parameters m_parameters;
+    // Output frames of one pass through the loop, usually fractional
+    double m_passFrames;
+    // Loop phase of the first recorded frame
+    double m_startPhase;
+    SINT m_recordedFrames;
+};
@@ -53,6 +53,7 @@ CachingReader::CachingReader(const QString& group,
           // buffer, where new requests replace old requests when full. Those
           // old requests need to be returned immediately to the CachingReader
           // that must take ownership and free them!!!
+          m_urgentChunkReadRequestFIFO(kNumberOfCachedChunksInMemory / 4),
           m_chunkReadRequestFIFO(kNumberOfCachedChunksInMemory / 4),
           // The capacity of the back channel must be equal to the number of
           // allocated chunks, because the worker use writeBlocking(). Otherwise
@@ -62,7 +63,10 @@ CachingReader::CachingReader(const QString& group,
           m_mruCachingReaderChunk(nullptr),
           m_lruCachingReaderChunk(nullptr),
           m_sampleBuffer(CachingReaderChunk::kSamples * kNumberOfCachedChunksInMemory),
-          m_worker(group, &m_chunkReadRequestFIFO, &m_readerStatusUpdateFIFO) {
+          m_worker(group,
+                  &m_urgentChunkReadRequestFIFO,
+                  &m_chunkReadRequestFIFO,
+                  &m_readerStatusUpdateFIFO) {
     m_allocatedCachingReaderChunks.reserve(kNumberOfCachedChunksInMemory);
     // Divide up the allocated raw memory buffer into total_chunks
     // chunks. Initialize each chunk to hold nothing and add it to the free
@@ -549,6 +553,12 @@ void CachingReader::hintAndMaybeWake(const HintVector& hintList) {
             continue;
         }
 
+        const bool urgent = hint.type == Hint::Type::CurrentPosition ||
+                hint.type == Hint::Type::SlipPosition;
+        FIFO<CachingReaderChunkReadRequest>* pRequestFIFO = urgent
+                ? &m_urgentChunkReadRequestFIFO
+                : &m_chunkReadRequestFIFO;
+
         const int firstChunkIndex = CachingReaderChunk::indexForFrame(readableFrameIndexRange.start());
         const int lastChunkIndex = CachingReaderChunk::indexForFrame(readableFrameIndexRange.end() - 1);
         for (int chunkIndex = firstChunkIndex; chunkIndex <= lastChunkIndex; ++chunkIndex) {
@@ -572,7 +582,7 @@ void CachingReader::hintAndMaybeWake(const HintVector& hintList) {
                             << "Requesting read of chunk"
                             << request.chunk;
                 }
-                if (m_chunkReadRequestFIFO.write(&request, 1) != 1) {
+                if (pRequestFIFO->write(&request, 1) != 1) {
                     kLogger.warning()
                             << "Failed to submit read request for chunk"
                             << chunkIndex;
@@ -37,8 +37,7 @@ typedef struct Hint {
     // If a range of frames should be present, use frameCount to indicate that the
     // range (frame, frame + frameCount) should be present in memory.
     SINT frameCount;
-    // Currently unused -- but in the future could be used to prioritize certain
-    // hints over others.
+    // Chunks for SlipPosition and CurrentPosition are read before all others
     Type type;
 
     // for the default frame count in forward direction
@@ -129,6 +128,9 @@ class CachingReader : public QObject {
 
     // Thread-safe FIFOs for communication between the engine callback and
     // reader thread.
+    // Chunks for the play position are requested through their own FIFO,
+    // to be read before the chunks for any other hints.
+    FIFO<CachingReaderChunkReadRequest> m_urgentChunkReadRequestFIFO;
     FIFO<CachingReaderChunkReadRequest> m_chunkReadRequestFIFO;
     FIFO<ReaderStatusUpdate> m_readerStatusUpdateFIFO;
 
@@ -11,6 +11,8 @@
 #include "util/compatibility/qmutex.h"
 #include "util/event.h"
 #include "util/logger.h"
+#include "util/threadrole.h"
+#include "util/timer.h"
 
 namespace {
 
@@ -20,14 +22,38 @@ mixxx::Logger kLogger("CachingReaderWorker");
 
 CachingReaderWorker::CachingReaderWorker(
         const QString& group,
+        FIFO<CachingReaderChunkReadRequest>* pUrgentChunkReadRequestFIFO,
         FIFO<CachingReaderChunkReadRequest>* pChunkReadRequestFIFO,
         FIFO<ReaderStatusUpdate>* pReaderStatusFIFO)
         : m_group(group),
           m_tag(QString("CachingReaderWorker %1").arg(m_group)),
+          m_queueDepthTag(m_tag + QStringLiteral(" queue depth")),
+          m_latencyTag(m_tag + QStringLiteral(" read latency")),
+          m_pUrgentChunkReadRequestFIFO(pUrgentChunkReadRequestFIFO),
           m_pChunkReadRequestFIFO(pChunkReadRequestFIFO),
           m_pReaderStatusFIFO(pReaderStatusFIFO) {
 }
 
+bool CachingReaderWorker::takeNextRequest(CachingReaderChunkReadRequest* pRequest) {
+    // Check the urgent FIFO again after each request. Reading the hinted
+    // chunks takes a while and a seek may need new chunks in the meantime.
+    const int queueDepth = m_pUrgentChunkReadRequestFIFO->readAvailable() +
+            m_pChunkReadRequestFIFO->readAvailable();
+    if (m_pUrgentChunkReadRequestFIFO->read(pRequest, 1) != 1 &&
+            m_pChunkReadRequestFIFO->read(pRequest, 1) != 1) {
+        return false;
+    }
+    Stat::track(m_queueDepthTag,
+            Stat::UNSPECIFIED,
+            Stat::COUNT | Stat::AVERAGE | Stat::MAX,
+            queueDepth);
+    Stat::track(m_latencyTag,
+            Stat::DURATION_NANOSEC,
+            kDefaultComputeFlags,
+            mixxx::Time::elapsed().toIntegerNanos() - pRequest->submittedAtNanos);
+    return true;
+}
+
 ReaderStatusUpdate CachingReaderWorker::processReadRequest(
         const CachingReaderChunkReadRequest& request) {
     CachingReaderChunk* pChunk = request.chunk;
@@ -89,6 +115,7 @@ void CachingReaderWorker::run() {
     const auto id = lastId.fetchAndAddRelaxed(1) + 1;
     QThread::currentThread()->setObjectName(
             QStringLiteral("CachingReaderWorker ") + QString::number(id));
+    const mixxx::ScopedThreadRole threadRole(mixxx::ThreadRole::CachingReader);
 
     Event::start(m_tag);
     while (!m_stop.loadAcquire()) {
@@ -109,7 +136,7 @@ void CachingReaderWorker::run() {
                 // here, the engine is already stopped
                 unloadTrack();
             }
-        } else if (m_pChunkReadRequestFIFO->read(&request, 1) == 1) {
+        } else if (takeNextRequest(&request)) {
             // Read the requested chunk and send the result
             const ReaderStatusUpdate update(processReadRequest(request));
             m_pReaderStatusFIFO->writeBlocking(&update, 1);
@@ -123,7 +150,8 @@ void CachingReaderWorker::run() {
 
 void CachingReaderWorker::discardAllPendingRequests() {
     CachingReaderChunkReadRequest request;
-    while (m_pChunkReadRequestFIFO->read(&request, 1) == 1) {
+    while (m_pUrgentChunkReadRequestFIFO->read(&request, 1) == 1 ||
+            m_pChunkReadRequestFIFO->read(&request, 1) == 1) {
         const auto update = ReaderStatusUpdate::readDiscarded(request.chunk);
         m_pReaderStatusFIFO->writeBlocking(&update, 1);
     }
@@ -140,6 +168,7 @@ void CachingReaderWorker::closeAudioSource() {
 
     // This function has to be called with the engine stopped only
     // to avoid collecting new requests for the old track
+    DEBUG_ASSERT(!m_pUrgentChunkReadRequestFIFO->readAvailable());
     DEBUG_ASSERT(!m_pChunkReadRequestFIFO->readAvailable());
 }
 
@@ -223,6 +252,7 @@ void CachingReaderWorker::loadTrack(const TrackPointer& pTrack) {
 
     // The engine must not request any chunks before receiving the
     // trackLoaded() signal
+    DEBUG_ASSERT(!m_pUrgentChunkReadRequestFIFO->readAvailable());
     DEBUG_ASSERT(!m_pChunkReadRequestFIFO->readAvailable());
 
     emit trackLoaded(
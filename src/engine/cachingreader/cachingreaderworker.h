@@ -11,14 +11,18 @@
 #include "sources/audiosource.h"
 #include "track/track_decl.h"
 #include "util/fifo.h"
+#include "util/time.h"
 
 // POD with trivial ctor/dtor/copy for passing through FIFO
 typedef struct CachingReaderChunkReadRequest {
     CachingReaderChunk* chunk;
+    // For measuring the service latency of the worker
+    qint64 submittedAtNanos;
 
     void giveToWorker(CachingReaderChunkForOwner* chunkForOwner) {
         DEBUG_ASSERT(chunkForOwner);
         chunk = chunkForOwner;
+        submittedAtNanos = mixxx::Time::elapsed().toIntegerNanos();
         chunkForOwner->giveToWorker();
     }
 } CachingReaderChunkReadRequest;
@@ -95,8 +99,10 @@ class CachingReaderWorker : public EngineWorker {
     Q_OBJECT
 
   public:
-    // Construct a CachingReader with the given group.
+    // Construct a CachingReader with the given group. Requests from the
+    // urgent FIFO are always served before those from the hint FIFO.
     CachingReaderWorker(const QString& group,
+            FIFO<CachingReaderChunkReadRequest>* pUrgentChunkReadRequestFIFO,
             FIFO<CachingReaderChunkReadRequest>* pChunkReadRequestFIFO,
             FIFO<ReaderStatusUpdate>* pReaderStatusFIFO);
     ~CachingReaderWorker() override = default;
@@ -119,9 +125,12 @@ class CachingReaderWorker : public EngineWorker {
   private:
     const QString m_group;
     QString m_tag;
+    const QString m_queueDepthTag;
+    const QString m_latencyTag;
 
     // Thread-safe FIFOs for communication between the engine callback and
     // reader thread.
+    FIFO<CachingReaderChunkReadRequest>* m_pUrgentChunkReadRequestFIFO;
     FIFO<CachingReaderChunkReadRequest>* m_pChunkReadRequestFIFO;
     FIFO<ReaderStatusUpdate>* m_pReaderStatusFIFO;
 
@@ -131,6 +140,8 @@ class CachingReaderWorker : public EngineWorker {
     QAtomicInt m_newTrackAvailable;
     TrackPointer m_pNewTrack;
 
+    // Takes the next request, urgent requests first
+    bool takeNextRequest(CachingReaderChunkReadRequest* pRequest);
     void discardAllPendingRequests();
 
     /// call to be prepare for new tracks
@@ -186,7 +186,7 @@ class ChannelHandleMap {
     }
 
     const T& at(const ChannelHandle& handle) const {
-        if (!handle.valid()) {
+        if (!handle.valid() || handle.handle() >= m_data.size()) {
             return m_dummy;
         }
         return m_data.at(handle);
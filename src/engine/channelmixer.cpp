@@ -1,8 +1,100 @@
 #include "engine/channelmixer.h"
 
+#include <algorithm>
+
 #include "util/sample.h"
 #include "util/timer.h"
 
+namespace {
+
+// The channels are mixed in blocks of this many samples, so the block of the
+// output buffer stays in the L1 cache while the channels are added to it.
+constexpr unsigned int kMixBlockSamples = 512;
+
+// Mixes the samples [start, end) of one channel into pOutput. With
+// kApplyInPlace the gain is also applied to the channel buffer.
+// This file is compiled with -ffp-contract=off like util/sample.cpp, so
+// the results are the same as those of SampleUtil on all architectures.
+template<bool kApplyInPlace>
+inline void mixChannelBlock(CSAMPLE* pOutput,
+        const ChannelMixer::ChannelGain& channel,
+        unsigned int start,
+        unsigned int end) {
+    CSAMPLE* pBuffer = channel.m_pBuffer;
+    const RampingGain& gain = channel.m_gain;
+    if (gain.isOne()) {
+        // note: LOOP VECTORIZED.
+        for (unsigned int i = start; i < end; ++i) {
+            pOutput[i] += pBuffer[i];
+        }
+    } else if (gain.isZero()) {
+        for (unsigned int i = start; i < end; ++i) {
+            if (kApplyInPlace) {
+                pBuffer[i] = CSAMPLE_ZERO;
+            }
+            pOutput[i] += CSAMPLE_ZERO;
+        }
+    } else if (gain.isRamping()) {
+        // note: LOOP VECTORIZED only with "int i"
+        for (int i = static_cast<int>(start / 2); i < static_cast<int>(end / 2); ++i) {
+            const CSAMPLE_GAIN frameGain = gain.at(i);
+            const CSAMPLE left = pBuffer[i * 2] * frameGain;
+            const CSAMPLE right = pBuffer[i * 2 + 1] * frameGain;
+            if (kApplyInPlace) {
+                pBuffer[i * 2] = left;
+                pBuffer[i * 2 + 1] = right;
+            }
+            pOutput[i * 2] += left;
+            pOutput[i * 2 + 1] += right;
+        }
+    } else {
+        const CSAMPLE_GAIN constantGain = gain.at(0);
+        // note: LOOP VECTORIZED.
+        for (unsigned int i = start; i < end; ++i) {
+            const CSAMPLE sample = pBuffer[i] * constantGain;
+            if (kApplyInPlace) {
+                pBuffer[i] = sample;
+            }
+            pOutput[i] += sample;
+        }
+    }
+}
+
+template<bool kApplyInPlace>
+void mixChannelBlocks(CSAMPLE* pOutput,
+        const ChannelMixer::ChannelGain* pChannels,
+        int numChannels,
+        unsigned int iBufferSize) {
+    // The channels are added in the given order to each sample, like when
+    // mixing one channel after the other into the whole buffer.
+    for (unsigned int start = 0; start < iBufferSize; start += kMixBlockSamples) {
+        const unsigned int end = std::min(start + kMixBlockSamples, iBufferSize);
+        for (int i = 0; i < numChannels; ++i) {
+            mixChannelBlock<kApplyInPlace>(pOutput, pChannels[i], start, end);
+        }
+    }
+}
+
+} // namespace
+
+// static
+void ChannelMixer::mixChannelsWithRampingGains(
+        CSAMPLE* pOutput,
+        const ChannelGain* pChannels,
+        int numChannels,
+        unsigned int iBufferSize) {
+    mixChannelBlocks<false>(pOutput, pChannels, numChannels, iBufferSize);
+}
+
+// static
+void ChannelMixer::applyRampingGainsAndMixChannels(
+        CSAMPLE* pOutput,
+        const ChannelGain* pChannels,
+        int numChannels,
+        unsigned int iBufferSize) {
+    mixChannelBlocks<true>(pOutput, pChannels, numChannels, iBufferSize);
+}
+
 // static
 void ChannelMixer::applyEffectsAndMixChannels(const EngineMaster::GainCalculator& gainCalculator,
         const QVarLengthArray<EngineMaster::ChannelInfo*, kPreallocatedChannels>& activeChannels,
@@ -21,8 +113,11 @@ void ChannelMixer::applyEffectsAndMixChannels(const EngineMaster::GainCalculator
     //     C) Processes effects on the temporary buffer
     //     D) Mixes the temporary buffer into pOutput
     // The original channel input buffers are not modified.
+    // Consecutive channels without postfader effects skip the temporary
+    // buffer, they are mixed together with their gains in a single pass.
     SampleUtil::clear(pOutput, iBufferSize);
     ScopedTimer t("EngineMaster::applyEffectsAndMixChannels");
+    QVarLengthArray<ChannelGain, kPreallocatedChannels> pendingChannels;
     for (auto* pChannelInfo : activeChannels) {
         EngineMaster::GainCache& gainCache = (*channelGainCache)[pChannelInfo->m_index];
         CSAMPLE_GAIN oldGain = gainCache.m_gain;
@@ -37,6 +132,29 @@ void ChannelMixer::applyEffectsAndMixChannels(const EngineMaster::GainCalculator
             newGain = gainCalculator.getGain(pChannelInfo);
         }
         gainCache.m_gain = newGain;
+        if (!pEngineEffectsManager->isPostFaderProcessingRequired(
+                    pChannelInfo->m_handle, outputHandle)) {
+            // Let the effect chains update their state for the channel,
+            // they leave the buffer untouched.
+            pEngineEffectsManager->processPostFaderInPlace(pChannelInfo->m_handle,
+                    outputHandle,
+                    pChannelInfo->m_pBuffer,
+                    iBufferSize,
+                    iSampleRate,
+                    pChannelInfo->m_features,
+                    CSAMPLE_GAIN_ONE,
+                    CSAMPLE_GAIN_ONE,
+                    fadeout);
+            pendingChannels.append(ChannelGain{pChannelInfo->m_pBuffer,
+                    RampingGain(oldGain, newGain, iBufferSize)});
+            continue;
+        }
+        // Keep the order of the channels in the mix
+        mixChannelsWithRampingGains(pOutput,
+                pendingChannels.constData(),
+                pendingChannels.size(),
+                iBufferSize);
+        pendingChannels.clear();
         pEngineEffectsManager->processPostFaderAndMix(pChannelInfo->m_handle,
                 outputHandle,
                 pChannelInfo->m_pBuffer,
@@ -48,6 +166,10 @@ void ChannelMixer::applyEffectsAndMixChannels(const EngineMaster::GainCalculator
                 newGain,
                 fadeout);
     }
+    mixChannelsWithRampingGains(pOutput,
+            pendingChannels.constData(),
+            pendingChannels.size(),
+            iBufferSize);
 }
 
 void ChannelMixer::applyEffectsInPlaceAndMixChannels(
@@ -67,8 +189,11 @@ void ChannelMixer::applyEffectsInPlaceAndMixChannels(
     //    A) Applies the calculated gain to the channel buffer, modifying the original input buffer
     //    B) Applies effects to the buffer, modifying the original input buffer
     // 4. Mix the channel buffers together to make pOutput, overwriting the pOutput buffer from the last engine callback
+    // Consecutive channels without postfader effects get their gain applied
+    // while they are mixed together in a single pass.
     ScopedTimer t("EngineMaster::applyEffectsInPlaceAndMixChannels");
     SampleUtil::clear(pOutput, iBufferSize);
+    QVarLengthArray<ChannelGain, kPreallocatedChannels> pendingChannels;
     for (auto* pChannelInfo : activeChannels) {
         EngineMaster::GainCache& gainCache = (*channelGainCache)[pChannelInfo->m_index];
         CSAMPLE_GAIN oldGain = gainCache.m_gain;
@@ -83,6 +208,29 @@ void ChannelMixer::applyEffectsInPlaceAndMixChannels(
             newGain = gainCalculator.getGain(pChannelInfo);
         }
         gainCache.m_gain = newGain;
+        if (!pEngineEffectsManager->isPostFaderProcessingRequired(
+                    pChannelInfo->m_handle, outputHandle)) {
+            // Let the effect chains update their state for the channel,
+            // they leave the buffer untouched.
+            pEngineEffectsManager->processPostFaderInPlace(pChannelInfo->m_handle,
+                    outputHandle,
+                    pChannelInfo->m_pBuffer,
+                    iBufferSize,
+                    iSampleRate,
+                    pChannelInfo->m_features,
+                    CSAMPLE_GAIN_ONE,
+                    CSAMPLE_GAIN_ONE,
+                    fadeout);
+            pendingChannels.append(ChannelGain{pChannelInfo->m_pBuffer,
+                    RampingGain(oldGain, newGain, iBufferSize)});
+            continue;
+        }
+        // Keep the order of the channels in the mix
+        applyRampingGainsAndMixChannels(pOutput,
+                pendingChannels.constData(),
+                pendingChannels.size(),
+                iBufferSize);
+        pendingChannels.clear();
         pEngineEffectsManager->processPostFaderInPlace(pChannelInfo->m_handle,
                 outputHandle,
                 pChannelInfo->m_pBuffer,
@@ -94,4 +242,8 @@ void ChannelMixer::applyEffectsInPlaceAndMixChannels(
                 fadeout);
         SampleUtil::add(pOutput, pChannelInfo->m_pBuffer, iBufferSize);
     }
+    applyRampingGainsAndMixChannels(pOutput,
+            pendingChannels.constData(),
+            pendingChannels.size(),
+            iBufferSize);
 }
@@ -5,9 +5,35 @@
 #include "util/types.h"
 #include "engine/enginemaster.h"
 #include "effects/engineeffectsmanager.h"
+#include "util/rampinggain.h"
 
 class ChannelMixer {
   public:
+    /// A channel buffer with the gain to apply to it while mixing
+    struct ChannelGain {
+        CSAMPLE* m_pBuffer;
+        RampingGain m_gain;
+    };
+
+    // Mixes the channel buffers multiplied by their gains into pOutput in a
+    // single pass, without modifying the channel buffers. The result is the
+    // same as from SampleUtil::copyWithRampingGain() into a temporary buffer
+    // followed by SampleUtil::add() for one channel after the other.
+    static void mixChannelsWithRampingGains(
+            CSAMPLE* pOutput,
+            const ChannelGain* pChannels,
+            int numChannels,
+            unsigned int iBufferSize);
+    // Applies the gains to the channel buffers and mixes them into pOutput
+    // in a single pass. The result is the same as from
+    // SampleUtil::applyRampingGain() followed by SampleUtil::add() for one
+    // channel after the other.
+    static void applyRampingGainsAndMixChannels(
+            CSAMPLE* pOutput,
+            const ChannelGain* pChannels,
+            int numChannels,
+            unsigned int iBufferSize);
+
     // This does not modify the input channel buffers. All manipulation of the input
     // channel buffers is done after copying to a temporary buffer, then they are mixed
     // to make the output buffer.
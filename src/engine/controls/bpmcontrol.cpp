@@ -351,11 +351,12 @@ double BpmControl::calcSyncedRate(double userTweak) {
     }
 
     // Now we have all we need to calculate the sync adjustment if any.
-    double adjustment = calcSyncAdjustment(userTweak != 0.0);
+    double adjustment = calcSyncAdjustment(userTweak != 0.0, beatLengthFrames);
     return (rate + userTweak) * adjustment;
 }
 
-double BpmControl::calcSyncAdjustment(bool userTweakingSync) {
+double BpmControl::calcSyncAdjustment(bool userTweakingSync,
+        mixxx::audio::FrameDiff_t beatLengthFrames) {
     int resetSyncAdjustment = m_resetSyncAdjustment.fetchAndStoreRelaxed(0);
     if (resetSyncAdjustment) {
         m_dLastSyncAdjustment = 1.0;
@@ -396,6 +397,8 @@ double BpmControl::calcSyncAdjustment(bool userTweakingSync) {
         // off, but then it gets turned on.
         constexpr double kTrainWreckThreshold = 0.2;
         constexpr double kSyncAdjustmentCap = 0.05;
+        // Offset below which the decks are considered to be in phase.
+        constexpr double kSyncPhaseTrimMinErrorFrames = 0.5;
         if (fabs(error) > kTrainWreckThreshold) {
             // Assume poor reflexes (late button push) -- speed up to catch the other track.
             adjustment = 1.0 + kSyncAdjustmentCap;
@@ -415,6 +418,21 @@ double BpmControl::calcSyncAdjustment(bool userTweakingSync) {
             adjustment = 1.0 + math_clamp(
                     m_dLastSyncAdjustment - 1.0 + delta,
                     -kSyncAdjustmentCap, kSyncAdjustmentCap);
+        } else if (fabs(error) * beatLengthFrames > kSyncPhaseTrimMinErrorFrames &&
+                m_dSyncInstantaneousBpm > 0.0) {
+            // The offset is too small to be heard as a flam, but it would
+            // otherwise never be corrected and sums up with every rate change
+            // that does not reach all decks in the same callback. Trim it with
+            // a time constant in seconds, so the correction per second does
+            // not depend on the buffer size and the decks end up in phase
+            // with sub-frame accuracy.
+            constexpr double kSyncPhaseTrimTimeConstantSeconds = 0.5;
+            const double beatLengthSeconds = 60.0 / m_dSyncInstantaneousBpm;
+            adjustment = 1.0 +
+                    math_clamp(-error * beatLengthSeconds /
+                                    kSyncPhaseTrimTimeConstantSeconds,
+                            -kSyncAdjustmentCap,
+                            kSyncAdjustmentCap);
         } else {
             // We are in sync, no adjustment needed.
             adjustment = 1.0;
@@ -485,14 +503,24 @@ bool BpmControl::getBeatContext(const mixxx::BeatsPointer& pBeats,
         mixxx::audio::FramePos* pPrevBeatPosition,
         mixxx::audio::FramePos* pNextBeatPosition,
         mixxx::audio::FrameDiff_t* pBeatLengthFrames,
-        double* pBeatPercentage) {
+        double* pBeatPercentage,
+        mixxx::Beats::Cursor* pCursor) {
     if (!pBeats) {
         return false;
     }
 
     mixxx::audio::FramePos prevBeatPosition;
     mixxx::audio::FramePos nextBeatPosition;
-    if (!pBeats->findPrevNextBeats(position, &prevBeatPosition, &nextBeatPosition, false)) {
+    bool found;
+    if (pCursor) {
+        pCursor->setBeats(pBeats.get());
+        found = pCursor->findPrevNextBeats(
+                position, &prevBeatPosition, &nextBeatPosition, false);
+    } else {
+        found = pBeats->findPrevNextBeats(
+                position, &prevBeatPosition, &nextBeatPosition, false);
+    }
+    if (!found) {
         return false;
     }
 
@@ -538,11 +566,23 @@ bool BpmControl::getBeatContextNoLookup(
 
 mixxx::audio::FramePos BpmControl::getNearestPositionInPhase(
         mixxx::audio::FramePos thisPosition, bool respectLoops, bool playing) {
+    return getNearestPositionInPhase(thisPosition, respectLoops, playing, nullptr, nullptr);
+}
+
+mixxx::audio::FramePos BpmControl::getNearestPositionInPhase(
+        mixxx::audio::FramePos thisPosition,
+        bool respectLoops,
+        bool playing,
+        mixxx::Beats::Cursor* pCursor,
+        mixxx::Beats::Cursor* pOtherCursor) {
     // Without a beatgrid, we don't know the phase offset.
     const mixxx::BeatsPointer pBeats = m_pBeats;
     if (!pBeats) {
         return thisPosition;
     }
+    if (pCursor) {
+        pCursor->setBeats(pBeats.get());
+    }
 
     SyncMode syncMode = getSyncMode();
 
@@ -568,7 +608,8 @@ mixxx::audio::FramePos BpmControl::getNearestPositionInPhase(
                     &thisPrevBeatPosition,
                     &thisNextBeatPosition,
                     &thisBeatLengthFrames,
-                    nullptr)) {
+                    nullptr,
+                    pCursor)) {
             return thisPosition;
         }
     } else {
@@ -617,7 +658,8 @@ mixxx::audio::FramePos BpmControl::getNearestPositionInPhase(
                     nullptr,
                     nullptr,
                     nullptr,
-                    &otherBeatFraction)) {
+                    &otherBeatFraction,
+                    pOtherCursor)) {
             return thisPosition;
         }
     }
@@ -649,7 +691,9 @@ mixxx::audio::FramePos BpmControl::getNearestPositionInPhase(
     } else if (thisNearNextBeat && !otherNearNextBeat) {
         newPlayPosition = thisNextBeatPosition;
     } else { //!thisNearNextBeat && otherNearNextBeat
-        thisPrevBeatPosition = pBeats->findNthBeat(thisPosition, -2);
+        thisPrevBeatPosition = pCursor
+                ? pCursor->findNthBeat(thisPosition, -2)
+                : pBeats->findNthBeat(thisPosition, -2);
         newPlayPosition = thisPrevBeatPosition;
     }
     newPlayPosition += (otherBeatFraction + m_dUserOffset.getValue()) * thisBeatLengthFrames;
@@ -698,7 +742,8 @@ mixxx::audio::FramePos BpmControl::getNearestPositionInPhase(
         // Move new position after loop jump into phase as well.
         // This is a recursive call, called only twice because of
         // respectLoops = false
-        newPlayPosition = getNearestPositionInPhase(newPlayPosition, false, playing);
+        newPlayPosition = getNearestPositionInPhase(
+                newPlayPosition, false, playing, pCursor, pOtherCursor);
     }
 
     // Note: Syncing to before the loop beginning is allowed, because
@@ -766,7 +811,8 @@ mixxx::audio::FramePos BpmControl::getBeatMatchPosition(
                 &thisPrevBeatPosition,
                 &thisNextBeatPosition,
                 &thisBeatLengthFrames,
-                nullptr);
+                nullptr,
+                &m_beatsCursor);
         // now we either have a useful next beat or there is none
         if (!thisNextBeatPosition.isValid()) {
             // We can't match the next beat, give up.
@@ -819,7 +865,8 @@ mixxx::audio::FramePos BpmControl::getBeatMatchPosition(
                 &otherPrevBeatPosition,
                 &otherNextBeatPosition,
                 &otherBeatLengthFrames,
-                &otherBeatFraction)) {
+                &otherBeatFraction,
+                &m_syncTargetBeatsCursor)) {
         return thisPosition;
     }
 
@@ -903,7 +950,11 @@ mixxx::audio::FramePos BpmControl::getBeatMatchPosition(
         // Move new position after loop jump into phase as well.
         // This is a recursive call, called only twice because of
         // respectLoops = false
-        newPlayPosition = getNearestPositionInPhase(newPlayPosition, false, playing);
+        newPlayPosition = getNearestPositionInPhase(newPlayPosition,
+                false,
+                playing,
+                &m_beatsCursor,
+                &m_syncTargetBeatsCursor);
     }
 
     // Note: Syncing to before the loop beginning is allowed, because
@@ -1013,12 +1064,25 @@ void BpmControl::slotBeatsTranslateMatchAlignment(double v) {
 }
 
 mixxx::Bpm BpmControl::updateLocalBpm() {
+    return updateLocalBpm(nullptr);
+}
+
+mixxx::Bpm BpmControl::updateLocalBpmInCallback() {
+    return updateLocalBpm(&m_beatsCursor);
+}
+
+mixxx::Bpm BpmControl::updateLocalBpm(mixxx::Beats::Cursor* pCursor) {
     mixxx::Bpm prevLocalBpm = mixxx::Bpm(m_pLocalBpm->get());
     mixxx::Bpm localBpm;
     const mixxx::BeatsPointer pBeats = m_pBeats;
     const FrameInfo info = frameInfo();
     if (pBeats) {
-        localBpm = pBeats->getBpmAroundPosition(info.currentPosition, kLocalBpmSpan);
+        if (pCursor) {
+            pCursor->setBeats(pBeats.get());
+            localBpm = pCursor->getBpmAroundPosition(info.currentPosition, kLocalBpmSpan);
+        } else {
+            localBpm = pBeats->getBpmAroundPosition(info.currentPosition, kLocalBpmSpan);
+        }
         if (!localBpm.isValid()) {
             localBpm = pBeats->getBpmInRange(mixxx::audio::kStartFramePos, info.trackEndPosition);
         }
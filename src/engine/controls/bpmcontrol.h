@@ -59,6 +59,9 @@ class BpmControl : public EngineControl {
     void updateInstantaneousBpm(double instantaneousBpm);
     void resetSyncAdjustment();
     mixxx::Bpm updateLocalBpm();
+    /// Same as updateLocalBpm(), but looks up the beats around the play
+    /// position incrementally. Must only be called from the engine thread.
+    mixxx::Bpm updateLocalBpmInCallback();
     /// Updates the beat distance based on the current play position.
     /// This override is called on every engine callback to update the
     /// beatposition based on the new current playposition.
@@ -72,13 +75,16 @@ class BpmControl : public EngineControl {
     // Calculates contextual information about beats: the previous beat, the
     // next beat, the current beat length, and the beat ratio (how far dPosition
     // lies within the current beat). Returns false if a previous or next beat
-    // does not exist. NULL arguments are safe and ignored.
+    // does not exist. NULL arguments are safe and ignored. The beats are looked
+    // up incrementally with pCursor if it is passed, which must only be done
+    // by the owner of the cursor.
     static bool getBeatContext(const mixxx::BeatsPointer& pBeats,
             mixxx::audio::FramePos position,
             mixxx::audio::FramePos* pPrevBeatPosition,
             mixxx::audio::FramePos* pNextBeatPosition,
             mixxx::audio::FrameDiff_t* pBeatLengthFrames,
-            double* pBeatPercentage);
+            double* pBeatPercentage,
+            mixxx::Beats::Cursor* pCursor = nullptr);
 
     // Alternative version that works if the next and previous beat positions
     // are already known.
@@ -117,7 +123,16 @@ class BpmControl : public EngineControl {
     inline bool isSynchronized() const {
         return toSynchronized(getSyncMode());
     }
-    double calcSyncAdjustment(bool userTweakingSync);
+    double calcSyncAdjustment(bool userTweakingSync,
+            mixxx::audio::FrameDiff_t beatLengthFrames);
+    mixxx::Bpm updateLocalBpm(mixxx::Beats::Cursor* pCursor);
+    // The cursors are only passed from the engine thread
+    mixxx::audio::FramePos getNearestPositionInPhase(
+            mixxx::audio::FramePos thisPosition,
+            bool respectLoops,
+            bool playing,
+            mixxx::Beats::Cursor* pCursor,
+            mixxx::Beats::Cursor* pOtherCursor);
     void adjustBeatsBpm(double deltaBpm);
 
     friend class SyncControl;
@@ -175,6 +190,10 @@ class BpmControl : public EngineControl {
 
     // m_pBeats is written from an engine worker thread
     mixxx::BeatsPointer m_pBeats;
+    // used in the engine thread only
+    mixxx::Beats::Cursor m_beatsCursor;
+    // for the beats of the sync target, used in the engine thread only
+    mixxx::Beats::Cursor m_syncTargetBeatsCursor;
 
     FRIEND_TEST(EngineSyncTest, UserTweakPreservedInSeek);
     FRIEND_TEST(EngineSyncTest, FollowerUserTweakPreservedInLeaderChange);
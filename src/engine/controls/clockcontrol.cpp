@@ -80,7 +80,8 @@ void ClockControl::updateIndicators(const double dRate,
         if (!m_prevBeatPosition.isValid() || !m_nextBeatPosition.isValid() ||
                 currentPosition >= m_nextBeatPosition ||
                 currentPosition <= m_prevBeatPosition) {
-            pBeats->findPrevNextBeats(currentPosition,
+            m_beatsCursor.setBeats(pBeats.get());
+            m_beatsCursor.findPrevNextBeats(currentPosition,
                     &m_prevBeatPosition,
                     &m_nextBeatPosition,
                     false); // Precise compare without tolerance needed
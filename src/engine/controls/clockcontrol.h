@@ -59,4 +59,6 @@ class ClockControl: public EngineControl {
 
     // m_pBeats is written from an engine worker thread
     mixxx::BeatsPointer m_pBeats;
+    // used in the engine thread only
+    mixxx::Beats::Cursor m_beatsCursor;
 };
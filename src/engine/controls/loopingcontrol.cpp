@@ -390,9 +390,9 @@ void LoopingControl::process(const double dRate,
     }
 
     if (m_bAdjustingLoopIn) {
-        setLoopInToCurrentPosition();
+        setLoopInToCurrentPosition(&m_beatsCursor);
     } else if (m_bAdjustingLoopOut) {
-        setLoopOutToCurrentPosition();
+        setLoopOutToCurrentPosition(&m_beatsCursor);
     }
 }
 
@@ -637,7 +637,7 @@ void LoopingControl::setLoop(mixxx::audio::FramePos startPosition,
     m_pCOBeatLoopSize->blockSignals(false);
 }
 
-void LoopingControl::setLoopInToCurrentPosition() {
+void LoopingControl::setLoopInToCurrentPosition(mixxx::Beats::Cursor* pCursor) {
     // set loop-in position
     const mixxx::BeatsPointer pBeats = m_pBeats;
     LoopInfo loopInfo = m_loopInfo.getValue();
@@ -676,7 +676,12 @@ void LoopingControl::setLoopInToCurrentPosition() {
     if (loopInfo.endPosition.isValid() &&
             (loopInfo.endPosition - position) < kMinimumAudibleLoopSizeFrames) {
         if (quantizedBeatPosition.isValid() && pBeats) {
-            position = pBeats->findNthBeat(quantizedBeatPosition, -2);
+            if (pCursor) {
+                pCursor->setBeats(pBeats.get());
+                position = pCursor->findNthBeat(quantizedBeatPosition, -2);
+            } else {
+                position = pBeats->findNthBeat(quantizedBeatPosition, -2);
+            }
             if (!position.isValid() ||
                     (loopInfo.endPosition - position) <
                             kMinimumAudibleLoopSizeFrames) {
@@ -767,7 +772,7 @@ void LoopingControl::slotLoopInGoto(double pressed) {
     }
 }
 
-void LoopingControl::setLoopOutToCurrentPosition() {
+void LoopingControl::setLoopOutToCurrentPosition(mixxx::Beats::Cursor* pCursor) {
     mixxx::BeatsPointer pBeats = m_pBeats;
     LoopInfo loopInfo = m_loopInfo.getValue();
     mixxx::audio::FramePos quantizedBeatPosition;
@@ -803,7 +808,12 @@ void LoopingControl::setLoopOutToCurrentPosition() {
     //  use the smallest pre-defined beatloop instead (when possible)
     if ((position - loopInfo.startPosition) < kMinimumAudibleLoopSizeFrames) {
         if (quantizedBeatPosition.isValid() && pBeats) {
-            position = pBeats->findNthBeat(quantizedBeatPosition, 2);
+            if (pCursor) {
+                pCursor->setBeats(pBeats.get());
+                position = pCursor->findNthBeat(quantizedBeatPosition, 2);
+            } else {
+                position = pBeats->findNthBeat(quantizedBeatPosition, 2);
+            }
             if (!position.isValid() ||
                     (position - loopInfo.startPosition) <
                             kMinimumAudibleLoopSizeFrames) {
@@ -1100,6 +1110,20 @@ bool LoopingControl::isLoopingEnabled() {
     return m_bLoopingEnabled;
 }
 
+bool LoopingControl::getActiveLoop(mixxx::audio::FramePos* pStartPosition,
+        mixxx::audio::FramePos* pEndPosition) const {
+    if (!m_bLoopingEnabled || m_bAdjustingLoopIn || m_bAdjustingLoopOut) {
+        return false;
+    }
+    const LoopInfo loopInfo = m_loopInfo.getValue();
+    if (!loopInfo.startPosition.isValid() || !loopInfo.endPosition.isValid()) {
+        return false;
+    }
+    *pStartPosition = loopInfo.startPosition;
+    *pEndPosition = loopInfo.endPosition;
+    return true;
+}
+
 void LoopingControl::trackLoaded(TrackPointer pNewTrack) {
     m_pTrack = pNewTrack;
     mixxx::BeatsPointer pBeats;
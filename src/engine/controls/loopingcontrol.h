@@ -54,6 +54,10 @@ class LoopingControl : public EngineControl {
             bool enabled);
     void setRateControl(RateControl* rateControl);
     bool isLoopingEnabled();
+    // Returns the bounds of the enabled loop, or false if looping is
+    // disabled or the loop is being adjusted.
+    bool getActiveLoop(mixxx::audio::FramePos* pStartPosition,
+            mixxx::audio::FramePos* pEndPosition) const;
 
     void trackLoaded(TrackPointer pNewTrack) override;
     void trackBeatsUpdated(mixxx::BeatsPointer pBeats) override;
@@ -117,8 +121,9 @@ class LoopingControl : public EngineControl {
     };
 
     void setLoopingEnabled(bool enabled);
-    void setLoopInToCurrentPosition();
-    void setLoopOutToCurrentPosition();
+    // The cursor must only be passed from the engine thread
+    void setLoopInToCurrentPosition(mixxx::Beats::Cursor* pCursor = nullptr);
+    void setLoopOutToCurrentPosition(mixxx::Beats::Cursor* pCursor = nullptr);
     void clearActiveBeatLoop();
     void updateBeatLoopingControls();
     bool currentLoopMatchesBeatloopSize(const LoopInfo& loopInfo) const;
@@ -200,6 +205,8 @@ class LoopingControl : public EngineControl {
     // objects below are written from an engine worker thread
     TrackPointer m_pTrack;
     mixxx::BeatsPointer m_pBeats;
+    // used in the engine thread only
+    mixxx::Beats::Cursor m_beatsCursor;
 
     friend class LoopingControlTest;
 };
@@ -79,18 +79,24 @@ void QuantizeControl::playPosChanged(mixxx::audio::FramePos position) {
                     m_pCONextBeat->get());
     if (!prevBeatPosition.isValid() || position < prevBeatPosition ||
             !nextBeatPosition.isValid() || position > nextBeatPosition) {
-        lookupBeatPositions(position);
+        lookupBeatPositions(position, &m_beatsCursor);
     }
     updateClosestBeat(position);
 }
 
-void QuantizeControl::lookupBeatPositions(mixxx::audio::FramePos position) {
+void QuantizeControl::lookupBeatPositions(mixxx::audio::FramePos position,
+        mixxx::Beats::Cursor* pCursor) {
     DEBUG_ASSERT(position.isValid());
     mixxx::BeatsPointer pBeats = m_pBeats;
     if (pBeats) {
         mixxx::audio::FramePos prevBeatPosition;
         mixxx::audio::FramePos nextBeatPosition;
-        pBeats->findPrevNextBeats(position, &prevBeatPosition, &nextBeatPosition, true);
+        if (pCursor) {
+            pCursor->setBeats(pBeats.get());
+            pCursor->findPrevNextBeats(position, &prevBeatPosition, &nextBeatPosition, true);
+        } else {
+            pBeats->findPrevNextBeats(position, &prevBeatPosition, &nextBeatPosition, true);
+        }
         // FIXME: -1.0 is a valid frame position, should we set the COs to NaN?
         m_pCOPrevBeat->set(prevBeatPosition.toEngineSamplePosMaybeInvalid());
         m_pCONextBeat->set(nextBeatPosition.toEngineSamplePosMaybeInvalid());
@@ -23,8 +23,10 @@ class QuantizeControl : public EngineControl {
     void trackBeatsUpdated(mixxx::BeatsPointer pBeats) override;
 
   private:
-    // Update positions of previous and next beats from beatgrid.
-    void lookupBeatPositions(mixxx::audio::FramePos position);
+    // Update positions of previous and next beats from beatgrid. The cursor
+    // must only be passed from the engine thread.
+    void lookupBeatPositions(mixxx::audio::FramePos position,
+            mixxx::Beats::Cursor* pCursor = nullptr);
     // Update position of the closest beat based on existing previous and
     // next beat values.  Usually callers will call lookupBeatPositions first.
     void updateClosestBeat(mixxx::audio::FramePos position);
@@ -37,4 +39,6 @@ class QuantizeControl : public EngineControl {
 
     // m_pBeats is written from an engine worker thread
     mixxx::BeatsPointer m_pBeats;
+    // used in the engine thread only
+    mixxx::Beats::Cursor m_beatsCursor;
 };
@@ -42,6 +42,9 @@ EngineEffect::EngineEffect(EffectManifestPointer pManifest,
             kInitalSampleRate,
             MAX_BUFFER_LEN / mixxx::kEngineChannelCount);
     m_pProcessor->initialize(activeInputChannels, registeredOutputChannels, engineParameters);
+    for (const ChannelHandleAndGroup& inputChannel : activeInputChannels) {
+        m_inputChannelsWithStates.insert(inputChannel.handle());
+    }
     m_effectRampsFromDry = pManifest->effectRampsFromDry();
 }
 
@@ -53,16 +56,23 @@ EngineEffect::~EngineEffect() {
     m_parameters.clear();
 }
 
-void EngineEffect::initalizeInputChannel(ChannelHandle inputChannel) {
-    if (m_pProcessor->hasStatesForInputChannel(inputChannel)) {
+std::unique_ptr<EffectStatesForInputChannel> EngineEffect::createStatesForInputChannel(
+        ChannelHandle inputChannel) {
+    if (m_inputChannelsWithStates.contains(inputChannel)) {
         // already initialized for this input channel
+        return nullptr;
     }
+    m_inputChannelsWithStates.insert(inputChannel);
 
     // At this point the SoundDevice is not set up so we use the kInitalSampleRate.
     const mixxx::EngineParameters engineParameters(
             kInitalSampleRate,
             MAX_BUFFER_LEN / mixxx::kEngineChannelCount);
-    m_pProcessor->initializeInputChannel(inputChannel, engineParameters);
+    return m_pProcessor->createStatesForInputChannel(engineParameters);
+}
+
+bool EngineEffect::releaseStatesForInputChannel(ChannelHandle inputChannel) {
+    return m_inputChannelsWithStates.remove(inputChannel);
 }
 
 bool EngineEffect::processEffectsRequest(EffectsRequest& message,
@@ -109,6 +119,7 @@ bool EngineEffect::processEffectsRequest(EffectsRequest& message,
                 message.SetParameterParameters.iParameter, EngineEffectParameterPointer());
         if (pParameter) {
             pParameter->setValue(message.value);
+            m_pProcessor->parameterChanged(message.SetParameterParameters.iParameter);
             response.success = true;
         } else {
             response.success = false;
@@ -32,8 +32,32 @@ class EngineEffect final : public EffectsRequestHandler {
     /// Called in main thread by EffectSlot
     ~EngineEffect();
 
-    /// Called from the main thread to make sure that the channel already has states
-    void initalizeInputChannel(ChannelHandle inputChannel);
+    /// Called from the main thread when the input channel is routed to the
+    /// chain. Returns the states that need to be installed in the audio
+    /// thread or nullptr if the channel already has states.
+    std::unique_ptr<EffectStatesForInputChannel> createStatesForInputChannel(
+            ChannelHandle inputChannel);
+    /// Called from the main thread when the input channel is unrouted from
+    /// the chain. Returns false if the channel has no states that need to
+    /// be removed in the audio thread.
+    bool releaseStatesForInputChannel(ChannelHandle inputChannel);
+    /// Called from the main thread with states that have been removed
+    /// in the audio thread
+    void recycleStatesForInputChannel(
+            std::unique_ptr<EffectStatesForInputChannel> pStates) {
+        m_pProcessor->recycleStatesForInputChannel(std::move(pStates));
+    }
+    /// Called from the main thread
+    EffectStatesMemoryReport memoryReport() const {
+        return m_pProcessor->memoryReport();
+    }
+
+    /// Called in audio thread
+    void swapStatesForInputChannel(
+            ChannelHandle inputChannel,
+            EffectStatesForInputChannel* pStates) {
+        m_pProcessor->swapStatesForInputChannel(inputChannel, pStates);
+    }
 
     /// Called in audio thread
     bool processEffectsRequest(
@@ -74,6 +98,8 @@ class EngineEffect final : public EffectsRequestHandler {
     // Must not be modified after construction.
     QVector<EngineEffectParameterPointer> m_parameters;
     QMap<QString, EngineEffectParameterPointer> m_parametersById;
+    // Only accessed by the main thread
+    QSet<ChannelHandle> m_inputChannelsWithStates;
 
     DISALLOW_COPY_AND_ASSIGN(EngineEffect);
 };
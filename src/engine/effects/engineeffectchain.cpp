@@ -4,6 +4,15 @@
 #include "util/defs.h"
 #include "util/sample.h"
 
+namespace {
+
+// Requests exceeding this limit of pending removals are deferred to the
+// next callback to avoid allocating memory in the audio thread. There is
+// at most one pending removal per effect and input channel.
+constexpr std::size_t kMaxPendingStatesRemovals = 256;
+
+} // namespace
+
 EngineEffectChain::EngineEffectChain(const QString& group,
         const QSet<ChannelHandleAndGroup>& registeredInputChannels,
         const QSet<ChannelHandleAndGroup>& registeredOutputChannels)
@@ -12,9 +21,11 @@ EngineEffectChain::EngineEffectChain(const QString& group,
           m_mixMode(EffectChainMixMode::DrySlashWet),
           m_dMix(0),
           m_buffer1(MAX_BUFFER_LEN),
-          m_buffer2(MAX_BUFFER_LEN) {
+          m_buffer2(MAX_BUFFER_LEN),
+          m_pResponsePipe(nullptr) {
     // Try to prevent memory allocation.
     m_effects.reserve(256);
+    m_pendingStatesRemovals.reserve(kMaxPendingStatesRemovals);
 
     for (const ChannelHandleAndGroup& inputChannel : registeredInputChannels) {
         ChannelHandleMap<ChannelStatus> outputChannelMap;
@@ -69,6 +80,14 @@ bool EngineEffectChain::removeEffect(EngineEffect* pEffect, int iIndex) {
         return false;
     }
 
+    // The effect is no longer processed and the states can be removed
+    // before the effect is deleted in the main thread.
+    for (std::size_t i = m_pendingStatesRemovals.size(); i-- > 0;) {
+        if (m_pendingStatesRemovals[i]->SwapEffectStatesForInputChannel.pEffect == pEffect) {
+            finishPendingStatesRemoval(i, true);
+        }
+    }
+
     m_effects.replace(iIndex, nullptr);
     return true;
 }
@@ -89,6 +108,7 @@ bool EngineEffectChain::updateParameters(const EffectsRequest& message) {
 
 bool EngineEffectChain::processEffectsRequest(EffectsRequest& message,
         EffectsResponsePipe* pResponsePipe) {
+    m_pResponsePipe = pResponsePipe;
     EffectsResponse response(message);
     switch (message.type) {
     case EffectsRequest::ADD_EFFECT_TO_CHAIN:
@@ -138,6 +158,20 @@ bool EngineEffectChain::processEffectsRequest(EffectsRequest& message,
         response.success = disableForInputChannel(
                 message.DisableInputChannelForChain.channelHandle);
         break;
+    case EffectsRequest::SWAP_EFFECT_STATES_FOR_INPUT_CHANNEL:
+        if (kEffectDebugOutput) {
+            qDebug() << debugString() << this
+                     << "SWAP_EFFECT_STATES_FOR_INPUT_CHANNEL"
+                     << message.SwapEffectStatesForInputChannel.pEffect
+                     << message.SwapEffectStatesForInputChannel.channelHandle
+                     << message.SwapEffectStatesForInputChannel.pStates->size();
+        }
+        if (!swapEffectStatesForInputChannel(&message)) {
+            // Responded to when the input channel has been faded out
+            return true;
+        }
+        response.success = true;
+        break;
     default:
         return false;
     }
@@ -145,6 +179,27 @@ bool EngineEffectChain::processEffectsRequest(EffectsRequest& message,
     return true;
 }
 
+bool EngineEffectChain::canProcessEffectsRequest(const EffectsRequest& message) {
+    if (message.type != EffectsRequest::SWAP_EFFECT_STATES_FOR_INPUT_CHANNEL ||
+            m_pendingStatesRemovals.size() < kMaxPendingStatesRemovals) {
+        return true;
+    }
+    // A removal that is resolved without waiting for the fade out
+    // doesn't need another pending slot.
+    const auto& request = message.SwapEffectStatesForInputChannel;
+    if (!request.pStates->empty() || isDisabledForInputChannel(request.channelHandle)) {
+        return true;
+    }
+    for (const EffectsRequest* pPending : m_pendingStatesRemovals) {
+        const auto& pending = pPending->SwapEffectStatesForInputChannel;
+        if (pending.pEffect == request.pEffect &&
+                pending.channelHandle == request.channelHandle) {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool EngineEffectChain::enableForInputChannel(ChannelHandle inputHandle) {
     if (kEffectDebugOutput) {
         qDebug() << "EngineEffectChain::enableForInputChannel" << this << inputHandle;
@@ -171,6 +226,66 @@ bool EngineEffectChain::disableForInputChannel(ChannelHandle inputHandle) {
     return true;
 }
 
+bool EngineEffectChain::swapEffectStatesForInputChannel(EffectsRequest* pRequest) {
+    EngineEffect* pEffect = pRequest->SwapEffectStatesForInputChannel.pEffect;
+    const ChannelHandle inputHandle = pRequest->SwapEffectStatesForInputChannel.channelHandle;
+    EffectStatesForInputChannel* pStates = pRequest->SwapEffectStatesForInputChannel.pStates;
+
+    for (std::size_t i = 0; i < m_pendingStatesRemovals.size(); ++i) {
+        const auto& pending = m_pendingStatesRemovals[i]->SwapEffectStatesForInputChannel;
+        if (pending.pEffect == pEffect && pending.channelHandle == inputHandle) {
+            // The input channel has been routed to the chain again before
+            // it has been faded out. Keep the current states and return
+            // the new states unused.
+            DEBUG_ASSERT(!pStates->empty());
+            finishPendingStatesRemoval(i, false);
+            return true;
+        }
+    }
+
+    if (pStates->empty() && !isDisabledForInputChannel(inputHandle)) {
+        // Ensured by canProcessEffectsRequest()
+        DEBUG_ASSERT(m_pendingStatesRemovals.size() < kMaxPendingStatesRemovals);
+        m_pendingStatesRemovals.push_back(pRequest);
+        return false;
+    }
+
+    pEffect->swapStatesForInputChannel(inputHandle, pStates);
+    return true;
+}
+
+bool EngineEffectChain::isDisabledForInputChannel(ChannelHandle inputHandle) {
+    for (const auto& outputChannelStatus : m_chainStatusForChannelMatrix[inputHandle]) {
+        if (outputChannelStatus.enableState != EffectEnableState::Disabled) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void EngineEffectChain::finishPendingStatesRemoval(std::size_t index, bool removeStates) {
+    EffectsRequest* pRequest = m_pendingStatesRemovals[index];
+    if (removeStates) {
+        pRequest->SwapEffectStatesForInputChannel.pEffect->swapStatesForInputChannel(
+                pRequest->SwapEffectStatesForInputChannel.channelHandle,
+                pRequest->SwapEffectStatesForInputChannel.pStates);
+    }
+    // The order of the pending requests doesn't matter
+    m_pendingStatesRemovals[index] = m_pendingStatesRemovals.back();
+    m_pendingStatesRemovals.pop_back();
+
+    EffectsResponse response(*pRequest, true);
+    m_pResponsePipe->writeMessage(response);
+}
+
+bool EngineEffectChain::isEnabledForChannel(const ChannelHandle& inputHandle,
+        const ChannelHandle& outputHandle) const {
+    // The chain's enable state only matters if the channel is not disabled,
+    // see process()
+    return m_chainStatusForChannelMatrix.at(inputHandle).at(outputHandle).enableState !=
+            EffectEnableState::Disabled;
+}
+
 bool EngineEffectChain::process(const ChannelHandle& inputHandle,
         const ChannelHandle& outputHandle,
         CSAMPLE* pIn,
@@ -324,5 +439,16 @@ bool EngineEffectChain::process(const ChannelHandle& inputHandle,
         m_enableState = EffectEnableState::Enabled;
     }
 
+    if (!m_pendingStatesRemovals.empty() &&
+            channelStatus.enableState == EffectEnableState::Disabled &&
+            isDisabledForInputChannel(inputHandle)) {
+        for (std::size_t i = m_pendingStatesRemovals.size(); i-- > 0;) {
+            if (m_pendingStatesRemovals[i]->SwapEffectStatesForInputChannel.channelHandle ==
+                    inputHandle) {
+                finishPendingStatesRemoval(i, true);
+            }
+        }
+    }
+
     return processingOccured;
 }
@@ -2,6 +2,7 @@
 
 #include <QList>
 #include <QString>
+#include <vector>
 
 #include "engine/channelhandle.h"
 #include "engine/effects/engineeffectsdelay.h"
@@ -36,6 +37,11 @@ class EngineEffectChain final : public EffectsRequestHandler {
             EffectsRequest& message,
             EffectsResponsePipe* pResponsePipe) override;
 
+    /// called from audio thread
+    /// Returns false if the request can't be processed without allocating
+    /// memory in this callback and needs to be retried in the next one.
+    bool canProcessEffectsRequest(const EffectsRequest& message);
+
     /// called from audio thread
     bool process(const ChannelHandle& inputHandle,
             const ChannelHandle& outputHandle,
@@ -46,6 +52,13 @@ class EngineEffectChain final : public EffectsRequestHandler {
             const GroupFeatureState& groupFeatures,
             bool fadeout);
 
+    /// called from audio thread
+    /// Returns false if process() leaves the buffers of the input channel
+    /// untouched for the output channel, because the chain is disabled
+    /// for it.
+    bool isEnabledForChannel(const ChannelHandle& inputHandle,
+            const ChannelHandle& outputHandle) const;
+
   private:
     struct ChannelStatus {
         ChannelStatus()
@@ -65,6 +78,12 @@ class EngineEffectChain final : public EffectsRequestHandler {
     bool removeEffect(EngineEffect* pEffect, int iIndex);
     bool enableForInputChannel(ChannelHandle inputHandle);
     bool disableForInputChannel(ChannelHandle inputHandle);
+    /// Returns false if removing the states has been deferred until
+    /// the input channel has been faded out.
+    bool swapEffectStatesForInputChannel(EffectsRequest* pRequest);
+    bool isDisabledForInputChannel(ChannelHandle inputHandle);
+    /// Removes the states and responds to the pending request
+    void finishPendingStatesRemoval(std::size_t index, bool removeStates);
 
     QString m_group;
     EffectEnableState m_enableState;
@@ -75,6 +94,10 @@ class EngineEffectChain final : public EffectsRequestHandler {
     mixxx::SampleBuffer m_buffer2;
     ChannelHandleMap<ChannelHandleMap<ChannelStatus>> m_chainStatusForChannelMatrix;
     EngineEffectsDelay m_effectsDelay;
+    // Requests to remove the states of an input channel that wait for
+    // the fade out of the channel.
+    std::vector<EffectsRequest*> m_pendingStatesRemovals;
+    EffectsResponsePipe* m_pResponsePipe;
 
     DISALLOW_COPY_AND_ASSIGN(EngineEffectChain);
 };
@@ -7,6 +7,7 @@
 
 EngineEffectsManager::EngineEffectsManager(EffectsResponsePipe* pResponsePipe)
         : m_pResponsePipe(pResponsePipe),
+          m_pDeferredRequest(nullptr),
           m_buffer1(MAX_BUFFER_LEN),
           m_buffer2(MAX_BUFFER_LEN) {
     // Try to prevent memory allocation.
@@ -17,8 +18,9 @@ EngineEffectsManager::~EngineEffectsManager() {
 }
 
 void EngineEffectsManager::onCallbackStart() {
-    EffectsRequest* request = nullptr;
-    while (m_pResponsePipe->readMessage(&request)) {
+    EffectsRequest* request = m_pDeferredRequest;
+    m_pDeferredRequest = nullptr;
+    while (request || m_pResponsePipe->readMessage(&request)) {
         EffectsResponse response(*request);
         bool processed = false;
         switch (request->type) {
@@ -32,7 +34,8 @@ void EngineEffectsManager::onCallbackStart() {
         case EffectsRequest::REMOVE_EFFECT_FROM_CHAIN:
         case EffectsRequest::SET_EFFECT_CHAIN_PARAMETERS:
         case EffectsRequest::ENABLE_EFFECT_CHAIN_FOR_INPUT_CHANNEL:
-        case EffectsRequest::DISABLE_EFFECT_CHAIN_FOR_INPUT_CHANNEL: {
+        case EffectsRequest::DISABLE_EFFECT_CHAIN_FOR_INPUT_CHANNEL:
+        case EffectsRequest::SWAP_EFFECT_STATES_FOR_INPUT_CHANNEL: {
             bool chainExists = false;
             for (const auto& chains : std::as_const(m_chainsByStage)) {
                 if (chains.contains(request->pTargetChain)) {
@@ -45,6 +48,11 @@ void EngineEffectsManager::onCallbackStart() {
                 response.status = EffectsResponse::NO_SUCH_CHAIN;
                 break;
             }
+            if (!request->pTargetChain->canProcessEffectsRequest(*request)) {
+                // Stop here to keep the order of the requests
+                m_pDeferredRequest = request;
+                return;
+            }
             processed = request->pTargetChain->processEffectsRequest(
                     *request, m_pResponsePipe.data());
             if (processed) {
@@ -91,6 +99,7 @@ void EngineEffectsManager::onCallbackStart() {
         if (!processed) {
             m_pResponsePipe->writeMessage(response);
         }
+        request = nullptr;
     }
 }
 
@@ -159,6 +168,19 @@ void EngineEffectsManager::processPostFaderAndMix(
             fadeout);
 }
 
+bool EngineEffectsManager::isPostFaderProcessingRequired(
+        const ChannelHandle& inputHandle,
+        const ChannelHandle& outputHandle) const {
+    const QList<EngineEffectChain*>& chains =
+            m_chainsByStage.value(SignalProcessingStage::Postfader);
+    for (const EngineEffectChain* pChain : chains) {
+        if (pChain && pChain->isEnabledForChannel(inputHandle, outputHandle)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void EngineEffectsManager::processInner(
         const SignalProcessingStage stage,
         const ChannelHandle& inputHandle,
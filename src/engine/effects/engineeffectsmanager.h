@@ -66,6 +66,14 @@ class EngineEffectsManager final : public EffectsRequestHandler {
             CSAMPLE_GAIN newGain = CSAMPLE_GAIN_ONE,
             bool fadeout = false);
 
+    /// Returns true if any postfader EngineEffectChain processes the input
+    /// channel for the output channel. Otherwise the postfader processing
+    /// of the channel only applies the gain, which allows ChannelMixer to
+    /// apply it while mixing.
+    bool isPostFaderProcessingRequired(
+            const ChannelHandle& inputHandle,
+            const ChannelHandle& outputHandle) const;
+
     bool processEffectsRequest(
             EffectsRequest& message,
             EffectsResponsePipe* pResponsePipe) override;
@@ -98,6 +106,9 @@ class EngineEffectsManager final : public EffectsRequestHandler {
             bool fadeout = false);
 
     QScopedPointer<EffectsResponsePipe> m_pResponsePipe;
+    /// A request that has been read from the pipe but could not be
+    /// processed yet. It is processed first in the next callback.
+    EffectsRequest* m_pDeferredRequest;
     QHash<SignalProcessingStage, QList<EngineEffectChain*>> m_chainsByStage;
     QList<EngineEffect*> m_effects;
 
@@ -3,6 +3,8 @@
 #include <QString>
 #include <QVariant>
 #include <QtGlobal>
+#include <memory>
+#include <vector>
 
 #include "effects/defs.h"
 #include "effects/effectchainmixmode.h"
@@ -12,6 +14,11 @@
 
 class EngineEffectChain;
 class EngineEffect;
+class EffectState;
+
+/// The EffectStates of one input channel, indexed by the handle of the output
+/// channel. Gaps for unregistered output channels are filled with nullptr.
+typedef std::vector<std::unique_ptr<EffectState>> EffectStatesForInputChannel;
 
 struct EffectsRequest {
     enum MessageType {
@@ -25,6 +32,10 @@ struct EffectsRequest {
         // the outputs that effects are applied to are hardwired in EngineMaster
         ENABLE_EFFECT_CHAIN_FOR_INPUT_CHANNEL,
         DISABLE_EFFECT_CHAIN_FOR_INPUT_CHANNEL,
+        // Installs new states of an effect in the chain for an input channel
+        // or removes them if the states are empty. Removing is deferred
+        // until the chain has faded out the input channel.
+        SWAP_EFFECT_STATES_FOR_INPUT_CHANNEL,
 
         // Messages for EngineEffect
         SET_EFFECT_PARAMETERS,
@@ -55,6 +66,7 @@ struct EffectsRequest {
         // - SET_EFFECT_CHAIN_PARAMETERS
         // - ENABLE_EFFECT_CHAIN_FOR_INPUT_CHANNEL
         // - DISABLE_EFFECT_CHAIN_FOR_INPUT_CHANNEL
+        // - SWAP_EFFECT_STATES_FOR_INPUT_CHANNEL
         EngineEffectChain* pTargetChain;
         // Used by:
         // - SET_EFFECT_PARAMETER
@@ -77,6 +89,13 @@ struct EffectsRequest {
         struct {
             ChannelHandle channelHandle;
         } DisableInputChannelForChain;
+        struct {
+            EngineEffect* pEffect;
+            ChannelHandle channelHandle;
+            // Owned by the request. Contains the swapped out states
+            // when the response has been received.
+            EffectStatesForInputChannel* pStates;
+        } SwapEffectStatesForInputChannel;
         struct {
             EngineEffect* pEffect;
             int iIndex;
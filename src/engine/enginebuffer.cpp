@@ -62,6 +62,9 @@ constexpr SINT kSamplesPerFrame = 2; // Engine buffer uses Stereo frames only
 // Rate at which the playpos slider is updated
 constexpr int kPlaypositionUpdateRate = 15; // updates per second
 
+// Longest pass through a loop that is cached, ~22 s at 48 kHz (8 MiB)
+constexpr SINT kLoopCacheCapacityFrames = 1 << 20;
+
 } // anonymous namespace
 
 EngineBuffer::EngineBuffer(const QString& group,
@@ -69,7 +72,9 @@ EngineBuffer::EngineBuffer(const QString& group,
         EngineChannel* pChannel,
         EngineMaster* pMixingEngine)
         : m_group(group),
+          m_channelIndex(-1),
           m_pConfig(pConfig),
+          m_pEngineMaster(pMixingEngine),
           m_pLoopingControl(nullptr),
           m_pSyncControl(nullptr),
           m_pVinylControlControl(nullptr),
@@ -93,6 +98,10 @@ EngineBuffer::EngineBuffer(const QString& group,
           m_pRepeat(nullptr),
           m_startButton(nullptr),
           m_endButton(nullptr),
+          m_pScaleKeylock(nullptr),
+          m_pScaleRBFaster(nullptr),
+          m_iKeylockEngineSelected(static_cast<int>(defaultKeylockEngine())),
+          m_bKeylockAdaptiveProcessing(false),
           m_bScalerOverride(false),
           m_iSeekPhaseQueued(0),
           m_iEnableSyncQueued(SYNC_REQUEST_NONE),
@@ -100,7 +109,9 @@ EngineBuffer::EngineBuffer(const QString& group,
           m_bPlayAfterLoading(false),
           m_pCrossfadeBuffer(SampleUtil::alloc(MAX_BUFFER_LEN)),
           m_bCrossfadeReady(false),
-          m_iLastBufferSize(0) {
+          m_iLastBufferSize(0),
+          m_pLoopCache(nullptr),
+          m_bPlayingFromLoopCache(false) {
     // This should be a static assertion, but isValid() is not constexpr.
     DEBUG_ASSERT(kInitialPlayPosition.isValid());
 
@@ -184,6 +195,17 @@ EngineBuffer::EngineBuffer(const QString& group,
     m_pTrackLoaded = new ControlObject(ConfigKey(m_group, "track_loaded"), false);
     m_pTrackLoaded->setReadOnly();
 
+    m_pKeylockEngineActive = new ControlObject(ConfigKey(m_group, "keylock_engine_active"));
+    m_pKeylockEngineActive->setReadOnly();
+
+    m_pLoopCacheEnabled = new ControlPushButton(ConfigKey(m_group, "keylock_loop_cache"));
+    m_pLoopCacheEnabled->setButtonMode(ControlPushButton::TOGGLE);
+    connect(m_pLoopCacheEnabled,
+            &ControlObject::valueChanged,
+            this,
+            &EngineBuffer::slotLoopCacheEnabled,
+            Qt::DirectConnection);
+
     // Quantization Controller for enabling and disabling the
     // quantization (alignment) of loop in/out positions and (hot)cues with
     // beats.
@@ -264,11 +286,18 @@ EngineBuffer::EngineBuffer(const QString& group,
     m_pKeylockEngine->connectValueChanged(this,
             &EngineBuffer::slotKeylockEngineChanged,
             Qt::DirectConnection);
+    m_pKeylockEngineAdaptive = new ControlProxy("[Master]", "keylock_engine_adaptive", this);
+    m_pKeylockEngineAdaptive->connectValueChanged(this,
+            &EngineBuffer::slotKeylockEngineAdaptiveChanged,
+            Qt::DirectConnection);
+    m_pAudioLatencyUsage = new ControlProxy("[Master]", "audio_latency_usage", this);
     // Construct scaling objects
     m_pScaleLinear = new EngineBufferScaleLinear(m_pReadAheadManager);
     m_pScaleST = new EngineBufferScaleST(m_pReadAheadManager);
     m_pScaleRB = new EngineBufferScaleRubberBand(m_pReadAheadManager);
     slotKeylockEngineChanged(m_pKeylockEngine->get());
+    // The audio thread is not running yet
+    setKeylockEngine(static_cast<KeylockEngine>(m_iKeylockEngineSelected.loadAcquire()));
     m_pScaleVinyl = m_pScaleLinear;
     m_pScale = m_pScaleVinyl;
     m_pScale->clear();
@@ -313,12 +342,16 @@ EngineBuffer::~EngineBuffer() {
     delete m_pSampleRate;
 
     delete m_pTrackLoaded;
+    delete m_pKeylockEngineActive;
+    delete m_pLoopCacheEnabled;
     delete m_pTrackSamples;
     delete m_pTrackSampleRate;
 
     delete m_pScaleLinear;
     delete m_pScaleST;
     delete m_pScaleRB;
+    delete m_pScaleRBFaster.loadAcquire();
+    delete m_pLoopCache.loadAcquire();
 
     delete m_pKeylock;
 
@@ -339,8 +372,7 @@ void EngineBuffer::enableIndependentPitchTempoScaling(bool bEnable,
     // interpolation code (EngineBufferScaleLinear). It is faster and sounds
     // much better for scratching.
 
-    // m_pScaleKeylock and m_pScaleVinyl could change out from under us,
-    // so cache it.
+    // m_pScaleVinyl could change out from under us, so cache it.
     EngineBufferScale* keylock_scale = m_pScaleKeylock;
     EngineBufferScale* vinyl_scale = m_pScaleVinyl;
 
@@ -453,6 +485,10 @@ void EngineBuffer::requestClonePosition(EngineChannel* pChannel) {
 }
 
 void EngineBuffer::readToCrossfadeBuffer(const int iBufferSize) {
+    if (m_bPlayingFromLoopCache) {
+        stopPlayingFromLoopCache(iBufferSize);
+        return;
+    }
     if (!m_bCrossfadeReady) {
         // Read buffer, as if there where no parameter change
         // (Must be called only once per callback)
@@ -474,9 +510,15 @@ void EngineBuffer::setNewPlaypos(mixxx::audio::FramePos position) {
         kLogger.trace() << m_group << "EngineBuffer::setNewPlaypos" << position;
     }
 
+    const bool wasPlayingFromLoopCache = m_bPlayingFromLoopCache;
+    if (wasPlayingFromLoopCache) {
+        // Crossfade from the cached audio at the old position
+        stopPlayingFromLoopCache(m_iLastBufferSize);
+    }
+
     m_playPosition = position;
 
-    if (m_rate_old != 0.0) {
+    if (m_rate_old != 0.0 && !wasPlayingFromLoopCache) {
         // Before seeking, read extra buffer for crossfading
         // this also sets m_pReadAheadManager to newpos
         readToCrossfadeBuffer(m_iLastBufferSize);
@@ -551,6 +593,7 @@ void EngineBuffer::slotTrackLoaded(TrackPointer pTrack,
     m_visualPlayPos->setInvalid();
     m_playPosition = kInitialPlayPosition; // for execute seeks to 0.0
     m_pCurrentTrack = pTrack;
+    invalidateLoopCache();
     m_pTrackSamples->set(iTrackNumSamples);
     m_pTrackSampleRate->set(iTrackSampleRate);
     m_pTrackLoaded->forceSet(1);
@@ -799,23 +842,169 @@ void EngineBuffer::slotKeylockEngineChanged(double dIndex) {
         return;
     }
     const KeylockEngine engine = static_cast<KeylockEngine>(dIndex);
+    // The keylock scaler itself is only switched by the audio thread in
+    // processKeylockEngine(), this slot may be called from any thread.
     switch (engine) {
     case KeylockEngine::SoundTouch:
-        m_pScaleKeylock = m_pScaleST;
         break;
     case KeylockEngine::RubberBandFaster:
         m_pScaleRB->useEngineFiner(false);
-        m_pScaleKeylock = m_pScaleRB;
         break;
     case KeylockEngine::RubberBandFiner:
         m_pScaleRB->useEngineFiner(
                 true); // in case of Rubberband V2 it falls back to RUBBERBAND_FASTER
-        m_pScaleKeylock = m_pScaleRB;
+        if (m_pKeylockEngineAdaptive->toBool() &&
+                EngineBufferScaleRubberBand::isEngineFinerAvailable() &&
+                !m_pScaleRBFaster.loadAcquire()) {
+            // Allocate the intermediate tier here, because Rubberband
+            // allocates its buffers when the sample rate is set.
+            auto* pScaleRBFaster = new EngineBufferScaleRubberBand(m_pReadAheadManager);
+            pScaleRBFaster->setSampleRate(m_pScaleRB->getOutputSignal().getSampleRate());
+            if (!m_pScaleRBFaster.testAndSetOrdered(nullptr, pScaleRBFaster)) {
+                delete pScaleRBFaster;
+            }
+        }
         break;
     default:
         slotKeylockEngineChanged(static_cast<double>(defaultKeylockEngine()));
-        break;
+        return;
+    }
+    m_iKeylockEngineSelected.storeRelease(static_cast<int>(engine));
+}
+
+void EngineBuffer::slotKeylockEngineAdaptiveChanged(double) {
+    // Allocate the intermediate tier if needed. The audio thread restores
+    // the selected engine or resets the KeylockQualityPolicy.
+    slotKeylockEngineChanged(m_pKeylockEngine->get());
+}
+
+void EngineBuffer::slotLoopCacheEnabled(double v) {
+    if (v > 0.0 && !m_pLoopCache.loadAcquire()) {
+        // Allocate here, the audio thread only picks up the pointer.
+        // The control may be toggled from the main and a controller thread.
+        auto* pLoopCache = new ScaledLoopCache(kLoopCacheCapacityFrames);
+        if (!m_pLoopCache.testAndSetOrdered(nullptr, pLoopCache)) {
+            delete pLoopCache;
+        }
+    }
+}
+
+ScaledLoopCache* EngineBuffer::loopCacheForCurrentLoop(
+        bool is_scratching, ScaledLoopCache::Parameters* pParameters) const {
+    if (!m_pLoopCacheEnabled->toBool()) {
+        return nullptr;
+    }
+    ScaledLoopCache* pLoopCache = m_pLoopCache.loadAcquire();
+    if (!pLoopCache) {
+        return nullptr;
+    }
+    // Only the time stretching scalers are expensive enough to be worth it,
+    // and only their output is independent from the fractional read position.
+    if (m_pScale != m_pScaleKeylock || is_scratching || m_bScalerOverride) {
+        return nullptr;
+    }
+    mixxx::audio::FramePos loopStartPosition;
+    mixxx::audio::FramePos loopEndPosition;
+    if (!m_pLoopingControl->getActiveLoop(&loopStartPosition, &loopEndPosition) ||
+            m_playPosition < loopStartPosition ||
+            m_playPosition >= loopEndPosition) {
+        return nullptr;
+    }
+    *pParameters = ScaledLoopCache::Parameters{
+            m_baserate_old,
+            m_speed_old,
+            m_pitch_old,
+            loopStartPosition,
+            loopEndPosition};
+    if (!pLoopCache->canCache(*pParameters)) {
+        return nullptr;
+    }
+    return pLoopCache;
+}
+
+void EngineBuffer::stopPlayingFromLoopCache(const int iBufferSize) {
+    // The scaler has been paused while playing from the cache. Fade out the
+    // cached continuation and restart the scaler at the current position.
+    ScaledLoopCache* pLoopCache = m_pLoopCache.loadAcquire();
+    if (!m_bCrossfadeReady && pLoopCache) {
+        pLoopCache->play(m_pCrossfadeBuffer, iBufferSize / kSamplesPerFrame, m_playPosition);
+        m_bCrossfadeReady = true;
+    }
+    m_pReadAheadManager->notifySeek(m_playPosition);
+    m_pScale->clear();
+    m_bPlayingFromLoopCache = false;
+}
+
+void EngineBuffer::invalidateLoopCache() {
+    ScaledLoopCache* pLoopCache = m_pLoopCache.loadAcquire();
+    if (pLoopCache) {
+        pLoopCache->invalidate();
     }
+    m_bPlayingFromLoopCache = false;
+}
+
+EngineBufferScale* EngineBuffer::keylockScalerForEngine(KeylockEngine engine) const {
+    switch (engine) {
+    case KeylockEngine::RubberBandFiner:
+        return m_pScaleRB;
+    case KeylockEngine::RubberBandFaster:
+        if (static_cast<KeylockEngine>(m_iKeylockEngineSelected.loadAcquire()) ==
+                KeylockEngine::RubberBandFaster) {
+            return m_pScaleRB;
+        }
+        if (EngineBufferScaleRubberBand* pScaleRBFaster = m_pScaleRBFaster.loadAcquire()) {
+            return pScaleRBFaster;
+        }
+        // The intermediate tier is not available, skip it
+        return m_pScaleST;
+    case KeylockEngine::SoundTouch:
+    default:
+        return m_pScaleST;
+    }
+}
+
+void EngineBuffer::processKeylockEngine(const int iBufferSize) {
+    if (m_bScalerOverride) {
+        return;
+    }
+
+    // The tiers are ordered like the KeylockEngine enum, from
+    // SoundTouch (cheapest) up to the engine selected in the preferences
+    const int selectedTier = m_iKeylockEngineSelected.loadAcquire();
+    if (!m_pKeylockEngineAdaptive->toBool()) {
+        m_bKeylockAdaptiveProcessing = false;
+        setKeylockEngine(static_cast<KeylockEngine>(selectedTier));
+        return;
+    }
+
+    bool tierChanged = false;
+    if (!m_bKeylockAdaptiveProcessing || m_keylockQualityPolicy.maxTier() != selectedTier) {
+        m_keylockQualityPolicy.setMaxTier(selectedTier);
+        m_bKeylockAdaptiveProcessing = true;
+        tierChanged = true;
+    }
+    if (m_keylockQualityPolicy.update(m_pAudioLatencyUsage->get(),
+                m_pEngineMaster->getMasterGain(m_channelIndex),
+                iBufferSize / kSamplesPerFrame,
+                m_sampleRate)) {
+        tierChanged = true;
+    }
+    if (!tierChanged) {
+        return;
+    }
+    setKeylockEngine(static_cast<KeylockEngine>(m_keylockQualityPolicy.tier()));
+}
+
+void EngineBuffer::setKeylockEngine(KeylockEngine engine) {
+    EngineBufferScale* pScaleKeylock = keylockScalerForEngine(engine);
+    if (pScaleKeylock == m_pScaleKeylock &&
+            m_pKeylockEngineActive->get() == static_cast<double>(engine)) {
+        return;
+    }
+    // If keylock is in use, enableIndependentPitchTempoScaling() notices the
+    // new scaler and crossfades from the previous one.
+    m_pScaleKeylock = pScaleKeylock;
+    m_pKeylockEngineActive->forceSet(static_cast<double>(engine));
 }
 
 void EngineBuffer::processTrackLocked(
@@ -833,6 +1022,8 @@ void EngineBuffer::processTrackLocked(
     // Sync requests can affect rate, so process those first.
     processSyncRequests();
 
+    processKeylockEngine(iBufferSize);
+
     // Note: play is also active during cue preview
     bool paused = !m_playButton->toBool();
     KeyControl::PitchTempoRatio pitchTempoRatio = m_pKeyControl->getPitchTempoRatio();
@@ -1041,26 +1232,62 @@ void EngineBuffer::processTrackLocked(
 
     // If the buffer is not paused, then scale the audio.
     if (!bCurBufferPaused) {
-        // Perform scaling of Reader buffer into buffer.
-        const auto framesRead = m_pScale->scaleBuffer(pOutput, iBufferSize);
-
-        // TODO(XXX): The result framesRead might not be an integer value.
-        // Converting to samples here does not make sense. All positional
-        // calculations should be done in frames instead of samples! Otherwise
-        // rounding errors might occur when converting from samples back to
-        // frames later.
-
-        if (m_bScalerOverride) {
-            // If testing, we don't have a real log so we fake the position.
-            m_playPosition += framesRead;
+        ScaledLoopCache::Parameters loopCacheParameters{};
+        ScaledLoopCache* pLoopCache = loopCacheForCurrentLoop(
+                is_scratching, &loopCacheParameters);
+        if (pLoopCache && pLoopCache->isCompleteFor(loopCacheParameters)) {
+            if (!m_bPlayingFromLoopCache && !m_bCrossfadeReady) {
+                // The scaler output is not exactly periodic, so fade from
+                // its continuation into the cached pass.
+                m_pScale->scaleBuffer(m_pCrossfadeBuffer, iBufferSize);
+                m_bCrossfadeReady = true;
+            }
+            // The scaler would render the same audio as during the last
+            // pass through the loop
+            m_playPosition = pLoopCache->play(
+                    pOutput, iBufferSize / kSamplesPerFrame, m_playPosition);
+            m_bPlayingFromLoopCache = true;
         } else {
-            // Adjust filepos_play by the amount we processed.
-            m_playPosition =
-                    m_pReadAheadManager->getFilePlaypositionFromLog(m_playPosition, framesRead);
+            if (m_bPlayingFromLoopCache) {
+                stopPlayingFromLoopCache(iBufferSize);
+            }
+            const mixxx::audio::FramePos positionBefore = m_playPosition;
+
+            // Perform scaling of Reader buffer into buffer.
+            const auto framesRead = m_pScale->scaleBuffer(pOutput, iBufferSize);
+
+            // TODO(XXX): The result framesRead might not be an integer value.
+            // Converting to samples here does not make sense. All positional
+            // calculations should be done in frames instead of samples! Otherwise
+            // rounding errors might occur when converting from samples back to
+            // frames later.
+
+            if (m_bScalerOverride) {
+                // If testing, we don't have a real log so we fake the position.
+                m_playPosition += framesRead;
+            } else {
+                // Adjust filepos_play by the amount we processed.
+                m_playPosition =
+                        m_pReadAheadManager->getFilePlaypositionFromLog(m_playPosition, framesRead);
+            }
+            // Note: The last buffer of a track is padded with silence.
+            // This silence is played together with the last samples in the last
+            // callback and the m_playPosition is advanced behind the end of the track.
+
+            if (pLoopCache) {
+                if (m_bCrossfadeReady) {
+                    // This buffer is faded in after a seek or parameter
+                    // change and does not belong to a steady pass.
+                    pLoopCache->invalidate();
+                } else {
+                    pLoopCache->record(loopCacheParameters,
+                            pOutput,
+                            iBufferSize / kSamplesPerFrame,
+                            positionBefore,
+                            m_playPosition);
+                }
+            }
         }
-        // Note: The last buffer of a track is padded with silence.
-        // This silence is played together with the last samples in the last
-        // callback and the m_playPosition is advanced behind the end of the track.
 
         if (m_bCrossfadeReady) {
             // Bring pOutput with the new parameters in and fade out the old one,
@@ -1139,6 +1366,9 @@ void EngineBuffer::process(CSAMPLE* pOutput, const int iBufferSize) {
     m_pScaleLinear->setSampleRate(m_sampleRate);
     m_pScaleST->setSampleRate(m_sampleRate);
     m_pScaleRB->setSampleRate(m_sampleRate);
+    if (EngineBufferScaleRubberBand* pScaleRBFaster = m_pScaleRBFaster.loadAcquire()) {
+        pScaleRBFaster->setSampleRate(m_sampleRate);
+    }
 
     bool bTrackLoading = m_iTrackLoading.loadAcquire() != 0;
     if (!bTrackLoading && m_pause.tryLock()) {
@@ -1322,7 +1552,7 @@ void EngineBuffer::postProcess(const int iBufferSize) {
     if (kLogger.traceEnabled()) {
         kLogger.trace() << getGroup() << "EngineBuffer::postProcess";
     }
-    const mixxx::Bpm localBpm = m_pBpmControl->updateLocalBpm();
+    const mixxx::Bpm localBpm = m_pBpmControl->updateLocalBpmInCallback();
     double beatDistance = m_pBpmControl->updateBeatDistance();
     const SyncMode mode = m_pSyncControl->getSyncMode();
     if (localBpm.isValid()) {
@@ -3,6 +3,7 @@
 #include <gtest/gtest_prod.h>
 
 #include <QAtomicInt>
+#include <QAtomicPointer>
 #include <QMutex>
 #include <cfloat>
 #include <initializer_list>
@@ -10,6 +11,8 @@
 #include "audio/frame.h"
 #include "control/controlvalue.h"
 #include "engine/bufferscalers/enginebufferscalerubberband.h"
+#include "engine/bufferscalers/keylockqualitypolicy.h"
+#include "engine/bufferscalers/scaledloopcache.h"
 #include "engine/cachingreader/cachingreader.h"
 #include "engine/engineobject.h"
 #include "engine/sync/syncable.h"
@@ -206,6 +209,8 @@ class EngineBuffer : public EngineObject {
     void slotControlEnd(double);
     void slotControlSeek(double);
     void slotKeylockEngineChanged(double);
+    void slotKeylockEngineAdaptiveChanged(double);
+    void slotLoopCacheEnabled(double);
 
   signals:
     void trackLoaded(TrackPointer pNewTrack, TrackPointer pOldTrack);
@@ -254,6 +259,23 @@ class EngineBuffer : public EngineObject {
     // Reset buffer playpos and set file playpos.
     void setNewPlaypos(mixxx::audio::FramePos playpos);
 
+    // Switches the keylock scaler to the selected engine. In adaptive mode
+    // steps it down to cheaper engines and back up, depending on the audio
+    // callback load and the gain of this deck.
+    void processKeylockEngine(const int iBufferSize);
+    // Must only be called from the audio thread, or before it is running
+    void setKeylockEngine(KeylockEngine engine);
+    EngineBufferScale* keylockScalerForEngine(KeylockEngine engine) const;
+
+    // Returns the loop cache if the keylock output of the current loop
+    // can be cached, otherwise nullptr
+    ScaledLoopCache* loopCacheForCurrentLoop(
+            bool is_scratching, ScaledLoopCache::Parameters* pParameters) const;
+    // Continues with the scaler after playing from the loop cache
+    void stopPlayingFromLoopCache(const int iBufferSize);
+    // Must be called when the track audio changes
+    void invalidateLoopCache();
+
     void processSyncRequests();
     void processSeek(bool paused);
     // For debugging / testing -- returns true if the previous buffer call resulted in a seek.
@@ -274,6 +296,8 @@ class EngineBuffer : public EngineObject {
 
     UserSettingsPointer m_pConfig;
 
+    EngineMaster* m_pEngineMaster;
+
     friend class CueControlTest;
     friend class HotcueControlTest;
     friend class LoopingControlTest;
@@ -373,7 +397,13 @@ class EngineBuffer : public EngineObject {
     ControlPotmeter* m_playposSlider;
     ControlProxy* m_pSampleRate;
     ControlProxy* m_pKeylockEngine;
+    ControlProxy* m_pKeylockEngineAdaptive;
+    ControlProxy* m_pAudioLatencyUsage;
     ControlPushButton* m_pKeylock;
+    // The keylock engine currently used by this deck, which differs from
+    // m_pKeylockEngine if it has been stepped down due to CPU pressure
+    ControlObject* m_pKeylockEngineActive;
+    ControlPushButton* m_pLoopCacheEnabled;
 
     // This ControlProxys is created as parent to this and deleted by
     // the Qt object tree. This helps that they are deleted by the creating
@@ -398,16 +428,26 @@ class EngineBuffer : public EngineObject {
     FRIEND_TEST(EngineBufferTest, ReadFadeOut);
     FRIEND_TEST(EngineBufferTest, RateTempTest);
     FRIEND_TEST(EngineBufferTest, RatePermTest);
+    FRIEND_TEST(EngineBufferE2ETest, AdaptiveKeylockStepsDownFadedOutDeckFirst);
     EngineBufferScale* m_pScaleVinyl;
-    // The keylock engine is configurable, so it could flip flop between
-    // ScaleST and ScaleRB during a single callback.
-    EngineBufferScale* volatile m_pScaleKeylock;
+    // The keylock engine is configurable. It is only switched by the
+    // audio thread in processKeylockEngine().
+    EngineBufferScale* m_pScaleKeylock;
 
     // Object used for vinyl-style interpolation scaling of the audio
     EngineBufferScaleLinear* m_pScaleLinear;
     // Objects used for pitch-indep time stretch (key lock) scaling of the audio
     EngineBufferScaleST* m_pScaleST;
     EngineBufferScaleRubberBand* m_pScaleRB;
+    // Used as intermediate tier by the adaptive keylock quality if the
+    // finer engine is selected. Created on demand outside the audio thread,
+    // to avoid allocating a second Rubberband instance for every sampler.
+    QAtomicPointer<EngineBufferScaleRubberBand> m_pScaleRBFaster;
+
+    // The keylock engine selected in the preferences
+    QAtomicInt m_iKeylockEngineSelected;
+    KeylockQualityPolicy m_keylockQualityPolicy;
+    bool m_bKeylockAdaptiveProcessing;
 
     // Indicates whether the scaler has changed since the last process()
     bool m_bScalerChanged;
@@ -443,6 +483,11 @@ class EngineBuffer : public EngineObject {
     bool m_bCrossfadeReady;
     int m_iLastBufferSize;
 
+    // Keylock output of the current loop, allocated outside the audio
+    // thread when enabled for the first time and kept until destruction
+    QAtomicPointer<ScaledLoopCache> m_pLoopCache;
+    bool m_bPlayingFromLoopCache;
+
     QSharedPointer<VisualPlayPosition> m_visualPlayPos;
 };
 
@@ -24,6 +24,7 @@
 #include "moc_enginemaster.cpp"
 #include "preferences/usersettings.h"
 #include "util/defs.h"
+#include "util/rampinggain.h"
 #include "util/sample.h"
 #include "util/timer.h"
 #include "util/trace.h"
@@ -74,7 +75,10 @@ EngineMaster::EngineMaster(
     m_pMasterLatency = new ControlObject(ConfigKey(group, "latency"), true, true);
     m_pMasterAudioBufferSize = new ControlObject(ConfigKey(group, "audio_buffer_size"));
     m_pAudioLatencyOverloadCount = new ControlObject(ConfigKey(group, "audio_latency_overload_count"), true, true);
-    m_pAudioLatencyUsage = new ControlPotmeter(ConfigKey(group, "audio_latency_usage"), 0.0, 0.25);
+    // The skins display 0...0.25, but the real callback load is needed
+    // by the adaptive keylock quality, so it must not be clamped.
+    m_pAudioLatencyUsage = new ControlPotmeter(
+            ConfigKey(group, "audio_latency_usage"), 0.0, 0.25, true);
     m_pAudioLatencyOverload  = new ControlPotmeter(ConfigKey(group, "audio_latency_overload"), 0.0, 1.0);
 
     // Master sync controller
@@ -175,6 +179,9 @@ EngineMaster::EngineMaster(
     m_pKeylockEngine = new ControlObject(ConfigKey(group, "keylock_engine"), true, false, true);
     m_pKeylockEngine->set(pConfig->getValue(ConfigKey(group, "keylock_engine"),
             static_cast<double>(EngineBuffer::defaultKeylockEngine())));
+    // Allows decks to step down to cheaper keylock engines under CPU pressure
+    m_pKeylockEngineAdaptive = new ControlObject(
+            ConfigKey(group, "keylock_engine_adaptive"), true, false, true);
 
     // TODO: Make this read only and make EngineMaster decide whether
     // processing the master mix is necessary.
@@ -195,6 +202,7 @@ EngineMaster::EngineMaster(
 EngineMaster::~EngineMaster() {
     //qDebug() << "in ~EngineMaster()";
     delete m_pKeylockEngine;
+    delete m_pKeylockEngineAdaptive;
     delete m_pCrossfader;
     delete m_pBalance;
     delete m_pHeadMix;
@@ -806,33 +814,48 @@ void EngineMaster::applyMasterEffects() {
 }
 
 void EngineMaster::processHeadphones(const CSAMPLE_GAIN masterMixGainInHeadphones) {
-    // Add master mix to headphones
-    SampleUtil::addWithRampingGain(m_pHead, m_pMaster,
-                                   m_headphoneMasterGainOld,
-                                   masterMixGainInHeadphones, m_iBufferSize);
+    // Add the master mix to the headphones, apply Head Split and the
+    // headphone gain in a single pass. The ramping gains match those of
+    // SampleUtil::addWithRampingGain() and SampleUtil::applyRampingGain(),
+    // this file is compiled with -ffp-contract=off like util/sample.cpp.
+    const RampingGain masterMixGain(m_headphoneMasterGainOld,
+            masterMixGainInHeadphones,
+            m_iBufferSize);
     m_headphoneMasterGainOld = masterMixGainInHeadphones;
+    const CSAMPLE_GAIN headphoneGain = static_cast<CSAMPLE_GAIN>(m_pHeadGain->get());
+    const RampingGain headGain(m_headphoneGainOld, headphoneGain, m_iBufferSize);
+    m_headphoneGainOld = headphoneGain;
 
     // If Head Split is enabled, replace the left channel of the pfl buffer
     // with a mono mix of the headphone buffer, and the right channel of the pfl
     // buffer with a mono mix of the master output buffer.
-    if (m_pHeadSplitEnabled->toBool()) {
-        // note: NOT VECTORIZED because of in place copy
-        for (unsigned int i = 0; i + 1 < m_iBufferSize; i += 2) {
-            m_pHead[i] = (m_pHead[i] + m_pHead[i + 1]) / 2;
-            m_pHead[i + 1] = (m_pMaster[i] + m_pMaster[i + 1]) / 2;
+    const bool headSplit = m_pHeadSplitEnabled->toBool();
+    for (unsigned int i = 0; i + 1 < m_iBufferSize; i += 2) {
+        const int frame = static_cast<int>(i / 2);
+        CSAMPLE left = m_pHead[i];
+        CSAMPLE right = m_pHead[i + 1];
+        if (!masterMixGain.isZero()) {
+            left += masterMixGain.apply(m_pMaster[i], frame);
+            right += masterMixGain.apply(m_pMaster[i + 1], frame);
+        }
+        if (headSplit) {
+            const CSAMPLE headMono = (left + right) / 2;
+            right = (m_pMaster[i] + m_pMaster[i + 1]) / 2;
+            left = headMono;
         }
+        m_pHead[i] = headGain.apply(left, frame);
+        m_pHead[i + 1] = headGain.apply(right, frame);
     }
-
-    // Apply headphone gain
-    CSAMPLE_GAIN headphoneGain = static_cast<CSAMPLE_GAIN>(m_pHeadGain->get());
-    SampleUtil::applyRampingGain(m_pHead, m_headphoneGainOld,
-                                 headphoneGain, m_iBufferSize);
-    m_headphoneGainOld = headphoneGain;
 }
 
 void EngineMaster::addChannel(EngineChannel* pChannel) {
     ChannelInfo* pChannelInfo = new ChannelInfo(m_channels.size());
     pChannel->setChannelIndex(pChannelInfo->m_index);
+    EngineBuffer* pEngineBuffer = pChannel->getEngineBuffer();
+    if (pEngineBuffer) {
+        // Allows the buffer to look up its gain in the main mix
+        pEngineBuffer->setChannelIndex(pChannelInfo->m_index);
+    }
     pChannelInfo->m_pChannel = pChannel;
     const QString& group = pChannel->getGroup();
     pChannelInfo->m_handle = m_pChannelHandleFactory->getOrCreateHandle(group);
@@ -6,6 +6,7 @@
 #include "moc_engineworkerscheduler.cpp"
 #include "util/compatibility/qmutex.h"
 #include "util/event.h"
+#include "util/threadrole.h"
 
 EngineWorkerScheduler::EngineWorkerScheduler(QObject* pParent)
         : m_bWakeScheduler(false),
@@ -41,6 +42,7 @@ void EngineWorkerScheduler::runWorkers() {
 
 void EngineWorkerScheduler::run() {
     static const QString tag("EngineWorkerScheduler");
+    const mixxx::ScopedThreadRole threadRole(mixxx::ThreadRole::EngineWorker);
     while (!m_bQuit) {
         Event::start(tag);
         {
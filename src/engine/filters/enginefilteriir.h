@@ -3,6 +3,10 @@
 #include <cstdio>
 #include <cstring>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #define MIXXX
 #include <fidlib.h>
 
@@ -26,6 +30,89 @@ enum IIRPass {
 };
 
 
+/// The samples of the left and right channel at the same position of a
+/// stereo stream. Both channels are filtered with the same coefficients but
+/// independent states, so every operation of the recursive processSample()
+/// functions is applied to both channels at once in the two lanes of a
+/// SIMD register.
+class IIRStereoSample {
+  public:
+    IIRStereoSample() = default;
+#ifdef __SSE2__
+    IIRStereoSample(double left, double right)
+            : m_lanes(_mm_set_pd(right, left)) {
+    }
+
+    double left() const {
+        return _mm_cvtsd_f64(m_lanes);
+    }
+    double right() const {
+        return _mm_cvtsd_f64(_mm_unpackhi_pd(m_lanes, m_lanes));
+    }
+
+    friend IIRStereoSample operator+(IIRStereoSample a, IIRStereoSample b) {
+        return IIRStereoSample(_mm_add_pd(a.m_lanes, b.m_lanes));
+    }
+    friend IIRStereoSample operator-(IIRStereoSample a, IIRStereoSample b) {
+        return IIRStereoSample(_mm_sub_pd(a.m_lanes, b.m_lanes));
+    }
+    friend IIRStereoSample operator-(IIRStereoSample a) {
+        // Flip the sign bits like the scalar negation
+        return IIRStereoSample(_mm_xor_pd(a.m_lanes, _mm_set1_pd(-0.0)));
+    }
+    friend IIRStereoSample operator*(IIRStereoSample a, double b) {
+        return IIRStereoSample(_mm_mul_pd(a.m_lanes, _mm_set1_pd(b)));
+    }
+
+  private:
+    explicit IIRStereoSample(__m128d lanes)
+            : m_lanes(lanes) {
+    }
+
+    __m128d m_lanes;
+#else
+    IIRStereoSample(double left, double right)
+            : m_left(left),
+              m_right(right) {
+    }
+
+    double left() const {
+        return m_left;
+    }
+    double right() const {
+        return m_right;
+    }
+
+    friend IIRStereoSample operator+(IIRStereoSample a, IIRStereoSample b) {
+        return IIRStereoSample(a.m_left + b.m_left, a.m_right + b.m_right);
+    }
+    friend IIRStereoSample operator-(IIRStereoSample a, IIRStereoSample b) {
+        return IIRStereoSample(a.m_left - b.m_left, a.m_right - b.m_right);
+    }
+    friend IIRStereoSample operator-(IIRStereoSample a) {
+        return IIRStereoSample(-a.m_left, -a.m_right);
+    }
+    friend IIRStereoSample operator*(IIRStereoSample a, double b) {
+        return IIRStereoSample(a.m_left * b, a.m_right * b);
+    }
+
+  private:
+    double m_left;
+    double m_right;
+#endif
+
+  public:
+    friend IIRStereoSample operator*(double a, IIRStereoSample b) {
+        return b * a;
+    }
+    IIRStereoSample& operator+=(IIRStereoSample other) {
+        return *this = *this + other;
+    }
+    IIRStereoSample& operator-=(IIRStereoSample other) {
+        return *this = *this - other;
+    }
+};
+
 class EngineFilterIIRBase : public EngineObjectConstIn {
   public:
     virtual void assumeSettled() = 0;
@@ -83,11 +170,9 @@ class EngineFilterIIR : public EngineFilterIIRBase {
 
     void initBuffers() {
         // Copy the current buffers into the old buffers
-        memcpy(m_oldBuf1, m_buf1, sizeof(m_buf1));
-        memcpy(m_oldBuf2, m_buf2, sizeof(m_buf2));
+        memcpy(m_oldBuf, m_buf, sizeof(m_buf));
         // Set the current buffers to 0
-        memset(m_buf1, 0, sizeof(m_buf1));
-        memset(m_buf2, 0, sizeof(m_buf2));
+        memset(m_buf, 0, sizeof(m_buf));
         m_doRamping = true;
     }
 
@@ -232,8 +317,10 @@ class EngineFilterIIR : public EngineFilterIIRBase {
                          const int iBufferSize) {
         if (!m_doRamping) {
             for (int i = 0; i < iBufferSize; i += 2) {
-                pOutput[i] = static_cast<CSAMPLE>(processSample(m_coef, m_buf1, pIn[i]));
-                pOutput[i + 1] = static_cast<CSAMPLE>(processSample(m_coef, m_buf2, pIn[i + 1]));
+                const IIRStereoSample out = processSample(
+                        m_coef, m_buf, IIRStereoSample(pIn[i], pIn[i + 1]));
+                pOutput[i] = static_cast<CSAMPLE>(out.left());
+                pOutput[i + 1] = static_cast<CSAMPLE>(out.right());
             }
         } else {
             double cross_mix = 0.0;
@@ -250,12 +337,14 @@ class EngineFilterIIR : public EngineFilterIIRBase {
                 // of the new filter but it turns out that this produces
                 // a gain drop due to the filter delay which is more
                 // conspicuous than the settling noise.
+                const IIRStereoSample in(pIn[i], pIn[i + 1]);
                 double old1;
                 double old2;
                 if (!m_doStart) {
                     // Process old filter, but only if we do not do a fresh start
-                    old1 = static_cast<CSAMPLE>(processSample(m_oldCoef, m_oldBuf1, pIn[i]));
-                    old2 = static_cast<CSAMPLE>(processSample(m_oldCoef, m_oldBuf2, pIn[i + 1]));
+                    const IIRStereoSample old = processSample(m_oldCoef, m_oldBuf, in);
+                    old1 = static_cast<CSAMPLE>(old.left());
+                    old2 = static_cast<CSAMPLE>(old.right());
                 } else {
                     if (m_startFromDry) {
                         old1 = pIn[i];
@@ -265,8 +354,9 @@ class EngineFilterIIR : public EngineFilterIIRBase {
                         old2 = 0;
                     }
                 }
-                double new1 = static_cast<CSAMPLE>(processSample(m_coef, m_buf1, pIn[i]));
-                double new2 = static_cast<CSAMPLE>(processSample(m_coef, m_buf2, pIn[i + 1]));
+                const IIRStereoSample out = processSample(m_coef, m_buf, in);
+                double new1 = static_cast<CSAMPLE>(out.left());
+                double new2 = static_cast<CSAMPLE>(out.right());
 
                 if (i < iBufferSize / 2) {
                     pOutput[i] = static_cast<CSAMPLE>(old1);
@@ -284,11 +374,13 @@ class EngineFilterIIR : public EngineFilterIIRBase {
     }
 
   protected:
-    inline double processSample(double* coef, double* buf, double val);
+    /// Sample is IIRStereoSample to filter both channels at once, or double
+    /// to filter a single channel.
+    template<typename Sample>
+    inline Sample processSample(const double* coef, Sample* buf, Sample val);
     inline void pauseFilterInner() {
         // Set the current buffers to 0
-        memset(m_buf1, 0, sizeof(m_buf1));
-        memset(m_buf2, 0, sizeof(m_buf2));
+        memset(m_buf, 0, sizeof(m_buf));
         m_doRamping = true;
         m_doStart = true;
     }
@@ -297,15 +389,11 @@ class EngineFilterIIR : public EngineFilterIIRBase {
     // Old coefficients needed for ramping
     double m_oldCoef[SIZE + 1];
 
-    // Channel 1 state
-    double m_buf1[SIZE];
-    // Old channel 1 buffer needed for ramping
-    double m_oldBuf1[SIZE];
-
-    // Channel 2 state
-    double m_buf2[SIZE];
-    // Old channel 2 buffer needed for ramping
-    double m_oldBuf2[SIZE];
+    // State of both channels, each element holds the values of
+    // both channels to process them together
+    IIRStereoSample m_buf[SIZE];
+    // Old buffer needed for ramping
+    IIRStereoSample m_oldBuf[SIZE];
 
     // Flag set to true if ramping needs to be done
     bool m_doRamping;
@@ -316,10 +404,10 @@ class EngineFilterIIR : public EngineFilterIIRBase {
 };
 
 template<>
-inline double EngineFilterIIR<2, IIR_LP>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-    double tmp, fir, iir;
+template<typename Sample>
+inline Sample EngineFilterIIR<2, IIR_LP>::processSample(
+        const double* coef, Sample* buf, Sample val) {
+    Sample tmp, fir, iir;
     tmp = buf[0]; buf[0] = buf[1];
     iir = val * coef[0];
     iir -= coef[1] * tmp; fir = tmp;
@@ -330,10 +418,10 @@ inline double EngineFilterIIR<2, IIR_LP>::processSample(double* coef,
 }
 
 template<>
-inline double EngineFilterIIR<2, IIR_BP>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-    double tmp, fir, iir;
+template<typename Sample>
+inline Sample EngineFilterIIR<2, IIR_BP>::processSample(
+        const double* coef, Sample* buf, Sample val) {
+    Sample tmp, fir, iir;
     tmp = buf[0]; buf[0] = buf[1];
     iir = val * coef[0];
     iir -= coef[1] * tmp; fir = -tmp;
@@ -344,10 +432,10 @@ inline double EngineFilterIIR<2, IIR_BP>::processSample(double* coef,
 }
 
 template<>
-inline double EngineFilterIIR<2, IIR_HP>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-    double tmp, fir, iir;
+template<typename Sample>
+inline Sample EngineFilterIIR<2, IIR_HP>::processSample(
+        const double* coef, Sample* buf, Sample val) {
+    Sample tmp, fir, iir;
     tmp = buf[0]; buf[0] = buf[1];
     iir = val * coef[0];
     iir -= coef[1] * tmp; fir = tmp;
@@ -358,10 +446,10 @@ inline double EngineFilterIIR<2, IIR_HP>::processSample(double* coef,
 }
 
 template<>
-inline double EngineFilterIIR<4, IIR_LP>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-    double tmp, fir, iir;
+template<typename Sample>
+inline Sample EngineFilterIIR<4, IIR_LP>::processSample(
+        const double* coef, Sample* buf, Sample val) {
+    Sample tmp, fir, iir;
     tmp = buf[0]; buf[0] = buf[1]; buf[1] = buf[2]; buf[2] = buf[3];
     iir = val * coef[0];
     iir -= coef[1] * tmp; fir = tmp;
@@ -377,10 +465,10 @@ inline double EngineFilterIIR<4, IIR_LP>::processSample(double* coef,
 }
 
 template<>
-inline double EngineFilterIIR<8, IIR_BP>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-    double tmp, fir, iir;
+template<typename Sample>
+inline Sample EngineFilterIIR<8, IIR_BP>::processSample(
+        const double* coef, Sample* buf, Sample val) {
+    Sample tmp, fir, iir;
     tmp = buf[0]; buf[0] = buf[1]; buf[1] = buf[2]; buf[2] = buf[3];
     buf[3] = buf[4]; buf[4] = buf[5]; buf[5] = buf[6]; buf[6] = buf[7];
     iir = val * coef[0];
@@ -407,10 +495,10 @@ inline double EngineFilterIIR<8, IIR_BP>::processSample(double* coef,
 }
 
 template<>
-inline double EngineFilterIIR<4, IIR_HP>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-    double tmp, fir, iir;
+template<typename Sample>
+inline Sample EngineFilterIIR<4, IIR_HP>::processSample(
+        const double* coef, Sample* buf, Sample val) {
+    Sample tmp, fir, iir;
     tmp = buf[0]; buf[0] = buf[1]; buf[1] = buf[2]; buf[2] = buf[3];
     iir= val * coef[0];
     iir -= coef[1] * tmp; fir = tmp;
@@ -426,10 +514,10 @@ inline double EngineFilterIIR<4, IIR_HP>::processSample(double* coef,
 }
 
 template<>
-inline double EngineFilterIIR<8, IIR_LP>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-    double tmp, fir, iir;
+template<typename Sample>
+inline Sample EngineFilterIIR<8, IIR_LP>::processSample(
+        const double* coef, Sample* buf, Sample val) {
+    Sample tmp, fir, iir;
     tmp = buf[0]; buf[0] = buf[1]; buf[1] = buf[2]; buf[2] = buf[3];
     buf[3] = buf[4]; buf[4] = buf[5]; buf[5] = buf[6]; buf[6] = buf[7];
     iir = val * coef[0];
@@ -456,10 +544,10 @@ inline double EngineFilterIIR<8, IIR_LP>::processSample(double* coef,
 }
 
 template<>
-inline double EngineFilterIIR<16, IIR_BP>::processSample(double* coef,
-                                                         double* buf,
-                                                         double val) {
-    double tmp, fir, iir;
+template<typename Sample>
+inline Sample EngineFilterIIR<16, IIR_BP>::processSample(
+        const double* coef, Sample* buf, Sample val) {
+    Sample tmp, fir, iir;
     tmp = buf[0]; buf[0] = buf[1]; buf[1] = buf[2]; buf[2] = buf[3];
     buf[3] = buf[4]; buf[4] = buf[5]; buf[5] = buf[6]; buf[6] = buf[7];
     buf[7] = buf[8]; buf[8] = buf[9]; buf[9] = buf[10]; buf[10] = buf[11];
@@ -508,10 +596,10 @@ inline double EngineFilterIIR<16, IIR_BP>::processSample(double* coef,
 }
 
 template<>
-inline double EngineFilterIIR<8, IIR_HP>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-    double tmp, fir, iir;
+template<typename Sample>
+inline Sample EngineFilterIIR<8, IIR_HP>::processSample(
+        const double* coef, Sample* buf, Sample val) {
+    Sample tmp, fir, iir;
     tmp = buf[0]; buf[0] = buf[1]; buf[1] = buf[2]; buf[2] = buf[3];
     buf[3] = buf[4]; buf[4] = buf[5]; buf[5] = buf[6]; buf[6] = buf[7];
     iir = val * coef[0];
@@ -539,10 +627,10 @@ inline double EngineFilterIIR<8, IIR_HP>::processSample(double* coef,
 
 // IIR_LP and IIR_HP use the same processSample routine
 template<>
-inline double EngineFilterIIR<5, IIR_BP>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-    double tmp, fir, iir;
+template<typename Sample>
+inline Sample EngineFilterIIR<5, IIR_BP>::processSample(
+        const double* coef, Sample* buf, Sample val) {
+    Sample tmp, fir, iir;
     tmp = buf[0]; buf[0] = buf[1];
     iir = val * coef[0];
     iir -= coef[1] * tmp; fir = coef[2] * tmp;
@@ -553,10 +641,10 @@ inline double EngineFilterIIR<5, IIR_BP>::processSample(double* coef,
 }
 
 template<>
-inline double EngineFilterIIR<4, IIR_LPMO>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-   double tmp, fir, iir;
+template<typename Sample>
+inline Sample EngineFilterIIR<4, IIR_LPMO>::processSample(
+        const double* coef, Sample* buf, Sample val) {
+   Sample tmp, fir, iir;
    tmp= buf[0]; buf[0] = buf[1]; buf[1] = buf[2]; buf[2] = buf[3];
    iir= val * coef[0];
    iir -= coef[1]*tmp; fir= tmp;
@@ -579,10 +667,10 @@ inline double EngineFilterIIR<4, IIR_LPMO>::processSample(double* coef,
 
 
 template<>
-inline double EngineFilterIIR<4, IIR_HPMO>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-   double tmp, fir, iir;
+template<typename Sample>
+inline Sample EngineFilterIIR<4, IIR_HPMO>::processSample(
+        const double* coef, Sample* buf, Sample val) {
+   Sample tmp, fir, iir;
    tmp= buf[0]; buf[0] = buf[1]; buf[1] = buf[2]; buf[2] = buf[3];
    iir= val * coef[0];
    iir -= coef[1]*tmp; fir= -tmp;
@@ -604,10 +692,10 @@ inline double EngineFilterIIR<4, IIR_HPMO>::processSample(double* coef,
 }
 
 template<>
-inline double EngineFilterIIR<2, IIR_LP2>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-    double tmp, fir, iir;
+template<typename Sample>
+inline Sample EngineFilterIIR<2, IIR_LP2>::processSample(
+        const double* coef, Sample* buf, Sample val) {
+    Sample tmp, fir, iir;
     tmp = buf[0];
     iir = val * coef[0];
     iir -= coef[1] * tmp; fir = tmp;
@@ -625,10 +713,10 @@ inline double EngineFilterIIR<2, IIR_LP2>::processSample(double* coef,
 
 
 template<>
-inline double EngineFilterIIR<2, IIR_HP2>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-    double tmp, fir, iir;
+template<typename Sample>
+inline Sample EngineFilterIIR<2, IIR_HP2>::processSample(
+        const double* coef, Sample* buf, Sample val) {
+    Sample tmp, fir, iir;
     tmp = buf[0];
     iir = val * -coef[0]; // swap gain to be in phase with LP2
     iir -= coef[1] * tmp; fir = -tmp;
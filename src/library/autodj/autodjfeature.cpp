@@ -235,15 +235,37 @@ void AutoDJFeature::slotCrateChanged(CrateId crateId) {
 
 void AutoDJFeature::slotAddRandomTrack() {
     if (m_iAutoDJPlaylistId >= 0) {
-        TrackPointer pRandomTrack;
+        // Continue with a track that mixes well with the last queued track
+        TrackId referenceTrackId;
+        QSet<TrackId> queuedTrackIds;
+        if (m_crateList.isEmpty() &&
+                m_pConfig->getValue(ConfigKey("[Auto DJ]", "UseSimilarTracks"), false)) {
+            const QList<TrackId> trackIds = m_playlistDao.getTrackIds(m_iAutoDJPlaylistId);
+            if (!trackIds.isEmpty()) {
+                referenceTrackId = trackIds.last();
+                queuedTrackIds = QSet<TrackId>(trackIds.begin(), trackIds.end());
+            }
+        }
+        TrackId existingTrackId;
         for (int failedRetrieveAttempts = 0;
-                !pRandomTrack && (failedRetrieveAttempts < 2 * kMaxRetrieveAttempts); // 2 rounds
+                !existingTrackId.isValid() &&
+                (failedRetrieveAttempts < 2 * kMaxRetrieveAttempts); // 2 rounds
                 ++failedRetrieveAttempts) {
             TrackId randomTrackId;
             if (m_crateList.isEmpty()) {
-                // Fetch Track from Library since we have no assigned crates
-                randomTrackId = m_autoDjCratesDao.getRandomTrackIdFromLibrary(
-                        m_iAutoDJPlaylistId);
+                if (referenceTrackId.isValid() &&
+                        failedRetrieveAttempts < kMaxRetrieveAttempts) {
+                    randomTrackId = m_autoDjCratesDao.getSimilarTrackIdFromLibrary(
+                            referenceTrackId, queuedTrackIds);
+                }
+                if (randomTrackId.isValid()) {
+                    // Don't pick it again if the file is missing
+                    queuedTrackIds.insert(randomTrackId);
+                } else {
+                    // Fetch Track from Library since we have no assigned crates
+                    randomTrackId = m_autoDjCratesDao.getRandomTrackIdFromLibrary(
+                            m_iAutoDJPlaylistId);
+                }
             } else {
                 // Fetch track from crates.
                 // We do not fall back to Library if this fails because this
@@ -252,23 +274,29 @@ void AutoDJFeature::slotAddRandomTrack() {
             }
 
             if (randomTrackId.isValid()) {
-                pRandomTrack = m_pLibrary->trackCollectionManager()->getTrackById(randomTrackId);
-                VERIFY_OR_DEBUG_ASSERT(pRandomTrack) {
+                // Only the file is checked, which doesn't need a Track object
+                const TrackSnapshotList snapshots =
+                        m_pLibrary->trackCollectionManager()->getTrackSnapshots(
+                                QList<TrackId>{randomTrackId});
+                VERIFY_OR_DEBUG_ASSERT(!snapshots.isEmpty()) {
                     qWarning() << "Track does not exist:"
                             << randomTrackId;
                     continue;
                 }
-                if (!pRandomTrack->getFileInfo().checkFileExists()) {
+                const TrackSnapshot& randomTrack = snapshots.first();
+                if (randomTrack.fileInfo().checkFileExists()) {
+                    existingTrackId = randomTrackId;
+                } else {
                     qWarning() << "Track does not exist:"
-                               << pRandomTrack->getInfo()
-                               << pRandomTrack->getFileInfo();
-                    pRandomTrack.reset();
+                               << randomTrack.artist
+                               << randomTrack.title
+                               << randomTrack.fileInfo();
                 }
             }
         }
-        if (pRandomTrack) {
+        if (existingTrackId.isValid()) {
             m_pTrackCollection->getPlaylistDAO().appendTrackToPlaylist(
-                    pRandomTrack->getId(), m_iAutoDJPlaylistId);
+                    existingTrackId, m_iAutoDJPlaylistId);
             m_pAutoDJView->onShow();
             return; // success
         }
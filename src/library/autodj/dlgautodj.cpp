@@ -358,11 +358,11 @@ void DlgAutoDJ::updateSelectionInfo() {
 
     QModelIndexList indices = m_pTrackTableView->selectionModel()->selectedRows();
 
-    for (int i = 0; i < indices.size(); ++i) {
-        TrackPointer pTrack = m_pAutoDJTableModel->getTrack(indices.at(i));
-        if (pTrack) {
-            duration += pTrack->getDuration();
-        }
+    // Selecting all tracks of a long playlist would otherwise
+    // create a Track object for each of them
+    const TrackSnapshotList tracks = m_pAutoDJTableModel->getTrackSnapshots(indices);
+    for (const auto& track : tracks) {
+        duration += track.durationSeconds;
     }
 
     QString label;
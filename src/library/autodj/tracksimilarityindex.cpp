@@ -0,0 +1,311 @@
+#include "library/autodj/tracksimilarityindex.h"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#include "track/keyutils.h"
+#include "track/replaygain.h"
+#include "util/assert.h"
+#include "util/math.h"
+
+namespace {
+
+// Bucket 0 is reserved for tracks without a BPM, faster tracks are
+// collected in the last bucket
+constexpr int kBucketCount = 301;
+
+constexpr int kKeyCount = mixxx::track::io::key::ChromaticKey_ARRAYSIZE;
+
+// The weights of the distance components. A tempo deviation of 1%
+// weighs as much as a single step on the Circle of Fifths, a difference
+// of 2 dB or a duration that differs by a factor of 2^(1/4).
+constexpr float kTempoWeightPerPercent = 1.0f;
+constexpr float kKeyWeightPerStep = 1.0f;
+constexpr float kGainWeightPerDb = 0.5f;
+constexpr float kDurationWeightPerOctave = 4.0f;
+
+// Mixing at half or double tempo is possible, but not preferred
+constexpr float kHalfOrDoubleTempoPenalty = 2.0f;
+
+// Missing features are treated like an average mismatch
+constexpr float kUnknownTempoDistance = 8.0f;
+constexpr float kUnknownKeyDistance = 3.0f;
+constexpr float kUnknownGainDistance = 2.0f;
+constexpr float kUnknownDurationDistance = 1.0f;
+
+// The distances between all pairs of keys, -1 if either key is invalid
+const std::array<std::array<qint8, kKeyCount>, kKeyCount>& keyDistances() {
+    static const auto s_keyDistances = [] {
+        std::array<std::array<qint8, kKeyCount>, kKeyCount> keyDistances;
+        for (int i = 0; i < kKeyCount; ++i) {
+            for (int j = 0; j < kKeyCount; ++j) {
+                keyDistances[i][j] = static_cast<qint8>(KeyUtils::circleOfFifthsDistance(
+                        static_cast<mixxx::track::io::key::ChromaticKey>(i),
+                        static_cast<mixxx::track::io::key::ChromaticKey>(j)));
+            }
+        }
+        return keyDistances;
+    }();
+    return s_keyDistances;
+}
+
+// The relative deviation of the tempo in percent
+float tempoDeviation(float bpm, float referenceBpm) {
+    return std::abs(bpm - referenceBpm) / referenceBpm * 100.0f;
+}
+
+// A lower bound of tempoDeviation() for all tracks in the bucket
+float bucketTempoDeviation(int bucket, float referenceBpm) {
+    if (bucket > referenceBpm) {
+        return tempoDeviation(static_cast<float>(bucket), referenceBpm);
+    }
+    if (bucket + 1 < referenceBpm) {
+        return tempoDeviation(static_cast<float>(bucket + 1), referenceBpm);
+    }
+    return 0.0f;
+}
+
+using Candidate = std::pair<float, TrackId>;
+
+bool closerThan(const Candidate& lhs, const Candidate& rhs) {
+    return lhs.first < rhs.first;
+}
+
+} // anonymous namespace
+
+TrackSimilarityIndex::TrackSimilarityIndex()
+        : m_buckets(kBucketCount) {
+}
+
+void TrackSimilarityIndex::clear() {
+    for (auto& bucket : m_buckets) {
+        bucket.clear();
+    }
+    m_locations.clear();
+}
+
+// static
+TrackSimilarityIndex::Entry TrackSimilarityIndex::makeEntry(
+        TrackId trackId, const Features& features) {
+    Entry entry;
+    entry.trackId = trackId;
+    entry.bpm = features.bpm > 0.0 ? static_cast<float>(features.bpm) : 0.0f;
+    entry.hasGain = mixxx::ReplayGain::isValidRatio(features.replayGainRatio);
+    entry.gainDb = entry.hasGain
+            ? static_cast<float>(ratio2db(features.replayGainRatio))
+            : 0.0f;
+    entry.hasDuration = features.durationSeconds > 0.0;
+    entry.log2Duration = entry.hasDuration
+            ? static_cast<float>(std::log2(features.durationSeconds))
+            : 0.0f;
+    entry.key = mixxx::track::io::key::ChromaticKey_IsValid(features.key)
+            ? static_cast<qint8>(features.key)
+            : static_cast<qint8>(mixxx::track::io::key::INVALID);
+    return entry;
+}
+
+// static
+int TrackSimilarityIndex::bucketOf(const Entry& entry) {
+    if (entry.bpm <= 0.0f) {
+        return 0;
+    }
+    return math_clamp(static_cast<int>(entry.bpm), 1, kBucketCount - 1);
+}
+
+// static
+float TrackSimilarityIndex::tempoDistance(const Entry& lhs, const Entry& rhs) {
+    if (lhs.bpm <= 0.0f || rhs.bpm <= 0.0f) {
+        return kUnknownTempoDistance;
+    }
+    const float deviation = tempoDeviation(lhs.bpm, rhs.bpm);
+    const float halfOrDoubleDeviation = std::min(
+            tempoDeviation(lhs.bpm, rhs.bpm * 2.0f),
+            tempoDeviation(lhs.bpm, rhs.bpm * 0.5f));
+    return std::min(deviation,
+                   halfOrDoubleDeviation + kHalfOrDoubleTempoPenalty) *
+            kTempoWeightPerPercent;
+}
+
+// static
+float TrackSimilarityIndex::nonTempoDistance(const Entry& lhs, const Entry& rhs) {
+    float distance = 0.0f;
+    const qint8 keyDistance = keyDistances()[lhs.key][rhs.key];
+    if (keyDistance < 0) {
+        distance += kUnknownKeyDistance;
+    } else {
+        distance += keyDistance * kKeyWeightPerStep;
+    }
+    if (lhs.hasGain && rhs.hasGain) {
+        distance += std::abs(lhs.gainDb - rhs.gainDb) * kGainWeightPerDb;
+    } else {
+        distance += kUnknownGainDistance;
+    }
+    if (lhs.hasDuration && rhs.hasDuration) {
+        distance += std::abs(lhs.log2Duration - rhs.log2Duration) *
+                kDurationWeightPerOctave;
+    } else {
+        distance += kUnknownDurationDistance;
+    }
+    return distance;
+}
+
+// static
+float TrackSimilarityIndex::distance(const Features& features, const Features& reference) {
+    const Entry entry = makeEntry(TrackId(), features);
+    const Entry referenceEntry = makeEntry(TrackId(), reference);
+    return tempoDistance(entry, referenceEntry) + nonTempoDistance(entry, referenceEntry);
+}
+
+void TrackSimilarityIndex::insert(TrackId trackId, const Features& features) {
+    VERIFY_OR_DEBUG_ASSERT(trackId.isValid()) {
+        return;
+    }
+    const Entry entry = makeEntry(trackId, features);
+    const int bucket = bucketOf(entry);
+    const auto it = m_locations.find(trackId);
+    if (it != m_locations.end()) {
+        if (it->bucket == bucket) {
+            m_buckets[bucket][it->index] = entry;
+            return;
+        }
+        remove(trackId);
+    }
+    m_buckets[bucket].push_back(entry);
+    m_locations.insert(trackId,
+            Location{bucket, static_cast<int>(m_buckets[bucket].size()) - 1});
+}
+
+void TrackSimilarityIndex::remove(TrackId trackId) {
+    const auto it = m_locations.find(trackId);
+    if (it == m_locations.end()) {
+        return;
+    }
+    const Location location = *it;
+    m_locations.erase(it);
+    auto& entries = m_buckets[location.bucket];
+    // Fill the gap with the last entry of the bucket
+    if (location.index != static_cast<int>(entries.size()) - 1) {
+        entries[location.index] = entries.back();
+        m_locations[entries[location.index].trackId].index = location.index;
+    }
+    entries.pop_back();
+}
+
+QList<TrackId> TrackSimilarityIndex::nearest(
+        TrackId referenceTrackId,
+        int maxCount,
+        const QSet<TrackId>& excludedTrackIds) const {
+    const auto it = m_locations.constFind(referenceTrackId);
+    if (it == m_locations.constEnd()) {
+        return QList<TrackId>();
+    }
+    return nearestEntries(m_buckets[it->bucket][it->index], maxCount, excludedTrackIds);
+}
+
+QList<TrackId> TrackSimilarityIndex::nearest(
+        const Features& reference,
+        int maxCount,
+        const QSet<TrackId>& excludedTrackIds) const {
+    return nearestEntries(makeEntry(TrackId(), reference), maxCount, excludedTrackIds);
+}
+
+QList<TrackId> TrackSimilarityIndex::nearestEntries(
+        const Entry& reference,
+        int maxCount,
+        const QSet<TrackId>& excludedTrackIds) const {
+    if (maxCount <= 0) {
+        return QList<TrackId>();
+    }
+
+    // Max-heap of the closest candidates found so far
+    std::vector<Candidate> candidates;
+    candidates.reserve(maxCount + 1);
+    const auto isFull = [&candidates, maxCount] {
+        return static_cast<int>(candidates.size()) >= maxCount;
+    };
+    const auto canImprove = [&candidates, &isFull](float lowerBound) {
+        return !isFull() || lowerBound < candidates.front().first;
+    };
+    const auto scanBucket = [&](int bucket) {
+        for (const auto& entry : m_buckets[bucket]) {
+            if (entry.trackId == reference.trackId ||
+                    excludedTrackIds.contains(entry.trackId)) {
+                continue;
+            }
+            const float distance = tempoDistance(entry, reference);
+            if (!canImprove(distance)) {
+                continue;
+            }
+            candidates.emplace_back(distance + nonTempoDistance(entry, reference),
+                    entry.trackId);
+            std::push_heap(candidates.begin(), candidates.end(), closerThan);
+            if (static_cast<int>(candidates.size()) > maxCount) {
+                std::pop_heap(candidates.begin(), candidates.end(), closerThan);
+                candidates.pop_back();
+            }
+        }
+    };
+
+    if (reference.bpm <= 0.0f) {
+        // Every track has the same tempo distance
+        for (int bucket = 0; bucket < kBucketCount; ++bucket) {
+            scanBucket(bucket);
+        }
+    } else {
+        std::array<bool, kBucketCount> visited{};
+        // Scan outwards from the reference tempo first, then from half
+        // and double of it, until the remaining buckets are too far away
+        const std::array<std::pair<float, float>, 3> tempoCenters = {{
+                {reference.bpm, 0.0f},
+                {reference.bpm * 2.0f, kHalfOrDoubleTempoPenalty},
+                {reference.bpm * 0.5f, kHalfOrDoubleTempoPenalty},
+        }};
+        for (const auto& [centerBpm, penalty] : tempoCenters) {
+            const int centerBucket = math_clamp(
+                    static_cast<int>(centerBpm), 1, kBucketCount - 1);
+            for (int radius = 0;; ++radius) {
+                const int lowerBucket = centerBucket - radius;
+                const int upperBucket = centerBucket + radius;
+                if (lowerBucket < 1 && upperBucket >= kBucketCount) {
+                    break;
+                }
+                bool anyBucketInRange = false;
+                for (const int bucket : {lowerBucket, upperBucket}) {
+                    if (bucket < 1 || bucket >= kBucketCount) {
+                        continue;
+                    }
+                    // The last bucket also contains all faster tracks
+                    const float lowerBound =
+                            (bucket == kBucketCount - 1 && bucket <= centerBpm)
+                            ? penalty * kTempoWeightPerPercent
+                            : (bucketTempoDeviation(bucket, centerBpm) + penalty) *
+                                    kTempoWeightPerPercent;
+                    if (!canImprove(lowerBound)) {
+                        continue;
+                    }
+                    anyBucketInRange = true;
+                    if (!visited[bucket]) {
+                        visited[bucket] = true;
+                        scanBucket(bucket);
+                    }
+                }
+                // The deviation only grows with the radius
+                if (!anyBucketInRange) {
+                    break;
+                }
+            }
+        }
+        if (canImprove(kUnknownTempoDistance)) {
+            scanBucket(0);
+        }
+    }
+
+    std::sort_heap(candidates.begin(), candidates.end(), closerThan);
+    QList<TrackId> trackIds;
+    trackIds.reserve(static_cast<int>(candidates.size()));
+    for (const auto& candidate : candidates) {
+        trackIds.append(candidate.second);
+    }
+    return trackIds;
+}
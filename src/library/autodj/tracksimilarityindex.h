@@ -0,0 +1,95 @@
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <vector>
+
+#include "proto/keys.pb.h"
+#include "track/trackid.h"
+
+/// An in-memory nearest-neighbour index of the library for finding tracks
+/// that mix well with a reference track.
+///
+/// Tracks are bucketed by their integer BPM. A query only visits the
+/// buckets around the reference tempo and around half and double of it,
+/// starting with the closest ones, and stops as soon as no remaining bucket
+/// could improve the current result. The distance combines the deviation
+/// of the tempo, the distance of the keys on the Circle of Fifths, the
+/// difference of the ReplayGain and the ratio of the durations.
+class TrackSimilarityIndex final {
+  public:
+    struct Features {
+        /// 0 if unknown
+        double bpm = 0.0;
+        mixxx::track::io::key::ChromaticKey key =
+                mixxx::track::io::key::INVALID;
+        /// The ReplayGain ratio, 0 if unknown
+        double replayGainRatio = 0.0;
+        /// 0 if unknown
+        double durationSeconds = 0.0;
+    };
+
+    TrackSimilarityIndex();
+
+    int size() const {
+        return m_locations.size();
+    }
+    bool contains(TrackId trackId) const {
+        return m_locations.contains(trackId);
+    }
+    void clear();
+
+    /// Inserts a new or replaces an existing track.
+    void insert(TrackId trackId, const Features& features);
+    void remove(TrackId trackId);
+
+    /// Returns up to maxCount tracks ordered by their distance, closest first.
+    /// The reference track itself is never returned and the result is empty
+    /// if it is not indexed. Without a BPM of the reference track all
+    /// buckets need to be scanned.
+    QList<TrackId> nearest(
+            TrackId referenceTrackId,
+            int maxCount,
+            const QSet<TrackId>& excludedTrackIds = QSet<TrackId>()) const;
+    QList<TrackId> nearest(
+            const Features& reference,
+            int maxCount,
+            const QSet<TrackId>& excludedTrackIds = QSet<TrackId>()) const;
+
+    /// The distance of a track from the reference track, 0 for identical
+    /// features. The tempo deviation is relative to the reference.
+    static float distance(const Features& features, const Features& reference);
+
+  private:
+    // Compact representation for scanning the buckets
+    struct Entry {
+        TrackId trackId;
+        float bpm;
+        float gainDb;
+        float log2Duration;
+        qint8 key;
+        bool hasGain;
+        bool hasDuration;
+    };
+
+    struct Location {
+        int bucket;
+        int index;
+    };
+
+    static Entry makeEntry(TrackId trackId, const Features& features);
+    static int bucketOf(const Entry& entry);
+    static float tempoDistance(const Entry& lhs, const Entry& rhs);
+    // All components except the tempo
+    static float nonTempoDistance(const Entry& lhs, const Entry& rhs);
+
+    QList<TrackId> nearestEntries(
+            const Entry& reference,
+            int maxCount,
+            const QSet<TrackId>& excludedTrackIds) const;
+
+    // Bucket 0 contains all tracks without a BPM
+    std::vector<std::vector<Entry>> m_buckets;
+    QHash<TrackId, Location> m_locations;
+};
@@ -1,6 +1,8 @@
 #include "library/basesqltablemodel.h"
 
+#include <QRegularExpression>
 #include <QUrl>
+#include <QtConcurrentRun>
 #include <QtDebug>
 #include <algorithm>
 
@@ -17,6 +19,8 @@
 #include "util/assert.h"
 #include "util/datetime.h"
 #include "util/db/dbconnection.h"
+#include "util/db/dbconnectionpooled.h"
+#include "util/db/dbconnectionpooler.h"
 #include "util/duration.h"
 #include "util/performancetimer.h"
 #include "util/platform.h"
@@ -45,10 +49,12 @@ BaseSqlTableModel::BaseSqlTableModel(
         : BaseTrackTableModel(parent, pTrackCollectionManager, settingsNamespace),
           m_pTrackCollectionManager(pTrackCollectionManager),
           m_database(pTrackCollectionManager->internalCollection()->database()),
-          m_bInitialized(false) {
+          m_bInitialized(false),
+          m_pPendingSelect(nullptr) {
 }
 
 BaseSqlTableModel::~BaseSqlTableModel() {
+    cancelPendingSelect();
 }
 
 void BaseSqlTableModel::initHeaderProperties() {
@@ -192,65 +198,80 @@ void BaseSqlTableModel::replaceRows(
     }
 }
 
-void BaseSqlTableModel::select() {
-    if (!m_bInitialized) {
-        return;
-    }
-    // We should be able to detect when a select() would be a no-op. The DAO's
-    // do not currently broadcast signals for when common things happen. In the
-    // future, we can turn this check on and avoid a lot of needless
-    // select()'s. rryan 9/2011
-    // if (!m_bDirty) {
-    //     if (sDebug) {
-    //         qDebug() << this << "Skipping non-dirty select()";
-    //     }
-    //     return;
-    // }
+QString BaseSqlTableModel::selectQueryString() const {
+    // Prepare query for id and all columns not in m_trackSource
+    return QString("SELECT %1 FROM %2 %3")
+            .arg(m_tableColumns.join(","), m_tableName, m_tableOrderBy);
+}
 
-    if (sDebug) {
-        qDebug() << this << "select()";
+QStringList BaseSqlTableModel::tempViewStatements() const {
+    // Temporary views only exist on the connection that created them.
+    // SQLite stores their definition without the TEMPORARY keyword.
+    QSqlQuery query(m_database);
+    query.setForwardOnly(true);
+    if (!query.prepare(QStringLiteral(
+                "SELECT name,sql FROM sqlite_temp_master "
+                "WHERE type='view' ORDER BY rowid")) ||
+            !query.exec()) {
+        LOG_FAILED_QUERY(query);
+        return QStringList();
     }
+    // A pooled connection may still have views with the same names from
+    // a previous select, e.g. of another playlist. They are dropped first,
+    // because their definition may have changed since.
+    const QRegularExpression createView(QStringLiteral("^CREATE VIEW "));
+    QStringList dropStatements;
+    QStringList createStatements;
+    while (query.next()) {
+        QString name = query.value(0).toString();
+        name.replace(QChar('"'), QStringLiteral("\"\""));
+        dropStatements.prepend(
+                QStringLiteral("DROP VIEW IF EXISTS temp.\"%1\"").arg(name));
+        QString statement = query.value(1).toString();
+        statement.replace(createView,
+                QStringLiteral("CREATE TEMPORARY VIEW "));
+        createStatements.append(statement);
+    }
+    return dropStatements + createStatements;
+}
 
-    PerformanceTimer time;
-    time.start();
-
-    // Prepare query for id and all columns not in m_trackSource
-    QString queryString = QString("SELECT %1 FROM %2 %3")
-                                  .arg(m_tableColumns.join(","), m_tableName, m_tableOrderBy);
-
+// static
+BaseSqlTableModel::SelectResult BaseSqlTableModel::queryRows(
+        const QSqlDatabase& database,
+        const QString& queryString,
+        const QString& idColumnName,
+        int columnCount,
+        const std::atomic<bool>* pCanceled) {
     if (sDebug) {
-        qDebug() << this << "select() executing:" << queryString;
+        qDebug() << "BaseSqlTableModel executing:" << queryString;
     }
 
-    QSqlQuery query(m_database);
+    SelectResult result;
+    QSqlQuery query(database);
     // This causes a memory savings since QSqlCachedResult (what QtSQLite uses)
     // won't allocate a giant in-memory table that we won't use at all.
     query.setForwardOnly(true);
     if (!query.prepare(queryString)) {
         LOG_FAILED_QUERY(query);
-        return;
+        return result;
     }
     if (!query.exec()) {
         LOG_FAILED_QUERY(query);
-        return;
+        return result;
     }
 
-    // Remove all the rows from the table after(!) the query has been
-    // executed successfully. See Bug #1090888.
-    // TODO(rryan) we could edit the table in place instead of clearing it?
-    clearRows();
-
     // The size of the result set is not known in advance for a
     // forward-only query, so we cannot reserve memory for rows
     // in advance.
-    QVector<RowInfo> rowInfos;
-    QSet<TrackId> trackIds;
     int idColumn = -1;
     while (query.next()) {
+        if (pCanceled && pCanceled->load(std::memory_order_relaxed)) {
+            return result;
+        }
         QSqlRecord sqlRecord = query.record();
 
         if (idColumn < 0) {
-            idColumn = sqlRecord.indexOf(m_idColumn);
+            idColumn = sqlRecord.indexOf(idColumnName);
         }
 
         // TODO(XXX): Can we get rid of the hard-coded assumption that
@@ -260,30 +281,190 @@ void BaseSqlTableModel::select() {
         VERIFY_OR_DEBUG_ASSERT(idColumn >= 0) {
             qCritical()
                     << "ID column not available in database query results:"
-                    << m_idColumn;
-            return;
+                    << idColumnName;
+            return result;
         }
 
         TrackId trackId(sqlRecord.value(idColumn));
-        trackIds.insert(trackId);
+        result.trackIds.insert(trackId);
 
         RowInfo rowInfo;
         rowInfo.trackId = trackId;
         // current position defines the ordering
-        rowInfo.order = rowInfos.size();
+        rowInfo.order = result.rowInfos.size();
         rowInfo.metadata.reserve(sqlRecord.count());
-        for (int i = 0; i < m_tableColumns.size(); ++i) {
+        for (int i = 0; i < columnCount; ++i) {
             rowInfo.metadata.push_back(sqlRecord.value(i));
         }
-        rowInfos.push_back(rowInfo);
+        result.rowInfos.push_back(rowInfo);
     }
 
     if (sDebug) {
-        qDebug() << "Rows actually received:" << rowInfos.size();
+        qDebug() << "Rows actually received:" << result.rowInfos.size();
+    }
+    result.ok = true;
+    return result;
+}
+
+// static
+BaseSqlTableModel::SelectResult BaseSqlTableModel::queryRowsPooled(
+        const mixxx::DbConnectionPoolPtr& pDbConnectionPool,
+        const QStringList& tempViewStatements,
+        const QString& queryString,
+        const QString& idColumnName,
+        int columnCount,
+        const std::shared_ptr<std::atomic<bool>>& pCanceled) {
+    if (pCanceled->load()) {
+        return SelectResult();
+    }
+    // The pooler limits the lifetime of the thread-local connection
+    // and thereby of the temporary views created below.
+    const mixxx::DbConnectionPooler dbConnectionPooler(pDbConnectionPool);
+    const QSqlDatabase database = mixxx::DbConnectionPooled(pDbConnectionPool);
+    VERIFY_OR_DEBUG_ASSERT(database.isOpen()) {
+        return SelectResult();
     }
+    for (const auto& statement : tempViewStatements) {
+        QSqlQuery query(database);
+        if (!query.exec(statement)) {
+            LOG_FAILED_QUERY(query);
+            return SelectResult();
+        }
+    }
+    return queryRows(database, queryString, idColumnName, columnCount, pCanceled.get());
+}
+
+void BaseSqlTableModel::select() {
+    if (!m_bInitialized) {
+        return;
+    }
+    // We should be able to detect when a select() would be a no-op. The DAO's
+    // do not currently broadcast signals for when common things happen. In the
+    // future, we can turn this check on and avoid a lot of needless
+    // select()'s. rryan 9/2011
+    // if (!m_bDirty) {
+    //     if (sDebug) {
+    //         qDebug() << this << "Skipping non-dirty select()";
+    //     }
+    //     return;
+    // }
+
+    if (sDebug) {
+        qDebug() << this << "select()";
+    }
+
+    // The rows selected now are more recent than those of a pending select
+    cancelPendingSelect();
+
+    PerformanceTimer time;
+    time.start();
+
+    SelectResult result = queryRows(m_database,
+            selectQueryString(),
+            m_idColumn,
+            m_tableColumns.size(),
+            nullptr);
+    if (!result.ok) {
+        return;
+    }
+    applySelectResult(std::move(result));
+
+    qDebug() << this << "select() took" << time.elapsed().debugMillisWithUnit()
+             << m_rowInfo.size();
+    emit selectFinished();
+}
+
+void BaseSqlTableModel::selectAsync() {
+    if (!m_bInitialized) {
+        return;
+    }
+    const auto& pDbConnectionPool = m_pTrackCollectionManager->dbConnectionPool();
+    if (!pDbConnectionPool) {
+        select();
+        return;
+    }
+
+    if (sDebug) {
+        qDebug() << this << "selectAsync()";
+    }
+
+    cancelPendingSelect();
+    // Includes the time spent in the queue of the thread pool
+    m_pendingSelectTimer.start();
+
+    const QStringList statements = tempViewStatements();
+    const QString queryString = selectQueryString();
+    const QString idColumnName = m_idColumn;
+    const int columnCount = m_tableColumns.size();
+    auto pCanceled = std::make_shared<std::atomic<bool>>(false);
+    auto* pWatcher = new QFutureWatcher<SelectResult>(this);
+    connect(pWatcher,
+            &QFutureWatcher<SelectResult>::finished,
+            this,
+            &BaseSqlTableModel::slotSelectFinished);
+    m_pPendingSelect = pWatcher;
+    m_pPendingSelectCanceled = pCanceled;
+    pWatcher->setFuture(QtConcurrent::run(
+            [pDbConnectionPool,
+                    statements,
+                    queryString,
+                    idColumnName,
+                    columnCount,
+                    pCanceled] {
+                return queryRowsPooled(pDbConnectionPool,
+                        statements,
+                        queryString,
+                        idColumnName,
+                        columnCount,
+                        pCanceled);
+            }));
+}
+
+void BaseSqlTableModel::cancelPendingSelect() {
+    if (!m_pPendingSelect) {
+        return;
+    }
+    // The worker stops fetching rows and its result will be discarded
+    m_pPendingSelectCanceled->store(true);
+    m_pPendingSelectCanceled.reset();
+    m_pPendingSelect = nullptr;
+}
+
+void BaseSqlTableModel::slotSelectFinished() {
+    auto* pWatcher = static_cast<QFutureWatcher<SelectResult>*>(sender());
+    pWatcher->deleteLater();
+    if (pWatcher != m_pPendingSelect) {
+        // Superseded by a more recent select
+        return;
+    }
+    SelectResult result = pWatcher->result();
+    m_pPendingSelect = nullptr;
+    m_pPendingSelectCanceled.reset();
+    if (!result.ok) {
+        // e.g. the temporary view depends on objects that only exist
+        // on our own connection
+        qWarning() << this << "Failed to select rows in the background";
+        select();
+        return;
+    }
+    applySelectResult(std::move(result));
+
+    qDebug() << this << "selectAsync() took"
+             << m_pendingSelectTimer.elapsed().debugMillisWithUnit()
+             << "until the rows are visible" << m_rowInfo.size();
+    emit selectFinished();
+}
+
+void BaseSqlTableModel::applySelectResult(SelectResult&& result) {
+    QVector<RowInfo> rowInfos = std::move(result.rowInfos);
+
+    // Remove all the rows from the table after(!) the query has been
+    // executed successfully. See Bug #1090888.
+    // TODO(rryan) we could edit the table in place instead of clearing it?
+    clearRows();
 
     if (m_trackSource) {
-        m_trackSource->filterAndSort(trackIds,
+        m_trackSource->filterAndSort(result.trackIds,
                 m_currentSearch,
                 m_currentSearchFilter,
                 m_trackSourceOrderBy,
@@ -336,9 +517,6 @@ void BaseSqlTableModel::select() {
             std::move(trackIdToRows));
     // Both rowInfo and trackIdToRows (might) have been moved and
     // must not be used afterwards!
-
-    qDebug() << this << "select() took" << time.elapsed().debugMillisWithUnit()
-             << m_rowInfo.size();
 }
 
 void BaseSqlTableModel::setTable(const QString& tableName,
@@ -348,6 +526,8 @@ void BaseSqlTableModel::setTable(const QString& tableName,
     if (sDebug) {
         qDebug() << this << "setTable" << tableName << tableColumns << idColumn;
     }
+    // The results of a pending select belong to the previous table
+    cancelPendingSelect();
     m_tableName = tableName;
     m_idColumn = idColumn;
     m_tableColumns = tableColumns;
@@ -419,7 +599,7 @@ void BaseSqlTableModel::search(const QString& searchText, const QString& extraFi
         qDebug() << this << "search" << searchText;
     }
     setSearch(searchText, extraFilter);
-    select();
+    selectAsync();
 }
 
 void BaseSqlTableModel::setSort(int column, Qt::SortOrder order) {
@@ -564,7 +744,7 @@ void BaseSqlTableModel::sort(int column, Qt::SortOrder order) {
         qDebug() << this << "sort()" << column << order;
     }
     setSort(column, order);
-    select();
+    selectAsync();
 }
 
 int BaseSqlTableModel::rowCount(const QModelIndex& parent) const {
@@ -756,6 +936,16 @@ TrackPointer BaseSqlTableModel::getTrack(const QModelIndex& index) const {
     return m_pTrackCollectionManager->getTrackById(getTrackId(index));
 }
 
+TrackSnapshotList BaseSqlTableModel::getTrackSnapshots(
+        const QModelIndexList& indices) const {
+    QList<TrackId> trackIds;
+    trackIds.reserve(indices.size());
+    for (const auto& index : indices) {
+        trackIds.append(getTrackId(index));
+    }
+    return m_pTrackCollectionManager->getTrackSnapshots(trackIds);
+}
+
 TrackId BaseSqlTableModel::getTrackId(const QModelIndex& index) const {
     if (index.isValid()) {
         return TrackId(index.sibling(index.row(), fieldIndex(m_idColumn)).data());
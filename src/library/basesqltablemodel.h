@@ -1,13 +1,18 @@
 #pragma once
 
+#include <QFutureWatcher>
 #include <QHash>
 #include <QtSql>
+#include <atomic>
+#include <memory>
 
 #include "library/basetrackcache.h"
 #include "library/dao/trackdao.h"
 #include "library/basetracktablemodel.h"
 #include "library/columncache.h"
 #include "util/class.h"
+#include "util/db/dbconnectionpool.h"
+#include "util/performancetimer.h"
 
 class TrackCollectionManager;
 
@@ -47,6 +52,9 @@ class BaseSqlTableModel : public BaseTrackTableModel {
 
     TrackPointer getTrack(const QModelIndex& index) const override;
     TrackId getTrackId(const QModelIndex& index) const override;
+    /// Loads read-only snapshots of multiple rows at once instead of
+    /// creating a Track object for each row.
+    TrackSnapshotList getTrackSnapshots(const QModelIndexList& indices) const;
     QString getTrackLocation(const QModelIndex& index) const override;
 
     QUrl getTrackUrl(const QModelIndex& index) const override;
@@ -66,6 +74,9 @@ class BaseSqlTableModel : public BaseTrackTableModel {
     void hideTracks(const QModelIndexList& indices) override;
 
     void select() override;
+    bool isSelectPending() const override {
+        return m_pPendingSelect != nullptr;
+    }
 
     ///////////////////////////////////////////////////////////////////////////
     // Inherited from BaseTrackTableModel
@@ -75,6 +86,11 @@ class BaseSqlTableModel : public BaseTrackTableModel {
 
     QString modelKey(bool noSearch) const override;
 
+  signals:
+    // Emitted after the rows of a select have been replaced, either
+    // immediately by select() or later by a background select.
+    void selectFinished();
+
   protected:
     ///////////////////////////////////////////////////////////////////////////
     // Inherited from BaseTrackTableModel
@@ -108,6 +124,7 @@ class BaseSqlTableModel : public BaseTrackTableModel {
 
   private slots:
     void tracksChanged(const QSet<TrackId>& trackIds);
+    void slotSelectFinished();
 
   private:
     void setTrackValueForColumn(
@@ -136,6 +153,41 @@ class BaseSqlTableModel : public BaseTrackTableModel {
 
     typedef QHash<TrackId, QVector<int>> TrackId2Rows;
 
+    struct SelectResult {
+        QVector<RowInfo> rowInfos;
+        QSet<TrackId> trackIds;
+        bool ok = false;
+    };
+
+    QString selectQueryString() const;
+    QStringList tempViewStatements() const;
+
+    // Fetches the rows on the given connection. Returns early if
+    // pCanceled is set while fetching.
+    static SelectResult queryRows(
+            const QSqlDatabase& database,
+            const QString& queryString,
+            const QString& idColumnName,
+            int columnCount,
+            const std::atomic<bool>* pCanceled);
+    // Fetches the rows on a thread-local connection of the pool after
+    // dropping and re-creating the temporary views of the model's
+    // connection.
+    static SelectResult queryRowsPooled(
+            const mixxx::DbConnectionPoolPtr& pDbConnectionPool,
+            const QStringList& tempViewStatements,
+            const QString& queryString,
+            const QString& idColumnName,
+            int columnCount,
+            const std::shared_ptr<std::atomic<bool>>& pCanceled);
+
+    // Like select(), but the query is executed in a worker thread. The
+    // current rows stay visible until the results arrive. Any following
+    // select supersedes a pending one.
+    void selectAsync();
+    void cancelPendingSelect();
+    void applySelectResult(SelectResult&& result);
+
     void clearRows();
     void replaceRows(
             QVector<RowInfo>&& rows,
@@ -155,5 +207,9 @@ class BaseSqlTableModel : public BaseTrackTableModel {
     QVector<QHash<int, QVariant>> m_headerInfo;
     QString m_trackSourceOrderBy;
 
+    QFutureWatcher<SelectResult>* m_pPendingSelect;
+    std::shared_ptr<std::atomic<bool>> m_pPendingSelectCanceled;
+    PerformanceTimer m_pendingSelectTimer;
+
     DISALLOW_COPY_AND_ASSIGN(BaseSqlTableModel);
 };
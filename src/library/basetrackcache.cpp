@@ -8,6 +8,7 @@
 #include "track/keyutils.h"
 #include "track/track.h"
 #include "util/performancetimer.h"
+#include "util/stringpool.h"
 
 namespace {
 
@@ -263,6 +264,24 @@ bool BaseTrackCache::updateIndexWithQuery(const QString& queryString) {
     int numColumns = columnCount();
     int idColumn = query.record().indexOf(m_idColumn);
 
+    // Values that are shared by many tracks reference a single,
+    // interned string instead of a copy per row
+    QVector<bool> internedColumns(numColumns, false);
+    for (const auto column : {
+                 ColumnCache::COLUMN_LIBRARYTABLE_ARTIST,
+                 ColumnCache::COLUMN_LIBRARYTABLE_ALBUM,
+                 ColumnCache::COLUMN_LIBRARYTABLE_ALBUMARTIST,
+                 ColumnCache::COLUMN_LIBRARYTABLE_YEAR,
+                 ColumnCache::COLUMN_LIBRARYTABLE_GENRE,
+                 ColumnCache::COLUMN_LIBRARYTABLE_COMPOSER,
+                 ColumnCache::COLUMN_LIBRARYTABLE_GROUPING,
+                 ColumnCache::COLUMN_LIBRARYTABLE_FILETYPE}) {
+        const int index = fieldIndex(column);
+        if (index >= 0 && index < numColumns) {
+            internedColumns[index] = true;
+        }
+    }
+
     while (query.next()) {
         TrackId trackId(query.value(idColumn));
 
@@ -277,6 +296,13 @@ bool BaseTrackCache::updateIndexWithQuery(const QString& queryString) {
                 // Here we want to cache the display string with native separators.
                 QString location = query.value(i).toString();
                 record[i] = QDir::toNativeSeparators(location);
+            } else if (internedColumns[i]) {
+                const QVariant value = query.value(i);
+                if (value.userType() == QMetaType::QString) {
+                    record[i] = mixxx::StringPool::global().intern(value.toString());
+                } else {
+                    record[i] = value;
+                }
             } else {
                 record[i] = query.value(i);
             }
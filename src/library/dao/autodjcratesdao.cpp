@@ -4,6 +4,7 @@
 #include <QtDebug>
 #include <QtSql>
 
+#include "library/autodj/tracksimilarityindex.h"
 #include "library/dao/settingsdao.h"
 #include "library/dao/trackdao.h"
 #include "library/dao/trackschema.h"
@@ -50,6 +51,10 @@ constexpr int kLeastPreferredPercentMin = 0;
 constexpr int kLeastPreferredPercentMax = 50;
 #endif
 
+// The similar track is chosen randomly among the closest tracks to
+// avoid repeating the same sequence of tracks
+constexpr int kSimilarTrackCandidates = 5;
+
 int bounded_rand(int highest) {
     return QRandomGenerator::global()->bounded(highest);
 }
@@ -729,6 +734,23 @@ TrackId AutoDJCratesDAO::getRandomTrackIdFromAutoDj(int percentActive) {
 
 
 
+// Signaled by the track DAO when tracks are added to the library.
+void AutoDJCratesDAO::slotTracksAdded(const QSet<TrackId>& trackIds) {
+    updateSimilarityIndex(trackIds);
+}
+
+// Signaled by the track DAO when a track has been saved.
+void AutoDJCratesDAO::slotTrackClean(TrackId trackId) {
+    updateSimilarityIndex(QSet<TrackId>{trackId});
+}
+
+// Signaled by the track DAO when tracks are hidden or purged.
+void AutoDJCratesDAO::slotTracksRemoved(const QSet<TrackId>& trackIds) {
+    for (const auto& trackId : trackIds) {
+        m_pSimilarityIndex->remove(trackId);
+    }
+}
+
 // Signaled by the track DAO when a track's information is updated.
 void AutoDJCratesDAO::slotTrackDirty(TrackId trackId) {
     // Update our record of the number of times played, if that changed.
@@ -1254,3 +1276,97 @@ TrackId AutoDJCratesDAO::getRandomTrackIdFromLibrary(int iPlaylistId) {
         return TrackId();
     }
 }
+
+// Create the similarity index of all tracks in the library.
+void AutoDJCratesDAO::createAndConnectSimilarityIndex() {
+    m_pSimilarityIndex = std::make_unique<TrackSimilarityIndex>();
+    if (!updateSimilarityIndex(QSet<TrackId>())) {
+        return;
+    }
+    qDebug() << "Created the similarity index of"
+             << m_pSimilarityIndex->size() << "tracks for Auto DJ";
+
+    // Keep the index up to date. The features are read from the database,
+    // i.e. modified tracks are only updated after they have been saved.
+    connect(m_pTrackCollectionManager->internalCollection(),
+            &TrackCollection::tracksAdded,
+            this,
+            &AutoDJCratesDAO::slotTracksAdded);
+    connect(m_pTrackCollectionManager->internalCollection(),
+            &TrackCollection::trackClean,
+            this,
+            &AutoDJCratesDAO::slotTrackClean);
+    connect(m_pTrackCollectionManager->internalCollection(),
+            &TrackCollection::tracksRemoved,
+            this,
+            &AutoDJCratesDAO::slotTracksRemoved);
+}
+
+bool AutoDJCratesDAO::updateSimilarityIndex(const QSet<TrackId>& trackIds) {
+    // SELECT library.id, library.bpm, library.key_id, library.replaygain,
+    //     library.duration
+    // FROM library INNER JOIN track_locations
+    //     ON library.location = track_locations.id
+    // WHERE library.mixxx_deleted = 0 AND track_locations.fs_deleted = 0
+    //     [AND library.id IN (...)]
+    QString queryString = QStringLiteral(
+            "SELECT library.%1,library.%2,library.%3,library.%4,library.%5 "
+            "FROM library INNER JOIN track_locations "
+            "ON library.%6=track_locations.%7 "
+            "WHERE library.%8=0 AND track_locations.%9=0")
+                                  .arg(LIBRARYTABLE_ID,
+                                          LIBRARYTABLE_BPM,
+                                          LIBRARYTABLE_KEY_ID,
+                                          LIBRARYTABLE_REPLAYGAIN,
+                                          LIBRARYTABLE_DURATION,
+                                          LIBRARYTABLE_LOCATION,
+                                          TRACKLOCATIONSTABLE_ID,
+                                          LIBRARYTABLE_MIXXXDELETED,
+                                          TRACKLOCATIONSTABLE_FSDELETED);
+    if (!trackIds.isEmpty()) {
+        QStringList trackIdList;
+        trackIdList.reserve(trackIds.size());
+        for (const auto& trackId : trackIds) {
+            trackIdList.append(trackId.toString());
+        }
+        queryString += QStringLiteral(" AND library.%1 IN (%2)")
+                               .arg(LIBRARYTABLE_ID, trackIdList.join(QChar(',')));
+    }
+    QSqlQuery oQuery(m_database);
+    oQuery.setForwardOnly(true);
+    if (!oQuery.exec(queryString)) {
+        LOG_FAILED_QUERY(oQuery);
+        return false;
+    }
+    // Tracks that are not returned have been hidden or removed
+    QSet<TrackId> removedTrackIds = trackIds;
+    while (oQuery.next()) {
+        const TrackId trackId(oQuery.value(0));
+        TrackSimilarityIndex::Features features;
+        features.bpm = oQuery.value(1).toDouble();
+        features.key = static_cast<mixxx::track::io::key::ChromaticKey>(
+                oQuery.value(2).toInt());
+        features.replayGainRatio = oQuery.value(3).toDouble();
+        features.durationSeconds = oQuery.value(4).toDouble();
+        m_pSimilarityIndex->insert(trackId, features);
+        removedTrackIds.remove(trackId);
+    }
+    for (const auto& trackId : std::as_const(removedTrackIds)) {
+        m_pSimilarityIndex->remove(trackId);
+    }
+    return true;
+}
+
+TrackId AutoDJCratesDAO::getSimilarTrackIdFromLibrary(TrackId referenceTrackId,
+        const QSet<TrackId>& excludedTrackIds) {
+    if (!m_pSimilarityIndex) {
+        createAndConnectSimilarityIndex();
+    }
+    const QList<TrackId> trackIds = m_pSimilarityIndex->nearest(
+            referenceTrackId, kSimilarTrackCandidates, excludedTrackIds);
+    if (trackIds.isEmpty()) {
+        qDebug() << "No similar track available for Auto DJ";
+        return TrackId();
+    }
+    return trackIds[bounded_rand(trackIds.size())];
+}
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <QObject>
+#include <QSet>
 #include <QSqlDatabase>
+#include <memory>
 
 #include "library/trackset/crate/crateid.h"
 #include "preferences/usersettings.h"
@@ -10,6 +12,7 @@
 #include "util/class.h"
 
 class TrackCollectionManager;
+class TrackSimilarityIndex;
 
 class AutoDJCratesDAO : public QObject {
     Q_OBJECT
@@ -26,6 +29,12 @@ class AutoDJCratesDAO : public QObject {
     // Get random track Id from library
     TrackId getRandomTrackIdFromLibrary(int iPlaylistId);
 
+    // Get the ID of a track from the library that mixes well with the
+    // reference track, e.g. the last track in the auto-DJ playlist.
+    // Returns an invalid ID if the reference track is unknown.
+    TrackId getSimilarTrackIdFromLibrary(TrackId referenceTrackId,
+            const QSet<TrackId>& excludedTrackIds);
+
   private:
     // Disallow copy and assign.
     // (Isn't that normal for QObject subclasses?)
@@ -55,6 +64,14 @@ class AutoDJCratesDAO : public QObject {
     // auto-DJ-crates database.  Returns true if successful.
     bool updateLastPlayedDateTimeForTrack(TrackId trackId);
 
+    // Create the similarity index of all tracks in the library.
+    // Done the first time it's used, like the auto-DJ-crates database.
+    void createAndConnectSimilarityIndex();
+
+    // Read the features of the given tracks, or of all tracks if empty,
+    // into the similarity index.  Returns true if successful.
+    bool updateSimilarityIndex(const QSet<TrackId>& trackIds);
+
     // Calculates a random Track from AutoDJ,
     // This is used when all active tracks are already queued up.
     TrackId getRandomTrackIdFromAutoDj(int percentActive);
@@ -63,6 +80,11 @@ class AutoDJCratesDAO : public QObject {
     // Signaled by the track DAO when a track's information is updated.
     void slotTrackDirty(TrackId trackId);
 
+    // Signaled by the track DAO when tracks are added, saved or removed.
+    void slotTracksAdded(const QSet<TrackId>& trackIds);
+    void slotTrackClean(TrackId trackId);
+    void slotTracksRemoved(const QSet<TrackId>& trackIds);
+
     // Signaled by the crate DAO when a crate is added.
     void slotCrateInserted(CrateId crateId);
 
@@ -119,4 +141,8 @@ class AutoDJCratesDAO : public QObject {
 
     // The ID of every set-log playlist.
     QList<int> m_lstSetLogPlaylistIds;
+
+    // The nearest-neighbour index for similar tracks, or nullptr if it
+    // has not been created yet.
+    std::unique_ptr<TrackSimilarityIndex> m_pSimilarityIndex;
 };
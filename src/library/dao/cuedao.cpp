@@ -61,6 +61,30 @@ CuePointer cueFromRow(const QSqlRecord& row) {
     return pCue;
 }
 
+/// Only the last of multiple hot cues with the same number is kept.
+void removeDuplicateHotCues(QList<CuePointer>* pCues) {
+    QList<CuePointer> cues;
+    cues.reserve(pCues->size());
+    QMap<int, CuePointer> hotCuesByNumber;
+    for (const auto& pCue : qAsConst(*pCues)) {
+        int hotCueNumber = pCue->getHotCue();
+        if (hotCueNumber != Cue::kNoHotCue) {
+            const auto pDuplicateCue = hotCuesByNumber.take(hotCueNumber);
+            if (pDuplicateCue) {
+                kLogger.warning()
+                        << "Dropping hot cue"
+                        << pDuplicateCue->getId()
+                        << "with duplicate number"
+                        << hotCueNumber;
+                cues.removeOne(pDuplicateCue);
+            }
+            hotCuesByNumber.insert(hotCueNumber, pCue);
+        }
+        cues.push_back(pCue);
+    }
+    *pCues = std::move(cues);
+}
+
 } // namespace
 
 QList<CuePointer> CueDAO::getCuesForTrack(TrackId trackId) const {
@@ -81,30 +105,53 @@ QList<CuePointer> CueDAO::getCuesForTrack(TrackId trackId) const {
         DEBUG_ASSERT(!"failed query");
         return cues;
     }
-    QMap<int, CuePointer> hotCuesByNumber;
     while (query.next()) {
         CuePointer pCue = cueFromRow(query.record());
         VERIFY_OR_DEBUG_ASSERT(pCue) {
             continue;
         }
-        int hotCueNumber = pCue->getHotCue();
-        if (hotCueNumber != Cue::kNoHotCue) {
-            const auto pDuplicateCue = hotCuesByNumber.take(hotCueNumber);
-            if (pDuplicateCue) {
-                kLogger.warning()
-                        << "Dropping hot cue"
-                        << pDuplicateCue->getId()
-                        << "with duplicate number"
-                        << hotCueNumber;
-                cues.removeOne(pDuplicateCue);
-            }
-            hotCuesByNumber.insert(hotCueNumber, pCue);
-        }
         cues.push_back(pCue);
     }
+    removeDuplicateHotCues(&cues);
     return cues;
 }
 
+QHash<TrackId, QList<CuePointer>> CueDAO::getCuesForTracks(
+        const QList<TrackId>& trackIds) const {
+    QHash<TrackId, QList<CuePointer>> cuesByTrackId;
+    if (trackIds.isEmpty()) {
+        return cuesByTrackId;
+    }
+
+    QStringList idList;
+    idList.reserve(trackIds.size());
+    for (const auto& trackId : trackIds) {
+        idList << trackId.toString();
+    }
+
+    QSqlQuery query(m_database);
+    query.setForwardOnly(true);
+    query.prepare(QStringLiteral("SELECT * FROM " CUE_TABLE " WHERE track_id IN (%1)")
+                          .arg(idList.join(",")));
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+        DEBUG_ASSERT(!"failed query");
+        return cuesByTrackId;
+    }
+    const int trackIdColumn = query.record().indexOf("track_id");
+    while (query.next()) {
+        CuePointer pCue = cueFromRow(query.record());
+        VERIFY_OR_DEBUG_ASSERT(pCue) {
+            continue;
+        }
+        cuesByTrackId[TrackId(query.value(trackIdColumn))].push_back(pCue);
+    }
+    for (auto& cues : cuesByTrackId) {
+        removeDuplicateHotCues(&cues);
+    }
+    return cuesByTrackId;
+}
+
 bool CueDAO::deleteCuesForTrack(TrackId trackId) const {
     qDebug() << "CueDAO::deleteCuesForTrack" << QThread::currentThread() << m_database.connectionName();
     QSqlQuery query(m_database);
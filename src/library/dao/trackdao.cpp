@@ -40,6 +40,7 @@
 #include "util/logger.h"
 #include "util/math.h"
 #include "util/qt.h"
+#include "util/stringpool.h"
 #include "util/timer.h"
 
 namespace {
@@ -48,6 +49,9 @@ mixxx::Logger kLogger("TrackDAO");
 
 enum { UndefinedRecordIndex = -2 };
 
+// The number of tracks or track snapshots that are loaded with a single query
+constexpr int kTrackBatchSize = 500;
+
 void markTrackLocationsAsDeleted(const QSqlDatabase& database, const QString& directory) {
     //qDebug() << "TrackDAO::markTrackLocationsAsDeleted" << QThread::currentThread() << m_database.connectionName();
     QSqlQuery query(database);
@@ -62,6 +66,12 @@ void markTrackLocationsAsDeleted(const QSqlDatabase& database, const QString& di
     }
 }
 
+// Values that are shared by many tracks, e.g. the artist or the genre,
+// reference a single, interned string instead of a copy per track.
+QString internString(const QSqlRecord& record, const int column) {
+    return mixxx::StringPool::global().intern(record.value(column).toString());
+}
+
 QString joinTrackIdList(const QSet<TrackId>& trackIds) {
     QStringList trackIdList;
     trackIdList.reserve(trackIds.size());
@@ -307,6 +317,87 @@ QString TrackDAO::getTrackLocation(TrackId trackId) const {
     return trackLocation;
 }
 
+TrackSnapshotList TrackDAO::getTrackSnapshots(
+        const QList<TrackId>& trackIds) const {
+    ScopedTimer t("TrackDAO::getTrackSnapshots");
+
+    // Cached tracks might have been modified and not saved yet
+    TrackPointerList cachedTracks;
+    QList<TrackId> uncachedTrackIds;
+    {
+        // The GlobalTrackCache is only locked while looking up the tracks
+        GlobalTrackCacheLocker cacheLocker;
+        for (const auto& trackId : trackIds) {
+            if (!trackId.isValid()) {
+                continue;
+            }
+            TrackPointer pTrack = cacheLocker.lookupTrackById(trackId);
+            if (pTrack) {
+                cachedTracks.append(std::move(pTrack));
+            } else {
+                uncachedTrackIds.append(trackId);
+            }
+        }
+    }
+    QHash<TrackId, TrackSnapshot> snapshots;
+    snapshots.reserve(trackIds.size());
+    for (const auto& pTrack : qAsConst(cachedTracks)) {
+        snapshots.insert(pTrack->getId(), TrackSnapshot::fromTrack(*pTrack));
+    }
+
+    // Load the remaining tracks in batches instead of one query per track
+    for (int offset = 0; offset < uncachedTrackIds.size(); offset += kTrackBatchSize) {
+        QStringList trackIdList;
+        for (const auto& trackId : uncachedTrackIds.mid(offset, kTrackBatchSize)) {
+            trackIdList.append(trackId.toString());
+        }
+        QSqlQuery query(m_database);
+        query.setForwardOnly(true);
+        query.prepare(QStringLiteral(
+                "SELECT library.id,track_locations.location,"
+                "artist,title,album,album_artist,genre,year,"
+                "duration,bpm,key_id,rating,timesplayed,color "
+                "FROM library "
+                "INNER JOIN track_locations ON library.location=track_locations.id "
+                "WHERE library.id IN (%1)")
+                              .arg(trackIdList.join(QChar(','))));
+        if (!query.exec()) {
+            LOG_FAILED_QUERY(query);
+            DEBUG_ASSERT(!"Failed query");
+            continue;
+        }
+        while (query.next()) {
+            const QSqlRecord record = query.record();
+            TrackSnapshot snapshot;
+            snapshot.id = TrackId(record.value(0));
+            snapshot.location = record.value(1).toString();
+            snapshot.artist = internString(record, 2);
+            snapshot.title = record.value(3).toString();
+            snapshot.album = internString(record, 4);
+            snapshot.albumArtist = internString(record, 5);
+            snapshot.genre = internString(record, 6);
+            snapshot.year = internString(record, 7);
+            snapshot.durationSeconds = record.value(8).toDouble();
+            snapshot.bpm = record.value(9).toDouble();
+            snapshot.key = KeyUtils::keyFromNumericValue(record.value(10).toInt());
+            snapshot.rating = record.value(11).toInt();
+            snapshot.timesPlayed = record.value(12).toInt();
+            snapshot.color = mixxx::RgbColor::fromQVariant(record.value(13));
+            snapshots.insert(snapshot.id, snapshot);
+        }
+    }
+
+    TrackSnapshotList result;
+    result.reserve(trackIds.size());
+    for (const auto& trackId : trackIds) {
+        const auto it = snapshots.constFind(trackId);
+        if (it != snapshots.constEnd()) {
+            result.append(it.value());
+        }
+    }
+    return result;
+}
+
 bool TrackDAO::saveTrack(Track* pTrack) const {
     VERIFY_OR_DEBUG_ASSERT(pTrack) {
         return false;
@@ -1094,7 +1185,7 @@ typedef bool (*TrackPopulatorFn)(const QSqlRecord& record,
         Track* pTrack);
 
 bool setTrackArtist(const QSqlRecord& record, const int column, Track* pTrack) {
-    pTrack->setArtist(record.value(column).toString());
+    pTrack->setArtist(internString(record, column));
     return false;
 }
 
@@ -1104,34 +1195,34 @@ bool setTrackTitle(const QSqlRecord& record, const int column, Track* pTrack) {
 }
 
 bool setTrackAlbum(const QSqlRecord& record, const int column, Track* pTrack) {
-    pTrack->setAlbum(record.value(column).toString());
+    pTrack->setAlbum(internString(record, column));
     return false;
 }
 
 bool setTrackAlbumArtist(const QSqlRecord& record, const int column, Track* pTrack) {
-    pTrack->setAlbumArtist(record.value(column).toString());
+    pTrack->setAlbumArtist(internString(record, column));
     return false;
 }
 
 bool setTrackYear(const QSqlRecord& record, const int column, Track* pTrack) {
-    pTrack->setYear(record.value(column).toString());
+    pTrack->setYear(internString(record, column));
     return false;
 }
 
 bool setTrackGenre(const QSqlRecord& record,
         const int column,
         Track* pTrack) {
-    TrackDAO::setTrackGenreInternal(pTrack, record.value(column).toString());
+    TrackDAO::setTrackGenreInternal(pTrack, internString(record, column));
     return false;
 }
 
 bool setTrackComposer(const QSqlRecord& record, const int column, Track* pTrack) {
-    pTrack->setComposer(record.value(column).toString());
+    pTrack->setComposer(internString(record, column));
     return false;
 }
 
 bool setTrackGrouping(const QSqlRecord& record, const int column, Track* pTrack) {
-    pTrack->setGrouping(record.value(column).toString());
+    pTrack->setGrouping(internString(record, column));
     return false;
 }
 
@@ -1214,7 +1305,7 @@ bool setTrackDateAdded(const QSqlRecord& record, const int column, Track* pTrack
 }
 
 bool setTrackFiletype(const QSqlRecord& record, const int column, Track* pTrack) {
-    pTrack->setType(record.value(column).toString());
+    pTrack->setType(internString(record, column));
     return false;
 }
 
@@ -1334,6 +1425,83 @@ struct ColumnPopulator {
     TrackPopulatorFn populator;
 };
 
+constexpr ColumnPopulator kTrackColumns[] = {
+        // Location must be first and is populated manually!
+        {"track_locations.location", nullptr},
+        {"artist", setTrackArtist},
+        {"title", setTrackTitle},
+        {"album", setTrackAlbum},
+        {"album_artist", setTrackAlbumArtist},
+        {"year", setTrackYear},
+        {"genre", setTrackGenre},
+        {"composer", setTrackComposer},
+        {"grouping", setTrackGrouping},
+        {"tracknumber", setTrackNumber},
+        {"tracktotal", setTrackTotal},
+        {"filetype", setTrackFiletype},
+        {"rating", setTrackRating},
+        {"color", setTrackColor},
+        {"comment", setTrackComment},
+        {"url", setTrackUrl},
+        {"cuepoint", setTrackCuePoint},
+        {"replaygain", setTrackReplayGainRatio},
+        {"replaygain_peak", setTrackReplayGainPeak},
+        {"timesplayed", setTrackTimesPlayed},
+        {"last_played_at", setTrackLastPlayedAt},
+        {"played", setTrackPlayed},
+        {"datetime_added", setTrackDateAdded},
+        {"header_parsed", setTrackHeaderParsed},
+        {"source_synchronized_ms", setTrackSourceSynchronizedAt},
+
+        // Audio properties are set together at once. Do not change the
+        // ordering of these columns or put other columns in between them!
+        {"channels", setTrackAudioProperties},
+        {"samplerate", nullptr},
+        {"bitrate", nullptr},
+        {"duration", nullptr},
+
+        // Beat detection columns are handled by setTrackBeats. Do not change
+        // the ordering of these columns or put other columns in between them!
+        {"bpm", setTrackBeats},
+        {"beats_version", nullptr},
+        {"beats_sub_version", nullptr},
+        {"beats", nullptr},
+        {"bpm_lock", nullptr},
+
+        // Beat detection columns are handled by setTrackKey. Do not change the
+        // ordering of these columns or put other columns in between them!
+        {"key", setTrackKey},
+        {"keys_version", nullptr},
+        {"keys_sub_version", nullptr},
+        {"keys", nullptr},
+
+        // Cover art columns are handled by setTrackCoverInfo. Do not change the
+        // ordering of these columns or put other columns in between them!
+        {"coverart_source", setTrackCoverInfo},
+        {"coverart_type", nullptr},
+        {"coverart_location", nullptr},
+        {"coverart_color", nullptr},
+        {"coverart_digest", nullptr},
+        {"coverart_hash", nullptr},
+};
+constexpr int kTrackColumnsCount = static_cast<int>(std::size(kTrackColumns));
+
+QString trackColumnsString() {
+    QString columnsStr;
+    int columnsSize = 0;
+    for (int i = 0; i < kTrackColumnsCount; ++i) {
+        columnsSize += qstrlen(kTrackColumns[i].name) + 1;
+    }
+    columnsStr.reserve(columnsSize);
+    for (int i = 0; i < kTrackColumnsCount; ++i) {
+        if (i > 0) {
+            columnsStr.append(QChar(','));
+        }
+        columnsStr.append(kTrackColumns[i].name);
+    }
+    return columnsStr;
+}
+
 }  // namespace
 
 TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
@@ -1347,178 +1515,186 @@ TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
         return pTrack;
     }
 
-    constexpr ColumnPopulator columns[] = {
-            // Location must be first and is populated manually!
-            {"track_locations.location", nullptr},
-            {"artist", setTrackArtist},
-            {"title", setTrackTitle},
-            {"album", setTrackAlbum},
-            {"album_artist", setTrackAlbumArtist},
-            {"year", setTrackYear},
-            {"genre", setTrackGenre},
-            {"composer", setTrackComposer},
-            {"grouping", setTrackGrouping},
-            {"tracknumber", setTrackNumber},
-            {"tracktotal", setTrackTotal},
-            {"filetype", setTrackFiletype},
-            {"rating", setTrackRating},
-            {"color", setTrackColor},
-            {"comment", setTrackComment},
-            {"url", setTrackUrl},
-            {"cuepoint", setTrackCuePoint},
-            {"replaygain", setTrackReplayGainRatio},
-            {"replaygain_peak", setTrackReplayGainPeak},
-            {"timesplayed", setTrackTimesPlayed},
-            {"last_played_at", setTrackLastPlayedAt},
-            {"played", setTrackPlayed},
-            {"datetime_added", setTrackDateAdded},
-            {"header_parsed", setTrackHeaderParsed},
-            {"source_synchronized_ms", setTrackSourceSynchronizedAt},
-
-            // Audio properties are set together at once. Do not change the
-            // ordering of these columns or put other columns in between them!
-            {"channels", setTrackAudioProperties},
-            {"samplerate", nullptr},
-            {"bitrate", nullptr},
-            {"duration", nullptr},
-
-            // Beat detection columns are handled by setTrackBeats. Do not change
-            // the ordering of these columns or put other columns in between them!
-            {"bpm", setTrackBeats},
-            {"beats_version", nullptr},
-            {"beats_sub_version", nullptr},
-            {"beats", nullptr},
-            {"bpm_lock", nullptr},
-
-            // Beat detection columns are handled by setTrackKey. Do not change the
-            // ordering of these columns or put other columns in between them!
-            {"key", setTrackKey},
-            {"keys_version", nullptr},
-            {"keys_sub_version", nullptr},
-            {"keys", nullptr},
-
-            // Cover art columns are handled by setTrackCoverInfo. Do not change the
-            // ordering of these columns or put other columns in between them!
-            {"coverart_source", setTrackCoverInfo},
-            {"coverart_type", nullptr},
-            {"coverart_location", nullptr},
-            {"coverart_color", nullptr},
-            {"coverart_digest", nullptr},
-            {"coverart_hash", nullptr},
-    };
-    constexpr int columnsCount = static_cast<int>(std::size(columns));
+    const TrackPointerList tracks = getTracksById(QList<TrackId>{trackId});
+    if (tracks.isEmpty()) {
+        qDebug() << "Track with id =" << trackId << "not found";
+        return nullptr;
+    }
+    DEBUG_ASSERT(tracks.size() == 1);
+    return tracks.first();
+}
+
+TrackPointerList TrackDAO::getTracksById(
+        const QList<TrackId>& trackIds) const {
+    QHash<TrackId, TrackPointer> tracksById;
+    tracksById.reserve(trackIds.size());
+    QList<TrackId> missingTrackIds;
+    {
+        // The GlobalTrackCache is only locked once while looking up all tracks
+        GlobalTrackCacheLocker cacheLocker;
+        for (const auto& trackId : trackIds) {
+            if (!trackId.isValid() || tracksById.contains(trackId)) {
+                continue;
+            }
+            TrackPointer pTrack = cacheLocker.lookupTrackById(trackId);
+            if (!pTrack) {
+                missingTrackIds.append(trackId);
+            }
+            tracksById.insert(trackId, std::move(pTrack));
+        }
+    }
 
     // Accessing the database is a time consuming operation that should not
     // be executed with a lock on the GlobalTrackCache. The GlobalTrackCache
     // will be locked again after the query has been executed (see below)
     // and potential race conditions will be resolved.
-    ScopedTimer t("TrackDAO::getTrackById");
+    if (!missingTrackIds.isEmpty()) {
+        ScopedTimer t("TrackDAO::getTracksById");
+        const QString columnsStr = trackColumnsString();
+        for (int offset = 0; offset < missingTrackIds.size(); offset += kTrackBatchSize) {
+            const QList<TrackId> batchTrackIds =
+                    missingTrackIds.mid(offset, kTrackBatchSize);
+            loadTracks(&tracksById, batchTrackIds, columnsStr);
+        }
+    }
 
-    QSqlRecord queryRecord;
-    {
-        QString columnsStr;
-        int columnsSize = 0;
-        for (int i = 0; i < columnsCount; ++i) {
-            columnsSize += qstrlen(columns[i].name) + 1;
-        }
-        columnsStr.reserve(columnsSize);
-        for (int i = 0; i < columnsCount; ++i) {
-            if (i > 0) {
-                columnsStr.append(QChar(','));
-            }
-            columnsStr.append(columns[i].name);
+    TrackPointerList tracks;
+    tracks.reserve(trackIds.size());
+    for (const auto& trackId : trackIds) {
+        TrackPointer pTrack = tracksById.value(trackId);
+        if (pTrack) {
+            tracks.append(std::move(pTrack));
         }
+    }
+    return tracks;
+}
 
+void TrackDAO::loadTracks(
+        QHash<TrackId, TrackPointer>* pTracksById,
+        const QList<TrackId>& trackIds,
+        const QString& columnsStr) const {
+    QStringList trackIdList;
+    trackIdList.reserve(trackIds.size());
+    for (const auto& trackId : trackIds) {
+        trackIdList.append(trackId.toString());
+    }
+    QList<QSqlRecord> queryRecords;
+    queryRecords.reserve(trackIds.size());
+    {
         QSqlQuery query(m_database);
+        query.setForwardOnly(true);
+        // The track id is appended after all populated columns
         query.prepare(QString(
-                "SELECT %1 FROM Library "
+                "SELECT %1,library.id FROM Library "
                 "INNER JOIN track_locations ON library.location = track_locations.id "
-                "WHERE library.id = %2")
-                              .arg(columnsStr, trackId.toString()));
+                "WHERE library.id IN (%2)")
+                              .arg(columnsStr, trackIdList.join(QChar(','))));
         if (!query.exec()) {
             LOG_FAILED_QUERY(query)
-                    << QString("getTrack(%1)").arg(trackId.toString());
+                    << QString("getTracks(%1)").arg(trackIdList.join(QChar(',')));
             DEBUG_ASSERT(!"Failed query");
-            return nullptr;
+            return;
         }
-
-        if (!query.next()) {
-            qDebug() << "Track with id =" << trackId << "not found";
-            return nullptr;
+        while (query.next()) {
+            queryRecords.append(query.record());
         }
-        queryRecord = query.record();
-        // Only a single record is expected
-        DEBUG_ASSERT(!query.next());
     }
+    QHash<TrackId, QList<CuePointer>> cuesByTrackId =
+            m_cueDao.getCuesForTracks(trackIds);
 
+    // All tracks of the batch are resolved while the cache is locked once
+    QList<std::pair<TrackPointer, QSqlRecord>> newTracks;
     {
-        // Location is the first column.
-        DEBUG_ASSERT(queryRecord.count() > 0);
-        const auto trackLocation = queryRecord.value(0).toString();
-        const auto fileInfo = mixxx::FileInfo(trackLocation);
-        const auto fileAccess = mixxx::FileAccess(fileInfo);
-        const auto cacheResolver = GlobalTrackCacheResolver(fileAccess, trackId);
-        pTrack = cacheResolver.getTrack();
-        switch (cacheResolver.getLookupResult()) {
-        case GlobalTrackCacheLookupResult::Hit:
-            // Due to race conditions the track might have been reloaded
-            // from the database in the meantime. In this case we abort
-            // the operation and simply return the already cached Track
-            // object which is up-to-date.
-            DEBUG_ASSERT(pTrack);
-            DEBUG_ASSERT(!trackId.isValid() || trackId == pTrack->getId());
-            DEBUG_ASSERT(fileInfo == pTrack->getFileInfo());
-            return pTrack;
-        case GlobalTrackCacheLookupResult::Miss:
-            // An (almost) empty track object
-            DEBUG_ASSERT(pTrack);
-            DEBUG_ASSERT(fileInfo == pTrack->getFileInfo());
-            DEBUG_ASSERT(!trackId.isValid() || trackId == pTrack->getId());
-            // Continue and populate the (almost) empty track object
-            break;
-        case GlobalTrackCacheLookupResult::ConflictCanonicalLocation:
-            // Reject requests that would otherwise cause a caching caching conflict
-            // by accessing the same, physical file from multiple tracks concurrently.
-            DEBUG_ASSERT(!pTrack);
-            DEBUG_ASSERT(cacheResolver.getTrackRef().hasId());
-            DEBUG_ASSERT(!trackId.isValid() || trackId == cacheResolver.getTrackRef().getId());
-            DEBUG_ASSERT(cacheResolver.getTrackRef().hasCanonicalLocation());
-            DEBUG_ASSERT(cacheResolver.getTrackRef().getCanonicalLocation() ==
-                    fileInfo.canonicalLocation());
-            kLogger.warning()
-                    << "Failed to load track with id"
-                    << trackId
-                    << "that is referencing the same file"
-                    << cacheResolver.getTrackRef().getCanonicalLocation()
-                    << "as the cached track with id"
-                    << cacheResolver.getTrackRef().getId();
-            return nullptr;
-        default:
-            DEBUG_ASSERT(!"unreachable");
-            return nullptr;
+        GlobalTrackCacheLocker cacheLocker;
+        for (const auto& queryRecord : qAsConst(queryRecords)) {
+            // Location is the first column and the id the last column.
+            DEBUG_ASSERT(queryRecord.count() > kTrackColumnsCount);
+            const auto trackId = TrackId(queryRecord.value(kTrackColumnsCount));
+            const auto trackLocation = queryRecord.value(0).toString();
+            const auto fileInfo = mixxx::FileInfo(trackLocation);
+            TrackPointer pTrack;
+            TrackRef trackRef;
+            switch (cacheLocker.resolveTrack(
+                    &pTrack, &trackRef, mixxx::FileAccess(fileInfo), trackId)) {
+            case GlobalTrackCacheLookupResult::Hit:
+                // Due to race conditions the track might have been reloaded
+                // from the database in the meantime. In this case we simply
+                // use the already cached Track object which is up-to-date.
+                DEBUG_ASSERT(pTrack);
+                DEBUG_ASSERT(trackId == pTrack->getId());
+                DEBUG_ASSERT(fileInfo == pTrack->getFileInfo());
+                break;
+            case GlobalTrackCacheLookupResult::Miss:
+                // An (almost) empty track object
+                DEBUG_ASSERT(pTrack);
+                DEBUG_ASSERT(fileInfo == pTrack->getFileInfo());
+                DEBUG_ASSERT(trackId == pTrack->getId());
+                // Populate the (almost) empty track object after
+                // the cache has been unlocked
+                newTracks.append(std::make_pair(pTrack, queryRecord));
+                break;
+            case GlobalTrackCacheLookupResult::ConflictCanonicalLocation:
+                // Reject requests that would otherwise cause a caching caching conflict
+                // by accessing the same, physical file from multiple tracks concurrently.
+                DEBUG_ASSERT(!pTrack);
+                DEBUG_ASSERT(trackRef.hasId());
+                DEBUG_ASSERT(trackRef.hasCanonicalLocation());
+                DEBUG_ASSERT(trackRef.getCanonicalLocation() ==
+                        fileInfo.canonicalLocation());
+                kLogger.warning()
+                        << "Failed to load track with id"
+                        << trackId
+                        << "that is referencing the same file"
+                        << trackRef.getCanonicalLocation()
+                        << "as the cached track with id"
+                        << trackRef.getId();
+                continue;
+            case GlobalTrackCacheLookupResult::None:
+                // Caching has already been deactivated
+                DEBUG_ASSERT(!pTrack);
+                continue;
+            default:
+                DEBUG_ASSERT(!"unreachable");
+                continue;
+            }
+            pTracksById->insert(trackId, std::move(pTrack));
         }
     }
 
     // NOTE(uklotzde, 2018-02-06):
     // pTrack has only the id set and is otherwise empty. It is registered
     // in the cache with both the id and the canonical location of the file.
-    // The following database query will restore and populate all remaining
-    // properties while the virgin track object is already visible for other
-    // threads when looking it up in the cache. This temporary inconsistency
-    // is acceptable as a tradeoff for reduced lock contention. Otherwise the
-    // global cache would need to be locked until the query and the population
-    // of the properties has finished.
+    // The following population will restore all remaining properties while
+    // the virgin track object is already visible for other threads when
+    // looking it up in the cache. This temporary inconsistency is acceptable
+    // as a tradeoff for reduced lock contention. Otherwise the global cache
+    // would need to be locked until the population of the properties has
+    // finished.
+    for (const auto& newTrack : qAsConst(newTracks)) {
+        const TrackPointer& pTrack = newTrack.first;
+        populateTrack(pTrack,
+                newTrack.second,
+                cuesByTrackId.take(pTrack->getId()));
+    }
+}
+
+void TrackDAO::populateTrack(
+        const TrackPointer& pTrack,
+        const QSqlRecord& queryRecord,
+        QList<CuePointer> cues) const {
+    const TrackId trackId = pTrack->getId();
 
     // For every column run its populator to fill the track in with the data.
     bool shouldDirty = false;
     {
-        int recordCount = queryRecord.count();
-        if (recordCount != columnsCount) {
-            recordCount = math_min(recordCount, columnsCount);
+        // The track id follows after all populated columns
+        int recordCount = queryRecord.count() - 1;
+        if (recordCount != kTrackColumnsCount) {
+            recordCount = math_min(recordCount, kTrackColumnsCount);
             DEBUG_ASSERT(!"Failed query");
         }
         for (int i = 0; i < recordCount; ++i) {
-            TrackPopulatorFn populator = columns[i].populator;
+            TrackPopulatorFn populator = kTrackColumns[i].populator;
             if (populator && (*populator)(queryRecord, i, pTrack.get())) {
                 // If any populator says the track should be dirty then we dirty it.
                 shouldDirty = true;
@@ -1526,8 +1702,8 @@ TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
         }
     }
 
-    // Populate track cues from the cues table.
-    pTrack->setCuePoints(m_cueDao.getCuesForTrack(trackId));
+    // Track cues have been loaded from the cues table.
+    pTrack->setCuePoints(std::move(cues));
 
     // Normally we will set the track as clean but sometimes when loading from
     // the database we need to perform upkeep that ought to be written back to
@@ -1611,8 +1787,6 @@ TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
     } else {
         emit mixxx::thisAsNonConst(this)->trackClean(trackId);
     }
-
-    return pTrack;
 }
 
 TrackId TrackDAO::getTrackIdByRef(
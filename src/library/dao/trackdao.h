@@ -1,6 +1,7 @@
 #pragma once
 
 #include <QFileInfo>
+#include <QHash>
 #include <QList>
 #include <QObject>
 #include <QSet>
@@ -10,11 +11,14 @@
 #include "library/dao/dao.h"
 #include "library/relocatedtrack.h"
 #include "preferences/usersettings.h"
+#include "track/cue.h"
 #include "track/globaltrackcache.h"
+#include "track/tracksnapshot.h"
 #include "util/class.h"
 #include "util/memory.h"
 
 class FwdSqlQuery;
+class QSqlRecord;
 class SqlTransaction;
 class PlaylistDAO;
 class AnalysisDao;
@@ -67,6 +71,13 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
     QSet<QString> getAllTrackLocations() const;
     QString getTrackLocation(TrackId trackId) const;
 
+    /// Loads snapshots of multiple tracks at once without creating
+    /// Track objects. Tracks that are already cached are copied from
+    /// the cache. The snapshots are returned in the order of the given
+    /// ids and missing tracks are skipped.
+    TrackSnapshotList getTrackSnapshots(
+            const QList<TrackId>& trackIds) const;
+
     // Only used by friend class LibraryScanner, but public for testing!
     bool detectMovedTracks(
             QList<RelocatedTrack>* pRelocatedTracks,
@@ -137,6 +148,21 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
             const QString& location) const;
     TrackPointer getTrackById(
             TrackId trackId) const;
+    /// Loads multiple tracks at once. All tracks that are already cached
+    /// are looked up while locking the GlobalTrackCache only once. The
+    /// remaining tracks are loaded in batches with a single query per
+    /// batch instead of one query per track. The tracks are returned in
+    /// the order of the given ids and missing tracks are skipped.
+    TrackPointerList getTracksById(
+            const QList<TrackId>& trackIds) const;
+    void loadTracks(
+            QHash<TrackId, TrackPointer>* pTracksById,
+            const QList<TrackId>& trackIds,
+            const QString& columnsStr) const;
+    void populateTrack(
+            const TrackPointer& pTrack,
+            const QSqlRecord& queryRecord,
+            QList<CuePointer> cues) const;
 
     // Loads a track from the database (by id if available, otherwise by location)
     // or adds it if not found in case the location is known. The (optional) out
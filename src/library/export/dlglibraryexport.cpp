@@ -12,6 +12,7 @@
 #include <string>
 
 #include "library/export/engineprimeexportrequest.h"
+#include "library/library_prefs.h"
 #include "library/trackcollection.h"
 #include "library/trackcollectionmanager.h"
 #include "library/trackset/crate/crateid.h"
@@ -206,6 +207,9 @@ void DlgLibraryExport::exportRequested() {
     pRequest->engineLibraryDbDir.setPath(databaseDirectory);
     pRequest->musicFilesDir.setPath(musicDirectory);
     pRequest->exportVersion = exportVersion;
+    pRequest->ioDepth = m_pConfig->getValue(
+            library::prefs::kExportIoDepthConfigKey,
+            library::prefs::kExportIoDepthDefault);
     if (m_pCratesList->isEnabled()) {
         const auto selectedItems = m_pCratesList->selectedItems();
         for (auto* pItem : selectedItems) {
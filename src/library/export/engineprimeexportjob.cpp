@@ -1,8 +1,12 @@
 #include "library/export/engineprimeexportjob.h"
 
 #include <QHash>
+#include <QFuture>
 #include <QMetaMethod>
+#include <QMutex>
 #include <QStringList>
+#include <QThreadPool>
+#include <QtConcurrentRun>
 #include <QtGlobal>
 #include <array>
 #include <chrono>
@@ -11,10 +15,14 @@
 #include <memory>
 #include <stdexcept>
 
+#include "library/export/exportfilecopier.h"
 #include "library/trackcollection.h"
 #include "library/trackset/crate/crate.h"
 #include "track/track.h"
+#include "util/math.h"
+#include "util/compatibility/qmutex.h"
 #include "util/optional.h"
+#include "util/performancetimer.h"
 #include "util/thread_affinity.h"
 #include "waveform/waveformfactory.h"
 
@@ -28,6 +36,9 @@ const std::string kMixxxRootCrateName = "Mixxx";
 
 constexpr int kMaxHotCues = 8;
 
+// The number of tracks that are loaded and exported at once
+constexpr int kTrackBatchSize = 32;
+
 constexpr uint8_t kDefaultWaveformOpacity = 127;
 
 const QStringList kSupportedFileTypes = {
@@ -74,17 +85,33 @@ std::optional<djinterop::musical_key> toDjinteropKey(
     return keyMap[key];
 }
 
-QString exportFile(const QSharedPointer<EnginePrimeExportRequest> pRequest,
-        TrackPointer pTrack) {
-    if (!pRequest->engineLibraryDbDir.exists()) {
+/// The result of the steps of a track export that don't access the
+/// Engine Prime database and are performed concurrently.
+struct PreparedTrack {
+    QString relativePath;
+    std::vector<djinterop::waveform_entry> waveform;
+    bool copied = false;
+    qint64 copiedBytes = 0;
+    std::string errorMessage;
+};
+
+/// The directories are passed as absolute paths, because the QDir objects
+/// of the request must not be shared between the threads of the pool.
+QString exportFile(const QString& engineLibraryDbPath,
+        const QString& musicFilesPath,
+        TrackPointer pTrack,
+        PreparedTrack* pPreparedTrack) {
+    const QDir engineLibraryDbDir(engineLibraryDbPath);
+    const QDir musicFilesDir(musicFilesPath);
+    if (!engineLibraryDbDir.exists()) {
         const auto msg = QStringLiteral(
                 "Engine Library DB directory %1 has been removed from disk!")
-                                 .arg(pRequest->engineLibraryDbDir.absolutePath());
+                                 .arg(engineLibraryDbPath);
         throw std::runtime_error{msg.toStdString()};
-    } else if (!pRequest->musicFilesDir.exists()) {
+    } else if (!musicFilesDir.exists()) {
         const auto msg = QStringLiteral(
                 "Music file export directory %1 has been removed from disk!")
-                                 .arg(pRequest->musicFilesDir.absolutePath());
+                                 .arg(musicFilesPath);
         throw std::runtime_error{msg.toStdString()};
     }
 
@@ -95,14 +122,24 @@ QString exportFile(const QSharedPointer<EnginePrimeExportRequest> pRequest,
     mixxx::FileInfo srcFileInfo = pTrack->getFileInfo();
     const auto trackId = pTrack->getId().value();
     QString dstFilename = QString::number(trackId) + " - " + srcFileInfo.fileName();
-    QString dstPath = pRequest->musicFilesDir.filePath(dstFilename);
-    if (!QFile::exists(dstPath) ||
-            srcFileInfo.lastModified() > QFileInfo{dstPath}.lastModified()) {
-        const auto srcPath = srcFileInfo.location();
-        QFile::copy(srcPath, dstPath);
+    QString dstPath = musicFilesDir.filePath(dstFilename);
+    const auto srcPath = srcFileInfo.location();
+    // Files of an interrupted export are either complete or missing, they
+    // are never truncated. Complete files are skipped when resuming.
+    if (!ExportFileCopier::isIdentical(srcPath,
+                dstPath,
+                ExportFileCopier::IdenticalCheck::SizeAndModificationTime)) {
+        const QString errorMessage = ExportFileCopier::copyFile(srcPath, dstPath);
+        if (!errorMessage.isEmpty()) {
+            const auto msg = QStringLiteral("Failed to copy %1 to %2: %3")
+                                     .arg(srcPath, dstPath, errorMessage);
+            throw std::runtime_error{msg.toStdString()};
+        }
+        pPreparedTrack->copied = true;
+        pPreparedTrack->copiedBytes = srcFileInfo.sizeInBytes();
     }
 
-    return pRequest->engineLibraryDbDir.relativeFilePath(dstPath);
+    return engineLibraryDbDir.relativeFilePath(dstPath);
 }
 
 std::optional<djinterop::track> getTrackByRelativePath(
@@ -168,10 +205,36 @@ bool tryGetBeatgrid(BeatsPointer pBeats,
     return true;
 }
 
+int64_t frameCountOf(const TrackPointer& pTrack) {
+    // Frames used interchangeably with "samples" here.
+    return static_cast<int64_t>(pTrack->getDuration() * pTrack->getSampleRate());
+}
+
+std::vector<djinterop::waveform_entry> convertWaveform(
+        const TrackPointer& pTrack,
+        const Waveform* pWaveform) {
+    std::vector<djinterop::waveform_entry> externalWaveform;
+    if (!pWaveform) {
+        return externalWaveform;
+    }
+    const int64_t frameCount = frameCountOf(pTrack);
+    int64_t samplesPerEntry =
+            el::required_waveform_samples_per_entry(pTrack->getSampleRate());
+    int64_t externalWaveformSize = (frameCount + samplesPerEntry - 1) / samplesPerEntry;
+    externalWaveform.reserve(externalWaveformSize);
+    for (int64_t i = 0; i < externalWaveformSize; ++i) {
+        int64_t j = pWaveform->getDataSize() * i / externalWaveformSize;
+        externalWaveform.push_back({{pWaveform->getLow(j), kDefaultWaveformOpacity},
+                {pWaveform->getMid(j), kDefaultWaveformOpacity},
+                {pWaveform->getHigh(j), kDefaultWaveformOpacity}});
+    }
+    return externalWaveform;
+}
+
 void exportMetadata(djinterop::database* pDatabase,
         QHash<TrackId, int64_t>* pMixxxToEnginePrimeTrackIdMap,
         TrackPointer pTrack,
-        const Waveform* pWaveform,
+        std::vector<djinterop::waveform_entry> waveform,
         const QString& relativePath) {
     // Attempt to load the track in the database, using the relative path to
     // the music file.  If it exists already, take a snapshot of the track and
@@ -213,8 +276,7 @@ void exportMetadata(djinterop::database* pDatabase,
     snapshot.rating = pTrack->getRating() * 20; // note rating is in range 0-100
     snapshot.file_bytes = pTrack->getFileInfo().sizeInBytes();
 
-    // Frames used interchangeably with "samples" here.
-    const auto frameCount = static_cast<int64_t>(pTrack->getDuration() * pTrack->getSampleRate());
+    const auto frameCount = frameCountOf(pTrack);
     snapshot.sampling = djinterop::sampling_info{
             static_cast<double>(pTrack->getSampleRate()), frameCount};
 
@@ -305,19 +367,8 @@ void exportMetadata(djinterop::database* pDatabase,
     // Write waveform.
     // Note that writing a single waveform will automatically calculate an
     // overview waveform too.
-    if (pWaveform) {
-        int64_t samplesPerEntry =
-                el::required_waveform_samples_per_entry(pTrack->getSampleRate());
-        int64_t externalWaveformSize = (frameCount + samplesPerEntry - 1) / samplesPerEntry;
-        std::vector<djinterop::waveform_entry> externalWaveform;
-        externalWaveform.reserve(externalWaveformSize);
-        for (int64_t i = 0; i < externalWaveformSize; ++i) {
-            int64_t j = pWaveform->getDataSize() * i / externalWaveformSize;
-            externalWaveform.push_back({{pWaveform->getLow(j), kDefaultWaveformOpacity},
-                    {pWaveform->getMid(j), kDefaultWaveformOpacity},
-                    {pWaveform->getHigh(j), kDefaultWaveformOpacity}});
-        }
-        snapshot.waveform = std::move(externalWaveform);
+    if (!waveform.empty()) {
+        snapshot.waveform = std::move(waveform);
     } else {
         qInfo() << "No waveform data found for track" << pTrack->getId()
                 << "(" << pTrack->getFileInfo().fileName() << ")";
@@ -336,29 +387,34 @@ void exportMetadata(djinterop::database* pDatabase,
     pMixxxToEnginePrimeTrackIdMap->insert(pTrack->getId(), externalTrackId);
 }
 
-void exportTrack(
-        const QSharedPointer<EnginePrimeExportRequest> pRequest,
-        djinterop::database* pDatabase,
-        QHash<TrackId, int64_t>* pMixxxToEnginePrimeTrackIdMap,
-        const TrackPointer pTrack,
-        const Waveform* pWaveform) {
+bool isSupportedFileType(const TrackPointer& pTrack) {
     // Only export supported file types.
     if (!kSupportedFileTypes.contains(pTrack->getType())) {
         qInfo() << "Skipping file" << pTrack->getFileInfo().fileName()
                 << "(id" << pTrack->getId() << ") as its file type"
                 << pTrack->getType() << "is not supported";
-        return;
+        return false;
     }
+    return true;
+}
 
-    // Copy the file, if required.
-    const auto musicFileRelativePath = exportFile(pRequest, pTrack);
-
-    // Export meta-data.
-    exportMetadata(pDatabase,
-            pMixxxToEnginePrimeTrackIdMap,
-            pTrack,
-            pWaveform,
-            musicFileRelativePath);
+/// Copies the file and converts the waveform. Invoked concurrently for
+/// multiple tracks.
+PreparedTrack prepareTrack(
+        const QString& engineLibraryDbPath,
+        const QString& musicFilesPath,
+        const TrackPointer pTrack,
+        const Waveform* pWaveform) {
+    PreparedTrack preparedTrack;
+    try {
+        preparedTrack.relativePath = exportFile(
+                engineLibraryDbPath, musicFilesPath, pTrack, &preparedTrack);
+        preparedTrack.waveform = convertWaveform(pTrack, pWaveform);
+    } catch (std::exception& e) {
+        // Exceptions are not propagated from the thread pool
+        preparedTrack.errorMessage = e.what();
+    }
+    return preparedTrack;
 }
 
 void exportCrate(
@@ -462,22 +518,32 @@ void EnginePrimeExportJob::loadIds(const QSet<CrateId>& crateIds) {
     }
 }
 
-void EnginePrimeExportJob::loadTrack(const TrackRef& trackRef) {
+void EnginePrimeExportJob::loadTracks(int first, int count) {
     DEBUG_ASSERT_QOBJECT_THREAD_AFFINITY(m_pTrackCollectionManager);
 
-    // Load the track.
-    m_pLastLoadedTrack = m_pTrackCollectionManager->getOrAddTrack(trackRef);
-
-    // Load high-resolution waveform from analysis info.
+    m_lastLoadedTracks.clear();
+    m_lastLoadedWaveforms.clear();
     auto& analysisDao = m_pTrackCollectionManager->internalCollection()->getAnalysisDAO();
-    const auto waveformAnalyses = analysisDao.getAnalysesForTrackByType(
-            m_pLastLoadedTrack->getId(), AnalysisDao::TYPE_WAVEFORM);
-    if (!waveformAnalyses.isEmpty()) {
-        const auto& waveformAnalysis = waveformAnalyses.first();
-        m_pLastLoadedWaveform.reset(
-                WaveformFactory::loadWaveformFromAnalysis(waveformAnalysis));
-    } else {
-        m_pLastLoadedWaveform.reset();
+    for (const auto& trackRef : m_trackRefs.mid(first, count)) {
+        // Load the track.
+        auto pTrack = m_pTrackCollectionManager->getOrAddTrack(trackRef);
+        if (!pTrack) {
+            qWarning() << "Failed to load track" << trackRef;
+            continue;
+        }
+
+        // Load high-resolution waveform from analysis info.
+        std::unique_ptr<Waveform> pWaveform;
+        const auto waveformAnalyses = analysisDao.getAnalysesForTrackByType(
+                pTrack->getId(), AnalysisDao::TYPE_WAVEFORM);
+        if (!waveformAnalyses.isEmpty()) {
+            const auto& waveformAnalysis = waveformAnalyses.first();
+            pWaveform.reset(
+                    WaveformFactory::loadWaveformFromAnalysis(waveformAnalysis));
+        }
+
+        m_lastLoadedTracks.append(std::move(pTrack));
+        m_lastLoadedWaveforms.push_back(std::move(pWaveform));
     }
 }
 
@@ -539,46 +605,114 @@ void EnginePrimeExportJob::run() {
     // We will build up a map from Mixxx track id to EL track id during export.
     QHash<TrackId, int64_t> mixxxToEnginePrimeTrackIdMap;
 
-    for (const auto& trackRef : qAsConst(m_trackRefs)) {
-        // Load each track.
+    // Files are copied and waveforms are converted concurrently, while the
+    // database is only accessed from this thread.
+    const QString engineLibraryDbPath = m_pRequest->engineLibraryDbDir.absolutePath();
+    const QString musicFilesPath = m_pRequest->musicFilesDir.absolutePath();
+    // The progress of a track is reported as soon as its file has been
+    // copied, the mutex keeps the reported values in order.
+    QMutex progressMutex;
+    const auto reportProgress = [this, &progressMutex, &currProgress]() {
+        const auto locker = lockMutex(&progressMutex);
+        ++currProgress;
+        emit jobProgress(currProgress);
+    };
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(math_max(m_pRequest->ioDepth, 1));
+    PerformanceTimer timer;
+    timer.start();
+    int copiedFiles = 0;
+    qint64 copiedBytes = 0;
+
+    for (int first = 0; first < m_trackRefs.size(); first += kTrackBatchSize) {
+        // Load the next batch of tracks.
         // Note that loading must happen on the same thread as the track collection
         // manager, which is not the same as this method's worker thread.
         QMetaObject::invokeMethod(
                 this,
-                "loadTrack",
+                "loadTracks",
                 Qt::BlockingQueuedConnection,
-                Q_ARG(TrackRef, trackRef));
+                Q_ARG(int, first),
+                Q_ARG(int, kTrackBatchSize));
 
         if (m_cancellationRequested.loadAcquire() != 0) {
             qInfo() << "Cancelling export";
             return;
         }
 
-        DEBUG_ASSERT(m_pLastLoadedTrack != nullptr);
-
-        qInfo() << "Exporting track" << m_pLastLoadedTrack->getId().value()
-                << "at" << m_pLastLoadedTrack->getFileInfo().location() << "...";
-        try {
-            exportTrack(m_pRequest,
-                    pDb.get(),
-                    &mixxxToEnginePrimeTrackIdMap,
-                    m_pLastLoadedTrack,
-                    m_pLastLoadedWaveform.get());
-        } catch (std::exception& e) {
-            qWarning() << "Failed to export track"
-                       << m_pLastLoadedTrack->getId().value() << ":"
-                       << e.what();
-            m_lastErrorMessage = e.what();
-            emit failed(m_lastErrorMessage);
-            return;
+        // Tracks with unsupported file types are not exported
+        std::vector<std::optional<QFuture<PreparedTrack>>> preparedTracks;
+        preparedTracks.reserve(m_lastLoadedTracks.size());
+        for (int i = 0; i < m_lastLoadedTracks.size(); ++i) {
+            const auto& pTrack = m_lastLoadedTracks[i];
+            if (!isSupportedFileType(pTrack)) {
+                preparedTracks.push_back(std::nullopt);
+                reportProgress();
+                continue;
+            }
+            qInfo() << "Exporting track" << pTrack->getId().value()
+                    << "at" << pTrack->getFileInfo().location() << "...";
+            const Waveform* pWaveform = m_lastLoadedWaveforms[i].get();
+            preparedTracks.push_back(QtConcurrent::run(&threadPool,
+                    [&engineLibraryDbPath,
+                            &musicFilesPath,
+                            &reportProgress,
+                            pTrack,
+                            pWaveform]() {
+                        PreparedTrack preparedTrack = prepareTrack(
+                                engineLibraryDbPath, musicFilesPath, pTrack, pWaveform);
+                        reportProgress();
+                        return preparedTrack;
+                    }));
         }
 
-        m_pLastLoadedTrack.reset();
+        // Write the metadata of the whole batch
+        for (int i = 0; i < m_lastLoadedTracks.size(); ++i) {
+            if (!preparedTracks[i]) {
+                continue;
+            }
+            const auto& pTrack = m_lastLoadedTracks[i];
+            PreparedTrack preparedTrack = preparedTracks[i]->result();
+            try {
+                if (!preparedTrack.errorMessage.empty()) {
+                    throw std::runtime_error{preparedTrack.errorMessage};
+                }
+                exportMetadata(pDb.get(),
+                        &mixxxToEnginePrimeTrackIdMap,
+                        pTrack,
+                        std::move(preparedTrack.waveform),
+                        preparedTrack.relativePath);
+            } catch (std::exception& e) {
+                qWarning() << "Failed to export track"
+                           << pTrack->getId().value() << ":"
+                           << e.what();
+                m_lastErrorMessage = e.what();
+                threadPool.waitForDone();
+                emit failed(m_lastErrorMessage);
+                return;
+            }
+            if (preparedTrack.copied) {
+                ++copiedFiles;
+                copiedBytes += preparedTrack.copiedBytes;
+            }
+        }
 
-        ++currProgress;
-        emit jobProgress(currProgress);
+        m_lastLoadedTracks.clear();
+        m_lastLoadedWaveforms.clear();
     }
 
+    const double elapsedSeconds = timer.elapsed().toDoubleSeconds();
+    qInfo() << "Exported" << m_trackRefs.size() << "tracks in" << elapsedSeconds
+            << "s, copied" << copiedFiles << "files with"
+            << copiedBytes / (1024 * 1024) << "MiB"
+            << QString("(%1 MiB/s)")
+                       .arg(elapsedSeconds > 0
+                                       ? copiedBytes / elapsedSeconds / (1024 * 1024)
+                                       : 0.0,
+                               0,
+                               'f',
+                               1);
+
     // We will ensure that there is a special top-level crate representing the
     // root of all Mixxx-exported items.  Mixxx tracks and crates will exist
     // underneath this crate.
@@ -8,6 +8,7 @@
 #include <QThread>
 #include <QWaitCondition>
 #include <memory>
+#include <vector>
 
 #include "library/export/engineprimeexportrequest.h"
 #include "library/trackcollectionmanager.h"
@@ -23,6 +24,12 @@ namespace mixxx {
 /// library to an external Engine Prime (also known as "Engine Library")
 /// database, using the libdjinterop library, in accordance with the export
 /// request with which it is constructed.
+///
+/// Tracks are exported in batches. The music files of a batch are copied
+/// and the waveforms are converted concurrently, before the metadata of
+/// all tracks in the batch is written into the database. Files that have
+/// already been exported are skipped, so an interrupted export can be
+/// resumed by simply starting it again.
 class EnginePrimeExportJob : public QThread {
     Q_OBJECT
   public:
@@ -56,14 +63,14 @@ class EnginePrimeExportJob : public QThread {
     // thread of the application, which will be different to the worker thread
     // used by an instance of this class.
     void loadIds(const QSet<CrateId>& crateIdsToExport);
-    void loadTrack(const TrackRef& trackRef);
+    void loadTracks(int first, int count);
     void loadCrate(const CrateId& crateId);
 
   private:
     QList<TrackRef> m_trackRefs;
     QList<CrateId> m_crateIds;
-    TrackPointer m_pLastLoadedTrack;
-    std::unique_ptr<Waveform> m_pLastLoadedWaveform;
+    TrackPointerList m_lastLoadedTracks;
+    std::vector<std::unique_ptr<Waveform>> m_lastLoadedWaveforms;
     Crate m_lastLoadedCrate;
     QList<TrackId> m_lastLoadedCrateTrackIds;
 
@@ -25,6 +25,9 @@ struct EnginePrimeExportRequest {
     /// An empty set here implies that the whole music library is to be
     /// exported.
     QSet<CrateId> crateIdsToExport;
+
+    /// The number of music files that are copied concurrently.
+    int ioDepth = 1;
 };
 
 } // namespace mixxx
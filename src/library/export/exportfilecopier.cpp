@@ -0,0 +1,176 @@
+#include "library/export/exportfilecopier.h"
+
+#include <QCryptographicHash>
+#include <QFile>
+#include <QFileInfo>
+#include <QObject>
+#include <QSaveFile>
+#include <QtConcurrentRun>
+
+#include "util/compatibility/qmutex.h"
+#include "util/logger.h"
+#include "util/math.h"
+
+namespace {
+
+const mixxx::Logger kLogger("ExportFileCopier");
+
+constexpr qint64 kCopyBufferSize = 1024 * 1024;
+
+QByteArray hashFile(const QString& filePath) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    if (!hash.addData(&file)) {
+        return QByteArray();
+    }
+    return hash.result();
+}
+
+} // anonymous namespace
+
+namespace mixxx {
+
+double ExportFileCopier::Stats::bytesPerSecond() const {
+    const double seconds = elapsed.toDoubleSeconds();
+    if (seconds <= 0) {
+        return 0;
+    }
+    return copiedBytes / seconds;
+}
+
+ExportFileCopier::ExportFileCopier(int ioDepth)
+        : m_ioDepth(math_max(ioDepth, 1)),
+          m_ioSlots(m_ioDepth) {
+    m_threadPool.setMaxThreadCount(m_ioDepth);
+    m_timer.start();
+}
+
+ExportFileCopier::~ExportFileCopier() {
+    waitForDone();
+}
+
+// static
+bool ExportFileCopier::isIdentical(
+        const QString& sourcePath,
+        const QString& destPath,
+        IdenticalCheck identicalCheck) {
+    const QFileInfo sourceFileInfo(sourcePath);
+    const QFileInfo destFileInfo(destPath);
+    if (identicalCheck == IdenticalCheck::None || !destFileInfo.exists() ||
+            sourceFileInfo.size() != destFileInfo.size()) {
+        return false;
+    }
+    switch (identicalCheck) {
+    case IdenticalCheck::None:
+        break;
+    case IdenticalCheck::SizeAndModificationTime:
+        return sourceFileInfo.lastModified() <= destFileInfo.lastModified();
+    case IdenticalCheck::SizeAndHash: {
+        const QByteArray sourceHash = hashFile(sourcePath);
+        return !sourceHash.isEmpty() && sourceHash == hashFile(destPath);
+    }
+    }
+    DEBUG_ASSERT(!"unreachable");
+    return false;
+}
+
+// static
+QString ExportFileCopier::copyFile(
+        const QString& sourcePath,
+        const QString& destPath) {
+    QFile sourceFile(sourcePath);
+    if (!sourceFile.open(QIODevice::ReadOnly)) {
+        return sourceFile.errorString();
+    }
+    // The contents are written into a temporary file that
+    // replaces the destination file when committed
+    QSaveFile destFile(destPath);
+    if (!destFile.open(QIODevice::WriteOnly)) {
+        return destFile.errorString();
+    }
+    QByteArray buffer(static_cast<int>(kCopyBufferSize), Qt::Uninitialized);
+    while (!sourceFile.atEnd()) {
+        const qint64 bytesRead = sourceFile.read(buffer.data(), buffer.size());
+        if (bytesRead < 0) {
+            destFile.cancelWriting();
+            return sourceFile.errorString();
+        }
+        if (destFile.write(buffer.constData(), bytesRead) != bytesRead) {
+            destFile.cancelWriting();
+            return destFile.errorString();
+        }
+    }
+    if (!destFile.commit()) {
+        return destFile.errorString();
+    }
+    return QString();
+}
+
+QFuture<QString> ExportFileCopier::copy(
+        const QString& sourcePath,
+        const QString& destPath,
+        IdenticalCheck identicalCheck) {
+    m_ioSlots.acquire();
+    return QtConcurrent::run(&m_threadPool, [this, sourcePath, destPath, identicalCheck] {
+        QString error = errorMessage();
+        if (!error.isEmpty()) {
+            // Files that are still queued after an error are
+            // not copied and fail with the same error
+            m_ioSlots.release();
+            return error;
+        }
+        if (isIdentical(sourcePath, destPath, identicalCheck)) {
+            kLogger.debug() << "Skipping identical file" << destPath;
+            m_identicalFiles.fetchAndAddRelaxed(1);
+            m_ioSlots.release();
+            return error;
+        }
+        kLogger.debug() << "Copying" << sourcePath << "to" << destPath;
+        error = copyFile(sourcePath, destPath);
+        if (error.isEmpty()) {
+            finishCopy(error, QFileInfo(destPath).size());
+        } else {
+            error = QObject::tr("Error exporting track %1 to %2: %3.")
+                            .arg(sourcePath, destPath, error);
+            finishCopy(error, 0);
+        }
+        return error;
+    });
+}
+
+void ExportFileCopier::finishCopy(const QString& errorMessage, qint64 bytes) {
+    if (errorMessage.isEmpty()) {
+        m_copiedFiles.fetchAndAddRelaxed(1);
+        m_copiedBytes.fetchAndAddRelaxed(bytes);
+    } else {
+        kLogger.warning() << errorMessage;
+        const auto locked = lockMutex(&m_mutex);
+        if (m_errorMessage.isEmpty()) {
+            m_errorMessage = errorMessage;
+        }
+    }
+    m_ioSlots.release();
+}
+
+void ExportFileCopier::waitForDone() {
+    m_threadPool.waitForDone();
+}
+
+QString ExportFileCopier::errorMessage() const {
+    const auto locked = lockMutex(&m_mutex);
+    return m_errorMessage;
+}
+
+ExportFileCopier::Stats ExportFileCopier::stats() const {
+    Stats stats;
+    stats.copiedFiles = m_copiedFiles.loadAcquire();
+    stats.identicalFiles = m_identicalFiles.loadAcquire();
+    stats.copiedBytes = m_copiedBytes.loadAcquire();
+    stats.elapsed = m_timer.elapsed();
+    return stats;
+}
+
+} // namespace mixxx
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <QAtomicInteger>
+#include <QFuture>
+#include <QMutex>
+#include <QSemaphore>
+#include <QString>
+#include <QThreadPool>
+
+#include "util/performancetimer.h"
+
+namespace mixxx {
+
+/// Copies the files of an export concurrently.
+///
+/// Writing to slow target devices like USB drives dominates the time
+/// that is needed for exporting tracks. Multiple files are copied at
+/// once on a dedicated thread pool to keep the device busy. The number
+/// of concurrent copies, i.e. the I/O depth, is limited and copy()
+/// blocks the calling thread until a slot becomes available.
+///
+/// Files are first written into a temporary file next to the destination
+/// that is renamed after it has been written completely. An interrupted
+/// export never leaves truncated files behind and can simply be resumed
+/// by exporting the same tracks again, skipping all files that are
+/// identical to their source.
+class ExportFileCopier final {
+  public:
+    enum class IdenticalCheck {
+        /// Always copies the file, e.g. if it is already known
+        /// that the destination file differs.
+        None,
+        /// Compares the size and requires that the destination file is
+        /// not older than the source file. Doesn't need to read the files.
+        SizeAndModificationTime,
+        /// Compares the size and the hash of the contents.
+        SizeAndHash,
+    };
+
+    struct Stats {
+        int copiedFiles = 0;
+        int identicalFiles = 0;
+        qint64 copiedBytes = 0;
+        Duration elapsed;
+
+        double bytesPerSecond() const;
+    };
+
+    explicit ExportFileCopier(int ioDepth);
+    /// Waits for all pending copies.
+    ~ExportFileCopier();
+
+    /// Checks if the destination file exists and is identical to the
+    /// source file.
+    static bool isIdentical(
+            const QString& sourcePath,
+            const QString& destPath,
+            IdenticalCheck identicalCheck);
+
+    /// Copies a file synchronously, replacing an existing file. Returns
+    /// an empty string on success or a message describing the error.
+    static QString copyFile(
+            const QString& sourcePath,
+            const QString& destPath);
+
+    /// Skips the copy if the destination file is identical. Otherwise
+    /// the file is copied asynchronously. The result of the future is
+    /// the error message if the copy has failed or an empty string.
+    QFuture<QString> copy(
+            const QString& sourcePath,
+            const QString& destPath,
+            IdenticalCheck identicalCheck);
+
+    /// Blocks until all pending copies have finished.
+    void waitForDone();
+
+    /// The message of the first copy that has failed or an empty string.
+    /// No more files are copied after an error.
+    QString errorMessage() const;
+
+    Stats stats() const;
+
+  private:
+    void finishCopy(const QString& errorMessage, qint64 bytes);
+
+    const int m_ioDepth;
+    QThreadPool m_threadPool;
+    QSemaphore m_ioSlots;
+
+    mutable QMutex m_mutex;
+    QString m_errorMessage;
+
+    QAtomicInteger<int> m_copiedFiles;
+    QAtomicInteger<int> m_identicalFiles;
+    QAtomicInteger<qint64> m_copiedBytes;
+    PerformanceTimer m_timer;
+};
+
+} // namespace mixxx
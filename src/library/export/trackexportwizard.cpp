@@ -5,6 +5,7 @@
 #include <QMessageBox>
 #include <QStandardPaths>
 
+#include "library/library_prefs.h"
 #include "moc_trackexportwizard.cpp"
 #include "util/assert.h"
 
@@ -29,7 +30,10 @@ bool TrackExportWizard::selectDestinationDirectory() {
     m_pConfig->set(ConfigKey("[Library]", "LastTrackCopyDirectory"),
                    ConfigValue(destDir));
 
-    m_worker.reset(new TrackExportWorker(destDir, m_tracks));
+    const int ioDepth = m_pConfig->getValue(
+            mixxx::library::prefs::kExportIoDepthConfigKey,
+            mixxx::library::prefs::kExportIoDepthDefault);
+    m_worker.reset(new TrackExportWorker(destDir, m_tracks, ioDepth));
     m_dialog.reset(new TrackExportDlg(m_parent, m_pConfig, m_worker.data()));
     return true;
 }
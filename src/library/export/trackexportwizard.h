@@ -14,13 +14,13 @@
 #include "library/export/trackexportdlg.h"
 #include "library/export/trackexportworker.h"
 #include "preferences/usersettings.h"
-#include "track/track_decl.h"
+#include "track/tracksnapshot.h"
 
 // A controller class for creating the export worker and UI.
 class TrackExportWizard : public QObject {
   Q_OBJECT
   public:
-    TrackExportWizard(QWidget* parent, UserSettingsPointer pConfig, const TrackPointerList& tracks)
+    TrackExportWizard(QWidget* parent, UserSettingsPointer pConfig, const TrackSnapshotList& tracks)
             : m_parent(parent), m_pConfig(pConfig), m_tracks(tracks) {
     }
     virtual ~TrackExportWizard() { }
@@ -34,7 +34,7 @@ class TrackExportWizard : public QObject {
 
     QWidget* m_parent;
     UserSettingsPointer m_pConfig;
-    TrackPointerList m_tracks;
+    TrackSnapshotList m_tracks;
     QScopedPointer<TrackExportDlg> m_dialog;
     QScopedPointer<TrackExportWorker> m_worker;
 };
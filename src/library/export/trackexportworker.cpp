@@ -5,7 +5,6 @@
 #include <QMessageBox>
 
 #include "moc_trackexportworker.cpp"
-#include "track/track.h"
 
 namespace {
 
@@ -21,13 +20,13 @@ QString rewriteFilename(const mixxx::FileInfo& fileinfo, int index) {
 // and skips if they refer to the same disk location.  Returns a map from
 // QString (the destination possibly-munged filenames) to QFileInfo (the source
 // file information).
-QMap<QString, mixxx::FileInfo> createCopylist(const TrackPointerList& tracks) {
+QMap<QString, mixxx::FileInfo> createCopylist(const TrackSnapshotList& tracks) {
     // QMap is a non-obvious return value, but it's easy for callers to use
     // in practice and is the best object for producing the final list
     // efficiently.
     QMap<QString, mixxx::FileInfo> copylist;
-    for (const auto& pTrack : tracks) {
-        auto fileInfo = pTrack->getFileInfo();
+    for (const auto& track : tracks) {
+        auto fileInfo = track.fileInfo();
         if (fileInfo.resolveCanonicalLocation().isEmpty()) {
             qWarning()
                     << "File not found or inaccessible while exporting"
@@ -69,80 +68,103 @@ QMap<QString, mixxx::FileInfo> createCopylist(const TrackPointerList& tracks) {
 }  // namespace
 
 void TrackExportWorker::run() {
-    int i = 0;
-    QMap<QString, mixxx::FileInfo> copy_list = createCopylist(m_tracks);
+    const QMap<QString, mixxx::FileInfo> copy_list = createCopylist(m_tracks);
+    m_copyCount = copy_list.size();
+    m_finishedCopyCount = 0;
+    mixxx::ExportFileCopier copier(m_ioDepth);
+    // Emit a sane progress before we start. Afterwards each file gets its
+    // own visible tick on the bar when its copy has finished.
+    if (!copy_list.isEmpty()) {
+        emit progress(copy_list.first().fileName(), 0, m_copyCount);
+    }
     for (auto it = copy_list.constBegin(); it != copy_list.constEnd(); ++it) {
-        // We emit progress twice per loop, which may seem excessive, but it
-        // guarantees that we emit a sane progress before we start and after
-        // we end.  In between, each filename will get its own visible tick
-        // on the bar, which looks really nice.
-        emit progress(it->fileName(), i, copy_list.size());
-        copyFile(*it, it.key());
+        m_pendingCopies.append(PendingCopy{
+                it->fileName(),
+                copyFile(&copier, *it, it.key())});
+        finishPendingCopies(false);
         if (m_bStop.loadAcquire()) {
-            emit canceled();
-            return;
+            break;
+        }
+    }
+    // Pending copies are not interrupted when canceled
+    finishPendingCopies(true);
+    if (m_bStop.loadAcquire()) {
+        emit canceled();
+        return;
+    }
+
+    const auto stats = copier.stats();
+    qInfo() << "Exported" << stats.copiedFiles << "files with"
+            << stats.copiedBytes / (1024 * 1024) << "MiB in"
+            << stats.elapsed.formatSecondsWithUnit()
+            << QString("(%1 MiB/s),").arg(stats.bytesPerSecond() / (1024 * 1024), 0, 'f', 1)
+            << "skipped" << stats.identicalFiles << "identical files";
+}
+
+void TrackExportWorker::finishPendingCopies(bool waitForAll) {
+    auto it = m_pendingCopies.begin();
+    while (it != m_pendingCopies.end()) {
+        if (!waitForAll && !it->future.isFinished()) {
+            ++it;
+            continue;
         }
-        ++i;
-        emit progress(it->fileName(), i, copy_list.size());
+        it->future.waitForFinished();
+        if (!it->future.isCanceled()) {
+            const QString error_message = it->future.result();
+            if (!error_message.isEmpty() && !m_bStop.loadAcquire()) {
+                m_errorMessage = error_message + QChar(' ') + tr("Stopping.");
+                stop();
+            }
+        }
+        ++m_finishedCopyCount;
+        emit progress(it->fileName, m_finishedCopyCount, m_copyCount);
+        it = m_pendingCopies.erase(it);
     }
 }
 
-void TrackExportWorker::copyFile(
+QFuture<QString> TrackExportWorker::copyFile(
+        mixxx::ExportFileCopier* pCopier,
         const mixxx::FileInfo& source_fileinfo,
         const QString& dest_filename) {
     QString sourceFilename = source_fileinfo.canonicalLocation();
     const QString dest_path = QDir(m_destDir).filePath(dest_filename);
     QFileInfo dest_fileinfo(dest_path);
 
+    // Copies of previous, possibly interrupted exports are skipped
+    auto identicalCheck = mixxx::ExportFileCopier::IdenticalCheck::SizeAndHash;
     if (dest_fileinfo.exists()) {
         switch (m_overwriteMode) {
         // Give the user the option to overwrite existing files in the destination.
         case OverwriteMode::ASK:
+            if (mixxx::ExportFileCopier::isIdentical(
+                        sourceFilename, dest_path, identicalCheck)) {
+                qDebug() << "skipping identical" << sourceFilename;
+                return QFuture<QString>();
+            }
             switch (makeOverwriteRequest(dest_path)) {
             case OverwriteAnswer::SKIP:
             case OverwriteAnswer::SKIP_ALL:
                 qDebug() << "skipping" << sourceFilename;
-                return;
+                return QFuture<QString>();
             case OverwriteAnswer::OVERWRITE:
             case OverwriteAnswer::OVERWRITE_ALL:
+                identicalCheck = mixxx::ExportFileCopier::IdenticalCheck::None;
                 break;
             case OverwriteAnswer::CANCEL:
                 m_errorMessage = tr("Export process was canceled");
                 stop();
-                return;
+                return QFuture<QString>();
             }
             break;
         case OverwriteMode::SKIP_ALL:
             qDebug() << "skipping" << sourceFilename;
-            return;
+            return QFuture<QString>();
         case OverwriteMode::OVERWRITE_ALL:;
         }
-
-        // Remove the existing file in preparation for overwriting.
-        QFile dest_file(dest_path);
-        qDebug() << "Removing existing file" << dest_path;
-        if (!dest_file.remove()) {
-            const QString error_message = tr(
-                    "Error removing file %1: %2. Stopping.").arg(
-                    dest_path, dest_file.errorString());
-            qWarning() << error_message;
-            m_errorMessage = error_message;
-            stop();
-            return;
-        }
     }
 
-    qDebug() << "Copying" << sourceFilename << "to" << dest_path;
-    QFile source_file(sourceFilename);
-    if (!source_file.copy(dest_path)) {
-        const QString error_message = tr(
-                "Error exporting track %1 to %2: %3. Stopping.").arg(
-                sourceFilename, dest_path, source_file.errorString());
-        qWarning() << error_message;
-        m_errorMessage = error_message;
-        stop();
-        return;
-    }
+    // The existing file is replaced after the copy has been written completely.
+    return pCopier->copy(sourceFilename, dest_path, identicalCheck);
 }
 
 TrackExportWorker::OverwriteAnswer TrackExportWorker::makeOverwriteRequest(
@@ -1,12 +1,16 @@
 #pragma once
 
+#include <QFuture>
+#include <QList>
 #include <QObject>
 #include <QScopedPointer>
 #include <QString>
 #include <QThread>
 #include <future>
 
-#include "track/track_decl.h"
+#include "library/export/exportfilecopier.h"
+#include "library/library_prefs.h"
+#include "track/tracksnapshot.h"
 #include "util/fileinfo.h"
 
 // A QThread class for copying a list of files to a single destination directory.
@@ -33,9 +37,15 @@ class TrackExportWorker : public QThread {
     };
 
     // Constructor does not validate the destination directory.  Calling classes
-    // should do that.
-    TrackExportWorker(const QString& destDir, const TrackPointerList& tracks)
-            : m_destDir(destDir), m_tracks(tracks) {
+    // should do that. Only the locations of the tracks are needed, so
+    // snapshots are sufficient and no Track objects need to be loaded.
+    // Up to ioDepth files are copied concurrently.
+    TrackExportWorker(const QString& destDir,
+            const TrackSnapshotList& tracks,
+            int ioDepth = mixxx::library::prefs::kExportIoDepthDefault)
+            : m_destDir(destDir),
+              m_tracks(tracks),
+              m_ioDepth(ioDepth) {
     }
     virtual ~TrackExportWorker() { };
 
@@ -65,14 +75,27 @@ class TrackExportWorker : public QThread {
     void canceled();
 
   private:
+    struct PendingCopy {
+        QString fileName;
+        // Canceled if the file is not copied
+        QFuture<QString> future;
+    };
+
     // Copies the file at source_fileinfo to the destination directory with the
     // name given by dest_filename (not a full path).  If the destination file
-    // exists, will emit an overwrite request signal to ask how to proceed.
-    // On unrecoverable error, sets the error message and stops the export
-    // process entirely.
-    void copyFile(const mixxx::FileInfo& source_fileinfo,
+    // exists and is not identical, will emit an overwrite request signal to ask
+    // how to proceed. The copy itself is performed asynchronously by pCopier
+    // and the returned future finishes when it is done. On unrecoverable
+    // error, sets the error message and stops the export process entirely.
+    QFuture<QString> copyFile(mixxx::ExportFileCopier* pCopier,
+            const mixxx::FileInfo& source_fileinfo,
             const QString& dest_filename);
 
+    // Emits the progress of all pending copies that have finished, or
+    // blocks until all of them have finished if waitForAll is set. Stops
+    // the export after the first failed copy.
+    void finishPendingCopies(bool waitForAll);
+
     // Emit a signal requesting overwrite mode, and block until we get an
     // answer.  Updates m_overwriteMode appropriately.
     OverwriteAnswer makeOverwriteRequest(const QString& filename);
@@ -81,6 +104,10 @@ class TrackExportWorker : public QThread {
     QString m_errorMessage;
 
     OverwriteMode m_overwriteMode = OverwriteMode::ASK;
+    QList<PendingCopy> m_pendingCopies;
+    int m_finishedCopyCount = 0;
+    int m_copyCount = 0;
     const QString m_destDir;
-    const TrackPointerList m_tracks;
+    const TrackSnapshotList m_tracks;
+    const int m_ioDepth;
 };
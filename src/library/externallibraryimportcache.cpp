@@ -0,0 +1,219 @@
+#include "library/externallibraryimportcache.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QStringList>
+#include <algorithm>
+
+#include "library/treeitem.h"
+#include "util/assert.h"
+#include "util/logger.h"
+#include "util/mappedfile.h"
+
+namespace {
+
+const mixxx::Logger kLogger("ExternalLibraryImportCache");
+
+constexpr QDataStream::Version kDataStreamVersion = QDataStream::Qt_5_12;
+
+// Protects against corrupt settings
+constexpr int kMaxTreeDepth = 64;
+
+constexpr int kHashChunkSize = 1 << 20;
+
+void writeTreeItem(QDataStream& stream, const TreeItem* pItem) {
+    stream << pItem->getLabel() << pItem->getData()
+           << static_cast<qint32>(pItem->childRows());
+    for (const auto* pChild : pItem->children()) {
+        writeTreeItem(stream, pChild);
+    }
+}
+
+bool readChildren(QDataStream& stream, TreeItem* pParent, qint32 childCount, int depth) {
+    if (depth > kMaxTreeDepth) {
+        return false;
+    }
+    for (qint32 i = 0; i < childCount; ++i) {
+        QString label;
+        QVariant data;
+        qint32 grandChildCount;
+        stream >> label >> data >> grandChildCount;
+        if (stream.status() != QDataStream::Ok || grandChildCount < 0) {
+            return false;
+        }
+        TreeItem* pChild = pParent->appendChild(std::move(label), std::move(data));
+        if (!readChildren(stream, pChild, grandChildCount, depth + 1)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+// static
+ExternalLibraryImportCache::FileSignature
+ExternalLibraryImportCache::FileSignature::ofFile(const QString& filePath) {
+    const QFileInfo fileInfo(filePath);
+    FileSignature signature;
+    if (fileInfo.exists()) {
+        signature.size = fileInfo.size();
+        signature.lastModifiedMs = fileInfo.lastModified().toMSecsSinceEpoch();
+    }
+    return signature;
+}
+
+// static
+QByteArray ExternalLibraryImportCache::FileSignature::hashContent(const QString& filePath) {
+    mixxx::MappedFile file(filePath);
+    if (!file.open()) {
+        return QByteArray();
+    }
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    if (file.isMapped()) {
+        const QByteArray& data = file.data();
+        for (int offset = 0; offset < data.size(); offset += kHashChunkSize) {
+            hash.addData(QByteArray::fromRawData(data.constData() + offset,
+                    std::min(kHashChunkSize, data.size() - offset)));
+        }
+    } else if (!hash.addData(file.device())) {
+        return QByteArray();
+    }
+    return hash.result();
+}
+
+QString ExternalLibraryImportCache::FileSignature::toString() const {
+    return QStringLiteral("%1;%2;%3")
+            .arg(QString::number(size),
+                    QString::number(lastModifiedMs),
+                    QString::fromLatin1(contentHash.toHex()));
+}
+
+// static
+ExternalLibraryImportCache::FileSignature
+ExternalLibraryImportCache::FileSignature::fromString(const QString& str) {
+    const QStringList parts = str.split(QChar(';'));
+    if (parts.size() != 3) {
+        return FileSignature();
+    }
+    bool sizeOk = false;
+    bool lastModifiedOk = false;
+    FileSignature signature;
+    signature.size = parts[0].toLongLong(&sizeOk);
+    signature.lastModifiedMs = parts[1].toLongLong(&lastModifiedOk);
+    signature.contentHash = QByteArray::fromHex(parts[2].toLatin1());
+    if (!sizeOk || !lastModifiedOk || signature.contentHash.isEmpty()) {
+        return FileSignature();
+    }
+    return signature;
+}
+
+ExternalLibraryImportCache::ExternalLibraryImportCache(
+        const QSqlDatabase& database,
+        const QString& settingsKey)
+        : m_settings(database),
+          m_pathKey(settingsKey + QStringLiteral(".path")),
+          m_signatureKey(settingsKey + QStringLiteral(".signature")),
+          m_treeKey(settingsKey + QStringLiteral(".tree")) {
+}
+
+std::unique_ptr<TreeItem> ExternalLibraryImportCache::restore(
+        const QString& filePath,
+        LibraryFeature* pFeature) {
+    m_filePath = filePath;
+    m_fileSignature = FileSignature::ofFile(filePath);
+    if (!m_fileSignature.isValid()) {
+        return nullptr;
+    }
+    if (m_settings.getValue(m_pathKey) != filePath) {
+        return nullptr;
+    }
+    const FileSignature storedSignature =
+            FileSignature::fromString(m_settings.getValue(m_signatureKey));
+    if (!storedSignature.isValid() || storedSignature.size != m_fileSignature.size) {
+        return nullptr;
+    }
+    if (storedSignature.lastModifiedMs != m_fileSignature.lastModifiedMs) {
+        // The content may still be the same, e.g. if the file has been
+        // touched or saved again without any changes
+        m_fileSignature.contentHash = FileSignature::hashContent(filePath);
+        if (m_fileSignature.contentHash != storedSignature.contentHash) {
+            return nullptr;
+        }
+        // Skip hashing next time
+        m_settings.setValue(m_signatureKey, m_fileSignature.toString());
+    } else {
+        m_fileSignature.contentHash = storedSignature.contentHash;
+    }
+    auto pRootItem = deserializeTree(
+            QByteArray::fromBase64(m_settings.getValue(m_treeKey).toLatin1()),
+            pFeature);
+    if (!pRootItem) {
+        kLogger.warning() << "Failed to restore the sidebar of" << filePath;
+        return nullptr;
+    }
+    kLogger.info() << "Reusing the last import of" << filePath;
+    return pRootItem;
+}
+
+void ExternalLibraryImportCache::invalidate() const {
+    m_settings.setValue(m_signatureKey, QString());
+    m_settings.setValue(m_treeKey, QString());
+}
+
+void ExternalLibraryImportCache::store(
+        const QString& filePath,
+        const TreeItem* pRootItem) {
+    VERIFY_OR_DEBUG_ASSERT(pRootItem) {
+        return;
+    }
+    if (filePath != m_filePath || !m_fileSignature.isValid()) {
+        m_filePath = filePath;
+        m_fileSignature = FileSignature::ofFile(filePath);
+        if (!m_fileSignature.isValid()) {
+            return;
+        }
+    }
+    if (m_fileSignature.contentHash.isEmpty()) {
+        m_fileSignature.contentHash = FileSignature::hashContent(filePath);
+        if (m_fileSignature.contentHash.isEmpty()) {
+            return;
+        }
+    }
+    m_settings.setValue(m_pathKey, filePath);
+    m_settings.setValue(m_signatureKey, m_fileSignature.toString());
+    m_settings.setValue(m_treeKey,
+            QString::fromLatin1(serializeTree(pRootItem).toBase64()));
+}
+
+// static
+QByteArray ExternalLibraryImportCache::serializeTree(const TreeItem* pRootItem) {
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(kDataStreamVersion);
+    writeTreeItem(stream, pRootItem);
+    return data;
+}
+
+// static
+std::unique_ptr<TreeItem> ExternalLibraryImportCache::deserializeTree(
+        const QByteArray& data,
+        LibraryFeature* pFeature) {
+    QDataStream stream(data);
+    stream.setVersion(kDataStreamVersion);
+    // The label and data of the invisible root item are not restored
+    QString label;
+    QVariant rootData;
+    qint32 childCount;
+    stream >> label >> rootData >> childCount;
+    if (stream.status() != QDataStream::Ok || childCount < 0) {
+        return nullptr;
+    }
+    auto pRootItem = TreeItem::newRoot(pFeature);
+    if (!readChildren(stream, pRootItem.get(), childCount, 0)) {
+        return nullptr;
+    }
+    return pRootItem;
+}
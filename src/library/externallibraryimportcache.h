@@ -0,0 +1,72 @@
+#pragma once
+
+#include <QByteArray>
+#include <QSqlDatabase>
+#include <QString>
+#include <memory>
+
+#include "library/dao/settingsdao.h"
+
+class LibraryFeature;
+class TreeItem;
+
+/// Skips the import of an external library file like the iTunes XML or
+/// the Traktor collection if it didn't change since the last import.
+///
+/// The tables of these features persist in the database. After a complete
+/// import the signature of the file and the sidebar tree built while
+/// parsing it are stored in the library settings. On the next activation
+/// the tables and the tree are reused if the file is unchanged.
+class ExternalLibraryImportCache final {
+  public:
+    struct FileSignature {
+        qint64 size = -1;
+        qint64 lastModifiedMs = -1;
+        // Only computed if size and modification time are not sufficient
+        QByteArray contentHash;
+
+        bool isValid() const {
+            return size >= 0;
+        }
+
+        /// Without the content hash
+        static FileSignature ofFile(const QString& filePath);
+        static QByteArray hashContent(const QString& filePath);
+
+        QString toString() const;
+        static FileSignature fromString(const QString& str);
+    };
+
+    ExternalLibraryImportCache(
+            const QSqlDatabase& database,
+            const QString& settingsKey);
+
+    /// Returns the sidebar tree of the last import of this file or nullptr
+    /// if it needs to be imported. The content is only hashed if the size
+    /// matches, but the modification time differs, e.g. after copying it.
+    std::unique_ptr<TreeItem> restore(
+            const QString& filePath,
+            LibraryFeature* pFeature);
+
+    /// Must be invoked before modifying the imported tables.
+    void invalidate() const;
+
+    /// Must be invoked after the file has been imported completely.
+    void store(
+            const QString& filePath,
+            const TreeItem* pRootItem);
+
+    static QByteArray serializeTree(const TreeItem* pRootItem);
+    static std::unique_ptr<TreeItem> deserializeTree(
+            const QByteArray& data,
+            LibraryFeature* pFeature);
+
+  private:
+    const SettingsDAO m_settings;
+    const QString m_pathKey;
+    const QString m_signatureKey;
+    const QString m_treeKey;
+
+    QString m_filePath;
+    FileSignature m_fileSignature;
+};
@@ -13,11 +13,13 @@
 #include "library/baseexternaltrackmodel.h"
 #include "library/basetrackcache.h"
 #include "library/dao/settingsdao.h"
+#include "library/externallibraryimportcache.h"
 #include "library/library.h"
 #include "library/queryutil.h"
 #include "library/trackcollectionmanager.h"
 #include "moc_itunesfeature.cpp"
 #include "util/lcs.h"
+#include "util/mappedfile.h"
 #include "util/sandbox.h"
 #include "widget/wlibrarysidebar.h"
 
@@ -30,6 +32,7 @@
 namespace {
 
 const QString ITDB_PATH_KEY = "mixxx.itunesfeature.itdbpath";
+const QString kImportCacheKey = QStringLiteral("mixxx.itunesfeature.import");
 
 const QString kDict = "dict";
 const QString kKey = "key";
@@ -166,13 +169,10 @@ void ITunesFeature::activate() {
 void ITunesFeature::activate(bool forceReload) {
     //qDebug("ITunesFeature::activate()");
     if (!m_isActivated || forceReload) {
-
-        //Delete all table entries of iTunes feature
-        ScopedTransaction transaction(m_database);
-        clearTable("itunes_playlist_tracks");
-        clearTable("itunes_library");
-        clearTable("itunes_playlists");
-        transaction.commit();
+        if (forceReload) {
+            // The tables are cleared before parsing
+            ExternalLibraryImportCache(m_database, kImportCacheKey).invalidate();
+        }
 
         emit showTrackModel(m_pITunesTrackModel);
 
@@ -382,7 +382,21 @@ TreeItem* ITunesFeature::importLibrary() {
 
     qDebug() << "ITunesFeature::importLibrary() ";
 
+    // The tables persist between sessions, skip parsing if the
+    // file has not changed since the last import
+    ExternalLibraryImportCache importCache(m_database, kImportCacheKey);
+    std::unique_ptr<TreeItem> pCachedRoot = importCache.restore(m_dbfile, this);
+    if (pCachedRoot) {
+        return pCachedRoot.release();
+    }
+
     ScopedTransaction transaction(m_database);
+    importCache.invalidate();
+
+    //Delete all table entries of iTunes feature
+    clearTable("itunes_playlist_tracks");
+    clearTable("itunes_library");
+    clearTable("itunes_playlists");
 
     // By default set m_mixxxItunesRoot and m_dbItunesRoot to strip out
     // file://localhost/ from the URL. When we load the user's iTunes XML
@@ -393,13 +407,13 @@ TreeItem* ITunesFeature::importLibrary() {
     m_dbItunesRoot = localhost_token();
 
     //Parse iTunes XML file using SAX (for performance)
-    QFile itunes_file(m_dbfile);
-    if (!itunes_file.open(QIODevice::ReadOnly)) {
+    mixxx::MappedFile itunes_file(m_dbfile);
+    if (!itunes_file.open()) {
         qDebug() << "Cannot open iTunes music collection";
         return nullptr;
     }
 
-    QXmlStreamReader xml(&itunes_file);
+    QXmlStreamReader xml(itunes_file.device());
     TreeItem* playlist_root = nullptr;
     while (!xml.atEnd() && !m_cancelImport) {
         xml.readNext();
@@ -455,6 +469,8 @@ TreeItem* ITunesFeature::importLibrary() {
             delete playlist_root;
         }
         playlist_root = nullptr;
+    } else if (playlist_root && !m_cancelImport) {
+        importCache.store(m_dbfile, playlist_root);
     }
     return playlist_root;
 }
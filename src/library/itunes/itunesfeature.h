@@ -37,6 +37,8 @@ class ITunesFeature : public BaseExternalLibraryFeature {
     void onTrackCollectionLoaded();
 
   private:
+    friend class ExternalLibraryImportBenchmark;
+
     BaseSqlTableModel* getPlaylistModelForPlaylist(const QString& playlist) override;
     static QString getiTunesMusicPath();
     // returns the invisible rootItem for the sidebar model
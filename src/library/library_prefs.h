@@ -40,6 +40,11 @@ extern const ConfigKey kSyncSeratoMetadataConfigKey;
 
 extern const ConfigKey kUseRelativePathOnExportConfigKey;
 
+/// The number of files that are copied concurrently when exporting tracks
+extern const ConfigKey kExportIoDepthConfigKey;
+
+const int kExportIoDepthDefault = 4;
+
 } // namespace prefs
 
 } // namespace library
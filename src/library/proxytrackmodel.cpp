@@ -103,6 +103,10 @@ bool ProxyTrackModel::isColumnHiddenByDefault(int column) {
     return m_pTrackModel ? m_pTrackModel->isColumnHiddenByDefault(column) : false;
 }
 
+bool ProxyTrackModel::isSelectPending() const {
+    return m_pTrackModel ? m_pTrackModel->isSelectPending() : false;
+}
+
 void ProxyTrackModel::removeTracks(const QModelIndexList& indices) {
     QModelIndexList translatedList;
     foreach (QModelIndex index, indices) {
@@ -35,6 +35,7 @@ class ProxyTrackModel : public QSortFilterProxyModel, public TrackModel {
     const QString currentSearch() const final;
     bool isColumnInternal(int column) final;
     bool isColumnHiddenByDefault(int column) final;
+    bool isSelectPending() const final;
     void removeTracks(const QModelIndexList& indices) final;
     void moveTrack(const QModelIndex& sourceIndex, const QModelIndex& destIndex) final;
     QAbstractItemDelegate* delegateForColumn(const int i, QObject* pParent) final;
@@ -545,6 +545,13 @@ TrackPointer TrackCollection::getTrackById(
     return m_trackDao.getTrackById(trackId);
 }
 
+TrackPointerList TrackCollection::getTracksById(
+        const QList<TrackId>& trackIds) const {
+    DEBUG_ASSERT_QOBJECT_THREAD_AFFINITY(this);
+
+    return m_trackDao.getTracksById(trackIds);
+}
+
 TrackPointer TrackCollection::getTrackByRef(
         const TrackRef& trackRef) const {
     DEBUG_ASSERT_QOBJECT_THREAD_AFFINITY(this);
@@ -552,6 +559,13 @@ TrackPointer TrackCollection::getTrackByRef(
     return m_trackDao.getTrackByRef(trackRef);
 }
 
+TrackSnapshotList TrackCollection::getTrackSnapshots(
+        const QList<TrackId>& trackIds) const {
+    DEBUG_ASSERT_QOBJECT_THREAD_AFFINITY(this);
+
+    return m_trackDao.getTrackSnapshots(trackIds);
+}
+
 TrackId TrackCollection::getTrackIdByRef(
         const TrackRef& trackRef) const {
     return m_trackDao.getTrackIdByRef(trackRef);
@@ -139,8 +139,12 @@ class TrackCollection : public QObject,
 
     TrackPointer getTrackById(
             TrackId trackId) const;
+    TrackPointerList getTracksById(
+            const QList<TrackId>& trackIds) const;
     TrackPointer getTrackByRef(
             const TrackRef& trackRef) const;
+    TrackSnapshotList getTrackSnapshots(
+            const QList<TrackId>& trackIds) const;
 
     TrackPointer getOrAddTrack(
             const TrackRef& trackRef,
@@ -41,6 +41,7 @@ TrackCollectionManager::TrackCollectionManager(
         deleteTrackFn_t /*only-needed-for-testing*/ deleteTrackForTestingFn)
     : QObject(parent),
       m_pConfig(pConfig),
+      m_pDbConnectionPool(pDbConnectionPool),
       m_pInternalCollection(createInternalTrackCollection(this, pConfig, deleteTrackForTestingFn)) {
     const QSqlDatabase dbConnection = mixxx::DbConnectionPooled(pDbConnectionPool);
 
@@ -569,12 +570,24 @@ TrackPointer TrackCollectionManager::getTrackById(
             trackId);
 }
 
+TrackPointerList TrackCollectionManager::getTracksById(
+        const QList<TrackId>& trackIds) const {
+    return internalCollection()->getTracksById(
+            trackIds);
+}
+
 TrackPointer TrackCollectionManager::getTrackByRef(
         const TrackRef& trackRef) const {
     return internalCollection()->getTrackByRef(
             trackRef);
 }
 
+TrackSnapshotList TrackCollectionManager::getTrackSnapshots(
+        const QList<TrackId>& trackIds) const {
+    return internalCollection()->getTrackSnapshots(
+            trackIds);
+}
+
 QList<TrackId> TrackCollectionManager::resolveTrackIdsFromUrls(
         const QList<QUrl>& urls,
         bool addMissing) const {
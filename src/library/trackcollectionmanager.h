@@ -8,6 +8,7 @@
 #include "library/relocatedtrack.h"
 #include "preferences/usersettings.h"
 #include "track/globaltrackcache.h"
+#include "track/tracksnapshot.h"
 #include "util/db/dbconnectionpool.h"
 #include "util/fileinfo.h"
 #include "util/parented_ptr.h"
@@ -47,10 +48,23 @@ class TrackCollectionManager: public QObject,
         return m_externalCollections;
     }
 
+    // For queries that are executed on a thread-local connection
+    // in a worker thread.
+    const mixxx::DbConnectionPoolPtr& dbConnectionPool() const {
+        return m_pDbConnectionPool;
+    }
+
     TrackPointer getTrackById(
             TrackId trackId) const;
+    /// Loads multiple tracks at once, see TrackDAO::getTracksById().
+    TrackPointerList getTracksById(
+            const QList<TrackId>& trackIds) const;
     TrackPointer getTrackByRef(
             const TrackRef& trackRef) const;
+    /// Snapshots for bulk operations that only need to read a few
+    /// properties of many tracks, see TrackDAO::getTrackSnapshots().
+    TrackSnapshotList getTrackSnapshots(
+            const QList<TrackId>& trackIds) const;
     QList<TrackId> resolveTrackIdsFromUrls(
             const QList<QUrl>& urls,
             bool addMissing) const;
@@ -121,6 +135,8 @@ class TrackCollectionManager: public QObject,
 
     const UserSettingsPointer m_pConfig;
 
+    const mixxx::DbConnectionPoolPtr m_pDbConnectionPool;
+
     const parented_ptr<TrackCollection> m_pInternalCollection;
 
     QList<ExternalTrackCollection*> m_externalCollections;
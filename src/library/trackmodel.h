@@ -214,6 +214,12 @@ class TrackModel {
     virtual void select() {
     }
 
+    /// Returns true while the results of search() or sort() are still
+    /// being fetched in the background and the rows are not updated yet.
+    virtual bool isSelectPending() const {
+        return false;
+    }
+
     /// @brief modelKey returns a unique identifier for the model
     /// @param noSearch don't include the current search in the key
     /// @param baseOnly return only a identifier for the whole subsystem
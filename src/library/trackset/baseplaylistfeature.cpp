@@ -614,11 +614,14 @@ void BasePlaylistFeature::slotExportTrackFiles() {
     pPlaylistTableModel->select();
 
     int rows = pPlaylistTableModel->rowCount();
-    TrackPointerList tracks;
+    QList<TrackId> trackIds;
+    trackIds.reserve(rows);
     for (int i = 0; i < rows; ++i) {
         QModelIndex index = pPlaylistTableModel->index(i, 0);
-        tracks.push_back(pPlaylistTableModel->getTrack(index));
+        trackIds.push_back(pPlaylistTableModel->getTrackId(index));
     }
+    const TrackSnapshotList tracks =
+            m_pLibrary->trackCollectionManager()->getTrackSnapshots(trackIds);
 
     TrackExportWizard track_export(nullptr, m_pConfig, tracks);
     track_export.exportTracks();
@@ -779,13 +779,16 @@ void CrateFeature::slotExportTrackFiles() {
     pCrateTableModel->select();
 
     int rows = pCrateTableModel->rowCount();
-    TrackPointerList trackpointers;
+    QList<TrackId> trackIds;
+    trackIds.reserve(rows);
     for (int i = 0; i < rows; ++i) {
         QModelIndex index = m_crateTableModel.index(i, 0);
-        trackpointers.push_back(m_crateTableModel.getTrack(index));
+        trackIds.push_back(m_crateTableModel.getTrackId(index));
     }
+    const TrackSnapshotList tracks =
+            m_pLibrary->trackCollectionManager()->getTrackSnapshots(trackIds);
 
-    TrackExportWizard track_export(nullptr, m_pConfig, trackpointers);
+    TrackExportWizard track_export(nullptr, m_pConfig, tracks);
     track_export.exportTracks();
 }
 
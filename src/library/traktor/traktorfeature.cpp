@@ -8,6 +8,7 @@
 #include <QXmlStreamReader>
 #include <QtDebug>
 
+#include "library/externallibraryimportcache.h"
 #include "library/library.h"
 #include "library/librarytablemodel.h"
 #include "library/missingtablemodel.h"
@@ -17,11 +18,14 @@
 #include "library/treeitem.h"
 #include "moc_traktorfeature.cpp"
 #include "track/keyutils.h"
+#include "util/mappedfile.h"
 #include "util/sandbox.h"
 #include "util/semanticversion.h"
 
 namespace {
 
+const QString kImportCacheKey = QStringLiteral("mixxx.traktorfeature.import");
+
 QString fromTraktorSeparators(QString path) {
     // Traktor uses /: instead of just / as delimiting character for some reasons
     return path.replace("/:", "/");
@@ -199,10 +203,25 @@ TreeItem* TraktorFeature::importLibrary(const QString& file) {
     //Give thread a low priority
     QThread* thisThread = QThread::currentThread();
     thisThread->setPriority(QThread::LowPriority);
+    // The collection must be accessible for checking if it has changed
+    mixxx::FileInfo fileInfo(file);
+    if (!Sandbox::askForAccess(&fileInfo)) {
+        qDebug() << "Cannot access Traktor music collection";
+        return nullptr;
+    }
+    // The tables persist between sessions, skip parsing if the
+    // collection has not changed since the last import
+    ExternalLibraryImportCache importCache(m_database, kImportCacheKey);
+    std::unique_ptr<TreeItem> pCachedRoot = importCache.restore(file, this);
+    if (pCachedRoot) {
+        return pCachedRoot.release();
+    }
+
     //Invisible root item of Traktor's child model
     TreeItem* root = nullptr;
     //Delete all table entries of Traktor feature
     ScopedTransaction transaction(m_database);
+    importCache.invalidate();
     clearTable("traktor_playlist_tracks");
     clearTable("traktor_library");
     clearTable("traktor_playlists");
@@ -217,13 +236,12 @@ TreeItem* TraktorFeature::importLibrary(const QString& file) {
                   ":rating,:key)");
 
     //Parse Trakor XML file using SAX (for performance)
-    mixxx::FileInfo fileInfo(file);
-    QFile traktor_file(file);
-    if (!Sandbox::askForAccess(&fileInfo) || !traktor_file.open(QIODevice::ReadOnly)) {
+    mixxx::MappedFile traktor_file(file);
+    if (!traktor_file.open()) {
         qDebug() << "Cannot open Traktor music collection";
         return nullptr;
     }
-    QXmlStreamReader xml(&traktor_file);
+    QXmlStreamReader xml(traktor_file.device());
     bool inCollectionTag = false;
     bool inPlaylistsTag = false;
     bool isRootFolderParsed = false;
@@ -278,6 +296,9 @@ TreeItem* TraktorFeature::importLibrary(const QString& file) {
     //initialize TraktorTableModel
     transaction.commit();
 
+    if (root && !m_cancelImport) {
+        importCache.store(file, root);
+    }
     return root;
 }
 
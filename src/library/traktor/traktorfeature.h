@@ -48,6 +48,8 @@ class TraktorFeature : public BaseExternalLibraryFeature {
     void onTrackCollectionLoaded();
 
   private:
+    friend class ExternalLibraryImportBenchmark;
+
     BaseSqlTableModel* getPlaylistModelForPlaylist(const QString& playlist) override;
     TreeItem* importLibrary(const QString& file);
     // parses a track in the music collection
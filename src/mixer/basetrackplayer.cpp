@@ -213,13 +213,15 @@ BaseTrackPlayerImpl::~BaseTrackPlayerImpl() {
     unloadTrack();
 }
 
-TrackPointer BaseTrackPlayerImpl::loadFakeTrack(bool bPlay, double filebpm) {
+TrackPointer BaseTrackPlayerImpl::loadFakeTrack(bool bPlay,
+        double filebpm,
+        mixxx::Duration duration) {
     TrackPointer pTrack(Track::newTemporary());
     pTrack->setAudioProperties(
             mixxx::kEngineChannelCount,
             mixxx::audio::SampleRate(44100),
             mixxx::audio::Bitrate(),
-            mixxx::Duration::fromSeconds(10));
+            duration);
     if (filebpm > 0) {
         pTrack->trySetBpm(filebpm);
     }
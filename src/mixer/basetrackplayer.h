@@ -12,6 +12,7 @@
 #include "track/track_decl.h"
 #include "track/trackid.h"
 #include "util/color/rgbcolor.h"
+#include "util/duration.h"
 #include "util/memory.h"
 #include "util/parented_ptr.h"
 
@@ -76,7 +77,9 @@ class BaseTrackPlayerImpl : public BaseTrackPlayer {
     void setupEqControls() final;
 
     // For testing, loads a fake track.
-    TrackPointer loadFakeTrack(bool bPlay, double filebpm);
+    TrackPointer loadFakeTrack(bool bPlay,
+            double filebpm,
+            mixxx::Duration duration = mixxx::Duration::fromSeconds(10));
 
   public slots:
     void slotLoadTrack(TrackPointer track, bool bPlay) final;
@@ -28,6 +28,9 @@ const mixxx::Logger kLogger("PlayerManager");
 // Utilize half of the available cores for adhoc analysis of tracks
 const int kNumberOfAnalyzerThreads = math_max(1, QThread::idealThreadCount() / 2);
 
+// The wait time of loaded tracks keeps growing while no track is dequeued
+constexpr int kAnalysisWaitTimeUpdateIntervalMillis = 1000;
+
 const QRegularExpression kDeckRegex(QStringLiteral("^\\[Channel(\\d+)\\]$"));
 const QRegularExpression kSamplerRegex(QStringLiteral("^\\[Sampler(\\d+)\\]$"));
 const QRegularExpression kPreviewDeckRegex(QStringLiteral("^\\[PreviewDeck(\\d+)\\]$"));
@@ -112,6 +115,10 @@ PlayerManager::PlayerManager(UserSettingsPointer pConfig,
                   ConfigKey("[Master]", "num_microphones"), true, true)),
           m_pCONumAuxiliaries(new ControlObject(
                   ConfigKey("[Master]", "num_auxiliaries"), true, true)),
+          m_pCOAnalysisQueueSize(new ControlObject(
+                  ConfigKey("[Library]", "player_analysis_queue_size"))),
+          m_pCOAnalysisWaitTime(new ControlObject(
+                  ConfigKey("[Library]", "player_analysis_wait_time"))),
           m_pTrackAnalysisScheduler(TrackAnalysisScheduler::NullPointer()) {
     m_pCONumDecks->connectValueChangeRequest(this,
             &PlayerManager::slotChangeNumDecks, Qt::DirectConnection);
@@ -123,6 +130,13 @@ PlayerManager::PlayerManager(UserSettingsPointer pConfig,
             &PlayerManager::slotChangeNumMicrophones, Qt::DirectConnection);
     m_pCONumAuxiliaries->connectValueChangeRequest(this,
             &PlayerManager::slotChangeNumAuxiliaries, Qt::DirectConnection);
+    m_pCOAnalysisQueueSize->setReadOnly();
+    m_pCOAnalysisWaitTime->setReadOnly();
+    m_analysisWaitTimeTimer.setInterval(kAnalysisWaitTimeUpdateIntervalMillis);
+    connect(&m_analysisWaitTimeTimer,
+            &QTimer::timeout,
+            this,
+            &PlayerManager::updateTrackAnalysisControls);
 
     // This is parented to the PlayerManager so does not need to be deleted
     m_pSamplerBank = new SamplerBank(m_pConfig, this);
@@ -154,6 +168,8 @@ PlayerManager::~PlayerManager() {
     delete m_pCONumPreviewDecks;
     delete m_pCONumMicrophones;
     delete m_pCONumAuxiliaries;
+    delete m_pCOAnalysisQueueSize;
+    delete m_pCOAnalysisWaitTime;
 
     if (m_pTrackAnalysisScheduler) {
         m_pTrackAnalysisScheduler->stop();
@@ -177,17 +193,24 @@ void PlayerManager::bindToLibrary(Library* pLibrary) {
     DEBUG_ASSERT(!m_pTrackAnalysisScheduler);
     m_pTrackAnalysisScheduler = pLibrary->createTrackAnalysisScheduler(
             kNumberOfAnalyzerThreads,
-            AnalyzerModeFlags::WithWaveform);
+            // A deck is waiting for the results
+            static_cast<AnalyzerModeFlags>(AnalyzerModeFlags::WithWaveform |
+                    AnalyzerModeFlags::WithWaveformPreview |
+                    AnalyzerModeFlags::Segmented));
 
     connect(m_pTrackAnalysisScheduler.get(), &TrackAnalysisScheduler::trackProgress,
             this, &PlayerManager::onTrackAnalysisProgress);
     connect(m_pTrackAnalysisScheduler.get(), &TrackAnalysisScheduler::finished,
             this, &PlayerManager::onTrackAnalysisFinished);
+    connect(m_pTrackAnalysisScheduler.get(),
+            &TrackAnalysisScheduler::queueChanged,
+            this,
+            &PlayerManager::updateTrackAnalysisControls);
 
     // Connect the player to the analyzer queue so that loaded tracks are
     // analyzed.
     foreach(Deck* pDeck, m_decks) {
-        connect(pDeck, &BaseTrackPlayer::newTrackLoaded, this, &PlayerManager::slotAnalyzeTrack);
+        connect(pDeck, &BaseTrackPlayer::newTrackLoaded, this, &PlayerManager::slotAnalyzeDeckTrack);
     }
 
     // Connect the player to the analyzer queue so that loaded tracks are
@@ -420,7 +443,7 @@ void PlayerManager::addDeckInner() {
         connect(pDeck,
                 &BaseTrackPlayer::newTrackLoaded,
                 this,
-                &PlayerManager::slotAnalyzeTrack);
+                &PlayerManager::slotAnalyzeDeckTrack);
     }
 
     m_players[handleGroup.handle()] = pDeck;
@@ -754,11 +777,23 @@ void PlayerManager::slotLoadTrackIntoNextAvailableSampler(TrackPointer pTrack) {
 }
 
 void PlayerManager::slotAnalyzeTrack(TrackPointer track) {
+    analyzeTrack(track, TrackAnalysisScheduler::Priority::Normal);
+}
+
+void PlayerManager::slotAnalyzeDeckTrack(TrackPointer track) {
+    // Tracks in decks are analyzed before those in samplers and
+    // preview decks
+    analyzeTrack(track, TrackAnalysisScheduler::Priority::High);
+}
+
+void PlayerManager::analyzeTrack(
+        TrackPointer track,
+        TrackAnalysisScheduler::Priority priority) {
     VERIFY_OR_DEBUG_ASSERT(track) {
         return;
     }
     if (m_pTrackAnalysisScheduler) {
-        if (m_pTrackAnalysisScheduler->scheduleTrack(track->getId())) {
+        if (m_pTrackAnalysisScheduler->scheduleTrack(track->getId(), priority)) {
             m_pTrackAnalysisScheduler->resume();
         }
         // The first progress signal will suspend a running batch analysis
@@ -782,3 +817,19 @@ void PlayerManager::onTrackAnalysisProgress(TrackId trackId, AnalyzerProgress an
 void PlayerManager::onTrackAnalysisFinished() {
     emit trackAnalyzerIdle();
 }
+
+void PlayerManager::updateTrackAnalysisControls() {
+    VERIFY_OR_DEBUG_ASSERT(m_pTrackAnalysisScheduler) {
+        return;
+    }
+    const int unfinishedTracksCount =
+            m_pTrackAnalysisScheduler->unfinishedTracksCount();
+    m_pCOAnalysisQueueSize->forceSet(unfinishedTracksCount);
+    m_pCOAnalysisWaitTime->forceSet(
+            m_pTrackAnalysisScheduler->longestWaitTime().toDoubleSeconds());
+    if (unfinishedTracksCount == 0) {
+        m_analysisWaitTimeTimer.stop();
+    } else if (!m_analysisWaitTimeTimer.isActive()) {
+        m_analysisWaitTimeTimer.start();
+    }
+}
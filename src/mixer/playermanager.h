@@ -5,6 +5,7 @@
 #include <QList>
 #include <QMap>
 #include <QObject>
+#include <QTimer>
 
 #include "analyzer/trackanalysisscheduler.h"
 #include "engine/channelhandle.h"
@@ -217,6 +218,7 @@ class PlayerManager : public QObject, public PlayerManagerInterface {
 
   private slots:
     void slotAnalyzeTrack(TrackPointer track);
+    void slotAnalyzeDeckTrack(TrackPointer track);
 
     void onTrackAnalysisProgress(TrackId trackId, AnalyzerProgress analyzerProgress);
     void onTrackAnalysisFinished();
@@ -248,6 +250,9 @@ class PlayerManager : public QObject, public PlayerManagerInterface {
 
   private:
     TrackPointer lookupTrack(QString location);
+    void analyzeTrack(TrackPointer track, TrackAnalysisScheduler::Priority priority);
+    // Publishes the state of the analysis of loaded tracks
+    void updateTrackAnalysisControls();
     // Must hold m_mutex before calling this method. Internal method that
     // creates a new deck.
     void addDeckInner();
@@ -281,6 +286,12 @@ class PlayerManager : public QObject, public PlayerManagerInterface {
     ControlObject* m_pCONumPreviewDecks;
     ControlObject* m_pCONumMicrophones;
     ControlObject* m_pCONumAuxiliaries;
+    // The number of loaded tracks that are waiting for or in analysis
+    ControlObject* m_pCOAnalysisQueueSize;
+    // Seconds since the longest waiting of these tracks has been loaded
+    ControlObject* m_pCOAnalysisWaitTime;
+    // Keeps the wait time up to date while no track is dequeued
+    QTimer m_analysisWaitTimeTimer;
     parented_ptr<ControlProxy> m_pAutoDjEnabled;
 
     TrackAnalysisScheduler::Pointer m_pTrackAnalysisScheduler;
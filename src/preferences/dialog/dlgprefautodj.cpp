@@ -61,6 +61,16 @@ DlgPrefAutoDJ::DlgPrefAutoDJ(QWidget* pParent,
             QOverload<int>::of(&QSpinBox::valueChanged),
             this,
             &DlgPrefAutoDJ::slotSetRandomQueueMin);
+
+    // Add tracks that mix well with the last track instead of random tracks
+    SimilarTracksCheckBox->setChecked(
+            m_pConfig->getValue(
+                    ConfigKey("[Auto DJ]", "UseSimilarTracks"), false));
+    slotToggleSimilarTracks(SimilarTracksCheckBox->checkState());
+    connect(SimilarTracksCheckBox,
+            &QCheckBox::stateChanged,
+            this,
+            &DlgPrefAutoDJ::slotToggleSimilarTracks);
 }
 
 DlgPrefAutoDJ::~DlgPrefAutoDJ() {
@@ -88,6 +98,10 @@ void DlgPrefAutoDJ::slotApply() {
     m_pConfig->setValue(ConfigKey("[Auto DJ]", "EnableRandomQueue"),
             m_pConfig->getValue(
                     ConfigKey("[Auto DJ]", "EnableRandomQueueBuff"), 0));
+
+    m_pConfig->setValue(ConfigKey("[Auto DJ]", "UseSimilarTracks"),
+            m_pConfig->getValue(
+                    ConfigKey("[Auto DJ]", "UseSimilarTracksBuff"), 0));
 }
 
 void DlgPrefAutoDJ::slotCancel() {
@@ -124,6 +138,13 @@ void DlgPrefAutoDJ::slotCancel() {
                     ConfigKey("[Auto DJ]", "EnableRandomQueue"), 0));
     slotToggleRandomQueue(
             m_pConfig->getValue<int>(ConfigKey("[Auto DJ]", "Requeue")));
+
+    SimilarTracksCheckBox->setChecked(
+            m_pConfig->getValue(
+                    ConfigKey("[Auto DJ]", "UseSimilarTracks"), false));
+    m_pConfig->setValue(ConfigKey("[Auto DJ]", "UseSimilarTracksBuff"),
+            m_pConfig->getValue(
+                    ConfigKey("[Auto DJ]", "UseSimilarTracks"), 0));
 }
 
 void DlgPrefAutoDJ::slotResetToDefaults() {
@@ -141,6 +162,9 @@ void DlgPrefAutoDJ::slotResetToDefaults() {
     m_pConfig->set(ConfigKey("[Auto DJ]", "EnableRandomQueueBuff"),QString("0"));
     RandomQueueMinimumSpinBox->setEnabled(false);
     RandomQueueCheckBox->setEnabled(true);
+
+    SimilarTracksCheckBox->setChecked(false);
+    m_pConfig->set(ConfigKey("[Auto DJ]", "UseSimilarTracksBuff"), QString("0"));
 }
 
 void DlgPrefAutoDJ::slotSetMinimumAvailable(int a_iValue) {
@@ -196,3 +220,8 @@ void DlgPrefAutoDJ::slotToggleRandomQueue(int a_iValue) {
                 ConfigValue(1));
     }
 }
+
+void DlgPrefAutoDJ::slotToggleSimilarTracks(int a_iState) {
+    m_pConfig->set(ConfigKey("[Auto DJ]", "UseSimilarTracksBuff"),
+            ConfigValue(a_iState == Qt::Checked ? 1 : 0));
+}
@@ -25,6 +25,7 @@ class DlgPrefAutoDJ : public DlgPreferencePage, public Ui::DlgPrefAutoDJDlg {
     void slotSetRandomQueueMin(int);
     void slotConsiderRepeatPlaylistState(int);
     void slotToggleRandomQueue(int);
+    void slotToggleSimilarTracks(int);
 
   private:
     UserSettingsPointer m_pConfig;
@@ -13,6 +13,7 @@
 #include "soundio/sounddevice.h"
 #include "util/memory.h"
 #include "util/performancetimer.h"
+#include "util/threadrole.h"
 
 #define CPU_USAGE_UPDATE_RATE 30 // in 1/s, fits to display frame rate
 #define CPU_OVERLOAD_DURATION 500 // in ms
@@ -96,6 +97,7 @@ class SoundDeviceNetworkThread : public QThread {
         }
 #endif
 
+        const mixxx::ScopedThreadRole threadRole(mixxx::ThreadRole::AudioCallback);
         while(!m_stop) {
             m_pParent->callbackProcessClkRef();
         }
@@ -15,6 +15,7 @@
 #include "util/fifo.h"
 #include "util/math.h"
 #include "util/sample.h"
+#include "util/threadrole.h"
 #include "util/timer.h"
 #include "util/trace.h"
 #include "vinylcontrol/defs_vinylcontrol.h"
@@ -87,6 +88,7 @@ SoundDevicePortAudio::SoundDevicePortAudio(UserSettingsPointer config,
           m_outputDrift(false),
           m_inputDrift(false),
           m_bSetThreadPriority(false),
+          m_threadRoleId(-1),
           m_masterAudioLatencyUsage("[Master]", "audio_latency_usage"),
           m_framesSinceAudioLatencyUsageUpdate(0),
           m_syncBuffers(2),
@@ -337,11 +339,17 @@ SoundDeviceStatus SoundDevicePortAudio::open(bool isClkRefDevice, int syncBuffer
     }
 #endif
 
+    // The callback thread is created by PortAudio. Prepare its registration
+    // here, the callback only attaches to it without locking or allocating.
+    m_threadRoleId = mixxx::ThreadRoleRegistry::reserveThread(
+            mixxx::ThreadRole::AudioCallback, m_deviceId.debugName());
+
     // Start stream
     err = Pa_StartStream(pStream);
     if (err != paNoError) {
         qWarning() << "PortAudio: Start stream error:" << Pa_GetErrorText(err);
         m_lastError = QString::fromUtf8(Pa_GetErrorText(err));
+        mixxx::ThreadRoleRegistry::unregisterThread(m_threadRoleId);
         err = Pa_CloseStream(pStream);
         if (err != paNoError) {
             qWarning() << "PortAudio: Close stream error:"
@@ -380,6 +388,10 @@ SoundDeviceStatus SoundDevicePortAudio::close() {
     //qDebug() << "SoundDevicePortAudio::close()" << m_deviceId;
     PaStream* pStream = m_pStream;
     m_pStream = nullptr;
+    // Before the callback thread exits, because its CPU clock must not be
+    // read afterwards. The id is kept, because the callback may still read
+    // it. Attaching an unregistered id has no effect.
+    mixxx::ThreadRoleRegistry::unregisterThread(m_threadRoleId);
     if (pStream) {
         // Make sure the stream is not stopped before we try stopping it.
         PaError err = Pa_IsStreamStopped(pStream);
@@ -875,6 +887,8 @@ int SoundDevicePortAudio::callbackProcessClkRef(
     if (!m_bSetThreadPriority) {
         QThread::currentThread()->setPriority(QThread::TimeCriticalPriority);
         m_bSetThreadPriority = true;
+        // Applies the configured affinity, only once per stream
+        mixxx::ThreadRoleRegistry::attachCurrentThread(m_threadRoleId);
 
 
 #ifdef __SSE__
@@ -73,6 +73,8 @@ class SoundDevicePortAudio : public SoundDevice {
     QString m_lastError;
     // Whether we have set the thread priority to realtime or not.
     bool m_bSetThreadPriority;
+    // Registration of the callback thread in the ThreadRoleRegistry
+    int m_threadRoleId;
     PollingControlProxy m_masterAudioLatencyUsage;
     mixxx::Duration m_timeInAudioCallback;
     int m_framesSinceAudioLatencyUsageUpdate;
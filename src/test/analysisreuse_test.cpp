@@ -0,0 +1,96 @@
+#include "analyzer/analysisreuse.h"
+
+#include <gtest/gtest.h>
+
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "analyzer/constants.h"
+#include "sources/soundsourceproxy.h"
+#include "test/librarytest.h"
+#include "track/keyfactory.h"
+#include "track/track.h"
+
+namespace {
+
+const QString kTestFile = QStringLiteral("id3-test-data/cover-test.flac");
+const QString kOtherTestFile = QStringLiteral("id3-test-data/cover-test.ogg");
+
+class AnalysisReuseTest : public LibraryTest {
+  protected:
+    AnalysisReuseTest()
+            : m_analysisReuse(config(), dbConnection()) {
+    }
+
+    QString copyTestFile(const QString& testFile, const QString& fileName) {
+        const QString filePath = m_tempDir.filePath(fileName);
+        EXPECT_TRUE(QFile::copy(getTestDir().filePath(testFile), filePath));
+        return filePath;
+    }
+
+    static mixxx::AudioSourcePointer openAudioSource(const QString& filePath) {
+        mixxx::AudioSource::OpenParams openParams;
+        openParams.setChannelCount(mixxx::kAnalysisChannels);
+        return SoundSourceProxy(Track::newTemporary(filePath)).openAudioSource(openParams);
+    }
+
+    static QByteArray fingerprint(const QString& filePath) {
+        const auto pAudioSource = openAudioSource(filePath);
+        EXPECT_NE(nullptr, pAudioSource);
+        if (!pAudioSource) {
+            return QByteArray();
+        }
+        return AnalysisReuse::fingerprint(pAudioSource);
+    }
+
+    QTemporaryDir m_tempDir;
+    const AnalysisReuse m_analysisReuse;
+};
+
+TEST_F(AnalysisReuseTest, Fingerprint) {
+    const QByteArray original = fingerprint(copyTestFile(kTestFile, "original.flac"));
+    ASSERT_FALSE(original.isEmpty());
+    EXPECT_EQ(original, fingerprint(copyTestFile(kTestFile, "copy.flac")));
+    EXPECT_NE(original, fingerprint(copyTestFile(kOtherTestFile, "other.ogg")));
+}
+
+TEST_F(AnalysisReuseTest, ReuseResultsOfIdenticalAudio) {
+    const TrackPointer pOriginal =
+            getOrAddTrackByLocation(copyTestFile(kTestFile, "original.flac"));
+    const TrackPointer pCopy =
+            getOrAddTrackByLocation(copyTestFile(kTestFile, "copy.flac"));
+    ASSERT_NE(nullptr, pOriginal);
+    ASSERT_NE(nullptr, pCopy);
+    const QByteArray fingerprint = AnalysisReuseTest::fingerprint(pOriginal->getLocation());
+    ASSERT_FALSE(fingerprint.isEmpty());
+    const auto sampleRate = pOriginal->getSampleRate();
+
+    // Nothing to reuse before the original has been analyzed
+    EXPECT_FALSE(m_analysisReuse.reuseResults(pCopy, sampleRate, fingerprint).isValid());
+
+    ASSERT_TRUE(pOriginal->trySetBeats(mixxx::Beats::fromConstTempo(
+            sampleRate,
+            mixxx::audio::FramePos(100),
+            mixxx::Bpm(128),
+            QStringLiteral("test"))));
+    pOriginal->setKeys(KeyFactory::makeBasicKeys(
+            mixxx::track::io::key::A_MINOR, mixxx::track::io::key::ANALYZER));
+    pOriginal->setReplayGain(mixxx::ReplayGain(0.5, 0.9f));
+    ASSERT_EQ(TrackCollectionManager::SaveTrackResult::Saved,
+            trackCollectionManager()->saveTrack(pOriginal));
+    EXPECT_FALSE(m_analysisReuse.hasFingerprint(pOriginal->getId()));
+    ASSERT_TRUE(m_analysisReuse.storeFingerprint(pOriginal->getId(), fingerprint));
+    EXPECT_TRUE(m_analysisReuse.hasFingerprint(pOriginal->getId()));
+
+    EXPECT_FALSE(m_analysisReuse.hasFingerprint(pCopy->getId()));
+    EXPECT_EQ(pOriginal->getId(),
+            m_analysisReuse.reuseResults(pCopy, sampleRate, fingerprint));
+    EXPECT_EQ(128.0, pCopy->getBpm());
+    EXPECT_EQ(mixxx::track::io::key::A_MINOR, pCopy->getKey());
+    EXPECT_EQ(pOriginal->getReplayGain(), pCopy->getReplayGain());
+
+    // The results of the copy are not replaced
+    EXPECT_FALSE(m_analysisReuse.reuseResults(pCopy, sampleRate, fingerprint).isValid());
+}
+
+} // namespace
@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+
+#include <QEventLoop>
+
+#include "library/librarytablemodel.h"
+#include "test/librarybenchmark.h"
+#include "util/performancetimer.h"
+
+namespace {
+
+constexpr int kLargeLibraryTrackCount = 250000;
+
+// Searches a library with many tracks
+class LibraryTableModelBenchmark : public LibraryBenchmark {
+  public:
+    using LibraryBenchmark::SetUp;
+
+    void SetUp(benchmark::State& state) override {
+        LibraryBenchmark::SetUp(state);
+        if (!addSyntheticTracks(static_cast<int>(state.range(0)))) {
+            state.SkipWithError("Failed to add tracks");
+        }
+    }
+
+  protected:
+    // Measures the time from a search until the rows are visible. The time
+    // spent in search() itself is the time the GUI thread is blocked before
+    // the results arrive.
+    void runSearch(benchmark::State& state, bool async) {
+        LibraryTableModel model(nullptr,
+                trackCollectionManager(),
+                "mixxx.db.model.library");
+        // Builds the index of the track cache
+        model.select();
+        if (model.rowCount() != state.range(0)) {
+            state.SkipWithError("Unexpected number of rows");
+            return;
+        }
+        QEventLoop eventLoop;
+        QObject::connect(&model,
+                &BaseSqlTableModel::selectFinished,
+                &eventLoop,
+                &QEventLoop::quit);
+        int searchCount = 0;
+        double searchSeconds = 0;
+        for (auto _ : state) {
+            // A different search every time, so the rows are replaced
+            const QString searchText = QStringLiteral("Artist %1").arg(++searchCount % 1000);
+            PerformanceTimer timer;
+            timer.start();
+            model.search(searchText);
+            if (!async) {
+                model.select();
+            }
+            searchSeconds += timer.elapsed().toDoubleSeconds();
+            if (model.isSelectPending()) {
+                eventLoop.exec();
+            }
+            if (model.rowCount() == 0) {
+                state.SkipWithError("No rows found");
+                break;
+            }
+        }
+        state.counters["SearchCallMs"] = benchmark::Counter(
+                searchSeconds * 1000, benchmark::Counter::kAvgIterations);
+    }
+};
+
+} // namespace
+
+BENCHMARK_DEFINE_F(LibraryTableModelBenchmark, SearchTimeToFirstRowAsync)
+(benchmark::State& state) {
+    runSearch(state, true);
+}
+BENCHMARK_REGISTER_F(LibraryTableModelBenchmark, SearchTimeToFirstRowAsync)
+        ->Arg(kLargeLibraryTrackCount)
+        ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(LibraryTableModelBenchmark, SearchTimeToFirstRowSync)
+(benchmark::State& state) {
+    runSearch(state, false);
+}
+BENCHMARK_REGISTER_F(LibraryTableModelBenchmark, SearchTimeToFirstRowSync)
+        ->Arg(kLargeLibraryTrackCount)
+        ->Unit(benchmark::kMillisecond);
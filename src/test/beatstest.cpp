@@ -1,3 +1,4 @@
+#include <benchmark/benchmark.h>
 #include <gtest/gtest.h>
 
 #include <QtDebug>
@@ -34,6 +35,82 @@ const auto kNonConstTempoBeats = Beats(
         kSampleRate,
         QString());
 
+constexpr int kBeatMapBeats = 10000;
+
+BeatsPointer nonConstTempoBeatsPointer() {
+    return Beats::fromBeatMarkers(kSampleRate,
+            kNonConstTempoBeats.getMarkers(),
+            kNonConstTempoBeats.getLastMarkerPosition(),
+            kNonConstTempoBeats.getLastMarkerBpm());
+}
+
+/// Creates a beat map with a marker for every beat, by alternating the
+/// beat length around 120 BPM.
+BeatsPointer makeBeatMap(int numBeats) {
+    QVector<audio::FramePos> beatPositions;
+    audio::FramePos position = kStartPosition;
+    for (int i = 0; i < numBeats; i++) {
+        beatPositions.append(position);
+        position += (i % 2 == 0) ? 23990 : 24010;
+    }
+    return Beats::fromBeatPositions(kSampleRate, beatPositions);
+}
+
+void expectCursorMatchesBeats(Beats::Cursor* pCursor, audio::FramePos position) {
+    const Beats* pBeats = pCursor->getBeats();
+    for (const bool snapToNearBeats : {false, true}) {
+        audio::FramePos prevBeatPosition;
+        audio::FramePos nextBeatPosition;
+        const bool found = pBeats->findPrevNextBeats(
+                position, &prevBeatPosition, &nextBeatPosition, snapToNearBeats);
+        audio::FramePos cursorPrevBeatPosition;
+        audio::FramePos cursorNextBeatPosition;
+        EXPECT_EQ(found,
+                pCursor->findPrevNextBeats(position,
+                        &cursorPrevBeatPosition,
+                        &cursorNextBeatPosition,
+                        snapToNearBeats));
+        EXPECT_EQ(prevBeatPosition, cursorPrevBeatPosition) << position.value();
+        EXPECT_EQ(nextBeatPosition, cursorNextBeatPosition) << position.value();
+    }
+    for (const int n : {-2, -1, 1, 2}) {
+        EXPECT_EQ(pBeats->findNthBeat(position, n), pCursor->findNthBeat(position, n))
+                << position.value() << " " << n;
+    }
+    EXPECT_EQ(pBeats->findClosestBeat(position), pCursor->findClosestBeat(position))
+            << position.value();
+    EXPECT_EQ(pBeats->getBpmAroundPosition(position, 4),
+            pCursor->getBpmAroundPosition(position, 4))
+            << position.value();
+}
+
+void expectCursorMatchesBeats(const BeatsPointer& pBeats) {
+    const audio::FrameDiff_t beatLengthFrames = 60.0 * kSampleRate.value() / kBpm.value();
+    const audio::FramePos startPosition = kStartPosition - 4 * beatLengthFrames;
+    const audio::FramePos endPosition = kEndPosition + 4 * beatLengthFrames;
+    Beats::Cursor cursor(pBeats.get());
+
+    // Forward and backward like the play position, across the markers
+    constexpr audio::FrameDiff_t kBufferFrames = 768;
+    for (auto position = startPosition; position < endPosition; position += kBufferFrames) {
+        expectCursorMatchesBeats(&cursor, position);
+    }
+    for (auto position = endPosition; position > startPosition; position -= kBufferFrames) {
+        expectCursorMatchesBeats(&cursor, position);
+    }
+
+    // Exactly on the beats
+    for (auto it = pBeats->iteratorFrom(startPosition); *it < endPosition; it++) {
+        expectCursorMatchesBeats(&cursor, *it);
+    }
+
+    // Seeks
+    for (int i = 0; i < 100; i++) {
+        const auto position = startPosition + ((i * 7919) % 1000) / 1000.0 * (endPosition - startPosition);
+        expectCursorMatchesBeats(&cursor, position);
+    }
+}
+
 TEST(BeatsTest, ConstTempoGetBpmInRange) {
     EXPECT_DOUBLE_EQ(kBpm.value(),
             kConstTempoBeats.getBpmInRange(kStartPosition, kEndPosition)
@@ -450,6 +527,65 @@ TEST(BeatsTest, NonConstTempoFromBeatPositions) {
     EXPECT_EQ(kBpm * 2, pBeats->getLastMarkerBpm());
 }
 
+TEST(BeatsTest, NonConstTempoIteratorFrom) {
+    // The lookup between the first and the last marker uses the precomputed
+    // beat positions
+    for (auto it = kNonConstTempoBeats.cfirstmarker();
+            it != kNonConstTempoBeats.clastmarker() + 2;
+            it++) {
+        EXPECT_EQ(it, kNonConstTempoBeats.iteratorFrom(*it));
+        EXPECT_EQ(it, kNonConstTempoBeats.iteratorFrom(*it - 1));
+        EXPECT_EQ(it + 1, kNonConstTempoBeats.iteratorFrom(*it + 1));
+    }
+
+    const BeatsPointer pBeatMap = makeBeatMap(kBeatMapBeats);
+    ASSERT_EQ(kBeatMapBeats - 1, static_cast<int>(pBeatMap->getMarkers().size()));
+    int beats = 0;
+    for (auto it = pBeatMap->cfirstmarker(); it != pBeatMap->clastmarker() + 1; it++) {
+        EXPECT_EQ(it, pBeatMap->iteratorFrom(*it - 0.5));
+        ++beats;
+    }
+    EXPECT_EQ(kBeatMapBeats, beats);
+}
+
+TEST(BeatsTest, ConstTempoCursorMatchesBeats) {
+    expectCursorMatchesBeats(
+            Beats::fromConstTempo(kSampleRate, kStartPosition, kBpm));
+}
+
+TEST(BeatsTest, NonConstTempoCursorMatchesBeats) {
+    expectCursorMatchesBeats(nonConstTempoBeatsPointer());
+}
+
+TEST(BeatsTest, CursorFollowsNewBeats) {
+    const BeatsPointer pBeats = Beats::fromConstTempo(kSampleRate, kStartPosition, kBpm);
+    Beats::Cursor cursor(pBeats.get());
+    const auto position = kStartPosition + 1000;
+    EXPECT_EQ(kStartPosition, cursor.findPrevBeat(position));
+
+    const BeatsPointer pTranslatedBeats = *pBeats->tryTranslate(2000);
+    cursor.setBeats(pTranslatedBeats.get());
+    EXPECT_EQ(pTranslatedBeats.get(), cursor.getBeats());
+    EXPECT_EQ(kStartPosition + 2000, cursor.findNextBeat(position));
+}
+
+TEST(BeatsTest, CursorDoesNotKeepBeatsAlive) {
+    BeatsPointer pBeats = Beats::fromConstTempo(kSampleRate, kStartPosition, kBpm);
+    const std::weak_ptr<const Beats> pWeakBeats = pBeats;
+    Beats::Cursor cursor(pBeats.get());
+    const auto position = kStartPosition + 1000;
+    EXPECT_EQ(kStartPosition, cursor.findPrevBeat(position));
+    pBeats.reset();
+    EXPECT_TRUE(pWeakBeats.expired());
+
+    // Beats that may have been allocated at the same address are not
+    // mistaken for the released beats
+    const BeatsPointer pNewBeats = Beats::fromConstTempo(
+            kSampleRate, kStartPosition + 2000, kBpm);
+    cursor.setBeats(pNewBeats.get());
+    EXPECT_EQ(kStartPosition + 2000, cursor.findNextBeat(position));
+}
+
 TEST(BeatsTest, ConstTempoFindNthBeatWhenOnBeat) {
     const auto it = kConstTempoBeats.cfirstmarker() + 10;
     const audio::FrameDiff_t beatLengthFrames = 60.0 * kSampleRate.value() / kBpm.value();
@@ -538,3 +674,41 @@ TEST(BeatsTest, ConstTempoFindPrevNextBeatWhenNotOnBeat) {
 }
 
 } // namespace
+
+// Looks up the beats around the play position of consecutive engine buffers
+// like the engine controls, either with a new search for each buffer or with
+// a cursor. The beats are a constant tempo grid or a beat map with a marker
+// for each of the 10000 beats.
+static void BM_BeatsLookupAtPlayPosition(benchmark::State& state) {
+    constexpr audio::FrameDiff_t kBufferFrames = 512;
+    const bool beatMap = state.range(0) != 0;
+    const bool useCursor = state.range(1) != 0;
+    const BeatsPointer pBeats = beatMap
+            ? makeBeatMap(kBeatMapBeats)
+            : Beats::fromConstTempo(kSampleRate, kStartPosition, kBpm);
+    const audio::FramePos endPosition = pBeats->findNthBeat(kStartPosition, kBeatMapBeats);
+    Beats::Cursor cursor(pBeats.get());
+
+    audio::FramePos position = kStartPosition;
+    for (auto _ : state) {
+        position += kBufferFrames;
+        if (position >= endPosition) {
+            position = kStartPosition;
+        }
+        audio::FramePos prevBeatPosition;
+        audio::FramePos nextBeatPosition;
+        if (useCursor) {
+            cursor.findPrevNextBeats(position, &prevBeatPosition, &nextBeatPosition, false);
+            benchmark::DoNotOptimize(cursor.getBpmAroundPosition(position, 4));
+        } else {
+            pBeats->findPrevNextBeats(position, &prevBeatPosition, &nextBeatPosition, false);
+            benchmark::DoNotOptimize(pBeats->getBpmAroundPosition(position, 4));
+        }
+        benchmark::DoNotOptimize(prevBeatPosition);
+        benchmark::DoNotOptimize(nextBeatPosition);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetLabel(beatMap ? "beat map" : "const tempo");
+}
+// Beat map, cursor
+BENCHMARK(BM_BeatsLookupAtPlayPosition)->ArgsProduct({{0, 1}, {0, 1}});
@@ -0,0 +1,130 @@
+#include "effects/backends/builtin/convolutionreverbeffect.h"
+
+#include <gtest/gtest.h>
+
+#include <QThread>
+#include <memory>
+
+#include "effects/backends/effectsbackendmanager.h"
+#include "engine/effects/engineeffect.h"
+#include "engine/effects/message.h"
+#include "test/mixxxtest.h"
+#include "util/messagepipe.h"
+#include "util/samplebuffer.h"
+
+namespace {
+
+constexpr int kPipeSize = 8;
+const auto kSampleRate = mixxx::audio::SampleRate(44100);
+
+/// Processes the reverb for the main output through EngineEffect, like
+/// EngineEffectChain does.
+class ConvolutionReverbEffectTest : public MixxxTest {
+  protected:
+    ConvolutionReverbEffectTest()
+            : m_pBackendManager(new EffectsBackendManager(config())) {
+        const QString inputGroup = QStringLiteral("[Channel1]");
+        const QString outputGroup = QStringLiteral("[Master]");
+        m_inputChannel = m_channelHandleFactory.getOrCreateHandle(inputGroup);
+        m_outputChannel = m_channelHandleFactory.getOrCreateHandle(outputGroup);
+        const QSet<ChannelHandleAndGroup> inputChannels = {
+                ChannelHandleAndGroup(m_inputChannel, inputGroup)};
+        m_pEffect = std::make_unique<EngineEffect>(
+                m_pBackendManager->getManifest(
+                        ConvolutionReverbEffect::getId(), EffectBackendType::BuiltIn),
+                m_pBackendManager,
+                inputChannels,
+                inputChannels,
+                QSet<ChannelHandleAndGroup>{
+                        ChannelHandleAndGroup(m_outputChannel, outputGroup)});
+
+        const auto pipes = TwoWayMessagePipe<EffectsRequest*, EffectsResponse>::
+                makeTwoWayMessagePipe(kPipeSize, kPipeSize);
+        m_pRequestPipe.reset(pipes.first);
+        m_pResponsePipe.reset(pipes.second);
+
+        EffectsRequest enable;
+        enable.type = EffectsRequest::SET_EFFECT_PARAMETERS;
+        enable.SetEffectParameters.enabled = true;
+        m_pEffect->processEffectsRequest(enable, m_pResponsePipe.get());
+        EffectsRequest send;
+        send.type = EffectsRequest::SET_PARAMETER_PARAMETERS;
+        send.SetParameterParameters.iParameter = 0;
+        send.value = 1.0;
+        m_pEffect->processEffectsRequest(send, m_pResponsePipe.get());
+    }
+
+    void process(const mixxx::SampleBuffer& input, mixxx::SampleBuffer* pOutput) {
+        m_pEffect->process(m_inputChannel,
+                m_outputChannel,
+                input.data(),
+                pOutput->data(),
+                static_cast<unsigned int>(input.size()),
+                kSampleRate,
+                EffectEnableState::Enabled,
+                GroupFeatureState());
+    }
+
+    static bool isSilent(const mixxx::SampleBuffer& buffer) {
+        for (SINT i = 0; i < buffer.size(); ++i) {
+            if (buffer[i] != 0.0f) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// The convolvers are built in the background. Once they are built
+    /// for the buffer size, the reverb of an impulse starts exactly one
+    /// buffer later.
+    void assertLatencyOfOneBuffer(SINT framesPerBuffer) {
+        const std::vector<float> impulseResponse =
+                ConvolutionReverbEffect::createImpulseResponse(kSampleRate, 0);
+        mixxx::SampleBuffer input(framesPerBuffer * mixxx::kEngineChannelCount);
+        mixxx::SampleBuffer impulseOutput(input.size());
+        mixxx::SampleBuffer output(input.size());
+        for (int attempt = 0; attempt < 100; ++attempt) {
+            // Let the reverb of the previous impulse decay completely
+            input.clear();
+            for (SINT frame = 0;
+                    frame < 2 * static_cast<SINT>(impulseResponse.size());
+                    frame += framesPerBuffer) {
+                process(input, &output);
+            }
+            input[0] = 1.0f;
+            process(input, &impulseOutput);
+            input[0] = 0.0f;
+            process(input, &output);
+            if (output[0] == 0.0f || !isSilent(impulseOutput)) {
+                // Still without convolvers or with convolvers for
+                // another buffer size
+                QThread::msleep(10);
+                continue;
+            }
+            for (SINT i = 0; i < framesPerBuffer; ++i) {
+                ASSERT_NEAR(impulseResponse[i],
+                        output[i * mixxx::kEngineChannelCount],
+                        1e-4)
+                        << "frame " << i;
+            }
+            return;
+        }
+        FAIL() << "No convolvers for " << framesPerBuffer << " frames";
+    }
+
+    EffectsBackendManagerPointer m_pBackendManager;
+    ChannelHandleFactory m_channelHandleFactory;
+    ChannelHandle m_inputChannel;
+    ChannelHandle m_outputChannel;
+    std::unique_ptr<EffectsRequestPipe> m_pRequestPipe;
+    std::unique_ptr<EffectsResponsePipe> m_pResponsePipe;
+    std::unique_ptr<EngineEffect> m_pEffect;
+};
+
+TEST_F(ConvolutionReverbEffectTest, ConvolversFollowBufferSize) {
+    assertLatencyOfOneBuffer(256);
+    // Rebuilt when the buffer size changes
+    assertLatencyOfOneBuffer(1024);
+}
+
+} // namespace
@@ -0,0 +1,246 @@
+#include "effects/backends/effectprocessor.h"
+
+#include <gtest/gtest.h>
+
+#include <QList>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "engine/engine.h"
+#include "util/samplebuffer.h"
+
+namespace {
+
+class CountingEffectState : public EffectState {
+  public:
+    CountingEffectState(const mixxx::EngineParameters& engineParameters)
+            : EffectState(engineParameters) {
+        ++s_createdCount;
+        ++s_liveCount;
+    }
+    ~CountingEffectState() override {
+        --s_liveCount;
+    }
+
+    bool resetForReuse() override {
+        ++s_resetCount;
+        m_processedCount = 0;
+        return true;
+    }
+
+    void processed() {
+        ++m_processedCount;
+        s_maxProcessedCount = std::max(s_maxProcessedCount, m_processedCount);
+    }
+
+    static int s_createdCount;
+    static int s_liveCount;
+    static int s_resetCount;
+    // The maximum number of buffers processed with a single state
+    static int s_maxProcessedCount;
+
+  private:
+    int m_processedCount = 0;
+};
+
+int CountingEffectState::s_createdCount = 0;
+int CountingEffectState::s_liveCount = 0;
+int CountingEffectState::s_resetCount = 0;
+int CountingEffectState::s_maxProcessedCount = 0;
+
+class CountingEffect : public EffectProcessorImpl<CountingEffectState> {
+  public:
+    void loadEngineEffectParameters(
+            const QMap<QString, EngineEffectParameterPointer>& parameters) override {
+        Q_UNUSED(parameters);
+    }
+
+    void processChannel(CountingEffectState* pState,
+            const CSAMPLE* pInput,
+            CSAMPLE* pOutput,
+            const mixxx::EngineParameters& engineParameters,
+            const EffectEnableState enableState,
+            const GroupFeatureState& groupFeatures) override {
+        pState->processed();
+        Q_UNUSED(enableState);
+        Q_UNUSED(groupFeatures);
+        SampleUtil::copy(pOutput, pInput, engineParameters.samplesPerBuffer());
+    }
+};
+
+constexpr int kDeckCount = 8;
+constexpr int kSamplerCount = 16;
+constexpr int kOutputCount = 2;
+
+class EffectProcessorTest : public testing::Test {
+  protected:
+    EffectProcessorTest()
+            : m_engineParameters(mixxx::audio::SampleRate(44100), 512) {
+        CountingEffectState::s_createdCount = 0;
+        CountingEffectState::s_liveCount = 0;
+        CountingEffectState::s_resetCount = 0;
+        CountingEffectState::s_maxProcessedCount = 0;
+        for (int i = 1; i <= kDeckCount; ++i) {
+            addInputChannel(QStringLiteral("[Channel%1]").arg(i));
+        }
+        for (int i = 1; i <= kSamplerCount; ++i) {
+            addInputChannel(QStringLiteral("[Sampler%1]").arg(i));
+        }
+        for (const auto& group : {QStringLiteral("[Master]"), QStringLiteral("[Headphone]")}) {
+            m_outputChannels.insert(ChannelHandleAndGroup(
+                    m_channelHandleFactory.getOrCreateHandle(group), group));
+        }
+    }
+
+    void addInputChannel(const QString& group) {
+        m_inputChannels.append(ChannelHandleAndGroup(
+                m_channelHandleFactory.getOrCreateHandle(group), group));
+    }
+
+    // Mimics the round trip through the EffectsMessenger
+    void route(ChannelHandle inputChannel) {
+        std::unique_ptr<EffectStatesForInputChannel> pStates =
+                m_effect.createStatesForInputChannel(m_engineParameters);
+        m_effect.swapStatesForInputChannel(inputChannel, pStates.get());
+        m_effect.recycleStatesForInputChannel(std::move(pStates));
+    }
+
+    void unroute(ChannelHandle inputChannel) {
+        auto pStates = std::make_unique<EffectStatesForInputChannel>();
+        m_effect.swapStatesForInputChannel(inputChannel, pStates.get());
+        EXPECT_FALSE(pStates->empty());
+        m_effect.recycleStatesForInputChannel(std::move(pStates));
+    }
+
+    void process(ChannelHandle inputChannel) {
+        mixxx::SampleBuffer input(m_engineParameters.samplesPerBuffer());
+        mixxx::SampleBuffer output(m_engineParameters.samplesPerBuffer());
+        for (const auto& outputChannel : std::as_const(m_outputChannels)) {
+            m_effect.process(inputChannel,
+                    outputChannel.handle(),
+                    input.data(),
+                    output.data(),
+                    m_engineParameters,
+                    EffectEnableState::Enabled,
+                    GroupFeatureState());
+        }
+    }
+
+    const mixxx::EngineParameters m_engineParameters;
+    ChannelHandleFactory m_channelHandleFactory;
+    QList<ChannelHandleAndGroup> m_inputChannels;
+    QSet<ChannelHandleAndGroup> m_outputChannels;
+    CountingEffect m_effect;
+};
+
+TEST_F(EffectProcessorTest, InitializeRoutedInputChannelsOnly) {
+    const QSet<ChannelHandleAndGroup> activeInputChannels = {
+            m_inputChannels.at(0), m_inputChannels.at(1)};
+    m_effect.initialize(activeInputChannels, m_outputChannels, m_engineParameters);
+
+    EXPECT_EQ(2 * kOutputCount, CountingEffectState::s_createdCount);
+    EXPECT_EQ(2 * kOutputCount, m_effect.memoryReport().stateCount);
+    EXPECT_EQ(2, m_effect.memoryReport().inputChannelCount);
+    EXPECT_EQ(static_cast<std::size_t>(2 * kOutputCount) * sizeof(CountingEffectState),
+            m_effect.memoryReport().bytes);
+
+    process(m_inputChannels.at(0).handle());
+    process(m_inputChannels.at(1).handle());
+}
+
+TEST_F(EffectProcessorTest, RouteInputChannelsOneAfterAnother) {
+    m_effect.initialize({}, m_outputChannels, m_engineParameters);
+    EXPECT_EQ(0, CountingEffectState::s_createdCount);
+
+    // The states of an unrouted input channel are reused
+    // for the next routed input channel after resetting them
+    for (const auto& inputChannel : std::as_const(m_inputChannels)) {
+        route(inputChannel.handle());
+        process(inputChannel.handle());
+        unroute(inputChannel.handle());
+    }
+
+    EXPECT_EQ(1, CountingEffectState::s_maxProcessedCount);
+    EXPECT_EQ(kOutputCount, CountingEffectState::s_liveCount);
+    EXPECT_EQ(1, m_effect.memoryReport().inputChannelCount);
+    EXPECT_EQ(1, m_effect.memoryReport().pooledInputChannelCount);
+}
+
+TEST_F(EffectProcessorTest, ReusePooledStateObjects) {
+    m_effect.initialize({}, m_outputChannels, m_engineParameters);
+
+    std::unique_ptr<EffectStatesForInputChannel> pStates =
+            m_effect.createStatesForInputChannel(m_engineParameters);
+    std::vector<const EffectState*> statePointers;
+    for (const auto& pState : std::as_const(*pStates)) {
+        if (pState) {
+            statePointers.push_back(pState.get());
+        }
+    }
+    ASSERT_EQ(static_cast<std::size_t>(kOutputCount), statePointers.size());
+    m_effect.recycleStatesForInputChannel(std::move(pStates));
+    EXPECT_EQ(1, m_effect.memoryReport().pooledInputChannelCount);
+
+    // The same state objects are reset instead of being recreated
+    pStates = m_effect.createStatesForInputChannel(m_engineParameters);
+    std::vector<const EffectState*> reusedStatePointers;
+    for (const auto& pState : std::as_const(*pStates)) {
+        if (pState) {
+            reusedStatePointers.push_back(pState.get());
+        }
+    }
+    EXPECT_EQ(statePointers, reusedStatePointers);
+    EXPECT_EQ(kOutputCount, CountingEffectState::s_createdCount);
+    EXPECT_EQ(kOutputCount, CountingEffectState::s_resetCount);
+    m_effect.recycleStatesForInputChannel(std::move(pStates));
+
+    // States for other engine parameters are recreated
+    const mixxx::EngineParameters otherEngineParameters(
+            mixxx::audio::SampleRate(48000), 512);
+    pStates = m_effect.createStatesForInputChannel(otherEngineParameters);
+    EXPECT_EQ(2 * kOutputCount, CountingEffectState::s_createdCount);
+    EXPECT_EQ(kOutputCount, CountingEffectState::s_resetCount);
+    EXPECT_EQ(kOutputCount, CountingEffectState::s_liveCount);
+    for (const auto& pState : std::as_const(*pStates)) {
+        if (pState) {
+            EXPECT_TRUE(pState->isCreatedFor(otherEngineParameters));
+        }
+    }
+    m_effect.recycleStatesForInputChannel(std::move(pStates));
+}
+
+TEST_F(EffectProcessorTest, RouteAllInputChannels) {
+    m_effect.initialize({}, m_outputChannels, m_engineParameters);
+
+    for (const auto& inputChannel : std::as_const(m_inputChannels)) {
+        route(inputChannel.handle());
+    }
+    for (const auto& inputChannel : std::as_const(m_inputChannels)) {
+        process(inputChannel.handle());
+    }
+    const int stateCount = (kDeckCount + kSamplerCount) * kOutputCount;
+    EXPECT_EQ(stateCount, CountingEffectState::s_createdCount);
+    EXPECT_EQ(stateCount, m_effect.memoryReport().stateCount);
+    EXPECT_EQ(kDeckCount + kSamplerCount, m_effect.memoryReport().inputChannelCount);
+
+    // Only a few unused states are kept
+    for (const auto& inputChannel : std::as_const(m_inputChannels)) {
+        unroute(inputChannel.handle());
+    }
+    const EffectStatesMemoryReport report = m_effect.memoryReport();
+    EXPECT_GE(2, report.pooledInputChannelCount);
+    EXPECT_EQ(report.pooledInputChannelCount, report.inputChannelCount);
+    EXPECT_EQ(report.pooledInputChannelCount * kOutputCount, report.stateCount);
+    EXPECT_EQ(report.stateCount, CountingEffectState::s_liveCount);
+
+    // Routing again doesn't keep more states than needed
+    route(m_inputChannels.at(0).handle());
+    route(m_inputChannels.at(1).handle());
+    route(m_inputChannels.at(2).handle());
+    EXPECT_EQ(3, m_effect.memoryReport().inputChannelCount);
+    EXPECT_EQ(0, m_effect.memoryReport().pooledInputChannelCount);
+    EXPECT_EQ(3 * kOutputCount, CountingEffectState::s_liveCount);
+}
+
+} // namespace
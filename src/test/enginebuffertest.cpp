@@ -526,3 +526,47 @@ TEST_F(EngineBufferTest, RatePermTest) {
     ControlObject::set(ConfigKey(m_sGroup1, "rate_perm_up_small"), 0);
     EXPECT_EQ(1.06, m_pChannel1->getEngineBuffer()->m_speed_old);
 }
+
+TEST_F(EngineBufferE2ETest, AdaptiveKeylockStepsDownFadedOutDeckFirst) {
+    ControlObject::set(ConfigKey("[Master]", "keylock_engine"),
+            static_cast<double>(EngineBuffer::KeylockEngine::RubberBandFaster));
+    ControlObject::set(ConfigKey("[Master]", "keylock_engine_adaptive"), 1.0);
+    ControlObject::set(ConfigKey(m_sGroup1, "keylock"), 1.0);
+    ControlObject::set(ConfigKey(m_sGroup2, "keylock"), 1.0);
+    ControlObject::set(ConfigKey(m_sGroup1, "play"), 1.0);
+    ControlObject::set(ConfigKey(m_sGroup2, "play"), 1.0);
+    // Deck 2 is playing, but not audible in the main mix
+    ControlObject::set(ConfigKey(m_sGroup2, "volume"), 0.0);
+
+    // More than the step down hold time of the KeylockQualityPolicy
+    const int kBuffersPerSecond = 44100 / (kProcessBufferSize / 2) + 1;
+
+    // A medium load only affects the faded out deck
+    ControlObject::set(ConfigKey("[Master]", "audio_latency_usage"), 0.6);
+    for (int i = 0; i < kBuffersPerSecond; ++i) {
+        ProcessBuffer();
+    }
+    EXPECT_EQ(static_cast<double>(EngineBuffer::KeylockEngine::RubberBandFaster),
+            ControlObject::get(ConfigKey(m_sGroup1, "keylock_engine_active")));
+    EXPECT_EQ(static_cast<double>(EngineBuffer::KeylockEngine::SoundTouch),
+            ControlObject::get(ConfigKey(m_sGroup2, "keylock_engine_active")));
+
+    // Beyond the range displayed by the skins, the on-air deck steps down too
+    ControlObject::set(ConfigKey("[Master]", "audio_latency_usage"), 0.95);
+    EXPECT_EQ(0.95, ControlObject::get(ConfigKey("[Master]", "audio_latency_usage")));
+    for (int i = 0; i < kBuffersPerSecond; ++i) {
+        ProcessBuffer();
+    }
+    EXPECT_EQ(static_cast<double>(EngineBuffer::KeylockEngine::SoundTouch),
+            ControlObject::get(ConfigKey(m_sGroup1, "keylock_engine_active")));
+    EXPECT_EQ(m_pChannel1->getEngineBuffer()->m_pScaleST,
+            m_pChannel1->getEngineBuffer()->m_pScaleKeylock);
+
+    // Disabling the adaptive mode restores the selected engine
+    ControlObject::set(ConfigKey("[Master]", "keylock_engine_adaptive"), 0.0);
+    ProcessBuffer();
+    EXPECT_EQ(static_cast<double>(EngineBuffer::KeylockEngine::RubberBandFaster),
+            ControlObject::get(ConfigKey(m_sGroup1, "keylock_engine_active")));
+    EXPECT_EQ(static_cast<double>(EngineBuffer::KeylockEngine::RubberBandFaster),
+            ControlObject::get(ConfigKey(m_sGroup2, "keylock_engine_active")));
+}
@@ -1,9 +1,81 @@
+#include <benchmark/benchmark.h>
 #include <gtest/gtest.h>
 
+#include <memory>
+#include <vector>
+
+#include "engine/filters/enginefilterbessel4.h"
+#include "engine/filters/enginefilterbessel8.h"
 #include "engine/filters/enginefilterbiquad1.h"
+#include "engine/filters/enginefilterlinkwitzriley8.h"
+#include "util/samplebuffer.h"
 
 namespace {
 
+constexpr int kSampleRate = 44100;
+constexpr int kBufferSize = 1024;
+
+/// Filters the channels one after another with scalar doubles, like the
+/// filters did before both channels were processed together in an
+/// IIRStereoSample. Only the settled case without ramping is supported.
+template<typename Filter, unsigned int SIZE>
+class ScalarFilter : public Filter {
+  public:
+    ScalarFilter(int sampleRate, double freqCorner1)
+            : Filter(sampleRate, freqCorner1),
+              m_buf1(),
+              m_buf2() {
+    }
+
+    void process(const CSAMPLE* pIn, CSAMPLE* pOutput, const int iBufferSize) override {
+        for (int i = 0; i < iBufferSize; i += 2) {
+            pOutput[i] = static_cast<CSAMPLE>(this->processSample(
+                    this->m_coef, m_buf1, static_cast<double>(pIn[i])));
+            pOutput[i + 1] = static_cast<CSAMPLE>(this->processSample(
+                    this->m_coef, m_buf2, static_cast<double>(pIn[i + 1])));
+        }
+    }
+
+  private:
+    double m_buf1[SIZE];
+    double m_buf2[SIZE];
+};
+
+void fillInput(mixxx::SampleBuffer* pInput) {
+    for (SINT i = 0; i < pInput->size(); ++i) {
+        (*pInput)[i] = static_cast<CSAMPLE>(i % 64) / 64 - 0.5f;
+    }
+}
+
+void fillNoise(mixxx::SampleBuffer* pInput, unsigned int* pSeed) {
+    for (SINT i = 0; i < pInput->size(); ++i) {
+        // A linear congruential generator, the same sequence on all platforms
+        *pSeed = *pSeed * 1664525u + 1013904223u;
+        (*pInput)[i] = static_cast<CSAMPLE>(*pSeed >> 8) / (1 << 24) - 0.5f;
+    }
+}
+
+template<typename Filter, unsigned int SIZE>
+void expectMatchesScalarFilter() {
+    Filter filter(kSampleRate, 1000);
+    ScalarFilter<Filter, SIZE> scalarFilter(kSampleRate, 1000);
+    filter.assumeSettled();
+    scalarFilter.assumeSettled();
+    mixxx::SampleBuffer input(kBufferSize);
+    mixxx::SampleBuffer output(kBufferSize);
+    mixxx::SampleBuffer scalarOutput(kBufferSize);
+    unsigned int seed = 1;
+    for (int buffer = 0; buffer < 16; ++buffer) {
+        fillNoise(&input, &seed);
+        filter.process(input.data(), output.data(), kBufferSize);
+        scalarFilter.process(input.data(), scalarOutput.data(), kBufferSize);
+        for (int i = 0; i < kBufferSize; ++i) {
+            SCOPED_TRACE(buffer * kBufferSize + i);
+            ASSERT_NEAR(scalarOutput[i], output[i], 1e-6f);
+        }
+    }
+}
+
 class EngineFilterBiquadTest : public testing::Test {
 };
 
@@ -19,4 +91,93 @@ TEST_F(EngineFilterBiquadTest, fidspecLengthIsLongEnough) {
     ASSERT_TRUE(FIDSPEC_LENGTH > strlen("LsBq/1.2200000000/-12.0000000000"));
 }
 
+TEST_F(EngineFilterBiquadTest, stereoChannelsAreIndependent) {
+    // Both channels are processed together but must not affect each other
+    EngineFilterLinkwitzRiley8Low filter(kSampleRate, 1000);
+    filter.assumeSettled();
+    mixxx::SampleBuffer input(kBufferSize);
+    mixxx::SampleBuffer output(kBufferSize);
+    input.clear();
+    input[0] = 1.0f;
+    input[3] = -1.0f;
+    filter.process(input.data(), output.data(), kBufferSize);
+    for (int i = 0; i < kBufferSize / 2; ++i) {
+        SCOPED_TRACE(i);
+        if (i == 0) {
+            EXPECT_NE(0.0f, output[2 * i]);
+            EXPECT_EQ(0.0f, output[2 * i + 1]);
+        } else {
+            // The right channel is the inverted left channel delayed by one frame
+            EXPECT_FLOAT_EQ(-output[2 * (i - 1)], output[2 * i + 1]);
+        }
+    }
+}
+
+TEST_F(EngineFilterBiquadTest, stereoSampleMatchesScalarFilter) {
+    {
+        SCOPED_TRACE("EngineFilterBessel4Low");
+        expectMatchesScalarFilter<EngineFilterBessel4Low, 4>();
+    }
+    {
+        SCOPED_TRACE("EngineFilterLinkwitzRiley8Low");
+        expectMatchesScalarFilter<EngineFilterLinkwitzRiley8Low, 8>();
+    }
+    {
+        SCOPED_TRACE("EngineFilterBessel8Low");
+        expectMatchesScalarFilter<EngineFilterBessel8Low, 8>();
+    }
+}
+
+// Each deck has its own filters that are processed one after another
+template<typename Filter>
+void processDecks(benchmark::State& state) {
+    const auto deckCount = static_cast<int>(state.range(0));
+    std::vector<std::unique_ptr<Filter>> filters;
+    for (int i = 0; i < deckCount; ++i) {
+        filters.push_back(std::make_unique<Filter>(kSampleRate, 1000));
+        filters.back()->assumeSettled();
+    }
+    mixxx::SampleBuffer input(kBufferSize);
+    mixxx::SampleBuffer output(kBufferSize);
+    fillInput(&input);
+    for (auto _ : state) {
+        for (const auto& pFilter : filters) {
+            pFilter->process(input.data(), output.data(), kBufferSize);
+        }
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.iterations() * deckCount * kBufferSize / 2);
+}
+
 } // namespace
+
+static void BM_EngineFilterBessel4LowDecks(benchmark::State& state) {
+    processDecks<EngineFilterBessel4Low>(state);
+}
+BENCHMARK(BM_EngineFilterBessel4LowDecks)->Arg(4)->Arg(8);
+
+// The baseline that filters the channels one after another
+static void BM_EngineFilterBessel4LowDecksScalar(benchmark::State& state) {
+    processDecks<ScalarFilter<EngineFilterBessel4Low, 4>>(state);
+}
+BENCHMARK(BM_EngineFilterBessel4LowDecksScalar)->Arg(4)->Arg(8);
+
+static void BM_EngineFilterLinkwitzRiley8LowDecks(benchmark::State& state) {
+    processDecks<EngineFilterLinkwitzRiley8Low>(state);
+}
+BENCHMARK(BM_EngineFilterLinkwitzRiley8LowDecks)->Arg(4)->Arg(8);
+
+static void BM_EngineFilterLinkwitzRiley8LowDecksScalar(benchmark::State& state) {
+    processDecks<ScalarFilter<EngineFilterLinkwitzRiley8Low, 8>>(state);
+}
+BENCHMARK(BM_EngineFilterLinkwitzRiley8LowDecksScalar)->Arg(4)->Arg(8);
+
+static void BM_EngineFilterBessel8LowDecks(benchmark::State& state) {
+    processDecks<EngineFilterBessel8Low>(state);
+}
+BENCHMARK(BM_EngineFilterBessel8LowDecks)->Arg(4)->Arg(8);
+
+static void BM_EngineFilterBessel8LowDecksScalar(benchmark::State& state) {
+    processDecks<ScalarFilter<EngineFilterBessel8Low, 8>>(state);
+}
+BENCHMARK(BM_EngineFilterBessel8LowDecksScalar)->Arg(4)->Arg(8);
@@ -1,10 +1,18 @@
+#include <benchmark/benchmark.h>
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
 #include <QtDebug>
+#include <memory>
+#include <vector>
 
 #include "control/controlproxy.h"
+#include "effects/effectsmanager.h"
+#include "engine/channelmixer.h"
 #include "engine/channels/enginechannel.h"
+#include "engine/effects/engineeffectchain.h"
+#include "engine/effects/engineeffectsmanager.h"
+#include "engine/effects/message.h"
 #include "engine/enginemaster.h"
 #include "test/mixxxtest.h"
 #include "test/signalpathtest.h"
@@ -50,6 +58,12 @@ class EngineMasterTest : public BaseSignalPathTest {
           assertBufferMatchesReference(m_pEngineMaster->getHeadphoneBuffer(), MAX_BUFFER_LEN,
               QString("%1-headphone").arg(testName));
     };
+
+    void assertBufferEquals(const std::vector<CSAMPLE>& expected, const CSAMPLE* pActual) {
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            ASSERT_EQ(expected[i], pActual[i]) << "at sample " << i;
+        }
+    }
 };
 
 TEST_F(EngineMasterTest, SingleChannelOutputWorks) {
@@ -428,4 +442,165 @@ TEST_F(EngineMasterTest, ThreeChannelPFLOutputWorks) {
     assertHeadphoneBufferMatchesGolden(testName);
 }
 
+
+TEST_F(EngineMasterTest, ManyChannelsMixMatchesSeparatePasses) {
+    // More samples than mixed in one block by ChannelMixer
+    constexpr int kBufferSize = 2048;
+    constexpr int kNumChannels = 10;
+    // A channel in the middle of the mix that is processed by a postfader
+    // effect chain, which interrupts the single pass mixing
+    constexpr int kPostFaderChannel = 6;
+    ControlObject::set(ConfigKey(m_sMasterGroup, "headSplit"), 1.0);
+    ControlObject::set(ConfigKey(m_sMasterGroup, "headGain"), 0.5);
+    // Half PFL, half master in the headphones
+    ControlObject::set(ConfigKey(m_sMasterGroup, "headMix"), 0.0);
+    constexpr CSAMPLE_GAIN kHeadMixGain = 0.5f;
+
+    QSet<ChannelHandleAndGroup> inputChannels;
+    for (int i = 0; i < kNumChannels; ++i) {
+        const QString group = QStringLiteral("[Test%1]").arg(i + 1);
+        inputChannels.insert(m_pEngineMaster->registerChannelGroup(group));
+    }
+    const QSet<ChannelHandleAndGroup> outputChannels = {
+            m_pEngineMaster->registerChannelGroup(m_sMasterGroup),
+            m_pEngineMaster->registerChannelGroup(QStringLiteral("[Headphone]"))};
+    // The chain has no effects, so it leaves the samples unchanged
+    EngineEffectChain chain(QStringLiteral("[TestChain]"), inputChannels, outputChannels);
+    const auto pipes = TwoWayMessagePipe<EffectsRequest*, EffectsResponse>::
+            makeTwoWayMessagePipe(8, 8);
+    std::unique_ptr<EffectsRequestPipe> pRequestPipe(pipes.first);
+    std::unique_ptr<EffectsResponsePipe> pResponsePipe(pipes.second);
+    EngineEffectsManager* pEngineEffectsManager = m_pEffectsManager->getEngineEffectsManager();
+    EffectsRequest addChain;
+    addChain.type = EffectsRequest::ADD_EFFECT_CHAIN;
+    addChain.AddEffectChain.pChain = &chain;
+    addChain.AddEffectChain.signalProcessingStage = SignalProcessingStage::Postfader;
+    ASSERT_TRUE(pEngineEffectsManager->processEffectsRequest(addChain, pResponsePipe.get()));
+    EffectsRequest enableChain;
+    enableChain.type = EffectsRequest::ENABLE_EFFECT_CHAIN_FOR_INPUT_CHANNEL;
+    enableChain.pTargetChain = &chain;
+    enableChain.EnableInputChannelForChain.channelHandle =
+            m_pEngineMaster->registerChannelGroup(
+                                   QStringLiteral("[Test%1]").arg(kPostFaderChannel + 1))
+                    .handle();
+    ASSERT_TRUE(chain.processEffectsRequest(enableChain, pResponsePipe.get()));
+
+    std::vector<std::vector<CSAMPLE>> inputs;
+    std::vector<CSAMPLE_GAIN> volumes;
+    std::vector<bool> pflEnabled;
+    for (int i = 0; i < kNumChannels; ++i) {
+        const QString group = QStringLiteral("[Test%1]").arg(i + 1);
+        auto* pChannel = new testing::NiceMock<EngineChannelMock>(
+                group, EngineChannel::CENTER, m_pEngineMaster);
+        m_pEngineMaster->addChannel(pChannel);
+        ON_CALL(*pChannel, updateActiveState())
+                .WillByDefault(Return(EngineChannel::ActiveState::Active));
+        ON_CALL(*pChannel, isActive()).WillByDefault(Return(true));
+        ON_CALL(*pChannel, isMasterEnabled()).WillByDefault(Return(true));
+        const bool pfl = i % 3 == 0;
+        ON_CALL(*pChannel, isPflEnabled()).WillByDefault(Return(pfl));
+        pflEnabled.push_back(pfl);
+
+        CSAMPLE* pBuffer = const_cast<CSAMPLE*>(m_pEngineMaster->getChannelBuffer(group));
+        for (int j = 0; j < kBufferSize; ++j) {
+            pBuffer[j] = 0.01f * (i + 1) * static_cast<CSAMPLE>(j % 7 - 3);
+        }
+        inputs.emplace_back(pBuffer, pBuffer + kBufferSize);
+        volumes.push_back(static_cast<CSAMPLE_GAIN>(1.0 - 0.07 * i));
+        ControlObject::set(ConfigKey(group, "volume"), volumes.back());
+    }
+
+    m_pEngineMaster->process(kBufferSize);
+
+    EffectsRequest removeChain;
+    removeChain.type = EffectsRequest::REMOVE_EFFECT_CHAIN;
+    removeChain.RemoveEffectChain.pChain = &chain;
+    removeChain.RemoveEffectChain.signalProcessingStage = SignalProcessingStage::Postfader;
+    ASSERT_TRUE(pEngineEffectsManager->processEffectsRequest(removeChain, pResponsePipe.get()));
+
+    // The same mix with a separate pass over the buffers for each step,
+    // the gains ramp up from zero in the first callback
+    std::vector<CSAMPLE> channel(kBufferSize);
+    std::vector<CSAMPLE> expectedBus(kBufferSize, CSAMPLE_ZERO);
+    std::vector<CSAMPLE> expectedHead(kBufferSize, CSAMPLE_ZERO);
+    for (int i = 0; i < kNumChannels; ++i) {
+        if (pflEnabled[i]) {
+            SampleUtil::copyWithRampingGain(channel.data(),
+                    inputs[i].data(),
+                    CSAMPLE_GAIN_ZERO,
+                    kHeadMixGain,
+                    kBufferSize);
+            SampleUtil::add(expectedHead.data(), channel.data(), kBufferSize);
+        }
+        SampleUtil::copy(channel.data(), inputs[i].data(), kBufferSize);
+        SampleUtil::applyRampingGain(channel.data(), CSAMPLE_GAIN_ZERO, volumes[i], kBufferSize);
+        SampleUtil::add(expectedBus.data(), channel.data(), kBufferSize);
+        // The gain is applied to the channel buffer in place
+        assertBufferEquals(channel,
+                m_pEngineMaster->getChannelBuffer(QStringLiteral("[Test%1]").arg(i + 1)));
+    }
+    assertBufferEquals(expectedBus, m_pEngineMaster->getOutputBusBuffer(EngineChannel::CENTER));
+
+    // Head Split puts the master mix on the right channel
+    std::vector<CSAMPLE> master(kBufferSize);
+    SampleUtil::copy3WithGain(master.data(),
+            m_pEngineMaster->getOutputBusBuffer(EngineChannel::LEFT),
+            1.0,
+            m_pEngineMaster->getOutputBusBuffer(EngineChannel::CENTER),
+            1.0,
+            m_pEngineMaster->getOutputBusBuffer(EngineChannel::RIGHT),
+            1.0,
+            kBufferSize);
+    // The master mix ramps up from zero in the headphones
+    SampleUtil::addWithRampingGain(expectedHead.data(),
+            master.data(),
+            CSAMPLE_GAIN_ZERO,
+            kHeadMixGain,
+            kBufferSize);
+    for (int i = 0; i + 1 < kBufferSize; i += 2) {
+        expectedHead[i] = (expectedHead[i] + expectedHead[i + 1]) / 2;
+        expectedHead[i + 1] = (master[i] + master[i + 1]) / 2;
+    }
+    SampleUtil::applyRampingGain(expectedHead.data(), CSAMPLE_GAIN_ONE, 0.5f, kBufferSize);
+    assertBufferEquals(expectedHead, m_pEngineMaster->getHeadphoneBuffer());
+}
+
 }  // namespace
+
+// Mixes the given number of channels with ramping gains into a bus without
+// modifying the channel buffers, either with a copy and an add pass per
+// channel like the effects processing or in a single pass by ChannelMixer.
+static void BM_MixChannelsWithRampingGains(benchmark::State& state) {
+    constexpr unsigned int kBufferSize = 2048;
+    const auto numChannels = static_cast<int>(state.range(0));
+    const bool singlePass = state.range(1) != 0;
+    std::vector<std::vector<CSAMPLE>> channels(
+            numChannels, std::vector<CSAMPLE>(kBufferSize, 0.1f));
+    std::vector<ChannelMixer::ChannelGain> channelGains;
+    for (auto& channel : channels) {
+        channelGains.push_back(ChannelMixer::ChannelGain{
+                channel.data(), RampingGain(0.9f, 1.0f, kBufferSize)});
+    }
+    std::vector<CSAMPLE> temp(kBufferSize);
+    std::vector<CSAMPLE> output(kBufferSize);
+
+    for (auto _ : state) {
+        SampleUtil::clear(output.data(), kBufferSize);
+        if (singlePass) {
+            ChannelMixer::mixChannelsWithRampingGains(output.data(),
+                    channelGains.data(),
+                    numChannels,
+                    kBufferSize);
+        } else {
+            for (const auto& channel : channels) {
+                SampleUtil::copyWithRampingGain(
+                        temp.data(), channel.data(), 0.9f, 1.0f, kBufferSize);
+                SampleUtil::add(output.data(), temp.data(), kBufferSize);
+            }
+        }
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.iterations() * numChannels * kBufferSize);
+}
+// Number of channels, single pass
+BENCHMARK(BM_MixChannelsWithRampingGains)->ArgsProduct({{4, 8, 16}, {0, 1}});
@@ -1,6 +1,8 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
 #include <string>
 
 #include "control/controlobject.h"
@@ -1723,6 +1725,74 @@ TEST_F(EngineSyncTest, ActivatingSyncDoesNotCauseDrifting) {
                     ->get());
 }
 
+TEST_F(EngineSyncTest, LongBlendStaysInPhaseWithinAFrame) {
+    // A 10 minute blend of two tracks at 1024 frames per buffer while the
+    // leader is slowly ramped up and down again. The follower is dropped in
+    // a little behind the beat, too little to be treated as out of sync.
+    constexpr int kBufferFrames = 1024;
+    constexpr int kBlendBuffers = 10 * 60 * 44100 / kBufferFrames;
+    // The decks may start out of phase with the internal clock, they are
+    // expected to have caught up after this
+    constexpr int kSettleBuffers = 30 * 44100 / kBufferFrames;
+    constexpr double kPhaseOffsetFrames = 100;
+    constexpr double kMaxRateRatioChange = 0.06;
+    const auto blendDuration = mixxx::Duration::fromSeconds(12 * 60);
+    m_pTrack1 = m_pMixerDeck1->loadFakeTrack(false, 0.0, blendDuration);
+    m_pTrack2 = m_pMixerDeck2->loadFakeTrack(false, 0.0, blendDuration);
+
+    mixxx::BeatsPointer pBeats1 = mixxx::Beats::fromConstTempo(
+            m_pTrack1->getSampleRate(), mixxx::audio::kStartFramePos, mixxx::Bpm(128));
+    m_pTrack1->trySetBeats(pBeats1);
+    mixxx::BeatsPointer pBeats2 = mixxx::Beats::fromConstTempo(
+            m_pTrack2->getSampleRate(),
+            mixxx::audio::FramePos(kPhaseOffsetFrames),
+            mixxx::Bpm(124));
+    m_pTrack2->trySetBeats(pBeats2);
+
+    ControlObject::set(ConfigKey(m_sGroup1, "sync_mode"),
+            static_cast<double>(SyncMode::LeaderExplicit));
+    ControlObject::set(ConfigKey(m_sGroup2, "sync_mode"),
+            static_cast<double>(SyncMode::Follower));
+    // Start both decks without a phase seek
+    ControlObject::set(ConfigKey(m_sGroup1, "play"), 1.0);
+    ControlObject::set(ConfigKey(m_sGroup2, "play"), 1.0);
+    m_pEngineMaster->process(kBufferFrames * 2);
+
+    // The phase error in frames of the output, which is the beat length
+    // of the leader at its current tempo
+    auto phaseErrorFrames = [&]() {
+        const double leaderBeatLengthFrames = m_pTrack1->getSampleRate() * 60.0 /
+                ControlObject::get(ConfigKey(m_sGroup1, "bpm"));
+        return std::abs(BpmControl::shortestPercentageChange(
+                       ControlObject::get(ConfigKey(m_sGroup1, "beat_distance")),
+                       ControlObject::get(ConfigKey(m_sGroup2, "beat_distance")))) *
+                leaderBeatLengthFrames;
+    };
+    // Without quantize the follower only matches the tempo, so the offset in
+    // the track of the follower is played back faster by 128 / 124
+    EXPECT_NEAR(kPhaseOffsetFrames * 124 / 128, phaseErrorFrames(), 1.0);
+
+    ControlObject::set(ConfigKey(m_sGroup1, "quantize"), 1.0);
+    ControlObject::set(ConfigKey(m_sGroup2, "quantize"), 1.0);
+
+    double maxPhaseErrorFrames = 0;
+    for (int i = 0; i < kBlendBuffers; ++i) {
+        // Triangle from 1 to 1 + kMaxRateRatioChange and back
+        const double progress = static_cast<double>(i) / kBlendBuffers;
+        ControlObject::set(ConfigKey(m_sGroup1, "rate_ratio"),
+                1.0 + kMaxRateRatioChange * (1.0 - std::abs(2 * progress - 1.0)));
+        m_pEngineMaster->process(kBufferFrames * 2);
+        if (i >= kSettleBuffers) {
+            maxPhaseErrorFrames = std::max(maxPhaseErrorFrames, phaseErrorFrames());
+        }
+    }
+    RecordProperty("max_phase_error_frames", std::to_string(maxPhaseErrorFrames));
+
+    // Make sure we're actually going somewhere!
+    EXPECT_GT(ControlObject::get(ConfigKey(m_sGroup2, "playposition")), 0.8);
+    EXPECT_LT(maxPhaseErrorFrames, 1.0);
+}
+
 TEST_F(EngineSyncTest, HalfDoubleBpmTest) {
     mixxx::BeatsPointer pBeats1 = mixxx::Beats::fromConstTempo(
             m_pTrack1->getSampleRate(), mixxx::audio::kStartFramePos, mixxx::Bpm(70));
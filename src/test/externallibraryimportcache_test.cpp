@@ -0,0 +1,364 @@
+#include "library/externallibraryimportcache.h"
+
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QDateTime>
+#include <QFile>
+#include <QFuture>
+#include <QTemporaryDir>
+#include <QtConcurrentRun>
+
+#include "control/controlindicatortimer.h"
+#include "effects/effectsmanager.h"
+#include "engine/enginemaster.h"
+#include "library/itunes/itunesfeature.h"
+#include "library/library.h"
+#include "library/library_prefs.h"
+#include "library/libraryfeature.h"
+#include "library/traktor/traktorfeature.h"
+#include "library/treeitem.h"
+#include "mixer/playerinfo.h"
+#include "mixer/playermanager.h"
+#include "recording/recordingmanager.h"
+#include "soundio/soundmanager.h"
+#include "test/librarybenchmark.h"
+#include "test/mixxxdbtest.h"
+
+namespace {
+
+const QString kSettingsKey = QStringLiteral("mixxx.test.importcache");
+
+class TestFeature : public LibraryFeature {
+  public:
+    explicit TestFeature(UserSettingsPointer pConfig)
+            : LibraryFeature(nullptr, pConfig, QString()) {
+    }
+    QVariant title() override {
+        return QVariant();
+    }
+    TreeItemModel* sidebarModel() const override {
+        return nullptr;
+    }
+    void activate() override {
+    }
+};
+
+class ExternalLibraryImportCacheTest : public MixxxDbTest {
+  protected:
+    ExternalLibraryImportCacheTest()
+            : m_feature(config()),
+              m_filePath(m_tempDir.filePath(QStringLiteral("collection.xml"))) {
+        writeFile("<collection>1</collection>");
+    }
+
+    void writeFile(const QByteArray& content) {
+        QFile file(m_filePath);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        ASSERT_EQ(content.size(), file.write(content));
+    }
+
+    void setLastModified(const QDateTime& lastModified) {
+        QFile file(m_filePath);
+        ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+        ASSERT_TRUE(file.setFileTime(lastModified, QFileDevice::FileModificationTime));
+    }
+
+    std::unique_ptr<TreeItem> createTree() {
+        auto pRootItem = TreeItem::newRoot(&m_feature);
+        TreeItem* pFolder = pRootItem->appendChild(
+                QStringLiteral("Folder"), QStringLiteral("/Folder"));
+        pFolder->appendChild(QStringLiteral("Playlist"), QStringLiteral("/Folder/Playlist"));
+        pRootItem->appendChild(QStringLiteral("Other"), QStringLiteral("/Other"));
+        return pRootItem;
+    }
+
+    std::unique_ptr<TreeItem> restore() {
+        ExternalLibraryImportCache cache(dbConnection(), kSettingsKey);
+        return cache.restore(m_filePath, &m_feature);
+    }
+
+    void store() {
+        ExternalLibraryImportCache cache(dbConnection(), kSettingsKey);
+        EXPECT_EQ(nullptr, cache.restore(m_filePath, &m_feature));
+        cache.store(m_filePath, createTree().get());
+    }
+
+    QTemporaryDir m_tempDir;
+    TestFeature m_feature;
+    const QString m_filePath;
+};
+
+TEST_F(ExternalLibraryImportCacheTest, SignatureToString) {
+    ExternalLibraryImportCache::FileSignature signature;
+    signature.size = 123;
+    signature.lastModifiedMs = 456;
+    signature.contentHash = QByteArray("\x01\x02\xff", 3);
+    const auto restored = ExternalLibraryImportCache::FileSignature::fromString(
+            signature.toString());
+    EXPECT_EQ(signature.size, restored.size);
+    EXPECT_EQ(signature.lastModifiedMs, restored.lastModifiedMs);
+    EXPECT_EQ(signature.contentHash, restored.contentHash);
+
+    EXPECT_FALSE(ExternalLibraryImportCache::FileSignature::fromString(QString()).isValid());
+    EXPECT_FALSE(ExternalLibraryImportCache::FileSignature::fromString("1;x;00").isValid());
+}
+
+TEST_F(ExternalLibraryImportCacheTest, RestoreUnchangedFile) {
+    store();
+
+    const auto pRootItem = restore();
+    ASSERT_NE(nullptr, pRootItem);
+    EXPECT_EQ(ExternalLibraryImportCache::serializeTree(createTree().get()),
+            ExternalLibraryImportCache::serializeTree(pRootItem.get()));
+    ASSERT_EQ(2, pRootItem->childRows());
+    EXPECT_EQ(QStringLiteral("Playlist"), pRootItem->child(0)->child(0)->getLabel());
+    EXPECT_EQ(QVariant(QStringLiteral("/Other")), pRootItem->child(1)->getData());
+}
+
+TEST_F(ExternalLibraryImportCacheTest, TouchedFileWithSameContent) {
+    store();
+    setLastModified(QDateTime::currentDateTime().addSecs(60));
+    EXPECT_NE(nullptr, restore());
+}
+
+TEST_F(ExternalLibraryImportCacheTest, ChangedFile) {
+    store();
+    // Same size, different content
+    writeFile("<collection>2</collection>");
+    setLastModified(QDateTime::currentDateTime().addSecs(60));
+    EXPECT_EQ(nullptr, restore());
+}
+
+TEST_F(ExternalLibraryImportCacheTest, Invalidate) {
+    store();
+    ExternalLibraryImportCache(dbConnection(), kSettingsKey).invalidate();
+    EXPECT_EQ(nullptr, restore());
+}
+
+} // namespace
+
+// Imports the iTunes and Traktor libraries like the features do when they
+// are activated, either parsing the collection again after it has changed
+// (cold) or reusing the tables of the previous import (warm).
+class ExternalLibraryImportBenchmark : public LibraryBenchmark {
+  public:
+    ExternalLibraryImportBenchmark()
+            : LibraryBenchmark(false) {
+    }
+
+    using LibraryBenchmark::SetUp;
+    using LibraryBenchmark::TearDown;
+
+    void SetUp(benchmark::State& state) override {
+        LibraryBenchmark::SetUp(state);
+        // The features are created below and would conflict
+        // with the ones that the Library creates
+        config()->setValue(ConfigKey(mixxx::library::prefs::kConfigGroup,
+                                   QStringLiteral("ShowITunesLibrary")),
+                false);
+        config()->setValue(ConfigKey(mixxx::library::prefs::kConfigGroup,
+                                   QStringLiteral("ShowTraktorLibrary")),
+                false);
+
+        // Same as in PlayerManagerTest
+        auto pChannelHandleFactory = std::make_shared<ChannelHandleFactory>();
+        m_pEffectsManager = std::make_unique<EffectsManager>(config(), pChannelHandleFactory);
+        m_pEngine = std::make_unique<EngineMaster>(
+                config(),
+                "[Master]",
+                m_pEffectsManager.get(),
+                pChannelHandleFactory,
+                true);
+        m_pSoundManager = std::make_unique<SoundManager>(config(), m_pEngine.get());
+        m_pControlIndicatorTimer = std::make_unique<mixxx::ControlIndicatorTimer>(nullptr);
+        m_pEngine->registerNonEngineChannelSoundIO(m_pSoundManager.get());
+        m_pPlayerManager = std::make_unique<PlayerManager>(config(),
+                m_pSoundManager.get(),
+                m_pEffectsManager.get(),
+                m_pEngine.get());
+        m_pPlayerManager->addConfiguredDecks();
+        PlayerInfo::create();
+        m_pEffectsManager->setup();
+        m_pRecordingManager = std::make_unique<RecordingManager>(config(), m_pEngine.get());
+        m_pLibrary = std::make_unique<Library>(
+                nullptr,
+                config(),
+                dbConnectionPooler(),
+                trackCollectionManager(),
+                m_pPlayerManager.get(),
+                m_pRecordingManager.get());
+
+        m_filePath = getTestDataDir().filePath(QStringLiteral("collection.xml"));
+    }
+
+    void TearDown(benchmark::State& state) override {
+        m_pSoundManager.reset();
+        m_pPlayerManager.reset();
+        PlayerInfo::destroy();
+        m_pLibrary.reset();
+        m_pRecordingManager.reset();
+        m_pEngine.reset();
+        m_pEffectsManager.reset();
+        m_pControlIndicatorTimer.reset();
+        LibraryBenchmark::TearDown(state);
+    }
+
+  protected:
+    // Writes a plist with the structure of an iTunes library
+    void writeITunesCollection(int trackCount) {
+        QFile file(m_filePath);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            return;
+        }
+        file.write("<plist><dict><key>Tracks</key><dict>\n");
+        for (int i = 0; i < trackCount; ++i) {
+            file.write(QStringLiteral(
+                    "<key>%1</key><dict>"
+                    "<key>Track ID</key><integer>%1</integer>"
+                    "<key>Name</key><string>Title %1</string>"
+                    "<key>Artist</key><string>Artist %2</string>"
+                    "<key>Location</key><string>file://localhost/Music/%1.mp3</string>"
+                    "</dict>\n")
+                               .arg(QString::number(i), QString::number(i % 100))
+                               .toUtf8());
+        }
+        file.write("</dict><key>Playlists</key><array/></dict></plist>\n");
+    }
+
+    // Writes an NML file with the structure of a Traktor collection
+    void writeTraktorCollection(int trackCount) {
+        QFile file(m_filePath);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            return;
+        }
+        file.write("<NML VERSION=\"19\"><COLLECTION>\n");
+        for (int i = 0; i < trackCount; ++i) {
+            file.write(QStringLiteral(
+                    "<ENTRY TITLE=\"Title %1\" ARTIST=\"Artist %2\">"
+                    "<LOCATION DIR=\"/:Music/:\" FILE=\"%1.mp3\" VOLUME=\"C:\"/>"
+                    "<INFO BITRATE=\"320000\" PLAYTIME=\"180\"/>"
+                    "<TEMPO BPM=\"120\"/>"
+                    "</ENTRY>\n")
+                               .arg(QString::number(i), QString::number(i % 100))
+                               .toUtf8());
+        }
+        file.write(
+                "</COLLECTION><PLAYLISTS>"
+                "<NODE TYPE=\"FOLDER\" NAME=\"$ROOT\"><SUBNODES COUNT=\"1\">"
+                "<NODE TYPE=\"PLAYLIST\" NAME=\"Playlist\">"
+                "<PLAYLIST ENTRIES=\"0\" TYPE=\"LIST\"></PLAYLIST>"
+                "</NODE></SUBNODES></NODE>"
+                "</PLAYLISTS></NML>\n");
+    }
+
+    // Runs the import on a worker thread like activate()
+    std::unique_ptr<TreeItem> importITunesLibrary(ITunesFeature* pFeature) {
+        pFeature->m_dbfile = m_filePath;
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+        QFuture<TreeItem*> future = QtConcurrent::run(
+                &ITunesFeature::importLibrary, pFeature);
+#else
+        QFuture<TreeItem*> future = QtConcurrent::run(
+                pFeature, &ITunesFeature::importLibrary);
+#endif
+        return std::unique_ptr<TreeItem>(future.result());
+    }
+
+    std::unique_ptr<TreeItem> importTraktorLibrary(TraktorFeature* pFeature) {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+        QFuture<TreeItem*> future = QtConcurrent::run(
+                &TraktorFeature::importLibrary, pFeature, m_filePath);
+#else
+        QFuture<TreeItem*> future = QtConcurrent::run(
+                pFeature, &TraktorFeature::importLibrary, m_filePath);
+#endif
+        return std::unique_ptr<TreeItem>(future.result());
+    }
+
+    // Cold activations alternate between two collections that differ by one
+    // track, so every import finds a changed file and parses it again.
+    template<typename Feature, typename WriteCollection, typename Import>
+    void runImport(benchmark::State& state,
+            bool cold,
+            WriteCollection writeCollection,
+            Import import) {
+        const int trackCount = static_cast<int>(state.range(0));
+        Feature feature(m_pLibrary.get(), config());
+        writeCollection(trackCount);
+        if (!import(&feature)) {
+            state.SkipWithError("Failed to import the collection");
+            return;
+        }
+        int changeCount = 0;
+        for (auto _ : state) {
+            if (cold) {
+                state.PauseTiming();
+                writeCollection(trackCount + (++changeCount % 2));
+                state.ResumeTiming();
+            }
+            std::unique_ptr<TreeItem> pRootItem = import(&feature);
+            benchmark::DoNotOptimize(pRootItem);
+            if (!pRootItem) {
+                state.SkipWithError("Failed to import the collection");
+                break;
+            }
+            state.PauseTiming();
+            pRootItem.reset();
+            state.ResumeTiming();
+        }
+    }
+
+    std::unique_ptr<EffectsManager> m_pEffectsManager;
+    std::unique_ptr<mixxx::ControlIndicatorTimer> m_pControlIndicatorTimer;
+    std::unique_ptr<EngineMaster> m_pEngine;
+    std::unique_ptr<SoundManager> m_pSoundManager;
+    std::unique_ptr<PlayerManager> m_pPlayerManager;
+    std::unique_ptr<RecordingManager> m_pRecordingManager;
+    std::unique_ptr<Library> m_pLibrary;
+    QString m_filePath;
+};
+
+BENCHMARK_DEFINE_F(ExternalLibraryImportBenchmark, ITunesCold)
+(benchmark::State& state) {
+    runImport<ITunesFeature>(state,
+            true,
+            [this](int trackCount) { writeITunesCollection(trackCount); },
+            [this](ITunesFeature* pFeature) { return importITunesLibrary(pFeature); });
+}
+BENCHMARK_REGISTER_F(ExternalLibraryImportBenchmark, ITunesCold)
+        ->Range(1000, 100000)
+        ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(ExternalLibraryImportBenchmark, ITunesWarm)
+(benchmark::State& state) {
+    runImport<ITunesFeature>(state,
+            false,
+            [this](int trackCount) { writeITunesCollection(trackCount); },
+            [this](ITunesFeature* pFeature) { return importITunesLibrary(pFeature); });
+}
+BENCHMARK_REGISTER_F(ExternalLibraryImportBenchmark, ITunesWarm)
+        ->Range(1000, 100000)
+        ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(ExternalLibraryImportBenchmark, TraktorCold)
+(benchmark::State& state) {
+    runImport<TraktorFeature>(state,
+            true,
+            [this](int trackCount) { writeTraktorCollection(trackCount); },
+            [this](TraktorFeature* pFeature) { return importTraktorLibrary(pFeature); });
+}
+BENCHMARK_REGISTER_F(ExternalLibraryImportBenchmark, TraktorCold)
+        ->Range(1000, 100000)
+        ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(ExternalLibraryImportBenchmark, TraktorWarm)
+(benchmark::State& state) {
+    runImport<TraktorFeature>(state,
+            false,
+            [this](int trackCount) { writeTraktorCollection(trackCount); },
+            [this](TraktorFeature* pFeature) { return importTraktorLibrary(pFeature); });
+}
+BENCHMARK_REGISTER_F(ExternalLibraryImportBenchmark, TraktorWarm)
+        ->Range(1000, 100000)
+        ->Unit(benchmark::kMillisecond);
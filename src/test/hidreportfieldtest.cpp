@@ -0,0 +1,131 @@
+#include "controllers/hid/hidreportfield.h"
+
+#include <gtest/gtest.h>
+
+namespace {
+
+HidReportField makeField(quint8 reportId,
+        int byteOffset,
+        int bitOffset,
+        int bitSize,
+        bool isSigned = false) {
+    HidReportField field;
+    field.reportId = reportId;
+    field.byteOffset = byteOffset;
+    field.bitOffset = bitOffset;
+    field.bitSize = bitSize;
+    field.isSigned = isSigned;
+    return field;
+}
+
+TEST(HidReportFieldTest, ExtractBits) {
+    const unsigned char data[] = {0x01, 0b10100101, 0x34, 0x12, 0xFF, 0xFF};
+    EXPECT_EQ(1, makeField(0, 1, 0, 1).extract(data));
+    EXPECT_EQ(0, makeField(0, 1, 1, 1).extract(data));
+    EXPECT_EQ(0b1010, makeField(0, 1, 4, 4).extract(data));
+    EXPECT_EQ(0x1234, makeField(0, 2, 0, 16).extract(data));
+    EXPECT_EQ(-1, makeField(0, 4, 0, 16, true).extract(data));
+    EXPECT_EQ(0xFFFF, makeField(0, 4, 0, 16).extract(data));
+    // Field crossing a byte boundary
+    EXPECT_EQ(0x4A, makeField(0, 1, 4, 8).extract(data) & 0xFF);
+}
+
+TEST(HidReportFieldTest, InsertBits) {
+    unsigned char data[] = {0x00, 0x00, 0x00};
+    EXPECT_TRUE(makeField(0, 0, 3, 2).insert(data, 0b11));
+    EXPECT_EQ(0b00011000, data[0]);
+    // Unchanged bits are detected
+    EXPECT_FALSE(makeField(0, 0, 3, 2).insert(data, 0b11));
+    EXPECT_TRUE(makeField(0, 1, 4, 12).insert(data, 0xABC));
+    EXPECT_EQ(0xC0, data[1]);
+    EXPECT_EQ(0xAB, data[2]);
+    EXPECT_EQ(0xABC, makeField(0, 1, 4, 12).extract(data));
+    // Neighbouring bits are preserved
+    EXPECT_EQ(0b00011000, data[0]);
+}
+
+TEST(HidReportFieldTest, InvalidFields) {
+    HidInputReportParser parser;
+    EXPECT_EQ(-1, parser.registerField(makeField(0, 0, 8, 1)));
+    EXPECT_EQ(-1, parser.registerField(makeField(0, 0, 0, 0)));
+    EXPECT_EQ(-1, parser.registerField(makeField(0, 0, 0, 33)));
+    EXPECT_TRUE(parser.isEmpty());
+}
+
+TEST(HidReportFieldTest, ParserReportsOnlyChangedFields) {
+    HidInputReportParser parser;
+    const int buttonId = parser.registerField(makeField(0x01, 1, 0, 1));
+    const int faderId = parser.registerField(makeField(0x01, 2, 0, 16));
+    const int otherReportId = parser.registerField(makeField(0x02, 1, 0, 8));
+
+    unsigned char report[] = {0x01, 0x00, 0x00, 0x00};
+    EXPECT_TRUE(parser.hasFieldsForReport(report, sizeof(report)));
+
+    // The first report contains all fields of the report
+    QVector<HidChangedField> changedFields;
+    parser.parseReport(report, sizeof(report), &changedFields);
+    ASSERT_EQ(2, changedFields.size());
+    EXPECT_EQ(buttonId, changedFields[0].fieldId);
+    EXPECT_EQ(faderId, changedFields[1].fieldId);
+
+    changedFields.clear();
+    parser.parseReport(report, sizeof(report), &changedFields);
+    EXPECT_TRUE(changedFields.isEmpty());
+
+    report[2] = 0x10;
+    changedFields.clear();
+    parser.parseReport(report, sizeof(report), &changedFields);
+    ASSERT_EQ(1, changedFields.size());
+    EXPECT_EQ(faderId, changedFields[0].fieldId);
+    EXPECT_EQ(0x10, changedFields[0].value);
+
+    // Report with another ID doesn't touch the fields of report 0x01
+    unsigned char otherReport[] = {0x02, 0x42};
+    changedFields.clear();
+    parser.parseReport(otherReport, sizeof(otherReport), &changedFields);
+    ASSERT_EQ(1, changedFields.size());
+    EXPECT_EQ(otherReportId, changedFields[0].fieldId);
+    EXPECT_EQ(0x42, changedFields[0].value);
+
+    // Reports without registered fields are passed on as raw data
+    unsigned char unknownReport[] = {0x03, 0x00};
+    EXPECT_FALSE(parser.hasFieldsForReport(unknownReport, sizeof(unknownReport)));
+
+    parser.clear();
+    EXPECT_FALSE(parser.hasFieldsForReport(report, sizeof(report)));
+}
+
+TEST(HidReportFieldTest, ParserTagsFieldsWithGeneration) {
+    HidInputReportParser parser;
+    const int oldGeneration = parser.generation();
+    const int oldId = parser.registerField(makeField(0, 1, 0, 8));
+    const unsigned char report[] = {0x00, 0x01};
+    QVector<HidChangedField> changedFields;
+    parser.parseReport(report, sizeof(report), &changedFields);
+    ASSERT_EQ(1, changedFields.size());
+    EXPECT_EQ(oldGeneration, changedFields[0].generation);
+
+    // The field ID is reused after clearing, but the generation differs,
+    // so still queued fields of the old binding can be told apart.
+    const int newGeneration = parser.clear();
+    EXPECT_NE(oldGeneration, newGeneration);
+    EXPECT_EQ(newGeneration, parser.generation());
+    EXPECT_EQ(oldId, parser.registerField(makeField(0, 0, 0, 8)));
+    changedFields.clear();
+    parser.parseReport(report, sizeof(report), &changedFields);
+    ASSERT_EQ(1, changedFields.size());
+    EXPECT_EQ(oldId, changedFields[0].fieldId);
+    EXPECT_EQ(newGeneration, changedFields[0].generation);
+}
+
+TEST(HidReportFieldTest, ParserIgnoresTruncatedReports) {
+    HidInputReportParser parser;
+    parser.registerField(makeField(0, 2, 0, 16));
+    const unsigned char report[] = {0x00, 0x00, 0x00};
+    EXPECT_FALSE(parser.hasFieldsForReport(report, sizeof(report)));
+    QVector<HidChangedField> changedFields;
+    parser.parseReport(report, sizeof(report), &changedFields);
+    EXPECT_TRUE(changedFields.isEmpty());
+}
+
+} // namespace
@@ -0,0 +1,81 @@
+#include "engine/bufferscalers/keylockqualitypolicy.h"
+
+#include <gtest/gtest.h>
+
+namespace {
+
+constexpr auto kSampleRate = mixxx::audio::SampleRate(48000);
+constexpr SINT kFrames = 1024;
+
+class KeylockQualityPolicyTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        m_policy.setMaxTier(2);
+    }
+
+    // Feeds callbacks with a constant load for the given duration,
+    // returns the number of tier changes
+    int runFor(double seconds, double load, CSAMPLE_GAIN gain) {
+        int changes = 0;
+        const SINT callbacks = static_cast<SINT>(seconds * kSampleRate / kFrames);
+        for (SINT i = 0; i < callbacks; ++i) {
+            if (m_policy.update(load, gain, kFrames, kSampleRate)) {
+                ++changes;
+            }
+        }
+        return changes;
+    }
+
+    KeylockQualityPolicy m_policy;
+};
+
+TEST_F(KeylockQualityPolicyTest, StaysAtMaxTierWithoutPressure) {
+    EXPECT_EQ(0, runFor(10.0, 0.2, CSAMPLE_GAIN_ONE));
+    EXPECT_EQ(2, m_policy.tier());
+}
+
+TEST_F(KeylockQualityPolicyTest, StepsDownUnderPressureAndRecovers) {
+    runFor(0.6, 0.95, CSAMPLE_GAIN_ONE);
+    EXPECT_EQ(1, m_policy.tier());
+    runFor(0.6, 0.95, CSAMPLE_GAIN_ONE);
+    EXPECT_EQ(0, m_policy.tier());
+    // Never below the cheapest tier
+    runFor(2.0, 0.95, CSAMPLE_GAIN_ONE);
+    EXPECT_EQ(0, m_policy.tier());
+
+    // Stepping up is delayed
+    runFor(1.0, 0.1, CSAMPLE_GAIN_ONE);
+    EXPECT_EQ(0, m_policy.tier());
+    runFor(10.0, 0.1, CSAMPLE_GAIN_ONE);
+    EXPECT_EQ(2, m_policy.tier());
+}
+
+TEST_F(KeylockQualityPolicyTest, SilentDecksStepDownFirst) {
+    KeylockQualityPolicy onAirPolicy;
+    onAirPolicy.setMaxTier(2);
+    const double load = 0.7;
+    for (int i = 0; i < 100; ++i) {
+        onAirPolicy.update(load, CSAMPLE_GAIN_ONE, kFrames, kSampleRate);
+        m_policy.update(load, CSAMPLE_GAIN_ZERO, kFrames, kSampleRate);
+    }
+    EXPECT_EQ(2, onAirPolicy.tier());
+    EXPECT_LT(m_policy.tier(), 2);
+}
+
+TEST_F(KeylockQualityPolicyTest, HysteresisPreventsFlipFlop) {
+    runFor(0.6, 0.95, CSAMPLE_GAIN_ONE);
+    EXPECT_EQ(1, m_policy.tier());
+    // Load between the step up and the step down threshold
+    EXPECT_EQ(0, runFor(20.0, 0.7, CSAMPLE_GAIN_ONE));
+    EXPECT_EQ(1, m_policy.tier());
+}
+
+TEST_F(KeylockQualityPolicyTest, SetMaxTierResets) {
+    runFor(0.6, 0.95, CSAMPLE_GAIN_ONE);
+    EXPECT_EQ(1, m_policy.tier());
+    m_policy.setMaxTier(0);
+    EXPECT_EQ(0, m_policy.tier());
+    EXPECT_EQ(0, runFor(10.0, 0.1, CSAMPLE_GAIN_ONE));
+}
+
+} // namespace
@@ -233,3 +233,30 @@ TEST_F(KeyUtilsTest, GetCompatibleKeys) {
                     mixxx::track::io::key::A_MINOR,
                     mixxx::track::io::key::G_MINOR));
 }
+
+TEST_F(KeyUtilsTest, CircleOfFifthsDistance) {
+    EXPECT_EQ(0,
+            KeyUtils::circleOfFifthsDistance(mixxx::track::io::key::A_MINOR,
+                    mixxx::track::io::key::A_MINOR));
+    // Relative major
+    EXPECT_EQ(1,
+            KeyUtils::circleOfFifthsDistance(mixxx::track::io::key::A_MINOR,
+                    mixxx::track::io::key::C_MAJOR));
+    // Wrap-around between 12 and 1
+    EXPECT_EQ(1,
+            KeyUtils::circleOfFifthsDistance(mixxx::track::io::key::C_MAJOR,
+                    mixxx::track::io::key::F_MAJOR));
+    EXPECT_EQ(2,
+            KeyUtils::circleOfFifthsDistance(mixxx::track::io::key::C_MAJOR,
+                    mixxx::track::io::key::D_MINOR));
+    // Opposite side of the circle
+    EXPECT_EQ(6,
+            KeyUtils::circleOfFifthsDistance(mixxx::track::io::key::C_MAJOR,
+                    mixxx::track::io::key::F_SHARP_MAJOR));
+    EXPECT_EQ(7,
+            KeyUtils::circleOfFifthsDistance(mixxx::track::io::key::C_MAJOR,
+                    mixxx::track::io::key::E_FLAT_MINOR));
+    EXPECT_EQ(-1,
+            KeyUtils::circleOfFifthsDistance(mixxx::track::io::key::C_MAJOR,
+                    mixxx::track::io::key::INVALID));
+}
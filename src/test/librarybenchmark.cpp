@@ -0,0 +1,130 @@
+#include "test/librarybenchmark.h"
+
+#include <QFile>
+#include <QSqlQuery>
+
+#include "control/control.h"
+#include "library/library_prefs.h"
+#include "library/queryutil.h"
+#include "sources/soundsourceproxy.h"
+#include "test/mixxxtest.h"
+#include "track/track.h"
+#include "util/db/dbconnectionpooled.h"
+
+namespace {
+
+const bool kInMemoryDbConnection = true;
+
+void deleteTrack(Track* pTrack) {
+    // Delete track objects directly in benchmarks with
+    // no main event loop
+    delete pTrack;
+};
+
+} // namespace
+
+void LibraryBenchmark::SetUp(benchmark::State& state) {
+    Q_UNUSED(state);
+    // Same as SoundSourceProviderRegistration, but only after the
+    // application has been created
+    if (!SoundSourceProxy::isFileSuffixSupported("wav")) {
+        const bool providersRegistered = SoundSourceProxy::registerProviders();
+        Q_UNUSED(providersRegistered);
+        DEBUG_ASSERT(providersRegistered);
+    }
+
+    m_pTestDataDir = std::make_unique<QTemporaryDir>();
+    DEBUG_ASSERT(m_pTestDataDir->isValid());
+    const QString configFilePath = getTestDataDir().filePath("test.cfg");
+    QFile configFile(configFilePath);
+    configFile.open(QIODevice::ReadWrite);
+    configFile.close();
+    m_pConfig = UserSettingsPointer(new UserSettings(configFilePath));
+    ControlDoublePrivate::setUserConfig(m_pConfig);
+
+    m_pMixxxDb = std::make_unique<MixxxDb>(m_pConfig, kInMemoryDbConnection);
+    m_dbConnectionPooler = mixxx::DbConnectionPooler(m_pMixxxDb->connectionPool());
+    if (!MixxxDb::initDatabaseSchema(dbConnection())) {
+        state.SkipWithError("Failed to initialize the database schema");
+        return;
+    }
+    m_pTrackCollectionManager = std::make_unique<TrackCollectionManager>(
+            nullptr,
+            m_pConfig,
+            dbConnectionPooler(),
+            deleteTrack);
+    if (m_createKeyNotationControl) {
+        m_pKeyNotationCO = std::make_unique<ControlObject>(
+                mixxx::library::prefs::kKeyNotationConfigKey);
+    }
+}
+
+void LibraryBenchmark::TearDown(benchmark::State& state) {
+    Q_UNUSED(state);
+    m_pKeyNotationCO.reset();
+    m_pTrackCollectionManager.reset();
+    m_dbConnectionPooler = mixxx::DbConnectionPooler();
+    m_pMixxxDb.reset();
+    // Like MixxxTest, delete all controls that have been leaked
+    // by the benchmark
+    const auto controls = ControlDoublePrivate::takeAllInstances();
+    for (auto pControl : controls) {
+        pControl->deleteCreatorCO();
+    }
+    m_pConfig.reset();
+    m_pTestDataDir.reset();
+}
+
+QSqlDatabase LibraryBenchmark::dbConnection() const {
+    return mixxx::DbConnectionPooled(m_dbConnectionPooler);
+}
+
+TrackPointer LibraryBenchmark::getOrAddTrackByLocation(
+        const QString& trackLocation) const {
+    return m_pTrackCollectionManager->getOrAddTrack(
+            TrackRef::fromFilePath(trackLocation));
+}
+
+bool LibraryBenchmark::addSyntheticTracks(int trackCount) const {
+    const QSqlDatabase database = dbConnection();
+    ScopedTransaction transaction(database);
+    QSqlQuery insertLocation(database);
+    insertLocation.prepare(QStringLiteral(
+            "INSERT INTO track_locations "
+            "(id,location,filename,directory,filesize,fs_deleted,needs_verification) "
+            "VALUES (:id,:location,:filename,'/Music',1000000,0,0)"));
+    // The header has been parsed, so loading the tracks doesn't try
+    // to import the metadata from the missing files
+    QSqlQuery insertTrack(database);
+    insertTrack.prepare(QStringLiteral(
+            "INSERT INTO library "
+            "(id,artist,title,album,album_artist,genre,year,location,duration,"
+            "mixxx_deleted,header_parsed) "
+            "VALUES (:id,:artist,:title,:album,:artist,:genre,:year,:location,180,0,1)"));
+    for (int i = 1; i <= trackCount; ++i) {
+        const QString filename = QStringLiteral("%1.mp3").arg(i);
+        insertLocation.bindValue(":id", i);
+        insertLocation.bindValue(":location", QStringLiteral("/Music/") + filename);
+        insertLocation.bindValue(":filename", filename);
+        if (!insertLocation.exec()) {
+            LOG_FAILED_QUERY(insertLocation);
+            return false;
+        }
+        insertTrack.bindValue(":id", i);
+        insertTrack.bindValue(":artist", QStringLiteral("Artist %1").arg(i % 1000));
+        insertTrack.bindValue(":title", QStringLiteral("Title %1").arg(i));
+        insertTrack.bindValue(":album", QStringLiteral("Album %1").arg(i % 10000));
+        insertTrack.bindValue(":genre", QStringLiteral("Genre %1").arg(i % 50));
+        insertTrack.bindValue(":year", QString::number(1970 + i % 50));
+        insertTrack.bindValue(":location", i);
+        if (!insertTrack.exec()) {
+            LOG_FAILED_QUERY(insertTrack);
+            return false;
+        }
+    }
+    return transaction.commit();
+}
+
+QDir LibraryBenchmark::getTestDir() const {
+    return MixxxTest::getOrInitTestDir(m_pConfig->getResourcePath());
+}
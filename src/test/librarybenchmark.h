@@ -0,0 +1,79 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <QDir>
+#include <QSqlDatabase>
+#include <QTemporaryDir>
+#include <memory>
+
+#include "control/controlobject.h"
+#include "database/mixxxdb.h"
+#include "library/trackcollectionmanager.h"
+#include "preferences/usersettings.h"
+#include "util/db/dbconnectionpooler.h"
+
+/// A benchmark fixture with the same library as LibraryTest: an in-memory
+/// database with the current schema and a TrackCollectionManager.
+///
+/// Unlike the test fixtures, the library is only set up when a benchmark is
+/// run, after the application has been created, and not when the benchmark
+/// is registered.
+class LibraryBenchmark : public benchmark::Fixture {
+  public:
+    using benchmark::Fixture::SetUp;
+    using benchmark::Fixture::TearDown;
+
+    void SetUp(benchmark::State& state) override;
+    void TearDown(benchmark::State& state) override;
+
+  protected:
+    /// Fixtures that create a Library must not create the key notation
+    /// control, the Library creates it.
+    explicit LibraryBenchmark(bool createKeyNotationControl = true)
+            : m_createKeyNotationControl(createKeyNotationControl) {
+    }
+
+    UserSettingsPointer config() const {
+        return m_pConfig;
+    }
+
+    const mixxx::DbConnectionPoolPtr& dbConnectionPooler() const {
+        return m_dbConnectionPooler;
+    }
+
+    QSqlDatabase dbConnection() const;
+
+    TrackCollectionManager* trackCollectionManager() const {
+        return m_pTrackCollectionManager.get();
+    }
+
+    TrackCollection* internalCollection() const {
+        return trackCollectionManager()->internalCollection();
+    }
+
+    TrackPointer getOrAddTrackByLocation(
+            const QString& trackLocation) const;
+
+    /// Inserts the rows of tracks without files directly into the database,
+    /// since adding large libraries track by track would take too long.
+    /// The tracks share 1000 artists, 10000 albums, 50 genres and 50 years.
+    bool addSyntheticTracks(int trackCount) const;
+
+    /// The directory with the test files, e.g. id3-test-data
+    QDir getTestDir() const;
+
+    /// A temporary directory that is deleted after the benchmark
+    QDir getTestDataDir() const {
+        return m_pTestDataDir->path();
+    }
+
+  private:
+    const bool m_createKeyNotationControl;
+    std::unique_ptr<QTemporaryDir> m_pTestDataDir;
+    UserSettingsPointer m_pConfig;
+    std::unique_ptr<MixxxDb> m_pMixxxDb;
+    mixxx::DbConnectionPooler m_dbConnectionPooler;
+    std::unique_ptr<TrackCollectionManager> m_pTrackCollectionManager;
+    std::unique_ptr<ControlObject> m_pKeyNotationCO;
+};
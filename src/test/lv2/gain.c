@@ -0,0 +1,85 @@
+// A trivial stereo gain plugin that is used for testing and benchmarking
+// the LV2 effects backend without depending on installed plugins.
+
+#include <lv2/core/lv2.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define GAIN_URI "https://mixxx.org/test/lv2/gain"
+
+enum {
+    GAIN_GAIN = 0,
+    GAIN_INPUT_LEFT = 1,
+    GAIN_INPUT_RIGHT = 2,
+    GAIN_OUTPUT_LEFT = 3,
+    GAIN_OUTPUT_RIGHT = 4,
+};
+
+typedef struct {
+    const float* gain;
+    const float* input[2];
+    float* output[2];
+} Gain;
+
+static LV2_Handle instantiate(const LV2_Descriptor* descriptor,
+        double rate,
+        const char* bundlePath,
+        const LV2_Feature* const* features) {
+    (void)descriptor;
+    (void)rate;
+    (void)bundlePath;
+    (void)features;
+    return (LV2_Handle)calloc(1, sizeof(Gain));
+}
+
+static void connectPort(LV2_Handle instance, uint32_t port, void* data) {
+    Gain* gain = (Gain*)instance;
+    switch (port) {
+    case GAIN_GAIN:
+        gain->gain = (const float*)data;
+        break;
+    case GAIN_INPUT_LEFT:
+        gain->input[0] = (const float*)data;
+        break;
+    case GAIN_INPUT_RIGHT:
+        gain->input[1] = (const float*)data;
+        break;
+    case GAIN_OUTPUT_LEFT:
+        gain->output[0] = (float*)data;
+        break;
+    case GAIN_OUTPUT_RIGHT:
+        gain->output[1] = (float*)data;
+        break;
+    }
+}
+
+static void run(LV2_Handle instance, uint32_t sampleCount) {
+    const Gain* gain = (const Gain*)instance;
+    const float factor = *gain->gain;
+    for (int channel = 0; channel < 2; ++channel) {
+        const float* input = gain->input[channel];
+        float* output = gain->output[channel];
+        for (uint32_t i = 0; i < sampleCount; ++i) {
+            output[i] = input[i] * factor;
+        }
+    }
+}
+
+static void cleanup(LV2_Handle instance) {
+    free(instance);
+}
+
+static const LV2_Descriptor kDescriptor = {
+        GAIN_URI,
+        instantiate,
+        connectPort,
+        NULL,
+        run,
+        NULL,
+        cleanup,
+        NULL,
+};
+
+LV2_SYMBOL_EXPORT const LV2_Descriptor* lv2_descriptor(uint32_t index) {
+    return index == 0 ? &kDescriptor : NULL;
+}
@@ -0,0 +1,147 @@
+#include "effects/backends/lv2/lv2effectprocessor.h"
+
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QList>
+#include <QMap>
+#include <memory>
+
+#include "effects/backends/lv2/lv2backend.h"
+#include "engine/effects/engineeffectparameter.h"
+#include "util/samplebuffer.h"
+
+namespace {
+
+// The plugin bundle is built together with the tests, see CMakeLists.txt
+const QString kGainPluginId = QStringLiteral("https://mixxx.org/test/lv2/gain");
+
+constexpr SINT kFramesPerBuffer = 1024;
+
+/// Processes the inputs of multiple channels with the gain plugin
+/// for the main output, like EngineEffect does.
+class GainPlugin {
+  public:
+    explicit GainPlugin(int inputChannelCount)
+            : m_engineParameters(mixxx::audio::SampleRate(44100), kFramesPerBuffer),
+              m_input(m_engineParameters.samplesPerBuffer()),
+              m_output(m_engineParameters.samplesPerBuffer()) {
+        qputenv("LV2_PATH", MIXXX_TEST_LV2_PATH);
+        m_pBackend = std::make_unique<LV2Backend>();
+        if (!m_pBackend->canInstantiateEffect(kGainPluginId)) {
+            return;
+        }
+        const EffectManifestPointer pManifest = m_pBackend->getManifest(kGainPluginId);
+        m_pProcessor = m_pBackend->createProcessor(pManifest);
+
+        QMap<QString, EngineEffectParameterPointer> parameters;
+        const auto& manifestParameters = pManifest->parameters();
+        for (int i = 0; i < manifestParameters.size(); ++i) {
+            const auto& pManifestParameter = manifestParameters.at(i);
+            parameters.insert(pManifestParameter->id(),
+                    EngineEffectParameterPointer(
+                            new EngineEffectParameter(pManifestParameter)));
+            if (pManifestParameter->id() == QStringLiteral("gain")) {
+                m_gainIndex = i;
+            }
+        }
+        m_pGain = parameters.value(QStringLiteral("gain"));
+        m_pProcessor->loadEngineEffectParameters(parameters);
+
+        QSet<ChannelHandleAndGroup> inputChannels;
+        for (int i = 1; i <= inputChannelCount; ++i) {
+            const QString group = QStringLiteral("[Channel%1]").arg(i);
+            const auto inputChannel = ChannelHandleAndGroup(
+                    m_channelHandleFactory.getOrCreateHandle(group), group);
+            inputChannels.insert(inputChannel);
+            m_inputChannels.append(inputChannel.handle());
+        }
+        const QString outputGroup = QStringLiteral("[Master]");
+        m_outputChannel = m_channelHandleFactory.getOrCreateHandle(outputGroup);
+        m_pProcessor->initialize(inputChannels,
+                {ChannelHandleAndGroup(m_outputChannel, outputGroup)},
+                m_engineParameters);
+
+        for (SINT i = 0; i < m_input.size(); ++i) {
+            m_input[i] = static_cast<CSAMPLE>(i % 100) / 100;
+        }
+    }
+
+    bool isValid() const {
+        return m_pProcessor && m_pGain;
+    }
+
+    /// Changes the parameter like EngineEffect does for a
+    /// SET_PARAMETER_PARAMETERS request
+    void setGain(double gain) {
+        m_pGain->setValue(gain);
+        m_pProcessor->parameterChanged(m_gainIndex);
+    }
+
+    void process(EffectEnableState enableState) {
+        for (const auto& inputChannel : std::as_const(m_inputChannels)) {
+            m_pProcessor->process(inputChannel,
+                    m_outputChannel,
+                    m_input.data(),
+                    m_output.data(),
+                    m_engineParameters,
+                    enableState,
+                    GroupFeatureState());
+        }
+    }
+
+    const mixxx::SampleBuffer& input() const {
+        return m_input;
+    }
+
+    const mixxx::SampleBuffer& output() const {
+        return m_output;
+    }
+
+  private:
+    const mixxx::EngineParameters m_engineParameters;
+    std::unique_ptr<LV2Backend> m_pBackend;
+    std::unique_ptr<EffectProcessor> m_pProcessor;
+    EngineEffectParameterPointer m_pGain;
+    int m_gainIndex = -1;
+    ChannelHandleFactory m_channelHandleFactory;
+    QList<ChannelHandle> m_inputChannels;
+    ChannelHandle m_outputChannel;
+    mixxx::SampleBuffer m_input;
+    mixxx::SampleBuffer m_output;
+};
+
+TEST(LV2EffectProcessorTest, ProcessInPlace) {
+    GainPlugin plugin(2);
+    ASSERT_TRUE(plugin.isValid());
+
+    plugin.setGain(0.5);
+    plugin.process(EffectEnableState::Enabling);
+    for (SINT i = 0; i < plugin.output().size(); ++i) {
+        ASSERT_FLOAT_EQ(plugin.input()[i] * 0.5f, plugin.output()[i]);
+    }
+
+    // Changed values are passed to the plugin
+    plugin.setGain(2.0);
+    plugin.process(EffectEnableState::Enabled);
+    for (SINT i = 0; i < plugin.output().size(); ++i) {
+        ASSERT_FLOAT_EQ(plugin.input()[i] * 2.0f, plugin.output()[i]);
+    }
+}
+
+} // namespace
+
+static void BM_LV2GainEightChannels(benchmark::State& state) {
+    GainPlugin plugin(8);
+    if (!plugin.isValid()) {
+        state.SkipWithError("Test plugin is not available");
+        return;
+    }
+    plugin.process(EffectEnableState::Enabling);
+    for (auto _ : state) {
+        plugin.process(EffectEnableState::Enabled);
+        benchmark::DoNotOptimize(plugin.output().data());
+    }
+    state.SetItemsProcessed(state.iterations() * 8 * kFramesPerBuffer);
+}
+BENCHMARK(BM_LV2GainEightChannels);
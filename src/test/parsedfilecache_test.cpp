@@ -0,0 +1,98 @@
+#include "util/parsedfilecache.h"
+
+#include <gtest/gtest.h>
+
+#include <QDateTime>
+#include <QFile>
+#include <QTemporaryDir>
+
+namespace {
+
+constexpr quint32 kVersion = 1;
+
+class ParsedFileCacheTest : public testing::Test {
+  protected:
+    ParsedFileCacheTest()
+            : m_cacheFilePath(m_tempDir.filePath(QStringLiteral("test.cache"))),
+              m_sourceFilePath(m_tempDir.filePath(QStringLiteral("source.xml"))) {
+        writeSource("<preset/>");
+    }
+
+    void writeSource(const QByteArray& content) {
+        QFile file(m_sourceFilePath);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        ASSERT_EQ(content.size(), file.write(content));
+    }
+
+    void setLastModified(const QDateTime& lastModified) {
+        QFile file(m_sourceFilePath);
+        ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+        ASSERT_TRUE(file.setFileTime(lastModified, QFileDevice::FileModificationTime));
+    }
+
+    QTemporaryDir m_tempDir;
+    const QString m_cacheFilePath;
+    const QString m_sourceFilePath;
+};
+
+TEST_F(ParsedFileCacheTest, RoundTrip) {
+    const QStringList value = {QStringLiteral("a"), QStringLiteral("b")};
+    {
+        mixxx::ParsedFileCache cache(m_cacheFilePath, kVersion);
+        EXPECT_FALSE(cache.value(m_sourceFilePath));
+        cache.insertValue(m_sourceFilePath, value);
+        ASSERT_TRUE(cache.save());
+    }
+    mixxx::ParsedFileCache cache(m_cacheFilePath, kVersion);
+    EXPECT_EQ(QStringList{m_sourceFilePath}, cache.sourceFilePaths());
+    QStringList cachedValue;
+    ASSERT_TRUE(cache.readValue(m_sourceFilePath, &cachedValue));
+    EXPECT_EQ(value, cachedValue);
+}
+
+TEST_F(ParsedFileCacheTest, ModifiedSourceInvalidatesEntry) {
+    setLastModified(QDateTime::currentDateTime().addSecs(-60));
+    {
+        mixxx::ParsedFileCache cache(m_cacheFilePath, kVersion);
+        cache.insert(m_sourceFilePath, QByteArray("parsed"));
+        ASSERT_TRUE(cache.save());
+    }
+    {
+        mixxx::ParsedFileCache cache(m_cacheFilePath, kVersion);
+        EXPECT_EQ(QByteArray("parsed"), cache.value(m_sourceFilePath));
+    }
+    // Same size, but a different modification time
+    writeSource("<other/>");
+    setLastModified(QDateTime::currentDateTime());
+    mixxx::ParsedFileCache cache(m_cacheFilePath, kVersion);
+    EXPECT_FALSE(cache.value(m_sourceFilePath));
+}
+
+TEST_F(ParsedFileCacheTest, RemovedSourceIsDropped) {
+    {
+        mixxx::ParsedFileCache cache(m_cacheFilePath, kVersion);
+        cache.insert(m_sourceFilePath, QByteArray("parsed"));
+        ASSERT_TRUE(cache.save());
+    }
+    ASSERT_TRUE(QFile::remove(m_sourceFilePath));
+    {
+        mixxx::ParsedFileCache cache(m_cacheFilePath, kVersion);
+        EXPECT_FALSE(cache.value(m_sourceFilePath));
+        ASSERT_TRUE(cache.save());
+    }
+    mixxx::ParsedFileCache cache(m_cacheFilePath, kVersion);
+    EXPECT_TRUE(cache.sourceFilePaths().isEmpty());
+}
+
+TEST_F(ParsedFileCacheTest, VersionMismatchDiscardsCache) {
+    {
+        mixxx::ParsedFileCache cache(m_cacheFilePath, kVersion);
+        cache.insert(m_sourceFilePath, QByteArray("parsed"));
+        ASSERT_TRUE(cache.save());
+    }
+    mixxx::ParsedFileCache cache(m_cacheFilePath, kVersion + 1);
+    EXPECT_TRUE(cache.sourceFilePaths().isEmpty());
+    EXPECT_FALSE(cache.value(m_sourceFilePath));
+}
+
+} // namespace
@@ -0,0 +1,164 @@
+#include "effects/backends/builtin/partitionedconvolver.h"
+
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "effects/backends/builtin/convolutionreverbeffect.h"
+#include "util/math.h"
+#include "util/samplebuffer.h"
+
+namespace {
+
+constexpr int kStereo = 2;
+
+std::vector<float> randomSignal(std::size_t length, unsigned int seed) {
+    std::minstd_rand generator(seed);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    std::vector<float> signal(length);
+    for (auto& value : signal) {
+        value = distribution(generator);
+    }
+    return signal;
+}
+
+class PartitionedConvolverTest : public testing::Test {
+  protected:
+    /// Convolves the left channel of a stereo buffer, processed in
+    /// chunks of varying size, and compares it to a direct convolution.
+    /// A worker gets the time to process the tail after each chunk, like
+    /// between the callbacks of the audio thread.
+    void assertConvolution(SINT blockFrames,
+            std::shared_ptr<mixxx::ConvolutionTailWorker> pWorker) {
+        const std::vector<float> impulseResponse = randomSignal(9000, 1);
+        const std::vector<float> input = randomSignal(40000, 2);
+        const auto pKernel = std::make_shared<const mixxx::ConvolutionKernel>(
+                impulseResponse, blockFrames);
+        ASSERT_NE(nullptr, pKernel->tail());
+        mixxx::PartitionedConvolver convolver(pKernel, pWorker);
+
+        const auto frameCount = static_cast<SINT>(input.size());
+        mixxx::SampleBuffer buffer(frameCount * kStereo);
+        for (SINT i = 0; i < frameCount; ++i) {
+            buffer[i * kStereo] = input[i];
+            buffer[i * kStereo + 1] = 1.0f;
+        }
+        const SINT chunks[] = {blockFrames, 37, blockFrames - 37, 3 * blockFrames, 1};
+        SINT frame = 0;
+        for (int chunk = 0; frame < frameCount; ++chunk) {
+            const SINT frames = math_min(chunks[chunk % 5], frameCount - frame);
+            convolver.process(&buffer[frame * kStereo],
+                    &buffer[frame * kStereo],
+                    frames,
+                    kStereo);
+            frame += frames;
+            while (pWorker && convolver.hasPendingTailJobs()) {
+                QThread::yieldCurrentThread();
+            }
+        }
+
+        // The output is delayed by one block
+        for (SINT i = 0; i < frameCount; ++i) {
+            double expected = 0;
+            for (SINT j = 0; j < static_cast<SINT>(impulseResponse.size()) &&
+                    j <= i - blockFrames;
+                    ++j) {
+                expected += impulseResponse[j] * input[i - blockFrames - j];
+            }
+            ASSERT_NEAR(expected, buffer[i * kStereo], 1e-4) << "frame " << i;
+            // The other channel is untouched
+            ASSERT_EQ(1.0f, buffer[i * kStereo + 1]);
+        }
+    }
+};
+
+TEST_F(PartitionedConvolverTest, MatchesDirectConvolution) {
+    assertConvolution(64, nullptr);
+    assertConvolution(100, nullptr);
+    assertConvolution(512, nullptr);
+}
+
+TEST_F(PartitionedConvolverTest, MatchesDirectConvolutionWithWorker) {
+    auto pWorker = std::make_shared<mixxx::ConvolutionTailWorker>();
+    pWorker->start();
+    assertConvolution(64, pWorker);
+    assertConvolution(512, pWorker);
+}
+
+TEST_F(PartitionedConvolverTest, MatchesDirectConvolutionWithStalledWorker) {
+    // The audio thread processes the tail jobs that the worker has not
+    // started in time, the output is the same.
+    auto pWorker = std::make_shared<mixxx::ConvolutionTailWorker>();
+    assertConvolution(64, pWorker);
+}
+
+TEST_F(PartitionedConvolverTest, ClearSilencesTail) {
+    const auto pKernel = std::make_shared<const mixxx::ConvolutionKernel>(
+            randomSignal(20000, 3), 128);
+    auto pWorker = std::make_shared<mixxx::ConvolutionTailWorker>();
+    pWorker->start();
+    for (const auto& pConvolverWorker :
+            {std::shared_ptr<mixxx::ConvolutionTailWorker>(), pWorker}) {
+        mixxx::PartitionedConvolver convolver(pKernel, pConvolverWorker);
+        mixxx::SampleBuffer buffer(128);
+        for (int i = 0; i < 100; ++i) {
+            buffer.fill(1.0f);
+            convolver.process(buffer.data(), buffer.data(), buffer.size(), 1);
+        }
+        // The worker may still be busy with the tail, clearing doesn't wait
+        convolver.clear();
+        for (int i = 0; i < 200; ++i) {
+            buffer.fill(0.0f);
+            convolver.process(buffer.data(), buffer.data(), buffer.size(), 1);
+            for (SINT j = 0; j < buffer.size(); ++j) {
+                ASSERT_EQ(0.0f, buffer[j]);
+            }
+        }
+    }
+}
+
+TEST_F(PartitionedConvolverTest, ImpulseResponseIsDecorrelated) {
+    const auto sampleRate = mixxx::audio::SampleRate(44100);
+    const std::vector<float> left = ConvolutionReverbEffect::createImpulseResponse(
+            sampleRate, 0);
+    const std::vector<float> right = ConvolutionReverbEffect::createImpulseResponse(
+            sampleRate, 1);
+    ASSERT_EQ(left.size(), right.size());
+    EXPECT_EQ(static_cast<std::size_t>(2 * sampleRate), left.size());
+    EXPECT_NE(left, right);
+    // Deterministic, so the kernels can be shared
+    EXPECT_EQ(left, ConvolutionReverbEffect::createImpulseResponse(sampleRate, 0));
+}
+
+} // namespace
+
+// Measures the processing time of one stereo channel pair
+// for the impulse response length in seconds and the buffer size.
+static void BM_PartitionedConvolver(benchmark::State& state) {
+    const auto sampleRate = mixxx::audio::SampleRate(44100);
+    const auto blockFrames = static_cast<SINT>(state.range(1));
+    const std::vector<float> impulseResponse =
+            randomSignal(static_cast<std::size_t>(state.range(0) * sampleRate), 4);
+    const auto pKernel = std::make_shared<const mixxx::ConvolutionKernel>(
+            impulseResponse, blockFrames);
+    std::shared_ptr<mixxx::ConvolutionTailWorker> pWorker;
+    if (state.range(2)) {
+        pWorker = std::make_shared<mixxx::ConvolutionTailWorker>();
+        pWorker->start(QThread::HighPriority);
+    }
+    mixxx::PartitionedConvolver left(pKernel, pWorker);
+    mixxx::PartitionedConvolver right(pKernel, pWorker);
+
+    const std::vector<float> input = randomSignal(blockFrames * kStereo, 5);
+    mixxx::SampleBuffer output(blockFrames * kStereo);
+    for (auto _ : state) {
+        left.process(input.data(), output.data(), blockFrames, kStereo);
+        right.process(input.data() + 1, output.data() + 1, blockFrames, kStereo);
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.iterations() * blockFrames);
+}
+// IR seconds, frames per buffer, tail on the worker thread
+BENCHMARK(BM_PartitionedConvolver)
+        ->ArgsProduct({{2, 6}, {64, 256, 1024}, {0, 1}});
@@ -0,0 +1,262 @@
+#include "engine/bufferscalers/scaledloopcache.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "engine/bufferscalers/enginebufferscalerubberband.h"
+#include "engine/bufferscalers/enginebufferscalest.h"
+#include "engine/engine.h"
+#include "engine/readaheadmanager.h"
+#include "test/mixxxtest.h"
+#include "util/math.h"
+
+namespace {
+
+constexpr SINT kChannels = mixxx::kEngineChannelCount;
+constexpr SINT kFrames = 256;
+constexpr SINT kCapacityFrames = 1 << 14;
+constexpr double kLoopLength = 4410;
+constexpr double kLoopCycles = 3;
+
+const auto kLoopStart = mixxx::audio::FramePos(1000);
+const auto kLoopEnd = kLoopStart + kLoopLength;
+
+class ScaledLoopCacheTest : public testing::Test {
+  protected:
+    ScaledLoopCacheTest()
+            : m_cache(kCapacityFrames),
+              m_parameters{1.0, 1.1, 1.0, kLoopStart, kLoopEnd},
+              m_buffer(kFrames * kChannels),
+              m_position(kLoopStart + 123.0) {
+    }
+
+    // A stand-in for the time stretching scaler: the output only depends on
+    // the position in the loop, so the live output is periodic.
+    static CSAMPLE liveSample(mixxx::audio::FramePos position, SINT channel) {
+        const double loopPhase = (position - kLoopStart) / kLoopLength;
+        return static_cast<CSAMPLE>(
+                std::sin(2 * M_PI * kLoopCycles * loopPhase + channel));
+    }
+
+    mixxx::audio::FramePos advance(mixxx::audio::FramePos position, SINT frames) const {
+        return kLoopStart +
+                std::fmod(position - kLoopStart + frames * m_parameters.rate(),
+                        kLoopLength);
+    }
+
+    // Renders one live buffer and returns the position after it
+    mixxx::audio::FramePos renderLive(CSAMPLE* pOutput,
+            mixxx::audio::FramePos position) const {
+        for (SINT i = 0; i < kFrames; ++i) {
+            const auto framePosition = advance(position, i);
+            for (SINT channel = 0; channel < kChannels; ++channel) {
+                pOutput[i * kChannels + channel] = liveSample(framePosition, channel);
+            }
+        }
+        return advance(position, kFrames);
+    }
+
+    void recordLive() {
+        const auto positionBefore = m_position;
+        m_position = renderLive(m_buffer.data(), m_position);
+        m_cache.record(m_parameters, m_buffer.data(), kFrames, positionBefore, m_position);
+    }
+
+    void recordUntilComplete() {
+        for (int i = 0; i < 100 && !m_cache.isCompleteFor(m_parameters); ++i) {
+            recordLive();
+        }
+        ASSERT_TRUE(m_cache.isCompleteFor(m_parameters));
+    }
+
+    ScaledLoopCache m_cache;
+    ScaledLoopCache::Parameters m_parameters;
+    std::vector<CSAMPLE> m_buffer;
+    mixxx::audio::FramePos m_position;
+};
+
+TEST_F(ScaledLoopCacheTest, CompleteAfterOnePass) {
+    const double passFrames = kLoopLength / m_parameters.rate();
+    SINT recordedFrames = 0;
+    bool wrapped = false;
+    while (!m_cache.isCompleteFor(m_parameters)) {
+        const auto positionBefore = m_position;
+        recordLive();
+        if (wrapped) {
+            recordedFrames += kFrames;
+        }
+        wrapped = wrapped || m_position < positionBefore;
+        ASSERT_LT(recordedFrames, passFrames + ScaledLoopCache::kSeamFrames + 1 + kFrames);
+    }
+    // Recording starts after the first wrap around
+    EXPECT_TRUE(wrapped);
+    EXPECT_GE(recordedFrames, passFrames + ScaledLoopCache::kSeamFrames);
+}
+
+TEST_F(ScaledLoopCacheTest, CachedMatchesLive) {
+    recordUntilComplete();
+
+    std::vector<CSAMPLE> live(kFrames * kChannels);
+    auto livePosition = m_position;
+    auto cachedPosition = m_position;
+    // Several passes, so the cache wraps around multiple times
+    for (int i = 0; i < 100; ++i) {
+        livePosition = renderLive(live.data(), livePosition);
+        cachedPosition = m_cache.play(m_buffer.data(), kFrames, cachedPosition);
+        ASSERT_NEAR(livePosition.value(), cachedPosition.value(), 1e-6);
+        for (SINT j = 0; j < kFrames * kChannels; ++j) {
+            // The fractional offset between the live and the recorded
+            // frames is interpolated
+            ASSERT_NEAR(live[j], m_buffer[j], 1e-4) << "buffer " << i << " sample " << j;
+        }
+    }
+}
+
+TEST_F(ScaledLoopCacheTest, ParameterChangeRestartsRecording) {
+    recordUntilComplete();
+
+    auto changedParameters = m_parameters;
+    changedParameters.pitchRatio = 1.2;
+    EXPECT_FALSE(m_cache.isCompleteFor(changedParameters));
+
+    m_parameters = changedParameters;
+    recordLive();
+    EXPECT_FALSE(m_cache.isCompleteFor(m_parameters));
+    recordUntilComplete();
+}
+
+TEST_F(ScaledLoopCacheTest, Invalidate) {
+    recordUntilComplete();
+    m_cache.invalidate();
+    EXPECT_FALSE(m_cache.isCompleteFor(m_parameters));
+}
+
+TEST_F(ScaledLoopCacheTest, CanCache) {
+    EXPECT_TRUE(m_cache.canCache(m_parameters));
+
+    auto reverse = m_parameters;
+    reverse.tempoRatio = -1.0;
+    EXPECT_FALSE(m_cache.canCache(reverse));
+
+    auto tooLong = m_parameters;
+    tooLong.loopEndPosition = kLoopStart + 2.0 * kCapacityFrames;
+    EXPECT_FALSE(m_cache.canCache(tooLong));
+
+    auto noLoop = m_parameters;
+    noLoop.loopEndPosition = mixxx::audio::kInvalidFramePos;
+    EXPECT_FALSE(m_cache.canCache(noLoop));
+}
+
+// Feeds the scaler with a loop of a sine, which contains an integer number
+// of cycles, so the input is continuous at the loop boundaries.
+class LoopReadAheadManager : public ReadAheadManager {
+  public:
+    LoopReadAheadManager()
+            : m_readFrames(0) {
+    }
+
+    SINT getNextSamples(double dRate, CSAMPLE* buffer, SINT requested_samples) override {
+        Q_UNUSED(dRate);
+        const SINT frames = requested_samples / kChannels;
+        const auto loopFrames = static_cast<SINT>(kLoopLength);
+        for (SINT i = 0; i < frames; ++i) {
+            const double loopPhase = static_cast<double>(m_readFrames % loopFrames) / loopFrames;
+            const auto sample = static_cast<CSAMPLE>(
+                    0.5 * std::sin(2 * M_PI * kCyclesPerLoop * loopPhase));
+            for (SINT channel = 0; channel < kChannels; ++channel) {
+                buffer[i * kChannels + channel] = sample;
+            }
+            ++m_readFrames;
+        }
+        return frames * kChannels;
+    }
+
+    // 110 Hz at 44100 Hz. The tempo of 1.1 keeps the pitch, so each pass of
+    // the scaled output contains 10 cycles as well, and the live output is
+    // periodic in the position like the cached output.
+    static constexpr int kCyclesPerLoop = 11;
+
+  private:
+    SINT m_readFrames;
+};
+
+class ScaledLoopCacheScalerTest : public MixxxTest {
+  protected:
+    void SetUp() override {
+        m_pReadAheadManager = std::make_unique<LoopReadAheadManager>();
+    }
+
+    // Renders the loop through the scaler until one pass is cached. Then
+    // continues to render the live scaler output alongside the cached
+    // output and compares them sample by sample. The tempo results in a
+    // fractional number of output frames per pass.
+    void compareCachedWithLive(EngineBufferScale* pScaler) {
+        const ScaledLoopCache::Parameters parameters{
+                1.0, 1.1, 1.0, kLoopStart, kLoopEnd};
+        ASSERT_NE(std::floor(parameters.loopLength() / parameters.rate()),
+                parameters.loopLength() / parameters.rate());
+        pScaler->setSampleRate(mixxx::audio::SampleRate(44100));
+        double tempoRatio = parameters.tempoRatio;
+        double pitchRatio = parameters.pitchRatio;
+        pScaler->setScaleParameters(parameters.baseRate, &tempoRatio, &pitchRatio);
+
+        ScaledLoopCache cache(kCapacityFrames);
+        std::vector<CSAMPLE> live(kFrames * kChannels);
+        auto position = kLoopStart;
+        const auto renderLive = [&]() {
+            const double framesRead = pScaler->scaleBuffer(live.data(), kFrames * kChannels);
+            return kLoopStart +
+                    std::fmod(position - kLoopStart + framesRead, kLoopLength);
+        };
+
+        // Skip the latency of the scaler, before it renders a steady pass
+        constexpr int kWarmUpBuffers = 44100 / kFrames;
+        for (int i = 0; i < kWarmUpBuffers; ++i) {
+            position = renderLive();
+        }
+        for (int i = 0; i < 100 && !cache.isCompleteFor(parameters); ++i) {
+            const auto positionBefore = position;
+            position = renderLive();
+            cache.record(parameters, live.data(), kFrames, positionBefore, position);
+        }
+        ASSERT_TRUE(cache.isCompleteFor(parameters));
+
+        // EngineBuffer crossfades from the live output into the first cached
+        // buffer, so start comparing after it. The time stretched output
+        // is only approximately periodic and the cached frames are
+        // interpolated at a fractional offset, hence the tolerance of 10%
+        // of the amplitude.
+        constexpr CSAMPLE kTolerance = 0.05f;
+        std::vector<CSAMPLE> cached(kFrames * kChannels);
+        const auto positionBefore = position;
+        position = renderLive();
+        auto cachedPosition = cache.play(cached.data(), kFrames, positionBefore);
+        // Several passes, so the cache wraps around multiple times
+        for (int i = 0; i < 100; ++i) {
+            position = renderLive();
+            cachedPosition = cache.play(cached.data(), kFrames, cachedPosition);
+            ASSERT_NEAR(position.value(), cachedPosition.value(), 1e-6);
+            for (SINT j = 0; j < kFrames * kChannels; ++j) {
+                ASSERT_NEAR(live[j], cached[j], kTolerance)
+                        << "buffer " << i << " sample " << j;
+            }
+        }
+    }
+
+    std::unique_ptr<LoopReadAheadManager> m_pReadAheadManager;
+};
+
+TEST_F(ScaledLoopCacheScalerTest, SoundTouchCachedMatchesLive) {
+    EngineBufferScaleST scaler(m_pReadAheadManager.get());
+    compareCachedWithLive(&scaler);
+}
+
+TEST_F(ScaledLoopCacheScalerTest, RubberBandCachedMatchesLive) {
+    EngineBufferScaleRubberBand scaler(m_pReadAheadManager.get());
+    compareCachedWithLive(&scaler);
+}
+
+} // namespace
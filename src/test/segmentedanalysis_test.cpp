@@ -0,0 +1,211 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QRandomGenerator>
+#include <QtDebug>
+#include <cmath>
+#include <vector>
+
+#include "analyzer/constants.h"
+#include "analyzer/plugins/analyzerqueenmarybeats.h"
+#include "analyzer/plugins/analyzerqueenmarykey.h"
+#include "analyzer/plugins/buffering_utils.h"
+#include "track/keyutils.h"
+
+namespace {
+
+constexpr auto kSampleRate = mixxx::audio::SampleRate(44100);
+constexpr double kBpm = 124.0;
+constexpr double kTrackSeconds = 150.0;
+
+// Clicks on every beat over an A minor chord
+std::vector<CSAMPLE> generateTrack(double seconds) {
+    const SINT frames = static_cast<SINT>(seconds * kSampleRate);
+    const SINT framesPerBeat = static_cast<SINT>(60.0 / kBpm * kSampleRate);
+    const SINT clickFrames = static_cast<SINT>(0.02 * kSampleRate);
+    QRandomGenerator random(1);
+    std::vector<CSAMPLE> samples(frames * mixxx::kAnalysisChannels);
+    for (SINT frame = 0; frame < frames; ++frame) {
+        const double t = static_cast<double>(frame) / kSampleRate;
+        double value = 0.1 * (std::sin(2 * M_PI * 220.0 * t) +
+                                     std::sin(2 * M_PI * 261.63 * t) +
+                                     std::sin(2 * M_PI * 329.63 * t));
+        const SINT clickFrame = frame % framesPerBeat;
+        if (clickFrame < clickFrames) {
+            const double envelope = 1.0 - static_cast<double>(clickFrame) / clickFrames;
+            value += envelope * (random.generateDouble() - 0.5);
+        }
+        samples[frame * 2] = static_cast<CSAMPLE>(value);
+        samples[frame * 2 + 1] = static_cast<CSAMPLE>(value * 0.8);
+    }
+    return samples;
+}
+
+// Feeds the samples in chunks like the AnalyzerThread
+template<typename Plugin>
+bool analyze(Plugin* pPlugin, const std::vector<CSAMPLE>& samples) {
+    if (!pPlugin->initialize(kSampleRate)) {
+        return false;
+    }
+    for (size_t offset = 0; offset < samples.size();
+            offset += mixxx::kAnalysisSamplesPerChunk) {
+        const int length = static_cast<int>(std::min<size_t>(
+                mixxx::kAnalysisSamplesPerChunk, samples.size() - offset));
+        if (!pPlugin->processSamples(samples.data() + offset, length)) {
+            return false;
+        }
+    }
+    return pPlugin->finalize();
+}
+
+class SegmentedAnalysisTest : public testing::Test {
+  protected:
+    static const std::vector<CSAMPLE>& track() {
+        static const std::vector<CSAMPLE> s_track = generateTrack(kTrackSeconds);
+        return s_track;
+    }
+};
+
+// A window function that depends on the two preceding windows
+class SumOfLastWindows {
+  public:
+    double operator()(const double* pWindow, size_t windowSize) {
+        double sum = 0.0;
+        for (size_t i = 0; i < windowSize; ++i) {
+            sum += pWindow[i] * (i + 1);
+        }
+        const double result = sum + 0.5 * m_previous + 0.25 * m_beforePrevious;
+        m_beforePrevious = m_previous;
+        m_previous = sum;
+        return result;
+    }
+
+  private:
+    double m_previous = 0.0;
+    double m_beforePrevious = 0.0;
+};
+
+TEST_F(SegmentedAnalysisTest, HelperMatchesSerialWindows) {
+    constexpr size_t kWindowSize = 8;
+    constexpr size_t kStepSize = 3;
+    constexpr size_t kSegmentWindows = 5;
+    constexpr size_t kWarmUpWindows = 2;
+    QRandomGenerator random(2);
+    // Covers inputs that end before, on and after segment boundaries
+    for (size_t frames = 0; frames < 100; ++frames) {
+        std::vector<CSAMPLE> samples(frames * 2);
+        for (auto& sample : samples) {
+            sample = static_cast<CSAMPLE>(random.generateDouble() - 0.5);
+        }
+
+        std::vector<double> serialResults;
+        SumOfLastWindows serialFunction;
+        mixxx::DownmixAndOverlapHelper serialHelper;
+        ASSERT_TRUE(serialHelper.initialize(kWindowSize,
+                kStepSize,
+                [&](double* pWindow, size_t windowSize) {
+                    serialResults.push_back(serialFunction(pWindow, windowSize));
+                    return true;
+                }));
+        ASSERT_TRUE(serialHelper.processStereoSamples(samples.data(), samples.size()));
+        ASSERT_TRUE(serialHelper.finalize());
+
+        mixxx::SegmentedDownmixAndOverlapHelper segmentedHelper;
+        ASSERT_TRUE(segmentedHelper.initialize(kWindowSize,
+                kStepSize,
+                kSegmentWindows,
+                kWarmUpWindows,
+                []() {
+                    auto pFunction = std::make_shared<SumOfLastWindows>();
+                    return [pFunction](double* pWindow, size_t windowSize, double* pResult) {
+                        *pResult = (*pFunction)(pWindow, windowSize);
+                        return true;
+                    };
+                }));
+        // Odd chunk sizes
+        for (size_t offset = 0; offset < samples.size(); offset += 14) {
+            ASSERT_TRUE(segmentedHelper.processStereoSamples(samples.data() + offset,
+                    std::min<size_t>(14, samples.size() - offset)));
+        }
+        ASSERT_TRUE(segmentedHelper.finalize());
+
+        EXPECT_EQ(serialResults, segmentedHelper.results()) << frames << "frames";
+    }
+}
+
+TEST_F(SegmentedAnalysisTest, HelperFailure) {
+    mixxx::SegmentedDownmixAndOverlapHelper helper;
+    ASSERT_TRUE(helper.initialize(8, 4, 4, 1, []() {
+        return [](double*, size_t, double*) {
+            return false;
+        };
+    }));
+    const std::vector<CSAMPLE> samples(200, 0.5f);
+    helper.processStereoSamples(samples.data(), samples.size());
+    EXPECT_FALSE(helper.finalize());
+}
+
+TEST_F(SegmentedAnalysisTest, QueenMaryBeatsMatchSerial) {
+    mixxx::AnalyzerQueenMaryBeats serial;
+    ASSERT_TRUE(analyze(&serial, track()));
+    mixxx::AnalyzerQueenMaryBeats segmented(true);
+    ASSERT_TRUE(analyze(&segmented, track()));
+
+    ASSERT_FALSE(serial.getBeats().isEmpty());
+    EXPECT_EQ(serial.getBeats(), segmented.getBeats());
+}
+
+TEST_F(SegmentedAnalysisTest, QueenMaryKeyMatchesSerial) {
+    mixxx::AnalyzerQueenMaryKey serial;
+    ASSERT_TRUE(analyze(&serial, track()));
+    mixxx::AnalyzerQueenMaryKey segmented(true);
+    ASSERT_TRUE(analyze(&segmented, track()));
+
+    // The warm-up restores the averaged chroma, but not the exact state
+    // of the decimation filter. Only the key positions may differ.
+    const int totalSamples = static_cast<int>(track().size());
+    const auto serialKey = KeyUtils::calculateGlobalKey(
+            serial.getKeyChanges(), totalSamples, kSampleRate);
+    ASSERT_NE(mixxx::track::io::key::INVALID, serialKey);
+    EXPECT_EQ(serialKey,
+            KeyUtils::calculateGlobalKey(
+                    segmented.getKeyChanges(), totalSamples, kSampleRate));
+    ASSERT_EQ(serial.getKeyChanges().size(), segmented.getKeyChanges().size());
+    for (int i = 0; i < serial.getKeyChanges().size(); ++i) {
+        EXPECT_EQ(serial.getKeyChanges()[i].first, segmented.getKeyChanges()[i].first);
+    }
+}
+
+template<typename Plugin>
+void analyzeTrack(benchmark::State& state, bool segmented) {
+    const std::vector<CSAMPLE> samples = generateTrack(static_cast<double>(state.range(0)));
+    for (auto _ : state) {
+        Plugin plugin(segmented);
+        if (!analyze(&plugin, samples)) {
+            state.SkipWithError("Analysis failed");
+            break;
+        }
+    }
+}
+
+} // namespace
+
+static void BM_QueenMaryBeatsSerial(benchmark::State& state) {
+    analyzeTrack<mixxx::AnalyzerQueenMaryBeats>(state, false);
+}
+BENCHMARK(BM_QueenMaryBeatsSerial)->Arg(60)->Arg(300)->Unit(benchmark::kMillisecond);
+
+static void BM_QueenMaryBeatsSegmented(benchmark::State& state) {
+    analyzeTrack<mixxx::AnalyzerQueenMaryBeats>(state, true);
+}
+BENCHMARK(BM_QueenMaryBeatsSegmented)->Arg(60)->Arg(300)->Unit(benchmark::kMillisecond);
+
+static void BM_QueenMaryKeySerial(benchmark::State& state) {
+    analyzeTrack<mixxx::AnalyzerQueenMaryKey>(state, false);
+}
+BENCHMARK(BM_QueenMaryKeySerial)->Arg(60)->Arg(300)->Unit(benchmark::kMillisecond);
+
+static void BM_QueenMaryKeySegmented(benchmark::State& state) {
+    analyzeTrack<mixxx::AnalyzerQueenMaryKey>(state, true);
+}
+BENCHMARK(BM_QueenMaryKeySegmented)->Arg(60)->Arg(300)->Unit(benchmark::kMillisecond);
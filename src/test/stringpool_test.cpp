@@ -0,0 +1,168 @@
+#include "util/stringpool.h"
+
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QSet>
+
+#include "test/librarybenchmark.h"
+#include "track/track.h"
+#include "track/tracksnapshot.h"
+
+namespace {
+
+class StringPoolTest : public testing::Test {
+  protected:
+    mixxx::StringPool m_pool;
+};
+
+TEST_F(StringPoolTest, Intern) {
+    const QString artist = m_pool.intern(QString("Art") + QString("ist"));
+    const QString other = m_pool.intern(QString("Artis") + QString("t"));
+    EXPECT_EQ(QStringLiteral("Artist"), other);
+    EXPECT_EQ(artist.constData(), other.constData());
+    EXPECT_NE(artist.constData(), m_pool.intern(QStringLiteral("Album")).constData());
+    EXPECT_EQ(2, m_pool.size());
+
+    // Empty strings are not pooled
+    EXPECT_TRUE(m_pool.intern(QString("")).isNull());
+    EXPECT_EQ(2, m_pool.size());
+}
+
+TEST_F(StringPoolTest, Purge) {
+    QString artist = m_pool.intern(QString("Art") + QString("ist"));
+    m_pool.intern(QString("Al") + QString("bum"));
+    EXPECT_EQ(2, m_pool.size());
+
+    // Only strings that are still referenced are kept
+    m_pool.purge();
+    EXPECT_EQ(1, m_pool.size());
+    EXPECT_EQ(artist.constData(),
+            m_pool.intern(QString("Artis") + QString("t")).constData());
+
+    artist.clear();
+    m_pool.purge();
+    EXPECT_EQ(0, m_pool.size());
+}
+
+TEST_F(StringPoolTest, PurgeWhileGrowing) {
+    // Unreferenced strings don't accumulate
+    for (int i = 0; i < 100000; ++i) {
+        m_pool.intern(QString::number(i));
+    }
+    EXPECT_GT(10000, m_pool.size());
+}
+
+// Counts the heap memory of all distinct string buffers
+class StringBytes {
+  public:
+    void add(const QString& str) {
+        if (!str.isEmpty() && !m_buffers.contains(str.constData())) {
+            m_buffers.insert(str.constData());
+            m_bytes += sizeof(QChar) * str.capacity();
+        }
+    }
+
+    std::size_t bytes() const {
+        return m_bytes;
+    }
+
+  private:
+    QSet<const QChar*> m_buffers;
+    std::size_t m_bytes = 0;
+};
+
+void reportMemory(benchmark::State& state, std::size_t bytes) {
+    const int trackCount = static_cast<int>(state.range(0));
+    state.counters["BytesPerTrack"] = static_cast<double>(bytes) / trackCount;
+    state.counters["TotalMB"] = static_cast<double>(bytes) / (1024 * 1024);
+}
+
+// Loads a synthetic library from the database through TrackDAO, either as
+// Track objects or as snapshots. The memory is estimated from the size of
+// the objects and of their strings, which are shared with other tracks if
+// they have been interned. Memory that is allocated by the objects
+// themselves, e.g. by QObject, is not included.
+class TrackMemoryBenchmark : public LibraryBenchmark {
+  public:
+    using LibraryBenchmark::SetUp;
+
+    void SetUp(benchmark::State& state) override {
+        LibraryBenchmark::SetUp(state);
+        const int trackCount = static_cast<int>(state.range(0));
+        if (!addSyntheticTracks(trackCount)) {
+            state.SkipWithError("Failed to add tracks");
+            return;
+        }
+        m_trackIds.reserve(trackCount);
+        for (int i = 1; i <= trackCount; ++i) {
+            m_trackIds.append(TrackId(i));
+        }
+    }
+
+  protected:
+    QList<TrackId> m_trackIds;
+};
+
+} // namespace
+
+BENCHMARK_DEFINE_F(TrackMemoryBenchmark, LoadTracks)
+(benchmark::State& state) {
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        // The tracks are evicted from the cache when the list is destroyed
+        const TrackPointerList tracks =
+                trackCollectionManager()->getTracksById(m_trackIds);
+        state.PauseTiming();
+        if (tracks.size() != m_trackIds.size()) {
+            state.SkipWithError("Failed to load tracks");
+            break;
+        }
+        StringBytes stringBytes;
+        for (const auto& pTrack : tracks) {
+            stringBytes.add(pTrack->getLocation());
+            stringBytes.add(pTrack->getArtist());
+            stringBytes.add(pTrack->getTitle());
+            stringBytes.add(pTrack->getAlbum());
+            stringBytes.add(pTrack->getAlbumArtist());
+            stringBytes.add(pTrack->getGenre());
+            stringBytes.add(pTrack->getYear());
+        }
+        bytes = sizeof(Track) * tracks.size() + stringBytes.bytes();
+        state.ResumeTiming();
+    }
+    reportMemory(state, bytes);
+}
+BENCHMARK_REGISTER_F(TrackMemoryBenchmark, LoadTracks)
+        ->Arg(100000)
+        ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(TrackMemoryBenchmark, LoadTrackSnapshots)
+(benchmark::State& state) {
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        const TrackSnapshotList snapshots =
+                trackCollectionManager()->getTrackSnapshots(m_trackIds);
+        state.PauseTiming();
+        if (snapshots.size() != m_trackIds.size()) {
+            state.SkipWithError("Failed to load track snapshots");
+            break;
+        }
+        StringBytes stringBytes;
+        for (const auto& snapshot : snapshots) {
+            stringBytes.add(snapshot.location);
+            stringBytes.add(snapshot.artist);
+            stringBytes.add(snapshot.title);
+            stringBytes.add(snapshot.album);
+            stringBytes.add(snapshot.albumArtist);
+            stringBytes.add(snapshot.genre);
+            stringBytes.add(snapshot.year);
+        }
+        bytes = sizeof(TrackSnapshot) * snapshots.size() + stringBytes.bytes();
+        state.ResumeTiming();
+    }
+    reportMemory(state, bytes);
+}
+BENCHMARK_REGISTER_F(TrackMemoryBenchmark, LoadTrackSnapshots)
+        ->Arg(100000)
+        ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,117 @@
+#include "util/threadrole.h"
+
+#include <gtest/gtest.h>
+
+namespace {
+
+using mixxx::ThreadRole;
+using mixxx::ThreadRoleConfig;
+using mixxx::ThreadRoleRegistry;
+
+class ThreadRoleTest : public testing::Test {
+  protected:
+    void TearDown() override {
+        for (int i = 0; i < mixxx::kThreadRoleCount; ++i) {
+            ThreadRoleRegistry::setConfig(static_cast<ThreadRole>(i), ThreadRoleConfig());
+        }
+    }
+
+    static int countThreads(ThreadRole role) {
+        int count = 0;
+        for (const auto& thread : ThreadRoleRegistry::threads()) {
+            if (thread.role == role) {
+                ++count;
+            }
+        }
+        return count;
+    }
+};
+
+TEST_F(ThreadRoleTest, ParseCpuList) {
+    EXPECT_EQ(QList<int>(), ThreadRoleConfig::parseCpuList(QString()));
+    EXPECT_EQ(QList<int>({2}), ThreadRoleConfig::parseCpuList("2"));
+    EXPECT_EQ(QList<int>({0, 1, 2, 5}), ThreadRoleConfig::parseCpuList("5, 0-2"));
+    EXPECT_EQ(QList<int>({1, 2, 3}), ThreadRoleConfig::parseCpuList("1-2,2-3"));
+    // Invalid ranges are skipped
+    EXPECT_EQ(QList<int>({4}), ThreadRoleConfig::parseCpuList("3-1,x,4,-1"));
+}
+
+TEST_F(ThreadRoleTest, EffectiveCpusWithoutIsolation) {
+    ThreadRoleConfig config;
+    config.cpus = {1, 2};
+    ThreadRoleRegistry::setConfig(ThreadRole::Analyzer, config);
+
+    EXPECT_EQ(QList<int>({1, 2}), ThreadRoleRegistry::effectiveCpus(ThreadRole::Analyzer, 4));
+    // Unrestricted
+    EXPECT_EQ(QList<int>(), ThreadRoleRegistry::effectiveCpus(ThreadRole::VSync, 4));
+}
+
+TEST_F(ThreadRoleTest, IsolatedCpusAreExcludedFromOtherRoles) {
+    ThreadRoleConfig audioConfig;
+    audioConfig.cpus = {3};
+    audioConfig.isolated = true;
+    ThreadRoleRegistry::setConfig(ThreadRole::AudioCallback, audioConfig);
+    ThreadRoleConfig analyzerConfig;
+    analyzerConfig.cpus = {2, 3};
+    ThreadRoleRegistry::setConfig(ThreadRole::Analyzer, analyzerConfig);
+
+    EXPECT_EQ(QList<int>({3}),
+            ThreadRoleRegistry::effectiveCpus(ThreadRole::AudioCallback, 4));
+    EXPECT_EQ(QList<int>({2}),
+            ThreadRoleRegistry::effectiveCpus(ThreadRole::Analyzer, 4));
+    EXPECT_EQ(QList<int>({0, 1, 2}),
+            ThreadRoleRegistry::effectiveCpus(ThreadRole::CachingReader, 4));
+}
+
+TEST_F(ThreadRoleTest, FallBackIfAllCpusAreIsolated) {
+    ThreadRoleConfig audioConfig;
+    audioConfig.cpus = {0, 1};
+    audioConfig.isolated = true;
+    ThreadRoleRegistry::setConfig(ThreadRole::AudioCallback, audioConfig);
+    ThreadRoleConfig analyzerConfig;
+    analyzerConfig.cpus = {1};
+    ThreadRoleRegistry::setConfig(ThreadRole::Analyzer, analyzerConfig);
+
+    EXPECT_EQ(QList<int>({1}),
+            ThreadRoleRegistry::effectiveCpus(ThreadRole::Analyzer, 2));
+}
+
+TEST_F(ThreadRoleTest, RegisterCurrentThread) {
+    const int countBefore = countThreads(ThreadRole::Controller);
+    {
+        const mixxx::ScopedThreadRole threadRole(ThreadRole::Controller);
+        EXPECT_EQ(countBefore + 1, countThreads(ThreadRole::Controller));
+    }
+    EXPECT_EQ(countBefore, countThreads(ThreadRole::Controller));
+}
+
+TEST_F(ThreadRoleTest, AttachReservedThread) {
+    const int countBefore = countThreads(ThreadRole::AudioCallback);
+    const int id = ThreadRoleRegistry::reserveThread(
+            ThreadRole::AudioCallback, QStringLiteral("Test"));
+    // Not listed before the thread has been attached
+    EXPECT_EQ(countBefore, countThreads(ThreadRole::AudioCallback));
+
+    ThreadRoleRegistry::attachCurrentThread(id);
+    // Only the first call has an effect
+    ThreadRoleRegistry::attachCurrentThread(id);
+    EXPECT_EQ(countBefore + 1, countThreads(ThreadRole::AudioCallback));
+
+    ThreadRoleRegistry::unregisterThread(id);
+    EXPECT_EQ(countBefore, countThreads(ThreadRole::AudioCallback));
+    // Attaching after unregistering is ignored
+    ThreadRoleRegistry::attachCurrentThread(id);
+    EXPECT_EQ(countBefore, countThreads(ThreadRole::AudioCallback));
+}
+
+#ifdef __LINUX__
+TEST_F(ThreadRoleTest, RealTimePriorityIsInRange) {
+    ThreadRoleConfig config;
+    config.policy = ThreadRoleConfig::Policy::RealTime;
+    config.priority = 0;
+    ThreadRoleRegistry::setConfig(ThreadRole::AudioCallback, config);
+    EXPECT_GE(ThreadRoleRegistry::config(ThreadRole::AudioCallback).priority, 1);
+}
+#endif
+
+} // namespace
@@ -0,0 +1,143 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "test/timecodesignal.h"
+
+namespace {
+
+constexpr unsigned int kSampleRate = 96000;
+constexpr int kChannels = 2;
+constexpr unsigned int kStartCycle = mixxxtest::kTimecodeStartCycle;
+
+const char* const kTimecodes[] = {"serato_2a", "traktor_a", "mixvibes_v2"};
+
+std::vector<float> synthesizeTimecode(const timecode_def& def, double rate, int frames) {
+    return mixxxtest::synthesizeTimecode(def, kSampleRate, rate, frames);
+}
+
+/// The position in milliseconds at the end of the synthesized signal
+double expectedPosition(const timecode_def& def, double rate, int frames) {
+    const double cycles = kStartCycle + frames * def.resolution * rate / kSampleRate;
+    return cycles * 1000.0 / def.resolution;
+}
+
+/// Converts the samples to signed short the way the float input
+/// was submitted before timecoder_submit_float() existed
+std::vector<short> toShort(const std::vector<float>& samples) {
+    std::vector<short> pcm(samples.size());
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        const float sample = samples[i] * 32767.0f;
+        pcm[i] = static_cast<short>(std::max(-32768.0f, std::min(32767.0f, sample)));
+    }
+    return pcm;
+}
+
+class TimecoderTest : public testing::TestWithParam<const char*> {
+  protected:
+    void SetUp() override {
+        m_pDef = timecoder_find_definition(GetParam());
+        ASSERT_NE(nullptr, m_pDef);
+        timecoder_init(&m_timecoder, m_pDef, 1.0, kSampleRate, false);
+    }
+
+    void TearDown() override {
+        timecoder_clear(&m_timecoder);
+    }
+
+    timecode_def* m_pDef;
+    timecoder m_timecoder;
+};
+
+TEST_P(TimecoderTest, DecodesFloatInput) {
+    constexpr double kRate = 1.03;
+    constexpr int kFrames = 2 * kSampleRate;
+    std::vector<float> samples = synthesizeTimecode(*m_pDef, kRate, kFrames);
+    // Submit in chunks of an odd size that is not aligned to the conversion
+    // blocks, with a gain as applied by the vinyl control pre-amp
+    for (float& sample : samples) {
+        sample *= 0.5f;
+    }
+    constexpr int kChunkFrames = 301;
+    for (int frame = 0; frame < kFrames; frame += kChunkFrames) {
+        timecoder_submit_float(&m_timecoder,
+                samples.data() + frame * kChannels,
+                std::min(kChunkFrames, kFrames - frame),
+                2.0f);
+    }
+
+    const signed int position = timecoder_get_position(&m_timecoder, nullptr);
+    ASSERT_NE(-1, position);
+    // Within two cycles of the carrier
+    EXPECT_NEAR(expectedPosition(*m_pDef, kRate, kFrames),
+            position,
+            2 * 1000.0 / m_pDef->resolution);
+    EXPECT_NEAR(kRate, timecoder_get_pitch(&m_timecoder), 0.005);
+}
+
+TEST_P(TimecoderTest, FloatInputMatchesShortInput) {
+    constexpr double kRate = 0.97;
+    constexpr int kFrames = kSampleRate;
+    std::vector<float> samples = synthesizeTimecode(*m_pDef, kRate, kFrames);
+    std::vector<short> pcm = toShort(samples);
+
+    timecoder shortTimecoder;
+    timecoder_init(&shortTimecoder, m_pDef, 1.0, kSampleRate, false);
+    timecoder_submit(&shortTimecoder, pcm.data(), kFrames);
+    timecoder_submit_float(&m_timecoder, samples.data(), kFrames, 1.0f);
+
+    EXPECT_EQ(timecoder_get_position(&shortTimecoder, nullptr),
+            timecoder_get_position(&m_timecoder, nullptr));
+    EXPECT_NEAR(timecoder_get_pitch(&shortTimecoder),
+            timecoder_get_pitch(&m_timecoder),
+            0.001);
+    timecoder_clear(&shortTimecoder);
+}
+
+INSTANTIATE_TEST_SUITE_P(Timecodes, TimecoderTest, testing::ValuesIn(kTimecodes));
+
+} // namespace
+
+// Decodes one second of a synthesized timecode signal at 96 kHz for the
+// timecode index in kTimecodes, either from float samples or from samples
+// converted to signed short. Reports the final pitch error.
+static void BM_TimecoderSubmit(benchmark::State& state) {
+    constexpr double kRate = 1.02;
+    constexpr int kFrames = kSampleRate;
+    constexpr int kBufferFrames = 512;
+    timecode_def* pDef = timecoder_find_definition(kTimecodes[state.range(0)]);
+    const bool submitFloat = state.range(1) != 0;
+    const std::vector<float> samples = synthesizeTimecode(*pDef, kRate, kFrames);
+    std::vector<short> pcm(kBufferFrames * kChannels);
+
+    double pitchError = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        timecoder timecoder;
+        timecoder_init(&timecoder, pDef, 1.0, kSampleRate, false);
+        state.ResumeTiming();
+        for (int frame = 0; frame < kFrames; frame += kBufferFrames) {
+            const float* pSamples = samples.data() + frame * kChannels;
+            const int frames = std::min(kBufferFrames, kFrames - frame);
+            if (submitFloat) {
+                timecoder_submit_float(&timecoder, pSamples, frames, 1.0f);
+            } else {
+                for (int i = 0; i < frames * kChannels; ++i) {
+                    pcm[i] = static_cast<short>(pSamples[i] * 32767.0f);
+                }
+                timecoder_submit(&timecoder, pcm.data(), frames);
+            }
+        }
+        benchmark::DoNotOptimize(timecoder_get_position(&timecoder, nullptr));
+        pitchError = std::abs(timecoder_get_pitch(&timecoder) - kRate);
+        timecoder_clear(&timecoder);
+    }
+    state.SetItemsProcessed(state.iterations() * kFrames);
+    state.SetLabel(kTimecodes[state.range(0)]);
+    state.counters["pitch_error"] = pitchError;
+}
+// Timecode index, float input
+BENCHMARK(BM_TimecoderSubmit)->ArgsProduct({{0, 1, 2}, {0, 1}});
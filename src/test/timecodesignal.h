@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include "util/math.h"
+
+#ifdef _MSC_VER
+#include "timecoder.h"
+#else
+extern "C" {
+#include "timecoder.h"
+}
+#endif
+
+namespace mixxxtest {
+
+// Skip the beginning of the record to start at a non-zero position
+constexpr unsigned int kTimecodeStartCycle = 10000;
+
+namespace detail {
+
+// Same values as in timecoder.c
+constexpr int kSwitchPhase = 0x1;
+constexpr int kSwitchPrimary = 0x2;
+constexpr int kSwitchPolarity = 0x4;
+
+// Forward LFSR of timecode_def, same as fwd() in timecoder.c
+inline bits_t nextCode(bits_t code, const timecode_def& def) {
+    bits_t taken = code & (def.taps | 0x1);
+    bits_t parity = 0;
+    while (taken != 0) {
+        parity ^= taken & 0x1;
+        taken >>= 1;
+    }
+    return (code >> 1) | (parity << (def.bits - 1));
+}
+
+} // namespace detail
+
+/// Synthesizes the stereo signal of a timecode record that is played at
+/// the given rate, starting at kTimecodeStartCycle.
+///
+/// Each cycle of the carrier carries one bit as the amplitude of the primary
+/// channel. The bit is read by the decoder at a peak of the primary channel
+/// when the secondary channel crosses zero, the amplitude changes at the
+/// opposite peak to keep the read point away from the transitions.
+inline std::vector<float> synthesizeTimecode(const timecode_def& def,
+        unsigned int sampleRate,
+        double rate,
+        int frames) {
+    constexpr int kChannels = 2;
+    bits_t code = def.seed;
+    for (unsigned int cycle = 0; cycle < kTimecodeStartCycle; ++cycle) {
+        code = detail::nextCode(code, def);
+    }
+    unsigned int cycle = kTimecodeStartCycle;
+
+    std::vector<float> samples(frames * kChannels);
+    const double cyclesPerFrame = def.resolution * rate / sampleRate;
+    const bool primaryLeft = def.flags & detail::kSwitchPrimary;
+    // The primary channel lags by 270 instead of 90 degrees
+    const double primarySign = (def.flags & detail::kSwitchPhase) ? -1.0 : 1.0;
+    // The bits are read at the positive or negative peak of the primary channel
+    const bool readAtPositivePeak = !(def.flags & detail::kSwitchPolarity);
+    const double readPhase = ((primarySign > 0) == readAtPositivePeak) ? 0.0 : 0.5;
+    for (int frame = 0; frame < frames; ++frame) {
+        const double position = kTimecodeStartCycle + frame * cyclesPerFrame;
+        while (cycle < static_cast<unsigned int>(position - readPhase + 0.5)) {
+            code = detail::nextCode(code, def);
+            ++cycle;
+        }
+        const bool bit = (code >> (def.bits - 1)) & 0x1;
+        const double phase = 2 * M_PI * position;
+        const auto primary = static_cast<float>(
+                primarySign * (bit ? 0.5 : 0.35) * std::cos(phase));
+        const auto secondary = static_cast<float>(0.5 * std::sin(phase));
+        samples[frame * kChannels] = primaryLeft ? primary : secondary;
+        samples[frame * kChannels + 1] = primaryLeft ? secondary : primary;
+    }
+    return samples;
+}
+
+} // namespace mixxxtest
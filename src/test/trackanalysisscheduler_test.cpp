@@ -0,0 +1,137 @@
+#include "analyzer/trackanalysisscheduler.h"
+
+#include <gtest/gtest.h>
+
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QTimer>
+
+#include "test/librarytest.h"
+#include "track/track.h"
+
+namespace {
+
+constexpr int kTimeoutMillis = 60000;
+
+class TestEnvironment : public TrackAnalysisSchedulerEnvironment {
+  public:
+    explicit TestEnvironment(TrackCollectionManager* pTrackCollectionManager)
+            : m_pTrackCollectionManager(pTrackCollectionManager) {
+    }
+
+    TrackPointer loadTrackById(TrackId trackId) const override {
+        return m_pTrackCollectionManager->getTrackById(trackId);
+    }
+
+  private:
+    TrackCollectionManager* const m_pTrackCollectionManager;
+};
+
+} // namespace
+
+class TrackAnalysisSchedulerTest : public LibraryTest {
+  protected:
+    void SetUp() override {
+        // A single worker analyzes the tracks one after another
+        m_pScheduler = TrackAnalysisScheduler::createInstance(
+                std::make_unique<TestEnvironment>(trackCollectionManager()),
+                1,
+                dbConnectionPooler(),
+                config(),
+                AnalyzerModeFlags::None);
+        QObject::connect(m_pScheduler.get(),
+                &TrackAnalysisScheduler::queueChanged,
+                [this] {
+                    ++m_queueChangedCount;
+                });
+        // With a single worker the tracks are analyzed in the order
+        // in which they have been dequeued
+        QObject::connect(m_pScheduler.get(),
+                &TrackAnalysisScheduler::trackProgress,
+                [this](TrackId trackId, AnalyzerProgress analyzerProgress) {
+                    Q_UNUSED(analyzerProgress);
+                    if (!m_analyzedTrackIds.contains(trackId)) {
+                        m_analyzedTrackIds.append(trackId);
+                    }
+                });
+    }
+
+    void TearDown() override {
+        // The worker must have exited before the database is closed
+        m_pScheduler->stop();
+        for (auto& worker : m_pScheduler->m_workers) {
+            if (worker) {
+                worker.thread()->wait();
+            }
+        }
+        // Deliver the exit signals of the workers and
+        // delete the threads and the scheduler
+        QCoreApplication::processEvents();
+        m_pScheduler.reset();
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    }
+
+    TrackId addTrack(const QString& fileName) const {
+        const TrackPointer pTrack = getOrAddTrackByLocation(
+                getTestDir().filePath(QStringLiteral("id3-test-data/") + fileName));
+        EXPECT_NE(nullptr, pTrack);
+        return pTrack ? pTrack->getId() : TrackId();
+    }
+
+    bool analyzeScheduledTracks() {
+        QEventLoop eventLoop;
+        QObject::connect(m_pScheduler.get(),
+                &TrackAnalysisScheduler::finished,
+                &eventLoop,
+                &QEventLoop::quit);
+        QTimer::singleShot(kTimeoutMillis, &eventLoop, &QEventLoop::quit);
+        m_pScheduler->resume();
+        eventLoop.exec();
+        return m_pScheduler->unfinishedTracksCount() == 0;
+    }
+
+    TrackAnalysisScheduler::Pointer m_pScheduler =
+            TrackAnalysisScheduler::NullPointer();
+    QList<TrackId> m_analyzedTrackIds;
+    int m_queueChangedCount = 0;
+};
+
+TEST_F(TrackAnalysisSchedulerTest, PriorityLaneIsServedFirst) {
+    const TrackId sampler1 = addTrack("cover-test.ogg");
+    const TrackId sampler2 = addTrack("cover-test.flac");
+    const TrackId deck1 = addTrack("cover-test.wav");
+    const TrackId deck2 = addTrack("cover-test.aiff");
+
+    ASSERT_TRUE(m_pScheduler->scheduleTrack(sampler1));
+    ASSERT_TRUE(m_pScheduler->scheduleTrack(sampler2));
+    ASSERT_TRUE(m_pScheduler->scheduleTrack(deck1, TrackAnalysisScheduler::Priority::High));
+    ASSERT_TRUE(m_pScheduler->scheduleTrack(deck2, TrackAnalysisScheduler::Priority::High));
+    EXPECT_EQ(4, m_pScheduler->unfinishedTracksCount());
+    EXPECT_EQ(4, m_queueChangedCount);
+
+    ASSERT_TRUE(analyzeScheduledTracks());
+
+    const QList<TrackId> expectedTrackIds{deck1, deck2, sampler1, sampler2};
+    EXPECT_EQ(expectedTrackIds, m_analyzedTrackIds);
+    // Each track has been dequeued and finished
+    EXPECT_EQ(4 + 2 * 4, m_queueChangedCount);
+    EXPECT_TRUE(m_pScheduler->longestWaitTime().isEmpty());
+}
+
+TEST_F(TrackAnalysisSchedulerTest, QueuedTrackMovesIntoPriorityLane) {
+    const TrackId first = addTrack("cover-test.ogg");
+    const TrackId second = addTrack("cover-test.flac");
+    const TrackId third = addTrack("cover-test.wav");
+
+    ASSERT_TRUE(m_pScheduler->scheduleTrack(first));
+    ASSERT_TRUE(m_pScheduler->scheduleTrack(second));
+    ASSERT_TRUE(m_pScheduler->scheduleTrack(third));
+    // The track is loaded into a deck while it is still queued
+    ASSERT_TRUE(m_pScheduler->scheduleTrack(third, TrackAnalysisScheduler::Priority::High));
+    EXPECT_EQ(3, m_pScheduler->unfinishedTracksCount());
+
+    ASSERT_TRUE(analyzeScheduledTracks());
+
+    const QList<TrackId> expectedTrackIds{third, first, second};
+    EXPECT_EQ(expectedTrackIds, m_analyzedTrackIds);
+}
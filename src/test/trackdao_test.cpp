@@ -1,7 +1,13 @@
+#include <benchmark/benchmark.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <QFile>
+
+#include "library/dao/playlistdao.h"
+#include "test/librarybenchmark.h"
 #include "test/librarytest.h"
+#include "track/globaltrackcache.h"
 #include "track/track.h"
 
 using ::testing::UnorderedElementsAre;
@@ -56,3 +62,179 @@ TEST_F(TrackDAOTest, detectMovedTracks) {
     QSet<QString> trackLocations = trackDAO.getAllTrackLocations();
     EXPECT_THAT(trackLocations, UnorderedElementsAre(newFile.location(), otherFile.location()));
 }
+
+TEST_F(TrackDAOTest, getTrackSnapshots) {
+    TrackDAO& trackDAO = internalCollection()->getTrackDAO();
+
+    TrackPointer pTrack1 = getOrAddTrackByLocation(
+            getTestDir().filePath(QStringLiteral("id3-test-data/cover-test.flac")));
+    TrackPointer pTrack2 = getOrAddTrackByLocation(
+            getTestDir().filePath(QStringLiteral("id3-test-data/cover-test.ogg")));
+    ASSERT_NE(nullptr, pTrack1);
+    ASSERT_NE(nullptr, pTrack2);
+    const TrackId trackId1 = pTrack1->getId();
+    const TrackId trackId2 = pTrack2->getId();
+    const QString location2 = pTrack2->getLocation();
+    pTrack1->setArtist(QStringLiteral("Artist"));
+    pTrack1->setTitle(QStringLiteral("Title 1"));
+    pTrack1->setRating(4);
+    pTrack2->setArtist(QStringLiteral("Artist"));
+    pTrack2->setTitle(QStringLiteral("Title 2"));
+    // Evict the tracks from the cache and save them
+    pTrack1.reset();
+    pTrack2.reset();
+
+    // Loaded from the database in the requested order
+    TrackSnapshotList snapshots =
+            trackDAO.getTrackSnapshots({trackId2, TrackId(1000), trackId1});
+    ASSERT_EQ(2, snapshots.size());
+    EXPECT_EQ(trackId2, snapshots[0].id);
+    EXPECT_EQ(location2, snapshots[0].location);
+    EXPECT_EQ(QStringLiteral("Title 2"), snapshots[0].title);
+    EXPECT_EQ(trackId1, snapshots[1].id);
+    EXPECT_EQ(QStringLiteral("Title 1"), snapshots[1].title);
+    EXPECT_EQ(4, snapshots[1].rating);
+    // Both tracks reference the same, interned artist
+    EXPECT_EQ(QStringLiteral("Artist"), snapshots[0].artist);
+    EXPECT_EQ(snapshots[0].artist.constData(), snapshots[1].artist.constData());
+
+    // Unsaved modifications of cached tracks are included
+    pTrack1 = trackCollectionManager()->getTrackById(trackId1);
+    ASSERT_NE(nullptr, pTrack1);
+    pTrack1->setTitle(QStringLiteral("Modified"));
+    snapshots = trackDAO.getTrackSnapshots({trackId1});
+    ASSERT_EQ(1, snapshots.size());
+    EXPECT_EQ(QStringLiteral("Modified"), snapshots[0].title);
+}
+
+TEST_F(TrackDAOTest, getTracksById) {
+    TrackPointer pTrack1 = getOrAddTrackByLocation(
+            getTestDir().filePath(QStringLiteral("id3-test-data/cover-test.flac")));
+    TrackPointer pTrack2 = getOrAddTrackByLocation(
+            getTestDir().filePath(QStringLiteral("id3-test-data/cover-test.ogg")));
+    ASSERT_NE(nullptr, pTrack1);
+    ASSERT_NE(nullptr, pTrack2);
+    const TrackId trackId1 = pTrack1->getId();
+    const TrackId trackId2 = pTrack2->getId();
+    pTrack1->setTitle(QStringLiteral("Title 1"));
+    pTrack2->setTitle(QStringLiteral("Title 2"));
+    // Evict the tracks from the cache and save them
+    pTrack1.reset();
+    pTrack2.reset();
+    ASSERT_TRUE(GlobalTrackCacheLocker().isEmpty());
+
+    // Loaded from the database in the requested order
+    TrackPointerList tracks = trackCollectionManager()->getTracksById(
+            {trackId2, TrackId(1000), trackId1, trackId2});
+    ASSERT_EQ(3, tracks.size());
+    EXPECT_EQ(trackId2, tracks[0]->getId());
+    EXPECT_EQ(QStringLiteral("Title 2"), tracks[0]->getTitle());
+    EXPECT_EQ(trackId1, tracks[1]->getId());
+    EXPECT_EQ(QStringLiteral("Title 1"), tracks[1]->getTitle());
+    EXPECT_FALSE(tracks[1]->isDirty());
+    // Duplicate ids reference the same track object
+    EXPECT_EQ(tracks[0], tracks[2]);
+
+    // Cached tracks are returned with their unsaved modifications
+    tracks[1]->setTitle(QStringLiteral("Modified"));
+    pTrack1 = tracks[1];
+    tracks = trackCollectionManager()->getTracksById({trackId1});
+    ASSERT_EQ(1, tracks.size());
+    EXPECT_EQ(pTrack1, tracks[0]);
+    EXPECT_EQ(QStringLiteral("Modified"), tracks[0]->getTitle());
+
+    EXPECT_LT(0u, GlobalTrackCacheLocker().getLockStats().lockCount);
+}
+
+namespace {
+
+constexpr int kAutoDJPlaylistSize = 5000;
+
+// The smallest of the test files
+const QString kAutoDJTestFile = QStringLiteral("id3-test-data/artist.mp3");
+
+// A library with a long Auto DJ playlist. Each track has its own copy
+// of a real test file, so the tracks are loaded like in a real library.
+class AutoDJPlaylistBenchmark : public LibraryBenchmark {
+  public:
+    using LibraryBenchmark::SetUp;
+
+    void SetUp(benchmark::State& state) override {
+        LibraryBenchmark::SetUp(state);
+        const int trackCount = static_cast<int>(state.range(0));
+        const QString testFilePath = getTestDir().filePath(kAutoDJTestFile);
+        PlaylistDAO& playlistDAO = internalCollection()->getPlaylistDAO();
+        m_autoDJPlaylistId = playlistDAO.createPlaylist(
+                AUTODJ_TABLE, PlaylistDAO::PLHT_AUTO_DJ);
+        QList<TrackId> trackIds;
+        trackIds.reserve(trackCount);
+        for (int i = 0; i < trackCount; ++i) {
+            const QString filePath = getTestDataDir().filePath(
+                    QStringLiteral("%1.mp3").arg(QString::number(i)));
+            if (!QFile::copy(testFilePath, filePath)) {
+                state.SkipWithError("Failed to copy the test file");
+                return;
+            }
+            const auto pTrack = getOrAddTrackByLocation(filePath);
+            if (!pTrack) {
+                state.SkipWithError("Failed to add a track");
+                return;
+            }
+            trackIds.append(pTrack->getId());
+        }
+        playlistDAO.appendTracksToPlaylist(trackIds, m_autoDJPlaylistId);
+    }
+
+  protected:
+    void loadAutoDJPlaylist(benchmark::State& state, bool batch) {
+        const auto lockStatsBefore = GlobalTrackCacheLocker().getLockStats();
+        for (auto _ : state) {
+            const QList<TrackId> trackIds =
+                    internalCollection()->getPlaylistDAO().getTrackIds(m_autoDJPlaylistId);
+            TrackPointerList tracks;
+            if (batch) {
+                tracks = trackCollectionManager()->getTracksById(trackIds);
+            } else {
+                tracks.reserve(trackIds.size());
+                for (const auto& trackId : trackIds) {
+                    tracks.append(trackCollectionManager()->getTrackById(trackId));
+                }
+            }
+            // Evict all tracks from the cache before the next iteration
+            state.PauseTiming();
+            if (tracks.size() != state.range(0) || tracks.contains(TrackPointer())) {
+                state.SkipWithError("Failed to load all tracks");
+                break;
+            }
+            tracks.clear();
+            state.ResumeTiming();
+        }
+        const auto lockStats = GlobalTrackCacheLocker().getLockStats();
+        state.counters["CacheLocks"] = benchmark::Counter(
+                static_cast<double>(lockStats.lockCount - lockStatsBefore.lockCount),
+                benchmark::Counter::kAvgIterations);
+        state.counters["ContendedCacheLocks"] = static_cast<double>(
+                lockStats.contendedLockCount - lockStatsBefore.contendedLockCount);
+    }
+
+  private:
+    int m_autoDJPlaylistId = -1;
+};
+
+} // namespace
+
+BENCHMARK_DEFINE_F(AutoDJPlaylistBenchmark, LoadTrackByTrack)
+(benchmark::State& state) {
+    loadAutoDJPlaylist(state, false);
+}
+BENCHMARK_REGISTER_F(AutoDJPlaylistBenchmark, LoadTrackByTrack)
+        ->Arg(kAutoDJPlaylistSize)
+        ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(AutoDJPlaylistBenchmark, LoadBatch)
+(benchmark::State& state) {
+    loadAutoDJPlaylist(state, true);
+}
+BENCHMARK_REGISTER_F(AutoDJPlaylistBenchmark, LoadBatch)
+        ->Arg(kAutoDJPlaylistSize)
+        ->Unit(benchmark::kMillisecond);
@@ -48,10 +48,10 @@ TEST_F(TrackExporterTest, SimpleListExport) {
 
     // An initializer list would be prettier here, but it doesn't compile
     // on MSVC or OSX.
-    TrackPointerList tracks;
-    tracks.append(track1);
-    tracks.append(track2);
-    tracks.append(track3);
+    TrackSnapshotList tracks;
+    tracks.append(TrackSnapshot::fromTrack(*track1));
+    tracks.append(TrackSnapshot::fromTrack(*track2));
+    tracks.append(TrackSnapshot::fromTrack(*track3));
     TrackExportWorker worker(m_exportDir.canonicalPath(), tracks);
     m_answerer.reset(new FakeOverwriteAnswerer(&worker));
 
@@ -67,6 +67,62 @@ TEST_F(TrackExporterTest, SimpleListExport) {
     EXPECT_TRUE(QFileInfo::exists(m_exportDir.filePath("cover-test-itunes-12.3.0-aac.m4a")));
 }
 
+TEST_F(TrackExporterTest, ProgressAfterCopyHasFinished) {
+    mixxx::FileInfo fileinfo1(m_testDataDir.filePath("cover-test.ogg"));
+    TrackPointer track1(Track::newTemporary(mixxx::FileAccess(fileinfo1)));
+    mixxx::FileInfo fileinfo2(m_testDataDir.filePath("cover-test.flac"));
+    TrackPointer track2(Track::newTemporary(mixxx::FileAccess(fileinfo2)));
+
+    TrackSnapshotList tracks;
+    tracks.append(TrackSnapshot::fromTrack(*track1));
+    tracks.append(TrackSnapshot::fromTrack(*track2));
+    TrackExportWorker worker(m_exportDir.canonicalPath(), tracks);
+    m_answerer.reset(new FakeOverwriteAnswerer(&worker));
+    QStringList finishedFiles;
+    QObject::connect(&worker,
+            &TrackExportWorker::progress,
+            [this, &finishedFiles](const QString& filename, int progress, int count) {
+                EXPECT_EQ(2, count);
+                if (progress == 0) {
+                    return;
+                }
+                // Each file is reported once after it has been written completely
+                EXPECT_TRUE(QFileInfo::exists(m_exportDir.filePath(filename)));
+                EXPECT_FALSE(finishedFiles.contains(filename));
+                finishedFiles.append(filename);
+                EXPECT_EQ(finishedFiles.size(), progress);
+            });
+
+    worker.run();
+    EXPECT_TRUE(worker.wait(10000));
+
+    EXPECT_EQ(2, finishedFiles.size());
+    EXPECT_EQ(2, m_answerer->currentProgress());
+}
+
+TEST_F(TrackExporterTest, CopyError) {
+    mixxx::FileInfo fileinfo1(m_testDataDir.filePath("cover-test.ogg"));
+    TrackPointer track1(Track::newTemporary(mixxx::FileAccess(fileinfo1)));
+
+    // A directory at the destination can't be overwritten with the file
+    ASSERT_TRUE(m_exportDir.mkdir("cover-test.ogg"));
+
+    TrackSnapshotList tracks;
+    tracks.append(TrackSnapshot::fromTrack(*track1));
+    TrackExportWorker worker(m_exportDir.canonicalPath(), tracks);
+    m_answerer.reset(new FakeOverwriteAnswerer(&worker));
+    m_answerer->setAnswer(QDir(m_exportDir.canonicalPath()).filePath("cover-test.ogg"),
+            TrackExportWorker::OverwriteAnswer::OVERWRITE);
+
+    worker.run();
+    EXPECT_TRUE(worker.wait(10000));
+
+    // The failed copy is reported and cancels the export
+    EXPECT_FALSE(worker.errorMessage().isEmpty());
+    EXPECT_EQ(-1, m_answerer->currentProgress());
+    EXPECT_EQ(-1, m_answerer->currentProgressCount());
+}
+
 TEST_F(TrackExporterTest, OverwriteSkip) {
     // Export a tracklist with two existing tracks -- overwrite one and skip
     // the other.
@@ -86,9 +142,9 @@ TEST_F(TrackExporterTest, OverwriteSkip) {
     file2.close();
 
     // Set up the worker and answerer.
-    TrackPointerList tracks;
-    tracks.append(track1);
-    tracks.append(track2);
+    TrackSnapshotList tracks;
+    tracks.append(TrackSnapshot::fromTrack(*track1));
+    tracks.append(TrackSnapshot::fromTrack(*track2));
     TrackExportWorker worker(m_exportDir.canonicalPath(), tracks);
     m_answerer.reset(new FakeOverwriteAnswerer(&worker));
     m_answerer->setAnswer(QFileInfo(file1).canonicalFilePath(),
@@ -132,9 +188,9 @@ TEST_F(TrackExporterTest, OverwriteAll) {
     file2.close();
 
     // Set up the worker and answerer.
-    TrackPointerList tracks;
-    tracks.append(track1);
-    tracks.append(track2);
+    TrackSnapshotList tracks;
+    tracks.append(TrackSnapshot::fromTrack(*track1));
+    tracks.append(TrackSnapshot::fromTrack(*track2));
     TrackExportWorker worker(m_exportDir.canonicalPath(), tracks);
     m_answerer.reset(new FakeOverwriteAnswerer(&worker));
     m_answerer->setAnswer(QFileInfo(file2).canonicalFilePath(),
@@ -156,6 +212,46 @@ TEST_F(TrackExporterTest, OverwriteAll) {
     EXPECT_EQ(fileSize2, newfile2.size());
 }
 
+TEST_F(TrackExporterTest, SkipIdentical) {
+    // Resume an interrupted export -- files that have already been copied
+    // are skipped without asking, the others are overwritten.
+    mixxx::FileInfo fileinfo1(m_testDataDir.filePath("cover-test.ogg"));
+    TrackPointer track1(Track::newTemporary(mixxx::FileAccess(fileinfo1)));
+    mixxx::FileInfo fileinfo2(m_testDataDir.filePath("cover-test-itunes-12.3.0-aac.m4a"));
+    const qint64 fileSize2 = fileinfo2.sizeInBytes();
+    TrackPointer track2(Track::newTemporary(mixxx::FileAccess(fileinfo2)));
+
+    ASSERT_TRUE(QFile::copy(fileinfo1.location(), m_exportDir.filePath("cover-test.ogg")));
+    const QDateTime lastModified1 =
+            QFileInfo(m_exportDir.filePath("cover-test.ogg")).lastModified();
+    QFile file2(m_exportDir.filePath("cover-test-itunes-12.3.0-aac.m4a"));
+    ASSERT_TRUE(file2.open(QIODevice::WriteOnly));
+    file2.close();
+
+    // Set up the worker and answerer.
+    TrackSnapshotList tracks;
+    tracks.append(TrackSnapshot::fromTrack(*track1));
+    tracks.append(TrackSnapshot::fromTrack(*track2));
+    TrackExportWorker worker(m_exportDir.canonicalPath(), tracks, 2);
+    m_answerer.reset(new FakeOverwriteAnswerer(&worker));
+    m_answerer->setAnswer(QFileInfo(file2).canonicalFilePath(),
+                           TrackExportWorker::OverwriteAnswer::OVERWRITE);
+
+    worker.run();
+    EXPECT_TRUE(worker.wait(10000));
+
+    EXPECT_EQ(2, m_answerer->currentProgress());
+    EXPECT_EQ(2, m_answerer->currentProgressCount());
+
+    // The identical file has not been touched.
+    QFileInfo newfile1(m_exportDir.filePath("cover-test.ogg"));
+    EXPECT_EQ(lastModified1, newfile1.lastModified());
+
+    QFileInfo newfile2(m_exportDir.filePath("cover-test-itunes-12.3.0-aac.m4a"));
+    EXPECT_TRUE(newfile2.exists());
+    EXPECT_EQ(fileSize2, newfile2.size());
+}
+
 TEST_F(TrackExporterTest, SkipAll) {
     // Export a tracklist with two existing tracks -- skip both.
     mixxx::FileInfo fileinfo1(m_testDataDir.filePath("cover-test.ogg"));
@@ -173,9 +269,9 @@ TEST_F(TrackExporterTest, SkipAll) {
     file2.close();
 
     // Set up the worker and answerer.
-    TrackPointerList tracks;
-    tracks.append(track1);
-    tracks.append(track2);
+    TrackSnapshotList tracks;
+    tracks.append(TrackSnapshot::fromTrack(*track1));
+    tracks.append(TrackSnapshot::fromTrack(*track2));
     TrackExportWorker worker(m_exportDir.canonicalPath(), tracks);
     m_answerer.reset(new FakeOverwriteAnswerer(&worker));
     m_answerer->setAnswer(QFileInfo(file2).canonicalFilePath(),
@@ -212,9 +308,9 @@ TEST_F(TrackExporterTest, Cancel) {
     file2.close();
 
     // Set up the worker and answerer.
-    TrackPointerList tracks;
-    tracks.append(track1);
-    tracks.append(track2);
+    TrackSnapshotList tracks;
+    tracks.append(TrackSnapshot::fromTrack(*track1));
+    tracks.append(TrackSnapshot::fromTrack(*track2));
     TrackExportWorker worker(m_exportDir.canonicalPath(), tracks);
     m_answerer.reset(new FakeOverwriteAnswerer(&worker));
     m_answerer->setAnswer(QFileInfo(file2).canonicalFilePath(),
@@ -243,9 +339,9 @@ TEST_F(TrackExporterTest, DedupeList) {
     TrackPointer track2(Track::newTemporary(mixxx::FileAccess(fileinfo1)));
 
     // Set up the worker and answerer.
-    TrackPointerList tracks;
-    tracks.append(track1);
-    tracks.append(track2);
+    TrackSnapshotList tracks;
+    tracks.append(TrackSnapshot::fromTrack(*track1));
+    tracks.append(TrackSnapshot::fromTrack(*track2));
     TrackExportWorker worker(m_exportDir.canonicalPath(), tracks);
     m_answerer.reset(new FakeOverwriteAnswerer(&worker));
 
@@ -280,9 +376,9 @@ TEST_F(TrackExporterTest, MungeFilename) {
     TrackPointer track2(Track::newTemporary(mixxx::FileAccess(fileinfo2)));
 
     // Set up the worker and answerer.
-    TrackPointerList tracks;
-    tracks.append(track1);
-    tracks.append(track2);
+    TrackSnapshotList tracks;
+    tracks.append(TrackSnapshot::fromTrack(*track1));
+    tracks.append(TrackSnapshot::fromTrack(*track2));
     TrackExportWorker worker(m_exportDir.canonicalPath(), tracks);
     m_answerer.reset(new FakeOverwriteAnswerer(&worker));
 
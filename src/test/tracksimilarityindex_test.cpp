@@ -0,0 +1,183 @@
+#include "library/autodj/tracksimilarityindex.h"
+
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QHash>
+#include <QRandomGenerator>
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+using mixxx::track::io::key::ChromaticKey;
+
+TrackSimilarityIndex::Features makeFeatures(
+        double bpm,
+        ChromaticKey key = mixxx::track::io::key::A_MINOR,
+        double replayGainRatio = 1.0,
+        double durationSeconds = 300.0) {
+    TrackSimilarityIndex::Features features;
+    features.bpm = bpm;
+    features.key = key;
+    features.replayGainRatio = replayGainRatio;
+    features.durationSeconds = durationSeconds;
+    return features;
+}
+
+TrackSimilarityIndex::Features randomFeatures(QRandomGenerator* pRandom) {
+    TrackSimilarityIndex::Features features;
+    // Some tracks have not been analyzed yet
+    if (pRandom->bounded(20) != 0) {
+        features.bpm = 60.0 + pRandom->bounded(120.0);
+        features.key = static_cast<ChromaticKey>(pRandom->bounded(1, 25));
+        features.replayGainRatio = 0.25 + pRandom->bounded(1.75);
+    }
+    features.durationSeconds = 60.0 + pRandom->bounded(540.0);
+    return features;
+}
+
+class TrackSimilarityIndexTest : public testing::Test {
+  protected:
+    TrackId insert(const TrackSimilarityIndex::Features& features) {
+        const TrackId trackId(static_cast<int>(m_features.size()) + 1);
+        m_index.insert(trackId, features);
+        m_features.insert(trackId, features);
+        return trackId;
+    }
+
+    // The distances of the closest tracks computed without the index
+    std::vector<float> bruteForceDistances(
+            TrackId referenceTrackId, int maxCount) const {
+        std::vector<float> distances;
+        for (auto it = m_features.constBegin(); it != m_features.constEnd(); ++it) {
+            if (it.key() != referenceTrackId && m_index.contains(it.key())) {
+                distances.push_back(TrackSimilarityIndex::distance(
+                        it.value(), m_features.value(referenceTrackId)));
+            }
+        }
+        std::sort(distances.begin(), distances.end());
+        distances.resize(std::min(distances.size(), static_cast<std::size_t>(maxCount)));
+        return distances;
+    }
+
+    std::vector<float> indexDistances(TrackId referenceTrackId, int maxCount) const {
+        std::vector<float> distances;
+        for (const auto& trackId : m_index.nearest(referenceTrackId, maxCount)) {
+            distances.push_back(TrackSimilarityIndex::distance(
+                    m_features.value(trackId), m_features.value(referenceTrackId)));
+        }
+        return distances;
+    }
+
+    TrackSimilarityIndex m_index;
+    QHash<TrackId, TrackSimilarityIndex::Features> m_features;
+};
+
+TEST_F(TrackSimilarityIndexTest, Distance) {
+    const auto reference = makeFeatures(128.0);
+    EXPECT_EQ(0.0f, TrackSimilarityIndex::distance(reference, reference));
+    // Tempo
+    EXPECT_LT(TrackSimilarityIndex::distance(makeFeatures(129.0), reference),
+            TrackSimilarityIndex::distance(makeFeatures(132.0), reference));
+    // Half tempo is closer than a large deviation
+    EXPECT_LT(TrackSimilarityIndex::distance(makeFeatures(64.0), reference),
+            TrackSimilarityIndex::distance(makeFeatures(100.0), reference));
+    // Compatible key
+    EXPECT_LT(TrackSimilarityIndex::distance(
+                      makeFeatures(128.0, mixxx::track::io::key::C_MAJOR),
+                      reference),
+            TrackSimilarityIndex::distance(
+                    makeFeatures(128.0, mixxx::track::io::key::F_SHARP_MAJOR),
+                    reference));
+    // Loudness
+    EXPECT_LT(TrackSimilarityIndex::distance(
+                      makeFeatures(128.0, mixxx::track::io::key::A_MINOR, 1.1),
+                      reference),
+            TrackSimilarityIndex::distance(
+                    makeFeatures(128.0, mixxx::track::io::key::A_MINOR, 2.0),
+                    reference));
+    // Duration
+    EXPECT_LT(TrackSimilarityIndex::distance(
+                      makeFeatures(128.0, mixxx::track::io::key::A_MINOR, 1.0, 330.0),
+                      reference),
+            TrackSimilarityIndex::distance(
+                    makeFeatures(128.0, mixxx::track::io::key::A_MINOR, 1.0, 90.0),
+                    reference));
+}
+
+TEST_F(TrackSimilarityIndexTest, Nearest) {
+    const TrackId reference = insert(makeFeatures(128.0));
+    const TrackId sameKey = insert(makeFeatures(127.5));
+    const TrackId compatibleKey = insert(makeFeatures(128.0, mixxx::track::io::key::E_MINOR));
+    const TrackId doubleTempo = insert(makeFeatures(256.0));
+    const TrackId unknownTempo = insert(makeFeatures(0.0));
+    insert(makeFeatures(90.0, mixxx::track::io::key::E_FLAT_MAJOR));
+
+    EXPECT_EQ(QList<TrackId>({sameKey, compatibleKey, doubleTempo, unknownTempo}),
+            m_index.nearest(reference, 4));
+    EXPECT_EQ(QList<TrackId>({compatibleKey, unknownTempo}),
+            m_index.nearest(reference, 2, QSet<TrackId>({sameKey, doubleTempo})));
+    EXPECT_EQ(QList<TrackId>({sameKey}), m_index.nearest(makeFeatures(127.5), 1));
+    EXPECT_TRUE(m_index.nearest(TrackId(1000), 4).isEmpty());
+}
+
+TEST_F(TrackSimilarityIndexTest, UpdateAndRemove) {
+    const TrackId reference = insert(makeFeatures(128.0));
+    const TrackId first = insert(makeFeatures(128.0));
+    const TrackId second = insert(makeFeatures(140.0));
+    EXPECT_EQ(3, m_index.size());
+    EXPECT_EQ(QList<TrackId>({first, second}), m_index.nearest(reference, 2));
+
+    // Moves both tracks into different buckets
+    m_index.insert(first, makeFeatures(150.0));
+    m_index.insert(second, makeFeatures(129.0));
+    EXPECT_EQ(3, m_index.size());
+    EXPECT_EQ(QList<TrackId>({second, first}), m_index.nearest(reference, 2));
+
+    m_index.remove(second);
+    EXPECT_EQ(2, m_index.size());
+    EXPECT_FALSE(m_index.contains(second));
+    EXPECT_EQ(QList<TrackId>({first}), m_index.nearest(reference, 2));
+
+    m_index.clear();
+    EXPECT_EQ(0, m_index.size());
+    EXPECT_TRUE(m_index.nearest(reference, 2).isEmpty());
+}
+
+TEST_F(TrackSimilarityIndexTest, MatchesBruteForce) {
+    QRandomGenerator random(42);
+    std::vector<TrackId> trackIds;
+    for (int i = 0; i < 5000; ++i) {
+        trackIds.push_back(insert(randomFeatures(&random)));
+    }
+    // Leave gaps in the buckets
+    for (int i = 0; i < 500; ++i) {
+        m_index.remove(trackIds[random.bounded(static_cast<int>(trackIds.size()))]);
+    }
+    for (int i = 0; i < 50; ++i) {
+        const TrackId referenceTrackId =
+                trackIds[random.bounded(static_cast<int>(trackIds.size()))];
+        if (!m_index.contains(referenceTrackId)) {
+            continue;
+        }
+        EXPECT_EQ(bruteForceDistances(referenceTrackId, 10),
+                indexDistances(referenceTrackId, 10));
+    }
+}
+
+} // namespace
+
+static void BM_TrackSimilarityIndexNearest(benchmark::State& state) {
+    QRandomGenerator random(42);
+    TrackSimilarityIndex index;
+    const int trackCount = static_cast<int>(state.range(0));
+    for (int i = 0; i < trackCount; ++i) {
+        index.insert(TrackId(i + 1), randomFeatures(&random));
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+                index.nearest(TrackId(random.bounded(trackCount) + 1), 5));
+    }
+}
+BENCHMARK(BM_TrackSimilarityIndexNearest)->Range(1000, 128000);
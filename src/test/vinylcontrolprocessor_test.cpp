@@ -0,0 +1,141 @@
+#include "vinylcontrol/vinylcontrolprocessor.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "control/controlobject.h"
+#include "test/mixxxtest.h"
+#include "test/timecodesignal.h"
+#include "vinylcontrol/defs_vinylcontrol.h"
+
+namespace {
+
+constexpr int kSampleRate = 44100;
+constexpr int kChannels = 2;
+constexpr int kBufferFrames = 256;
+const QString kGroup = QStringLiteral("[Channel1]");
+
+const char* const kDeckControls[] = {
+        "playposition",
+        "track_samples",
+        "track_samplerate",
+        "duration",
+        "play",
+        "rate_ratio",
+        "reverse",
+        "loop_enabled",
+        "vinylcontrol_seek",
+        "vinylcontrol_rate",
+        "vinylcontrol_mode",
+        "vinylcontrol_enabled",
+        "vinylcontrol_wantenabled",
+        "vinylcontrol_cueing",
+        "vinylcontrol_scratching",
+        "vinylcontrol_status",
+        "vinylcontrol_signal_enabled",
+};
+
+class VinylControlProcessorTest : public MixxxTest {
+  protected:
+    void SetUp() override {
+        for (const char* item : kDeckControls) {
+            m_controls.push_back(std::make_unique<ControlObject>(ConfigKey(kGroup, item)));
+        }
+        m_controls.push_back(std::make_unique<ControlObject>(
+                ConfigKey(VINYL_PREF_KEY, "gain")));
+
+        // A loaded track of 5 minutes that is paused in the middle
+        constexpr double kDuration = 300;
+        ControlObject::set(ConfigKey(kGroup, "duration"), kDuration);
+        ControlObject::set(ConfigKey(kGroup, "track_samplerate"), kSampleRate);
+        ControlObject::set(ConfigKey(kGroup, "track_samples"),
+                kDuration * kSampleRate * kChannels);
+        ControlObject::set(ConfigKey(kGroup, "playposition"), 0.5);
+        ControlObject::set(ConfigKey(kGroup, "vinylcontrol_mode"), MIXXX_VCMODE_RELATIVE);
+        ControlObject::set(ConfigKey(kGroup, "vinylcontrol_enabled"), 1.0);
+
+        config()->set(ConfigKey("[Soundcard]", "Samplerate"), ConfigValue(kSampleRate));
+        config()->set(ConfigKey(kGroup, "vinylcontrol_vinyl_type"),
+                ConfigValue(QStringLiteral(MIXXX_VINYL_SERATOCV02VINYLSIDEA)));
+        config()->set(ConfigKey(kGroup, "vinylcontrol_analyze_in_callback"), ConfigValue(1));
+
+        m_pDef = timecoder_find_definition(MIXXX_VINYL_SERATOCV02VINYLSIDEA_XWAX_NAME);
+        ASSERT_NE(nullptr, m_pDef);
+        m_pProcessor = std::make_unique<VinylControlProcessor>(nullptr, config());
+        m_pProcessor->onInputConfigured(m_input);
+    }
+
+    void TearDown() override {
+        m_pProcessor.reset();
+        m_controls.clear();
+    }
+
+    /// Pushes the samples to the processor like the engine callback,
+    /// returns the vinyl control rate that the engine would apply
+    /// when processing the deck in the same callback.
+    double processCallback(const CSAMPLE* pBuffer) {
+        m_pProcessor->receiveBuffer(m_input, pBuffer, kBufferFrames);
+        return ControlObject::get(ConfigKey(kGroup, "vinylcontrol_rate"));
+    }
+
+    const AudioInput m_input = AudioInput(AudioInput::VINYLCONTROL, 0, kChannels, 0);
+    timecode_def* m_pDef;
+    std::vector<std::unique_ptr<ControlObject>> m_controls;
+    std::unique_ptr<VinylControlProcessor> m_pProcessor;
+};
+
+TEST_F(VinylControlProcessorTest, AnalyzeInCallbackAddsNoLatency) {
+    // The needle is dropped on a record that spins at the regular speed
+    constexpr double kRate = 1.0;
+    // The applied rate is the average of the recent pitches of the decoder,
+    // rounded and corrected by the drift of the position. It only follows
+    // the pitch of the decoder within this tolerance.
+    constexpr double kPitchTolerance = 0.05;
+    constexpr int kSilentBuffers = 8;
+    constexpr int kSignalBuffers = kSampleRate / kBufferFrames;
+    const std::vector<CSAMPLE> silence(kBufferFrames * kChannels, 0);
+    const std::vector<float> signal = mixxxtest::synthesizeTimecode(
+            *m_pDef, kSampleRate, kRate, kSignalBuffers * kBufferFrames);
+
+    // The same decoder without any buffering in between
+    timecoder reference;
+    timecoder_init(&reference, m_pDef, 1.0, kSampleRate, false);
+
+    for (int i = 0; i < kSilentBuffers; ++i) {
+        EXPECT_EQ(0.0, processCallback(silence.data()));
+        timecoder_submit_float(&reference, silence.data(), kBufferFrames, 1.0f);
+    }
+
+    int latencyFrames = -1;
+    int referenceLatencyFrames = -1;
+    for (int i = 0; i < kSignalBuffers; ++i) {
+        const CSAMPLE* pBuffer = signal.data() + i * kBufferFrames * kChannels;
+        const double rate = processCallback(pBuffer);
+        timecoder_submit_float(&reference, pBuffer, kBufferFrames, 1.0f);
+        const double referencePitch = timecoder_get_pitch(&reference);
+        if (referenceLatencyFrames < 0 &&
+                std::abs(referencePitch - kRate) < kPitchTolerance) {
+            referenceLatencyFrames = (i + 1) * kBufferFrames;
+        }
+        if (latencyFrames < 0 && std::abs(rate - kRate) < kPitchTolerance) {
+            latencyFrames = (i + 1) * kBufferFrames;
+        }
+        // The pitch of all samples up to and including this buffer applies
+        // in this callback
+        if (referenceLatencyFrames >= 0) {
+            EXPECT_NEAR(referencePitch, rate, kPitchTolerance);
+        }
+    }
+    timecoder_clear(&reference);
+
+    RecordProperty("latency_frames", latencyFrames);
+    ASSERT_GE(referenceLatencyFrames, 0);
+    ASSERT_GE(latencyFrames, 0);
+    // Only the settling time of the pitch filter in the decoder remains
+    EXPECT_LE(latencyFrames, kSampleRate / 20);
+}
+
+} // namespace
@@ -1,5 +1,7 @@
 #include "track/beats.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <iterator>
 #include <vector>
@@ -20,6 +22,27 @@ struct BeatGridV1Data {
 
 constexpr double kEpsilon = 0.01;
 
+// Cursors step at most this many beats before falling back to a search
+constexpr int kMaxCursorSteps = 4;
+
+mixxx::audio::FramePos closestBeat(mixxx::audio::FramePos position,
+        mixxx::audio::FramePos prevBeatPosition,
+        mixxx::audio::FramePos nextBeatPosition) {
+    if (!prevBeatPosition.isValid()) {
+        // If both positions are invalid, we correctly return an invalid position.
+        return nextBeatPosition;
+    }
+
+    if (!nextBeatPosition.isValid()) {
+        return prevBeatPosition;
+    }
+
+    // Both position are valid, return the closest position.
+    return (nextBeatPosition - position > position - prevBeatPosition)
+            ? prevBeatPosition
+            : nextBeatPosition;
+}
+
 } // namespace
 
 namespace mixxx {
@@ -379,7 +402,18 @@ bool Beats::findPrevNextBeats(audio::FramePos position,
         audio::FramePos* prevBeatPosition,
         audio::FramePos* nextBeatPosition,
         bool snapToNearBeats) const {
-    auto it = iteratorFrom(position);
+    return findPrevNextBeats(iteratorFrom(position),
+            position,
+            prevBeatPosition,
+            nextBeatPosition,
+            snapToNearBeats);
+}
+
+bool Beats::findPrevNextBeats(ConstIterator it,
+        audio::FramePos position,
+        audio::FramePos* prevBeatPosition,
+        audio::FramePos* nextBeatPosition,
+        bool snapToNearBeats) const {
     if (it == cend()) {
         *prevBeatPosition = *it;
         *nextBeatPosition = audio::kInvalidFramePos;
@@ -444,7 +478,12 @@ Beats::ConstIterator Beats::iteratorFrom(audio::FramePos position) const {
         }
         it -= static_cast<int>(n);
     } else {
-        it = std::lower_bound(cfirstmarker(), clastmarker() + 1, position);
+        // Lookup position is between the first and the last marker position
+        const auto beatPositionIt = std::lower_bound(
+                m_markerBeatPositions.cbegin(), m_markerBeatPositions.cend(), position);
+        DEBUG_ASSERT(beatPositionIt != m_markerBeatPositions.cend());
+        it = iteratorAtMarkerBeat(
+                static_cast<int>(beatPositionIt - m_markerBeatPositions.cbegin()));
     }
     DEBUG_ASSERT(it == cbegin() || it == cend() || *it >= position);
     DEBUG_ASSERT(it == cbegin() || it == cend() ||
@@ -457,7 +496,11 @@ audio::FramePos Beats::findNthBeat(audio::FramePos position, int n) const {
         return audio::kInvalidFramePos;
     }
 
-    auto it = iteratorFrom(position);
+    return findNthBeat(iteratorFrom(position), position, n);
+}
+
+audio::FramePos Beats::findNthBeat(ConstIterator it, audio::FramePos position, int n) const {
+    DEBUG_ASSERT(n != 0);
     const bool searchForward = n > 0;
     if (searchForward) {
         n--;
@@ -577,8 +620,11 @@ mixxx::Bpm Beats::getBpmAroundPosition(audio::FramePos position, int n) const {
         return m_lastMarkerBpm;
     }
 
-    auto it = iteratorFrom(position);
+    return getBpmAroundPosition(iteratorFrom(position), n);
+}
 
+mixxx::Bpm Beats::getBpmAroundPosition(ConstIterator it, int n) const {
+    DEBUG_ASSERT(!m_markers.empty());
     // To make sure we are always counting n beats, iterate backward to the
     // lower bound, then iterate forward from there to the upper bound.
     it -= n;
@@ -692,6 +738,39 @@ mixxx::audio::FrameDiff_t Beats::lastBeatLengthFrames() const {
     return 60.0 * m_sampleRate / m_lastMarkerBpm.value();
 }
 
+void Beats::initBeatPositions() {
+    m_markerBeatIndices.reserve(m_markers.size() + 1);
+    int beatIndex = 0;
+    for (const BeatMarker& marker : m_markers) {
+        m_markerBeatIndices.push_back(beatIndex);
+        beatIndex += marker.beatsTillNextMarker();
+    }
+    m_markerBeatIndices.push_back(beatIndex);
+
+    // Use the iterator for calculating the positions to get exactly the same
+    // values as the iterators returned by the lookups.
+    m_markerBeatPositions.reserve(beatIndex + 1);
+    for (auto it = cfirstmarker(); it != clastmarker() + 1; it++) {
+        m_markerBeatPositions.push_back(*it);
+    }
+    DEBUG_ASSERT(m_markerBeatPositions.size() == m_markerBeatIndices.back() + 1u);
+}
+
+// static
+quint64 Beats::nextId() {
+    static std::atomic<quint64> s_nextId(1);
+    return s_nextId.fetch_add(1, std::memory_order_relaxed);
+}
+
+Beats::ConstIterator Beats::iteratorAtMarkerBeat(int beatIndex) const {
+    DEBUG_ASSERT(beatIndex >= 0 && beatIndex <= m_markerBeatIndices.back());
+    // The last marker with a beat index less than or equal to beatIndex
+    const auto indexIt = std::prev(std::upper_bound(
+            m_markerBeatIndices.cbegin(), m_markerBeatIndices.cend(), beatIndex));
+    const auto markerIndex = indexIt - m_markerBeatIndices.cbegin();
+    return ConstIterator(this, m_markers.cbegin() + markerIndex, beatIndex - *indexIt);
+}
+
 audio::FramePos Beats::snapPosToNearBeat(audio::FramePos position) const {
     audio::FramePos prevBeatPosition;
     audio::FramePos nextBeatPosition;
@@ -735,19 +814,78 @@ audio::FramePos Beats::findClosestBeat(audio::FramePos position) const {
     audio::FramePos prevBeatPosition;
     audio::FramePos nextBeatPosition;
     findPrevNextBeats(position, &prevBeatPosition, &nextBeatPosition, false);
-    if (!prevBeatPosition.isValid()) {
-        // If both positions are invalid, we correctly return an invalid position.
-        return nextBeatPosition;
+    return closestBeat(position, prevBeatPosition, nextBeatPosition);
+}
+
+Beats::ConstIterator Beats::Cursor::iteratorFrom(audio::FramePos position) {
+    DEBUG_ASSERT(m_pBeats);
+    if (m_it) {
+        // Step to the beat at or after the position, which is usually the
+        // same or the next beat as for the previous lookup.
+        const auto cbegin = m_pBeats->cbegin();
+        const auto cend = m_pBeats->cend();
+        auto it = *m_it;
+        for (int step = 0; step <= kMaxCursorSteps; ++step) {
+            if (it == cbegin || it == cend) {
+                break;
+            }
+            if (*it < position) {
+                ++it;
+                continue;
+            }
+            if (*std::prev(it) >= position) {
+                --it;
+                continue;
+            }
+            m_it = it;
+            return it;
+        }
     }
+    m_it = m_pBeats->iteratorFrom(position);
+    return *m_it;
+}
 
-    if (!nextBeatPosition.isValid()) {
-        return prevBeatPosition;
+bool Beats::Cursor::findPrevNextBeats(audio::FramePos position,
+        audio::FramePos* prevBeatPosition,
+        audio::FramePos* nextBeatPosition,
+        bool snapToNearBeats) {
+    VERIFY_OR_DEBUG_ASSERT(m_pBeats) {
+        *prevBeatPosition = audio::kInvalidFramePos;
+        *nextBeatPosition = audio::kInvalidFramePos;
+        return false;
+    }
+    return m_pBeats->findPrevNextBeats(iteratorFrom(position),
+            position,
+            prevBeatPosition,
+            nextBeatPosition,
+            snapToNearBeats);
+}
+
+audio::FramePos Beats::Cursor::findClosestBeat(audio::FramePos position) {
+    if (!m_pBeats || !m_pBeats->isValid()) {
+        return audio::kInvalidFramePos;
     }
+    audio::FramePos prevBeatPosition;
+    audio::FramePos nextBeatPosition;
+    findPrevNextBeats(position, &prevBeatPosition, &nextBeatPosition, false);
+    return closestBeat(position, prevBeatPosition, nextBeatPosition);
+}
 
-    // Both position are valid, return the closest position.
-    return (nextBeatPosition - position > position - prevBeatPosition)
-            ? prevBeatPosition
-            : nextBeatPosition;
+audio::FramePos Beats::Cursor::findNthBeat(audio::FramePos position, int n) {
+    if (!m_pBeats || n == 0) {
+        return audio::kInvalidFramePos;
+    }
+    return m_pBeats->findNthBeat(iteratorFrom(position), position, n);
+}
+
+mixxx::Bpm Beats::Cursor::getBpmAroundPosition(audio::FramePos position, int n) {
+    if (!m_pBeats) {
+        return {};
+    }
+    if (m_pBeats->m_markers.empty()) {
+        return m_pBeats->m_lastMarkerBpm;
+    }
+    return m_pBeats->getBpmAroundPosition(iteratorFrom(position), n);
 }
 
 } // namespace mixxx
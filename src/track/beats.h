@@ -151,6 +151,75 @@ class Beats : private std::enable_shared_from_this<Beats> {
         int m_beatOffset;
     };
 
+    /// A cursor remembers the beat found by the last lookup, so that lookups
+    /// at nearby positions only need to step to the neighboring beats instead
+    /// of searching all beats again. This makes lookups at the play position,
+    /// which moves a little in every engine callback, O(1) amortized.
+    ///
+    /// Results are identical to the corresponding functions of Beats. A cursor
+    /// is not thread-safe and should be owned by a single consumer.
+    ///
+    /// The cursor does not keep the beats alive, so it never releases them
+    /// in the engine thread. The owner must hold a reference to the beats
+    /// and pass them to setBeats() before each lookup.
+    class Cursor {
+      public:
+        Cursor() = default;
+        explicit Cursor(const Beats* pBeats) {
+            setBeats(pBeats);
+        }
+
+        const Beats* getBeats() const {
+            return m_pBeats;
+        }
+
+        /// Binds the cursor to `pBeats`. The remembered beat is kept if
+        /// the cursor is already bound to the same beats. Beats that are
+        /// allocated at the address of released beats are distinguished
+        /// by their id.
+        void setBeats(const Beats* pBeats) {
+            const quint64 beatsId = pBeats ? pBeats->m_id : 0;
+            if (m_pBeats != pBeats || m_beatsId != beatsId) {
+                m_pBeats = pBeats;
+                m_beatsId = beatsId;
+                m_it.reset();
+            }
+        }
+
+        /// See Beats::findNextBeat()
+        audio::FramePos findNextBeat(audio::FramePos position) {
+            return findNthBeat(position, 1);
+        }
+
+        /// See Beats::findPrevBeat()
+        audio::FramePos findPrevBeat(audio::FramePos position) {
+            return findNthBeat(position, -1);
+        }
+
+        /// See Beats::findPrevNextBeats()
+        bool findPrevNextBeats(audio::FramePos position,
+                audio::FramePos* prevBeatPosition,
+                audio::FramePos* nextBeatPosition,
+                bool snapToNearBeats);
+
+        /// See Beats::findClosestBeat()
+        audio::FramePos findClosestBeat(audio::FramePos position);
+
+        /// See Beats::findNthBeat()
+        audio::FramePos findNthBeat(audio::FramePos position, int n);
+
+        /// See Beats::getBpmAroundPosition()
+        mixxx::Bpm getBpmAroundPosition(audio::FramePos position, int n);
+
+      private:
+        ConstIterator iteratorFrom(audio::FramePos position);
+
+        const Beats* m_pBeats = nullptr;
+        quint64 m_beatsId = 0;
+        // The first beat at or after the position of the last lookup
+        std::optional<ConstIterator> m_it;
+    };
+
     Beats(std::vector<BeatMarker> markers,
             mixxx::audio::FramePos lastMarkerPosition,
             mixxx::Bpm lastMarkerBpm,
@@ -165,6 +234,7 @@ class Beats : private std::enable_shared_from_this<Beats> {
         DEBUG_ASSERT(!m_lastMarkerPosition.isFractional());
         DEBUG_ASSERT(m_lastMarkerBpm.isValid());
         DEBUG_ASSERT(m_sampleRate.isValid());
+        initBeatPositions();
     }
 
     Beats(mixxx::audio::FramePos lastMarkerPosition,
@@ -427,13 +497,36 @@ class Beats : private std::enable_shared_from_this<Beats> {
     mixxx::audio::FrameDiff_t firstBeatLengthFrames() const;
     mixxx::audio::FrameDiff_t lastBeatLengthFrames() const;
 
+    void initBeatPositions();
+    ConstIterator iteratorAtMarkerBeat(int beatIndex) const;
+    static quint64 nextId();
+
+    // The lookups starting at the iterator `it` returned by
+    // iteratorFrom(position), shared with Cursor
+    bool findPrevNextBeats(ConstIterator it,
+            audio::FramePos position,
+            audio::FramePos* prevBeatPosition,
+            audio::FramePos* nextBeatPosition,
+            bool snapToNearBeats) const;
+    audio::FramePos findNthBeat(ConstIterator it, audio::FramePos position, int n) const;
+    mixxx::Bpm getBpmAroundPosition(ConstIterator it, int n) const;
+
     std::vector<BeatMarker> m_markers;
     mixxx::audio::FramePos m_lastMarkerPosition;
     mixxx::Bpm m_lastMarkerBpm;
     mixxx::audio::SampleRate m_sampleRate;
 
+    // Precomputed positions of all beats from the first to the last marker
+    // for a binary search instead of iterating over the markers, and the
+    // index of the beat at each marker, including the last marker.
+    std::vector<mixxx::audio::FramePos> m_markerBeatPositions;
+    std::vector<int> m_markerBeatIndices;
+
     // The sub-version of this beatgrid.
     const QString m_subVersion;
+
+    // Unique for each instance, used by Cursor
+    const quint64 m_id = nextId();
 };
 
 } // namespace mixxx
@@ -6,6 +6,7 @@
 #include "track/track.h"
 #include "util/assert.h"
 #include "util/logger.h"
+#include "util/performancetimer.h"
 #include "util/thread_affinity.h"
 
 namespace {
@@ -113,7 +114,28 @@ void GlobalTrackCacheLocker::lockCache() {
     if (traceLogEnabled()) {
         kLogger.trace() << "Locking cache";
     }
-    s_pInstance->m_mutex.lock();
+    if (s_pInstance->m_mutex.tryLock()) {
+        ++s_pInstance->m_lockStats.lockCount;
+    } else {
+        PerformanceTimer timer;
+        timer.start();
+        s_pInstance->m_mutex.lock();
+        const auto waitDuration = timer.elapsed();
+        // The statistics are protected by the mutex itself
+        auto& lockStats = s_pInstance->m_lockStats;
+        ++lockStats.lockCount;
+        ++lockStats.contendedLockCount;
+        lockStats.totalWaitDuration += waitDuration;
+        if (lockStats.maxWaitDuration < waitDuration) {
+            lockStats.maxWaitDuration = waitDuration;
+        }
+        if (traceLogEnabled()) {
+            kLogger.trace()
+                    << "Waited"
+                    << waitDuration.formatMicrosWithUnit()
+                    << "for locking the cache";
+        }
+    }
     if (traceLogEnabled()) {
         kLogger.trace() << "Cache is locked";
     }
@@ -178,11 +200,30 @@ QSet<TrackId> GlobalTrackCacheLocker::getCachedTrackIds() const {
     return m_pInstance->getCachedTrackIds();
 }
 
+GlobalTrackCacheLookupResult GlobalTrackCacheLocker::resolveTrack(
+        TrackPointer* pTrack,
+        TrackRef* pTrackRef,
+        mixxx::FileAccess fileAccess,
+        TrackId trackId) const {
+    DEBUG_ASSERT(m_pInstance);
+    // Tracks without an id need to be resolved by GlobalTrackCacheResolver
+    // that keeps the cache locked until the id has been initialized.
+    DEBUG_ASSERT(trackId.isValid());
+    return m_pInstance->resolve(
+            pTrack,
+            pTrackRef,
+            std::move(fileAccess),
+            std::move(trackId));
+}
+
+GlobalTrackCacheLockStats GlobalTrackCacheLocker::getLockStats() const {
+    DEBUG_ASSERT(m_pInstance);
+    return m_pInstance->m_lockStats;
+}
+
 GlobalTrackCacheResolver::GlobalTrackCacheResolver(
         mixxx::FileAccess fileAccess)
-        : m_lookupResult(GlobalTrackCacheLookupResult::None) {
-    DEBUG_ASSERT(m_pInstance);
-    m_pInstance->resolve(this, std::move(fileAccess), TrackId());
+        : GlobalTrackCacheResolver(std::move(fileAccess), TrackId()) {
 }
 
 GlobalTrackCacheResolver::GlobalTrackCacheResolver(
@@ -190,7 +231,19 @@ GlobalTrackCacheResolver::GlobalTrackCacheResolver(
         TrackId trackId)
         : m_lookupResult(GlobalTrackCacheLookupResult::None) {
     DEBUG_ASSERT(m_pInstance);
-    m_pInstance->resolve(this, std::move(fileAccess), std::move(trackId));
+    TrackPointer strongPtr;
+    TrackRef trackRef;
+    const auto lookupResult = m_pInstance->resolve(
+            &strongPtr,
+            &trackRef,
+            std::move(fileAccess),
+            std::move(trackId));
+    if (lookupResult != GlobalTrackCacheLookupResult::None) {
+        initLookupResult(
+                lookupResult,
+                std::move(strongPtr),
+                std::move(trackRef));
+    }
 }
 
 void GlobalTrackCacheResolver::initLookupResult(
@@ -394,6 +447,17 @@ void GlobalTrackCache::saveEvictedTrack(Track* pEvictedTrack) const {
 void GlobalTrackCache::deactivate() {
     DEBUG_ASSERT_QOBJECT_THREAD_AFFINITY(this);
 
+    kLogger.info()
+            << "Locked cache"
+            << m_lockStats.lockCount
+            << "times,"
+            << m_lockStats.contendedLockCount
+            << "contended, waited"
+            << m_lockStats.totalWaitDuration.formatMillisWithUnit()
+            << "in total and"
+            << m_lockStats.maxWaitDuration.formatMillisWithUnit()
+            << "at most";
+
     if (isEmpty()) {
         return;
     }
@@ -556,11 +620,13 @@ TrackPointer GlobalTrackCache::revive(
     return savingPtr;
 }
 
-void GlobalTrackCache::resolve(
-        GlobalTrackCacheResolver* /*in/out*/ pCacheResolver,
+GlobalTrackCacheLookupResult GlobalTrackCache::resolve(
+        TrackPointer* /*out*/ pTrack,
+        TrackRef* /*out*/ pTrackRef,
         mixxx::FileAccess /*in*/ fileAccess,
         TrackId trackId) {
-    DEBUG_ASSERT(pCacheResolver);
+    DEBUG_ASSERT(pTrack);
+    DEBUG_ASSERT(pTrackRef);
     // Primary lookup by id (if available)
     if (trackId.isValid()) {
         if (debugLogEnabled()) {
@@ -576,12 +642,9 @@ void GlobalTrackCache::resolve(
                         << trackId
                         << strongPtr.get();
             }
-            TrackRef trackRef = createTrackRef(*strongPtr);
-            pCacheResolver->initLookupResult(
-                    GlobalTrackCacheLookupResult::Hit,
-                    std::move(strongPtr),
-                    std::move(trackRef));
-            return;
+            *pTrackRef = createTrackRef(*strongPtr);
+            *pTrack = std::move(strongPtr);
+            return GlobalTrackCacheLookupResult::Hit;
         }
     }
     // Secondary lookup by canonical location
@@ -609,17 +672,13 @@ void GlobalTrackCache::resolve(
                     *strongPtr);
             // Multiple tracks may reference the same physical file on disk
             if (!trackRef.hasId() || trackRef.getId() == cachedTrackRef.getId()) {
-                pCacheResolver->initLookupResult(
-                        GlobalTrackCacheLookupResult::Hit,
-                        std::move(strongPtr),
-                        std::move(trackRef));
+                *pTrack = std::move(strongPtr);
+                *pTrackRef = std::move(trackRef);
+                return GlobalTrackCacheLookupResult::Hit;
             } else {
-                pCacheResolver->initLookupResult(
-                        GlobalTrackCacheLookupResult::ConflictCanonicalLocation,
-                        TrackPointer(),
-                        std::move(cachedTrackRef));
+                *pTrackRef = std::move(cachedTrackRef);
+                return GlobalTrackCacheLookupResult::ConflictCanonicalLocation;
             }
-            return;
         }
     }
     if (!m_pSaver) {
@@ -629,7 +688,7 @@ void GlobalTrackCache::resolve(
         kLogger.warning()
                 << "Cache miss - caching has already been deactivated"
                 << trackRef;
-        return;
+        return GlobalTrackCacheLookupResult::None;
     }
     if (debugLogEnabled()) {
         kLogger.debug()
@@ -680,10 +739,9 @@ void GlobalTrackCache::resolve(
     // created object to the main thread.
     savingPtr->moveToThread(QCoreApplication::instance()->thread());
 
-    pCacheResolver->initLookupResult(
-            GlobalTrackCacheLookupResult::Miss,
-            std::move(savingPtr),
-            std::move(trackRef));
+    *pTrack = std::move(savingPtr);
+    *pTrackRef = std::move(trackRef);
+    return GlobalTrackCacheLookupResult::Miss;
 }
 
 TrackRef GlobalTrackCache::initTrackId(
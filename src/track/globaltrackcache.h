@@ -6,6 +6,7 @@
 #include "track/track_decl.h"
 #include "track/trackref.h"
 #include "util/compatibility/qmutex.h"
+#include "util/duration.h"
 #include "util/fileaccess.h"
 #include "util/sandbox.h"
 
@@ -36,6 +37,15 @@ private:
 
 typedef void (*deleteTrackFn_t)(Track*);
 
+/// Statistics about the contention of the cache mutex. A lock is
+/// contended if it could not be acquired without waiting.
+struct GlobalTrackCacheLockStats {
+    quint64 lockCount = 0;
+    quint64 contendedLockCount = 0;
+    mixxx::Duration totalWaitDuration;
+    mixxx::Duration maxWaitDuration;
+};
+
 class GlobalTrackCacheEntry final {
     // We need to hold two shared pointers, the deletingPtr is
     // responsible for the lifetime of the Track object itself.
@@ -116,6 +126,20 @@ public:
             const TrackRef& trackRef) const;
     QSet<TrackId> getCachedTrackIds() const;
 
+    // Lookup an existing or allocate a new Track object for a track
+    // with a known id. Multiple tracks that are resolved within the
+    // scope of a single locker are resolved without releasing and
+    // re-acquiring the lock for each track. Newly allocated Track
+    // objects (= Miss) are still empty and need to be populated
+    // by the caller.
+    GlobalTrackCacheLookupResult resolveTrack(
+            TrackPointer* /*out*/ pTrack,
+            TrackRef* /*out*/ pTrackRef,
+            mixxx::FileAccess fileAccess,
+            TrackId trackId) const;
+
+    GlobalTrackCacheLockStats getLockStats() const;
+
   private:
     friend class GlobalTrackCache;
 
@@ -254,8 +278,9 @@ class GlobalTrackCache : public QObject {
 
     TrackPointer revive(GlobalTrackCacheEntryPointer entryPtr);
 
-    void resolve(
-            GlobalTrackCacheResolver* /*in/out*/ pCacheResolver,
+    GlobalTrackCacheLookupResult resolve(
+            TrackPointer* /*out*/ pTrack,
+            TrackRef* /*out*/ pTrackRef,
             mixxx::FileAccess /*in*/ fileAccess,
             TrackId /*in*/ trackId);
 
@@ -278,6 +303,9 @@ class GlobalTrackCache : public QObject {
     // Managed by GlobalTrackCacheLocker
     mutable QT_RECURSIVE_MUTEX m_mutex;
 
+    // Only modified while m_mutex is locked
+    GlobalTrackCacheLockStats m_lockStats;
+
     GlobalTrackCacheSaver* m_pSaver;
 
     deleteTrackFn_t m_deleteTrackFn;
@@ -537,6 +537,23 @@ int KeyUtils::shortestStepsToCompatibleKey(
     return shortestDistance; // in the range of -2 .. +2
 }
 
+// static
+int KeyUtils::circleOfFifthsDistance(
+        mixxx::track::io::key::ChromaticKey key,
+        mixxx::track::io::key::ChromaticKey target_key) {
+    if (!ChromaticKey_IsValid(key) ||
+            key == mixxx::track::io::key::INVALID ||
+            !ChromaticKey_IsValid(target_key) ||
+            target_key == mixxx::track::io::key::INVALID) {
+        return -1;
+    }
+    // The OpenKey number is the radial on the Circle of Fifths
+    const int radialDistance = std::abs(
+            keyToOpenKeyNumber(key) - keyToOpenKeyNumber(target_key));
+    const int steps = std::min(radialDistance, 12 - radialDistance);
+    return steps + (keyIsMajor(key) != keyIsMajor(target_key) ? 1 : 0);
+}
+
 QList<mixxx::track::io::key::ChromaticKey> KeyUtils::getCompatibleKeys(
         mixxx::track::io::key::ChromaticKey key) {
     QList<mixxx::track::io::key::ChromaticKey> compatible;
@@ -71,6 +71,12 @@ class KeyUtils {
     static int shortestStepsToCompatibleKey(mixxx::track::io::key::ChromaticKey key,
                                             mixxx::track::io::key::ChromaticKey target_key);
 
+    // Returns the number of steps between both keys on the Circle of Fifths
+    // in the range 0..7, where switching between the major and minor ring
+    // counts as one step. Returns -1 if either key is invalid.
+    static int circleOfFifthsDistance(mixxx::track::io::key::ChromaticKey key,
+                                      mixxx::track::io::key::ChromaticKey target_key);
+
     // Returns a list of keys that are harmonically compatible with key using
     // the Circle of Fifths (including the key itself).
     static QList<mixxx::track::io::key::ChromaticKey> getCompatibleKeys(
@@ -0,0 +1,23 @@
+#include "track/tracksnapshot.h"
+
+#include "track/track.h"
+
+// static
+TrackSnapshot TrackSnapshot::fromTrack(const Track& track) {
+    TrackSnapshot snapshot;
+    snapshot.id = track.getId();
+    snapshot.location = track.getLocation();
+    snapshot.artist = track.getArtist();
+    snapshot.title = track.getTitle();
+    snapshot.album = track.getAlbum();
+    snapshot.albumArtist = track.getAlbumArtist();
+    snapshot.genre = track.getGenre();
+    snapshot.year = track.getYear();
+    snapshot.durationSeconds = track.getDuration();
+    snapshot.bpm = track.getBpm();
+    snapshot.key = track.getKey();
+    snapshot.rating = track.getRating();
+    snapshot.timesPlayed = track.getTimesPlayed();
+    snapshot.color = track.getColor();
+    return snapshot;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <QList>
+#include <QMetaType>
+#include <QString>
+
+#include "proto/keys.pb.h"
+#include "track/trackid.h"
+#include "util/color/rgbcolor.h"
+#include "util/fileinfo.h"
+
+class Track;
+
+/// A read-only copy of the properties of a library track that are
+/// needed by bulk consumers like the track export or the table models.
+///
+/// In contrast to a Track a snapshot is a plain value without a
+/// QObject, a mutex or an entry in the GlobalTrackCache. Snapshots
+/// of many tracks are loaded from the database with a single query
+/// (see TrackDAO::getTrackSnapshots()). They are not updated when
+/// the track is modified afterwards.
+struct TrackSnapshot final {
+    /// Copies the current properties of a track, e.g. for tracks
+    /// that are already cached and might have unsaved modifications.
+    static TrackSnapshot fromTrack(const Track& track);
+
+    mixxx::FileInfo fileInfo() const {
+        return mixxx::FileInfo(location);
+    }
+
+    TrackId id;
+    QString location;
+    QString artist;
+    QString title;
+    QString album;
+    QString albumArtist;
+    QString genre;
+    QString year;
+    double durationSeconds = 0.0;
+    double bpm = 0.0;
+    mixxx::track::io::key::ChromaticKey key = mixxx::track::io::key::INVALID;
+    int rating = 0;
+    int timesPlayed = 0;
+    mixxx::RgbColor::optional_t color;
+};
+
+Q_DECLARE_TYPEINFO(TrackSnapshot, Q_MOVABLE_TYPE);
+Q_DECLARE_METATYPE(TrackSnapshot)
+
+typedef QList<TrackSnapshot> TrackSnapshotList;
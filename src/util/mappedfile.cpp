@@ -0,0 +1,77 @@
+#include "util/mappedfile.h"
+
+#include <limits>
+
+#include "util/logger.h"
+
+namespace mixxx {
+
+namespace {
+
+const Logger kLogger("MappedFile");
+
+} // anonymous namespace
+
+MappedFile::MappedFile(const QString& filePath)
+        : m_file(filePath),
+          m_pData(nullptr) {
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open() {
+    close();
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        kLogger.warning() << "Failed to open" << m_file.fileName()
+                          << ":" << m_file.errorString();
+        return false;
+    }
+    const qint64 fileSize = m_file.size();
+    if (fileSize <= 0 || fileSize > std::numeric_limits<int>::max()) {
+        // Nothing to map or not addressable by QByteArray
+        return true;
+    }
+    m_pData = m_file.map(0, fileSize);
+    if (!m_pData) {
+        kLogger.debug() << "Reading" << m_file.fileName()
+                        << "without mapping it:" << m_file.errorString();
+        return true;
+    }
+    // No deep copy, the buffer reads from the mapped memory
+    m_data = QByteArray::fromRawData(
+            reinterpret_cast<const char*>(m_pData),
+            static_cast<int>(fileSize));
+    m_buffer.setBuffer(&m_data);
+    if (!m_buffer.open(QIODevice::ReadOnly)) {
+        m_data.clear();
+        m_file.unmap(m_pData);
+        m_pData = nullptr;
+    }
+    return true;
+}
+
+void MappedFile::close() {
+    if (m_buffer.isOpen()) {
+        m_buffer.close();
+    }
+    // The raw data must not outlive the mapping
+    m_data.clear();
+    if (m_pData) {
+        m_file.unmap(m_pData);
+        m_pData = nullptr;
+    }
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+}
+
+QIODevice* MappedFile::device() {
+    if (m_pData) {
+        return &m_buffer;
+    }
+    return &m_file;
+}
+
+} // namespace mixxx
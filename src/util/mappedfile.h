@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QBuffer>
+#include <QByteArray>
+#include <QFile>
+
+namespace mixxx {
+
+/// A read-only file that is mapped into memory if possible.
+///
+/// Parsers like QXmlStreamReader can stream the file through device()
+/// directly from the page cache, without copying it into intermediate read
+/// buffers first. If the file can't be mapped, e.g. because it is too
+/// large for a QByteArray, device() falls back to reading the file.
+class MappedFile final {
+  public:
+    explicit MappedFile(const QString& filePath);
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open();
+    void close();
+
+    bool isMapped() const {
+        return m_pData != nullptr;
+    }
+    /// The contents if isMapped(), otherwise empty
+    const QByteArray& data() const {
+        return m_data;
+    }
+    qint64 size() const {
+        return m_file.size();
+    }
+
+    QIODevice* device();
+
+  private:
+    QFile m_file;
+    uchar* m_pData;
+    QByteArray m_data;
+    QBuffer m_buffer;
+};
+
+} // namespace mixxx
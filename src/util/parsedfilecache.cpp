@@ -0,0 +1,124 @@
+#include "util/parsedfilecache.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include "util/logger.h"
+
+namespace {
+
+const mixxx::Logger kLogger("ParsedFileCache");
+
+// "MXPC"
+constexpr quint32 kMagic = 0x4d585043;
+
+bool isUnchanged(const QFileInfo& fileInfo, qint64 size, qint64 lastModified) {
+    return fileInfo.exists() &&
+            fileInfo.size() == size &&
+            fileInfo.lastModified().toMSecsSinceEpoch() == lastModified;
+}
+
+} // anonymous namespace
+
+namespace mixxx {
+
+ParsedFileCache::ParsedFileCache(const QString& filePath, quint32 version)
+        : m_filePath(filePath),
+          m_version(version),
+          m_modified(false) {
+    read();
+}
+
+void ParsedFileCache::read() {
+    QFile file(m_filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    QDataStream stream(&file);
+    stream.setVersion(kDataStreamVersion);
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    if (magic != kMagic || version != m_version) {
+        kLogger.info() << "Discarding outdated cache" << m_filePath;
+        m_modified = true;
+        return;
+    }
+    qint32 count = 0;
+    stream >> count;
+    for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString sourceFilePath;
+        Entry entry;
+        stream >> sourceFilePath >> entry.size >> entry.lastModified >> entry.data;
+        m_entries.insert(sourceFilePath, entry);
+    }
+    if (stream.status() != QDataStream::Ok) {
+        kLogger.warning() << "Discarding corrupt cache" << m_filePath;
+        m_entries.clear();
+        m_modified = true;
+    }
+}
+
+std::optional<QByteArray> ParsedFileCache::value(const QString& sourceFilePath) const {
+    const auto it = m_entries.constFind(sourceFilePath);
+    if (it == m_entries.constEnd() ||
+            !isUnchanged(QFileInfo(sourceFilePath), it->size, it->lastModified)) {
+        return std::nullopt;
+    }
+    return it->data;
+}
+
+void ParsedFileCache::insert(const QString& sourceFilePath, const QByteArray& data) {
+    const QFileInfo fileInfo(sourceFilePath);
+    Entry entry;
+    entry.size = fileInfo.size();
+    entry.lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+    entry.data = data;
+    m_entries.insert(sourceFilePath, entry);
+    m_modified = true;
+}
+
+void ParsedFileCache::clear() {
+    if (!m_entries.isEmpty()) {
+        m_entries.clear();
+        m_modified = true;
+    }
+}
+
+bool ParsedFileCache::save() {
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (QFileInfo::exists(it.key())) {
+            ++it;
+        } else {
+            it = m_entries.erase(it);
+            m_modified = true;
+        }
+    }
+    if (!m_modified) {
+        return true;
+    }
+
+    QDir().mkpath(QFileInfo(m_filePath).absolutePath());
+    QSaveFile file(m_filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        kLogger.warning() << "Failed to write cache" << m_filePath << file.errorString();
+        return false;
+    }
+    QDataStream stream(&file);
+    stream.setVersion(kDataStreamVersion);
+    stream << kMagic << m_version << static_cast<qint32>(m_entries.size());
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        stream << it.key() << it->size << it->lastModified << it->data;
+    }
+    if (stream.status() != QDataStream::Ok || !file.commit()) {
+        kLogger.warning() << "Failed to write cache" << m_filePath << file.errorString();
+        return false;
+    }
+    m_modified = false;
+    return true;
+}
+
+} // namespace mixxx
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <optional>
+
+namespace mixxx {
+
+/// Caches data that has been parsed from source files, e.g. XML documents,
+/// in a single binary file that is much faster to read than the sources.
+///
+/// Each entry is only valid as long as the size and the modification time
+/// of its source file are unchanged. A cache file that has been written
+/// with a different version is discarded entirely, so the version must be
+/// increased whenever the format of the cached data changes.
+class ParsedFileCache final {
+  public:
+    /// Reads the cache file, if it exists
+    ParsedFileCache(const QString& filePath, quint32 version);
+
+    const QString& filePath() const {
+        return m_filePath;
+    }
+
+    /// The paths of all source files with cached data
+    QStringList sourceFilePaths() const {
+        return m_entries.keys();
+    }
+
+    /// Returns the cached data if the source file has not been
+    /// modified since it has been inserted.
+    std::optional<QByteArray> value(const QString& sourceFilePath) const;
+    /// Stores the data that has been parsed from the current
+    /// contents of the source file.
+    void insert(const QString& sourceFilePath, const QByteArray& data);
+    void clear();
+
+    /// Deserializes a cached value with QDataStream. Returns false if the
+    /// entry is missing, outdated or corrupt.
+    template<typename T>
+    bool readValue(const QString& sourceFilePath, T* pValue) const {
+        const std::optional<QByteArray> data = value(sourceFilePath);
+        if (!data) {
+            return false;
+        }
+        QDataStream stream(*data);
+        stream.setVersion(kDataStreamVersion);
+        stream >> *pValue;
+        return stream.status() == QDataStream::Ok;
+    }
+
+    /// Serializes a value with QDataStream
+    template<typename T>
+    void insertValue(const QString& sourceFilePath, const T& value) {
+        QByteArray data;
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        stream.setVersion(kDataStreamVersion);
+        stream << value;
+        insert(sourceFilePath, data);
+    }
+
+    /// Writes the cache file if entries have been inserted or removed.
+    /// Entries of source files that don't exist anymore are dropped.
+    bool save();
+
+  private:
+    static constexpr QDataStream::Version kDataStreamVersion = QDataStream::Qt_5_12;
+
+    struct Entry {
+        qint64 size = 0;
+        qint64 lastModified = 0;
+        QByteArray data;
+    };
+
+    void read();
+
+    const QString m_filePath;
+    const quint32 m_version;
+    QHash<QString, Entry> m_entries;
+    bool m_modified;
+};
+
+} // namespace mixxx
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "util/types.h"
+
+/// A gain that is ramped from an old to a new value over a buffer of
+/// interleaved stereo samples.
+///
+/// The gain of each frame is calculated exactly like in
+/// SampleUtil::applyRampingGain() and SampleUtil::copyWithRampingGain(),
+/// which allows to apply it in loops that process several buffers at
+/// once with identical results.
+class RampingGain {
+  public:
+    /// A gain of one that leaves the samples unchanged
+    RampingGain()
+            : m_oldGain(CSAMPLE_GAIN_ONE),
+              m_gainDelta(0),
+              m_startGain(CSAMPLE_GAIN_ONE),
+              m_one(true),
+              m_zero(false) {
+    }
+
+    RampingGain(CSAMPLE_GAIN oldGain, CSAMPLE_GAIN newGain, SINT numSamples)
+            : m_oldGain(oldGain),
+              m_gainDelta((newGain - oldGain) / CSAMPLE_GAIN(numSamples / 2)),
+              m_startGain(oldGain + m_gainDelta),
+              m_one(oldGain == CSAMPLE_GAIN_ONE && newGain == CSAMPLE_GAIN_ONE),
+              m_zero(oldGain == CSAMPLE_GAIN_ZERO && newGain == CSAMPLE_GAIN_ZERO) {
+    }
+
+    /// The samples are left unchanged
+    bool isOne() const {
+        return m_one;
+    }
+
+    /// The samples are replaced by zero
+    bool isZero() const {
+        return m_zero;
+    }
+
+    bool isRamping() const {
+        return m_gainDelta != 0;
+    }
+
+    /// The gain of the given frame, only valid if neither isOne()
+    /// nor isZero()
+    CSAMPLE_GAIN at(int frame) const {
+        return isRamping() ? m_startGain + m_gainDelta * frame : m_oldGain;
+    }
+
+    /// Returns the sample of the given frame with the gain applied
+    CSAMPLE apply(CSAMPLE sample, int frame) const {
+        if (m_one) {
+            return sample;
+        }
+        if (m_zero) {
+            return CSAMPLE_ZERO;
+        }
+        return sample * at(frame);
+    }
+
+  private:
+    CSAMPLE_GAIN m_oldGain;
+    CSAMPLE_GAIN m_gainDelta;
+    CSAMPLE_GAIN m_startGain;
+    bool m_one;
+    bool m_zero;
+};
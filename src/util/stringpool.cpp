@@ -0,0 +1,59 @@
+#include "util/stringpool.h"
+
+#include "util/compatibility/qmutex.h"
+
+namespace {
+
+// The pool is not purged while it is smaller than this
+constexpr int kMinPurgeSize = 1024;
+
+} // anonymous namespace
+
+namespace mixxx {
+
+// static
+StringPool& StringPool::global() {
+    static StringPool s_pool;
+    return s_pool;
+}
+
+QString StringPool::intern(const QString& str) {
+    if (str.isEmpty()) {
+        return QString();
+    }
+    const auto locked = lockMutex(&m_mutex);
+    const auto it = m_strings.constFind(str);
+    if (it != m_strings.constEnd()) {
+        return *it;
+    }
+    if (m_strings.size() >= m_purgeSize) {
+        purgeLocked();
+    }
+    m_strings.insert(str);
+    return str;
+}
+
+int StringPool::size() const {
+    const auto locked = lockMutex(&m_mutex);
+    return m_strings.size();
+}
+
+void StringPool::purge() {
+    const auto locked = lockMutex(&m_mutex);
+    purgeLocked();
+}
+
+void StringPool::purgeLocked() {
+    auto it = m_strings.begin();
+    while (it != m_strings.end()) {
+        if (it->isDetached()) {
+            it = m_strings.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    // Amortize the costs of purging over the following insertions
+    m_purgeSize = qMax(kMinPurgeSize, 2 * m_strings.size());
+}
+
+} // namespace mixxx
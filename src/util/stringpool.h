@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QMutex>
+#include <QSet>
+#include <QString>
+
+namespace mixxx {
+
+/// A thread-safe pool of implicitly shared strings.
+///
+/// Many tracks in a library share the same artist, album or genre.
+/// Interning these strings while loading tracks from the database
+/// lets all tracks reference a single string buffer instead of
+/// allocating a separate copy for each track.
+///
+/// Strings that are no longer referenced outside of the pool are
+/// dropped when the pool grows, i.e. the pool only holds on to
+/// strings that are actually shared.
+class StringPool final {
+  public:
+    StringPool() = default;
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+    /// The pool that is used for loading tracks from the database.
+    static StringPool& global();
+
+    /// Returns a string that is equal to the given string and
+    /// shares its buffer with all other interned copies.
+    QString intern(const QString& str);
+
+    int size() const;
+
+    /// Drops all strings that are only referenced by the pool.
+    void purge();
+
+  private:
+    void purgeLocked();
+
+    mutable QMutex m_mutex;
+    QSet<QString> m_strings;
+    // Strings are purged before the pool grows beyond this size
+    int m_purgeSize = 0;
+};
+
+} // namespace mixxx
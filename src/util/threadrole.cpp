@@ -0,0 +1,539 @@
+#include "util/threadrole.h"
+
+#include <QHash>
+#include <QThread>
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+#include "util/assert.h"
+#include "util/compatibility/qmutex.h"
+#include "util/logger.h"
+#include "util/math.h"
+
+#ifdef __LINUX__
+#include <cerrno>
+#include <cstring>
+
+extern "C" {
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+}
+#endif
+
+namespace mixxx {
+
+namespace {
+
+const Logger kLogger("ThreadRole");
+
+const QString kConfigGroup = QStringLiteral("[ThreadRoles]");
+
+struct RegisteredThread {
+    ThreadRole role;
+    QString name;
+    qint64 threadId;
+    QList<int> cpus;
+    ThreadRoleConfig::Policy policy;
+    bool applied;
+#ifdef __LINUX__
+    clockid_t cpuClock;
+    bool cpuClockValid;
+#endif
+    /// Index in Registry::attachableThreads for threads reserved with
+    /// reserveThread(), or -1
+    int attachableIndex;
+};
+
+/// A preallocated registration for a thread that is attached from a
+/// real-time context, see ThreadRoleRegistry::reserveThread().
+struct AttachableThread {
+    enum State {
+        Reserved = 0,
+        Attaching = 1,
+        Attached = 2,
+    };
+    static constexpr qint64 kFree = -1;
+
+    static constexpr qint64 ticket(int id, State state) {
+        return (static_cast<qint64>(id) << 2) | state;
+    }
+
+    /// The id and the state, kFree if not reserved. The unique id in the
+    /// ticket prevents attaching to a slot that was reused in between.
+    std::atomic<qint64> ticket{kFree};
+
+    // Written by reserveThread(), before the ticket is published
+    ThreadRoleConfig config;
+    bool restrictCpus = false;
+#ifdef __LINUX__
+    cpu_set_t cpuSet;
+
+    // Written by attachCurrentThread(), before the Attached ticket is
+    // published
+    qint64 threadId = 0;
+    clockid_t cpuClock;
+    bool cpuClockValid = false;
+    const char* failure = nullptr;
+    int error = 0;
+#endif
+    bool applied = false;
+};
+
+/// The number of threads which can be reserved at the same time, e.g.
+/// one per open audio device
+constexpr int kMaxAttachableThreads = 16;
+
+struct Registry {
+    QMutex mutex;
+    std::array<ThreadRoleConfig, kThreadRoleCount> configs;
+    QHash<int, RegisteredThread> threads;
+    std::array<AttachableThread, kMaxAttachableThreads> attachableThreads;
+    int nextId = 0;
+};
+
+Registry& registry() {
+    static Registry s_registry;
+    return s_registry;
+}
+
+int cpuCount() {
+    return QThread::idealThreadCount();
+}
+
+qint64 currentThreadId() {
+#ifdef __LINUX__
+    return static_cast<qint64>(syscall(SYS_gettid));
+#else
+    return reinterpret_cast<qint64>(QThread::currentThreadId());
+#endif
+}
+
+#ifdef __LINUX__
+cpu_set_t cpuSetOf(const QList<int>& cpus) {
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (const int cpu : cpus) {
+        CPU_SET(cpu, &cpuSet);
+    }
+    return cpuSet;
+}
+
+/// Applies the affinity and the scheduling policy to the calling thread.
+/// Real-time safe, the failure is returned instead of logged.
+bool applyToCurrentThread(const cpu_set_t* pCpuSet,
+        const ThreadRoleConfig& config,
+        const char** ppFailure,
+        int* pError) {
+    if (pCpuSet) {
+        const int error = pthread_setaffinity_np(pthread_self(), sizeof(*pCpuSet), pCpuSet);
+        if (error != 0) {
+            *ppFailure = "Failed to set CPU affinity";
+            *pError = error;
+            return false;
+        }
+    }
+    switch (config.policy) {
+    case ThreadRoleConfig::Policy::Nice:
+        // On Linux the nice level is a property of the thread
+        if (setpriority(PRIO_PROCESS,
+                    static_cast<id_t>(currentThreadId()),
+                    config.priority) != 0) {
+            *ppFailure = "Failed to set nice level";
+            *pError = errno;
+            return false;
+        }
+        break;
+    case ThreadRoleConfig::Policy::RealTime: {
+        struct sched_param param = {};
+        param.sched_priority = config.priority;
+        const int error = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (error != 0) {
+            *ppFailure = "Failed to set SCHED_FIFO priority";
+            *pError = error;
+            return false;
+        }
+        break;
+    }
+    case ThreadRoleConfig::Policy::Default:
+        break;
+    }
+    return true;
+}
+
+void logFailure(ThreadRole role, const ThreadRoleConfig& config, const char* failure, int error) {
+    kLogger.warning() << failure << "of" << threadRoleName(role)
+                      << "thread with priority" << config.priority << ":"
+                      << strerror(error);
+}
+#endif
+
+} // anonymous namespace
+
+QString threadRoleName(ThreadRole role) {
+    switch (role) {
+    case ThreadRole::AudioCallback:
+        return QStringLiteral("AudioCallback");
+    case ThreadRole::EngineWorker:
+        return QStringLiteral("EngineWorker");
+    case ThreadRole::CachingReader:
+        return QStringLiteral("CachingReader");
+    case ThreadRole::Analyzer:
+        return QStringLiteral("Analyzer");
+    case ThreadRole::Controller:
+        return QStringLiteral("Controller");
+    case ThreadRole::VSync:
+        return QStringLiteral("VSync");
+    }
+    DEBUG_ASSERT(!"unreachable");
+    return QString();
+}
+
+// static
+QList<int> ThreadRoleConfig::parseCpuList(const QString& cpuList) {
+    // Same format as the kernel uses, e.g. "0-1,4"
+    QList<int> cpus;
+    const QStringList ranges = cpuList.split(QChar(','),
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+            Qt::SkipEmptyParts);
+#else
+            QString::SkipEmptyParts);
+#endif
+    for (const auto& range : ranges) {
+        const QStringList bounds = range.trimmed().split(QChar('-'));
+        bool firstOk = false;
+        bool lastOk = false;
+        const int first = bounds.first().toInt(&firstOk);
+        const int last = bounds.size() == 2 ? bounds.last().toInt(&lastOk) : first;
+        if (!firstOk || (bounds.size() == 2 && !lastOk) ||
+                bounds.size() > 2 || first < 0 || last < first) {
+            kLogger.warning() << "Ignoring invalid CPU range" << range;
+            continue;
+        }
+        for (int cpu = first; cpu <= last; ++cpu) {
+            if (!cpus.contains(cpu)) {
+                cpus.append(cpu);
+            }
+        }
+    }
+    std::sort(cpus.begin(), cpus.end());
+    return cpus;
+}
+
+// static
+QString ThreadRoleConfig::policyName(Policy policy) {
+    switch (policy) {
+    case Policy::Default:
+        return QStringLiteral("default");
+    case Policy::Nice:
+        return QStringLiteral("nice");
+    case Policy::RealTime:
+        return QStringLiteral("realtime");
+    }
+    DEBUG_ASSERT(!"unreachable");
+    return QString();
+}
+
+// static
+void ThreadRoleRegistry::loadConfig(const UserSettingsPointer& pConfig) {
+    for (int i = 0; i < kThreadRoleCount; ++i) {
+        const auto role = static_cast<ThreadRole>(i);
+        const QString name = threadRoleName(role);
+        ThreadRoleConfig config;
+        const QString policy = pConfig->getValue(
+                ConfigKey(kConfigGroup, name + QStringLiteral("Policy")),
+                ThreadRoleConfig::policyName(ThreadRoleConfig::Policy::Default));
+        if (policy == ThreadRoleConfig::policyName(ThreadRoleConfig::Policy::Nice)) {
+            config.policy = ThreadRoleConfig::Policy::Nice;
+        } else if (policy == ThreadRoleConfig::policyName(ThreadRoleConfig::Policy::RealTime)) {
+            config.policy = ThreadRoleConfig::Policy::RealTime;
+        }
+        config.priority = pConfig->getValue(
+                ConfigKey(kConfigGroup, name + QStringLiteral("Priority")), 0);
+        config.cpus = ThreadRoleConfig::parseCpuList(pConfig->getValueString(
+                ConfigKey(kConfigGroup, name + QStringLiteral("Cpus"))));
+        config.isolated = pConfig->getValue(
+                ConfigKey(kConfigGroup, name + QStringLiteral("Isolated")), false);
+        setConfig(role, config);
+    }
+}
+
+// static
+void ThreadRoleRegistry::setConfig(ThreadRole role, const ThreadRoleConfig& config) {
+    ThreadRoleConfig validConfig = config;
+#ifdef __LINUX__
+    if (validConfig.policy == ThreadRoleConfig::Policy::RealTime) {
+        // SCHED_FIFO rejects the priority 0 of an unset config value
+        const int minPriority = sched_get_priority_min(SCHED_FIFO);
+        const int maxPriority = sched_get_priority_max(SCHED_FIFO);
+        if (validConfig.priority < minPriority || validConfig.priority > maxPriority) {
+            kLogger.warning() << "SCHED_FIFO priority" << validConfig.priority << "of"
+                              << threadRoleName(role) << "is out of range"
+                              << minPriority << "-" << maxPriority;
+            validConfig.priority = math_clamp(validConfig.priority, minPriority, maxPriority);
+        }
+    }
+#endif
+    auto& reg = registry();
+    const auto locker = lockMutex(&reg.mutex);
+    reg.configs[static_cast<int>(role)] = validConfig;
+}
+
+// static
+ThreadRoleConfig ThreadRoleRegistry::config(ThreadRole role) {
+    auto& reg = registry();
+    const auto locker = lockMutex(&reg.mutex);
+    return reg.configs[static_cast<int>(role)];
+}
+
+// static
+QList<int> ThreadRoleRegistry::effectiveCpus(ThreadRole role, int cpuCount) {
+    auto& reg = registry();
+    const auto locker = lockMutex(&reg.mutex);
+    const ThreadRoleConfig& config = reg.configs[static_cast<int>(role)];
+
+    QList<int> isolatedCpus;
+    for (int i = 0; i < kThreadRoleCount; ++i) {
+        if (i != static_cast<int>(role) && reg.configs[i].isolated) {
+            isolatedCpus += reg.configs[i].cpus;
+        }
+    }
+    if (isolatedCpus.isEmpty()) {
+        return config.cpus;
+    }
+
+    QList<int> cpus;
+    if (config.cpus.isEmpty()) {
+        for (int cpu = 0; cpu < cpuCount; ++cpu) {
+            cpus.append(cpu);
+        }
+    } else {
+        cpus = config.cpus;
+    }
+    cpus.erase(std::remove_if(cpus.begin(),
+                       cpus.end(),
+                       [&isolatedCpus](int cpu) {
+                           return isolatedCpus.contains(cpu);
+                       }),
+            cpus.end());
+    if (cpus.isEmpty()) {
+        kLogger.warning() << "All CPUs of" << threadRoleName(role)
+                          << "are isolated by other roles, using them anyway";
+        return config.cpus;
+    }
+    if (cpus.size() == cpuCount) {
+        return QList<int>();
+    }
+    return cpus;
+}
+
+// static
+int ThreadRoleRegistry::registerCurrentThread(ThreadRole role) {
+    const ThreadRoleConfig roleConfig = config(role);
+    RegisteredThread thread;
+    thread.role = role;
+    thread.name = QThread::currentThread()->objectName();
+    thread.threadId = currentThreadId();
+    thread.cpus = effectiveCpus(role, cpuCount());
+    thread.policy = roleConfig.policy;
+    thread.attachableIndex = -1;
+#ifdef __LINUX__
+    const cpu_set_t cpuSet = cpuSetOf(thread.cpus);
+    const char* failure = nullptr;
+    int error = 0;
+    thread.applied = applyToCurrentThread(
+            thread.cpus.isEmpty() ? nullptr : &cpuSet, roleConfig, &failure, &error);
+    if (!thread.applied) {
+        logFailure(role, roleConfig, failure, error);
+    }
+    thread.cpuClockValid =
+            pthread_getcpuclockid(pthread_self(), &thread.cpuClock) == 0;
+#else
+    thread.applied = thread.cpus.isEmpty() &&
+            roleConfig.policy == ThreadRoleConfig::Policy::Default;
+    if (!thread.applied) {
+        kLogger.warning() << "Thread configuration for"
+                          << threadRoleName(role)
+                          << "is not supported on this platform";
+    }
+#endif
+    if (thread.name.isEmpty()) {
+        thread.name = threadRoleName(role);
+    }
+    kLogger.debug() << "Registered" << thread.name << "as"
+                    << threadRoleName(role) << "thread" << thread.threadId;
+
+    auto& reg = registry();
+    const auto locker = lockMutex(&reg.mutex);
+    const int id = reg.nextId++;
+    reg.threads.insert(id, thread);
+    return id;
+}
+
+// static
+int ThreadRoleRegistry::reserveThread(ThreadRole role, const QString& name) {
+    const ThreadRoleConfig roleConfig = config(role);
+    RegisteredThread thread;
+    thread.role = role;
+    thread.name = name.isEmpty() ? threadRoleName(role) : name;
+    thread.threadId = 0;
+    thread.cpus = effectiveCpus(role, cpuCount());
+    thread.policy = roleConfig.policy;
+    thread.applied = false;
+#ifdef __LINUX__
+    thread.cpuClockValid = false;
+#endif
+    thread.attachableIndex = -1;
+
+    auto& reg = registry();
+    const auto locker = lockMutex(&reg.mutex);
+    const int id = reg.nextId++;
+    for (int i = 0; i < kMaxAttachableThreads; ++i) {
+        AttachableThread& attachable = reg.attachableThreads[i];
+        if (attachable.ticket.load(std::memory_order_acquire) != AttachableThread::kFree) {
+            continue;
+        }
+        attachable.config = roleConfig;
+        attachable.restrictCpus = !thread.cpus.isEmpty();
+#ifdef __LINUX__
+        attachable.cpuSet = cpuSetOf(thread.cpus);
+        attachable.threadId = 0;
+        attachable.cpuClockValid = false;
+        attachable.failure = nullptr;
+        attachable.error = 0;
+#endif
+        attachable.applied = false;
+        attachable.ticket.store(
+                AttachableThread::ticket(id, AttachableThread::Reserved),
+                std::memory_order_release);
+        thread.attachableIndex = i;
+        break;
+    }
+    if (thread.attachableIndex < 0) {
+        kLogger.warning() << "Too many reserved threads, the configuration of"
+                          << thread.name << "is not applied";
+    }
+    reg.threads.insert(id, thread);
+    return id;
+}
+
+// static
+void ThreadRoleRegistry::attachCurrentThread(int id) {
+    if (id < 0) {
+        return;
+    }
+    // No locks, allocations or logging here, this is called from the
+    // real-time audio callback.
+    auto& reg = registry();
+    for (auto& attachable : reg.attachableThreads) {
+        qint64 expected = AttachableThread::ticket(id, AttachableThread::Reserved);
+        if (!attachable.ticket.compare_exchange_strong(expected,
+                    AttachableThread::ticket(id, AttachableThread::Attaching),
+                    std::memory_order_acq_rel)) {
+            continue;
+        }
+#ifdef __LINUX__
+        attachable.threadId = currentThreadId();
+        attachable.applied = applyToCurrentThread(
+                attachable.restrictCpus ? &attachable.cpuSet : nullptr,
+                attachable.config,
+                &attachable.failure,
+                &attachable.error);
+        attachable.cpuClockValid =
+                pthread_getcpuclockid(pthread_self(), &attachable.cpuClock) == 0;
+#else
+        attachable.applied = !attachable.restrictCpus &&
+                attachable.config.policy == ThreadRoleConfig::Policy::Default;
+#endif
+        attachable.ticket.store(
+                AttachableThread::ticket(id, AttachableThread::Attached),
+                std::memory_order_release);
+        return;
+    }
+}
+
+// static
+void ThreadRoleRegistry::unregisterThread(int id) {
+    auto& reg = registry();
+    const auto locker = lockMutex(&reg.mutex);
+    const auto it = reg.threads.constFind(id);
+    if (it == reg.threads.constEnd()) {
+        return;
+    }
+    if (it->attachableIndex >= 0) {
+        AttachableThread& attachable = reg.attachableThreads[it->attachableIndex];
+        const qint64 attaching = AttachableThread::ticket(id, AttachableThread::Attaching);
+        while (attachable.ticket.load(std::memory_order_acquire) == attaching) {
+            // Only a few syscalls in the attaching thread
+            QThread::yieldCurrentThread();
+        }
+#ifdef __LINUX__
+        if (attachable.ticket.load(std::memory_order_acquire) ==
+                        AttachableThread::ticket(id, AttachableThread::Attached) &&
+                !attachable.applied) {
+            // Deferred from attachCurrentThread()
+            logFailure(it->role, attachable.config, attachable.failure, attachable.error);
+        }
+#endif
+        attachable.ticket.store(AttachableThread::kFree, std::memory_order_release);
+    }
+    reg.threads.erase(it);
+}
+
+// static
+QList<ThreadRoleRegistry::ThreadInfo> ThreadRoleRegistry::threads() {
+    auto& reg = registry();
+    const auto locker = lockMutex(&reg.mutex);
+    QList<ThreadInfo> threads;
+    threads.reserve(reg.threads.size());
+    for (auto it = reg.threads.constBegin(); it != reg.threads.constEnd(); ++it) {
+        const RegisteredThread& thread = it.value();
+        ThreadInfo info;
+        info.role = thread.role;
+        info.name = thread.name;
+        info.threadId = thread.threadId;
+        info.cpus = thread.cpus;
+        info.policy = thread.policy;
+        info.applied = thread.applied;
+#ifdef __LINUX__
+        bool cpuClockValid = thread.cpuClockValid;
+        clockid_t cpuClock = thread.cpuClock;
+#endif
+        if (thread.attachableIndex >= 0) {
+            const AttachableThread& attachable =
+                    reg.attachableThreads[thread.attachableIndex];
+            if (attachable.ticket.load(std::memory_order_acquire) !=
+                    AttachableThread::ticket(it.key(), AttachableThread::Attached)) {
+                // The thread has not been started yet
+                continue;
+            }
+            info.applied = attachable.applied;
+#ifdef __LINUX__
+            info.threadId = attachable.threadId;
+            cpuClockValid = attachable.cpuClockValid;
+            cpuClock = attachable.cpuClock;
+#endif
+        }
+#ifdef __LINUX__
+        // The clock of another thread is only valid while it is running,
+        // which is ensured by unregistering before the thread exits.
+        timespec ts;
+        if (cpuClockValid && clock_gettime(cpuClock, &ts) == 0) {
+            info.cpuTime = Duration::fromNanos(
+                    ts.tv_sec * Q_INT64_C(1000000000) + ts.tv_nsec);
+        }
+#endif
+        threads.append(info);
+    }
+    std::sort(threads.begin(), threads.end(), [](const ThreadInfo& lhs, const ThreadInfo& rhs) {
+        return lhs.role < rhs.role ||
+                (lhs.role == rhs.role && lhs.threadId < rhs.threadId);
+    });
+    return threads;
+}
+
+} // namespace mixxx
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <QList>
+#include <QString>
+
+#include "preferences/usersettings.h"
+#include "util/duration.h"
+
+namespace mixxx {
+
+/// The threads that compete with the audio callback for CPU time.
+/// Each role can be pinned to a set of CPUs and get its own scheduling
+/// policy, configured in the [ThreadRoles] group of the settings.
+enum class ThreadRole {
+    AudioCallback,
+    EngineWorker,
+    CachingReader,
+    Analyzer,
+    Controller,
+    VSync,
+};
+
+constexpr int kThreadRoleCount = static_cast<int>(ThreadRole::VSync) + 1;
+
+QString threadRoleName(ThreadRole role);
+
+struct ThreadRoleConfig {
+    enum class Policy {
+        /// Leave the scheduling as set up by Qt or the audio API
+        Default,
+        /// Nice level in priority, only for the calling thread
+        Nice,
+        /// SCHED_FIFO with the given priority
+        RealTime,
+    };
+
+    Policy policy = Policy::Default;
+    int priority = 0;
+    /// Empty means all CPUs
+    QList<int> cpus;
+    /// CPUs of an isolated role are not used by any other role
+    bool isolated = false;
+
+    static QList<int> parseCpuList(const QString& cpuList);
+    static QString policyName(Policy policy);
+};
+
+/// Applies the configured CPU affinity and scheduling policy when a
+/// thread starts and keeps track of the running threads for diagnostics.
+///
+/// Applying the configuration is only implemented on Linux, other
+/// platforms only register the threads.
+class ThreadRoleRegistry {
+  public:
+    struct ThreadInfo {
+        ThreadRole role;
+        QString name;
+        qint64 threadId;
+        /// Empty if not restricted
+        QList<int> cpus;
+        ThreadRoleConfig::Policy policy;
+        bool applied;
+        Duration cpuTime;
+    };
+
+    static void loadConfig(const UserSettingsPointer& pConfig);
+    static void setConfig(ThreadRole role, const ThreadRoleConfig& config);
+    static ThreadRoleConfig config(ThreadRole role);
+
+    /// The CPUs a thread of this role may run on, after removing the CPUs
+    /// of isolated roles. An empty list means all CPUs.
+    static QList<int> effectiveCpus(ThreadRole role, int cpuCount);
+
+    /// Applies the configuration of the role to the calling thread and
+    /// returns an id for unregisterThread().
+    static int registerCurrentThread(ThreadRole role);
+    /// Prepares the registration of a thread that is started by a library,
+    /// like the callback thread of PortAudio, and returns an id for
+    /// attachCurrentThread() and unregisterThread(). The thread is listed
+    /// after it has been attached.
+    static int reserveThread(ThreadRole role, const QString& name);
+    /// Applies the reserved configuration to the calling thread. Only the
+    /// first call has an effect. Real-time safe: doesn't lock, allocate or
+    /// log, failures are logged when unregistering the thread.
+    static void attachCurrentThread(int id);
+    /// May be called from any thread. Must be called before the thread
+    /// exits, because its CPU clock is only valid while it is running.
+    static void unregisterThread(int id);
+
+    /// The registered threads with their CPU time so far
+    static QList<ThreadInfo> threads();
+};
+
+/// Registers the calling thread for its lifetime, for use in run()
+class ScopedThreadRole {
+  public:
+    explicit ScopedThreadRole(ThreadRole role)
+            : m_id(ThreadRoleRegistry::registerCurrentThread(role)) {
+    }
+    ~ScopedThreadRole() {
+        ThreadRoleRegistry::unregisterThread(m_id);
+    }
+    ScopedThreadRole(const ScopedThreadRole&) = delete;
+    ScopedThreadRole& operator=(const ScopedThreadRole&) = delete;
+
+  private:
+    const int m_id;
+};
+
+} // namespace mixxx
@@ -8,16 +8,21 @@
 #include "util/timer.h"
 #include "vinylcontrol/defs_vinylcontrol.h"
 #include "vinylcontrol/vinylcontrol.h"
+#include "vinylcontrol/vinylcontrolworker.h"
 #include "vinylcontrol/vinylcontrolxwax.h"
 
 #define SIGNAL_QUALITY_FIFO_SIZE 256
+#define CALLBACK_SIGNAL_QUALITY_FIFO_SIZE 4
 #define SAMPLE_PIPE_FIFO_SIZE 65536
 
+namespace {
+constexpr int kChannels = 2;
+} // anonymous namespace
+
 VinylControlProcessor::VinylControlProcessor(QObject* pParent, UserSettingsPointer pConfig)
         : QThread(pParent),
           m_pConfig(pConfig),
           m_pToggle(new ControlPushButton(ConfigKey(VINYL_PREF_KEY, "Toggle"))),
-          m_pWorkBuffer(SampleUtil::alloc(MAX_BUFFER_LEN)),
           m_processorsLock(QT_RECURSIVE_MUTEX_INIT),
           m_processors(kMaximumVinylControlInputs, NULL),
           m_signalQualityFifo(SIGNAL_QUALITY_FIFO_SIZE),
@@ -32,6 +37,11 @@ VinylControlProcessor::VinylControlProcessor(QObject* pParent, UserSettingsPoint
 
     for (int i = 0; i < kMaximumVinylControlInputs; ++i) {
         m_samplePipes[i] = new FIFO<CSAMPLE>(SAMPLE_PIPE_FIFO_SIZE);
+        m_callbackQualityReports[i] = new FIFO<VinylSignalQualityReport>(
+                CALLBACK_SIGNAL_QUALITY_FIFO_SIZE);
+        // Workers are started when their input is configured
+        m_workers[i] = nullptr;
+        m_analyzeInCallback[i] = false;
     }
 
     start(QThread::HighPriority);
@@ -43,7 +53,6 @@ VinylControlProcessor::~VinylControlProcessor() {
     wait();
 
     delete m_pToggle;
-    SampleUtil::free(m_pWorkBuffer);
 
     {
         const auto locker = lockMutex(&m_processorsLock);
@@ -54,6 +63,12 @@ VinylControlProcessor::~VinylControlProcessor() {
 
             delete m_samplePipes[i];
             m_samplePipes[i] = nullptr;
+
+            delete m_callbackQualityReports[i];
+            m_callbackQualityReports[i] = nullptr;
+
+            delete m_workers[i];
+            m_workers[i] = nullptr;
         }
     }
 
@@ -86,40 +101,105 @@ void VinylControlProcessor::run() {
             m_bReloadConfig = false;
         }
 
+        // Read the samples of all inputs first to analyze them in parallel
+        VinylControl* processors[kMaximumVinylControlInputs];
+        VinylControlWorker* workers[kMaximumVinylControlInputs];
+        int framesRead[kMaximumVinylControlInputs];
+        bool analysisLocked[kMaximumVinylControlInputs];
+        int lastInputRead = -1;
         for (int i = 0; i < kMaximumVinylControlInputs; ++i) {
             auto locker = lockMutex(&m_processorsLock);
-            VinylControl* pProcessor = m_processors[i];
+            processors[i] = m_processors[i];
+            workers[i] = m_workers[i];
             locker.unlock();
+            framesRead[i] = 0;
+            analysisLocked[i] = false;
             FIFO<CSAMPLE>* pSamplePipe = m_samplePipes[i];
 
             if (pSamplePipe->readAvailable() > 0) {
-                int samplesRead = pSamplePipe->read(m_pWorkBuffer, MAX_BUFFER_LEN);
-
-                if (samplesRead % 2 != 0) {
+                VinylControlWorker* pWorker = workers[i];
+                if (!pWorker) {
+                    // The input has never been configured
+                    qWarning() << "Samples written to non-existent VinylControl processor:" << i;
+                    pSamplePipe->flushReadData(pSamplePipe->readAvailable());
+                    continue;
+                }
+                // Keeps the engine callback from analyzing the next samples
+                // of this input before the queued ones have been analyzed.
+                m_analysisMutexes[i].lock();
+                analysisLocked[i] = true;
+                int samplesRead = pSamplePipe->read(pWorker->workBuffer(),
+                        static_cast<int>(pWorker->workBufferSize()));
+
+                if (samplesRead % kChannels != 0) {
                     qWarning() << "VinylControlProcessor received non-even number of samples via sample FIFO.";
                     samplesRead--;
                 }
-                int framesRead = samplesRead / 2;
 
-                if (pProcessor) {
-                    pProcessor->analyzeSamples(m_pWorkBuffer, framesRead);
+                if (processors[i]) {
+                    framesRead[i] = samplesRead / kChannels;
+                    lastInputRead = i;
                 } else {
                     // Samples are being written to a non-existent processor. Warning?
                     qWarning() << "Samples written to non-existent VinylControl processor:" << i;
                 }
             }
+        }
 
+        // The last input is analyzed on this thread while the workers
+        // analyze the other inputs.
+        for (int i = 0; i < lastInputRead; ++i) {
+            if (framesRead[i] > 0) {
+                workers[i]->startAnalysis(processors[i], framesRead[i]);
+            }
+        }
+        if (lastInputRead >= 0) {
+            processors[lastInputRead]->analyzeSamples(
+                    workers[lastInputRead]->workBuffer(),
+                    framesRead[lastInputRead]);
+        }
+        for (int i = 0; i < lastInputRead; ++i) {
+            if (framesRead[i] > 0) {
+                workers[i]->waitForAnalysis();
+            }
+        }
+
+        for (int i = 0; i < kMaximumVinylControlInputs; ++i) {
+            VinylControl* pProcessor = processors[i];
+            // The reports of samples that have been analyzed in the engine
+            // callback are forwarded without touching the processor, which
+            // the callback may be analyzing at the same time.
+            FIFO<VinylSignalQualityReport>* pCallbackReports = m_callbackQualityReports[i];
+            while (pCallbackReports->readAvailable() > 0) {
+                VinylSignalQualityReport report;
+                pCallbackReports->read(&report, 1);
+                if (m_bReportSignalQuality &&
+                        m_signalQualityFifo.write(&report, 1) != 1) {
+                    qWarning() << "VinylControlProcessor could not write signal quality report for VC index:" << i;
+                }
+            }
             // TODO(rryan) define a time-based update rate. This will update way
             // too quickly.
-            if (pProcessor && m_bReportSignalQuality) {
+            if (pProcessor && m_bReportSignalQuality &&
+                    (analysisLocked[i] || !m_analyzeInCallback[i])) {
+                if (!analysisLocked[i]) {
+                    m_analysisMutexes[i].lock();
+                    analysisLocked[i] = true;
+                }
+                // The processor is only replaced while holding the
+                // analysis mutex
+                pProcessor = m_processors[i];
                 VinylSignalQualityReport report;
-                if (pProcessor->writeQualityReport(&report)) {
+                if (pProcessor && pProcessor->writeQualityReport(&report)) {
                     report.processor = i;
                     if (m_signalQualityFifo.write(&report, 1) != 1) {
                         qWarning() << "VinylControlProcessor could not write signal quality report for VC index:" << i;
                     }
                 }
             }
+            if (analysisLocked[i]) {
+                m_analysisMutexes[i].unlock();
+            }
         }
 
         if (m_bQuit) {
@@ -136,17 +216,20 @@ void VinylControlProcessor::run() {
 
 void VinylControlProcessor::reloadConfig() {
     for (int i = 0; i < kMaximumVinylControlInputs; ++i) {
+        auto analysisLocker = lockMutex(&m_analysisMutexes[i]);
         auto locker = lockMutex(&m_processorsLock);
         VinylControl* pCurrent = m_processors[i];
 
         if (pCurrent == nullptr) {
             continue;
         }
+        loadAnalyzeInCallback(i);
 
         VinylControl *pNew = new VinylControlXwax(
             m_pConfig, kVCGroup.arg(i + 1));
         m_processors.replace(i, pNew);
         locker.unlock();
+        analysisLocker.unlock();
         // Delete outside of the critical section to avoid deadlocks.
         delete pCurrent;
     }
@@ -167,11 +250,27 @@ void VinylControlProcessor::onInputConfigured(const AudioInput& input) {
 
     VinylControl *pNew = new VinylControlXwax(
         m_pConfig, kVCGroup.arg(index + 1));
+    loadAnalyzeInCallback(index);
+
+    // Only configured decks get a worker thread. It is kept when the input
+    // is unconfigured, since the processor thread may still be using it.
+    VinylControlWorker* pNewWorker = nullptr;
+    if (!m_workers[index]) {
+        pNewWorker = new VinylControlWorker(index);
+        pNewWorker->start(QThread::HighPriority);
+    }
 
+    // The engine callback accesses the processor while holding the analysis
+    // mutex. It must be locked before m_processorsLock to avoid deadlocks.
+    auto analysisLocker = lockMutex(&m_analysisMutexes[index]);
     auto locker = lockMutex(&m_processorsLock);
     VinylControl* pCurrent = m_processors.at(index);
     m_processors.replace(index, pNew);
+    if (pNewWorker) {
+        m_workers[index] = pNewWorker;
+    }
     locker.unlock();
+    analysisLocker.unlock();
     // Delete outside of the critical section to avoid deadlocks.
     delete pCurrent;
 }
@@ -190,14 +289,22 @@ void VinylControlProcessor::onInputUnconfigured(const AudioInput& input) {
         return;
     }
 
+    auto analysisLocker = lockMutex(&m_analysisMutexes[index]);
     auto locker = lockMutex(&m_processorsLock);
     VinylControl* pVC = m_processors.at(index);
     m_processors.replace(index, NULL);
     locker.unlock();
+    analysisLocker.unlock();
     // Delete outside of the critical section to avoid deadlocks.
     delete pVC;
 }
 
+void VinylControlProcessor::loadAnalyzeInCallback(int index) {
+    m_analyzeInCallback[index] = m_pConfig->getValue<bool>(
+            ConfigKey(kVCGroup.arg(index + 1), "vinylcontrol_analyze_in_callback"),
+            false);
+}
+
 bool VinylControlProcessor::deckConfigured(int index) const {
     return m_processors[index] != NULL;
 }
@@ -225,7 +332,13 @@ void VinylControlProcessor::receiveBuffer(const AudioInput& input,
         return;
     }
 
-    constexpr int kChannels = 2;
+    if (m_analyzeInCallback[vcIndex] &&
+            analyzeInCallback(vcIndex, pBuffer, nFrames)) {
+        // Wake up the processor thread for the signal quality reports
+        m_samplesAvailableSignal.wakeAll();
+        return;
+    }
+
     const int nSamples = nFrames * kChannels;
     int samplesWritten = pSamplePipe->write(pBuffer, nSamples);
 
@@ -237,6 +350,39 @@ void VinylControlProcessor::receiveBuffer(const AudioInput& input,
     m_samplesAvailableSignal.wakeAll();
 }
 
+bool VinylControlProcessor::analyzeInCallback(int index,
+        const CSAMPLE* pBuffer,
+        unsigned int nFrames) {
+    QMutex* pAnalysisMutex = &m_analysisMutexes[index];
+    if (!pAnalysisMutex->tryLock()) {
+        // The processor thread is analyzing queued samples
+        return false;
+    }
+    // Samples that are still queued must be analyzed first. The processor
+    // thread only dequeues samples while holding the analysis mutex.
+    if (m_samplePipes[index]->readAvailable() > 0) {
+        pAnalysisMutex->unlock();
+        return false;
+    }
+    // The processor is only replaced while holding the analysis mutex
+    VinylControl* pProcessor = m_processors[index];
+    if (pProcessor) {
+        // The cost per sample is bounded by the timecode decoder
+        pProcessor->analyzeSamples(pBuffer, nFrames);
+        // The processor thread forwards the report. If it has not caught
+        // up with the previous reports, this one is dropped.
+        FIFO<VinylSignalQualityReport>* pReports = m_callbackQualityReports[index];
+        VinylSignalQualityReport report;
+        if (m_bReportSignalQuality && pReports->writeAvailable() > 0 &&
+                pProcessor->writeQualityReport(&report)) {
+            report.processor = static_cast<unsigned char>(index);
+            pReports->write(&report, 1);
+        }
+    }
+    pAnalysisMutex->unlock();
+    return pProcessor != nullptr;
+}
+
 void VinylControlProcessor::toggleDeck(double value) {
     if (value == 0) {
         return;
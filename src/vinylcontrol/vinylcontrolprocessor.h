@@ -5,6 +5,7 @@
 #include <QThread>
 #include <QVector>
 #include <QWaitCondition>
+#include <atomic>
 
 #include "preferences/usersettings.h"
 #include "soundio/soundmanagerutil.h"
@@ -13,12 +14,22 @@
 #include "vinylcontrol/vinylsignalquality.h"
 
 class VinylControl;
+class VinylControlWorker;
 class ControlPushButton;
 
 // VinylControlProcessor is a thread that is in charge of receiving samples from
 // the engine callback and feeding those samples to the VinylControl
 // classes. The most important thing is that the connection between the engine
 // callback and VinylControlProcessor (the receiveBuffer method) is lock-free.
+// The samples of multiple inputs are analyzed in parallel by one
+// VinylControlWorker per configured input.
+//
+// Optionally, the samples of a deck are analyzed directly in the engine
+// callback when they are received (vinylcontrol_analyze_in_callback). Since
+// the inputs are pushed before the engine processes the decks, the pitch and
+// position of the timecode apply in the same callback instead of the next one.
+// The callback never waits for the processor thread: if the thread is busy
+// with the input or samples are still queued, the samples are queued as well.
 class VinylControlProcessor : public QThread, public AudioDestination {
     Q_OBJECT
   public:
@@ -45,7 +56,9 @@ class VinylControlProcessor : public QThread, public AudioDestination {
     virtual void onInputUnconfigured(const AudioInput& input);
 
     // Called by the engine callback. Must not touch any state in
-    // VinylControlProcessor except for m_samplePipes. NOTE:
+    // VinylControlProcessor except for m_samplePipes and, when analyzing in
+    // the callback, the processor and m_callbackQualityReports of the input.
+    // The analysis mutex is only acquired with tryLock() there. NOTE:
 
     // This is called by SoundManager whenever there are new samples from the
     // configured input to be processed. This is run in the callback thread of
@@ -63,6 +76,10 @@ class VinylControlProcessor : public QThread, public AudioDestination {
 
   private:
     void reloadConfig();
+    void loadAnalyzeInCallback(int index);
+    // Called by the engine callback. Returns false if the samples could not
+    // be analyzed without blocking and need to be queued instead.
+    bool analyzeInCallback(int index, const CSAMPLE* pBuffer, unsigned int iNumFrames);
 
     UserSettingsPointer m_pConfig;
     ControlPushButton* m_pToggle;
@@ -70,7 +87,20 @@ class VinylControlProcessor : public QThread, public AudioDestination {
     // callback to the processor thread. There is a maximum of
     // kMaximumVinylControlInputs pipes.
     FIFO<CSAMPLE>* m_samplePipes[kMaximumVinylControlInputs];
-    CSAMPLE* m_pWorkBuffer;
+    // The workers own the buffers that the samples are read into from the
+    // FIFOs. They are created when their input is configured for the first
+    // time and only deleted with the processor. Written under
+    // m_processorsLock.
+    VinylControlWorker* m_workers[kMaximumVinylControlInputs];
+    // Held while the samples of an input are analyzed, which happens
+    // either in the processor thread or in the engine callback, and while
+    // the processor of the input is replaced.
+    QMutex m_analysisMutexes[kMaximumVinylControlInputs];
+    std::atomic<bool> m_analyzeInCallback[kMaximumVinylControlInputs];
+    // The signal quality reports of inputs that are analyzed in the engine
+    // callback. Written by the callback and forwarded by the processor
+    // thread, which never reads the processor of these inputs.
+    FIFO<VinylSignalQualityReport>* m_callbackQualityReports[kMaximumVinylControlInputs];
     QWaitCondition m_samplesAvailableSignal;
     QMutex m_waitForSampleMutex;
     QT_RECURSIVE_MUTEX m_processorsLock;
@@ -0,0 +1,50 @@
+#include "vinylcontrol/vinylcontrolworker.h"
+
+#include "moc_vinylcontrolworker.cpp"
+#include "util/assert.h"
+#include "util/defs.h"
+#include "vinylcontrol/vinylcontrol.h"
+
+namespace {
+constexpr int kChannels = 2;
+} // anonymous namespace
+
+VinylControlWorker::VinylControlWorker(int index)
+        : m_index(index),
+          m_workBuffer(MAX_BUFFER_LEN),
+          m_pProcessor(nullptr),
+          m_frames(0),
+          m_bQuit(false) {
+}
+
+VinylControlWorker::~VinylControlWorker() {
+    m_bQuit = true;
+    m_semaRun.release();
+    wait();
+}
+
+void VinylControlWorker::startAnalysis(VinylControl* pProcessor, SINT frames) {
+    DEBUG_ASSERT(pProcessor);
+    DEBUG_ASSERT(frames * kChannels <= m_workBuffer.size());
+    m_pProcessor = pProcessor;
+    m_frames = frames;
+    m_semaRun.release();
+}
+
+void VinylControlWorker::waitForAnalysis() {
+    m_semaDone.acquire();
+}
+
+void VinylControlWorker::run() {
+    QThread::currentThread()->setObjectName(
+            QStringLiteral("VinylControlWorker %1").arg(m_index + 1));
+
+    while (true) {
+        m_semaRun.acquire();
+        if (m_bQuit) {
+            break;
+        }
+        m_pProcessor->analyzeSamples(m_workBuffer.data(), m_frames);
+        m_semaDone.release();
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <QSemaphore>
+#include <QThread>
+#include <atomic>
+
+#include "util/samplebuffer.h"
+#include "util/types.h"
+
+class VinylControl;
+
+/// Decodes the timecode of one vinyl control input on its own thread.
+///
+/// VinylControlProcessor hands the samples of all inputs that have received
+/// new samples to their workers at once and waits until all of them are done,
+/// so the timecodes of multiple turntables are decoded in parallel.
+class VinylControlWorker : public QThread {
+    Q_OBJECT
+  public:
+    explicit VinylControlWorker(int index);
+    ~VinylControlWorker() override;
+
+    /// Receives the interleaved stereo samples that are analyzed next
+    CSAMPLE* workBuffer() {
+        return m_workBuffer.data();
+    }
+    SINT workBufferSize() const {
+        return m_workBuffer.size();
+    }
+
+    /// Starts to analyze the frames in the work buffer. Must be followed
+    /// by waitForAnalysis() before the work buffer is touched again.
+    void startAnalysis(VinylControl* pProcessor, SINT frames);
+    /// Blocks until the analysis started by startAnalysis() has finished
+    void waitForAnalysis();
+
+  protected:
+    void run() override;
+
+  private:
+    const int m_index;
+    mixxx::SampleBuffer m_workBuffer;
+    QSemaphore m_semaRun;
+    QSemaphore m_semaDone;
+    // Only written before releasing m_semaRun
+    VinylControl* m_pProcessor;
+    SINT m_frames;
+    std::atomic<bool> m_bQuit;
+};
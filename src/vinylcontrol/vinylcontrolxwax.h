@@ -27,7 +27,7 @@ class VinylControlXwax : public VinylControl {
     virtual ~VinylControlXwax();
 
     static void freeLUTs();
-    void analyzeSamples(CSAMPLE* pSamples, size_t nFrames);
+    void analyzeSamples(const CSAMPLE* pSamples, size_t nFrames);
 
     virtual bool writeQualityReport(VinylSignalQualityReport* qualityReportFifo);
 
@@ -56,10 +56,6 @@ class VinylControlXwax : public VinylControl {
     // The position read last time it was polled.
     double m_dVinylPositionOld;
 
-    // Scratch buffer for CSAMPLE -> short conversions.
-    std::vector<short> m_pWorkBuffer;
-    size_t m_workBufferSize;
-
     // Signal quality ring buffer.
     // TODO(XXX): Replace with CircularBuffer instead of handling the ring logic
     // in VinylControlXwax.
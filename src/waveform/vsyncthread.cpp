@@ -8,6 +8,7 @@
 #include "moc_vsyncthread.cpp"
 #include "util/math.h"
 #include "util/performancetimer.h"
+#include "util/threadrole.h"
 #include "waveform/guitick.h"
 
 VSyncThread::VSyncThread(QObject* pParent)
@@ -33,6 +34,7 @@ VSyncThread::~VSyncThread() {
 
 void VSyncThread::run() {
     QThread::currentThread()->setObjectName("VSyncThread");
+    const mixxx::ScopedThreadRole threadRole(mixxx::ThreadRole::VSync);
 
     m_waitToSwapMicros = m_syncIntervalTimeMicros;
     m_timer.start();
@@ -103,6 +103,16 @@ class Waveform {
         m_completion = completion;
     }
 
+    // The data beyond the completion might contain a coarse preview
+    // of the whole track, which is replaced while the analysis
+    // progresses.
+    bool hasPreview() const {
+        return m_hasPreview.loadAcquire() != 0;
+    }
+    void setHasPreview(bool hasPreview) {
+        m_hasPreview.storeRelease(hasPreview ? 1 : 0);
+    }
+
     // We do not lock the mutex since m_textureStride is not changed after
     // the constructor runs.
     inline int getTextureStride() const { return m_textureStride; }
@@ -174,6 +184,7 @@ class Waveform {
     // For performance, completion is shared as a QAtomicInt and does not lock
     // the mutex. The completion of the waveform calculation.
     QAtomicInt m_completion;
+    QAtomicInt m_hasPreview;
 
     mutable QMutex m_mutex;
 
@@ -291,6 +291,7 @@ void WOverview::slotWaveformSummaryUpdated() {
     } else {
         // Null waveform pointer means waveform was cleared.
         m_waveformSourceImage = QImage();
+        m_waveformPreviewImage = QImage();
         m_analyzerProgress = kAnalyzerProgressUnknown;
         m_actualCompletion = 0;
         m_waveformPeak = -1.0;
@@ -300,6 +301,97 @@ void WOverview::slotWaveformSummaryUpdated() {
     }
 }
 
+QImage WOverview::createWaveformImage(int dataSize) const {
+    // We keep full range waveform data to scale it on paint
+    QImage image(dataSize / 2,
+            waveformImageHeight(),
+            QImage::Format_ARGB32_Premultiplied);
+    image.fill(QColor(0, 0, 0, 0).value());
+    return image;
+}
+
+bool WOverview::drawNextPixmapPart() {
+    ScopedTimer t("WOverview::drawNextPixmapPart");
+
+    //qDebug() << "WOverview::drawNextPixmapPart()";
+
+    ConstWaveformPointer pWaveform = getWaveform();
+    if (!pWaveform) {
+        return false;
+    }
+
+    const int dataSize = pWaveform->getDataSize();
+    if (dataSize == 0) {
+        return false;
+    }
+
+    if (m_waveformSourceImage.isNull()) {
+        m_waveformSourceImage = createWaveformImage(dataSize);
+    }
+
+    // Always multiple of 2
+    const int waveformCompletion = pWaveform->getCompletion();
+
+    bool previewDrawn = false;
+    if (m_waveformPreviewImage.isNull() && pWaveform->hasPreview() &&
+            waveformCompletion < dataSize - 2) {
+        // The preview does not change and is drawn only once. The
+        // parts that are analyzed in the mean time are covered later.
+        m_waveformPreviewImage = createWaveformImage(dataSize);
+        QPainter painter(&m_waveformPreviewImage);
+        painter.translate(0.0, static_cast<double>(m_waveformPreviewImage.height()) / 2.0);
+        drawWaveformPart(&painter, *pWaveform, waveformCompletion, dataSize);
+        m_waveformImageScaled = QImage();
+        previewDrawn = true;
+    }
+
+    // Test if there is some new to draw (at least of pixel width)
+    const int completionIncrement = waveformCompletion - m_actualCompletion;
+
+    int visiblePixelIncrement = completionIncrement * length() / dataSize;
+    if (waveformCompletion < (dataSize - 2) &&
+            (completionIncrement < 2 || visiblePixelIncrement == 0)) {
+        return previewDrawn;
+    }
+
+    const int nextCompletion = m_actualCompletion + completionIncrement;
+
+    //qDebug() << "WOverview::drawNextPixmapPart() - nextCompletion:"
+    //         << nextCompletion
+    //         << "m_actualCompletion:" << m_actualCompletion
+    //         << "waveformCompletion:" << waveformCompletion
+    //         << "completionIncrement:" << completionIncrement;
+
+    {
+        QPainter painter(&m_waveformSourceImage);
+        painter.translate(0.0, static_cast<double>(m_waveformSourceImage.height()) / 2.0);
+        drawWaveformPart(&painter, *pWaveform, m_actualCompletion, nextCompletion);
+    }
+
+    // Evaluate waveform ratio peak
+    for (int currentCompletion = m_actualCompletion;
+            currentCompletion < nextCompletion;
+            currentCompletion += 2) {
+        m_waveformPeak = math_max3(
+                m_waveformPeak,
+                static_cast<float>(pWaveform->getAll(currentCompletion)),
+                static_cast<float>(pWaveform->getAll(currentCompletion + 1)));
+    }
+
+    m_actualCompletion = nextCompletion;
+    m_waveformImageScaled = QImage();
+    m_diffGain = 0;
+
+    // Test if the complete waveform is done
+    if (m_actualCompletion >= dataSize - 2) {
+        m_pixmapDone = true;
+        m_waveformPreviewImage = QImage();
+        //qDebug() << "m_waveformPeakRatio" << m_waveformPeak;
+    }
+
+    return true;
+}
+
 void WOverview::onTrackAnalyzerProgress(TrackId trackId, AnalyzerProgress analyzerProgress) {
     if (!m_pCurrentTrack || (m_pCurrentTrack->getId() != trackId)) {
         return;
@@ -335,6 +427,7 @@ void WOverview::slotLoadingTrack(TrackPointer pNewTrack, TrackPointer pOldTrack)
     }
 
     m_waveformSourceImage = QImage();
+    m_waveformPreviewImage = QImage();
     m_analyzerProgress = kAnalyzerProgressUnknown;
     m_actualCompletion = 0;
     m_waveformPeak = -1.0;
@@ -688,7 +781,25 @@ void WOverview::drawWaveformPixmap(QPainter* pPainter) {
                     m_waveformSourceImage.width(),
                     m_waveformSourceImage.height() -
                             2 * static_cast<int>(diffGain));
-            QImage croppedImage = m_waveformSourceImage.copy(sourceRect);
+            QImage croppedImage;
+            if (m_waveformPreviewImage.isNull()) {
+                croppedImage = m_waveformSourceImage.copy(sourceRect);
+            } else {
+                // Fill the parts that have not been analyzed yet with
+                // the preview
+                QImage sourceImage = m_waveformSourceImage;
+                const int previewBegin = m_actualCompletion / 2;
+                {
+                    QPainter painter(&sourceImage);
+                    painter.drawImage(QPoint(previewBegin, 0),
+                            m_waveformPreviewImage,
+                            QRect(previewBegin,
+                                    0,
+                                    m_waveformPreviewImage.width() - previewBegin,
+                                    m_waveformPreviewImage.height()));
+                }
+                croppedImage = sourceImage.copy(sourceRect);
+            }
             if (m_orientation == Qt::Vertical) {
                 // Rotate pixmap
                 croppedImage = croppedImage.transformed(QTransform(0, 1, 1, 0, 0, 0));
@@ -33,6 +33,7 @@
 
 class PlayerManager;
 class PainterScope;
+class QPainter;
 
 class WOverview : public WWidget, public TrackDropTarget {
     Q_OBJECT
@@ -79,6 +80,8 @@ class WOverview : public WWidget, public TrackDropTarget {
     }
 
     QImage m_waveformSourceImage;
+    // The coarse preview of the parts that have not been analyzed yet
+    QImage m_waveformPreviewImage;
     QImage m_waveformImageScaled;
 
     WaveformSignalColors m_signalColors;
@@ -107,7 +110,16 @@ class WOverview : public WWidget, public TrackDropTarget {
   private:
     // Append the waveform overview pixmap according to available data
     // in waveform
-    virtual bool drawNextPixmapPart() = 0;
+    bool drawNextPixmapPart();
+    // Draws the visual samples in [begin, end) of the waveform. The painter
+    // is translated onto the axis of the waveform image.
+    virtual void drawWaveformPart(
+            QPainter* pPainter, const Waveform& waveform, int begin, int end) = 0;
+    virtual int waveformImageHeight() const {
+        // Twice the height of the viewport to be scalable by total_gain
+        return 2 * 255;
+    }
+    QImage createWaveformImage(int dataSize) const;
     void drawEndOfTrackBackground(QPainter* pPainter);
     void drawAxis(QPainter* pPainter);
     void drawWaveformPixmap(QPainter* pPainter);
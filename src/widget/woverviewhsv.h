@@ -12,5 +12,6 @@ class WOverviewHSV : public WOverview {
             QWidget* parent = nullptr);
 
   private:
-    bool drawNextPixmapPart() override;
+    void drawWaveformPart(
+            QPainter* pPainter, const Waveform& waveform, int begin, int end) override;
 };
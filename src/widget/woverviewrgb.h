@@ -12,5 +12,7 @@ class WOverviewRGB : public WOverview {
             QWidget* parent = nullptr);
 
   private:
-    bool drawNextPixmapPart() override;
+    int waveformImageHeight() const override;
+    void drawWaveformPart(
+            QPainter* pPainter, const Waveform& waveform, int begin, int end) override;
 };
@@ -1,5 +1,6 @@
 #include "widget/wtracktableview.h"
 
+#include <QAbstractProxyModel>
 #include <QDrag>
 #include <QModelIndex>
 #include <QScrollBar>
@@ -7,6 +8,7 @@
 #include <QUrl>
 
 #include "control/controlobject.h"
+#include "library/basesqltablemodel.h"
 #include "library/dao/trackschema.h"
 #include "library/library.h"
 #include "library/library_prefs.h"
@@ -168,6 +170,24 @@ void WTrackTableView::loadTrackModel(QAbstractItemModel* model, bool restoreStat
 
     setVisible(false);
 
+    // Restoring the state of the previous model is obsolete
+    disconnect(m_selectFinishedConnection);
+    m_afterSelectFns.clear();
+    auto* pSqlTableModel = qobject_cast<BaseSqlTableModel*>(model);
+    if (!pSqlTableModel) {
+        // ProxyTrackModel forwards isSelectPending() of its source model
+        auto* pProxyModel = qobject_cast<QAbstractProxyModel*>(model);
+        if (pProxyModel) {
+            pSqlTableModel = qobject_cast<BaseSqlTableModel*>(pProxyModel->sourceModel());
+        }
+    }
+    if (pSqlTableModel) {
+        m_selectFinishedConnection = connect(pSqlTableModel,
+                &BaseSqlTableModel::selectFinished,
+                this,
+                &WTrackTableView::slotSelectFinished);
+    }
+
     // Save the previous track model's header state
     WTrackTableViewHeader* oldHeader =
             qobject_cast<WTrackTableViewHeader*>(horizontalHeader());
@@ -507,21 +527,27 @@ void WTrackTableView::onSearch(const QString& text) {
             prevColumn = currentIndex().column();
         }
         trackModel->search(text);
-        if (queryIsLessSpecific) {
-            // If the user removed query terms, we try to select the same
-            // tracks as before
-            setCurrentTrackId(prevTrack, prevColumn);
-            setSelectedTracks(selectedTracks);
-        } else {
-            // The user created a more specific search query, try to restore a
-            // previous state
-            if (!restoreCurrentViewState()) {
-                // We found no saved state for this query, try to select the
-                // tracks last active, if they are part of the result set
+        runAfterPendingSelect([this,
+                                      queryIsLessSpecific,
+                                      selectedTracks,
+                                      prevTrack,
+                                      prevColumn] {
+            if (queryIsLessSpecific) {
+                // If the user removed query terms, we try to select the same
+                // tracks as before
                 setCurrentTrackId(prevTrack, prevColumn);
                 setSelectedTracks(selectedTracks);
+            } else {
+                // The user created a more specific search query, try to restore a
+                // previous state
+                if (!restoreCurrentViewState()) {
+                    // We found no saved state for this query, try to select the
+                    // tracks last active, if they are part of the result set
+                    setCurrentTrackId(prevTrack, prevColumn);
+                    setSelectedTracks(selectedTracks);
+                }
             }
-        }
+        });
     }
 }
 
@@ -1106,6 +1132,40 @@ void WTrackTableView::slotSelectTrack(const TrackId& trackId) {
     }
 }
 
+bool WTrackTableView::restoreCurrentViewState() {
+    TrackModel* trackModel = getTrackModel();
+    if (trackModel && trackModel->isSelectPending()) {
+        // The scroll position and selection refer to the new rows
+        runAfterPendingSelect([this] {
+            WLibraryTableView::restoreCurrentViewState();
+        });
+        return true;
+    }
+    return WLibraryTableView::restoreCurrentViewState();
+}
+
+void WTrackTableView::runAfterPendingSelect(std::function<void()> fn) {
+    TrackModel* trackModel = getTrackModel();
+    if (trackModel && trackModel->isSelectPending()) {
+        m_afterSelectFns.append(std::move(fn));
+    } else {
+        fn();
+    }
+}
+
+void WTrackTableView::slotSelectFinished() {
+    TrackModel* trackModel = getTrackModel();
+    if (trackModel && trackModel->isSelectPending()) {
+        // Superseded by another background select
+        return;
+    }
+    const auto fns = std::move(m_afterSelectFns);
+    m_afterSelectFns.clear();
+    for (const auto& fn : fns) {
+        fn();
+    }
+}
+
 void WTrackTableView::doSortByColumn(int headerSection, Qt::SortOrder sortOrder) {
     TrackModel* trackModel = getTrackModel();
     QAbstractItemModel* itemModel = model();
@@ -1128,54 +1188,62 @@ void WTrackTableView::doSortByColumn(int headerSection, Qt::SortOrder sortOrder)
 
     sortByColumn(headerSection, sortOrder);
 
-    QItemSelectionModel* currentSelection = selectionModel();
-    currentSelection->reset(); // remove current selection
-
-    // Find previously selected tracks and store respective rows for reselection.
-    QMap<int, int> selectedRows;
-    for (const auto& trackId : selectedTrackIds) {
-        // TODO(rryan) slowly fixing the issues with BaseSqlTableModel. This
-        // code is broken for playlists because it assumes each trackid is in
-        // the table once. This will erroneously select all instances of the
-        // track for playlists, but it works fine for every other view. The way
-        // to fix this that we should do is to delegate the selection saving to
-        // the TrackModel. This will allow the playlist table model to use the
-        // table index as the unique id instead of this code stupidly using
-        // trackid.
-        const auto rows = trackModel->getTrackRows(trackId);
-        for (int row : rows) {
-            // Restore sort order by rows, so the following commands will act as expected
-            selectedRows.insert(row, 0);
+    // The rows may only be available after a background select
+    runAfterPendingSelect([this,
+                                  trackModel,
+                                  itemModel,
+                                  selectedTrackIds,
+                                  savedHScrollBarPos,
+                                  prevColum] {
+        QItemSelectionModel* currentSelection = selectionModel();
+        currentSelection->reset(); // remove current selection
+
+        // Find previously selected tracks and store respective rows for reselection.
+        QMap<int, int> selectedRows;
+        for (const auto& trackId : selectedTrackIds) {
+            // TODO(rryan) slowly fixing the issues with BaseSqlTableModel. This
+            // code is broken for playlists because it assumes each trackid is in
+            // the table once. This will erroneously select all instances of the
+            // track for playlists, but it works fine for every other view. The way
+            // to fix this that we should do is to delegate the selection saving to
+            // the TrackModel. This will allow the playlist table model to use the
+            // table index as the unique id instead of this code stupidly using
+            // trackid.
+            const auto rows = trackModel->getTrackRows(trackId);
+            for (int row : rows) {
+                // Restore sort order by rows, so the following commands will act as expected
+                selectedRows.insert(row, 0);
+            }
         }
-    }
 
-    // Select the first row of the previous selection.
-    // This scrolls to that row and with the leftmost cell being focused we have
-    // a starting point (currentIndex) for navigation with Up/Down keys.
-    // Replaces broken scrollTo() (see comment below)
-    if (!selectedRows.isEmpty()) {
-        selectRow(selectedRows.firstKey());
-    }
+        // Select the first row of the previous selection.
+        // This scrolls to that row and with the leftmost cell being focused we have
+        // a starting point (currentIndex) for navigation with Up/Down keys.
+        // Replaces broken scrollTo() (see comment below)
+        if (!selectedRows.isEmpty()) {
+            selectRow(selectedRows.firstKey());
+        }
 
-    // Refocus the cell in the column that was focused before sorting.
-    // With this, any Up/Down key press moves the selection and keeps the
-    // horizontal scrollbar position we will restore below.
-    QModelIndex restoreIndex = itemModel->index(currentIndex().row(), prevColum);
-    if (restoreIndex.isValid()) {
-        setCurrentIndex(restoreIndex);
-    }
+        // Refocus the cell in the column that was focused before sorting.
+        // With this, any Up/Down key press moves the selection and keeps the
+        // horizontal scrollbar position we will restore below.
+        QModelIndex restoreIndex = itemModel->index(currentIndex().row(), prevColum);
+        if (restoreIndex.isValid()) {
+            setCurrentIndex(restoreIndex);
+        }
 
-    // Restore previous selection (doesn't affect focused cell).
-    QMapIterator<int, int> i(selectedRows);
-    while (i.hasNext()) {
-        i.next();
-        QModelIndex tl = itemModel->index(i.key(), 0);
-        currentSelection->select(tl, QItemSelectionModel::Rows | QItemSelectionModel::Select);
-    }
+        // Restore previous selection (doesn't affect focused cell).
+        QMapIterator<int, int> i(selectedRows);
+        while (i.hasNext()) {
+            i.next();
+            QModelIndex tl = itemModel->index(i.key(), 0);
+            currentSelection->select(tl, QItemSelectionModel::Rows | QItemSelectionModel::Select);
+        }
 
-    // This seems to be broken since at least Qt 5.12: no scrolling is issued
-    //scrollTo(first, QAbstractItemView::EnsureVisible);
-    horizontalScrollBar()->setValue(savedHScrollBarPos);
+        // This seems to be broken since at least Qt 5.12: no scrolling is issued
+        //scrollTo(first, QAbstractItemView::EnsureVisible);
+        horizontalScrollBar()->setValue(savedHScrollBarPos);
+    });
 }
 
 void WTrackTableView::applySortingIfVisible() {
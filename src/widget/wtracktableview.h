@@ -2,6 +2,7 @@
 
 #include <QAbstractItemModel>
 #include <QSortFilterProxyModel>
+#include <functional>
 
 #include "control/controlproxy.h"
 #include "control/pollingcontrolproxy.h"
@@ -77,6 +78,8 @@ class WTrackTableView : public WLibraryTableView {
     };
     void slotSelectTrack(const TrackId&);
 
+    bool restoreCurrentViewState() override;
+
   private slots:
     void doSortByColumn(int headerSection, Qt::SortOrder sortOrder);
     void applySortingIfVisible();
@@ -88,6 +91,7 @@ class WTrackTableView : public WLibraryTableView {
 
     void slotSortingChanged(int headerSection, Qt::SortOrder order);
     void keyNotationChanged();
+    void slotSelectFinished();
 
   protected:
     QString getModelStateKey() const override;
@@ -113,6 +117,10 @@ class WTrackTableView : public WLibraryTableView {
 
     void hideOrRemoveSelectedTracks();
 
+    // Calls fn once the rows of a pending background select of the model
+    // have arrived, or immediately if no select is pending.
+    void runAfterPendingSelect(std::function<void()> fn);
+
     const UserSettingsPointer m_pConfig;
     Library* const m_pLibrary;
 
@@ -132,4 +140,7 @@ class WTrackTableView : public WLibraryTableView {
     ControlProxy* m_pKeyNotation;
     ControlProxy* m_pSortColumn;
     ControlProxy* m_pSortOrder;
+
+    QMetaObject::Connection m_selectFinishedConnection;
+    QList<std::function<void()>> m_afterSelectFns;
 };